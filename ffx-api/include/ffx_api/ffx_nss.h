@@ -26,6 +26,7 @@
 #pragma once
 #include "ffx_api.h"
 #include "ffx_api_types.h"
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,15 +43,20 @@ enum FfxApiNssShaderQualityMode
 /// @ingroup ffxNss
 enum FfxApiCreateContextNssFlags
 {
-    FFX_API_NSS_CONTEXT_FLAG_QUANTIZED              = (1 << 0),  ///< Use a quantized data graph. Resources will be quantized to 8 bits.
-    FFX_API_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE     = (1 << 1),  ///< A bit indicating if the input color data provided is using a high-dynamic range.
-    FFX_API_NSS_CONTEXT_FLAG_DEPTH_INVERTED         = (1 << 2),  ///< A bit indicating that the input depth buffer data provided is inverted [1..0].
-    FFX_API_NSS_CONTEXT_FLAG_DEPTH_INFINITE         = (1 << 3),  ///< A bit indicating that the input depth buffer data provided is using an infinite far plane.
-    FFX_API_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC       = (1 << 4),  ///< A bit indicating sample using Bicubic filtering
-    FFX_API_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES = (1 << 5),  ///< A bit indicating tensor image aliasing is enable.
-    FFX_API_NSS_CONTEXT_FLAG_ALLOW_16BIT            = (1 << 6),  ///< A bit indicating that the runtime should allow 16bit resources to be used.
-    FFX_API_NSS_CONTEXT_FLAG_DISABLE_PADDING        = (1 << 7),  ///< A bit indicating that the padding is disabled in sdk.
-    FFX_API_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING  = (1 << 8),  ///< A bit indicating that the runtime should check some API values and report issues.
+    FFX_API_NSS_CONTEXT_FLAG_QUANTIZED               = (1 << 0),   ///< Use a quantized data graph. Resources will be quantized to 8 bits. Without it, the tensors are fp16 and an fp16 data graph is used when one is built in, otherwise the quantized one.
+    FFX_API_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE      = (1 << 1),   ///< A bit indicating if the input color data provided is using a high-dynamic range.
+    FFX_API_NSS_CONTEXT_FLAG_DEPTH_INVERTED          = (1 << 2),   ///< A bit indicating that the input depth buffer data provided is inverted [1..0].
+    FFX_API_NSS_CONTEXT_FLAG_DEPTH_INFINITE          = (1 << 3),   ///< A bit indicating that the input depth buffer data provided is using an infinite far plane.
+    FFX_API_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC        = (1 << 4),   ///< A bit indicating sample using Bicubic filtering
+    FFX_API_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES  = (1 << 5),   ///< A bit indicating tensor image aliasing is enable.
+    FFX_API_NSS_CONTEXT_FLAG_ALLOW_16BIT             = (1 << 6),   ///< A bit indicating that the runtime should allow 16bit resources to be used.
+    FFX_API_NSS_CONTEXT_FLAG_DISABLE_PADDING         = (1 << 7),   ///< A bit indicating that the padding is disabled in sdk.
+    FFX_API_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING   = (1 << 8),   ///< A bit indicating that the runtime should check some API values and report issues.
+    FFX_API_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION = (1 << 9),   ///< A bit indicating that pipelines should be created in the background, see <c><i>ffxApiQueryDescNssGetPipelinesReady</i></c>.
+    FFX_API_NSS_CONTEXT_FLAG_FUSED_PADDING           = (1 << 10),  ///< A bit indicating that input padding is fused into the passes instead of a padding pass.
+    FFX_API_NSS_CONTEXT_FLAG_REGION_OF_INTEREST      = (1 << 11),  ///< A bit indicating that dispatches upscale a region of the resources, see <c><i>ffxApiDispatchDescNssRegion</i></c>.
+    FFX_API_NSS_CONTEXT_FLAG_FOVEATED                = (1 << 12),  ///< A bit indicating that the network only upscales a region around the gaze, see <c><i>ffxApiCreateContextDescNssFovea</i></c>.
+    FFX_API_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS   = (1 << 13),  ///< A bit indicating that dispatches are recorded once and replayed while unchanged, see <c><i>ffxCreateBackendVKQueueFamilyDesc</i></c>.
 };
 
 /// @ingroup ffxNss
@@ -112,6 +118,77 @@ struct ffxApiDispatchDescNss
     uint32_t flags;  ///< Zero or a combination of values from FfxApiDispatchNssFlags.
 };
 
+/// @ingroup ffxNss
+#define FFX_API_CONFIGURE_DESC_TYPE_NSS_MODEL 0x000F0002u  ///< header type for <c><i>ffxApiConfigureDescNssModel</i></c>.
+/// @ingroup ffxNss
+///
+/// Replaces the data graph model used by the context. The fields describe a parsed
+/// model, as emitted by the <c><i>ffx_model_parser</i></c> tool. The model is validated
+/// against the tensors of the context, then its pipeline is built on a background thread.
+/// Dispatches keep running the current network until it is ready, and the first one after
+/// that switches to the new network. The model is copied, so all pointed-to data only needs
+/// to remain valid for the duration of the call.
+struct ffxApiConfigureDescNssModel
+{
+    ffxConfigureDescHeader header;
+
+    uint32_t              constantNums;                ///< The number of graph constants.
+    const uint32_t*       constantIds;                 ///< The id of each graph constant.
+    const uint32_t*       constantFormats;             ///< The <c><i>VkFormat</i></c> of each graph constant.
+    const uint32_t*       constantShapeSize;           ///< The rank of each graph constant.
+    const int64_t**       constantShapes;              ///< The shape of each graph constant.
+    const int64_t*        constantSparsityDimensions;  ///< The sparsity dimension of each graph constant, or -1 if dense.
+    const uint32_t*       constantDataSize;            ///< The size in bytes of each graph constant.
+    const unsigned char** constantDatas;               ///< The data of each graph constant.
+
+    const char*          graphEntryPoint;  ///< The entry point of the graph module.
+    uint32_t             graphDataSize;    ///< The size in bytes of the graph SPIR-V module.
+    const unsigned char* graphData;        ///< The graph SPIR-V module.
+
+    uint32_t         tensorNums;      ///< The number of tensors bound to the graph.
+    const char**     tensorNames;     ///< The name of each tensor.
+    const uint32_t*  tensorSets;      ///< The descriptor set of each tensor.
+    const uint32_t*  tensorBindings;  ///< The binding of each tensor.
+    const uint32_t*  tensorFormats;   ///< The <c><i>VkFormat</i></c> of each tensor.
+    const uint32_t*  tensorDimSize;   ///< The rank of each tensor.
+    const uint64_t** tensorDims;      ///< The dimensions of each tensor.
+
+    const float*   tensorQuantScales;      ///< The quantization scale of each int8 tensor, 0 for none. May be null for a model without quantization metadata.
+    const int32_t* tensorQuantZeroPoints;  ///< The quantization zero point of each int8 tensor. May be null for a model without quantization metadata.
+
+    const uint32_t* constantSparsityZeroCounts;  ///< The zeros in each group along the sparsity dimension of each graph constant, 0 for a dense constant. A constant with zeros is stored compressed. May be null for a dense model.
+    const uint32_t* constantSparsityGroupSizes;  ///< The elements in each group along the sparsity dimension of each graph constant. May be null for a dense model.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_CONFIGURE_DESC_TYPE_NSS_WARMUP 0x000F0003u  ///< header type for <c><i>ffxApiConfigureDescNssWarmup</i></c>.
+
+/// @ingroup ffxNss
+/// A unit of work scheduled by <c><i>ffxApiConfigureDescNssWarmup</i></c>.
+typedef void (*ffxApiNssTask)(void* pTaskData);
+
+/// @ingroup ffxNss
+/// Hands a task to the application's job system, which must eventually call
+/// <c><i>fpTask(pTaskData)</i></c> exactly once, on any thread.
+typedef void (*ffxApiNssSubmitTask)(ffxApiNssTask fpTask, void* pTaskData, void* pUserData);
+
+/// @ingroup ffxNss
+///
+/// Precompiles every pipeline permutation the context can use on the current device into
+/// the pipeline cache of the context. The pipelines of the context's own permutation are kept
+/// until the context creates them or is destroyed, the others are released. Store the cache with
+/// <c><i>ffxApiQueryDescNssGetPipelineCacheData</i></c> and pass it to contexts of later
+/// runs through <c><i>ffxApiCreateContextDescNssPipelineCache</i></c>. The work is split into
+/// at most <c><i>maxTaskCount</i></c> tasks handed to <c><i>fpSubmitTask</i></c>; the call
+/// blocks until all of them have completed.
+struct ffxApiConfigureDescNssWarmup
+{
+    ffxConfigureDescHeader header;
+    ffxApiNssSubmitTask    fpSubmitTask;  ///< Submits a task to the application's job system. If null, all work runs on the calling thread.
+    void*                  pUserData;     ///< Passed unchanged to <c><i>fpSubmitTask</i></c>.
+    uint32_t               maxTaskCount;  ///< The maximum number of tasks submitted at once. 0 selects a default.
+};
+
 /// @ingroup ffxNss
 #define FFX_API_QUERY_DESC_TYPE_NSS_GETJITTERPHASECOUNT 0x000F0004u  ///< header type for <c><i>ffxApiQueryDescNssGetJitterPhaseCount</i></c>.
 /// @ingroup ffxNss
@@ -136,6 +213,298 @@ struct ffxApiQueryDescNssGetJitterOffset
     float*             pOutY;       ///< A pointer to a <c>float</c> which will contain the subpixel jitter offset for the y dimension.
 };
 
+/// @ingroup ffxNss
+#define FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINESREADY 0x000F0006u  ///< header type for <c><i>ffxApiQueryDescNssGetPipelinesReady</i></c>.
+/// @ingroup ffxNss
+///
+/// Queries whether a context created with <c><i>FFX_API_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION</i></c>
+/// has finished creating its pipelines. Until then, dispatches write a bilinear upscale of the input color.
+struct ffxApiQueryDescNssGetPipelinesReady
+{
+    ffxQueryDescHeader header;
+    bool*              pOutReady;  ///< A pointer to a <c>bool</c> which will be set to true once the network is used by dispatches.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_CONFIGURE_DESC_TYPE_NSS_CAPTURE 0x000F0007u  ///< header type for <c><i>ffxApiConfigureDescNssCapture</i></c>.
+/// @ingroup ffxNss
+///
+/// Starts writing the inputs of the following dispatches to a capture file, which the
+/// <c><i>NSS_Replay</i></c> tool can feed back through a context. The color, depth and
+/// motion vector resources are read back on the GPU, so their images must be created with
+/// transfer source usage. A frame is written a few dispatches after it was captured, once
+/// the GPU has finished with it. Configuring a new capture, or passing a null path, finishes
+/// the current capture file; frames which were not written by then are dropped.
+struct ffxApiConfigureDescNssCapture
+{
+    ffxConfigureDescHeader header;
+    const char*            path;        ///< The file to write the capture to. If null, the current capture is finished.
+    uint32_t               frameCount;  ///< The number of dispatches to capture. 0 captures until the capture is finished.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_ASYNC_COMPUTE 0x000F0008u  ///< header type for <c><i>ffxApiDispatchDescNssAsyncCompute</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> to record the upscale into the context's own command
+/// buffers and submit them to <c><i>queue</i></c>, instead of recording onto <c><i>commandList</i></c>.
+/// The input and output resources must be owned by <c><i>commandListQueueFamilyIndex</i></c> before the
+/// dispatch, and are owned by it again once <c><i>acquireCommandList</i></c> has executed after the
+/// signal semaphore. The application must submit <c><i>commandList</i></c> before the wait semaphore is
+/// signalled, and must not read the output before the signal semaphore has been reached.
+struct ffxApiDispatchDescNssAsyncCompute
+{
+    ffxDispatchDescHeader header;
+    void*                 queue;                        ///< The compute or data graph capable <c>VkQueue</c> to submit the upscale to.
+    uint32_t              queueFamilyIndex;             ///< The queue family of <c><i>queue</i></c>.
+    uint32_t              commandListQueueFamilyIndex;  ///< The queue family of <c><i>commandList</i></c> and <c><i>acquireCommandList</i></c>.
+    void*                 waitSemaphore;                ///< A timeline <c>VkSemaphore</c> waited on before the upscale runs. May only be null when the queue families match.
+    uint64_t              waitValue;                    ///< The value of <c><i>waitSemaphore</i></c> to wait for.
+    void*                 signalSemaphore;              ///< A timeline <c>VkSemaphore</c> signalled once the upscale completes. May be null.
+    uint64_t              signalValue;                  ///< The value <c><i>signalSemaphore</i></c> is signalled with.
+    void*                 acquireCommandList;           ///< Receives the ownership acquire barriers. Required when the queue families differ.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_RESOURCE_STATES 0x000F0009u  ///< header type for <c><i>ffxApiDispatchDescNssResourceStates</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> to name the states the external resources are left in once
+/// the dispatch has executed. The <c><i>state</i></c> of each resource of the dispatch is the state NSS expects
+/// it in, and by default the resource is transitioned back to it. Naming the state the application uses the
+/// resource in next instead saves a transition there and back. A state of 0 keeps the default.
+struct ffxApiDispatchDescNssResourceStates
+{
+    ffxDispatchDescHeader header;
+    uint32_t              colorFinalState;          ///< The <c><i>FfxApiResourceState</i></c> <c><i>color</i></c> is left in.
+    uint32_t              depthFinalState;          ///< The <c><i>FfxApiResourceState</i></c> <c><i>depth</i></c> is left in.
+    uint32_t              depthTm1FinalState;       ///< The <c><i>FfxApiResourceState</i></c> <c><i>depthTm1</i></c> is left in.
+    uint32_t              motionVectorsFinalState;  ///< The <c><i>FfxApiResourceState</i></c> <c><i>motionVectors</i></c> is left in.
+    uint32_t              outputTm1FinalState;      ///< The <c><i>FfxApiResourceState</i></c> <c><i>outputTm1</i></c> is left in.
+    uint32_t              outputFinalState;         ///< The <c><i>FfxApiResourceState</i></c> <c><i>output</i></c> is left in.
+    uint32_t              debugViewsFinalState;     ///< The <c><i>FfxApiResourceState</i></c> <c><i>debugViews</i></c> is left in.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_NSS_MAX_REGISTERED_RESOURCES 32u  ///< The number of resources a context can hold registered through <c><i>ffxApiConfigureDescNssRegisterResource</i></c>.
+
+/// @ingroup ffxNss
+#define FFX_API_CONFIGURE_DESC_TYPE_NSS_REGISTER_RESOURCE 0x000F000Au  ///< header type for <c><i>ffxApiConfigureDescNssRegisterResource</i></c>.
+/// @ingroup ffxNss
+///
+/// Registers an application resource with the context once, so dispatches can refer to it by handle through
+/// <c><i>ffxApiDispatchDescNssRegisteredResources</i></c> instead of describing it again every frame. The backend
+/// keeps the resource and the views it creates for it from the first dispatch which uses it, rather than registering
+/// them again with every dispatch. Passing the handle of an earlier registration replaces the resource it refers to,
+/// which is only needed when the underlying image or its description changes. Passing a null resource releases the
+/// handle. Handles stay valid until they are released or the context is destroyed, a handle which is out of range or
+/// was released returns <c><i>FFX_API_RETURN_ERROR_PARAMETER</i></c>. Configuring and dispatching the context are
+/// serialized, so resources may be registered from another thread than the one dispatching.
+struct ffxApiConfigureDescNssRegisterResource
+{
+    ffxConfigureDescHeader header;
+    struct FfxApiResource  resource;    ///< The resource to register, or a null resource to release <c><i>handle</i></c>.
+    uint32_t               handle;      ///< 0 to register a new resource, or a handle returned by an earlier registration.
+    uint32_t*              pOutHandle;  ///< A pointer to a <c>uint32_t</c> which will hold the handle of the resource. May be null when releasing.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_REGISTERED_RESOURCES 0x000F000Bu  ///< header type for <c><i>ffxApiDispatchDescNssRegisteredResources</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> to use resources registered through
+/// <c><i>ffxApiConfigureDescNssRegisterResource</i></c>. A non-zero handle takes the place of the matching
+/// resource of the dispatch, of which only the <c><i>state</i></c> is read: when it is not 0, the registered
+/// resource is in that state for this dispatch, otherwise in the state it was registered in. A handle of 0 uses the
+/// resource of the dispatch. A handle which is out of range or was released returns
+/// <c><i>FFX_API_RETURN_ERROR_PARAMETER</i></c>.
+struct ffxApiDispatchDescNssRegisteredResources
+{
+    ffxDispatchDescHeader header;
+    uint32_t              color;          ///< The handle of the resource used as <c><i>color</i></c>.
+    uint32_t              depth;          ///< The handle of the resource used as <c><i>depth</i></c>.
+    uint32_t              depthTm1;       ///< The handle of the resource used as <c><i>depthTm1</i></c>.
+    uint32_t              motionVectors;  ///< The handle of the resource used as <c><i>motionVectors</i></c>.
+    uint32_t              outputTm1;      ///< The handle of the resource used as <c><i>outputTm1</i></c>.
+    uint32_t              output;         ///< The handle of the resource used as <c><i>output</i></c>.
+    uint32_t              debugViews;     ///< The handle of the resource used as <c><i>debugViews</i></c>.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_NSS_MAX_VIEW_COUNT 4u  ///< The number of views a context can upscale in one dispatch.
+
+/// @ingroup ffxNss
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_VIEWS 0x000F000Cu  ///< header type for <c><i>ffxApiCreateContextDescNssViews</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiCreateContextDescNss</i></c> to create a context which upscales several views, such as
+/// the two eyes of a stereo renderer, in every dispatch. The views share one run of the network through batched
+/// tensors and keep their own history. Requires data graph support and is incompatible with
+/// <c><i>FFX_NSS_ENABLE_READ_TENSORS_AS_IMAGES</i></c>.
+struct ffxApiCreateContextDescNssViews
+{
+    ffxCreateContextDescHeader header;
+    uint32_t                   viewCount;  ///< The number of views of every dispatch, between 1 and <c><i>FFX_API_NSS_MAX_VIEW_COUNT</i></c>.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_VIEWS 0x000F000Du  ///< header type for <c><i>ffxApiDispatchDescNssViews</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> to describe the views after the first one, which is the dispatch
+/// itself. The number of views must match the one the context was created with. Each additional view may chain its
+/// own <c><i>ffxApiDispatchDescNssRegisteredResources</i></c> and <c><i>ffxApiDispatchDescNssResourceStates</i></c>,
+/// the command list and <c><i>ffxApiDispatchDescNssAsyncCompute</i></c> of the first view are used for all of them.
+struct ffxApiDispatchDescNssViews
+{
+    ffxDispatchDescHeader               header;
+    uint32_t                            additionalViewCount;  ///< The number of entries in <c><i>pAdditionalViews</i></c>.
+    const struct ffxApiDispatchDescNss* pAdditionalViews;     ///< The views after the first one.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_NETWORK_INTERVAL 0x000F000Eu  ///< header type for <c><i>ffxApiCreateContextDescNssNetworkInterval</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiCreateContextDescNss</i></c> to run the network on only one dispatch in
+/// <c><i>networkInterval</i></c>. The dispatches in between warp the coefficients of the last run along the motion
+/// vectors instead, trading some quality in motion for a lower average cost. Dispatches that reset the history always
+/// run the network.
+struct ffxApiCreateContextDescNssNetworkInterval
+{
+    ffxCreateContextDescHeader header;
+    uint32_t                   networkInterval;  ///< The number of dispatches per run of the network, 0 and 1 run it on every dispatch.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_NSS_REGION_HALO 16u  ///< The number of input pixels read on each side of a region of interest.
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_REGION 0x000F000Fu  ///< header type for <c><i>ffxApiDispatchDescNssRegion</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> of a context created with
+/// <c><i>FFX_API_NSS_CONTEXT_FLAG_REGION_OF_INTEREST</i></c> to upscale a region of the resources, such as the viewport of
+/// an editor or one tile of a frame too large for the device. The sizes of the regions replace <c><i>renderSize</i></c> and
+/// <c><i>upscaleSize</i></c> and must match the maximum sizes of the context. Up to <c><i>FFX_API_NSS_REGION_HALO</i></c>
+/// input pixels around the render region are read as well. Moving either region requires a reset.
+struct ffxApiDispatchDescNssRegion
+{
+    ffxDispatchDescHeader header;
+    struct FfxApiRect2D   renderRegion;   ///< The region of the input resources to upscale.
+    struct FfxApiRect2D   upscaleRegion;  ///< The region of the output written with the result.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_FOVEA 0x000F0010u  ///< header type for <c><i>ffxApiCreateContextDescNssFovea</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiCreateContextDescNss</i></c> with <c><i>FFX_API_NSS_CONTEXT_FLAG_FOVEATED</i></c> to size the
+/// region around the gaze the network upscales. The rest of the frame takes a cheaper temporal upscale, blended with
+/// the region over <c><i>FFX_API_NSS_REGION_HALO</i></c> input pixels around it.
+struct ffxApiCreateContextDescNssFovea
+{
+    ffxCreateContextDescHeader header;
+    struct FfxApiDimensions2D  foveaSize;  ///< The size of the region the network upscales, in render pixels.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_DISPATCH_DESC_TYPE_NSS_GAZE 0x000F0011u  ///< header type for <c><i>ffxApiDispatchDescNssGaze</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiDispatchDescNss</i></c> of a foveated context to place the region the network upscales. It
+/// follows the gaze once the gaze leaves its inner half, which resets the history of the region. Without it, the
+/// region stays in the centre of the view.
+struct ffxApiDispatchDescNssGaze
+{
+    ffxDispatchDescHeader      header;
+    struct FfxApiFloatCoords2D gazeOffset;  ///< The gaze point relative to the centre of the view, in uv units.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_PIPELINE_CACHE 0x000F0012u  ///< header type for <c><i>ffxApiCreateContextDescNssPipelineCache</i></c>.
+/// @ingroup ffxNss
+///
+/// Chained to <c><i>ffxApiCreateContextDescNss</i></c> to add pipeline cache data stored by an earlier run to the
+/// pipeline cache of the context before it creates its pipelines, so the pipelines in it aren't compiled again. Data
+/// written by another device or driver version is ignored. The data is only read during context creation.
+struct ffxApiCreateContextDescNssPipelineCache
+{
+    ffxCreateContextDescHeader header;
+    const void*                pData;     ///< The data returned by <c><i>ffxApiQueryDescNssGetPipelineCacheData</i></c>.
+    size_t                     dataSize;  ///< The size of <c><i>pData</i></c> in bytes.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINECACHEDATA 0x000F0013u  ///< header type for <c><i>ffxApiQueryDescNssGetPipelineCacheData</i></c>.
+/// @ingroup ffxNss
+///
+/// Retrieves the contents of the pipeline cache of a context, e.g. after <c><i>ffxApiConfigureDescNssWarmup</i></c>, for
+/// the application to store. Query with a null <c><i>pOutData</i></c> to get the size first. Returns
+/// <c><i>FFX_API_RETURN_ERROR_MEMORY</i></c> when the buffer is too small, it then holds as much of the data as fits.
+/// Requires a context.
+struct ffxApiQueryDescNssGetPipelineCacheData
+{
+    ffxQueryDescHeader header;
+    void*              pOutData;        ///< A buffer receiving the data, or null to query its size.
+    size_t*            pInOutDataSize;  ///< The size of <c><i>pOutData</i></c> in bytes. Receives the size of the data written, or of all the data.
+};
+
+/// @ingroup ffxNss
+#define FFX_API_NSS_CAPTURE_MAGIC   0x4353534Eu  ///< "NSSC", the first four bytes of a capture file.
+#define FFX_API_NSS_CAPTURE_VERSION 2u           ///< The version of the capture file layout described below.
+
+/// @ingroup ffxNss
+///
+/// The start of a capture file. It is followed by <c><i>frameCount</i></c> frames, each made of a
+/// <c><i>ffxApiNssCaptureFrameHeader</i></c> followed by the color, depth, motion vector, previous
+/// depth and previous output texels.
+/// All values are stored in the byte order of the capturing machine.
+struct ffxApiNssCaptureFileHeader
+{
+    uint32_t                  magic;           ///< <c><i>FFX_API_NSS_CAPTURE_MAGIC</i></c>.
+    uint32_t                  version;         ///< <c><i>FFX_API_NSS_CAPTURE_VERSION</i></c>.
+    uint32_t                  frameCount;      ///< The number of frames in the file.
+    uint32_t                  contextFlags;    ///< The <c><i>FfxApiCreateContextNssFlags</i></c> of the capturing context.
+    uint32_t                  qualityMode;     ///< The <c><i>FfxApiNssShaderQualityMode</i></c> of the capturing context.
+    struct FfxApiDimensions2D maxRenderSize;   ///< The maximum render size of the capturing context.
+    struct FfxApiDimensions2D maxUpscaleSize;  ///< The maximum upscale size of the capturing context.
+};
+
+/// @ingroup ffxNss
+/// An image of a captured frame. Its texels are tightly packed rows of mip 0.
+struct ffxApiNssCaptureImage
+{
+    uint32_t format;    ///< The <c><i>FfxApiSurfaceFormat</i></c> of the image.
+    uint32_t usage;     ///< The <c><i>FfxApiResourceUsage</i></c> of the image.
+    uint32_t width;     ///< The width of the image.
+    uint32_t height;    ///< The height of the image.
+    uint32_t dataSize;  ///< The size of the texel data in bytes.
+};
+
+/// @ingroup ffxNss
+/// The parameters a captured frame was dispatched with.
+struct ffxApiNssCaptureFrameHeader
+{
+    uint32_t                     frameIndex;              ///< The index of the frame in the capture.
+    uint32_t                     flags;                   ///< Zero or a combination of values from FfxApiDispatchNssFlags.
+    struct FfxApiFloatCoords2D   jitterOffset;            ///< The subpixel jitter offset applied to the camera.
+    struct FfxApiFloatCoords2D   motionVectorScale;       ///< The scale applied to the motion vectors.
+    struct FfxApiDimensions2D    renderSize;              ///< The resolution that was used for rendering the input resources.
+    struct FfxApiDimensions2D    upscaleSize;             ///< The resolution that was used for rendering the output resources.
+    float                        cameraNear;              ///< The distance to the near plane of the camera.
+    float                        cameraFar;               ///< The distance to the far plane of the camera.
+    float                        cameraFovAngleVertical;  ///< The camera angle field of view in the vertical direction (expressed in radians).
+    float                        exposure;                ///< The exposure value.
+    float                        frameTimeDelta;          ///< The time elapsed since the last frame (expressed in milliseconds).
+    uint32_t                     reset;                   ///< 1 if the camera moved discontinuously, 0 otherwise.
+    struct ffxApiNssCaptureImage color;                   ///< The color buffer.
+    struct ffxApiNssCaptureImage depth;                   ///< The depth buffer.
+    struct ffxApiNssCaptureImage motionVectors;           ///< The motion vectors.
+    struct ffxApiNssCaptureImage depthTm1;                ///< The depth buffer of the previous frame, with no data if it was null.
+    struct ffxApiNssCaptureImage outputTm1;               ///< The output of the previous frame, with no data if it was null.
+};
+
 #ifdef __cplusplus
 }
 #endif
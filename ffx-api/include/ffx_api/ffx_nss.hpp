@@ -50,6 +50,24 @@ namespace ffx
     {
     };
 
+    template <>
+    struct struct_type<ffxApiConfigureDescNssModel> : std::integral_constant<uint64_t, FFX_API_CONFIGURE_DESC_TYPE_NSS_MODEL>
+    {
+    };
+
+    struct ConfigureDescNssModel : public InitHelper<ffxApiConfigureDescNssModel>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiConfigureDescNssWarmup> : std::integral_constant<uint64_t, FFX_API_CONFIGURE_DESC_TYPE_NSS_WARMUP>
+    {
+    };
+
+    struct ConfigureDescNssWarmup : public InitHelper<ffxApiConfigureDescNssWarmup>
+    {
+    };
+
     template <>
     struct struct_type<ffxApiQueryDescNssGetJitterPhaseCount> : std::integral_constant<uint64_t, FFX_API_QUERY_DESC_TYPE_NSS_GETJITTERPHASECOUNT>
     {
@@ -68,4 +86,130 @@ namespace ffx
     {
     };
 
+    template <>
+    struct struct_type<ffxApiQueryDescNssGetPipelinesReady> : std::integral_constant<uint64_t, FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINESREADY>
+    {
+    };
+
+    struct QueryDescNssGetPipelinesReady : public InitHelper<ffxApiQueryDescNssGetPipelinesReady>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiConfigureDescNssCapture> : std::integral_constant<uint64_t, FFX_API_CONFIGURE_DESC_TYPE_NSS_CAPTURE>
+    {
+    };
+
+    struct ConfigureDescNssCapture : public InitHelper<ffxApiConfigureDescNssCapture>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssAsyncCompute> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_ASYNC_COMPUTE>
+    {
+    };
+
+    struct DispatchDescNssAsyncCompute : public InitHelper<ffxApiDispatchDescNssAsyncCompute>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssResourceStates> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_RESOURCE_STATES>
+    {
+    };
+
+    struct DispatchDescNssResourceStates : public InitHelper<ffxApiDispatchDescNssResourceStates>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiConfigureDescNssRegisterResource> : std::integral_constant<uint64_t, FFX_API_CONFIGURE_DESC_TYPE_NSS_REGISTER_RESOURCE>
+    {
+    };
+
+    struct ConfigureDescNssRegisterResource : public InitHelper<ffxApiConfigureDescNssRegisterResource>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssRegisteredResources> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_REGISTERED_RESOURCES>
+    {
+    };
+
+    struct DispatchDescNssRegisteredResources : public InitHelper<ffxApiDispatchDescNssRegisteredResources>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiCreateContextDescNssViews> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_VIEWS>
+    {
+    };
+
+    struct CreateContextDescNssViews : public InitHelper<ffxApiCreateContextDescNssViews>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssViews> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_VIEWS>
+    {
+    };
+
+    struct DispatchDescNssViews : public InitHelper<ffxApiDispatchDescNssViews>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiCreateContextDescNssNetworkInterval> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_NETWORK_INTERVAL>
+    {
+    };
+
+    struct CreateContextDescNssNetworkInterval : public InitHelper<ffxApiCreateContextDescNssNetworkInterval>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssRegion> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_REGION>
+    {
+    };
+
+    struct DispatchDescNssRegion : public InitHelper<ffxApiDispatchDescNssRegion>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiCreateContextDescNssFovea> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_FOVEA>
+    {
+    };
+
+    struct CreateContextDescNssFovea : public InitHelper<ffxApiCreateContextDescNssFovea>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiDispatchDescNssGaze> : std::integral_constant<uint64_t, FFX_API_DISPATCH_DESC_TYPE_NSS_GAZE>
+    {
+    };
+
+    struct DispatchDescNssGaze : public InitHelper<ffxApiDispatchDescNssGaze>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiCreateContextDescNssPipelineCache> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_PIPELINE_CACHE>
+    {
+    };
+
+    struct CreateContextDescNssPipelineCache : public InitHelper<ffxApiCreateContextDescNssPipelineCache>
+    {
+    };
+
+    template <>
+    struct struct_type<ffxApiQueryDescNssGetPipelineCacheData> : std::integral_constant<uint64_t, FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINECACHEDATA>
+    {
+    };
+
+    struct QueryDescNssGetPipelineCacheData : public InitHelper<ffxApiQueryDescNssGetPipelineCacheData>
+    {
+    };
+
 }  // namespace ffx
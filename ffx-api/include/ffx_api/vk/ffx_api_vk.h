@@ -47,6 +47,15 @@ struct ffxCreateBackendVKDesc
     PFN_vkGetInstanceProcAddr  vkGetInstanceProcAddr;
 };
 
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_QUEUE_FAMILY 0x0000004u
+/// Optionally chained next to <c><i>ffxCreateBackendVKDesc</i></c>. Command buffers the backend records itself, such as those
+/// replayed with <c><i>FFX_API_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS</i></c>, are allocated from this queue family.
+struct ffxCreateBackendVKQueueFamilyDesc
+{
+    ffxCreateContextDescHeader header;
+    uint32_t                   queueFamilyIndex;  ///< the queue family of the command lists passed to dispatches.
+};
+
 #define FFX_API_EFFECT_ID_FGSC_VK 0x00040000u
 
 #define FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK 0x40001u
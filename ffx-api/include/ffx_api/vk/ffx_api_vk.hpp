@@ -38,6 +38,15 @@ namespace ffx
     {
     };
 
+    template <>
+    struct struct_type<ffxCreateBackendVKQueueFamilyDesc> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_QUEUE_FAMILY>
+    {
+    };
+
+    struct CreateBackendVKQueueFamilyDesc : public InitHelper<ffxCreateBackendVKQueueFamilyDesc>
+    {
+    };
+
     template <>
     struct struct_type<ffxCreateContextDescFrameGenerationSwapChainVK> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK>
     {
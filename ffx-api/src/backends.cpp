@@ -27,6 +27,19 @@
 #include <ffx_api/vk/ffx_api_vk.h>
 #endif  // #ifdef FFX_BACKEND_VK
 
+#ifdef FFX_BACKEND_VK
+// The queue family of the command lists, family 0 unless chained
+static uint32_t GetQueueFamilyIndex(const ffxCreateContextDescHeader* desc)
+{
+    for (const auto* it = desc->pNext; it; it = it->pNext)
+    {
+        if (it->type == FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_QUEUE_FAMILY)
+            return reinterpret_cast<const ffxCreateBackendVKQueueFamilyDesc*>(it)->queueFamilyIndex;
+    }
+    return 0;
+}
+#endif  // FFX_BACKEND_VK
+
 ffxReturnCode_t CreateBackend(const ffxCreateContextDescHeader* desc, bool& backendFound, FfxInterface* iface, size_t contexts, Allocator& alloc)
 {
     for (const auto* it = desc->pNext; it; it = it->pNext)
@@ -46,7 +59,8 @@ ffxReturnCode_t CreateBackend(const ffxCreateContextDescHeader* desc, bool& back
                                              backendDesc->vkPhysicalDevice,
                                              backendDesc->vkDeviceProcAddr,
                                              backendDesc->vkInstance,
-                                             backendDesc->vkGetInstanceProcAddr};
+                                             backendDesc->vkGetInstanceProcAddr,
+                                             GetQueueFamilyIndex(desc)};
             FfxDevice       device            = ffxGetDeviceVK(&deviceContext);
             size_t          scratchBufferSize = ffxGetScratchMemorySizeVK(deviceContext, contexts);
             void*           scratchBuffer     = alloc.alloc(scratchBufferSize);
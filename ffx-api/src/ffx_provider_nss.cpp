@@ -33,6 +33,8 @@
 #include <FidelityFX/gpu/nss/ffx_nss_resources.h>
 #include <FidelityFX/host/ffx_nss.h>
 
+#include <mutex>
+#include <stdio.h>
 #include <stdlib.h>
 
 static uint32_t ConvertContextFlagsNss(uint32_t apiFlags)
@@ -56,6 +58,16 @@ static uint32_t ConvertContextFlagsNss(uint32_t apiFlags)
         outFlags |= FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING;
     if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING)
         outFlags |= FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION)
+        outFlags |= FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_FUSED_PADDING)
+        outFlags |= FFX_NSS_CONTEXT_FLAG_FUSED_PADDING;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_REGION_OF_INTEREST)
+        outFlags |= FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_FOVEATED)
+        outFlags |= FFX_NSS_CONTEXT_FLAG_FOVEATED;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS)
+        outFlags |= FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS;
     return outFlags;
 }
 
@@ -67,6 +79,14 @@ static uint32_t ConvertDispatchFlagsNss(uint32_t apiFlags)
     return outFlags;
 }
 
+static uint32_t ReverseConvertDispatchFlagsNss(uint32_t flags)
+{
+    uint32_t outFlags = 0;
+    if (flags & FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW)
+        outFlags |= FFX_API_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW;
+    return outFlags;
+}
+
 bool ffxProvider_Nss::CanProvide(uint64_t type) const
 {
     return (type & FFX_API_EFFECT_MASK) == FFX_API_EFFECT_ID_NSS;
@@ -89,13 +109,116 @@ const char* ffxProvider_Nss::GetVersionName() const
 
 struct InternalNssContext
 {
-    InternalContextHeader header;
-    FfxInterface          backendInterface;
-    FfxResourceInternal   sharedResources[FFX_NSS_RESOURCE_IDENTIFIER_COUNT];
-    FfxNssContext         context;
-    ffxApiMessage         fpMessage;
+    InternalContextHeader      header;
+    FfxInterface               backendInterface;
+    FfxResourceInternal        sharedResources[FFX_NSS_RESOURCE_IDENTIFIER_COUNT];
+    FfxNssContext              context;
+    ffxApiMessage              fpMessage;
+    ffxApiNssCaptureFileHeader captureHeader;      // describes the context, frameCount counts the frames written so far
+    uint32_t                   captureFrameCount;  // the number of frames requested, 0 if unbounded
+    FILE*                      captureFile;
+    uint32_t                   registeredHandles;  // bit handle - 1 is set while the handle is registered, the context keeps the resources
+    std::mutex                 mutex;              // serializes configuring the context with dispatching it
 };
 
+FFX_STATIC_ASSERT(FFX_API_NSS_MAX_REGISTERED_RESOURCES == FFX_NSS_MAX_REGISTERED_RESOURCES);
+FFX_STATIC_ASSERT(FFX_API_NSS_MAX_REGISTERED_RESOURCES <= 32);
+
+static bool IsRegisteredHandleNss(const InternalNssContext* internal_context, uint32_t handle)
+{
+    return handle != 0 && handle <= FFX_API_NSS_MAX_REGISTERED_RESOURCES && (internal_context->registeredHandles & (1u << (handle - 1))) != 0;
+}
+
+// The context uses the registered resource in place of a non-zero handle, only the state of the dispatch is passed on for it
+static FfxResource ResolveResourceNss(uint32_t handle, const FfxApiResource& resource)
+{
+    if (handle != 0)
+    {
+        FfxResource stateOnly = {};
+        stateOnly.state       = ConvertEnum<FfxResourceStates>(resource.state);
+        return stateOnly;
+    }
+    return Convert(resource);
+}
+
+static ffxApiNssCaptureImage ConvertCaptureImageNss(const FfxResource& resource, uint32_t dataSize)
+{
+    ffxApiNssCaptureImage image = {};
+    image.format                = ReverseConvertEnum<FfxSurfaceFormat>(resource.description.format);
+    image.usage                 = ReverseConvertEnum<FfxResourceUsage>(resource.description.usage);
+    image.width                 = resource.description.width;
+    image.height                = resource.description.height;
+    image.dataSize              = dataSize;
+    return image;
+}
+
+static void FinishCaptureNss(InternalNssContext* internal_context)
+{
+    if (internal_context->captureFile == nullptr)
+    {
+        return;
+    }
+
+    // the frame count is only known once the capture is finished
+    fseek(internal_context->captureFile, 0, SEEK_SET);
+    fwrite(&internal_context->captureHeader, sizeof(internal_context->captureHeader), 1, internal_context->captureFile);
+    fclose(internal_context->captureFile);
+    internal_context->captureFile = nullptr;
+}
+
+static void WriteCaptureFrameNss(const FfxNssCaptureFrame* frame, void* pUserData)
+{
+    InternalNssContext* internal_context = reinterpret_cast<InternalNssContext*>(pUserData);
+    if (internal_context->captureFile == nullptr)
+    {
+        return;
+    }
+
+    const FfxNssDispatchDescription& params = frame->dispatchDescription;
+
+    ffxApiNssCaptureFrameHeader frameHeader = {};
+    frameHeader.frameIndex                  = frame->frameIndex;
+    frameHeader.flags                       = ReverseConvertDispatchFlagsNss(params.flags);
+    frameHeader.jitterOffset.x              = params.jitterOffset.x;
+    frameHeader.jitterOffset.y              = params.jitterOffset.y;
+    frameHeader.motionVectorScale.x         = params.motionVectorScale.x;
+    frameHeader.motionVectorScale.y         = params.motionVectorScale.y;
+    frameHeader.renderSize.width            = params.renderSize.width;
+    frameHeader.renderSize.height           = params.renderSize.height;
+    frameHeader.upscaleSize.width           = params.upscaleSize.width;
+    frameHeader.upscaleSize.height          = params.upscaleSize.height;
+    frameHeader.cameraNear                  = params.cameraNear;
+    frameHeader.cameraFar                   = params.cameraFar;
+    frameHeader.cameraFovAngleVertical      = params.cameraFovAngleVertical;
+    frameHeader.exposure                    = params.exposure;
+    frameHeader.frameTimeDelta              = params.frameTimeDelta;
+    frameHeader.reset                       = params.reset ? 1 : 0;
+    frameHeader.color                       = ConvertCaptureImageNss(params.color, frame->colorDataSize);
+    frameHeader.depth                       = ConvertCaptureImageNss(params.depth, frame->depthDataSize);
+    frameHeader.motionVectors               = ConvertCaptureImageNss(params.motionVectors, frame->motionVectorsDataSize);
+    frameHeader.depthTm1                    = ConvertCaptureImageNss(params.depthTm1, frame->depthTm1DataSize);
+    frameHeader.outputTm1                   = ConvertCaptureImageNss(params.outputTm1, frame->outputTm1DataSize);
+
+    FILE*      file    = internal_context->captureFile;
+    const bool written = fwrite(&frameHeader, sizeof(frameHeader), 1, file) == 1 &&
+                         fwrite(frame->colorData, 1, frame->colorDataSize, file) == frame->colorDataSize &&
+                         fwrite(frame->depthData, 1, frame->depthDataSize, file) == frame->depthDataSize &&
+                         fwrite(frame->motionVectorsData, 1, frame->motionVectorsDataSize, file) == frame->motionVectorsDataSize &&
+                         fwrite(frame->depthTm1Data, 1, frame->depthTm1DataSize, file) == frame->depthTm1DataSize &&
+                         fwrite(frame->outputTm1Data, 1, frame->outputTm1DataSize, file) == frame->outputTm1DataSize;
+    if (!written)
+    {
+        // the header only counts complete frames, so readers ignore the partial one
+        FinishCaptureNss(internal_context);
+        return;
+    }
+
+    if (++internal_context->captureHeader.frameCount == internal_context->captureFrameCount)
+    {
+        FinishCaptureNss(internal_context);
+    }
+}
+
 ffxReturnCode_t ffxProvider_Nss::CreateContext(ffxContext* context, ffxCreateContextDescHeader* header, Allocator& alloc) const
 {
     VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
@@ -106,12 +229,19 @@ ffxReturnCode_t ffxProvider_Nss::CreateContext(ffxContext* context, ffxCreateCon
         if (desc->fpMessage)
         {
 #ifdef FFX_BACKEND_VK
-            Validator{desc->fpMessage, header}.AcceptExtensions({FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK, FFX_API_DESC_TYPE_OVERRIDE_VERSION});
+            Validator{desc->fpMessage, header}.AcceptExtensions({FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK,
+                                                                 FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_QUEUE_FAMILY,
+                                                                 FFX_API_DESC_TYPE_OVERRIDE_VERSION,
+                                                                 FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_VIEWS,
+                                                                 FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_NETWORK_INTERVAL,
+                                                                 FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_FOVEA,
+                                                                 FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_PIPELINE_CACHE});
 #endif  // FFX_BACKEND_VK
         }
         InternalNssContext* internal_context = alloc.construct<InternalNssContext>();
         VERIFY(internal_context, FFX_API_RETURN_ERROR_MEMORY);
         internal_context->header.provider = this;
+        ::new (&internal_context->mutex) std::mutex();
 
         TRY(MustCreateBackend(header, &internal_context->backendInterface, 1, alloc));
 
@@ -127,12 +257,48 @@ ffxReturnCode_t ffxProvider_Nss::CreateContext(ffxContext* context, ffxCreateCon
 
         initializationParameters.qualityMode = ConvertEnum<FfxNssShaderQualityMode>(desc->qualityMode);
         initializationParameters.flags       = ConvertContextFlagsNss(desc->flags);
+        for (const auto* it = header->pNext; it; it = it->pNext)
+        {
+            if (it->type == FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_VIEWS)
+            {
+                initializationParameters.viewCount = reinterpret_cast<const ffxApiCreateContextDescNssViews*>(it)->viewCount;
+            }
+            else if (it->type == FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_NETWORK_INTERVAL)
+            {
+                initializationParameters.networkInterval = reinterpret_cast<const ffxApiCreateContextDescNssNetworkInterval*>(it)->networkInterval;
+            }
+            else if (it->type == FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_FOVEA)
+            {
+                auto foveaDesc                            = reinterpret_cast<const ffxApiCreateContextDescNssFovea*>(it);
+                initializationParameters.foveaSize.width  = foveaDesc->foveaSize.width;
+                initializationParameters.foveaSize.height = foveaDesc->foveaSize.height;
+            }
+            else if (it->type == FFX_API_CREATE_CONTEXT_DESC_TYPE_NSS_PIPELINE_CACHE)
+            {
+                auto cacheDesc                                 = reinterpret_cast<const ffxApiCreateContextDescNssPipelineCache*>(it);
+                initializationParameters.pipelineCacheData     = cacheDesc->pData;
+                initializationParameters.pipelineCacheDataSize = cacheDesc->dataSize;
+            }
+        }
         // Calling this casted function is undefined behaviour, but it's probably safe.
         initializationParameters.fpMessage = reinterpret_cast<FfxNssMessage>(desc->fpMessage);
 
         // Grab this fp for use in extensions later
         internal_context->fpMessage = desc->fpMessage;
 
+        // Describe the context at the start of capture files
+        internal_context->captureHeader.magic          = FFX_API_NSS_CAPTURE_MAGIC;
+        internal_context->captureHeader.version        = FFX_API_NSS_CAPTURE_VERSION;
+        internal_context->captureHeader.contextFlags   = desc->flags;
+        internal_context->captureHeader.qualityMode    = desc->qualityMode;
+        internal_context->captureHeader.maxRenderSize  = desc->maxRenderSize;
+        internal_context->captureHeader.maxUpscaleSize = desc->maxUpscaleSize;
+        internal_context->captureHeader.frameCount     = 0;
+        internal_context->captureFrameCount            = 0;
+        internal_context->captureFile                  = nullptr;
+
+        internal_context->registeredHandles = 0;
+
         // Create the NSS context
         TRY2(ffxNssContextCreate(&internal_context->context, &initializationParameters));
 
@@ -157,9 +323,13 @@ ffxReturnCode_t ffxProvider_Nss::DestroyContext(ffxContext* context, Allocator&
         TRY2(internal_context->backendInterface.fpDestroyResource(&internal_context->backendInterface, internal_context->sharedResources[i], 0));
     }
 
-    TRY2(ffxNssContextDestroy(&internal_context->context));
+    // Destroying the context delivers the frames still in flight
+    const FfxErrorCode destroyError = ffxNssContextDestroy(&internal_context->context);
+    FinishCaptureNss(internal_context);
+    TRY2(destroyError);
 
     alloc.dealloc(internal_context->backendInterface.scratchBuffer);
+    internal_context->mutex.~mutex();
     alloc.dealloc(internal_context);
 
     return FFX_API_RETURN_OK;
@@ -167,6 +337,130 @@ ffxReturnCode_t ffxProvider_Nss::DestroyContext(ffxContext* context, Allocator&
 
 ffxReturnCode_t ffxProvider_Nss::Configure(ffxContext* context, const ffxConfigureDescHeader* header) const
 {
+    VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
+    VERIFY(*context, FFX_API_RETURN_ERROR_PARAMETER);
+    VERIFY(header, FFX_API_RETURN_ERROR_PARAMETER);
+
+    InternalNssContext* internal_context = reinterpret_cast<InternalNssContext*>(*context);
+    if (internal_context->fpMessage)
+    {
+        Validator{internal_context->fpMessage, header}.NoExtensions();
+    }
+
+    std::lock_guard<std::mutex> lock(internal_context->mutex);
+    switch (header->type)
+    {
+    case FFX_API_CONFIGURE_DESC_TYPE_NSS_MODEL:
+    {
+        auto desc = reinterpret_cast<const ffxApiConfigureDescNssModel*>(header);
+
+        const FfxDataGraphBlob dataGraph = {desc->constantNums,
+                                            desc->constantIds,
+                                            desc->constantFormats,
+                                            desc->constantShapeSize,
+                                            desc->constantShapes,
+                                            desc->constantSparsityDimensions,
+                                            desc->constantDataSize,
+                                            desc->constantDatas,
+                                            desc->graphEntryPoint,
+                                            desc->graphDataSize,
+                                            desc->graphData,
+                                            desc->tensorNums,
+                                            desc->tensorNames,
+                                            desc->tensorSets,
+                                            desc->tensorBindings,
+                                            desc->tensorFormats,
+                                            desc->tensorDimSize,
+                                            desc->tensorDims,
+                                            desc->tensorQuantScales,
+                                            desc->tensorQuantZeroPoints,
+                                            desc->constantSparsityZeroCounts,
+                                            desc->constantSparsityGroupSizes};
+
+        FfxNssModelDescription modelDescription = {};
+        modelDescription.dataGraph              = &dataGraph;
+
+        TRY2(ffxNssContextSetModel(&internal_context->context, &modelDescription));
+        break;
+    }
+    case FFX_API_CONFIGURE_DESC_TYPE_NSS_WARMUP:
+    {
+        auto desc = reinterpret_cast<const ffxApiConfigureDescNssWarmup*>(header);
+
+        FfxNssWarmupDescription warmupDescription = {};
+        warmupDescription.fpSubmitTask            = reinterpret_cast<FfxNssSubmitTaskFunc>(desc->fpSubmitTask);
+        warmupDescription.pUserData               = desc->pUserData;
+        warmupDescription.maxTaskCount            = desc->maxTaskCount;
+
+        TRY2(ffxNssContextWarmupPipelines(&internal_context->context, &warmupDescription));
+        break;
+    }
+    case FFX_API_CONFIGURE_DESC_TYPE_NSS_CAPTURE:
+    {
+        auto desc = reinterpret_cast<const ffxApiConfigureDescNssCapture*>(header);
+
+        // Finish the current capture before starting another one
+        FfxNssCaptureDescription captureDescription = {};
+        TRY2(ffxNssContextSetCapture(&internal_context->context, &captureDescription));
+        FinishCaptureNss(internal_context);
+
+        if (desc->path != nullptr)
+        {
+            FILE* file = fopen(desc->path, "wb");
+            VERIFY(file, FFX_API_RETURN_ERROR_PARAMETER);
+
+            internal_context->captureHeader.frameCount = 0;
+            if (fwrite(&internal_context->captureHeader, sizeof(internal_context->captureHeader), 1, file) != 1)
+            {
+                fclose(file);
+                return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
+            }
+
+            internal_context->captureFile       = file;
+            internal_context->captureFrameCount = desc->frameCount;
+
+            captureDescription.fpCaptureFrame = WriteCaptureFrameNss;
+            captureDescription.pUserData      = internal_context;
+            captureDescription.frameCount     = desc->frameCount;
+            TRY2(ffxNssContextSetCapture(&internal_context->context, &captureDescription));
+        }
+        break;
+    }
+    case FFX_API_CONFIGURE_DESC_TYPE_NSS_REGISTER_RESOURCE:
+    {
+        auto desc = reinterpret_cast<const ffxApiConfigureDescNssRegisterResource*>(header);
+        VERIFY(desc->handle == 0 || IsRegisteredHandleNss(internal_context, desc->handle), FFX_API_RETURN_ERROR_PARAMETER);
+
+        // releasing a handle that was never handed out has nothing to do
+        const uint32_t previousHandle = desc->handle;
+        uint32_t       handle         = desc->handle;
+        if (handle != 0 || desc->resource.resource != nullptr)
+        {
+            const FfxResource  resource  = Convert(desc->resource);
+            const FfxErrorCode errorCode = ffxNssContextRegisterResource(&internal_context->context, &resource, &handle);
+            VERIFY(errorCode != FfxErrorCode(FFX_ERROR_OUT_OF_MEMORY), FFX_API_RETURN_ERROR_MEMORY);
+            TRY2(errorCode);
+        }
+
+        if (previousHandle != 0)
+        {
+            internal_context->registeredHandles &= ~(1u << (previousHandle - 1));
+        }
+        if (handle != 0)
+        {
+            internal_context->registeredHandles |= 1u << (handle - 1);
+        }
+
+        if (desc->pOutHandle != nullptr)
+        {
+            *desc->pOutHandle = handle;
+        }
+        break;
+    }
+    default:
+        return FFX_API_RETURN_ERROR_UNKNOWN_DESCTYPE;
+    }
+
     return FFX_API_RETURN_OK;
 }
 
@@ -211,6 +505,37 @@ ffxReturnCode_t ffxProvider_Nss::Query(ffxContext* context, ffxQueryDescHeader*
         }
         break;
     }
+    case FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINESREADY:
+    {
+        VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
+        VERIFY(*context, FFX_API_RETURN_ERROR_PARAMETER);
+
+        auto                desc             = reinterpret_cast<ffxApiQueryDescNssGetPipelinesReady*>(header);
+        InternalNssContext* internal_context = reinterpret_cast<InternalNssContext*>(*context);
+
+        bool pipelinesReady = false;
+        TRY2(ffxNssContextGetPipelinesReady(&internal_context->context, &pipelinesReady));
+        if (desc->pOutReady != nullptr)
+        {
+            *desc->pOutReady = pipelinesReady;
+        }
+        break;
+    }
+    case FFX_API_QUERY_DESC_TYPE_NSS_GETPIPELINECACHEDATA:
+    {
+        VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
+        VERIFY(*context, FFX_API_RETURN_ERROR_PARAMETER);
+
+        auto                desc             = reinterpret_cast<ffxApiQueryDescNssGetPipelineCacheData*>(header);
+        InternalNssContext* internal_context = reinterpret_cast<InternalNssContext*>(*context);
+        VERIFY(desc->pInOutDataSize, FFX_API_RETURN_ERROR_PARAMETER);
+
+        // A warmup running on another thread adds to the cache, which the backend reads consistently on its own
+        const FfxErrorCode errorCode = ffxNssContextGetPipelineCacheData(&internal_context->context, desc->pOutData, desc->pInOutDataSize);
+        VERIFY(errorCode != FfxErrorCode(FFX_ERROR_INSUFFICIENT_MEMORY), FFX_API_RETURN_ERROR_MEMORY);
+        TRY2(errorCode);
+        break;
+    }
     default:
         return FFX_API_RETURN_ERROR_UNKNOWN_DESCTYPE;
     }
@@ -218,6 +543,93 @@ ffxReturnCode_t ffxProvider_Nss::Query(ffxContext* context, ffxQueryDescHeader*
     return FFX_API_RETURN_OK;
 }
 
+// Converts one view of a dispatch, resolving the resources and final states chained to it
+static ffxReturnCode_t ConvertDispatchDescNss(const InternalNssContext*  internal_context,
+                                              const ffxApiDispatchDescNss* desc,
+                                              FfxNssDispatchDescription& dispatchParameters)
+{
+    ffxApiDispatchDescNssRegisteredResources handles = {};
+    for (const auto* it = desc->header.pNext; it; it = it->pNext)
+    {
+        if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_REGISTERED_RESOURCES)
+        {
+            handles = *reinterpret_cast<const ffxApiDispatchDescNssRegisteredResources*>(it);
+        }
+    }
+
+    for (uint32_t handle : {handles.color, handles.depth, handles.depthTm1, handles.motionVectors, handles.outputTm1, handles.output, handles.debugViews})
+    {
+        VERIFY(handle == 0 || IsRegisteredHandleNss(internal_context, handle), FFX_API_RETURN_ERROR_PARAMETER);
+    }
+
+    dispatchParameters                        = {};
+    dispatchParameters.commandList            = desc->commandList;
+    dispatchParameters.color                  = ResolveResourceNss(handles.color, desc->color);
+    dispatchParameters.depth                  = ResolveResourceNss(handles.depth, desc->depth);
+    dispatchParameters.depthTm1               = ResolveResourceNss(handles.depthTm1, desc->depthTm1);
+    dispatchParameters.motionVectors          = ResolveResourceNss(handles.motionVectors, desc->motionVectors);
+    dispatchParameters.outputTm1              = ResolveResourceNss(handles.outputTm1, desc->outputTm1);
+    dispatchParameters.output                 = ResolveResourceNss(handles.output, desc->output);
+    dispatchParameters.debugViews             = ResolveResourceNss(handles.debugViews, desc->debugViews);
+    dispatchParameters.handles.color          = handles.color;
+    dispatchParameters.handles.depth          = handles.depth;
+    dispatchParameters.handles.depthTm1       = handles.depthTm1;
+    dispatchParameters.handles.motionVectors  = handles.motionVectors;
+    dispatchParameters.handles.outputTm1      = handles.outputTm1;
+    dispatchParameters.handles.output         = handles.output;
+    dispatchParameters.handles.debugViews     = handles.debugViews;
+    dispatchParameters.jitterOffset.x         = desc->jitterOffset.x;
+    dispatchParameters.jitterOffset.y         = desc->jitterOffset.y;
+    dispatchParameters.cameraFar              = desc->cameraFar;
+    dispatchParameters.cameraNear             = desc->cameraNear;
+    dispatchParameters.cameraFovAngleVertical = desc->cameraFovAngleVertical;
+    dispatchParameters.exposure               = desc->exposure;
+    dispatchParameters.motionVectorScale.x    = desc->motionVectorScale.x;
+    dispatchParameters.motionVectorScale.y    = desc->motionVectorScale.y;
+    dispatchParameters.reset                  = desc->reset;
+    dispatchParameters.frameTimeDelta         = desc->frameTimeDelta;
+    dispatchParameters.upscaleSize.width      = desc->upscaleSize.width;
+    dispatchParameters.upscaleSize.height     = desc->upscaleSize.height;
+    dispatchParameters.renderSize.width       = desc->renderSize.width;
+    dispatchParameters.renderSize.height      = desc->renderSize.height;
+    dispatchParameters.flags                  = ConvertDispatchFlagsNss(desc->flags);
+
+    for (const auto* it = desc->header.pNext; it; it = it->pNext)
+    {
+        if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_RESOURCE_STATES)
+        {
+            auto statesDesc                              = reinterpret_cast<const ffxApiDispatchDescNssResourceStates*>(it);
+            dispatchParameters.finalStates.color         = ConvertEnum<FfxResourceStates>(statesDesc->colorFinalState);
+            dispatchParameters.finalStates.depth         = ConvertEnum<FfxResourceStates>(statesDesc->depthFinalState);
+            dispatchParameters.finalStates.depthTm1      = ConvertEnum<FfxResourceStates>(statesDesc->depthTm1FinalState);
+            dispatchParameters.finalStates.motionVectors = ConvertEnum<FfxResourceStates>(statesDesc->motionVectorsFinalState);
+            dispatchParameters.finalStates.outputTm1     = ConvertEnum<FfxResourceStates>(statesDesc->outputTm1FinalState);
+            dispatchParameters.finalStates.output        = ConvertEnum<FfxResourceStates>(statesDesc->outputFinalState);
+            dispatchParameters.finalStates.debugViews    = ConvertEnum<FfxResourceStates>(statesDesc->debugViewsFinalState);
+        }
+        else if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_REGION)
+        {
+            auto regionDesc                       = reinterpret_cast<const ffxApiDispatchDescNssRegion*>(it);
+            dispatchParameters.renderOffset.x     = regionDesc->renderRegion.left;
+            dispatchParameters.renderOffset.y     = regionDesc->renderRegion.top;
+            dispatchParameters.renderSize.width   = regionDesc->renderRegion.width;
+            dispatchParameters.renderSize.height  = regionDesc->renderRegion.height;
+            dispatchParameters.upscaleOffset.x    = regionDesc->upscaleRegion.left;
+            dispatchParameters.upscaleOffset.y    = regionDesc->upscaleRegion.top;
+            dispatchParameters.upscaleSize.width  = regionDesc->upscaleRegion.width;
+            dispatchParameters.upscaleSize.height = regionDesc->upscaleRegion.height;
+        }
+        else if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_GAZE)
+        {
+            auto gazeDesc                   = reinterpret_cast<const ffxApiDispatchDescNssGaze*>(it);
+            dispatchParameters.gazeOffset.x = gazeDesc->gazeOffset.x;
+            dispatchParameters.gazeOffset.y = gazeDesc->gazeOffset.y;
+        }
+    }
+
+    return FFX_API_RETURN_OK;
+}
+
 ffxReturnCode_t ffxProvider_Nss::Dispatch(ffxContext* context, const ffxDispatchDescHeader* header) const
 {
     VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
@@ -227,41 +639,56 @@ ffxReturnCode_t ffxProvider_Nss::Dispatch(ffxContext* context, const ffxDispatch
     InternalNssContext* internal_context = reinterpret_cast<InternalNssContext*>(*context);
     if (internal_context->fpMessage)
     {
-        Validator{internal_context->fpMessage, header}.NoExtensions();
+        Validator{internal_context->fpMessage, header}.AcceptExtensions({FFX_API_DISPATCH_DESC_TYPE_NSS_ASYNC_COMPUTE,
+                                                                         FFX_API_DISPATCH_DESC_TYPE_NSS_RESOURCE_STATES,
+                                                                         FFX_API_DISPATCH_DESC_TYPE_NSS_REGISTERED_RESOURCES,
+                                                                         FFX_API_DISPATCH_DESC_TYPE_NSS_VIEWS,
+                                                                         FFX_API_DISPATCH_DESC_TYPE_NSS_REGION,
+                                                                         FFX_API_DISPATCH_DESC_TYPE_NSS_GAZE});
     }
 
+    std::lock_guard<std::mutex> lock(internal_context->mutex);
     switch (header->type)
     {
     case FFX_API_DISPATCH_DESC_TYPE_NSS:
     {
         auto desc = reinterpret_cast<const ffxApiDispatchDescNss*>(header);
 
-        FfxNssDispatchDescription dispatchParameters = {};
-        dispatchParameters.commandList               = desc->commandList;
-        dispatchParameters.color                     = Convert(desc->color);
-        dispatchParameters.depth                     = Convert(desc->depth);
-        dispatchParameters.depthTm1                  = Convert(desc->depthTm1);
-        dispatchParameters.motionVectors             = Convert(desc->motionVectors);
-        dispatchParameters.outputTm1                 = Convert(desc->outputTm1);
-        dispatchParameters.output                    = Convert(desc->output);
-        dispatchParameters.debugViews                = Convert(desc->debugViews);
-        dispatchParameters.jitterOffset.x            = desc->jitterOffset.x;
-        dispatchParameters.jitterOffset.y            = desc->jitterOffset.y;
-        dispatchParameters.cameraFar                 = desc->cameraFar;
-        dispatchParameters.cameraNear                = desc->cameraNear;
-        dispatchParameters.cameraFovAngleVertical    = desc->cameraFovAngleVertical;
-        dispatchParameters.exposure                  = desc->exposure;
-        dispatchParameters.motionVectorScale.x       = desc->motionVectorScale.x;
-        dispatchParameters.motionVectorScale.y       = desc->motionVectorScale.y;
-        dispatchParameters.reset                     = desc->reset;
-        dispatchParameters.frameTimeDelta            = desc->frameTimeDelta;
-        dispatchParameters.upscaleSize.width         = desc->upscaleSize.width;
-        dispatchParameters.upscaleSize.height        = desc->upscaleSize.height;
-        dispatchParameters.renderSize.width          = desc->renderSize.width;
-        dispatchParameters.renderSize.height         = desc->renderSize.height;
-        dispatchParameters.flags                     = ConvertDispatchFlagsNss(desc->flags);
-
-        TRY2(ffxNssContextDispatch(&internal_context->context, &dispatchParameters));
+        FfxNssDispatchDescription dispatchParameters[FFX_NSS_MAX_VIEW_COUNT] = {};
+        uint32_t                  viewCount                                  = 1;
+        TRY(ConvertDispatchDescNss(internal_context, desc, dispatchParameters[0]));
+
+        FfxAsyncComputeDescription asyncCompute = {};
+        for (const auto* it = header->pNext; it; it = it->pNext)
+        {
+            if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_ASYNC_COMPUTE)
+            {
+                auto asyncDesc                           = reinterpret_cast<const ffxApiDispatchDescNssAsyncCompute*>(it);
+                asyncCompute.queue                       = asyncDesc->queue;
+                asyncCompute.queueFamilyIndex            = asyncDesc->queueFamilyIndex;
+                asyncCompute.commandListQueueFamilyIndex = asyncDesc->commandListQueueFamilyIndex;
+                asyncCompute.waitSemaphore               = asyncDesc->waitSemaphore;
+                asyncCompute.waitValue                   = asyncDesc->waitValue;
+                asyncCompute.signalSemaphore             = asyncDesc->signalSemaphore;
+                asyncCompute.signalValue                 = asyncDesc->signalValue;
+                asyncCompute.acquireCommandList          = asyncDesc->acquireCommandList;
+                dispatchParameters[0].asyncCompute       = &asyncCompute;
+            }
+            else if (it->type == FFX_API_DISPATCH_DESC_TYPE_NSS_VIEWS)
+            {
+                auto viewsDesc = reinterpret_cast<const ffxApiDispatchDescNssViews*>(it);
+                VERIFY(viewsDesc->additionalViewCount < FFX_NSS_MAX_VIEW_COUNT, FFX_API_RETURN_ERROR_PARAMETER);
+                VERIFY(viewsDesc->additionalViewCount == 0 || viewsDesc->pAdditionalViews, FFX_API_RETURN_ERROR_PARAMETER);
+
+                for (uint32_t i = 0; i < viewsDesc->additionalViewCount; ++i)
+                {
+                    TRY(ConvertDispatchDescNss(internal_context, &viewsDesc->pAdditionalViews[i], dispatchParameters[1 + i]));
+                }
+                viewCount = 1 + viewsDesc->additionalViewCount;
+            }
+        }
+
+        TRY2(ffxNssContextDispatchViews(&internal_context->context, dispatchParameters, viewCount));
         break;
     }
     default:
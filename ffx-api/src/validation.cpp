@@ -48,6 +48,7 @@ static std::unordered_map<uint64_t, const char*> EnumNameMap{
     MAP_ENUM_NAME(FFX_API_CONFIGURE_DESC_TYPE_FGSWAPCHAIN_REGISTERUIRESOURCE_VK),
     MAP_ENUM_NAME(FFX_API_CONFIGURE_DESC_TYPE_GLOBALDEBUG1),
     MAP_ENUM_NAME(FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK),
+    MAP_ENUM_NAME(FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_QUEUE_FAMILY),
     MAP_ENUM_NAME(FFX_API_CREATE_CONTEXT_DESC_TYPE_FG),
     MAP_ENUM_NAME(FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK),
     MAP_ENUM_NAME(FFX_API_CREATE_CONTEXT_DESC_TYPE_FSR_UPSCALE),
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef GPU_NSS_BILINEAR_UPSCALE_H
+#define GPU_NSS_BILINEAR_UPSCALE_H
+
+// Cheap stand-in for the network while its pipelines are still being compiled.
+void BilinearUpscale(int32_t2 output_pixel)
+{
+    if (any(greaterThanEqual(output_pixel, OutputDims())))
+    {
+        return;
+    }
+
+    // Undo the jitter so the image doesn't shake while the fallback is active.
+    float2 uv = (float2(output_pixel) + 0.5) * InvOutputDims() - JitterOffsetUv();
+
+    WriteUpsampledColour(output_pixel, half3(SampleInputColorJittered(uv).rgb));
+}
+
+#endif  // GPU_NSS_BILINEAR_UPSCALE_H
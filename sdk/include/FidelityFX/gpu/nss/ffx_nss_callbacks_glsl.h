@@ -45,12 +45,26 @@
 #include "ffx_core.h"
 #include "ffx_nss_common_glsl.h"
 
+// Tensors hold int8 values with the quantization parameters of the model, or fp16 values as they are.
 #if QUANTIZED
 #define tensor_t    int8_t
 #define tensorVec_t int8_t4
+
+#define QuantizeTensor(f, quant_params)   Quantize(f, quant_params)
+#define DequantizeTensor(i, quant_params) Dequantize(i, quant_params)
 #else
-#define tensor_t    float
-#define tensorVec_t float4
+#define tensor_t    float16_t
+#define tensorVec_t f16vec4
+
+#define QuantizeTensor(f, quant_params)   tensorVec_t(f)
+#define DequantizeTensor(i, quant_params) (i)
+#endif
+
+// Without tensor support the tensors are storage buffers of the same NHWC layout holding a single view, which are read and
+// written a word of 4 int8 channels at a time. Only quantized contexts use them, and buffers can't be aliased as images.
+#if TENSORS_AS_BUFFERS
+#undef ALIAS_OUTPUT_TENSORS_AS_IMAGES
+#define ALIAS_OUTPUT_TENSORS_AS_IMAGES 0
 #endif
 
 #if REVERSE_Z
@@ -81,9 +95,9 @@ struct PreprocessTensorElementInternal
 
 struct TensorElement
 {
-    int8_t4 wh_rgb_col_r;       // warped_history.rgb, jittered_colour.r
-    int8_t4 col_gb_dm_fback_r;  // jittered_colour.gb, disocclusion mask, feedback.r
-    int8_t4 fback_gba_ld;       // feedback.gba, luma derivative
+    tensorVec_t wh_rgb_col_r;       // warped_history.rgb, jittered_colour.r
+    tensorVec_t col_gb_dm_fback_r;  // jittered_colour.gb, disocclusion mask, feedback.r
+    tensorVec_t fback_gba_ld;       // feedback.gba, luma derivative
 };
 
 struct BilinearSamplingData
@@ -122,32 +136,113 @@ BilinearSamplingData GetBilinearSamplingData(float2 fUv, int32_t2 iSize)
     return data;
 }
 
+///////////////////////////////////////////////
+// quantization of the int8 tensors
+///////////////////////////////////////////////
+// real = (q - zero point) * scale. The host specializes them with the quantization of the model, in the
+// order of NssQuantizationConstants; the defaults leave the values unchanged.
+layout(constant_id = 0) const float NSS_INPUT_QUANT_SCALE          = 1.0;
+layout(constant_id = 1) const float NSS_INPUT_QUANT_ZERO_POINT     = 0.0;
+layout(constant_id = 2) const float NSS_FEEDBACK_QUANT_SCALE       = 1.0;
+layout(constant_id = 3) const float NSS_FEEDBACK_QUANT_ZERO_POINT  = 0.0;
+layout(constant_id = 4) const float NSS_TEMPORAL_QUANT_SCALE       = 1.0;
+layout(constant_id = 5) const float NSS_TEMPORAL_QUANT_ZERO_POINT  = 0.0;
+layout(constant_id = 6) const float NSS_K0_QUANT_SCALE             = 1.0;
+layout(constant_id = 7) const float NSS_K0_QUANT_ZERO_POINT        = 0.0;
+layout(constant_id = 8) const float NSS_K1_QUANT_SCALE             = 1.0;
+layout(constant_id = 9) const float NSS_K1_QUANT_ZERO_POINT        = 0.0;
+layout(constant_id = 10) const float NSS_K2_QUANT_SCALE            = 1.0;
+layout(constant_id = 11) const float NSS_K2_QUANT_ZERO_POINT       = 0.0;
+layout(constant_id = 12) const float NSS_K3_QUANT_SCALE            = 1.0;
+layout(constant_id = 13) const float NSS_K3_QUANT_ZERO_POINT       = 0.0;
+
+// The aliased images read the int8 outputs as snorm, q / 127, so their parameters are rescaled.
+// Only the input tensor can't be aliased through a single image, it is always read as int.
+#if ALIAS_OUTPUT_TENSORS_AS_IMAGES
+#define NSS_OUTPUT_QUANT_PARAMS(scale, zero_point) half2(half((scale) * 127.0), half((zero_point) / 127.0))
+#else
+#define NSS_OUTPUT_QUANT_PARAMS(scale, zero_point) half2(half(scale), half(zero_point))
+#endif
+
+// .x = 1 / scale, .y = zero point
+half2 InputQuantParams()
+{
+    return half2(half(1.0 / NSS_INPUT_QUANT_SCALE), half(NSS_INPUT_QUANT_ZERO_POINT));
+}
+
+// .x = scale, .y = zero point
+half2 InputDequantParams()
+{
+    return half2(half(NSS_INPUT_QUANT_SCALE), half(NSS_INPUT_QUANT_ZERO_POINT));
+}
+
+half2 FeedbackQuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_FEEDBACK_QUANT_SCALE, NSS_FEEDBACK_QUANT_ZERO_POINT);
+}
+
+half2 K0QuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_K0_QUANT_SCALE, NSS_K0_QUANT_ZERO_POINT);
+}
+
+half2 K1QuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_K1_QUANT_SCALE, NSS_K1_QUANT_ZERO_POINT);
+}
+
+half2 K2QuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_K2_QUANT_SCALE, NSS_K2_QUANT_ZERO_POINT);
+}
+
+half2 K3QuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_K3_QUANT_SCALE, NSS_K3_QUANT_ZERO_POINT);
+}
+
+half2 TemporalQuantParams()
+{
+    return NSS_OUTPUT_QUANT_PARAMS(NSS_TEMPORAL_QUANT_SCALE, NSS_TEMPORAL_QUANT_ZERO_POINT);
+}
+
 ///////////////////////////////////////////////
 // declare CBs and CB accessors
 ///////////////////////////////////////////////
 #if defined(NSS_BIND_CB_NSS)
+// The push constant permutation reads the same block from the push constant range, which saves
+// the uniform buffer allocation and descriptor write per pass. Only used with 16-bit constants,
+// as the 32-bit layout does not fit the push constant size most devices guarantee.
+#if PUSH_CONSTANTS
+layout(push_constant, std140) uniform cbNSS_t
+#else
 layout(set = 0, binding = NSS_BIND_CB_NSS, std140) uniform cbNSS_t
+#endif
 {
     // ─────────────── 32bit precision objects ───────────────
-    float4   _DeviceToViewDepth;  //  16 B
-    float4   _JitterOffset;       //  16 B (.xy = pixels, .zw = uvs)
-    float4   _JitterOffsetTm1;    //  16 B (.xy = pixels, .zw = uvs)
-    float4   _ScaleFactor;        //  16 B (.xy = scale, .zw = inv scale)
-    int32_t2 _OutputDims;         //   8 B
-    int32_t2 _InputDims;          //   8 B
-    float2   _InvOutputDims;      //   8 B
-    float2   _InvInputDims;       //   8 B
-    float2   _MotionVectorScale;  //   8 B
-    int32_t2 _UnpaddedInputDims;  //   8 B
+    float4   _DeviceToViewDepth;   //  16 B
+    float4   _JitterOffset;        //  16 B (.xy = pixels, .zw = uvs)
+    float4   _JitterOffsetTm1;     //  16 B (.xy = pixels, .zw = uvs)
+    float4   _ScaleFactor;         //  16 B (.xy = scale, .zw = inv scale)
+    int32_t2 _OutputDims;          //   8 B
+    int32_t2 _InputDims;           //   8 B
+    float2   _InvOutputDims;       //   8 B
+    float2   _InvInputDims;        //   8 B
+    float2   _MotionVectorScale;   //   8 B
+    int32_t2 _UnpaddedInputDims;   //   8 B
+    int32_t2 _UnpaddedOutputDims;  //   8 B
+    int32_t2 _InputOffset;         //   8 B  (input pixel of the first padded input pixel)
+    int32_t4 _OutputRegion;        //  16 B  (.xy = first padded output pixel written, .zw = output pixel it lands on)
+    int32_t4 _FoveaRect;           //  16 B  (.xy = first output pixel of the fovea, .zw = one past the last, empty unless foveated)
 
     // ───────────────  16bit precision objects  ────────────────
-    half4    _QuantParamsSNORM;    //   8 B  (.xy for quantize, .zw for dequantize)
-    half4    _QuantParamsSINT;     //   8 B  (.xy for quantize, .zw for dequantize)
     half4    _MotionDisThreshPad;  //   8 B  (.xyzw = motion/disocclusion thresholds)
     half2    _Exposure;            //   4 B  (.x = exposure, .y = 1/exp)
     int16_t2 _IndexModulo;         //   4 B
     int16_t2 _LutOffset;           //   4 B
     half     _NotHistoryReset;     //   2 B
+    uint32_t _ViewIndex;           //   4 B  (batch of the view in the shared tensors)
+    uint32_t _ReuseCoefficients;   //   4 B  (1 when the network was skipped and its coefficients are warped)
 }
 cbNSS;
 
@@ -215,37 +310,30 @@ int32_t2 UnpaddedInputDims()
     return cbNSS._UnpaddedInputDims;
 }
 
-float2 MotionVectorScale()
+int32_t2 UnpaddedOutputDims()
 {
-    return cbNSS._MotionVectorScale.xy;
+    return cbNSS._UnpaddedOutputDims;
 }
 
-half4 QuantParamsSNORM()
+int32_t2 InputOffset()
 {
-    return cbNSS._QuantParamsSNORM;
+    return cbNSS._InputOffset;
 }
 
-half4 QuantParamsSINT()
+int32_t4 OutputRegion()
 {
-    return cbNSS._QuantParamsSINT;
+    return cbNSS._OutputRegion;
 }
 
-half2 InputQuantParams()
+int32_t4 FoveaRect()
 {
-    return cbNSS._QuantParamsSINT.xy;
+    return cbNSS._FoveaRect;
 }
 
-#if ALIAS_OUTPUT_TENSORS_AS_IMAGES
-half2 FeedbackQuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-#else
-half2 FeedbackQuantParams()
+float2 MotionVectorScale()
 {
-    return cbNSS._QuantParamsSINT.zw;
+    return cbNSS._MotionVectorScale.xy;
 }
-#endif
 
 half Exposure()
 {
@@ -287,66 +375,24 @@ int16_t2 IndexModulo()
     return cbNSS._IndexModulo;
 }
 
-#if ALIAS_OUTPUT_TENSORS_AS_IMAGES
-half2 K0QuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-
-half2 K1QuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-
-half2 K2QuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-
-half2 K3QuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-
-half2 TemporalQuantParams()
-{
-    return cbNSS._QuantParamsSNORM.zw;
-}
-#else
-half2 K0QuantParams()
-{
-    return cbNSS._QuantParamsSINT.zw;
-}
-
-half2 K1QuantParams()
-{
-    return cbNSS._QuantParamsSINT.zw;
-}
-
-half2 K2QuantParams()
-{
-    return cbNSS._QuantParamsSINT.zw;
-}
-
-half2 K3QuantParams()
+int16_t2 LutOffset()
 {
-    return cbNSS._QuantParamsSINT.zw;
+    return cbNSS._LutOffset;
 }
 
-half2 TemporalQuantParams()
+half NotHistoryReset()
 {
-    return cbNSS._QuantParamsSINT.zw;
+    return cbNSS._NotHistoryReset;
 }
-#endif
 
-int16_t2 LutOffset()
+uint32_t ViewIndex()
 {
-    return cbNSS._LutOffset;
+    return cbNSS._ViewIndex;
 }
 
-half NotHistoryReset()
+bool ReuseCoefficients()
 {
-    return cbNSS._NotHistoryReset;
+    return cbNSS._ReuseCoefficients != 0;
 }
 
 float GetViewSpaceDepth(float fDeviceDepth)
@@ -374,54 +420,55 @@ layout(set = 0, binding = 1001) uniform sampler s_LinearClamp;
 //=========================================================================
 // Helper functions for reading tensors
 //=========================================================================
-#if QUANTIZED
+// Views dispatched together are stacked in the batch dimension of the tensors
+#if defined(NSS_BIND_CB_NSS)
+#define TENSOR_BATCH ViewIndex()
+#else
+#define TENSOR_BATCH 0
+#endif
+
+// Bilinear filtering of 4 channel quads, for tensors which can't be sampled by hardware.
+#define DECLARE_SAMPLE_QUAD_BILINEAR(TENSORNAME, tensor_dims)                                \
+    half4 Sample##TENSORNAME##Tensor(float2 uv, half2 quant_params)                          \
+    {                                                                                        \
+        uint32_t2 dims  = tensor_dims;                                                       \
+        float2    coord = uv * float2(dims) - 0.5;                                           \
+        uint32_t2 f     = min(dims - 1U, uint32_t2(max(float2(0.0), floor(coord))));         \
+        uint32_t2 c     = min(dims - 1U, uint32_t2(max(float2(0.0), ceil(coord))));          \
+        float2    frac  = fract(coord);                                                      \
+        float4    c00   = Load##TENSORNAME##Quad(int32_t2(f), quant_params);                 \
+        float4    c01   = Load##TENSORNAME##Quad(int32_t2(f.x, c.y), quant_params);          \
+        float4    c10   = Load##TENSORNAME##Quad(int32_t2(c.x, f.y), quant_params);          \
+        float4    c11   = Load##TENSORNAME##Quad(int32_t2(c), quant_params);                 \
+        float4    c0    = mix(c00, c01, frac.y);                                             \
+        float4    c1    = mix(c10, c11, frac.y);                                             \
+        return half4(mix(c0, c1, frac.x));                                                   \
+    }
+
 #define DECLARE_SAMPLE_TENSOR(TENSORNAME, tensor_variable)                                                 \
     half4 Load##TENSORNAME##Quad(int32_t2 coord, half2 quant_params)                                       \
     {                                                                                                      \
         tensor_t a[4];                                                                                     \
-        tensorReadARM(tensor_variable, uint[](0, coord.y, coord.x, 0), a);                                 \
+        tensorReadARM(tensor_variable, uint[](TENSOR_BATCH, coord.y, coord.x, 0), a);                      \
         tensorVec_t v = tensorVec_t(a[0], a[1], a[2], a[3]);                                               \
-        return Dequantize(v, quant_params);                                                                \
+        return half4(DequantizeTensor(v, quant_params));                                                   \
     }                                                                                                      \
-    half4 Sample##TENSORNAME##Tensor(float2 uv, half2 quant_params)                                        \
-    {                                                                                                      \
-        uint32_t2 dims  = uint32_t2(tensorSizeARM(tensor_variable, 2), tensorSizeARM(tensor_variable, 1)); \
-        float2    coord = uv * float2(dims) - 0.5;                                                         \
-        uint32_t2 f     = min(dims - 1U, uint32_t2(max(float2(0.0), floor(coord))));                       \
-        uint32_t2 c     = min(dims - 1U, uint32_t2(max(float2(0.0), ceil(coord))));                        \
-        float2    frac  = fract(coord);                                                                    \
-        float4    c00   = Load##TENSORNAME##Quad(int32_t2(f), quant_params);                               \
-        float4    c01   = Load##TENSORNAME##Quad(int32_t2(f.x, c.y), quant_params);                        \
-        float4    c10   = Load##TENSORNAME##Quad(int32_t2(c.x, f.y), quant_params);                        \
-        float4    c11   = Load##TENSORNAME##Quad(int32_t2(c), quant_params);                               \
-        float4    c0    = mix(c00, c01, frac.y);                                                           \
-        float4    c1    = mix(c10, c11, frac.y);                                                           \
-        return half4(mix(c0, c1, frac.x));                                                                 \
-    }
-#else
-#define DECLARE_SAMPLE_TENSOR(TENSORNAME, tensor_variable)                                                 \
+    DECLARE_SAMPLE_QUAD_BILINEAR(TENSORNAME, uint32_t2(tensorSizeARM(tensor_variable, 2), tensorSizeARM(tensor_variable, 1)))
+
+#if TENSORS_AS_BUFFERS && defined(NSS_BIND_CB_NSS)
+// Returns the index of the word holding channels [channel, channel + 4) of a pixel in a buffer at the input resolution.
+int32_t TensorBufferWord(int32_t2 coord, int32_t channel, int32_t channels)
+{
+    return ((coord.y * InputDims().x + coord.x) * channels + channel) / 4;
+}
+
+#define DECLARE_SAMPLE_BUFFER(TENSORNAME, buffer_variable)                                                 \
     half4 Load##TENSORNAME##Quad(int32_t2 coord, half2 quant_params)                                       \
     {                                                                                                      \
-        tensor_t a[4];                                                                                     \
-        tensorReadARM(tensor_variable, uint[](0, coord.y, coord.x, 0), a);                                 \
-        tensorVec_t v = tensorVec_t(a[0], a[1], a[2], a[3]);                                               \
-        return v;                                                                                          \
+        tensorVec_t v = tensorVec_t(unpack8(buffer_variable.data[TensorBufferWord(coord, 0, 4)]));         \
+        return half4(DequantizeTensor(v, quant_params));                                                   \
     }                                                                                                      \
-    half4 Sample##TENSORNAME##Tensor(float2 uv, half2 quant_params)                                        \
-    {                                                                                                      \
-        uint32_t2 dims  = uint32_t2(tensorSizeARM(tensor_variable, 2), tensorSizeARM(tensor_variable, 1)); \
-        float2    coord = uv * float2(dims) - 0.5;                                                         \
-        uint32_t2 f     = min(dims - 1U, uint32_t2(max(float2(0.0), floor(coord))));                       \
-        uint32_t2 c     = min(dims - 1U, uint32_t2(max(float2(0.0), ceil(coord))));                        \
-        float2    frac  = fract(coord);                                                                    \
-        float4    c00   = Load##TENSORNAME##Quad(int32_t2(f), quant_params);                               \
-        float4    c01   = Load##TENSORNAME##Quad(int32_t2(f.x, c.y), quant_params);                        \
-        float4    c10   = Load##TENSORNAME##Quad(int32_t2(c.x, f.y), quant_params);                        \
-        float4    c11   = Load##TENSORNAME##Quad(int32_t2(c), quant_params);                               \
-        float4    c0    = mix(c00, c01, frac.y);                                                           \
-        float4    c1    = mix(c10, c11, frac.y);                                                           \
-        return half4(mix(c0, c1, frac.x));                                                                 \
-    }
+    DECLARE_SAMPLE_QUAD_BILINEAR(TENSORNAME, uint32_t2(InputDims()))
 #endif
 
 //=========================================================================
@@ -498,6 +545,32 @@ void StorePaddedDepthTm1(int32_t2 coord, float depth)
 }
 #endif
 
+//-------------------------------------------------------------------------
+// Fused padding: mirror padded coordinates back into the unpadded inputs
+//-------------------------------------------------------------------------
+#if FUSED_PADDING
+// Reflects a pixel of the padded input space about the unpadded edge, matching ApplyMirrorPadding.
+// A region of interest is offset into the inputs first, its halo only mirrors past the edges of the inputs.
+int32_t2 PaddedToInputPixel(int32_t2 pixel)
+{
+    const int32_t2 dims = UnpaddedInputDims();
+    pixel += InputOffset();
+    pixel = max(pixel, -1 - pixel);
+    return max(min(pixel, 2 * dims - 1 - pixel), int32_t2(0));
+}
+
+// Reflects a uv of the padded input space about the unpadded edge and rescales it to the unpadded input.
+float2 PaddedToInputUv(float2 uv)
+{
+    const float2 dims  = float2(UnpaddedInputDims());
+    const float2 pixel = abs(uv * float2(InputDims()) + float2(InputOffset()));
+    return min(pixel, 2.0f * dims - pixel) / dims;
+}
+#else
+#define PaddedToInputPixel(pixel) (pixel)
+#define PaddedToInputUv(uv)       (uv)
+#endif
+
 //=========================================================================
 // Common Resources for both pre-process and post-process
 //=========================================================================
@@ -511,17 +584,17 @@ layout(set = 0, binding = NSS_BIND_SRV_INPUT_COLOR_JITTERED) uniform mediump tex
 
 FfxFloat32x4 LoadInputColorJittered(int32_t2 iPxPos)
 {
-    return texelFetch(r_input_color_jittered, iPxPos, 0);
+    return texelFetch(r_input_color_jittered, PaddedToInputPixel(iPxPos), 0);
 }
 
 FfxFloat32x4 SampleInputColorJittered(FfxFloat32x2 fUV)
 {
-    return textureLod(sampler2D(r_input_color_jittered, s_LinearClamp), fUV, 0);
+    return textureLod(sampler2D(r_input_color_jittered, s_LinearClamp), PaddedToInputUv(fUV), 0);
 }
 
 half3 LoadColour(int32_t2 pixel)
 {
-    return Tonemap(SafeColour(half3(texelFetch(_ColourTex, pixel, 0).rgb) * Exposure()));
+    return Tonemap(SafeColour(half3(texelFetch(_ColourTex, PaddedToInputPixel(pixel), 0).rgb) * Exposure()));
 }
 
 #endif
@@ -535,7 +608,7 @@ layout(set = 0, binding = NSS_BIND_SRV_INPUT_MOTION_VECTORS) uniform mediump tex
 
 half2 LoadMotion(int32_t2 pixel)
 {
-    return half2(texelFetch(_InputMotionTex, pixel, 0).rg * MotionVectorScale());
+    return half2(texelFetch(_InputMotionTex, PaddedToInputPixel(pixel), 0).rg * MotionVectorScale());
 }
 
 #endif  // #if defined(NSS_BIND_SRV_INPUT_MOTION_VECTORS)
@@ -666,7 +739,7 @@ int32_t2 LoadDepthNearestDepthOffsetTm1(int32_t2 pixel)
 // We want to bilinearly sample this tensor:
 //  1. when it is bound as an image, we can use a sampler.
 //  2. when it is bound as a tensorARM or buffer, we need to manually load the quad positions and lerp.
-// Additionally, the model can be quantized, which results in 2 variants per permutation, resulting in 6 permutations.
+// Additionally, the model can be quantized to int8 or run in fp16, which results in 2 variants per permutation.
 //-------------------------------------------------------------------------
 #if defined(NSS_BIND_SRV_FEEDBACK_TM1_TENSOR)
 #if ALIAS_OUTPUT_TENSORS_AS_IMAGES
@@ -675,13 +748,23 @@ layout(set = 0, binding = NSS_BIND_SRV_FEEDBACK_TM1_TENSOR) uniform lowp texture
 
 half4 WarpFeedback(float2 uv)
 {
-    return Dequantize(half4(textureLod(_FeedbackTensor, uv, 0)), FeedbackQuantParams()) * NotHistoryReset();
+    return DequantizeTensor(half4(textureLod(_FeedbackTensor, uv, 0)), FeedbackQuantParams()) * NotHistoryReset();
 }
 
+#else
+#if TENSORS_AS_BUFFERS
+// --- bind as storage buffer, manual load of the packed channels ---
+layout(set = 0, binding = NSS_BIND_SRV_FEEDBACK_TM1_TENSOR, std430) readonly buffer PrevFeedbackTensor_t
+{
+    int32_t data[];
+}
+r_prev_feedback_tensor;
+DECLARE_SAMPLE_BUFFER(Feedback, r_prev_feedback_tensor)
 #else
 // --- bind as GL ARM tensor, manual load via tensorReadARM ---
 layout(set = 0, binding = NSS_BIND_SRV_FEEDBACK_TM1_TENSOR) uniform readonly tensorARM<tensor_t, 4> r_prev_feedback_tensor;
 DECLARE_SAMPLE_TENSOR(Feedback, r_prev_feedback_tensor)
+#endif
 
 half4 WarpFeedback(float2 uv)
 {
@@ -769,12 +852,12 @@ layout(set = 0, binding = NSS_BIND_SRV_INPUT_DEPTH_TM1) uniform highp texture2D
 
 FfxFloat32 LoadPrevDepth(int32_t2 iPxPos)
 {
-    return texelFetch(r_prev_depth, iPxPos, 0).r;
+    return texelFetch(r_prev_depth, PaddedToInputPixel(iPxPos), 0).r;
 }
 
 FfxFloat32 SamplePrevDepth(FfxFloat32x2 fUV)
 {
-    return textureLod(sampler2D(r_prev_depth, s_LinearClamp), fUV, 0.0).r;
+    return textureLod(sampler2D(r_prev_depth, s_LinearClamp), PaddedToInputUv(fUV), 0.0).r;
 }
 
 // declaration
@@ -784,7 +867,16 @@ void GatherReconstructedPreviousDepthRQuad(float2 fUV, inout float4 depthQuad)
 {
     int32_t2 offset    = LoadDepthNearestDepthOffsetTm1(int32_t2(fUV * InputDims()));
     float2   offset_uv = float2(offset) * InvInputDims();
-    depthQuad          = textureGather(_DepthTm1Tex, fUV + offset_uv, 0).wzxy;
+#if FUSED_PADDING
+    // the gather footprint may straddle the mirror edge, so fetch the quad texel by texel in .wzxy order
+    int32_t2 base = int32_t2(floor((fUV + offset_uv) * float2(InputDims()) - 0.5f));
+    depthQuad     = float4(LoadPrevDepth(base),
+                       LoadPrevDepth(base + int32_t2(1, 0)),
+                       LoadPrevDepth(base + int32_t2(0, 1)),
+                       LoadPrevDepth(base + int32_t2(1, 1)));
+#else
+    depthQuad = textureGather(_DepthTm1Tex, fUV + offset_uv, 0).wzxy;
+#endif
 }
 
 FfxFloat32x2 ComputeNdc(FfxFloat32x2 fPxPos, int32_t2 iSize)
@@ -892,12 +984,12 @@ layout(set = 0, binding = NSS_BIND_SRV_INPUT_DEPTH) uniform highp texture2D r_in
 
 FfxFloat32 LoadInputDepth(int32_t2 iPxPos)
 {
-    return texelFetch(r_input_depth, iPxPos, 0).r;
+    return texelFetch(r_input_depth, PaddedToInputPixel(iPxPos), 0).r;
 }
 
 FfxFloat32 SampleInputDepth(FfxFloat32x2 fUV)
 {
-    return textureLod(sampler2D(r_input_depth, s_PointClamp), fUV, 0.0).r;
+    return textureLod(sampler2D(r_input_depth, s_PointClamp), PaddedToInputUv(fUV), 0.0).r;
 }
 
 // motion vector dilation code adapted from Unity's TAA implementation
@@ -905,10 +997,10 @@ highp FfxFloat32x2 GetClosestFragment(highp FfxFloat32x2 uv, highp FfxFloat32 de
 {
     highp FfxFloat32x2 k = InvOutputDims();  // output texel size
 
-    highp FfxFloat32x4 neighborhood = FfxFloat32x4(textureLod(sampler2D(r_input_depth, s_PointClamp), uv - k, 0).x,
-                                                   textureLod(sampler2D(r_input_depth, s_PointClamp), uv + FfxFloat32x2(k.x, -k.y), 0).x,
-                                                   textureLod(sampler2D(r_input_depth, s_PointClamp), uv + FfxFloat32x2(-k.x, k.y), 0).x,
-                                                   textureLod(sampler2D(r_input_depth, s_PointClamp), uv + k, 0).x);
+    highp FfxFloat32x4 neighborhood = FfxFloat32x4(SampleInputDepth(uv - k),
+                                                   SampleInputDepth(uv + FfxFloat32x2(k.x, -k.y)),
+                                                   SampleInputDepth(uv + FfxFloat32x2(-k.x, k.y)),
+                                                   SampleInputDepth(uv + k));
 
 #ifdef REVERSE_Z
 #define COMPARE_DEPTH(a, b) step(b, a)
@@ -951,6 +1043,17 @@ void FindNearestDepth(int32_t2 iPxPos, int32_t2 iPxSize, out float fNearestDepth
     // optimize by using textureGather (with textureGather, we can use 4 sample count instead of 9)
     // pull out the depth loads to allow SC to batch them
     float depth[9];
+#if FUSED_PADDING
+    depth[0] = float(LoadInputDepth(iPxPos + int32_t2(+0, +0).yx));
+    depth[1] = float(LoadInputDepth(iPxPos + int32_t2(+1, +0).yx));
+    depth[2] = float(LoadInputDepth(iPxPos + int32_t2(+0, +1).yx));
+    depth[3] = float(LoadInputDepth(iPxPos + int32_t2(+0, -1).yx));
+    depth[4] = float(LoadInputDepth(iPxPos + int32_t2(-1, +0).yx));
+    depth[5] = float(LoadInputDepth(iPxPos + int32_t2(-1, +1).yx));
+    depth[6] = float(LoadInputDepth(iPxPos + int32_t2(+1, +1).yx));
+    depth[7] = float(LoadInputDepth(iPxPos + int32_t2(-1, -1).yx));
+    depth[8] = float(LoadInputDepth(iPxPos + int32_t2(+1, -1).yx));
+#else
     depth[0] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(+0, +0).yx).r);
     depth[1] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(+1, +0).yx).r);
     depth[2] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(+0, +1).yx).r);
@@ -960,6 +1063,7 @@ void FindNearestDepth(int32_t2 iPxPos, int32_t2 iPxSize, out float fNearestDepth
     depth[6] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(+1, +1).yx).r);
     depth[7] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(-1, -1).yx).r);
     depth[8] = float(texelFetchOffset(_DepthTex, iPxPos, 0, int32_t2(+1, -1).yx).r);
+#endif
 
     // find closest depth
     fNearestDepth       = depth[0];
@@ -1024,30 +1128,68 @@ void WriteNearestDepthOffset(int32_t2 pixel, uint8_t offset)
 //-------------------------------------------------------------------------
 #if defined(NSS_BIND_UAV_PREPROCESS_INPUT_TENSOR)
 
+#if TENSORS_AS_BUFFERS
+layout(set = 0, binding = NSS_BIND_UAV_PREPROCESS_INPUT_TENSOR, std430) buffer PreprocessTensor_t
+{
+    int32_t data[];
+}
+rw_preprocessed_tensor;
+
+void WriteToTensor(int32_t2 outputPixel, half3 input_colour, half3 history, half disocclusion_mask, half luma_derivative, half4 temporal_feedback)
+{
+    TensorElement te;
+    te.wh_rgb_col_r      = QuantizeTensor(half4(history.rgb, input_colour.r), InputQuantParams());
+    te.col_gb_dm_fback_r = QuantizeTensor(half4(input_colour.gb, disocclusion_mask, temporal_feedback.r), InputQuantParams());
+    te.fback_gba_ld      = QuantizeTensor(half4(temporal_feedback.gba, luma_derivative), InputQuantParams());
+
+    // The 12 channels of a pixel are 3 consecutive words.
+    const int32_t word                   = TensorBufferWord(outputPixel, 0, 12);
+    rw_preprocessed_tensor.data[word]     = pack32(int8_t4(te.wh_rgb_col_r));
+    rw_preprocessed_tensor.data[word + 1] = pack32(int8_t4(te.col_gb_dm_fback_r));
+    rw_preprocessed_tensor.data[word + 2] = pack32(int8_t4(te.fback_gba_ld));
+}
+
+PreprocessTensorElement LoadPreprocessTensor(int32_t2 coord)
+{
+    const int32_t word = TensorBufferWord(coord, 0, 12);
+
+    PreprocessTensorElementInternal f;
+    f.wh_rgb_col_r      = tensorVec_t(unpack8(rw_preprocessed_tensor.data[word]));
+    f.col_gb_dm_fback_r = tensorVec_t(unpack8(rw_preprocessed_tensor.data[word + 1]));
+    f.fback_gba_ld      = tensorVec_t(unpack8(rw_preprocessed_tensor.data[word + 2]));
+
+    PreprocessTensorElement f_dequantized;
+    f_dequantized.wh_rgb_col_r      = FfxFloat32x4(DequantizeTensor(f.wh_rgb_col_r, InputDequantParams()));
+    f_dequantized.col_gb_dm_fback_r = FfxFloat32x4(DequantizeTensor(f.col_gb_dm_fback_r, InputDequantParams()));
+    f_dequantized.fback_gba_ld      = FfxFloat32x4(DequantizeTensor(f.fback_gba_ld, InputDequantParams()));
+    return f_dequantized;
+}
+
+#else
 layout(set = 0, binding = NSS_BIND_UAV_PREPROCESS_INPUT_TENSOR) uniform tensorARM<tensor_t, 4> rw_preprocessed_tensor;
 #define _PreprocessTensor rw_preprocessed_tensor
 
 void WriteToTensor(int32_t2 outputPixel, half3 input_colour, half3 history, half disocclusion_mask, half luma_derivative, half4 temporal_feedback)
 {
     TensorElement te;
-    te.wh_rgb_col_r      = Quantize(half4(history.rgb, input_colour.r), InputQuantParams());
-    te.col_gb_dm_fback_r = Quantize(half4(input_colour.gb, disocclusion_mask, temporal_feedback.r), InputQuantParams());
-    te.fback_gba_ld      = Quantize(half4(temporal_feedback.gba, luma_derivative), InputQuantParams());
+    te.wh_rgb_col_r      = QuantizeTensor(half4(history.rgb, input_colour.r), InputQuantParams());
+    te.col_gb_dm_fback_r = QuantizeTensor(half4(input_colour.gb, disocclusion_mask, temporal_feedback.r), InputQuantParams());
+    te.fback_gba_ld      = QuantizeTensor(half4(temporal_feedback.gba, luma_derivative), InputQuantParams());
 
     // currently we have to split this into two calls to tensorWriteARM() since malisc only supports a limited number of data sizes.
     // See https://jira.arm.com/browse/MPGCOMP-18646
-    int8_t t0[8] = {te.wh_rgb_col_r.x,
-                    te.wh_rgb_col_r.y,
-                    te.wh_rgb_col_r.z,
-                    te.wh_rgb_col_r.w,
-                    te.col_gb_dm_fback_r.x,
-                    te.col_gb_dm_fback_r.y,
-                    te.col_gb_dm_fback_r.z,
-                    te.col_gb_dm_fback_r.w};
-    tensorWriteARM(_PreprocessTensor, uint[](0, outputPixel.y, outputPixel.x, 0), t0);
+    tensor_t t0[8] = {te.wh_rgb_col_r.x,
+                      te.wh_rgb_col_r.y,
+                      te.wh_rgb_col_r.z,
+                      te.wh_rgb_col_r.w,
+                      te.col_gb_dm_fback_r.x,
+                      te.col_gb_dm_fback_r.y,
+                      te.col_gb_dm_fback_r.z,
+                      te.col_gb_dm_fback_r.w};
+    tensorWriteARM(_PreprocessTensor, uint[](TENSOR_BATCH, outputPixel.y, outputPixel.x, 0), t0);
 
-    int8_t t1[4] = {te.fback_gba_ld.x, te.fback_gba_ld.y, te.fback_gba_ld.z, te.fback_gba_ld.w};
-    tensorWriteARM(_PreprocessTensor, uint[](0, outputPixel.y, outputPixel.x, 8), t1);
+    tensor_t t1[4] = {te.fback_gba_ld.x, te.fback_gba_ld.y, te.fback_gba_ld.z, te.fback_gba_ld.w};
+    tensorWriteARM(_PreprocessTensor, uint[](TENSOR_BATCH, outputPixel.y, outputPixel.x, 8), t1);
 }
 
 PreprocessTensorElement LoadPreprocessTensor(int32_t2 coord)
@@ -1056,9 +1198,9 @@ PreprocessTensorElement LoadPreprocessTensor(int32_t2 coord)
     tensor_t col_gb_dm_fback_r[4];  // jittered_colour.gb, disocclusion mask, feedback.r
     tensor_t fback_gba_ld[4];       // feedback.gba, luma derivative
 
-    tensorReadARM(_PreprocessTensor, uint32_t[](0, coord.y, coord.x, 0), wh_rgb_col_r);
-    tensorReadARM(_PreprocessTensor, uint32_t[](0, coord.y, coord.x, 4), col_gb_dm_fback_r);
-    tensorReadARM(_PreprocessTensor, uint32_t[](0, coord.y, coord.x, 8), fback_gba_ld);
+    tensorReadARM(_PreprocessTensor, uint32_t[](TENSOR_BATCH, coord.y, coord.x, 0), wh_rgb_col_r);
+    tensorReadARM(_PreprocessTensor, uint32_t[](TENSOR_BATCH, coord.y, coord.x, 4), col_gb_dm_fback_r);
+    tensorReadARM(_PreprocessTensor, uint32_t[](TENSOR_BATCH, coord.y, coord.x, 8), fback_gba_ld);
 
     PreprocessTensorElementInternal f;
     f.wh_rgb_col_r      = tensorVec_t(wh_rgb_col_r[0], wh_rgb_col_r[1], wh_rgb_col_r[2], wh_rgb_col_r[3]);
@@ -1067,18 +1209,55 @@ PreprocessTensorElement LoadPreprocessTensor(int32_t2 coord)
 
 #if QUANTIZED
     PreprocessTensorElement f_dequantized;
-    f_dequantized.wh_rgb_col_r      = Dequantize(f.wh_rgb_col_r, QuantParamsSINT().zw);
-    f_dequantized.col_gb_dm_fback_r = Dequantize(f.col_gb_dm_fback_r, QuantParamsSINT().zw);
-    f_dequantized.fback_gba_ld      = Dequantize(f.fback_gba_ld, QuantParamsSINT().zw);
+    f_dequantized.wh_rgb_col_r      = Dequantize(f.wh_rgb_col_r, InputDequantParams());
+    f_dequantized.col_gb_dm_fback_r = Dequantize(f.col_gb_dm_fback_r, InputDequantParams());
+    f_dequantized.fback_gba_ld      = Dequantize(f.fback_gba_ld, InputDequantParams());
     return f_dequantized;
 #endif
 
-    // When we are not quantized, we can return the internal representation directly.
-    return PreprocessTensorElement(f.wh_rgb_col_r, f.col_gb_dm_fback_r, f.fback_gba_ld);
+    // When we are not quantized, we can return the fp16 representation directly.
+    return PreprocessTensorElement(FfxFloat32x4(f.wh_rgb_col_r), FfxFloat32x4(f.col_gb_dm_fback_r), FfxFloat32x4(f.fback_gba_ld));
 }
+#endif  // #if TENSORS_AS_BUFFERS
 
 #endif  // NSS_BIND_UAV_PREPROCESSED_TENSOR
 
+//-------------------------------------------------------------------------
+// Coefficient uv: where each pixel finds its coefficients in the tensors of
+// the last network run. The frames which skip the network follow it along
+// the motion vectors, the other frames reset it to the pixel's own uv.
+//-------------------------------------------------------------------------
+#if WARP_COEFFICIENTS && defined(NSS_BIND_SRV_COEFFICIENT_UV_TM1) && defined(NSS_BIND_UAV_COEFFICIENT_UV)
+layout(set = 0, binding = NSS_BIND_SRV_COEFFICIENT_UV_TM1) uniform highp texture2D r_coefficient_uv_tm1;
+layout(set = 0, binding = NSS_BIND_UAV_COEFFICIENT_UV, rg16f) uniform writeonly highp image2D rw_coefficient_uv;
+#define _CoefficientUvTm1Tex sampler2D(r_coefficient_uv_tm1, s_LinearClamp)
+
+void WarpCoefficientUv(int32_t2 pixel, float2 uv, float2 reproj_uv)
+{
+    float2 coefficient_uv = ReuseCoefficients() ? textureLod(_CoefficientUvTm1Tex, reproj_uv, 0).xy : uv;
+    imageStore(rw_coefficient_uv, pixel, float4(coefficient_uv, 0.f, 0.f));
+}
+#else
+void WarpCoefficientUv(int32_t2 pixel, float2 uv, float2 reproj_uv)
+{
+}
+#endif
+
+#if WARP_COEFFICIENTS && defined(NSS_BIND_SRV_COEFFICIENT_UV)
+layout(set = 0, binding = NSS_BIND_SRV_COEFFICIENT_UV) uniform highp texture2D r_coefficient_uv;
+#define _CoefficientUvTex sampler2D(r_coefficient_uv, s_LinearClamp)
+
+float2 LoadCoefficientUv(float2 uv)
+{
+    return ReuseCoefficients() ? textureLod(_CoefficientUvTex, uv, 0).xy : uv;
+}
+#else
+float2 LoadCoefficientUv(float2 uv)
+{
+    return uv;
+}
+#endif
+
 //=========================================================================
 // Resources for post-process
 //=========================================================================
@@ -1110,10 +1289,10 @@ layout(set = 0, binding = NSS_BIND_SRV_K4_TENSOR) uniform lowp texture2D r_coeff
 half4 LoadKPNWeight(float2 uv, int16_t lut_idx)
 {
     // Load 4 kernel slices (each with 4 taps)
-    half4 k0 = Dequantize(half4(textureLod(_K0Tensor, uv, 0)), K0QuantParams());
-    half4 k1 = Dequantize(half4(textureLod(_K1Tensor, uv, 0)), K1QuantParams());
-    half4 k2 = Dequantize(half4(textureLod(_K2Tensor, uv, 0)), K2QuantParams());
-    half4 k3 = Dequantize(half4(textureLod(_K3Tensor, uv, 0)), K3QuantParams());
+    half4 k0 = DequantizeTensor(half4(textureLod(_K0Tensor, uv, 0)), K0QuantParams());
+    half4 k1 = DequantizeTensor(half4(textureLod(_K1Tensor, uv, 0)), K1QuantParams());
+    half4 k2 = DequantizeTensor(half4(textureLod(_K2Tensor, uv, 0)), K2QuantParams());
+    half4 k3 = DequantizeTensor(half4(textureLod(_K3Tensor, uv, 0)), K3QuantParams());
 
     // Precomputed swizzle patterns for KernelTile
     half4 p0 = half4(k0.x, k2.x, k0.z, k2.z);
@@ -1128,19 +1307,51 @@ half4 LoadKPNWeight(float2 uv, int16_t lut_idx)
 void LoadKPNRaw(float2 uv, out half4 k0, out half4 k1, out half4 k2, out half4 k3)
 {
     // Load 4 kernel slices (each with 4 taps)
-    k0 = clamp(Dequantize(half4(textureLod(_K0Tensor, uv, 0)), K0QuantParams()), half4(EPS), half4(1.HF));
-    k1 = clamp(Dequantize(half4(textureLod(_K1Tensor, uv, 0)), K1QuantParams()), half4(EPS), half4(1.HF));
-    k2 = clamp(Dequantize(half4(textureLod(_K2Tensor, uv, 0)), K2QuantParams()), half4(EPS), half4(1.HF));
-    k3 = clamp(Dequantize(half4(textureLod(_K3Tensor, uv, 0)), K3QuantParams()), half4(EPS), half4(1.HF));
+    k0 = clamp(DequantizeTensor(half4(textureLod(_K0Tensor, uv, 0)), K0QuantParams()), half4(EPS), half4(1.HF));
+    k1 = clamp(DequantizeTensor(half4(textureLod(_K1Tensor, uv, 0)), K1QuantParams()), half4(EPS), half4(1.HF));
+    k2 = clamp(DequantizeTensor(half4(textureLod(_K2Tensor, uv, 0)), K2QuantParams()), half4(EPS), half4(1.HF));
+    k3 = clamp(DequantizeTensor(half4(textureLod(_K3Tensor, uv, 0)), K3QuantParams()), half4(EPS), half4(1.HF));
 }
 
 void LoadTemporalParameters(float2 uv, out half theta, out half alpha)
 {
-    half2 tp = Dequantize(half2(textureLod(_TemporalTensor, uv, 0).xy), TemporalQuantParams());
+    half2 tp = DequantizeTensor(half2(textureLod(_TemporalTensor, uv, 0).xy), TemporalQuantParams());
     theta    = tp.x * NotHistoryReset();  // {0 <= x <= 1}
     alpha    = tp.y * 0.35HF + 0.05HF;    // { 0.05 <= x <= 0.4}
 }
 
+#else
+#if TENSORS_AS_BUFFERS
+layout(set = 0, binding = NSS_BIND_SRV_K0_TENSOR, std430) readonly buffer CoefficientsK0Tensor_t
+{
+    int32_t data[];
+}
+r_coefficients_k0_tensor;
+layout(set = 0, binding = NSS_BIND_SRV_K1_TENSOR, std430) readonly buffer CoefficientsK1Tensor_t
+{
+    int32_t data[];
+}
+r_coefficients_k1_tensor;
+layout(set = 0, binding = NSS_BIND_SRV_K2_TENSOR, std430) readonly buffer CoefficientsK2Tensor_t
+{
+    int32_t data[];
+}
+r_coefficients_k2_tensor;
+layout(set = 0, binding = NSS_BIND_SRV_K3_TENSOR, std430) readonly buffer CoefficientsK3Tensor_t
+{
+    int32_t data[];
+}
+r_coefficients_k3_tensor;
+layout(set = 0, binding = NSS_BIND_SRV_K4_TENSOR, std430) readonly buffer CoefficientsK4Tensor_t
+{
+    int32_t data[];
+}
+r_coefficients_k4_tensor;
+DECLARE_SAMPLE_BUFFER(K0, r_coefficients_k0_tensor)
+DECLARE_SAMPLE_BUFFER(K1, r_coefficients_k1_tensor)
+DECLARE_SAMPLE_BUFFER(K2, r_coefficients_k2_tensor)
+DECLARE_SAMPLE_BUFFER(K3, r_coefficients_k3_tensor)
+DECLARE_SAMPLE_BUFFER(K4, r_coefficients_k4_tensor)
 #else
 layout(set = 0, binding = NSS_BIND_SRV_K0_TENSOR) uniform readonly tensorARM<tensor_t, 4> r_coefficients_k0_tensor;
 layout(set = 0, binding = NSS_BIND_SRV_K1_TENSOR) uniform readonly tensorARM<tensor_t, 4> r_coefficients_k1_tensor;
@@ -1152,6 +1363,7 @@ DECLARE_SAMPLE_TENSOR(K1, r_coefficients_k1_tensor)
 DECLARE_SAMPLE_TENSOR(K2, r_coefficients_k2_tensor)
 DECLARE_SAMPLE_TENSOR(K3, r_coefficients_k3_tensor)
 DECLARE_SAMPLE_TENSOR(K4, r_coefficients_k4_tensor)
+#endif
 
 half4 LoadKPNWeight(float2 uv, int16_t lut_idx)
 {
@@ -1218,10 +1430,10 @@ half3 LoadAndFilterColour(int32_t2 output_pixel, float2 uv, out half4 col_to_acc
 
     // Gather taps
     half4x4 interm;
-    interm[0] = half4(SafeColour(half3(texelFetch(_ColourTex, int16_t2(tap_x[0], tap_y[0]), 0).rgb) * half3(Exposure())), 1.HF);
-    interm[1] = half4(SafeColour(half3(texelFetch(_ColourTex, int16_t2(tap_x[1], tap_y[1]), 0).rgb) * half3(Exposure())), 1.HF);
-    interm[2] = half4(SafeColour(half3(texelFetch(_ColourTex, int16_t2(tap_x[2], tap_y[2]), 0).rgb) * half3(Exposure())), 1.HF);
-    interm[3] = half4(SafeColour(half3(texelFetch(_ColourTex, int16_t2(tap_x[3], tap_y[3]), 0).rgb) * half3(Exposure())), 1.HF);
+    interm[0] = half4(SafeColour(half3(texelFetch(_ColourTex, PaddedToInputPixel(int32_t2(tap_x[0], tap_y[0])), 0).rgb) * half3(Exposure())), 1.HF);
+    interm[1] = half4(SafeColour(half3(texelFetch(_ColourTex, PaddedToInputPixel(int32_t2(tap_x[1], tap_y[1])), 0).rgb) * half3(Exposure())), 1.HF);
+    interm[2] = half4(SafeColour(half3(texelFetch(_ColourTex, PaddedToInputPixel(int32_t2(tap_x[2], tap_y[2])), 0).rgb) * half3(Exposure())), 1.HF);
+    interm[3] = half4(SafeColour(half3(texelFetch(_ColourTex, PaddedToInputPixel(int32_t2(tap_x[3], tap_y[3])), 0).rgb) * half3(Exposure())), 1.HF);
 
     // Special case: grab the accumulation pixel, when it corresponds to current thread
     half match   = half(lut.dx[CENTER_TAP] == 0 && lut.dy[CENTER_TAP] == 0);
@@ -1276,7 +1488,7 @@ half3 LoadAndFilterColour(int32_t2 output_pixel, float2 uv, out half4 col_to_acc
             if (input_pixel.x >= 0 && input_pixel.y >= 0)
             {
                 input_pixel     = clamp(input_pixel, int32_t2(0), int32_t2(InputDims() - 1));
-                half3 tap_color = half3(texelFetch(_ColourTex, int16_t2(input_pixel), 0).rgb);
+                half3 tap_color = half3(texelFetch(_ColourTex, PaddedToInputPixel(int32_t2(input_pixel)), 0).rgb);
 
                 out_colour += tap_color * weight;
                 weight_sum += weight;
@@ -1355,6 +1567,9 @@ half3 LoadWarpedHistory(float2 uv, int32_t2 input_pixel, out half onscreen)
 //-------------------------------------------------------------------------
 #if defined(NSS_BIND_UAV_UPSCALED_OUTPUT)
 layout(set = 0, binding = NSS_BIND_UAV_UPSCALED_OUTPUT, OUTPUT_IMG_FORMAT) uniform mediump image2D rw_upscaled_output;
+#if defined(NSS_BIND_UAV_UNPADDED_OUTPUT)
+layout(set = 0, binding = NSS_BIND_UAV_UNPADDED_OUTPUT, OUTPUT_IMG_FORMAT) uniform mediump image2D rw_unpadded_output;
+#endif
 
 half4 LoadUpscaledOutput(int32_t2 iPxPos)
 {
@@ -1415,10 +1630,44 @@ void WriteUpsampledColour(int32_t2 pixel, half3 colour)
 #endif
     // Write with alpha = 1.0
     imageStore(rw_upscaled_output, pixel, half4(to_write, 1.0));
+#if defined(NSS_BIND_UAV_UNPADDED_OUTPUT)
+    // The padded output is kept as history, the unaligned output only takes the pixels inside its bounds.
+    // For a region of interest, those are the pixels inside the halo, moved to where the region is in the output.
+    const int32_t2 region_pixel = pixel - OutputRegion().xy;
+    if (all(greaterThanEqual(region_pixel, int32_t2(0))) && all(lessThan(region_pixel, UnpaddedOutputDims())))
+    {
+        imageStore(rw_unpadded_output, region_pixel + OutputRegion().zw, half4(to_write, 1.0));
+    }
+    else if (all(lessThan(FoveaRect().xy, FoveaRect().zw)))
+    {
+        // A fovea fades into the periphery written before it over the halo, the network's weight falling to 0 at its outer edge
+        const int32_t2 output_pixel = region_pixel + OutputRegion().zw;
+        const int32_t2 distance     = max(max(-region_pixel, region_pixel + 1 - UnpaddedOutputDims()), int32_t2(0));
+        const half     weight       = half(1.0) - half(max(float(distance.x) / float(OutputRegion().x), float(distance.y) / float(OutputRegion().y)));
+        if (weight > half(0.0) && all(greaterThanEqual(output_pixel, int32_t2(0))) && all(lessThan(output_pixel, imageSize(rw_unpadded_output))))
+        {
+            const half3 periphery = half3(imageLoad(rw_unpadded_output, output_pixel).rgb);
+            imageStore(rw_unpadded_output, output_pixel, half4(lerp(periphery, to_write, weight), 1.0));
+        }
+    }
+#endif
 }
 
 #endif  // #if defined(NSS_BIND_UAV_UPSCALED_OUTPUT)
 
+//-------------------------------------------------------------------------
+// Output: Periphery of a foveated frame, written to the output directly
+//-------------------------------------------------------------------------
+#if defined(NSS_BIND_UAV_UNPADDED_OUTPUT) && !defined(NSS_BIND_UAV_UPSCALED_OUTPUT)
+layout(set = 0, binding = NSS_BIND_UAV_UNPADDED_OUTPUT, OUTPUT_IMG_FORMAT) uniform mediump image2D rw_unpadded_output;
+
+void WritePeripheryColour(int32_t2 pixel, half3 colour)
+{
+    imageStore(rw_unpadded_output, pixel, half4(SafeColour(colour), 1.0));
+}
+
+#endif  // #if defined(NSS_BIND_UAV_UNPADDED_OUTPUT) && !defined(NSS_BIND_UAV_UPSCALED_OUTPUT)
+
 //-------------------------------------------------------------------------
 // Debug views (RWTexture2D UAV)
 //-------------------------------------------------------------------------
@@ -1441,6 +1690,122 @@ float2 GetDebugViewDimensions()
 }
 #endif  // #if defined(NSS_BIND_UAV_DEBUG_VIEWS)
 
+// Resources for the compute shader network
+//=========================================================================
+
+//-------------------------------------------------------------------------
+// Layer constants (push constants) and parameters (SRV Buffer)
+//-------------------------------------------------------------------------
+#if defined(NSS_BIND_SRV_NETWORK_PARAMETERS)
+// Matches NssNetworkLayerConstants, each layer pushes its own.
+layout(push_constant, std430) uniform cbNetworkLayer_t
+{
+    int32_t4 _OutputShape;   // .xy = output width/height, .z = output channels, .w = input channels
+    int32_t4 _Convolution;   // .xy = stride, .zw = left/top padding
+    int32_t4 _Kernel;        // .xy = kernel width/height, .zw = dilation
+    int32_t4 _Source0;       // .xy = width/height, .z = channels, .w = nearest upsampling factor
+    int32_t4 _Source1;       // .xy = width/height, .z = channels, .w = nearest upsampling factor
+    int32_t4 _Parameters;    // word offsets: .x = weights, .y = channel parameters, .z = table or -1, .w = 2:4 sparse weights or -1 (CPU only)
+    int32_t4 _Quantization;  // .x = input zero point in every byte, .y = output zero point, .z = double rounding
+}
+cbNetworkLayer;
+
+layout(set = 0, binding = NSS_BIND_SRV_NETWORK_PARAMETERS, std430) readonly buffer NetworkParameters_t
+{
+    int32_t data[];
+}
+r_network_parameters;
+
+int32_t4 NetworkOutputShape()
+{
+    return cbNetworkLayer._OutputShape;
+}
+
+int32_t4 NetworkConvolution()
+{
+    return cbNetworkLayer._Convolution;
+}
+
+int32_t4 NetworkKernel()
+{
+    return cbNetworkLayer._Kernel;
+}
+
+int32_t4 NetworkSource0()
+{
+    return cbNetworkLayer._Source0;
+}
+
+int32_t4 NetworkSource1()
+{
+    return cbNetworkLayer._Source1;
+}
+
+int32_t4 NetworkParameterOffsets()
+{
+    return cbNetworkLayer._Parameters;
+}
+
+int32_t4 NetworkQuantization()
+{
+    return cbNetworkLayer._Quantization;
+}
+
+int32_t LoadNetworkParameter(int32_t index)
+{
+    return r_network_parameters.data[index];
+}
+#endif  // #if defined(NSS_BIND_SRV_NETWORK_PARAMETERS)
+
+//-------------------------------------------------------------------------
+// Input: the concatenated sources of a layer (SRV Buffer)
+// The network runs where tensors aren't supported, its tensors are storage buffers in the NHWC layout.
+//-------------------------------------------------------------------------
+#if defined(NSS_BIND_SRV_NETWORK_INPUT_0) && defined(NSS_BIND_SRV_NETWORK_INPUT_1)
+layout(set = 0, binding = NSS_BIND_SRV_NETWORK_INPUT_0, std430) readonly buffer NetworkInput0_t
+{
+    int32_t data[];
+}
+r_network_input_0;
+layout(set = 0, binding = NSS_BIND_SRV_NETWORK_INPUT_1, std430) readonly buffer NetworkInput1_t
+{
+    int32_t data[];
+}
+r_network_input_1;
+
+// Returns 4 consecutive channels packed into a word, channel in the lowest byte.
+int32_t LoadNetworkInput0(int32_t2 pixel, int32_t channel)
+{
+    const int32_t4 source = NetworkSource0();
+    return r_network_input_0.data[((pixel.y * source.x + pixel.x) * source.z + channel) / 4];
+}
+
+int32_t LoadNetworkInput1(int32_t2 pixel, int32_t channel)
+{
+    const int32_t4 source = NetworkSource1();
+    return r_network_input_1.data[((pixel.y * source.x + pixel.x) * source.z + channel) / 4];
+}
+#endif  // #if defined(NSS_BIND_SRV_NETWORK_INPUT_0) && defined(NSS_BIND_SRV_NETWORK_INPUT_1)
+
+//-------------------------------------------------------------------------
+// Output: layer output (UAV Buffer)
+//-------------------------------------------------------------------------
+#if defined(NSS_BIND_UAV_NETWORK_OUTPUT)
+layout(set = 0, binding = NSS_BIND_UAV_NETWORK_OUTPUT, std430) buffer NetworkOutput_t
+{
+    int32_t data[];
+}
+rw_network_output;
+
+// Stores 4 consecutive channels, each value already saturated to int8.
+void StoreNetworkOutput(int32_t2 pixel, int32_t channel, int32_t4 value)
+{
+    const int32_t4 shape = NetworkOutputShape();
+    rw_network_output.data[((pixel.y * shape.x + pixel.x) * shape.z + channel) / 4] =
+        (value.x & 0xFF) | ((value.y & 0xFF) << 8) | ((value.z & 0xFF) << 16) | (value.w << 24);
+}
+#endif  // #if defined(NSS_BIND_UAV_NETWORK_OUTPUT)
+
 #endif  // #if defined(FFX_GPU)
 
 #endif  // GPU_NSS_FFX_NSS_CALLBACKS_GLSL_H
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef GPU_NSS_NETWORK_H
+#define GPU_NSS_NETWORK_H
+
+// One fused layer of the quantized network: 2D convolution, per channel rescale and an optional table lookup.
+// The host folds the input zero point into the bias, so padding taps read the zero point and contribute nothing.
+
+// Reads 4 channels of the layer input, which is the concatenation of up to two sources, each optionally upsampled.
+int32_t LoadLayerInput(int32_t2 pixel, int32_t channel)
+{
+    const int32_t4 source0 = NetworkSource0();
+    if (channel < source0.z)
+    {
+        return LoadNetworkInput0(pixel / source0.w, channel);
+    }
+
+    const int32_t4 source1 = NetworkSource1();
+    return LoadNetworkInput1(pixel / source1.w, channel - source0.z);
+}
+
+// Adds two 64bit values split into a signed high and an unsigned low word.
+void Add64(inout int32_t high, inout uint32_t low, int32_t addHigh, uint32_t addLow)
+{
+    uint32_t carry;
+    low  = uaddCarry(low, addLow, carry);
+    high = high + addHigh + int32_t(carry);
+}
+
+// TOSA apply_scale_32: (value * multiplier + round) >> shift with a 64bit intermediate, shift in [2, 62].
+int32_t ApplyScale32(int32_t value, int32_t multiplier, int32_t shift, bool doubleRound)
+{
+    int32_t high;
+    int32_t lowBits;
+    imulExtended(value, multiplier, high, lowBits);
+    uint32_t low = uint32_t(lowBits);
+
+    Add64(high, low, shift > 32 ? (1 << (shift - 33)) : 0, shift > 32 ? 0u : (1u << (shift - 1)));
+    if (doubleRound && shift > 31)
+    {
+        Add64(high, low, value >= 0 ? 0 : -1, value >= 0 ? (1u << 30) : uint32_t(-(1 << 30)));
+    }
+
+    return (shift >= 32) ? (high >> (shift - 32)) : int32_t((low >> shift) | (uint32_t(high) << (32 - shift)));
+}
+
+// TOSA table for int8 values, 256 entries packed 4 per word.
+int32_t LoadTableEntry(int32_t tableOffset, int32_t value)
+{
+    const int32_t index = value + 128;
+    return bitfieldExtract(LoadNetworkParameter(tableOffset + (index >> 2)), (index & 3) * 8, 8);
+}
+
+// Each invocation computes 4 output channels of one pixel.
+void NetworkLayer(int32_t3 invocation)
+{
+    const int32_t4 outputShape   = NetworkOutputShape();
+    const int32_t2 outputPixel   = invocation.xy;
+    const int32_t  outputChannel = invocation.z * 4;
+
+    if (any(greaterThanEqual(outputPixel, outputShape.xy)) || outputChannel >= outputShape.z)
+    {
+        return;
+    }
+
+    const int32_t4 convolution  = NetworkConvolution();
+    const int32_t4 kernel       = NetworkKernel();
+    const int32_t4 offsets      = NetworkParameterOffsets();
+    const int32_t4 quantization = NetworkQuantization();
+    const int32_t2 inputDims    = NetworkSource0().xy * NetworkSource0().w;
+
+    // Weights are [output channel][kernel y][kernel x][input channel], with 4 input channels per word
+    const int32_t inputWords  = outputShape.w / 4;
+    const int32_t kernelWords = kernel.x * kernel.y * inputWords;
+    int32_t       weightIndex = offsets.x + outputChannel * kernelWords;
+
+    // Channel parameters are {bias, multiplier, shift, unused} per output channel
+    const int32_t channelIndex = offsets.y + outputChannel * 4;
+    int32_t4      acc          = int32_t4(LoadNetworkParameter(channelIndex),
+                                          LoadNetworkParameter(channelIndex + 4),
+                                          LoadNetworkParameter(channelIndex + 8),
+                                          LoadNetworkParameter(channelIndex + 12));
+
+    for (int32_t ky = 0; ky < kernel.y; ++ky)
+    {
+        for (int32_t kx = 0; kx < kernel.x; ++kx)
+        {
+            const int32_t2 inputPixel = outputPixel * convolution.xy - convolution.zw + int32_t2(kx, ky) * kernel.zw;
+            const bool     inside     = all(greaterThanEqual(inputPixel, int32_t2(0))) && all(lessThan(inputPixel, inputDims));
+
+            for (int32_t word = 0; word < inputWords; ++word, ++weightIndex)
+            {
+                const int32_t x = inside ? LoadLayerInput(inputPixel, word * 4) : quantization.x;
+
+                acc.x += dotPacked4x8EXT(x, LoadNetworkParameter(weightIndex));
+                acc.y += dotPacked4x8EXT(x, LoadNetworkParameter(weightIndex + kernelWords));
+                acc.z += dotPacked4x8EXT(x, LoadNetworkParameter(weightIndex + kernelWords * 2));
+                acc.w += dotPacked4x8EXT(x, LoadNetworkParameter(weightIndex + kernelWords * 3));
+            }
+        }
+    }
+
+    int32_t4 result;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        const int32_t multiplier = LoadNetworkParameter(channelIndex + i * 4 + 1);
+        const int32_t shift      = LoadNetworkParameter(channelIndex + i * 4 + 2);
+
+        int32_t value = clamp(ApplyScale32(acc[i], multiplier, shift, quantization.z != 0) + quantization.y, -128, 127);
+        if (offsets.z >= 0)
+        {
+            value = LoadTableEntry(offsets.z, value);
+        }
+        result[i] = value;
+    }
+
+    StoreNetworkOutput(outputPixel, outputChannel, result);
+}
+
+#endif  // GPU_NSS_NETWORK_H
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef GPU_NSS_PERIPHERY_UPSCALE_H
+#define GPU_NSS_PERIPHERY_UPSCALE_H
+
+// Weight of the history in the periphery, the network learns its own per pixel.
+#define NSS_PERIPHERY_HISTORY_WEIGHT 0.9HF
+
+// Temporal upscale of a foveated frame outside its fovea, in place of the network. The history is
+// resampled with Catmull-Rom, rectified to the neighbourhood of the current samples and blended with them.
+void PeripheryUpscale(int32_t2 output_pixel)
+{
+    if (any(greaterThanEqual(output_pixel, OutputDims())))
+        return;
+
+    // The network writes the inside of the fovea, its halo is blended by the postprocess
+    const int32_t4 fovea = FoveaRect();
+    if (all(greaterThanEqual(output_pixel, fovea.xy)) && all(lessThan(output_pixel, fovea.zw)))
+        return;
+
+    float2   uv          = (float2(output_pixel) + 0.5) * InvOutputDims();
+    int32_t2 input_pixel = int32_t2(uv * InputDims());
+
+    //-------------------------------------------------------------------------
+    // 1) Warp history
+    //-------------------------------------------------------------------------
+    float2 reproj_uv = uv - float2(LoadMotion(input_pixel));
+    half   onscreen  = half(all(greaterThanEqual(reproj_uv, float2(0.0))) && all(lessThan(reproj_uv, float2(1.0))));
+    half3  history   = Tonemap(SafeColour(LoadHistoryCatmull(reproj_uv) * Exposure()));
+
+    //-------------------------------------------------------------------------
+    // 2) Current sample, undoing the jitter, and its neighbourhood
+    //-------------------------------------------------------------------------
+    half3 colour = Tonemap(SafeColour(half3(SampleInputColorJittered(uv - JitterOffsetUv()).rgb) * Exposure()));
+    half3 n_min  = colour;
+    half3 n_max  = colour;
+    for (int32_t y = -1; y <= 1; ++y)
+    {
+        for (int32_t x = -1; x <= 1; ++x)
+        {
+            half3 tap = LoadColour(clamp(input_pixel + int32_t2(x, y), int32_t2(0), InputDims() - 1));
+            n_min     = min(n_min, tap);
+            n_max     = max(n_max, tap);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // 3) Rectify history and accumulate, history offscreen is discarded
+    //-------------------------------------------------------------------------
+    half3 accumulated = lerp(colour, clamp(history, n_min, n_max), NSS_PERIPHERY_HISTORY_WEIGHT * onscreen * NotHistoryReset());
+
+    //-------------------------------------------------------------------------
+    // 4) Inverse tonemap + exposure and write output
+    //-------------------------------------------------------------------------
+    WritePeripheryColour(output_pixel, InverseTonemap(accumulated) * InvExposure());
+}
+
+#endif  // GPU_NSS_PERIPHERY_UPSCALE_H
@@ -23,14 +23,17 @@ void Postprocess(int32_t2 output_pixel)
     //-------------------------------------------------------------------------
     // 2) KPN filter → col
     //-------------------------------------------------------------------------
+    // The coefficients come from the last run of the network, warped to this frame when it was skipped
+    float2 coefficient_uv = LoadCoefficientUv(uv);
+
     half4 col_to_accum;
-    half3 colour = LoadAndFilterColour(output_pixel, uv, col_to_accum);
+    half3 colour = LoadAndFilterColour(output_pixel, coefficient_uv, col_to_accum);
 
     // -------------------------------------------------------------------------
     // 3) Load temporal parameters
     //-------------------------------------------------------------------------
     half theta, alpha;
-    LoadTemporalParameters(uv, theta, alpha);
+    LoadTemporalParameters(coefficient_uv, theta, alpha);
 
     //-------------------------------------------------------------------------
     // 3) Rectify history, force reset when offscreen
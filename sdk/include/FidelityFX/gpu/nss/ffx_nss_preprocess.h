@@ -72,20 +72,26 @@ void Preprocess(int32_t2 input_pixel)
     //-------------------------------------------------------------------------
     // 9) Write Outputs
     //-------------------------------------------------------------------------
-    // Consumed by NE
-    WriteToTensor(input_pixel,
-                  jittered_colour,    // 3ch
-                  warped_history,     // 3ch
-                  disocclusion_mask,  // 1ch
-                  luma_derivative.x,  // 1ch
-                  temporal_feedback   // 4ch
-    );                                // total: 12ch
+    // Consumed by NE, which doesn't run when the coefficients are reused
+    if (!ReuseCoefficients())
+    {
+        WriteToTensor(input_pixel,
+                      jittered_colour,    // 3ch
+                      warped_history,     // 3ch
+                      disocclusion_mask,  // 1ch
+                      luma_derivative.x,  // 1ch
+                      temporal_feedback   // 4ch
+        );                                // total: 12ch
+    }
 
     // Consumed by post process and frame t+1
     WriteNearestDepthOffset(input_pixel, enc_depth_offset);
 
     // Consumed at frame t+1
     WriteLumaDerivative(input_pixel, luma_derivative);
+
+    // Consumed by post process and frame t+1
+    WarpCoefficientUv(input_pixel, uv, reproj_uv);
 }
 
 #endif  // GPU_NSS_PREPROCESS_H
\ No newline at end of file
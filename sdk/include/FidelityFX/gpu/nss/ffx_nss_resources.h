@@ -62,7 +62,30 @@
 
 #define FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS 30
 
-#define FFX_NSS_RESOURCE_IDENTIFIER_COUNT 31
+// Compute shader network, used when the device can't run the data graph
+#define FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_PARAMETERS   31
+#define FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_0      32
+#define FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_1      33
+#define FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_OUTPUT       34
+#define FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0 35
+
+#define FFX_NSS_NETWORK_MAX_ACTIVATIONS 16
+
+// Coefficient warping, used on the dispatches which skip the network
+#define FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV     (FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0 + FFX_NSS_NETWORK_MAX_ACTIVATIONS)
+#define FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_TM1 (FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV + 1)
+#define FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_1   (FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV + 2)
+#define FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2   (FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV + 3)
+
+// Foveated upscaling, the full frame output of the last frame read by the periphery pass
+#define FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY (FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2 + 1)
+
+// Tensors passed between the segments of a model exported from several modules, shared by intermediates which are never live at once
+#define FFX_NSS_RESOURCE_IDENTIFIER_SEGMENT_INTERMEDIATE_0 (FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY + 1)
+
+#define FFX_NSS_SEGMENT_MAX_INTERMEDIATES 8
+
+#define FFX_NSS_RESOURCE_IDENTIFIER_COUNT (FFX_NSS_RESOURCE_IDENTIFIER_SEGMENT_INTERMEDIATE_0 + FFX_NSS_SEGMENT_MAX_INTERMEDIATES)
 
 #define FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS 0
 #define FFX_NSS_CONSTANTBUFFER_COUNT          1
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+/// @defgroup CPUBackend CPU Backend
+/// FidelityFX SDK native backend implementation running every pass on the CPU.
+///
+/// Jobs are executed synchronously by <c><i>fpExecuteGpuJobs</i></c>, with each compute dispatch split
+/// across worker threads. Resources are tightly packed host memory: textures are rows of texels without
+/// padding, tensors are laid out as [1, height, width, channels] and buffers are plain bytes. The command
+/// list passed to the effects is never dereferenced.
+///
+/// The backend reports tensors and packed integer dot products as supported, but no data graphs, so NSS runs
+/// its network as compute layers and has to be created with <c><i>FFX_NSS_CONTEXT_FLAG_QUANTIZED</i></c>.
+///
+/// The passes are C++ kernels, but their resources are bound with the reflection of the Vulkan shader blobs,
+/// so the backend is only built alongside the Vulkan backend (<c><i>FFX_API_VK</i></c>).
+///
+/// @ingroup Backends
+
+#pragma once
+
+#include <FidelityFX/host/ffx_interface.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif  // #if defined(__cplusplus)
+
+/// Convenience structure to hold the settings of the CPU device.
+typedef struct FfxCpuDeviceContext
+{
+    uint32_t threadCount;  /// The number of threads a dispatch is split across, 0 to use every hardware thread
+} FfxCpuDeviceContext;
+
+/// Query how much memory is required for the CPU backend's scratch buffer.
+///
+/// @param [in] maxContexts                 The maximum number of simultaneous effect contexts that will share the backend.
+///                                         (Note that some effects contain internal contexts which count towards this maximum)
+///
+/// @returns
+/// The size (in bytes) of the required scratch memory buffer for the CPU backend.
+///
+/// @ingroup CPUBackend
+FFX_API size_t ffxGetScratchMemorySizeCPU(size_t maxContexts);
+
+/// Create a <c><i>FfxDevice</i></c> from the settings of the CPU device.
+///
+/// @param [in] cpuDeviceContext            A pointer to a FfxCpuDeviceContext that holds all needed information
+///
+/// @returns
+/// An abstract FidelityFX device.
+///
+/// @ingroup CPUBackend
+FFX_API FfxDevice ffxGetDeviceCPU(FfxCpuDeviceContext* cpuDeviceContext);
+
+/// Populate an interface with pointers for the CPU backend.
+///
+/// @param [out] backendInterface           A pointer to a <c><i>FfxInterface</i></c> structure to populate with pointers.
+/// @param [in] device                      A device returned by <c><i>ffxGetDeviceCPU</i></c>.
+/// @param [in] scratchBuffer               A pointer to a buffer of memory which can be used by the CPU backend.
+/// @param [in] scratchBufferSize           The size (in bytes) of the buffer pointed to by <c><i>scratchBuffer</i></c>.
+/// @param [in] maxContexts                 The maximum number of simultaneous effect contexts that will share the backend.
+///                                         (Note that some effects contain internal contexts which count towards this maximum)
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_INVALID_POINTER          The <c><i>interface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup CPUBackend
+FFX_API FfxErrorCode ffxGetInterfaceCPU(FfxInterface* backendInterface, FfxDevice device, void* scratchBuffer, size_t scratchBufferSize, size_t maxContexts);
+
+/// Fetch a <c><i>FfxResource</i></c> from host memory.
+///
+/// @param [in] data                        A pointer to the tightly packed contents of the resource.
+/// @param [in] ffxResDescription           An <c><i>FfxResourceDescription</i></c> for the resource representation.
+/// @param [in] ffxResName                  (optional) A name string to identify the resource in debug mode.
+/// @param [in] state                       The state the resource is currently in.
+///
+/// @returns
+/// An abstract FidelityFX resources.
+///
+/// @ingroup CPUBackend
+FFX_API FfxResource ffxGetResourceCPU(void*                  data,
+                                      FfxResourceDescription ffxResDescription,
+                                      const wchar_t*         ffxResName,
+                                      FfxResourceStates      state = FFX_RESOURCE_STATE_COMPUTE_READ);
+
+#if defined(__cplusplus)
+}
+#endif  // #if defined(__cplusplus)
@@ -105,6 +105,7 @@ typedef struct VkDeviceContext
     PFN_vkGetDeviceProcAddr   vkDeviceProcAddr;       /// The device's function address table
     VkInstance                vkInstance;             /// The Vulkan instance
     PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;  /// The instance's function address table
+    uint32_t                  queueFamilyIndex;       /// The queue family of the command buffers passed to dispatches. Used for recorded command buffers
 } VkDeviceContext;
 
 /// Query how much memory is required for the Vulkan backend's scratch buffer.
@@ -146,6 +147,47 @@ FFX_API FfxDevice ffxGetDeviceVK(VkDeviceContext* vkDeviceContext);
 /// @ingroup VKBackend
 FFX_API FfxErrorCode ffxGetInterfaceVK(FfxInterface* backendInterface, FfxDevice device, void* scratchBuffer, size_t scratchBufferSize, size_t maxContexts);
 
+/// Key the destruction of Vulkan objects on a timeline supplied by the application.
+///
+/// The backend defers destroying the objects of resources, pipelines and effect contexts until the GPU can no
+/// longer be using them, so contexts can be destroyed or recreated, for example on resize, without waiting for
+/// the device to go idle. By default an object is destroyed once <c><i>FFX_MAX_QUEUED_FRAMES</i></c> more frames
+/// have been dispatched, which assumes each effect context is dispatched at most once per frame and no more than
+/// <c><i>FFX_MAX_QUEUED_FRAMES</i></c> frames are in flight.
+///
+/// Applications tracking GPU progress with a timeline semaphore or a counted fence should call this function
+/// every frame instead. From the first call on, objects destroyed are kept until <c><i>completedValue</i></c>
+/// reaches the <c><i>pendingValue</i></c> that was last set when they were destroyed.
+///
+/// @param [in] device                      A device returned by <c><i>ffxGetDeviceVK</i></c>.
+/// @param [in] pendingValue                The value signalled once the work being recorded has completed on the GPU.
+/// @param [in] completedValue              The highest value the GPU is known to have signalled.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>device</i></c> pointer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              <c><i>completedValue</i></c> was greater than <c><i>pendingValue</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetDeferredDestructionTimelineVK(FfxDevice device, uint64_t pendingValue, uint64_t completedValue);
+
+/// Destroy every Vulkan object whose destruction the backend has deferred.
+///
+/// Call this once the GPU is idle. Destroying the last backend context created on the device flushes the
+/// objects still queued for it as well, so the GPU has to be done with the work of the contexts by then.
+///
+/// @param [in] device                      A device returned by <c><i>ffxGetDeviceVK</i></c>.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>device</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxFlushDeferredDestructionVK(FfxDevice device);
+
 /// Create a <c><i>FfxCommandList</i></c> from a <c><i>VkCommandBuffer</i></c>.
 ///
 /// @param [in] cmdBuf                      A pointer to the Vulkan command buffer.
@@ -250,6 +250,93 @@ typedef FfxResource (*FfxGetResourceFunc)(FfxInterface* backendInterface, FfxRes
 /// @ingroup FfxInterface
 typedef FfxErrorCode (*FfxUnregisterResourcesFunc)(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
 
+/// Set the state a registered resource is left in once the temporary resources are unregistered.
+///
+/// By default <c><i>FfxUnregisterResourcesFunc</i></c> transitions a registered
+/// resource back to the state it was registered in. An application which
+/// transitions the resource again right after the effect can name the state it
+/// needs instead, so the backend transitions the resource there directly.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] resource                            A resource returned by <c><i>FfxRegisterResourceFunc</i></c>.
+/// @param [in] finalState                          The state to leave the resource in.
+/// @param [in] effectContextId                     The context space to be used for the effect in question.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FfxInterface
+typedef FfxErrorCode (*FfxSetResourceFinalStateFunc)(FfxInterface*       backendInterface,
+                                                     FfxResourceInternal resource,
+                                                     FfxResourceStates   finalState,
+                                                     FfxUInt32           effectContextId);
+
+/// Register an external resource in a slot the backend keeps across dispatches.
+///
+/// Unlike <c><i>FfxRegisterResourceFunc</i></c>, the slot and the views the backend
+/// creates for the resource stay registered when the temporary resources are
+/// unregistered. Registering the resource a slot already holds, with the same
+/// description, only takes the state it is passed in for the jobs being scheduled.
+/// Any other resource replaces the one of the slot, and a null resource releases
+/// the slot. Within the jobs being scheduled, the resource is walked back to its
+/// state by <c><i>FfxUnregisterResourcesFunc</i></c> like a temporary resource.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] inResource                          A pointer to a <c><i>FfxResource</i></c>, or a null resource to release the slot.
+/// @param [in] effectContextId                     The context space to be used for the effect in question.
+/// @param [in,out] inOutResource                   The slot of an earlier registration, or 0 to take a new one. Receives the slot.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FfxInterface
+typedef FfxErrorCode (*FfxRegisterPersistentResourceFunc)(FfxInterface*        backendInterface,
+                                                          const FfxResource*   inResource,
+                                                          FfxUInt32            effectContextId,
+                                                          FfxResourceInternal* inOutResource);
+
+/// Retrieve the contents of the pipeline cache the backend creates pipelines with.
+///
+/// The data can be stored by the application and passed to
+/// <c><i>FfxMergePipelineCacheDataFunc</i></c> in a later run, so pipelines
+/// built before are not compiled again. With a null <c><i>outData</i></c>, only
+/// the size of the data is returned.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [out] outData                            A buffer receiving the data, or <c><i>NULL</i></c> to query its size.
+/// @param [in,out] inOutDataSize                   The size of <c><i>outData</i></c>. Receives the size of the data written, or of all the data.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY                   <c><i>outData</i></c> was too small, it holds as much of the data as fits.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FfxInterface
+typedef FfxErrorCode (*FfxGetPipelineCacheDataFunc)(FfxInterface* backendInterface, void* outData, size_t* inOutDataSize);
+
+/// Add the contents of a pipeline cache retrieved by <c><i>FfxGetPipelineCacheDataFunc</i></c>
+/// to the pipeline cache of the backend.
+///
+/// Data written by another device or driver version is ignored.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] data                                The pipeline cache data.
+/// @param [in] dataSize                            The size of <c><i>data</i></c>.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FfxInterface
+typedef FfxErrorCode (*FfxMergePipelineCacheDataFunc)(FfxInterface* backendInterface, const void* data, size_t dataSize);
+
 /// Register a resource in the static bindless table of the backend.
 ///
 /// A static resource will persist in their respective bindless table until it is
@@ -420,13 +507,18 @@ typedef FfxErrorCode (*FfxGetPermutationBlobByIndexFunc)(
 typedef FfxErrorCode (*FfxDestroyPipelineFunc)(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId);
 
 /// Schedule a render job to be executed on the next call of
-/// <c><i>FfxExecuteGpuJobsFunc</i></c>.
+/// <c><i>FfxExecuteGpuJobsFunc</i></c> for the same effect context.
 ///
 /// Render jobs can perform one of three different tasks: clear, copy or
 /// compute dispatches.
 ///
+/// Each effect context keeps its own list of scheduled jobs, so different
+/// effect contexts may schedule and execute their jobs concurrently from
+/// different threads. Calls for a single effect context must not overlap.
+///
 /// @param [in] backendInterface                    A pointer to the backend interface.
 /// @param [in] job                                 A pointer to a <c><i>FfxGpuJobDescription</i></c> structure.
+/// @param [in] effectContextId                     The context space to be used for the effect in question.
 ///
 /// @retval
 /// FFX_OK                                          The operation completed successfully.
@@ -434,7 +526,7 @@ typedef FfxErrorCode (*FfxDestroyPipelineFunc)(FfxInterface* backendInterface, F
 /// Anything else                                   The operation failed.
 ///
 /// @ingroup FfxInterface
-typedef FfxErrorCode (*FfxScheduleGpuJobFunc)(FfxInterface* backendInterface, const FfxGpuJobDescription* job);
+typedef FfxErrorCode (*FfxScheduleGpuJobFunc)(FfxInterface* backendInterface, const FfxGpuJobDescription* job, FfxUInt32 effectContextId);
 
 /// Execute scheduled render jobs on the <c><i>comandList</i></c> provided.
 ///
@@ -461,6 +553,50 @@ typedef FfxErrorCode (*FfxScheduleGpuJobFunc)(FfxInterface* backendInterface, co
 /// @ingroup FfxInterface
 typedef FfxErrorCode (*FfxExecuteGpuJobsFunc)(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
 
+/// A structure describing the queue and synchronization used to execute render
+/// jobs asynchronously to the command list of a dispatch.
+///
+/// External resources are owned by the queue family of the dispatch's command
+/// list before and after the dispatch. The backend releases them to
+/// <c><i>queueFamilyIndex</i></c> on the command list and hands them back in
+/// <c><i>acquireCommandList</i></c>.
+///
+/// @ingroup FfxInterface
+typedef struct FfxAsyncComputeDescription
+{
+    FfxCommandQueue queue;                        ///< The queue the render jobs are submitted to. Access to it must be externally synchronized.
+    FfxUInt32       queueFamilyIndex;             ///< The queue family of <c><i>queue</i></c>.
+    FfxUInt32       commandListQueueFamilyIndex;  ///< The queue family of the dispatch's command list.
+    void*           waitSemaphore;                ///< A timeline semaphore the submission waits for before it starts, may only be null when the queue families match.
+    FfxUInt64       waitValue;                    ///< The value <c><i>waitSemaphore</i></c> has to reach.
+    void*           signalSemaphore;              ///< A timeline semaphore signalled once the render jobs have completed, may be null.
+    FfxUInt64       signalValue;                  ///< The value <c><i>signalSemaphore</i></c> is set to.
+    FfxCommandList  acquireCommandList;           ///< A command list of the dispatch's queue family, run after waiting on <c><i>signalSemaphore</i></c>.
+} FfxAsyncComputeDescription;
+
+/// Execute scheduled render jobs on a separate queue.
+///
+/// The render jobs are recorded into command buffers owned by the backend and
+/// submitted to <c><i>asyncCompute->queue</i></c>. This also releases the
+/// dynamic resources registered for the jobs, so
+/// <c><i>FfxUnregisterResourcesFunc</i></c> must not be called afterwards.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] commandList                         A pointer to a <c><i>FfxCommandList</i></c> structure the ownership releases are recorded into.
+/// @param [in] asyncCompute                        A pointer to a <c><i>FfxAsyncComputeDescription</i></c> structure.
+/// @param [in] effectContextId                     The context space to be used for the effect in question.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FfxInterface
+typedef FfxErrorCode (*FfxExecuteGpuJobsAsyncFunc)(FfxInterface*                     backendInterface,
+                                                   FfxCommandList                    commandList,
+                                                   const FfxAsyncComputeDescription* asyncCompute,
+                                                   FfxUInt32                         effectContextId);
+
 typedef enum FfxUiCompositionFlags
 {
     FFX_UI_COMPOSITION_FLAG_USE_PREMUL_ALPHA                    = (1 << 0),  ///< A bit indicating that we use premultiplied alpha for UI composition
@@ -578,6 +714,12 @@ typedef struct FfxInterface
 
     FfxRegisterConstantBufferAllocatorFunc
         fpRegisterConstantBufferAllocator;  ///< A callback function to register a custom <b>Thread Safe</b> constant buffer allocator.
+    FfxExecuteGpuJobsFunc             fpExecuteRecordedGpuJobs;      ///< Optional. Executes all queued render jobs, replaying a previous recording of them when unchanged.
+    FfxExecuteGpuJobsAsyncFunc        fpExecuteGpuJobsAsync;         ///< Optional. Executes all queued render jobs on a separate queue.
+    FfxSetResourceFinalStateFunc      fpSetResourceFinalState;       ///< Optional. Sets the state a registered resource is left in once unregistered.
+    FfxRegisterPersistentResourceFunc fpRegisterPersistentResource;  ///< Optional. Registers an external resource in a slot kept across dispatches.
+    FfxGetPipelineCacheDataFunc       fpGetPipelineCacheData;        ///< Optional. Retrieves the contents of the pipeline cache, to store them.
+    FfxMergePipelineCacheDataFunc     fpMergePipelineCacheData;      ///< Optional. Adds stored contents to the pipeline cache.
 
     void*     scratchBuffer;      ///< A preallocated buffer for memory utilized internally by the backend.
     size_t    scratchBufferSize;  ///< Size of the buffer pointed to by <c><i>scratchBuffer</i></c>.
@@ -56,7 +56,31 @@
 /// The size of the context specified in 32bit values.
 ///
 /// @ingroup ffxNss
-#define FFX_NSS_CONTEXT_SIZE (24576)
+#define FFX_NSS_CONTEXT_SIZE (40960)
+
+/// The number of tasks <c><i>ffxNssContextWarmupPipelines</i></c> submits
+/// when <c><i>FfxNssWarmupDescription::maxTaskCount</i></c> is 0.
+///
+/// @ingroup ffxNss
+#define FFX_NSS_WARMUP_DEFAULT_TASK_COUNT (8)
+
+/// The maximum number of views a context can upscale together, see
+/// <c><i>ffxNssContextDispatchViews</i></c>.
+///
+/// @ingroup ffxNss
+#define FFX_NSS_MAX_VIEW_COUNT (4)
+
+/// The number of resources a context can keep registered, see
+/// <c><i>ffxNssContextRegisterResource</i></c>.
+///
+/// @ingroup ffxNss
+#define FFX_NSS_MAX_REGISTERED_RESOURCES (32)
+
+/// The number of input pixels read on each side of a region of interest, so the
+/// network sees past its edges. Covers the receptive field of the built-in model.
+///
+/// @ingroup ffxNss
+#define FFX_NSS_REGION_HALO (16)
 
 #if defined(__cplusplus)
 extern "C" {
@@ -82,12 +106,15 @@ extern "C" {
 typedef enum FfxNssPass
 {
 
-    FFX_NSS_PASS_MIRROR_PADDING = 0,  ///< A pass which performs mirror padding.
-    FFX_NSS_PASS_PREPROCESS     = 1,  ///< A pass which performs preprocessing.
-    FFX_NSS_PASS_DATA_GRAPH     = 2,  ///< A pass which performs data graph.
-    FFX_NSS_PASS_POSTPROCESS    = 3,  ///< A pass which performs postprocessing.
-    FFX_NSS_PASS_DEBUG_VIEW     = 4,  ///< A pass which overlays debug views.
-    FFX_NSS_PASS_COUNT                ///< The number of passes performed by NSS.
+    FFX_NSS_PASS_MIRROR_PADDING    = 0,  ///< A pass which performs mirror padding.
+    FFX_NSS_PASS_PREPROCESS        = 1,  ///< A pass which performs preprocessing.
+    FFX_NSS_PASS_DATA_GRAPH        = 2,  ///< A pass which performs data graph.
+    FFX_NSS_PASS_POSTPROCESS       = 3,  ///< A pass which performs postprocessing.
+    FFX_NSS_PASS_DEBUG_VIEW        = 4,  ///< A pass which overlays debug views.
+    FFX_NSS_PASS_BILINEAR_UPSCALE  = 5,  ///< A pass which performs a bilinear upscale while the other pipelines are being created.
+    FFX_NSS_PASS_NETWORK           = 6,  ///< A pass which runs one layer of the network as a compute shader when the data graph is unavailable.
+    FFX_NSS_PASS_PERIPHERY_UPSCALE = 7,  ///< A pass which performs a temporal upscale of the periphery of a foveated frame.
+    FFX_NSS_PASS_COUNT                   ///< The number of passes performed by NSS.
 } FfxNssPass;
 
 /// An enumeration of all the quality modes supported by NSS.
@@ -123,15 +150,20 @@ typedef enum FfxNssShaderQualityMode
 /// @ingroup ffxNss
 typedef enum FfxNssInitializationFlagBits
 {
-    FFX_NSS_CONTEXT_FLAG_QUANTIZED              = (1 << 0),  ///< Use a quantized data graph. Resources will be quantized to 8 bits.
-    FFX_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE     = (1 << 1),  ///< A bit indicating if the input color data provided is using a high-dynamic range.
-    FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED         = (1 << 2),  ///< A bit indicating that the input depth buffer data provided is inverted [1..0].
-    FFX_NSS_CONTEXT_FLAG_DEPTH_INFINITE         = (1 << 3),  ///< A bit indicating that the input depth buffer data provided is using an infinite far plane.
-    FFX_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC       = (1 << 4),  ///< A bit indicating sample using Bicubic filtering
-    FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES = (1 << 5),  ///< A bit indicating tensor image aliasing is enable.
-    FFX_NSS_CONTEXT_FLAG_ALLOW_16BIT            = (1 << 6),  ///< A bit indicating that the runtime should allow 16bit resources to be used.
-    FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING        = (1 << 7),  ///< A bit indicating that the padding is disabled in sdk.
-    FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING  = (1 << 8),  ///< A bit indicating that the runtime should check some API values and report issues.
+    FFX_NSS_CONTEXT_FLAG_QUANTIZED               = (1 << 0),   ///< Use a quantized data graph. Resources will be quantized to 8 bits. Without it, the tensors are fp16 and an fp16 data graph is used when one is built in, otherwise the quantized one.
+    FFX_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE      = (1 << 1),   ///< A bit indicating if the input color data provided is using a high-dynamic range.
+    FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED          = (1 << 2),   ///< A bit indicating that the input depth buffer data provided is inverted [1..0].
+    FFX_NSS_CONTEXT_FLAG_DEPTH_INFINITE          = (1 << 3),   ///< A bit indicating that the input depth buffer data provided is using an infinite far plane.
+    FFX_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC        = (1 << 4),   ///< A bit indicating sample using Bicubic filtering
+    FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES  = (1 << 5),   ///< A bit indicating tensor image aliasing is enable.
+    FFX_NSS_CONTEXT_FLAG_ALLOW_16BIT             = (1 << 6),   ///< A bit indicating that the runtime should allow 16bit resources to be used.
+    FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING         = (1 << 7),   ///< A bit indicating that the padding is disabled in sdk.
+    FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING   = (1 << 8),   ///< A bit indicating that the runtime should check some API values and report issues.
+    FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION = (1 << 9),   ///< A bit indicating that pipelines should be created in the background, see <c><i>ffxNssContextGetPipelinesReady</i></c>.
+    FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS   = (1 << 10),  ///< A bit indicating that dispatches are recorded once and replayed while unchanged.
+    FFX_NSS_CONTEXT_FLAG_FUSED_PADDING           = (1 << 11),  ///< A bit indicating that input padding is fused into the passes instead of a padding pass.
+    FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST      = (1 << 12),  ///< A bit indicating that dispatches upscale a region of the resources, see <c><i>FfxNssDispatchDescription::renderOffset</i></c>.
+    FFX_NSS_CONTEXT_FLAG_FOVEATED                = (1 << 13),  ///< A bit indicating that the network only upscales a region around the gaze, see <c><i>FfxNssContextDescription::foveaSize</i></c>.
 } FfxNssInitializationFlagBits;
 
 /// Pass a string message
@@ -158,6 +190,24 @@ typedef struct FfxNssContextDescription
 
     FfxInterface  backendInterface;  ///< A set of pointers to the backend implementation for FidelityFX SDK
     FfxNssMessage fpMessage;         ///< A pointer to a function that can receive messages from the runtime.
+
+    /// The number of views upscaled by each dispatch, up to <c><i>FFX_NSS_MAX_VIEW_COUNT</i></c>. 0 is treated as 1.
+    /// Views share one run of the network, see <c><i>ffxNssContextDispatchViews</i></c>.
+    uint32_t viewCount;
+
+    /// Run the network on every <c><i>networkInterval</i></c>th dispatch only. 0 and 1 run it on every dispatch.
+    /// The dispatches in between warp the coefficients of the last run along the motion vectors, trading some
+    /// quality for the cost of the network. Resets always run the network.
+    uint32_t networkInterval;
+
+    /// With <c><i>FFX_NSS_CONTEXT_FLAG_FOVEATED</i></c>, the size of the region around the gaze the network upscales, in render
+    /// pixels. The rest of the frame takes a cheaper temporal upscale, blended with the region over its halo.
+    FfxDimensions2D foveaSize;
+
+    /// Optional. The pipeline cache data <c><i>ffxNssContextGetPipelineCacheData</i></c> returned in an earlier run, added to the
+    /// pipeline cache of the backend before the context creates its pipelines. Data of another device or driver is ignored.
+    const void* pipelineCacheData;
+    size_t      pipelineCacheDataSize;  ///< The size of <c><i>pipelineCacheData</i></c> in bytes, 0 when there is none.
 } FfxNssContextDescription;
 
 typedef enum FfxNssDispatchFlags
@@ -165,6 +215,43 @@ typedef enum FfxNssDispatchFlags
     FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW = (1 << 0),  ///< A bit indicating that the output resource will contain debug views with relevant information.
 } FfxNssDispatchFlags;
 
+/// The states the external resources of a dispatch are left in once it has executed.
+///
+/// A state of 0 leaves the resource in the state it was passed in, which is the
+/// default. The state a resource is passed in is the state NSS expects it in.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssResourceFinalStates
+{
+    FfxResourceStates color;
+    FfxResourceStates depth;
+    FfxResourceStates depthTm1;
+    FfxResourceStates motionVectors;
+    FfxResourceStates outputTm1;
+    FfxResourceStates output;
+    FfxResourceStates debugViews;
+} FfxNssResourceFinalStates;
+
+/// Handles of resources registered with <c><i>ffxNssContextRegisterResource</i></c>
+/// which take the place of the matching resources of a dispatch.
+///
+/// A handle of 0 uses the resource of the dispatch, which is the default. For a
+/// non-zero handle only the <c><i>state</i></c> of the resource of the dispatch
+/// is read: when it is not 0, the registered resource is in that state for the
+/// dispatch, otherwise in the state it was registered in.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssResourceHandles
+{
+    FfxUInt32 color;
+    FfxUInt32 depth;
+    FfxUInt32 depthTm1;
+    FfxUInt32 motionVectors;
+    FfxUInt32 outputTm1;
+    FfxUInt32 output;
+    FfxUInt32 debugViews;
+} FfxNssResourceHandles;
+
 /// A structure encapsulating the parameters for dispatching the various passes
 /// of NSS.
 ///
@@ -197,8 +284,108 @@ typedef struct FfxNssDispatchDescription
     float    frameTimeDelta;  ///< The time elapsed since the last frame (expressed in milliseconds).
     bool     reset;           ///< A boolean value which when set to true, indicates the camera has moved discontinuously.
     uint32_t flags;           ///< combination of FfxNssDispatchFlags
+
+    /// Optional. When set, the NSS passes run on <c><i>asyncCompute->queue</i></c> instead of <c><i>commandList</i></c>, which only
+    /// receives the ownership releases of the external resources. Switching between the two discards the history.
+    const FfxAsyncComputeDescription* asyncCompute;
+
+    /// Optional. Naming the state the application uses a resource in next saves transitioning it back to the state it
+    /// was passed in, only for the application to transition it again.
+    FfxNssResourceFinalStates finalStates;
+
+    /// Optional. Resources registered with the context to use in place of the ones above.
+    FfxNssResourceHandles handles;
+
+    /// With <c><i>FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST</i></c>, the top left pixel of the <c><i>renderSize</i></c> region to
+    /// upscale in the input resources. Up to <c><i>FFX_NSS_REGION_HALO</i></c> pixels around it are read too. Must be 0 otherwise.
+    FfxIntCoords2D renderOffset;
+
+    /// With <c><i>FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST</i></c>, the top left pixel of the <c><i>upscaleSize</i></c> region
+    /// written in <c><i>output</i></c>. Must be 0 otherwise. Moving either region requires <c><i>reset</i></c>.
+    FfxIntCoords2D upscaleOffset;
+
+    /// With <c><i>FFX_NSS_CONTEXT_FLAG_FOVEATED</i></c>, the gaze point relative to the centre of the view, in uv units.
+    /// The region the network upscales follows it, moving only once the gaze has left its inner part.
+    FfxFloatCoords2D gazeOffset;
 } FfxNssDispatchDescription;
 
+/// A structure describing a network model to run in place of the one built
+/// into the NSS runtime.
+///
+/// The data graph is expected in the layout emitted by <c><i>ffx_model_parser</i></c>
+/// for a VGF file. Its tensors must use the resource names, descriptor set and
+/// channel counts of the built-in model, since they are bound to the tensors
+/// owned by the <c><i>FfxNssContext</i></c>.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssModelDescription
+{
+    const FfxDataGraphBlob* dataGraph;  ///< The parsed data graph. Only needs to remain valid for the duration of <c><i>ffxNssContextSetModel</i></c>.
+} FfxNssModelDescription;
+
+/// A unit of work scheduled by <c><i>ffxNssContextWarmupPipelines</i></c>.
+///
+/// @ingroup ffxNss
+typedef void (*FfxNssTaskFunc)(void* pTaskData);
+
+/// A function which hands a task to the application's job system.
+///
+/// The task must eventually be invoked exactly once as <c><i>fpTask(pTaskData)</i></c>,
+/// on any thread. It may also be run before this function returns.
+///
+/// @ingroup ffxNss
+typedef void (*FfxNssSubmitTaskFunc)(FfxNssTaskFunc fpTask, void* pTaskData, void* pUserData);
+
+/// A structure encapsulating the parameters for pipeline warm-up.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssWarmupDescription
+{
+    FfxNssSubmitTaskFunc fpSubmitTask;  ///< Submits a task to the application's job system. If <c><i>NULL</i></c>, all work runs on the calling thread.
+    void*                pUserData;     ///< Passed unchanged to <c><i>fpSubmitTask</i></c>.
+    uint32_t             maxTaskCount;  ///< The maximum number of tasks submitted at once. 0 selects <c><i>FFX_NSS_WARMUP_DEFAULT_TASK_COUNT</i></c>.
+} FfxNssWarmupDescription;
+
+/// The inputs of one dispatch read back by a capture.
+///
+/// The resources in <c><i>dispatchDescription</i></c> only carry their
+/// descriptions, their handles and the command list are cleared. Texel data is
+/// tightly packed rows of mip 0, in the format of the resource description.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssCaptureFrame
+{
+    uint32_t                  frameIndex;             ///< The index of the frame in the capture, starting at 0.
+    FfxNssDispatchDescription dispatchDescription;    ///< The parameters the frame was dispatched with.
+    const void*               colorData;              ///< The texels of <c><i>dispatchDescription.color</i></c>.
+    uint32_t                  colorDataSize;          ///< The size of <c><i>colorData</i></c> in bytes.
+    const void*               depthData;              ///< The texels of <c><i>dispatchDescription.depth</i></c>.
+    uint32_t                  depthDataSize;          ///< The size of <c><i>depthData</i></c> in bytes.
+    const void*               motionVectorsData;      ///< The texels of <c><i>dispatchDescription.motionVectors</i></c>.
+    uint32_t                  motionVectorsDataSize;  ///< The size of <c><i>motionVectorsData</i></c> in bytes.
+    const void*               depthTm1Data;           ///< The texels of <c><i>dispatchDescription.depthTm1</i></c>, <c><i>NULL</i></c> if it was a null resource.
+    uint32_t                  depthTm1DataSize;       ///< The size of <c><i>depthTm1Data</i></c> in bytes.
+    const void*               outputTm1Data;          ///< The texels of <c><i>dispatchDescription.outputTm1</i></c>, <c><i>NULL</i></c> if it was a null resource.
+    uint32_t                  outputTm1DataSize;      ///< The size of <c><i>outputTm1Data</i></c> in bytes.
+} FfxNssCaptureFrame;
+
+/// A function receiving the frames of a capture, in dispatch order.
+///
+/// The data pointed to by <c><i>pFrame</i></c> is only valid for the duration of the call.
+///
+/// @ingroup ffxNss
+typedef void (*FfxNssCaptureFrameFunc)(const FfxNssCaptureFrame* pFrame, void* pUserData);
+
+/// A structure encapsulating the parameters for capturing the inputs of NSS.
+///
+/// @ingroup ffxNss
+typedef struct FfxNssCaptureDescription
+{
+    FfxNssCaptureFrameFunc fpCaptureFrame;  ///< Receives the captured frames. If <c><i>NULL</i></c>, capturing stops and pending frames are dropped.
+    void*                  pUserData;       ///< Passed unchanged to <c><i>fpCaptureFrame</i></c>.
+    uint32_t               frameCount;      ///< The number of dispatches to capture. 0 captures until capturing is stopped.
+} FfxNssCaptureDescription;
+
 /// A structure encapsulating the parameters for automatic generation of a reactive mask
 ///
 /// @ingroup ffxNss
@@ -302,6 +489,16 @@ FFX_API FfxErrorCode ffxNssContextCreate(FfxNssContext* pContext, const FfxNssCo
 /// documentation for <c><i>ffxNssGetJitterOffset</i></c> as well as the
 /// accompanying overview documentation for NSS.
 ///
+/// When the context was created with <c><i>FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS</i></c>,
+/// the jobs of a dispatch are recorded into a secondary command buffer kept for
+/// each queued frame, and replayed with updated constants as long as the jobs,
+/// resources and resource states match those of the recording. With the Vulkan
+/// backend, the command list must belong to the queue family given in
+/// <c><i>VkDeviceContext::queueFamilyIndex</i></c>, and the image views of the
+/// external resources are kept alive across frames, so an external image must
+/// not be destroyed until the context is destroyed or other images have been
+/// passed in for the following queued frames.
+///
 /// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
 /// @param [in] pDispatchDescription     A pointer to a <c><i>FfxNssDispatchDescription</i></c> structure.
 ///
@@ -319,6 +516,42 @@ FFX_API FfxErrorCode ffxNssContextCreate(FfxNssContext* pContext, const FfxNssCo
 /// @ingroup ffxNss
 FFX_API FfxErrorCode ffxNssContextDispatch(FfxNssContext* pContext, const FfxNssDispatchDescription* pDispatchDescription);
 
+/// Dispatch the various passes that constitute NSS for several views, such as
+/// the eyes of a stereo headset or the players of a split screen.
+///
+/// The inputs of each view are preprocessed into their own batch of the network
+/// input tensor, and the network runs once over all the batches, which saves
+/// fetching its weights and dispatching it once per view. Each view keeps its
+/// own history, and may be reset on its own.
+///
+/// <c><i>viewCount</i></c> must match <c><i>FfxNssContextDescription::viewCount</i></c>.
+/// The jobs are recorded into the <c><i>commandList</i></c>, and submitted to the
+/// <c><i>asyncCompute</i></c> queue, of the first view; these members of the
+/// other views are ignored. Only the first view is captured.
+///
+/// Contexts with more than one view need a device which can run data graphs, and
+/// can't be created with <c><i>FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES</i></c>.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [in] pDispatchDescriptions    An array of <c><i>viewCount</i></c> <c><i>FfxNssDispatchDescription</i></c> structures, one per view.
+/// @param [in] viewCount                The number of views in <c><i>pDispatchDescriptions</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>pDispatchDescriptions</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because <c><i>viewCount</i></c> doesn't match the view count of the context.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The operation failed because the <c><i>renderSize</i></c> of a view was larger than the maximum render resolution.
+/// @retval
+/// FFX_ERROR_NULL_DEVICE               The operation failed because the device inside the context was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextDispatchViews(FfxNssContext* pContext, const FfxNssDispatchDescription* pDispatchDescriptions, uint32_t viewCount);
+
 /// A helper function generate a Reactive mask from an opaque only texure and one containing translucent objects.
 ///
 /// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
@@ -330,6 +563,163 @@ FFX_API FfxErrorCode ffxNssContextDispatch(FfxNssContext* pContext, const FfxNss
 /// @ingroup ffxNss
 FFX_API FfxErrorCode ffxNssContextGenerateReactiveMask(FfxNssContext* pContext, const FfxNssGenerateReactiveDescription* pParams);
 
+/// Replace the network model used by the NSS context.
+///
+/// The model is validated against the tensors owned by the context and copied,
+/// then its data graph pipeline is built on a background thread, so this function
+/// doesn't wait for the compile. Dispatches keep running the current model until
+/// the pipeline is ready, and the first call to <c><i>ffxNssContextDispatch</i></c>
+/// after that swaps it in and resets the temporal history. A pipeline which fails
+/// to build is reported through <c><i>fpMessage</i></c> and the current model is
+/// kept. Setting another model while one is still being built waits for that build.
+/// The previous pipeline is kept alive until the frames which may still
+/// reference it have retired, so the application does not need to wait for
+/// the GPU to be idle. Like dispatch, this function must not be called
+/// concurrently with other calls on the same context.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [in] pModelDescription        A pointer to a <c><i>FfxNssModelDescription</i></c> structure.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>modelDescription</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because the model does not match the tensors expected by NSS.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextSetModel(FfxNssContext* pContext, const FfxNssModelDescription* pModelDescription);
+
+/// Query whether the pipelines of the NSS context are ready to use.
+///
+/// When the context was created with <c><i>FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION</i></c>,
+/// the preprocess, postprocess, debug view and data graph pipelines are created on
+/// a background thread. Until they are ready, <c><i>ffxNssContextDispatch</i></c>
+/// writes a bilinear upscale of the input color to the output instead. The history
+/// is reset on the first dispatch which runs the network. Contexts created without
+/// the flag are always ready.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [out] pOutReady               A pointer to a <c>bool</c> which receives whether the pipelines are ready.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>pOutReady</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// Anything else                       The error returned by the background pipeline creation, the context keeps using the bilinear upscale.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextGetPipelinesReady(FfxNssContext* pContext, bool* pOutReady);
+
+/// Precompile every pipeline permutation NSS can use on the current device.
+///
+/// Each combination of the quantized, inverted depth, bicubic resampling,
+/// 16-bit (when supported by the device) and scale preset options is built
+/// through the backend, which adds it to its pipeline cache. The context keeps
+/// the pipelines of its own permutation until it creates them, taking the
+/// warmed pipelines instead of building them, or until it is destroyed; the
+/// pipelines of the other permutations are released once built. Store the
+/// pipeline cache with <c><i>ffxNssContextGetPipelineCacheData</i></c> to
+/// spare later runs the compilation. Permutations which resolve to the same
+/// shader, or which an earlier call kept, are only built once.
+///
+/// The work is split into at most <c><i>maxTaskCount</i></c> tasks handed to
+/// <c><i>fpSubmitTask</i></c>, so it can run on an engine's job system. This
+/// function blocks until all of them have completed, so it must not be called
+/// from a thread that the submitted tasks depend on to make progress. It may
+/// run concurrently with dispatches on the same context.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [in] pWarmupDescription       A pointer to a <c><i>FfxNssWarmupDescription</i></c> structure.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>pWarmupDescription</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextWarmupPipelines(FfxNssContext* pContext, const FfxNssWarmupDescription* pWarmupDescription);
+
+/// Retrieve the contents of the pipeline cache the NSS context builds its pipelines with.
+///
+/// The data can be stored by the application, e.g. after
+/// <c><i>ffxNssContextWarmupPipelines</i></c>, and passed as
+/// <c><i>FfxNssContextDescription::pipelineCacheData</i></c> when creating a
+/// context in a later run, so the pipelines it holds are not compiled again.
+/// Call this function with a null <c><i>pData</i></c> to query the size of the
+/// data first. A backend without a pipeline cache returns a size of 0.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [out] pData                   A buffer receiving the data, or <c><i>NULL</i></c> to query its size.
+/// @param [in,out] pDataSize            The size of <c><i>pData</i></c> in bytes. Receives the size of the data written, or of all the data.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>pDataSize</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY       The buffer was too small, it holds as much of the data as fits.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextGetPipelineCacheData(FfxNssContext* pContext, void* pData, size_t* pDataSize);
+
+/// Start or stop capturing the inputs of NSS.
+///
+/// While capturing, each call to <c><i>ffxNssContextDispatch</i></c> records
+/// copies of the color, depth, motion vector, previous depth and previous
+/// output resources into readback buffers owned by the context. A frame is
+/// handed to <c><i>fpCaptureFrame</i></c> from the dispatch
+/// <c><i>FFX_MAX_QUEUED_FRAMES</i></c> frames later, once the GPU is known to
+/// have written it, so the last frames of a capture are only delivered after
+/// that many further dispatches, or when the context is destroyed. The
+/// readback buffers are sized by the first captured frame and kept until the
+/// context is destroyed; capturing stops if a later frame uses larger
+/// resources, or a format a capture can't store.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [in] pCaptureDescription      A pointer to a <c><i>FfxNssCaptureDescription</i></c> structure.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>pCaptureDescription</i></c> was <c><i>NULL</i></c>.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextSetCapture(FfxNssContext* pContext, const FfxNssCaptureDescription* pCaptureDescription);
+
+/// Register a resource with the NSS context, so dispatches can refer to it by handle.
+///
+/// The backend keeps a registered resource, and the views it creates for it,
+/// from the first dispatch which uses it until the handle is released or the
+/// context is destroyed, instead of registering it again with each dispatch.
+/// Passing the handle of an earlier registration replaces its resource, which
+/// is only needed when the image behind it or its description changes. A null
+/// resource releases the handle. The views of a replaced or released resource
+/// are destroyed once the frames in flight no longer use them. Like dispatch,
+/// this function must not be called concurrently with other calls on the same
+/// context.
+///
+/// @param [in] pContext                 A pointer to a <c><i>FfxNssContext</i></c> structure.
+/// @param [in] pResource                A pointer to the resource to register, or to a null resource to release the handle.
+/// @param [in,out] pInOutHandle         0 to register a new resource, or the handle of an earlier registration. Receives the handle, 0 once released.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c>, <c><i>pResource</i></c> or <c><i>pInOutHandle</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because the handle was not handed out by the context, or was released.
+/// @retval
+/// FFX_ERROR_OUT_OF_MEMORY             The operation failed because all <c><i>FFX_NSS_MAX_REGISTERED_RESOURCES</i></c> handles are in use.
+///
+/// @ingroup ffxNss
+FFX_API FfxErrorCode ffxNssContextRegisterResource(FfxNssContext* pContext, const FfxResource* pResource, FfxUInt32* pInOutHandle);
+
 /// Destroy the NSS context.
 ///
 /// @param [out] pContext                A pointer to a <c><i>FfxNssContext</i></c> structure to destroy.
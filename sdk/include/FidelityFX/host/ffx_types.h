@@ -715,6 +715,9 @@ typedef struct FfxDeviceCapabilities
     bool           shaderStorageBufferArrayNonUniformIndexing;  ///< The device supports shader storage buffer array non uniform indexing.
     bool           tensorSupported;                             ///< The device supports tensors.
     bool           dataGraphSupported;                          ///< The device supports data graphs.
+    bool           integerDotProductSupported;                  ///< The device supports packed integer dot products in shaders.
+    bool           pushConstant16BitSupported;                  ///< The device supports 16-bit types in push constants.
+    uint32_t       maxPushConstantsSize;                        ///< The maximum size in bytes of the constants pushed to a pipeline.
 } FfxDeviceCapabilities;
 
 /// A structure encapsulating a 2-dimensional point, using 32bit unsigned integers.
@@ -979,6 +982,7 @@ typedef struct FfxPipelineState
     uint32_t                    staticTextureUavCount;  ///< Count of static Texture UAVs used in this pipeline
     uint32_t                    staticBufferUavCount;   ///< Count of static Buffer UAVs used in this pipeline
     uint32_t                    constCount;             ///< Count of constant buffers used in this pipeline
+    uint32_t                    pushConstantSize;       ///< Size in bytes of the constants pushed to this pipeline, 0 if it only uses constant buffers
     uint32_t                    rtCount;
     uint32_t                    uavTensorCount;
     uint32_t                    srvTensorCount;
@@ -1070,6 +1074,14 @@ typedef struct FfxPipelineDescription
     FfxBindStage                      stage;                         ///< The stage(s) for which this pipeline is being built
     uint32_t                          indirectWorkload;              ///< Whether this pipeline has an indirect workload
     FfxSurfaceFormat                  backbufferFormat;              ///< For raster pipelines this contains the backbuffer format
+    const struct FfxDataGraphBlob*    dataGraphBlob;  ///< For data graph pipelines, an optional blob to build from instead of the effect's built-in permutation
+    uint32_t                          pushConstantSize;  ///< For compute pipelines, the size in bytes of the constants pushed instead of bound
+    uint32_t                          batchSize;  ///< For data graph pipelines, the batch dimension of the graph's tensors, 0 is treated as 1
+    const uint32_t*                   specializationConstants;  ///< For compute pipelines, the shader's 32bit specialization constants, indexed by constant_id
+    uint32_t                          specializationConstantCount;  ///< Number of values in specializationConstants
+    const struct FfxShaderBlob*       shaderBlob;  ///< For compute pipelines, an optional blob to build from instead of the effect's built-in permutation
+    const char*                       entryPoint;  ///< For compute pipelines, the entry point of the shader, nullptr for "main"
+    uint32_t                          dispatchesPerFrame;  ///< For compute pipelines, the most times a frame dispatches the pipeline, 0 for the backend's default
 } FfxPipelineDescription;
 
 /// A structure containing the data required to create a barrier
@@ -1180,6 +1192,7 @@ typedef struct FfxComputeJobDescription
 
     FfxConstantBuffer cbs[FFX_MAX_NUM_CONST_BUFFERS];  ///< Constant buffers to be bound in the compute job.
     wchar_t           cbNames[FFX_MAX_NUM_CONST_BUFFERS][FFX_RESOURCE_NAME_SIZE];
+    FfxConstantBuffer pushConstants;  ///< Constants pushed in the compute job when <c><i>pipeline.pushConstantSize</i></c> is not 0.
 
     wchar_t  srvTextureNames[FFX_MAX_NUM_SRVS][64];
     uint32_t uavTextureMips[FFX_MAX_NUM_UAVS];  ///< Mip level of UAV texture resources to be bound in the compute job.
@@ -1409,6 +1422,17 @@ typedef struct FfxShaderBlob
 
 } FfxShaderBlob;
 
+/// The formats the model parser records for the tensors and constants of a data graph, which are their VkFormat values.
+///
+/// @ingroup SDKTypes
+typedef enum FfxDataGraphTensorFormat
+{
+    FFX_DATA_GRAPH_TENSOR_FORMAT_UNDEFINED = 0,    ///< VK_FORMAT_UNDEFINED
+    FFX_DATA_GRAPH_TENSOR_FORMAT_R8_SINT   = 14,   ///< VK_FORMAT_R8_SINT
+    FFX_DATA_GRAPH_TENSOR_FORMAT_R16_FLOAT = 76,   ///< VK_FORMAT_R16_SFLOAT
+    FFX_DATA_GRAPH_TENSOR_FORMAT_R32_FLOAT = 100,  ///< VK_FORMAT_R32_SFLOAT
+} FfxDataGraphTensorFormat;
+
 typedef struct FfxDataGraphBlob
 {
     const uint32_t        constantNums;
@@ -1431,8 +1455,68 @@ typedef struct FfxDataGraphBlob
     const uint32_t*  tensorFormats;
     const uint32_t*  tensorDimSize;
     const uint64_t** tensorDims;
+
+    const float*   tensorQuantScales;      ///< Scale of each int8 tensor, real = (q - zero point) * scale. 0 or nullptr when the model carries none
+    const int32_t* tensorQuantZeroPoints;  ///< Zero point of each int8 tensor, nullptr when the model carries no quantization metadata
+
+    const uint32_t* constantSparsityZeroCounts;  ///< Zeros in each group along the sparsity dimension of a constant, whose data is then compressed (see ffxDataGraphExpandConstant). 0 when dense, nullptr when no constant is sparse
+    const uint32_t* constantSparsityGroupSizes;  ///< Elements in each group along the sparsity dimension of a constant
+
+    const uint32_t                    segmentNums;  ///< Number of segments of a model exported from several modules, 0 when the model is a single graph
+    const struct FfxDataGraphSegment* segments;     ///< The segments in execution order. The graph and tensor fields above describe the first graph segment
+
+    const uint32_t                  graphShapeNums;  ///< Number of resolutions the parser specialized the graph for, 0 when it's shape inferred at runtime
+    const struct FfxDataGraphShape* graphShapes;     ///< The specialized graphs, used instead of shape inference when the graph is created at their resolution
 } FfxDataGraphBlob;
 
+/// A graph module specialized offline by the model parser for the tensors it's created with,
+/// which would otherwise be shape inferred when the data graph pipeline is created.
+///
+/// @ingroup SDKTypes
+typedef struct FfxDataGraphShape
+{
+    const uint32_t       width;         ///< Width of the tensors the graph was specialized for
+    const uint32_t       height;        ///< Height of the tensors the graph was specialized for
+    const uint32_t       batchSize;     ///< Batch dimension of the tensors the graph was specialized for
+    const uint32_t       codeSize;      ///< Size in bytes of the specialized SPIR-V module
+    const unsigned char* code;          ///< The specialized SPIR-V module
+    const int64_t**      tensorShapes;  ///< The shape of each tensor of the graph in the specialized module, in the order of the graph's tensors
+    const uint64_t       graphHash;     ///< arm::computeHash of the graph data the module was specialized from, which it's only used with
+} FfxDataGraphShape;
+
+/// An enumeration of the kinds of segment a data graph model is executed as.
+///
+/// @ingroup SDKTypes
+typedef enum FfxDataGraphSegmentType
+{
+    FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH   = 0,  ///< A data graph pipeline
+    FFX_DATA_GRAPH_SEGMENT_TYPE_COMPUTE = 1,  ///< A compute shader dispatch
+} FfxDataGraphSegmentType;
+
+/// A segment of a model exported from several modules, such as the compute shaders of
+/// the operators a data graph can't express, run in order with the model's other segments.
+/// Tensors which aren't part of the model's interface are intermediates passed between segments.
+///
+/// @ingroup SDKTypes
+typedef struct FfxDataGraphSegment
+{
+    const uint32_t                 type;           ///< A <c><i>FfxDataGraphSegmentType</i></c>
+    const struct FfxDataGraphBlob* graph;          ///< For graph segments, the graph with the constants it uses, nullptr for compute segments
+    const char*                    entryPoint;     ///< The entry point of the segment's SPIR-V module
+    const uint32_t                 codeSize;       ///< Size in bytes of the segment's SPIR-V module
+    const unsigned char*           code;           ///< The segment's SPIR-V module
+    const uint32_t*                dispatchShape;  ///< For compute segments, the workgroup counts at the resolution the model was exported for
+
+    const uint32_t   tensorNums;       ///< The tensors bound by the segment, for graph segments the same as its graph's
+    const char**     tensorNames;
+    const uint32_t*  tensorSets;
+    const uint32_t*  tensorBindings;
+    const uint32_t*  tensorFormats;
+    const uint32_t*  tensorDimSize;
+    const uint64_t** tensorDims;
+    const uint32_t*  tensorResources;  ///< Index of each tensor in the model's resource table, identifies the intermediates shared by segments
+} FfxDataGraphSegment;
+
 /// A structure describing the parameters passed from the
 /// presentation thread to the ui composition callback function.
 ///
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <FidelityFX/host/ffx_types.h>
+#include <string.h>
 #if !defined(_WIN32)
 #include <wchar.h>
 #include <stdexcept>
@@ -229,3 +230,96 @@ inline uint8_t ffxCountBitsSet(uint32_t val) noexcept
     return static_cast<uint8_t>(((c >> 16) + c) & 0x0000FFFF);
 #endif
 }
+
+/// Checks whether a data graph constant is stored compressed.
+///
+/// @param [in] dataGraph      The data graph holding the constant.
+/// @param [in] constantIndex  Index of the constant in the data graph.
+///
+/// @return true when the zeros of the constant's sparsity groups are left out of its data.
+///
+/// @ingroup Utils
+inline bool ffxDataGraphConstantIsCompressed(const FfxDataGraphBlob& dataGraph, uint32_t constantIndex) noexcept
+{
+    return dataGraph.constantSparsityZeroCounts != nullptr && dataGraph.constantSparsityZeroCounts[constantIndex] != 0;
+}
+
+/// Expands a data graph constant to its dense layout.
+///
+/// The elements of a compressed constant are split into groups of <c><i>constantSparsityGroupSizes</i></c>
+/// consecutive elements along its sparsity dimension, ordered by their first element. Its data starts with a
+/// mask of the elements kept in each group, one bit per element with the first group in the lowest bits, padded
+/// to a byte. The kept elements follow, <c><i>groupSize - zeroCount</i></c> per group; the others are zero.
+///
+/// @param [in]  dataGraph      The data graph holding the constant.
+/// @param [in]  constantIndex  Index of the constant in the data graph.
+/// @param [out] outData        <c><i>constantDataSize</i></c> bytes receiving the dense constant.
+///
+/// @return false when the sparsity of the constant doesn't match its shape or data.
+///
+/// @ingroup Utils
+inline bool ffxDataGraphExpandConstant(const FfxDataGraphBlob& dataGraph, uint32_t constantIndex, uint8_t* outData) noexcept
+{
+    const uint32_t dataSize = dataGraph.constantDataSize[constantIndex];
+    const uint8_t* data     = dataGraph.constantDatas[constantIndex];
+    if (!ffxDataGraphConstantIsCompressed(dataGraph, constantIndex))
+    {
+        memcpy(outData, data, dataSize);
+        return true;
+    }
+
+    const uint32_t rank      = dataGraph.constantShapeSize[constantIndex];
+    const int64_t* shape     = dataGraph.constantShapes[constantIndex];
+    const int64_t  dimension = dataGraph.constantSparsityDimensions[constantIndex];
+    const uint32_t zeroCount = dataGraph.constantSparsityZeroCounts[constantIndex];
+    const uint32_t groupSize = dataGraph.constantSparsityGroupSizes[constantIndex];
+    if (dimension < 0 || dimension >= int64_t(rank) || zeroCount >= groupSize || (shape[dimension] % groupSize) != 0)
+        return false;
+
+    int64_t outerCount = 1;
+    int64_t innerCount = 1;
+    for (uint32_t i = 0; i < rank; ++i)
+    {
+        if (int64_t(i) < dimension)
+            outerCount *= shape[i];
+        else if (int64_t(i) > dimension)
+            innerCount *= shape[i];
+    }
+
+    const int64_t elementCount = outerCount * shape[dimension] * innerCount;
+    if (elementCount == 0 || (dataSize % elementCount) != 0)
+        return false;
+
+    const size_t   elementSize = size_t(dataSize / elementCount);
+    const int64_t  groupCount  = elementCount / groupSize;
+    const uint8_t* mask        = data;
+    const uint8_t* values      = data + (groupCount * groupSize + 7) / 8;
+    const auto     isKept      = [mask](int64_t bit) { return (mask[bit / 8] & (1u << (bit % 8))) != 0; };
+
+    memset(outData, 0, dataSize);
+    int64_t group = 0;
+    for (int64_t outer = 0; outer < outerCount; ++outer)
+    {
+        for (int64_t first = 0; first < shape[dimension]; first += groupSize)
+        {
+            for (int64_t inner = 0; inner < innerCount; ++inner, ++group)
+            {
+                uint32_t keptCount = 0;
+                for (uint32_t position = 0; position < groupSize; ++position)
+                    keptCount += isKept(group * groupSize + position) ? 1 : 0;
+                if (keptCount != groupSize - zeroCount)
+                    return false;
+
+                for (uint32_t position = 0; position < groupSize; ++position)
+                {
+                    if (!isKept(group * groupSize + position))
+                        continue;
+                    const int64_t element = (outer * shape[dimension] + first + position) * innerCount + inner;
+                    memcpy(outData + element * elementSize, values, elementSize);
+                    values += elementSize;
+                }
+            }
+        }
+    }
+    return true;
+}
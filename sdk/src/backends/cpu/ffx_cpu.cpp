@@ -0,0 +1,1089 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#include <FidelityFX/host/backends/cpu/ffx_cpu.h>
+#include <FidelityFX/host/ffx_assert.h>
+#include <FidelityFX/host/ffx_interface.h>
+#include <FidelityFX/host/ffx_util.h>
+#include <ffx_shader_blobs.h>
+
+#include "ffx_cpu_nss_kernels.h"
+
+#ifdef _WIN32
+#if !defined(__UNREAL__)  // Unreal wants to include its own minimal windows .h
+#include <windows.h>
+#endif  // if !__UNREAL__
+#endif  // _WIN32
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>  // for mbstowcs
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// prototypes for functions in the interface
+FfxVersionNumber       GetSDKVersionCPU(FfxInterface* backendInterface);
+FfxErrorCode           GetEffectGpuMemoryUsageCPU(FfxInterface* backendInterface, FfxUInt32 effectContextId, FfxEffectMemoryUsage* outVramUsage);
+FfxErrorCode           CreateBackendContextCPU(FfxInterface* backendInterface, FfxEffect effect, FfxEffectBindlessConfig* bindlessConfig, FfxUInt32* effectContextId);
+FfxErrorCode           GetDeviceCapabilitiesCPU(FfxInterface* backendInterface, FfxDeviceCapabilities* deviceCapabilities);
+FfxErrorCode           DestroyBackendContextCPU(FfxInterface* backendInterface, FfxUInt32 effectContextId);
+FfxErrorCode           CreateResourceCPU(FfxInterface*                       backendInterface,
+                                         const FfxCreateResourceDescription* createResourceDescription,
+                                         FfxUInt32                           effectContextId,
+                                         FfxResourceInternal*                outResource);
+FfxErrorCode           DestroyResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId);
+FfxErrorCode           MapResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource, void** ptr);
+FfxErrorCode           UnmapResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode           RegisterResourceCPU(FfxInterface*        backendInterface,
+                                           const FfxResource*   inResource,
+                                           FfxUInt32            effectContextId,
+                                           FfxResourceInternal* outResourceInternal);
+FfxResource            GetResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode           UnregisterResourcesCPU(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+FfxErrorCode           RegisterStaticResourceCPU(FfxInterface* backendInterface, const FfxStaticResourceDescription* desc, FfxUInt32 effectContextId);
+FfxResourceDescription GetResourceDescriptionCPU(FfxInterface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode           StageConstantBufferDataCPU(FfxInterface* backendInterface, void* data, FfxUInt32 size, FfxConstantBuffer* constantBuffer);
+FfxErrorCode           CreatePipelineCPU(FfxInterface*                 backendInterface,
+                                         FfxEffect                     effect,
+                                         FfxPass                       pass,
+                                         uint32_t                      permutationOptions,
+                                         const FfxPipelineDescription* pipelineDescription,
+                                         FfxUInt32                     effectContextId,
+                                         FfxPipelineState*             outPipeline);
+FfxErrorCode           CreateDataGraphPipelineCPU(FfxInterface*                 backendInterface,
+                                                  FfxEffect                     effect,
+                                                  FfxPass                       pass,
+                                                  uint32_t                      permutationOptions,
+                                                  const FfxPipelineDescription* pipelineDescription,
+                                                  FfxUInt32                     effectContextId,
+                                                  FfxUInt32                     renderWidth,
+                                                  FfxUInt32                     renderHeight,
+                                                  FfxPipelineState*             outPipeline);
+FfxErrorCode           DestroyPipelineCPU(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId);
+FfxErrorCode           ScheduleGpuJobCPU(FfxInterface* backendInterface, const FfxGpuJobDescription* job, FfxUInt32 effectContextId);
+FfxErrorCode           ExecuteGpuJobsCPU(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+
+static FfxCpuDeviceContext sCpuDeviceContext = {0};
+
+typedef struct BackendContext_CPU
+{
+    // A resource in host memory, tightly packed
+    typedef struct Resource
+    {
+#ifdef _DEBUG
+        char resourceName[64] = {};
+#endif
+        uint8_t*               data;
+        bool                   ownsData;  // Allocated by CreateResourceCPU rather than registered
+        uint64_t               dataSize;
+        FfxResourceDescription resourceDescription;
+        FfxResourceStates      initialState;
+        FfxResourceStates      currentState;
+        bool                   undefined;
+        bool                   dynamic;
+    } Resource;
+
+    // The pass a pipeline runs, resolved to a kernel when its jobs are executed
+    typedef struct Pipeline
+    {
+        FfxEffect effect;
+        FfxPass   pass;
+        uint32_t  permutationOptions;
+        uint32_t  specializationConstants[FFX_CPU_MAX_SPECIALIZATION_CONSTANTS];
+        uint32_t  specializationConstantCount;
+        bool      inUse;
+    } Pipeline;
+
+    typedef struct EffectContext
+    {
+        // Resource allocation
+        uint32_t nextStaticResource;
+        uint32_t nextDynamicResource;
+
+        // Pipeline allocation
+        uint32_t nextPipeline;
+
+        // Jobs scheduled until the next execute
+        uint32_t              gpuJobCount;
+        FfxGpuJobDescription* pGpuJobs;
+
+        // Usage
+        bool active;
+
+        // VRAM usage
+        FfxEffectMemoryUsage vramUsage;
+
+        // Effect identifier
+        FfxEffect effectId;
+    } EffectContext;
+
+    uint32_t refCount;
+    uint32_t maxEffectContexts;
+
+    FfxGpuJobDescription* pGpuJobs;
+
+    uint32_t   stagingRingBufferBase;
+    uint8_t*   pStagingRingBuffer;
+    std::mutex stagingRingBufferMutex;
+
+    Pipeline*      pPipelines;
+    Resource*      pResources;
+    EffectContext* pEffectContexts;
+
+    // Pipelines may be created and destroyed from several threads
+    std::mutex pipelineMutex;
+
+} BackendContext_CPU;
+
+FFX_API size_t ffxGetScratchMemorySizeCPU(size_t maxContexts)
+{
+    uint32_t gpuJobDescArraySize        = FFX_ALIGN_UP(maxContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
+    uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(maxContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
+    uint32_t pipelineArraySize          = FFX_ALIGN_UP(maxContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_CPU::Pipeline), sizeof(uint32_t));
+    uint32_t resourceArraySize          = FFX_ALIGN_UP(maxContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_CPU::Resource), sizeof(uint32_t));
+    uint32_t contextArraySize           = FFX_ALIGN_UP(maxContexts * sizeof(BackendContext_CPU::EffectContext), sizeof(uint32_t));
+
+    return FFX_ALIGN_UP(sizeof(BackendContext_CPU) + gpuJobDescArraySize + stagingRingBufferArraySize + pipelineArraySize + resourceArraySize + contextArraySize,
+                        sizeof(uint64_t));
+}
+
+// Create a FfxDevice from the CPU device settings
+FfxDevice ffxGetDeviceCPU(FfxCpuDeviceContext* cpuDeviceContext)
+{
+    sCpuDeviceContext = *cpuDeviceContext;
+    return reinterpret_cast<FfxDevice>(&sCpuDeviceContext);
+}
+
+FfxErrorCode ffxGetInterfaceCPU(FfxInterface* backendInterface, FfxDevice device, void* scratchBuffer, size_t scratchBufferSize, size_t maxContexts)
+{
+    FFX_RETURN_ON_ERROR(backendInterface, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(scratchBufferSize >= ffxGetScratchMemorySizeCPU(maxContexts), FFX_ERROR_INSUFFICIENT_MEMORY);
+
+    backendInterface->fpGetSDKVersion               = GetSDKVersionCPU;
+    backendInterface->fpGetEffectGpuMemoryUsage     = GetEffectGpuMemoryUsageCPU;
+    backendInterface->fpCreateBackendContext        = CreateBackendContextCPU;
+    backendInterface->fpGetDeviceCapabilities       = GetDeviceCapabilitiesCPU;
+    backendInterface->fpDestroyBackendContext       = DestroyBackendContextCPU;
+    backendInterface->fpCreateResource              = CreateResourceCPU;
+    backendInterface->fpDestroyResource             = DestroyResourceCPU;
+    backendInterface->fpMapResource                 = MapResourceCPU;
+    backendInterface->fpUnmapResource               = UnmapResourceCPU;
+    backendInterface->fpRegisterResource            = RegisterResourceCPU;
+    backendInterface->fpGetResource                 = GetResourceCPU;
+    backendInterface->fpUnregisterResources         = UnregisterResourcesCPU;
+    backendInterface->fpRegisterStaticResource      = RegisterStaticResourceCPU;
+    backendInterface->fpGetResourceDescription      = GetResourceDescriptionCPU;
+    backendInterface->fpStageConstantBufferDataFunc = StageConstantBufferDataCPU;
+    backendInterface->fpCreatePipeline              = CreatePipelineCPU;
+    backendInterface->fpCreateGraphicsPipeline      = nullptr;
+    backendInterface->fpCreateDataGraphPipeline     = CreateDataGraphPipelineCPU;
+    backendInterface->fpDestroyPipeline             = DestroyPipelineCPU;
+    backendInterface->fpGetPermutationBlobByIndex   = ffxGetPermutationBlobByIndex;
+    backendInterface->fpScheduleGpuJob              = ScheduleGpuJobCPU;
+    backendInterface->fpExecuteGpuJobs              = ExecuteGpuJobsCPU;
+
+    // Jobs run synchronously on the calling thread, so there is nothing to record, overlap or transition.
+    // Registering a resource only takes its pointer, so there is nothing worth keeping across dispatches either,
+    // and pipelines only pick a kernel, so there is no pipeline cache.
+    backendInterface->fpExecuteRecordedGpuJobs     = nullptr;
+    backendInterface->fpExecuteGpuJobsAsync        = nullptr;
+    backendInterface->fpSetResourceFinalState      = nullptr;
+    backendInterface->fpRegisterPersistentResource = nullptr;
+    backendInterface->fpGetPipelineCacheData       = nullptr;
+    backendInterface->fpMergePipelineCacheData     = nullptr;
+
+    // Memory assignments
+    backendInterface->scratchBuffer     = scratchBuffer;
+    backendInterface->scratchBufferSize = scratchBufferSize;
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FFX_RETURN_ON_ERROR(!backendContext->refCount, FFX_ERROR_BACKEND_API_ERROR);
+
+    // Clear everything out, the context holds mutexes so it is constructed in place rather than cleared
+    new (backendContext) BackendContext_CPU();
+
+    // Map the device
+    backendInterface->device = device;
+
+    // Assign the max number of contexts we'll be using
+    backendContext->maxEffectContexts = (uint32_t)maxContexts;
+
+    return FFX_OK;
+}
+
+FfxResource ffxGetResourceCPU(void*                            data,
+                              FfxResourceDescription           ffxResDescription,
+                              [[maybe_unused]] const wchar_t*  ffxResName,
+                              FfxResourceStates                state /*=FFX_RESOURCE_STATE_COMPUTE_READ*/)
+{
+    FfxResource resource = {};
+    resource.resource    = data;
+    resource.state       = state;
+    resource.description = ffxResDescription;
+
+#ifdef _DEBUG
+    if (ffxResName)
+    {
+        wcscpy_s(resource.name, ffxResName);
+    }
+#endif
+
+    return resource;
+}
+
+#ifdef _WIN32
+static void ConvertUTF8ToUTF16(const char* inputName, wchar_t* outputBuffer, size_t outputLen)
+{
+    if (MultiByteToWideChar(CP_UTF8, 0, inputName, -1, outputBuffer, static_cast<int>(outputLen)) == 0)
+    {
+        memset(outputBuffer, 0, outputLen * sizeof(wchar_t));
+    }
+}
+#else
+static void ConvertUTF8ToUTF16(const char* inputName, wchar_t* outputBuffer, size_t outputLen)
+{
+    memset(outputBuffer, 0, outputLen * sizeof(wchar_t));
+    mbstowcs(outputBuffer, inputName, outputLen - 1);
+}
+#endif  // _WIN32
+
+static uint32_t getDynamicResourcesStartIndex(uint32_t effectContextId)
+{
+    // dynamic resources are tracked from the max index
+    return (effectContextId * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT - 1;
+}
+
+static void resetBackendContext(BackendContext_CPU* backendContext)
+{
+    // reset the context except the maxEffectContexts in case the memory is reused for a new context
+    uint32_t maxEffectContexts = backendContext->maxEffectContexts;
+
+    backendContext->~BackendContext_CPU();
+    new (backendContext) BackendContext_CPU();
+
+    // restore the maxEffectContexts
+    backendContext->maxEffectContexts = maxEffectContexts;
+}
+
+// The size in bytes of the tightly packed contents of a resource
+static uint64_t getResourceDataSize(const FfxResourceDescription& description)
+{
+    switch (description.type)
+    {
+    case FFX_RESOURCE_TYPE_BUFFER:
+        return description.size;
+    case FFX_RESOURCE_TYPE_TENSOR:
+        return uint64_t(description.width) * description.height * description.channel * cpuGetSurfaceFormatSize(description.format);
+    case FFX_RESOURCE_TYPE_TEXTURE2D:
+        return uint64_t(description.width) * description.height * cpuGetSurfaceFormatSize(description.format);
+    default:
+        return 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CPU back end implementation
+
+FfxVersionNumber GetSDKVersionCPU(FfxInterface* /*backendInterface*/)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+FfxErrorCode GetEffectGpuMemoryUsageCPU(FfxInterface* backendInterface, FfxUInt32 effectContextId, FfxEffectMemoryUsage* outVramUsage)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != outVramUsage);
+
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    *outVramUsage = effectContext.vramUsage;
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreateBackendContextCPU(FfxInterface* backendInterface, FfxEffect effect, FfxEffectBindlessConfig* bindlessConfig, FfxUInt32* effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != backendInterface->device);
+    FFX_ASSERT_MESSAGE(bindlessConfig == nullptr, "FFXInterface: CPU: Bindless resources are not supported.");
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    // Set things up if this is the first invocation
+    if (!backendContext->refCount)
+    {
+        resetBackendContext(backendContext);
+
+        uint32_t gpuJobDescArraySize =
+            FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
+        uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
+        uint32_t pipelineArraySize =
+            FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_CPU::Pipeline), sizeof(uint32_t));
+        uint32_t resourceArraySize =
+            FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_CPU::Resource), sizeof(uint32_t));
+        uint32_t contextArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * sizeof(BackendContext_CPU::EffectContext), sizeof(uint32_t));
+        uint8_t* pMem             = (uint8_t*)((BackendContext_CPU*)(backendContext + 1));
+
+        // Map gpu job array
+        backendContext->pGpuJobs = (FfxGpuJobDescription*)pMem;
+        memset(backendContext->pGpuJobs, 0, gpuJobDescArraySize);
+        pMem += gpuJobDescArraySize;
+
+        // Map the staging ring buffer array
+        backendContext->pStagingRingBuffer = (uint8_t*)pMem;
+        memset(backendContext->pStagingRingBuffer, 0, stagingRingBufferArraySize);
+        pMem += stagingRingBufferArraySize;
+
+        // Map pipeline array
+        backendContext->pPipelines = (BackendContext_CPU::Pipeline*)pMem;
+        memset(backendContext->pPipelines, 0, pipelineArraySize);
+        pMem += pipelineArraySize;
+
+        // Map resource array
+        backendContext->pResources = (BackendContext_CPU::Resource*)pMem;
+        memset(backendContext->pResources, 0, resourceArraySize);
+        pMem += resourceArraySize;
+
+        // Map context array
+        backendContext->pEffectContexts = (BackendContext_CPU::EffectContext*)pMem;
+        memset(backendContext->pEffectContexts, 0, contextArraySize);
+        pMem += contextArraySize;
+    }
+
+    // Increment the ref count
+    ++backendContext->refCount;
+
+    // Get an available context id
+    for (uint32_t i = 0; i < backendContext->maxEffectContexts; ++i)
+    {
+        if (!backendContext->pEffectContexts[i].active)
+        {
+            *effectContextId = i;
+
+            // Reset everything accordingly
+            BackendContext_CPU::EffectContext& effectContext = backendContext->pEffectContexts[i];
+            effectContext.active                             = true;
+            effectContext.effectId                           = effect;
+            effectContext.nextStaticResource                 = (i * FFX_MAX_RESOURCE_COUNT) + 1;
+            effectContext.nextDynamicResource                = getDynamicResourcesStartIndex(i);
+            effectContext.nextPipeline                       = (i * FFX_MAX_PASS_COUNT);
+            effectContext.gpuJobCount                        = 0;
+            effectContext.pGpuJobs                           = backendContext->pGpuJobs + (i * FFX_MAX_GPU_JOBS);
+            effectContext.vramUsage                          = {};
+            break;
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode GetDeviceCapabilitiesCPU(FfxInterface* backendInterface, FfxDeviceCapabilities* deviceCapabilities)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != deviceCapabilities);
+
+    // The kernels evaluate every shader in 32-bit floats, one invocation at a time
+    deviceCapabilities->maximumSupportedShaderModel                = FFX_SHADER_MODEL_6_7;
+    deviceCapabilities->waveLaneCountMin                           = 1;
+    deviceCapabilities->waveLaneCountMax                           = 1;
+    deviceCapabilities->fp16Supported                              = false;
+    deviceCapabilities->raytracingSupported                        = false;
+    deviceCapabilities->deviceCoherentMemorySupported              = true;
+    deviceCapabilities->dedicatedAllocationSupported               = false;
+    deviceCapabilities->bufferMarkerSupported                      = false;
+    deviceCapabilities->extendedSynchronizationSupported           = false;
+    deviceCapabilities->shaderStorageBufferArrayNonUniformIndexing = false;
+
+    // Networks run as compute layers reading storage buffers with packed dot products
+    deviceCapabilities->tensorSupported            = true;
+    deviceCapabilities->dataGraphSupported         = false;
+    deviceCapabilities->integerDotProductSupported = true;
+
+    deviceCapabilities->pushConstant16BitSupported = false;
+    deviceCapabilities->maxPushConstantsSize       = 256;
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyBackendContextCPU(FfxInterface* backendInterface, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    FFX_ASSERT(backendContext->refCount > 0);
+
+    // Delete any resources allocated by this context
+    BackendContext_CPU::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    for (uint32_t currentStaticResourceIndex = effectContextId * FFX_MAX_RESOURCE_COUNT; currentStaticResourceIndex < effectContext.nextStaticResource;
+         ++currentStaticResourceIndex)
+    {
+        if (backendContext->pResources[currentStaticResourceIndex].ownsData)
+        {
+            FFX_ASSERT_MESSAGE(false, "FFXInterface: CPU: SDK Resource was not destroyed prior to destroying the backend context. There is a resource leak.");
+            FfxResourceInternal internalResource = {static_cast<int32_t>(currentStaticResourceIndex)};
+            DestroyResourceCPU(backendInterface, internalResource, effectContextId);
+        }
+    }
+
+    // Free up for use by another context
+    effectContext.nextStaticResource = 0;
+    effectContext.active             = false;
+
+    // Decrement ref count
+    --backendContext->refCount;
+
+    if (!backendContext->refCount)
+    {
+        resetBackendContext(backendContext);
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreateResourceCPU(FfxInterface*                       backendInterface,
+                               const FfxCreateResourceDescription* createResourceDescription,
+                               FfxUInt32                           effectContextId,
+                               FfxResourceInternal*                outResource)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != createResourceDescription);
+    FFX_ASSERT(NULL != outResource);
+    FFX_ASSERT_MESSAGE(createResourceDescription->initData.type != FFX_RESOURCE_INIT_DATA_TYPE_INVALID,
+                       "InitData type cannot be FFX_RESOURCE_INIT_DATA_TYPE_INVALID. Please explicitly specify the resource initialization type.");
+
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    const FfxResourceDescription& resourceDescription = createResourceDescription->resourceDescription;
+    const uint64_t                dataSize            = getResourceDataSize(resourceDescription);
+    FFX_RETURN_ON_ERROR(dataSize > 0, FFX_ERROR_INVALID_ARGUMENT);
+
+    FFX_ASSERT(effectContext.nextStaticResource + 1 < effectContext.nextDynamicResource);
+    outResource->internalIndex = effectContext.nextStaticResource++;
+
+    BackendContext_CPU::Resource* backendResource = &backendContext->pResources[outResource->internalIndex];
+    backendResource->data                         = (uint8_t*)calloc(1, size_t(dataSize));
+    FFX_RETURN_ON_ERROR(backendResource->data, FFX_ERROR_OUT_OF_MEMORY);
+
+    backendResource->ownsData            = true;
+    backendResource->dataSize            = dataSize;
+    backendResource->resourceDescription = resourceDescription;
+    backendResource->initialState        = createResourceDescription->initialState;
+    backendResource->currentState        = createResourceDescription->initialState;
+    backendResource->undefined           = false;
+    backendResource->dynamic             = false;
+
+#ifdef _DEBUG
+    size_t retval = 0;
+    wcstombs_s(&retval, backendResource->resourceName, sizeof(backendResource->resourceName), createResourceDescription->name, sizeof(backendResource->resourceName));
+    if (retval >= 64)
+        backendResource->resourceName[63] = '\0';
+#endif
+
+    switch (createResourceDescription->initData.type)
+    {
+    case FFX_RESOURCE_INIT_DATA_TYPE_BUFFER:
+        memcpy(backendResource->data, createResourceDescription->initData.buffer, size_t(std::min<uint64_t>(createResourceDescription->initData.size, dataSize)));
+        break;
+    case FFX_RESOURCE_INIT_DATA_TYPE_VALUE:
+        memset(backendResource->data, createResourceDescription->initData.value, size_t(std::min<uint64_t>(createResourceDescription->initData.size, dataSize)));
+        break;
+    default:
+        break;
+    }
+
+    effectContext.vramUsage.totalUsageInBytes += dataSize;
+    if ((resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE) == FFX_RESOURCE_FLAGS_ALIASABLE)
+    {
+        effectContext.vramUsage.aliasableUsageInBytes += dataSize;
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    if ((resource.internalIndex >= int32_t(effectContextId * FFX_MAX_RESOURCE_COUNT)) && (resource.internalIndex < int32_t(effectContext.nextStaticResource)))
+    {
+        BackendContext_CPU::Resource& backendResource = backendContext->pResources[resource.internalIndex];
+
+        if (backendResource.ownsData)
+        {
+            effectContext.vramUsage.totalUsageInBytes -= backendResource.dataSize;
+            if ((backendResource.resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE) == FFX_RESOURCE_FLAGS_ALIASABLE)
+            {
+                effectContext.vramUsage.aliasableUsageInBytes -= backendResource.dataSize;
+            }
+
+            free(backendResource.data);
+        }
+
+        backendResource = {};
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode MapResourceCPU(FfxInterface* backendInterface, FfxResourceInternal resource, void** ptr)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != ptr);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    // Every resource lives in host memory
+    *ptr = backendContext->pResources[resource.internalIndex].data;
+
+    return FFX_OK;
+}
+
+FfxErrorCode UnmapResourceCPU(FfxInterface* backendInterface, FfxResourceInternal /*resource*/)
+{
+    FFX_ASSERT(NULL != backendInterface);
+
+    return FFX_OK;
+}
+
+FfxErrorCode RegisterResourceCPU(FfxInterface*        backendInterface,
+                                 const FfxResource*   inFfxResource,
+                                 FfxUInt32            effectContextId,
+                                 FfxResourceInternal* outFfxResourceInternal)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)(backendInterface->scratchBuffer);
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    if (inFfxResource->resource == nullptr)
+    {
+        outFfxResourceInternal->internalIndex = 0;  // Always maps to FFX_<feature>_RESOURCE_IDENTIFIER_NULL;
+        return FFX_OK;
+    }
+
+    FFX_ASSERT(effectContext.nextDynamicResource > effectContext.nextStaticResource);
+    outFfxResourceInternal->internalIndex = effectContext.nextDynamicResource--;
+
+    BackendContext_CPU::Resource* backendResource = &backendContext->pResources[outFfxResourceInternal->internalIndex];
+    backendResource->data                         = reinterpret_cast<uint8_t*>(inFfxResource->resource);
+    backendResource->ownsData                     = false;
+    backendResource->dataSize                     = getResourceDataSize(inFfxResource->description);
+    backendResource->resourceDescription          = inFfxResource->description;
+    backendResource->initialState                 = inFfxResource->state;
+    backendResource->currentState                 = inFfxResource->state;
+    backendResource->undefined                    = false;
+    backendResource->dynamic                      = true;
+
+#ifdef _DEBUG
+    size_t retval = 0;
+    wcstombs_s(&retval, backendResource->resourceName, sizeof(backendResource->resourceName), inFfxResource->name, sizeof(backendResource->resourceName));
+    if (retval >= 64)
+        backendResource->resourceName[63] = '\0';
+#endif
+
+    return FFX_OK;
+}
+
+FfxResource GetResourceCPU(FfxInterface* backendInterface, FfxResourceInternal inResource)
+{
+    FFX_ASSERT(nullptr != backendInterface);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FfxResourceDescription ffxResDescription = backendInterface->fpGetResourceDescription(backendInterface, inResource);
+
+    FfxResource resource = {};
+    resource.resource    = reinterpret_cast<void*>(backendContext->pResources[inResource.internalIndex].data);
+    resource.state       = backendContext->pResources[inResource.internalIndex].currentState;
+    resource.description = ffxResDescription;
+
+#ifdef _DEBUG
+    ConvertUTF8ToUTF16(backendContext->pResources[inResource.internalIndex].resourceName, resource.name, 64);
+#endif
+
+    return resource;
+}
+
+// dispose dynamic resources: This should be called at the end of the frame
+FfxErrorCode UnregisterResourcesCPU(FfxInterface* backendInterface, FfxCommandList /*commandList*/, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)(backendInterface->scratchBuffer);
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    // Forget the memory of the resources that don't belong to us
+    const uint32_t dynamicResourceIndexStart = getDynamicResourcesStartIndex(effectContextId);
+    for (uint32_t resourceIndex = effectContext.nextDynamicResource + 1; resourceIndex <= dynamicResourceIndexStart; ++resourceIndex)
+    {
+        backendContext->pResources[resourceIndex] = {};
+    }
+
+    effectContext.nextDynamicResource = dynamicResourceIndexStart;
+
+    return FFX_OK;
+}
+
+FfxErrorCode RegisterStaticResourceCPU(FfxInterface* backendInterface, const FfxStaticResourceDescription* desc, FfxUInt32 /*effectContextId*/)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != desc);
+
+    // No effect using the CPU backend binds resources bindlessly
+    return FFX_ERROR_BACKEND_API_ERROR;
+}
+
+FfxResourceDescription GetResourceDescriptionCPU(FfxInterface* backendInterface, FfxResourceInternal resource)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FfxResourceDescription resourceDescription = backendContext->pResources[resource.internalIndex].resourceDescription;
+    return resourceDescription;
+}
+
+FfxErrorCode StageConstantBufferDataCPU(FfxInterface* backendInterface, void* data, FfxUInt32 size, FfxConstantBuffer* constantBuffer)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    if (data && constantBuffer)
+    {
+        // Effect contexts may stage their constants concurrently, so they share the ring buffers of all contexts under a lock
+        std::lock_guard<std::mutex> lock{backendContext->stagingRingBufferMutex};
+
+        if ((backendContext->stagingRingBufferBase + FFX_ALIGN_UP(size, 256)) >= backendContext->maxEffectContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE)
+            backendContext->stagingRingBufferBase = 0;
+
+        uint32_t* dstPtr = (uint32_t*)(backendContext->pStagingRingBuffer + backendContext->stagingRingBufferBase);
+
+        memcpy(dstPtr, data, size);
+
+        constantBuffer->data            = dstPtr;
+        constantBuffer->num32BitEntries = size / sizeof(uint32_t);
+
+        backendContext->stagingRingBufferBase += FFX_ALIGN_UP(size, 256);
+
+        return FFX_OK;
+    }
+    else
+        return FFX_ERROR_INVALID_POINTER;
+}
+
+// Returns a pipeline slot for the effect context, recycling slots released by DestroyPipelineCPU. Returns nullptr when all
+// FFX_MAX_PASS_COUNT slots of the effect context are in use.
+static BackendContext_CPU::Pipeline* acquirePipeline(BackendContext_CPU* backendContext, FfxUInt32 effectContextId)
+{
+    BackendContext_CPU::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    std::lock_guard<std::mutex>        lock{backendContext->pipelineMutex};
+
+    for (uint32_t pipelineIndex = effectContextId * FFX_MAX_PASS_COUNT; pipelineIndex < effectContext.nextPipeline; ++pipelineIndex)
+    {
+        BackendContext_CPU::Pipeline* pPipeline = &backendContext->pPipelines[pipelineIndex];
+        if (!pPipeline->inUse)
+        {
+            *pPipeline       = {};
+            pPipeline->inUse = true;
+            return pPipeline;
+        }
+    }
+
+    if (effectContext.nextPipeline >= (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT)
+        return nullptr;
+    BackendContext_CPU::Pipeline* pPipeline = &backendContext->pPipelines[effectContext.nextPipeline++];
+    pPipeline->inUse                        = true;
+    return pPipeline;
+}
+
+FfxErrorCode CreatePipelineCPU(FfxInterface*                 backendInterface,
+                               FfxEffect                     effect,
+                               FfxPass                       pass,
+                               uint32_t                      permutationOptions,
+                               const FfxPipelineDescription* pipelineDescription,
+                               FfxUInt32                     effectContextId,
+                               FfxPipelineState*             outPipeline)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != pipelineDescription);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FFX_RETURN_ON_ERROR(effect == FFX_EFFECT_NSS, FFX_ERROR_BACKEND_API_ERROR);
+
+    // The shader blob is only used for its reflection, which tells the effect where to bind each resource
+    FfxShaderBlob shaderBlob = {};
+    backendInterface->fpGetPermutationBlobByIndex(effect, pass, permutationOptions, &shaderBlob, nullptr, nullptr);
+    FFX_ASSERT(shaderBlob.data && shaderBlob.size);
+
+    const uint32_t constantBufferCount = (pipelineDescription->pushConstantSize > 0) ? 0 : shaderBlob.cbvCount;
+
+    uint32_t flattenedSrvTextureCount = 0;
+
+    for (uint32_t srvIndex = 0; srvIndex < shaderBlob.srvTextureCount; ++srvIndex)
+    {
+        uint32_t slotIndex = shaderBlob.boundSRVTextures[srvIndex];
+        uint32_t bindCount = shaderBlob.boundSRVTextureCounts[srvIndex];
+
+        for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+        {
+            uint32_t bindingIndex = flattenedSrvTextureCount++;
+
+            outPipeline->srvTextureBindings[bindingIndex].slotIndex  = slotIndex;
+            outPipeline->srvTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            ConvertUTF8ToUTF16(shaderBlob.boundSRVTextureNames[srvIndex], outPipeline->srvTextureBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+        }
+    }
+
+    outPipeline->srvTextureCount = flattenedSrvTextureCount;
+    FFX_ASSERT(outPipeline->srvTextureCount < FFX_MAX_NUM_SRVS);
+
+    uint32_t flattenedUavTextureCount = 0;
+
+    for (uint32_t uavIndex = 0; uavIndex < shaderBlob.uavTextureCount; ++uavIndex)
+    {
+        uint32_t slotIndex = shaderBlob.boundUAVTextures[uavIndex];
+        uint32_t bindCount = shaderBlob.boundUAVTextureCounts[uavIndex];
+
+        for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+        {
+            uint32_t bindingIndex = flattenedUavTextureCount++;
+
+            outPipeline->uavTextureBindings[bindingIndex].slotIndex  = slotIndex;
+            outPipeline->uavTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            ConvertUTF8ToUTF16(shaderBlob.boundUAVTextureNames[uavIndex], outPipeline->uavTextureBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+        }
+    }
+
+    outPipeline->uavTextureCount = flattenedUavTextureCount;
+    FFX_ASSERT(outPipeline->uavTextureCount < FFX_MAX_NUM_UAVS);
+
+    uint32_t flattenedSrvBufferCount = 0;
+
+    for (uint32_t srvIndex = 0; srvIndex < shaderBlob.srvBufferCount; ++srvIndex)
+    {
+        uint32_t slotIndex  = shaderBlob.boundSRVBuffers[srvIndex];
+        uint32_t spaceIndex = shaderBlob.boundSRVBufferSpaces[srvIndex];
+        uint32_t bindCount  = shaderBlob.boundSRVBufferCounts[srvIndex];
+
+        // Skip static resources
+        if (spaceIndex == 1)
+            continue;
+
+        for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+        {
+            uint32_t bindingIndex = flattenedSrvBufferCount++;
+
+            outPipeline->srvBufferBindings[bindingIndex].slotIndex  = slotIndex;
+            outPipeline->srvBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            ConvertUTF8ToUTF16(shaderBlob.boundSRVBufferNames[srvIndex], outPipeline->srvBufferBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+        }
+    }
+
+    outPipeline->srvBufferCount = flattenedSrvBufferCount;
+    FFX_ASSERT(outPipeline->srvBufferCount < FFX_MAX_NUM_SRVS);
+
+    uint32_t flattenedUavBufferCount = 0;
+
+    for (uint32_t uavIndex = 0; uavIndex < shaderBlob.uavBufferCount; ++uavIndex)
+    {
+        uint32_t slotIndex = shaderBlob.boundUAVBuffers[uavIndex];
+        uint32_t bindCount = shaderBlob.boundUAVBufferCounts[uavIndex];
+
+        for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+        {
+            uint32_t bindingIndex = flattenedUavBufferCount++;
+
+            outPipeline->uavBufferBindings[bindingIndex].slotIndex  = slotIndex;
+            outPipeline->uavBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            ConvertUTF8ToUTF16(shaderBlob.boundUAVBufferNames[uavIndex], outPipeline->uavBufferBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+        }
+    }
+
+    outPipeline->uavBufferCount = flattenedUavBufferCount;
+    FFX_ASSERT(outPipeline->uavBufferCount < FFX_MAX_NUM_UAVS);
+
+    {
+        uint32_t flattenedSrvTensorCount = 0;
+
+        for (uint32_t tensorIndex = 0; tensorIndex < shaderBlob.srvTensorCount; ++tensorIndex)
+        {
+            uint32_t slotIndex = shaderBlob.boundSRVTensors[tensorIndex];
+            uint32_t bindCount = shaderBlob.boundSRVTensorCounts[tensorIndex];
+
+            for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+            {
+                uint32_t bindingIndex = flattenedSrvTensorCount++;
+
+                outPipeline->srvTensorBindings[bindingIndex].slotIndex  = slotIndex;
+                outPipeline->srvTensorBindings[bindingIndex].arrayIndex = arrayIndex;
+                ConvertUTF8ToUTF16(shaderBlob.boundSRVTensorNames[tensorIndex], outPipeline->srvTensorBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+            }
+        }
+
+        outPipeline->srvTensorCount = flattenedSrvTensorCount;
+        FFX_ASSERT(outPipeline->srvTensorCount < FFX_MAX_NUM_TENSORS);
+    }
+
+    {
+        uint32_t flattenedUavTensorCount = 0;
+
+        for (uint32_t tensorIndex = 0; tensorIndex < shaderBlob.uavTensorCount; ++tensorIndex)
+        {
+            uint32_t slotIndex = shaderBlob.boundUAVTensors[tensorIndex];
+            uint32_t bindCount = shaderBlob.boundUAVTensorCounts[tensorIndex];
+
+            for (uint32_t arrayIndex = 0; arrayIndex < bindCount; arrayIndex++)
+            {
+                uint32_t bindingIndex = flattenedUavTensorCount++;
+
+                outPipeline->uavTensorBindings[bindingIndex].slotIndex  = slotIndex;
+                outPipeline->uavTensorBindings[bindingIndex].arrayIndex = arrayIndex;
+                ConvertUTF8ToUTF16(shaderBlob.boundUAVTensorNames[tensorIndex], outPipeline->uavTensorBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
+            }
+        }
+
+        outPipeline->uavTensorCount = flattenedUavTensorCount;
+        FFX_ASSERT(outPipeline->uavTensorCount < FFX_MAX_NUM_TENSORS);
+    }
+
+    for (uint32_t cbIndex = 0; cbIndex < constantBufferCount; ++cbIndex)
+    {
+        outPipeline->constantBufferBindings[cbIndex].slotIndex  = shaderBlob.boundConstantBuffers[cbIndex];
+        outPipeline->constantBufferBindings[cbIndex].arrayIndex = 1;
+        ConvertUTF8ToUTF16(shaderBlob.boundConstantBufferNames[cbIndex], outPipeline->constantBufferBindings[cbIndex].name, FFX_RESOURCE_NAME_SIZE);
+    }
+
+    outPipeline->constCount = constantBufferCount;
+    FFX_ASSERT(outPipeline->constCount < FFX_MAX_NUM_CONST_BUFFERS);
+    outPipeline->pushConstantSize = pipelineDescription->pushConstantSize;
+
+    // Remember which kernel runs the pass
+    BackendContext_CPU::Pipeline* pPipeline = acquirePipeline(backendContext, effectContextId);
+    FFX_RETURN_ON_ERROR(pPipeline != nullptr, FFX_ERROR_OUT_OF_RANGE);
+    pPipeline->effect             = effect;
+    pPipeline->pass               = pass;
+    pPipeline->permutationOptions = permutationOptions;
+
+    // The kernels read the specialization constants in place of the compiler folding them
+    FFX_RETURN_ON_ERROR(pipelineDescription->specializationConstantCount <= FFX_CPU_MAX_SPECIALIZATION_CONSTANTS, FFX_ERROR_INVALID_ARGUMENT);
+    if (pipelineDescription->specializationConstantCount > 0)
+    {
+        memcpy(pPipeline->specializationConstants,
+               pipelineDescription->specializationConstants,
+               pipelineDescription->specializationConstantCount * sizeof(uint32_t));
+    }
+    pPipeline->specializationConstantCount = pipelineDescription->specializationConstantCount;
+
+    outPipeline->passId        = pass;
+    outPipeline->rootSignature = nullptr;
+    outPipeline->cmdSignature  = nullptr;
+    outPipeline->pipeline      = reinterpret_cast<FfxPipeline>(pPipeline);
+
+    // Setup the pipeline name
+    wcscpy_s(outPipeline->name, pipelineDescription->name);
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreateDataGraphPipelineCPU(FfxInterface* /*backendInterface*/,
+                                        FfxEffect /*effect*/,
+                                        FfxPass /*pass*/,
+                                        uint32_t /*permutationOptions*/,
+                                        const FfxPipelineDescription* /*pipelineDescription*/,
+                                        FfxUInt32 /*effectContextId*/,
+                                        FfxUInt32 /*renderWidth*/,
+                                        FfxUInt32 /*renderHeight*/,
+                                        FfxPipelineState* /*outPipeline*/)
+{
+    // Data graphs are reported as unsupported, so effects run their networks as compute passes instead
+    return FFX_ERROR_BACKEND_API_ERROR;
+}
+
+FfxErrorCode DestroyPipelineCPU(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 /*effectContextId*/)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    if (!pipeline)
+        return FFX_OK;
+
+    BackendContext_CPU::Pipeline* pPipeline = reinterpret_cast<BackendContext_CPU::Pipeline*>(pipeline->pipeline);
+    if (pPipeline)
+    {
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        pPipeline->inUse = false;
+    }
+
+    pipeline->pipeline = nullptr;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ScheduleGpuJobCPU(FfxInterface* backendInterface, const FfxGpuJobDescription* job, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != job);
+
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    FFX_ASSERT(effectContext.gpuJobCount < FFX_MAX_GPU_JOBS);
+
+    effectContext.pGpuJobs[effectContext.gpuJobCount] = *job;
+    effectContext.gpuJobCount++;
+
+    return FFX_OK;
+}
+
+static CpuBinding getBinding(BackendContext_CPU* backendContext, FfxResourceInternal resource)
+{
+    const BackendContext_CPU::Resource& backendResource = backendContext->pResources[resource.internalIndex];
+    return {backendResource.data, backendResource.resourceDescription};
+}
+
+static FfxErrorCode executeGpuJobCompute(FfxInterface* backendInterface, BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    const FfxComputeJobDescription&     computeJob = job->computeJobDescriptor;
+    const BackendContext_CPU::Pipeline* pPipeline  = reinterpret_cast<const BackendContext_CPU::Pipeline*>(computeJob.pipeline.pipeline);
+    FFX_RETURN_ON_ERROR(pPipeline, FFX_ERROR_INVALID_ARGUMENT);
+
+    // Gather the bound resources by the binding slots of the shader
+    CpuPassBindings bindings    = {};
+    bindings.permutationOptions          = pPipeline->permutationOptions;
+    bindings.constants                   = computeJob.pipeline.pushConstantSize ? computeJob.pushConstants.data : computeJob.cbs[0].data;
+    bindings.specializationConstants     = pPipeline->specializationConstants;
+    bindings.specializationConstantCount = pPipeline->specializationConstantCount;
+    FFX_RETURN_ON_ERROR(bindings.constants, FFX_ERROR_INVALID_ARGUMENT);
+
+    const auto bind = [&](const FfxResourceBinding& binding, FfxResourceInternal resource) {
+        FFX_ASSERT(binding.slotIndex < FFX_CPU_MAX_BINDING_SLOTS);
+        if (binding.slotIndex < FFX_CPU_MAX_BINDING_SLOTS)
+            bindings.slots[binding.slotIndex] = getBinding(backendContext, resource);
+    };
+
+    for (uint32_t i = 0; i < computeJob.pipeline.srvTextureCount; ++i)
+        bind(computeJob.pipeline.srvTextureBindings[i], computeJob.srvTextures[i].resource);
+    for (uint32_t i = 0; i < computeJob.pipeline.uavTextureCount; ++i)
+        bind(computeJob.pipeline.uavTextureBindings[i], computeJob.uavTextures[i].resource);
+    for (uint32_t i = 0; i < computeJob.pipeline.srvBufferCount; ++i)
+        bind(computeJob.pipeline.srvBufferBindings[i], computeJob.srvBuffers[i].resource);
+    for (uint32_t i = 0; i < computeJob.pipeline.uavBufferCount; ++i)
+        bind(computeJob.pipeline.uavBufferBindings[i], computeJob.uavBuffers[i].resource);
+    for (uint32_t i = 0; i < computeJob.pipeline.srvTensorCount; ++i)
+        bind(computeJob.pipeline.srvTensorBindings[i], computeJob.srvTensors[i].resource);
+    for (uint32_t i = 0; i < computeJob.pipeline.uavTensorCount; ++i)
+        bind(computeJob.pipeline.uavTensorBindings[i], computeJob.uavTensors[i].resource);
+
+    const uint32_t rowCount = cpuGetNssPassRowCount(pPipeline->pass, bindings);
+    if (rowCount == 0)
+        return FFX_OK;
+
+    // Split the rows into chunks picked up by the worker threads as they finish the previous one
+    const FfxCpuDeviceContext* cpuDeviceContext = reinterpret_cast<const FfxCpuDeviceContext*>(backendInterface->device);
+    const uint32_t             hardwareThreads  = std::max(std::thread::hardware_concurrency(), 1u);
+    const uint32_t             threadCount      = std::min(cpuDeviceContext->threadCount ? cpuDeviceContext->threadCount : hardwareThreads, rowCount);
+    const uint32_t             rowsPerChunk     = std::max(rowCount / (threadCount * 4), 1u);
+
+    std::atomic<uint32_t> nextRow{0};
+    const auto            runChunks = [&]() {
+        for (uint32_t firstRow = nextRow.fetch_add(rowsPerChunk); firstRow < rowCount; firstRow = nextRow.fetch_add(rowsPerChunk))
+            cpuRunNssPassRows(pPipeline->pass, bindings, firstRow, std::min(rowsPerChunk, rowCount - firstRow));
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i)
+        workers.emplace_back(runChunks);
+    runChunks();
+    for (std::thread& worker : workers)
+        worker.join();
+
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobCopy(BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    const FfxCopyJobDescription&        copyJob = job->copyJobDescriptor;
+    const BackendContext_CPU::Resource& src     = backendContext->pResources[copyJob.src.internalIndex];
+    const BackendContext_CPU::Resource& dst     = backendContext->pResources[copyJob.dst.internalIndex];
+    FFX_RETURN_ON_ERROR(src.data && dst.data, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(copyJob.srcOffset <= src.dataSize && copyJob.dstOffset <= dst.dataSize, FFX_ERROR_INVALID_ARGUMENT);
+
+    const uint64_t srcRemaining = src.dataSize - copyJob.srcOffset;
+    const uint64_t dstRemaining = dst.dataSize - copyJob.dstOffset;
+    const uint64_t size         = copyJob.size ? copyJob.size : std::min(srcRemaining, dstRemaining);
+    FFX_RETURN_ON_ERROR(size <= srcRemaining && size <= dstRemaining, FFX_ERROR_INVALID_ARGUMENT);
+
+    memcpy(dst.data + copyJob.dstOffset, src.data + copyJob.srcOffset, size_t(size));
+
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobClearFloat(BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    const FfxClearFloatJobDescription&  clearJob = job->clearJobDescriptor;
+    const BackendContext_CPU::Resource& target   = backendContext->pResources[clearJob.target.internalIndex];
+    FFX_RETURN_ON_ERROR(target.data, FFX_ERROR_INVALID_ARGUMENT);
+
+    // Buffers and tensors are cleared per byte and per element, like textures with the same format
+    const uint32_t elementSize =
+        target.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER ? sizeof(uint32_t) : cpuGetSurfaceFormatSize(target.resourceDescription.format);
+    const FfxSurfaceFormat format =
+        target.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER ? FFX_SURFACE_FORMAT_R32_FLOAT : target.resourceDescription.format;
+    FFX_RETURN_ON_ERROR(elementSize > 0, FFX_ERROR_INVALID_ARGUMENT);
+
+    uint8_t texel[16];
+    cpuStoreTexel(format, texel, clearJob.color);
+    for (uint64_t offset = 0; offset + elementSize <= target.dataSize; offset += elementSize)
+        memcpy(target.data + offset, texel, elementSize);
+
+    return FFX_OK;
+}
+
+FfxErrorCode ExecuteGpuJobsCPU(FfxInterface* backendInterface, FfxCommandList /*commandList*/, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+
+    BackendContext_CPU*                backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    BackendContext_CPU::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    FfxErrorCode errorCode = FFX_OK;
+
+    // execute all GpuJobs in order, each one completes before the next starts
+    for (uint32_t currentGpuJobIndex = 0; currentGpuJobIndex < effectContext.gpuJobCount; ++currentGpuJobIndex)
+    {
+        FfxGpuJobDescription* GpuJob = &effectContext.pGpuJobs[currentGpuJobIndex];
+
+        switch (GpuJob->jobType)
+        {
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+            errorCode = executeGpuJobClearFloat(backendContext, GpuJob);
+            break;
+        case FFX_GPU_JOB_COPY:
+            errorCode = executeGpuJobCopy(backendContext, GpuJob);
+            break;
+        case FFX_GPU_JOB_COMPUTE:
+            errorCode = executeGpuJobCompute(backendInterface, backendContext, GpuJob);
+            break;
+        case FFX_GPU_JOB_BARRIER:
+        case FFX_GPU_JOB_DISCARD:
+            // Memory is coherent between jobs, and discarding can leave the contents as they are
+            break;
+        default:
+            errorCode = FFX_ERROR_BACKEND_API_ERROR;
+            break;
+        }
+
+        if (errorCode != FFX_OK)
+            break;
+    }
+
+    effectContext.gpuJobCount = 0;
+
+    return errorCode;
+}
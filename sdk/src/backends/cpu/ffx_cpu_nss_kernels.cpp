@@ -0,0 +1,2063 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#include "ffx_cpu_nss_kernels.h"
+
+#include <FidelityFX/host/ffx_assert.h>
+#include <FidelityFX/host/ffx_nss.h>
+#include "nss/ffx_nss_private.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// The kernels below mirror the GLSL in FidelityFX/gpu/nss, evaluated in 32-bit floats. The backend doesn't
+// report fp16 support, so the passes always read the 32-bit layout of NssConstants.
+namespace
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Vector helpers
+
+struct Int2
+{
+    int32_t x, y;
+};
+
+struct Float2
+{
+    float x, y;
+};
+
+struct Float3
+{
+    float x, y, z;
+};
+
+struct Float4
+{
+    float x, y, z, w;
+};
+
+inline Int2 operator+(Int2 a, Int2 b)
+{
+    return {a.x + b.x, a.y + b.y};
+}
+
+inline Float2 operator+(Float2 a, Float2 b)
+{
+    return {a.x + b.x, a.y + b.y};
+}
+
+inline Float2 operator-(Float2 a, Float2 b)
+{
+    return {a.x - b.x, a.y - b.y};
+}
+
+inline Float2 operator*(Float2 a, Float2 b)
+{
+    return {a.x * b.x, a.y * b.y};
+}
+
+inline Float2 operator*(Float2 a, float b)
+{
+    return {a.x * b, a.y * b};
+}
+
+inline Float3 operator+(Float3 a, Float3 b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+inline Float3 operator*(Float3 a, float b)
+{
+    return {a.x * b, a.y * b, a.z * b};
+}
+
+inline Float4 operator+(Float4 a, Float4 b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+}
+
+inline Float4 operator*(Float4 a, float b)
+{
+    return {a.x * b, a.y * b, a.z * b, a.w * b};
+}
+
+inline Float2 toFloat2(Int2 v)
+{
+    return {float(v.x), float(v.y)};
+}
+
+inline Float3 rgb(Float4 v)
+{
+    return {v.x, v.y, v.z};
+}
+
+inline float component(const Float4& v, int32_t index)
+{
+    return (&v.x)[index];
+}
+
+inline float lerp(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+inline Float3 lerp(Float3 a, Float3 b, float t)
+{
+    return {lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t)};
+}
+
+inline Float4 lerp(Float4 a, Float4 b, float t)
+{
+    return {lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t), lerp(a.w, b.w, t)};
+}
+
+inline float saturate(float x)
+{
+    return std::min(std::max(x, 0.0f), 1.0f);
+}
+
+inline float length(Float2 v)
+{
+    return std::sqrt(v.x * v.x + v.y * v.y);
+}
+
+inline float length(Float3 v)
+{
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+// GLSL int(): truncates towards zero, clamped so huge coordinates don't overflow.
+inline int32_t toInt(float v)
+{
+    return int32_t(std::min(std::max(v, -1073741824.0f), 1073741824.0f));
+}
+
+inline Int2 toInt2(Float2 v)
+{
+    return {toInt(v.x), toInt(v.y)};
+}
+
+inline Int2 floorInt2(Float2 v)
+{
+    return {toInt(std::floor(v.x)), toInt(std::floor(v.y))};
+}
+
+// IsOnScreen in ffx_nss_common_glsl.h
+inline bool isOnScreen(Int2 pos, Int2 size)
+{
+    return uint32_t(pos.x) < uint32_t(size.x) && uint32_t(pos.y) < uint32_t(size.y);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Surface format conversions
+
+float halfToFloat(uint16_t value)
+{
+    const uint32_t sign     = uint32_t(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0)
+    {
+        const float denormal = std::ldexp(float(mantissa), -24);
+        return sign ? -denormal : denormal;
+    }
+
+    const uint32_t bits = sign | (exponent == 31 ? (0x7F800000u | (mantissa << 13)) : (((exponent + 112) << 23) | (mantissa << 13)));
+    float          result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign    = (bits >> 16) & 0x8000u;
+    const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits > 0x7F800000u)
+        return uint16_t(sign | 0x7E00u);  // NaN
+    if (absBits >= 0x477FF000u)
+        return uint16_t(sign | 0x7C00u);  // Rounds past the largest half
+    if (absBits < 0x38800000u)
+    {
+        float absValue;
+        memcpy(&absValue, &absBits, sizeof(absValue));
+        return uint16_t(sign | uint32_t(std::lrint(absValue * 16777216.0f)));  // Denormal, multiples of 2^-24
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even
+    uint32_t       result    = (absBits - 0x38000000u) >> 13;
+    const uint32_t remainder = absBits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u)))
+        ++result;
+    return uint16_t(sign | result);
+}
+
+// Unsigned floats with a 5-bit exponent, used by the channels of R11G11B10_FLOAT
+float smallFloatToFloat(uint32_t value, uint32_t mantissaBits)
+{
+    const uint32_t exponent = value >> mantissaBits;
+    const uint32_t mantissa = value & ((1u << mantissaBits) - 1);
+
+    if (exponent == 0)
+        return std::ldexp(float(mantissa), -14 - int32_t(mantissaBits));
+    if (exponent == 31)
+        return mantissa ? NAN : INFINITY;
+    return std::ldexp(1.0f + float(mantissa) / float(1u << mantissaBits), int32_t(exponent) - 15);
+}
+
+uint32_t floatToSmallFloat(float value, uint32_t mantissaBits)
+{
+    // Negative values and NaN aren't representable
+    if (!(value > 0.0f))
+        return 0;
+
+    const uint32_t maxFinite = (30u << mantissaBits) | ((1u << mantissaBits) - 1);
+    if (std::isinf(value))
+        return 31u << mantissaBits;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t result;
+    if (bits < 0x38800000u)
+    {
+        result = uint32_t(std::lrint(std::ldexp(value, 14 + int32_t(mantissaBits))));
+    }
+    else
+    {
+        const uint32_t shift     = 23 - mantissaBits;
+        const uint32_t half      = 1u << (shift - 1);
+        const uint32_t remainder = bits & ((1u << shift) - 1);
+        result                   = (bits - 0x38000000u) >> shift;
+        if (remainder > half || (remainder == half && (result & 1u)))
+            ++result;
+    }
+    return std::min(result, maxFinite);
+}
+
+float srgbToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+inline float unorm8ToFloat(uint8_t value)
+{
+    return float(value) / 255.0f;
+}
+
+inline float snorm8ToFloat(uint8_t value)
+{
+    return std::max(float(int8_t(value)) / 127.0f, -1.0f);
+}
+
+inline uint8_t floatToUnorm8(float value)
+{
+    return uint8_t(std::lrint(saturate(value) * 255.0f));
+}
+
+inline uint8_t floatToSnorm8(float value)
+{
+    return uint8_t(int8_t(std::lrint(std::min(std::max(value, -1.0f), 1.0f) * 127.0f)));
+}
+
+template <typename T>
+inline T clampToInteger(float value)
+{
+    const float lowest  = float(std::numeric_limits<T>::lowest());
+    const float highest = float(std::numeric_limits<T>::max());
+    return T(std::min(std::max(std::nearbyint(value), lowest), highest));
+}
+
+template <typename T>
+inline T readElement(const uint8_t* texel, uint32_t index)
+{
+    T value;
+    memcpy(&value, texel + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+template <typename T>
+inline void writeElement(uint8_t* texel, uint32_t index, T value)
+{
+    memcpy(texel + index * sizeof(T), &value, sizeof(T));
+}
+
+Float4 loadTexel(FfxSurfaceFormat format, const uint8_t* texel)
+{
+    Float4 result = {0.0f, 0.0f, 0.0f, 1.0f};
+    float* out    = &result.x;
+
+    switch (format)
+    {
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = readElement<float>(texel, i);
+        break;
+    case FFX_SURFACE_FORMAT_R32G32B32A32_UINT:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = float(readElement<uint32_t>(texel, i));
+        break;
+    case FFX_SURFACE_FORMAT_R32G32B32_FLOAT:
+        for (uint32_t i = 0; i < 3; ++i)
+            out[i] = readElement<float>(texel, i);
+        break;
+    case FFX_SURFACE_FORMAT_R32G32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = readElement<float>(texel, i);
+        break;
+    case FFX_SURFACE_FORMAT_R32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        out[0] = readElement<float>(texel, 0);
+        break;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+        out[0] = float(readElement<uint32_t>(texel, 0));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = halfToFloat(readElement<uint16_t>(texel, i));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = halfToFloat(readElement<uint16_t>(texel, i));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = float(readElement<uint16_t>(texel, i));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_SINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = float(readElement<int16_t>(texel, i));
+        break;
+    case FFX_SURFACE_FORMAT_R16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+        out[0] = halfToFloat(readElement<uint16_t>(texel, 0));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UINT:
+        out[0] = float(readElement<uint16_t>(texel, 0));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+        out[0] = float(readElement<uint16_t>(texel, 0)) / 65535.0f;
+        break;
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+        out[0] = std::max(float(readElement<int16_t>(texel, 0)) / 32767.0f, -1.0f);
+        break;
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    {
+        const uint32_t packed = readElement<uint32_t>(texel, 0);
+        out[0]                = smallFloatToFloat(packed & 0x7FFu, 6);
+        out[1]                = smallFloatToFloat((packed >> 11) & 0x7FFu, 6);
+        out[2]                = smallFloatToFloat(packed >> 22, 5);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R9G9B9E5_SHAREDEXP:
+    {
+        const uint32_t packed = readElement<uint32_t>(texel, 0);
+        const int32_t  scale  = int32_t(packed >> 27) - 15 - 9;
+        for (uint32_t i = 0; i < 3; ++i)
+            out[i] = std::ldexp(float((packed >> (9 * i)) & 0x1FFu), scale);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R10G10B10A2_TYPELESS:
+    case FFX_SURFACE_FORMAT_R10G10B10A2_UNORM:
+    {
+        const uint32_t packed = readElement<uint32_t>(texel, 0);
+        for (uint32_t i = 0; i < 3; ++i)
+            out[i] = float((packed >> (10 * i)) & 0x3FFu) / 1023.0f;
+        out[3] = float(packed >> 30) / 3.0f;
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = unorm8ToFloat(texel[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SRGB:
+        for (uint32_t i = 0; i < 3; ++i)
+            out[i] = srgbToLinear(unorm8ToFloat(texel[i]));
+        out[3] = unorm8ToFloat(texel[3]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = snorm8ToFloat(texel[i]);
+        break;
+    case FFX_SURFACE_FORMAT_B8G8R8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_UNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            out[i] = unorm8ToFloat(texel[i == 3 ? 3 : 2 - i]);
+        break;
+    case FFX_SURFACE_FORMAT_B8G8R8A8_SRGB:
+        for (uint32_t i = 0; i < 3; ++i)
+            out[i] = srgbToLinear(unorm8ToFloat(texel[2 - i]));
+        out[3] = unorm8ToFloat(texel[3]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = unorm8ToFloat(texel[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_UINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            out[i] = float(texel[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+        out[0] = unorm8ToFloat(texel[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_SNORM:
+        out[0] = snorm8ToFloat(texel[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        out[0] = float(texel[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_SINT:
+        out[0] = float(int8_t(texel[0]));
+        break;
+    default:
+        FFX_ASSERT_MESSAGE(false, "FFXInterface: CPU: Unsupported surface format.");
+        break;
+    }
+
+    return result;
+}
+
+void storeTexel(FfxSurfaceFormat format, uint8_t* texel, const Float4& value)
+{
+    const float* in = &value.x;
+
+    switch (format)
+    {
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        for (uint32_t i = 0; i < 4; ++i)
+            writeElement<float>(texel, i, in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R32G32B32A32_UINT:
+        for (uint32_t i = 0; i < 4; ++i)
+            writeElement<uint32_t>(texel, i, clampToInteger<uint32_t>(in[i]));
+        break;
+    case FFX_SURFACE_FORMAT_R32G32B32_FLOAT:
+        for (uint32_t i = 0; i < 3; ++i)
+            writeElement<float>(texel, i, in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R32G32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        for (uint32_t i = 0; i < 2; ++i)
+            writeElement<float>(texel, i, in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        writeElement<float>(texel, 0, in[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+        writeElement<uint32_t>(texel, 0, clampToInteger<uint32_t>(in[0]));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+        for (uint32_t i = 0; i < 4; ++i)
+            writeElement<uint16_t>(texel, i, floatToHalf(in[i]));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+        for (uint32_t i = 0; i < 2; ++i)
+            writeElement<uint16_t>(texel, i, floatToHalf(in[i]));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            writeElement<uint16_t>(texel, i, clampToInteger<uint16_t>(in[i]));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_SINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            writeElement<int16_t>(texel, i, clampToInteger<int16_t>(in[i]));
+        break;
+    case FFX_SURFACE_FORMAT_R16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+        writeElement<uint16_t>(texel, 0, floatToHalf(in[0]));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UINT:
+        writeElement<uint16_t>(texel, 0, clampToInteger<uint16_t>(in[0]));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+        writeElement<uint16_t>(texel, 0, uint16_t(std::lrint(saturate(in[0]) * 65535.0f)));
+        break;
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+        writeElement<int16_t>(texel, 0, int16_t(std::lrint(std::min(std::max(in[0], -1.0f), 1.0f) * 32767.0f)));
+        break;
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+        writeElement<uint32_t>(texel, 0, floatToSmallFloat(in[0], 6) | (floatToSmallFloat(in[1], 6) << 11) | (floatToSmallFloat(in[2], 5) << 22));
+        break;
+    case FFX_SURFACE_FORMAT_R9G9B9E5_SHAREDEXP:
+    {
+        // Shared exponent encoding as specified for DXGI_FORMAT_R9G9B9E5_SHAREDEXP
+        const float maxValue = 65408.0f;
+        float       channels[3];
+        for (uint32_t i = 0; i < 3; ++i)
+            channels[i] = std::min(std::max(in[i], 0.0f), maxValue);
+        const float maxChannel = std::max(channels[0], std::max(channels[1], channels[2]));
+        int32_t     exponent   = std::max(-16, int32_t(std::floor(std::log2(std::max(maxChannel, 1e-30f))))) + 1 + 15;
+        float       scale      = std::ldexp(1.0f, exponent - 15 - 9);
+        if (std::lrint(maxChannel / scale) == 512)
+        {
+            scale *= 2.0f;
+            ++exponent;
+        }
+        uint32_t packed = uint32_t(exponent) << 27;
+        for (uint32_t i = 0; i < 3; ++i)
+            packed |= (uint32_t(std::lrint(channels[i] / scale)) & 0x1FFu) << (9 * i);
+        writeElement<uint32_t>(texel, 0, packed);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R10G10B10A2_TYPELESS:
+    case FFX_SURFACE_FORMAT_R10G10B10A2_UNORM:
+    {
+        uint32_t packed = uint32_t(std::lrint(saturate(in[3]) * 3.0f)) << 30;
+        for (uint32_t i = 0; i < 3; ++i)
+            packed |= uint32_t(std::lrint(saturate(in[i]) * 1023.0f)) << (10 * i);
+        writeElement<uint32_t>(texel, 0, packed);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            texel[i] = floatToUnorm8(in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SRGB:
+        for (uint32_t i = 0; i < 3; ++i)
+            texel[i] = floatToUnorm8(linearToSrgb(saturate(in[i])));
+        texel[3] = floatToUnorm8(in[3]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            texel[i] = floatToSnorm8(in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_B8G8R8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_UNORM:
+        for (uint32_t i = 0; i < 4; ++i)
+            texel[i == 3 ? 3 : 2 - i] = floatToUnorm8(in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_B8G8R8A8_SRGB:
+        for (uint32_t i = 0; i < 3; ++i)
+            texel[2 - i] = floatToUnorm8(linearToSrgb(saturate(in[i])));
+        texel[3] = floatToUnorm8(in[3]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        for (uint32_t i = 0; i < 2; ++i)
+            texel[i] = floatToUnorm8(in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_UINT:
+        for (uint32_t i = 0; i < 2; ++i)
+            texel[i] = clampToInteger<uint8_t>(in[i]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+        texel[0] = floatToUnorm8(in[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_SNORM:
+        texel[0] = floatToSnorm8(in[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        texel[0] = clampToInteger<uint8_t>(in[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_SINT:
+        texel[0] = uint8_t(clampToInteger<int8_t>(in[0]));
+        break;
+    default:
+        FFX_ASSERT_MESSAGE(false, "FFXInterface: CPU: Unsupported surface format.");
+        break;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Resource access
+
+// A texture bound to a slot, accessed the way the shaders access images.
+struct TextureView
+{
+    uint8_t*         data      = nullptr;
+    FfxSurfaceFormat format    = FFX_SURFACE_FORMAT_UNKNOWN;
+    int32_t          width     = 0;
+    int32_t          height    = 0;
+    uint32_t         texelSize = 0;
+
+    Int2 size() const
+    {
+        return {width, height};
+    }
+
+    // texelFetch/imageLoad, out of bounds reads return 0 like robust image access
+    Float4 fetch(Int2 pixel) const
+    {
+        if (data == nullptr || !isOnScreen(pixel, size()))
+            return {0.0f, 0.0f, 0.0f, 0.0f};
+        return loadTexel(format, data + (size_t(pixel.y) * size_t(width) + size_t(pixel.x)) * texelSize);
+    }
+
+    // Fetches a texel with clamp to edge addressing
+    Float4 fetchClamped(Int2 pixel) const
+    {
+        return fetch({std::min(std::max(pixel.x, 0), width - 1), std::min(std::max(pixel.y, 0), height - 1)});
+    }
+
+    // textureLod with s_LinearClamp
+    Float4 sample(Float2 uv) const
+    {
+        const float  x  = uv.x * float(width) - 0.5f;
+        const float  y  = uv.y * float(height) - 0.5f;
+        const float  fx = std::floor(x);
+        const float  fy = std::floor(y);
+        const Int2   p  = {toInt(fx), toInt(fy)};
+        const float  tx = x - fx;
+        const float  ty = y - fy;
+        const Float4 c0 = lerp(fetchClamped(p), fetchClamped({p.x + 1, p.y}), tx);
+        const Float4 c1 = lerp(fetchClamped({p.x, p.y + 1}), fetchClamped({p.x + 1, p.y + 1}), tx);
+        return lerp(c0, c1, ty);
+    }
+
+    // imageStore, out of bounds writes are dropped
+    void store(Int2 pixel, const Float4& value) const
+    {
+        if (data == nullptr || !isOnScreen(pixel, size()))
+            return;
+        storeTexel(format, data + (size_t(pixel.y) * size_t(width) + size_t(pixel.x)) * texelSize, value);
+    }
+};
+
+// A tensor bound to a slot, laid out as [1, height, width, channels].
+struct TensorView
+{
+    uint8_t* data        = nullptr;
+    int32_t  width       = 0;
+    int32_t  height      = 0;
+    int32_t  channels    = 0;
+    FfxSurfaceFormat format      = FFX_SURFACE_FORMAT_R8_SINT;  // R8_SINT, or R16_FLOAT / R32_FLOAT without quantization
+    uint32_t         elementSize = 1;
+
+    uint8_t* element(Int2 pixel, int32_t channel) const
+    {
+        return data + ((size_t(pixel.y) * size_t(width) + size_t(pixel.x)) * size_t(channels) + size_t(channel)) * elementSize;
+    }
+
+    bool contains(Int2 pixel, int32_t channel) const
+    {
+        return data != nullptr && isOnScreen(pixel, {width, height}) && uint32_t(channel) < uint32_t(channels);
+    }
+
+    // tensorReadARM of one element, out of bounds reads return 0
+    float load(Int2 pixel, int32_t channel) const
+    {
+        if (!contains(pixel, channel))
+            return 0.0f;
+        switch (format)
+        {
+        case FFX_SURFACE_FORMAT_R32_FLOAT:
+            return readElement<float>(element(pixel, channel), 0);
+        case FFX_SURFACE_FORMAT_R16_FLOAT:
+            return halfToFloat(readElement<uint16_t>(element(pixel, channel), 0));
+        default:
+            return float(int8_t(*element(pixel, channel)));
+        }
+    }
+
+    Float4 loadQuad(Int2 pixel, int32_t channel) const
+    {
+        return {load(pixel, channel), load(pixel, channel + 1), load(pixel, channel + 2), load(pixel, channel + 3)};
+    }
+
+    // tensorWriteARM of one element, out of bounds writes are dropped
+    void store(Int2 pixel, int32_t channel, float value) const
+    {
+        if (!contains(pixel, channel))
+            return;
+        switch (format)
+        {
+        case FFX_SURFACE_FORMAT_R32_FLOAT:
+            writeElement<float>(element(pixel, channel), 0, value);
+            break;
+        case FFX_SURFACE_FORMAT_R16_FLOAT:
+            writeElement<uint16_t>(element(pixel, channel), 0, floatToHalf(value));
+            break;
+        default:
+            *element(pixel, channel) = uint8_t(clampToInteger<int8_t>(value));
+            break;
+        }
+    }
+};
+
+TextureView getTexture(const CpuBinding& binding)
+{
+    TextureView view;
+    view.data   = binding.data;
+    view.format = binding.description.format;
+    view.width  = int32_t(binding.description.width);
+    view.height = int32_t(binding.description.height);
+
+    // Tensors aliased as images are read through a 4 channel view of their elements
+    if (binding.description.type == FFX_RESOURCE_TYPE_TENSOR)
+    {
+        FFX_ASSERT(binding.description.channel == 4);
+        switch (binding.description.format)
+        {
+        case FFX_SURFACE_FORMAT_R32_FLOAT:
+            view.format = FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT;
+            break;
+        case FFX_SURFACE_FORMAT_R16_FLOAT:
+            view.format = FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT;
+            break;
+        default:
+            view.format = FFX_SURFACE_FORMAT_R8G8B8A8_SNORM;
+            break;
+        }
+    }
+
+    view.texelSize = cpuGetSurfaceFormatSize(view.format);
+    if (view.texelSize == 0)
+        view.data = nullptr;
+    return view;
+}
+
+TensorView getTensor(const CpuBinding& binding)
+{
+    TensorView view;
+    view.data        = binding.data;
+    view.width       = int32_t(binding.description.width);
+    view.height      = int32_t(binding.description.height);
+    view.channels    = int32_t(binding.description.channel);
+    view.format      = binding.description.format;
+    view.elementSize = std::max(cpuGetSurfaceFormatSize(view.format), 1u);
+    return view;
+}
+
+// A tensor kept in a storage buffer on devices without tensor support, with the int8 layout of a tensor of the given width and height
+TensorView getBufferTensor(const CpuBinding& binding, int32_t width, int32_t height)
+{
+    TensorView view;
+    view.data        = binding.data;
+    view.width       = width;
+    view.height      = height;
+    view.channels    = (width > 0 && height > 0) ? int32_t(binding.description.size / uint32_t(width * height)) : 0;
+    view.format      = FFX_SURFACE_FORMAT_R8_SINT;
+    view.elementSize = 1;
+    return view;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Shared NSS helpers (ffx_nss_common_glsl.h and ffx_nss_callbacks_glsl.h)
+
+const float EPS      = 1e-7f;
+const float MAX_FP16 = 65504.0f;
+
+Float3 safeColour(Float3 x)
+{
+    return {std::min(std::max(x.x, 0.0f), MAX_FP16), std::min(std::max(x.y, 0.0f), MAX_FP16), std::min(std::max(x.z, 0.0f), MAX_FP16)};
+}
+
+Float3 tonemap(Float3 x)
+{
+    x = safeColour(x);
+    return x * (1.0f / (1.0f + std::max(std::max(x.x, x.y), x.z)));
+}
+
+Float3 inverseTonemap(Float3 x)
+{
+    const float maxValue = 1.0f - EPS;
+    x = {std::min(std::max(x.x, 0.0f), maxValue), std::min(std::max(x.y, 0.0f), maxValue), std::min(std::max(x.z, 0.0f), maxValue)};
+    return x * (1.0f / (1.0f - std::max(std::max(x.x, x.y), x.z)));
+}
+
+float luminance(Float3 rgb)
+{
+    return rgb.x * 0.2126f + rgb.y * 0.7152f + rgb.z * 0.0722f;
+}
+
+inline float dequantize(float value, const float quantParams[2])
+{
+    return (value - quantParams[1]) * quantParams[0];
+}
+
+inline Float4 dequantize(Float4 value, const float quantParams[2])
+{
+    return {dequantize(value.x, quantParams), dequantize(value.y, quantParams), dequantize(value.z, quantParams), dequantize(value.w, quantParams)};
+}
+
+inline float quantize(float value, const float quantParams[2])
+{
+    return std::min(std::max(std::nearbyint(value * quantParams[0] + quantParams[1]), -128.0f), 127.0f);
+}
+
+inline Float4 clampWeights(Float4 v)
+{
+    return {std::min(std::max(v.x, EPS), 1.0f), std::min(std::max(v.y, EPS), 1.0f), std::min(std::max(v.z, EPS), 1.0f), std::min(std::max(v.w, EPS), 1.0f)};
+}
+
+uint32_t encodeNearestDepthCoord(Int2 o)
+{
+    o = {std::min(std::max(o.x, -1), 1), std::min(std::max(o.y, -1), 1)};
+    return uint32_t((o.y + 1) << 2 | (o.x + 1));
+}
+
+Int2 decodeNearestDepthCoord(int32_t code)
+{
+    return {int32_t(code & 0x3) - 1, int32_t((code >> 2) & 0x3) - 1};
+}
+
+struct BilinearSamplingData
+{
+    Int2   offsets[4];
+    float  weights[4];
+    Int2   basePos;
+    Float2 quadCenterUv;
+};
+
+BilinearSamplingData getBilinearSamplingData(Float2 uv, Int2 size)
+{
+    BilinearSamplingData data;
+
+    const Float2 pxSample = uv * toFloat2(size) - Float2{0.5f, 0.5f};
+    const Float2 pxFloor  = {std::floor(pxSample.x), std::floor(pxSample.y)};
+    data.basePos          = toInt2(pxFloor);
+    data.quadCenterUv     = {(pxSample.x + 0.5f) / float(size.x), (pxSample.y + 0.5f) / float(size.y)};
+    const Float2 pxFrac   = pxSample - pxFloor;
+
+    data.offsets[0] = {0, 0};
+    data.offsets[2] = {1, 0};
+    data.offsets[1] = {0, 1};
+    data.offsets[3] = {1, 1};
+
+    data.weights[0] = (1.0f - pxFrac.x) * (1.0f - pxFrac.y);
+    data.weights[1] = (pxFrac.x) * (1.0f - pxFrac.y);
+    data.weights[2] = (1.0f - pxFrac.x) * (pxFrac.y);
+    data.weights[3] = (pxFrac.x) * (pxFrac.y);
+
+    return data;
+}
+
+// .x = scale or 1 / scale, .y = zero point, as taken by quantize() and dequantize()
+using QuantParams = std::array<float, 2>;
+
+// Everything the NSS passes read from NssConstants and the specialization constants, unpacked for the kernels.
+struct NssPassState
+{
+    const CpuPassBindings&             bindings;
+    const NssConstants&                cb;
+    const NssConstants32bitParameters& params;
+    const NssQuantizationConstants&    quantization;
+    const uint32_t                     options;
+
+    const Int2   outputDims;
+    const Int2   inputDims;
+    const Int2   unpaddedInputDims;
+    const Int2   unpaddedOutputDims;
+    const Float2 invOutputDims;
+    const Float2 invInputDims;
+
+    explicit NssPassState(const CpuPassBindings& passBindings)
+        : bindings(passBindings)
+        , cb(*reinterpret_cast<const NssConstants*>(passBindings.constants))
+        , params(cb.dynamicPrecision._32bit)
+        , quantization(*reinterpret_cast<const NssQuantizationConstants*>(passBindings.specializationConstants))
+        , options(passBindings.permutationOptions)
+        , outputDims{int32_t(cb._OutputDims[0]), int32_t(cb._OutputDims[1])}
+        , inputDims{int32_t(cb._InputDims[0]), int32_t(cb._InputDims[1])}
+        , unpaddedInputDims{int32_t(cb._UnpaddedInputDims[0]), int32_t(cb._UnpaddedInputDims[1])}
+        , unpaddedOutputDims{int32_t(cb._UnpaddedOutputDims[0]), int32_t(cb._UnpaddedOutputDims[1])}
+        , invOutputDims{cb._InvOutputDims[0], cb._InvOutputDims[1]}
+        , invInputDims{cb._InvInputDims[0], cb._InvInputDims[1]}
+    {
+        FFX_ASSERT_MESSAGE((options & NSS_SHADER_PERMUTATION_ALLOW_16BIT) == 0, "FFXInterface: CPU: The NSS passes only read 32-bit constants.");
+        FFX_ASSERT_MESSAGE(passBindings.specializationConstantCount >= NSS_SPECIALIZATION_CONSTANT_COUNT,
+                           "FFXInterface: CPU: The NSS passes need the quantization of the model as specialization constants.");
+    }
+
+    bool quantized() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_QUANTIZED) != 0;
+    }
+
+    bool reverseZ() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_REVERSE_Z) != 0;
+    }
+
+    bool aliasTensorsAsImages() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_ALIAS_OUTPUT_TENSORS_AS_IMAGES) != 0;
+    }
+
+    bool fusedPadding() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_FUSED_PADDING) != 0;
+    }
+
+    bool warpCoefficients() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_WARP_COEFFICIENTS) != 0;
+    }
+
+    bool scaleModeX2() const
+    {
+        return (options & NSS_SHADER_PERMUTATION_SCALE_PRESET_MODE_X2) != 0;
+    }
+
+    TextureView texture(uint32_t slot) const
+    {
+        return getTexture(bindings.slots[slot]);
+    }
+
+    // The tensors are buffers at the input resolution when the device has no tensor support
+    TensorView tensor(uint32_t slot) const
+    {
+        const CpuBinding& binding = bindings.slots[slot];
+        if (binding.description.type == FFX_RESOURCE_TYPE_BUFFER)
+            return getBufferTensor(binding, inputDims.x, inputDims.y);
+        return getTensor(binding);
+    }
+
+    float exposure() const
+    {
+        return params._Exposure[0];
+    }
+
+    float invExposure() const
+    {
+        return params._Exposure[1];
+    }
+
+    float notHistoryReset() const
+    {
+        return params._NotHistoryReset;
+    }
+
+    bool reuseCoefficients() const
+    {
+        return params._ReuseCoefficients != 0;
+    }
+
+    // InputQuantParams()
+    QuantParams inputQuantParams() const
+    {
+        return {1.0f / quantization.input[0], quantization.input[1]};
+    }
+
+    // InputDequantParams()
+    QuantParams inputDequantParams() const
+    {
+        return {quantization.input[0], quantization.input[1]};
+    }
+
+    // NSS_OUTPUT_QUANT_PARAMS(), the aliased images read the int8 values as snorm
+    QuantParams outputQuantParams(const FfxFloat32x2& tensorQuantization) const
+    {
+        if (aliasTensorsAsImages())
+            return {tensorQuantization[0] * 127.0f, tensorQuantization[1] / 127.0f};
+        return {tensorQuantization[0], tensorQuantization[1]};
+    }
+
+    // FeedbackQuantParams()
+    QuantParams feedbackQuantParams() const
+    {
+        return outputQuantParams(quantization.feedback);
+    }
+
+    // K0QuantParams() to K3QuantParams()
+    QuantParams kernelQuantParams(uint32_t kernel) const
+    {
+        const FfxFloat32x2* kernels[] = {&quantization.k0, &quantization.k1, &quantization.k2, &quantization.k3};
+        return outputQuantParams(*kernels[kernel]);
+    }
+
+    // TemporalQuantParams()
+    QuantParams temporalQuantParams() const
+    {
+        return outputQuantParams(quantization.temporal);
+    }
+
+    // PaddedToInputPixel()
+    Int2 paddedToInputPixel(Int2 pixel) const
+    {
+        if (!fusedPadding())
+            return pixel;
+        pixel = {pixel.x + cb._InputOffset[0], pixel.y + cb._InputOffset[1]};
+        pixel = {std::max(pixel.x, -1 - pixel.x), std::max(pixel.y, -1 - pixel.y)};
+        return {std::max(std::min(pixel.x, 2 * unpaddedInputDims.x - 1 - pixel.x), 0), std::max(std::min(pixel.y, 2 * unpaddedInputDims.y - 1 - pixel.y), 0)};
+    }
+
+    // PaddedToInputUv()
+    Float2 paddedToInputUv(Float2 uv) const
+    {
+        if (!fusedPadding())
+            return uv;
+        const Float2 dims  = toFloat2(unpaddedInputDims);
+        const Float2 pixel = {std::fabs(uv.x * float(inputDims.x) + float(cb._InputOffset[0])), std::fabs(uv.y * float(inputDims.y) + float(cb._InputOffset[1]))};
+        return {std::min(pixel.x, 2.0f * dims.x - pixel.x) / dims.x, std::min(pixel.y, 2.0f * dims.y - pixel.y) / dims.y};
+    }
+
+    float getViewSpaceDepth(float deviceDepth) const
+    {
+        return cb._DeviceToViewDepth[1] / (deviceDepth - cb._DeviceToViewDepth[0]);
+    }
+
+    Float3 getViewSpacePosition(Int2 viewportPos, Int2 viewportSize, float deviceDepth) const
+    {
+        const float z = getViewSpaceDepth(deviceDepth);
+
+        // ComputeNdc() swaps the axes
+        const Float2 ndc = {float(viewportPos.y) / float(viewportSize.y) * 2.0f - 1.0f, float(viewportPos.x) / float(viewportSize.x) * -2.0f + 1.0f};
+        return {cb._DeviceToViewDepth[2] * ndc.x * z, cb._DeviceToViewDepth[3] * ndc.y * z, z};
+    }
+
+    // LoadMotion()
+    Float2 loadMotion(const TextureView& motionTexture, Int2 pixel) const
+    {
+        const Float4 motion = motionTexture.fetch(paddedToInputPixel(pixel));
+        return Float2{motion.x, motion.y} * Float2{cb._MotionVectorScale[0], cb._MotionVectorScale[1]};
+    }
+
+    // Sample<Name>Tensor() for tensors, or the sampler path when they are aliased as images
+    Float4 sampleOutputTensor(uint32_t slot, Float2 uv, const QuantParams& quantParams) const
+    {
+        if (aliasTensorsAsImages())
+        {
+            const Float4 value = texture(slot).sample(uv);
+            return quantized() ? dequantize(value, quantParams.data()) : value;
+        }
+
+        const TensorView t     = tensor(slot);
+        const Float2     coord = uv * toFloat2({t.width, t.height}) - Float2{0.5f, 0.5f};
+        const Int2       f     = {std::min(t.width - 1, toInt(std::max(0.0f, std::floor(coord.x)))),
+                                  std::min(t.height - 1, toInt(std::max(0.0f, std::floor(coord.y))))};
+        const Int2       c     = {std::min(t.width - 1, toInt(std::max(0.0f, std::ceil(coord.x)))),
+                                  std::min(t.height - 1, toInt(std::max(0.0f, std::ceil(coord.y))))};
+        const Float2     frac  = coord - Float2{std::floor(coord.x), std::floor(coord.y)};
+
+        Float4 c00 = t.loadQuad(f, 0);
+        Float4 c01 = t.loadQuad({f.x, c.y}, 0);
+        Float4 c10 = t.loadQuad({c.x, f.y}, 0);
+        Float4 c11 = t.loadQuad(c, 0);
+        if (quantized())
+        {
+            c00 = dequantize(c00, quantParams.data());
+            c01 = dequantize(c01, quantParams.data());
+            c10 = dequantize(c10, quantParams.data());
+            c11 = dequantize(c11, quantParams.data());
+        }
+        return lerp(lerp(c00, c01, frac.y), lerp(c10, c11, frac.y), frac.x);
+    }
+
+    // FindNearestDepth()
+    void findNearestDepth(const TextureView& depthTexture, Int2 pixel, Int2 size, float& nearestDepth, Int2& nearestDepthOffset) const
+    {
+        static const Int2 sampleOffsets[9] = {{0, 0}, {0, 1}, {1, 0}, {-1, 0}, {0, -1}, {1, -1}, {1, 1}, {-1, -1}, {-1, 1}};
+
+        float depth[9];
+        for (uint32_t sampleIndex = 0; sampleIndex < 9; ++sampleIndex)
+            depth[sampleIndex] = depthTexture.fetch(paddedToInputPixel(pixel + sampleOffsets[sampleIndex])).x;
+
+        nearestDepth       = depth[0];
+        nearestDepthOffset = sampleOffsets[0];
+        for (uint32_t sampleIndex = 1; sampleIndex < 9; ++sampleIndex)
+        {
+            if (isOnScreen(pixel + sampleOffsets[sampleIndex], size))
+            {
+                const float sampleDepth = depth[sampleIndex];
+                if (reverseZ() ? sampleDepth > nearestDepth : sampleDepth < nearestDepth)
+                {
+                    nearestDepth       = sampleDepth;
+                    nearestDepthOffset = sampleOffsets[sampleIndex];
+                }
+            }
+        }
+    }
+
+    // LoadNearestDepthOffset() and LoadDepthNearestDepthOffsetTm1()
+    Int2 loadNearestDepthOffset(const TextureView& nearestTexture, Int2 pixel) const
+    {
+        const float encoded = nearestTexture.fetch(pixel).x;
+        return decodeNearestDepthCoord(toInt(encoded * 255.0f + 0.5f));
+    }
+
+    // WriteUpsampledColour()
+    void writeUpsampledColour(const TextureView& upscaled, const TextureView& unpadded, Int2 pixel, Float3 colour) const
+    {
+        const Float3 toWrite = safeColour(colour);
+        upscaled.store(pixel, {toWrite.x, toWrite.y, toWrite.z, 1.0f});
+
+        // A region of interest only writes the pixels inside its halo, moved to where the region is in the output
+        const Int2 regionPixel = {pixel.x - cb._OutputRegion[0], pixel.y - cb._OutputRegion[1]};
+        const Int2 outputPixel = {regionPixel.x + cb._OutputRegion[2], regionPixel.y + cb._OutputRegion[3]};
+        if (regionPixel.x >= 0 && regionPixel.y >= 0 && regionPixel.x < unpaddedOutputDims.x && regionPixel.y < unpaddedOutputDims.y)
+        {
+            unpadded.store(outputPixel, {toWrite.x, toWrite.y, toWrite.z, 1.0f});
+        }
+        else if (cb._FoveaRect[0] < cb._FoveaRect[2] && cb._FoveaRect[1] < cb._FoveaRect[3])
+        {
+            // A fovea fades into the periphery over its halo
+            const int32_t distanceX = std::max(std::max(-regionPixel.x, regionPixel.x + 1 - unpaddedOutputDims.x), 0);
+            const int32_t distanceY = std::max(std::max(-regionPixel.y, regionPixel.y + 1 - unpaddedOutputDims.y), 0);
+            const float   weight    = 1.0f - std::max(float(distanceX) / float(cb._OutputRegion[0]), float(distanceY) / float(cb._OutputRegion[1]));
+            if (weight > 0.0f && isOnScreen(outputPixel, unpadded.size()))
+            {
+                const Float3 blended = lerp(rgb(unpadded.fetch(outputPixel)), toWrite, weight);
+                unpadded.store(outputPixel, {blended.x, blended.y, blended.z, 1.0f});
+            }
+        }
+    }
+
+    // LoadKPNWeight()
+    Float4 loadKpnWeight(uint32_t firstKernelSlot, Float2 uv, int32_t lutIndex) const
+    {
+        const Float4 k0 = sampleOutputTensor(firstKernelSlot + 0, uv, kernelQuantParams(0));
+        const Float4 k1 = sampleOutputTensor(firstKernelSlot + 1, uv, kernelQuantParams(1));
+        const Float4 k2 = sampleOutputTensor(firstKernelSlot + 2, uv, kernelQuantParams(2));
+        const Float4 k3 = sampleOutputTensor(firstKernelSlot + 3, uv, kernelQuantParams(3));
+
+        switch (lutIndex)
+        {
+        case 0:
+            return {k0.x, k2.x, k0.z, k2.z};
+        case 1:
+            return {k1.x, k3.x, k1.z, k3.z};
+        case 2:
+            return {k0.y, k2.y, k0.w, k2.w};
+        default:
+            return {k1.y, k3.y, k1.w, k3.w};
+        }
+    }
+
+    // LoadTemporalParameters()
+    void loadTemporalParameters(uint32_t temporalSlot, Float2 uv, float& theta, float& alpha) const
+    {
+        const Float4 tp = sampleOutputTensor(temporalSlot, uv, temporalQuantParams());
+        theta           = tp.x * notHistoryReset();
+        alpha           = tp.y * 0.35f + 0.05f;
+    }
+
+    // The LUT index of an output pixel in the 2x scale mode
+    int32_t kernelLutIndex(Int2 outputPixel) const
+    {
+        const int32_t moduloX = int32_t(params._IndexModulo[0]);
+        const int32_t moduloY = int32_t(params._IndexModulo[1]);
+        const int32_t tiledX  = (outputPixel.x + int32_t(params._LutOffset[0])) % moduloX;
+        const int32_t tiledY  = (outputPixel.y + int32_t(params._LutOffset[1])) % moduloY;
+        return tiledY * moduloX + tiledX;
+    }
+};
+
+// kernelLUT of the 2x scale mode in ffx_nss_common_glsl.h
+struct KernelTile
+{
+    int32_t dx[4];
+    int32_t dy[4];
+};
+
+const KernelTile kernelLUT[4] = {{{-1, +1, -1, +1}, {-1, -1, +1, +1}},
+                                 {{0, +2, 0, +2}, {-1, -1, +1, +1}},
+                                 {{-1, +1, -1, +1}, {0, 0, +2, +2}},
+                                 {{0, +2, 0, +2}, {0, 0, +2, +2}}};
+
+//////////////////////////////////////////////////////////////////////////
+// Mirror padding (ffx_nss_mirror_padding.glsl)
+
+enum MirrorPaddingSlot : uint32_t
+{
+    MIRROR_PADDING_SRV_UNPADDED_COLOR     = 0,
+    MIRROR_PADDING_SRV_UNPADDED_DEPTH     = 1,
+    MIRROR_PADDING_SRV_UNPADDED_MOTION    = 2,
+    MIRROR_PADDING_SRV_UNPADDED_DEPTH_TM1 = 3,
+    MIRROR_PADDING_UAV_PADDED_COLOR       = 4,
+    MIRROR_PADDING_UAV_PADDED_DEPTH       = 5,
+    MIRROR_PADDING_UAV_PADDED_MOTION      = 6,
+    MIRROR_PADDING_UAV_PADDED_DEPTH_TM1   = 7,
+};
+
+void runMirrorPadding(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView unpaddedColor    = s.texture(MIRROR_PADDING_SRV_UNPADDED_COLOR);
+    const TextureView unpaddedDepth    = s.texture(MIRROR_PADDING_SRV_UNPADDED_DEPTH);
+    const TextureView unpaddedMotion   = s.texture(MIRROR_PADDING_SRV_UNPADDED_MOTION);
+    const TextureView unpaddedDepthTm1 = s.texture(MIRROR_PADDING_SRV_UNPADDED_DEPTH_TM1);
+    const TextureView paddedColor      = s.texture(MIRROR_PADDING_UAV_PADDED_COLOR);
+    const TextureView paddedDepth      = s.texture(MIRROR_PADDING_UAV_PADDED_DEPTH);
+    const TextureView paddedMotion     = s.texture(MIRROR_PADDING_UAV_PADDED_MOTION);
+    const TextureView paddedDepthTm1   = s.texture(MIRROR_PADDING_UAV_PADDED_DEPTH_TM1);
+
+    const Int2 unpaddedDims = s.unpaddedInputDims;
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < s.inputDims.x; ++x)
+        {
+            Int2 unpaddedPixel = {x, y};
+            if (unpaddedPixel.x >= unpaddedDims.x)
+                unpaddedPixel.x = (unpaddedDims.x - 1) - (unpaddedPixel.x - unpaddedDims.x);
+            if (unpaddedPixel.y >= unpaddedDims.y)
+                unpaddedPixel.y = (unpaddedDims.y - 1) - (unpaddedPixel.y - unpaddedDims.y);
+            const Float2 unpaddedUv = {(float(unpaddedPixel.x) + 0.5f) / float(unpaddedDims.x), (float(unpaddedPixel.y) + 0.5f) / float(unpaddedDims.y)};
+
+            const Float3 color  = rgb(unpaddedColor.sample(unpaddedUv));
+            const Float4 motion = unpaddedMotion.sample(unpaddedUv);
+            paddedColor.store({x, y}, {color.x, color.y, color.z, 1.0f});
+            paddedDepth.store({x, y}, {unpaddedDepth.sample(unpaddedUv).x, 0.0f, 0.0f, 1.0f});
+            paddedMotion.store({x, y}, {motion.x, motion.y, 0.0f, 1.0f});
+            paddedDepthTm1.store({x, y}, {unpaddedDepthTm1.sample(unpaddedUv).x, 0.0f, 0.0f, 1.0f});
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Preprocess (ffx_nss_pre_process.glsl)
+
+enum PreprocessSlot : uint32_t
+{
+    PREPROCESS_SRV_INPUT_COLOR_JITTERED    = 0,
+    PREPROCESS_SRV_INPUT_DEPTH             = 1,
+    PREPROCESS_SRV_INPUT_MOTION_VECTORS    = 2,
+    PREPROCESS_SRV_HISTORY_UPSCALED_COLOR  = 3,
+    PREPROCESS_SRV_FEEDBACK_TM1_TENSOR     = 4,
+    PREPROCESS_SRV_INPUT_DEPTH_TM1         = 5,
+    PREPROCESS_SRV_LUMA_DERIV_TM1          = 6,
+    PREPROCESS_SRV_NEAREST_DEPTH_COORD_TM1 = 7,
+    PREPROCESS_SRV_COEFFICIENT_UV_TM1      = 8,
+    PREPROCESS_UAV_PREPROCESS_INPUT_TENSOR = 9,
+    PREPROCESS_UAV_LUMA_DERIV              = 10,
+    PREPROCESS_UAV_NEAREST_DEPTH_COORD     = 11,
+    PREPROCESS_UAV_COEFFICIENT_UV          = 12,
+};
+
+// ComputeDepthClip()
+float computeDepthClip(const NssPassState& s, const TextureView& depthTm1, const TextureView& nearestTm1, Float2 uvSample, float currentDepthSample)
+{
+    const float                reconstructedDepthBilinearWeightThreshold = 0.1f;
+    const Int2                 renderSize                                = s.inputDims;
+    const float                currentDepthViewSpace                     = s.getViewSpaceDepth(currentDepthSample);
+    const BilinearSamplingData bilinearInfo                              = getBilinearSamplingData(uvSample, renderSize);
+
+    // GatherReconstructedPreviousDepthRQuad()
+    float        prevDepthSamples[4];
+    const Float2 quadUv   = bilinearInfo.quadCenterUv;
+    const Int2   offset   = s.loadNearestDepthOffset(nearestTm1, toInt2(quadUv * toFloat2(renderSize)));
+    const Float2 offsetUv = toFloat2(offset) * s.invInputDims;
+    const Int2   base     = floorInt2((quadUv + offsetUv) * toFloat2(renderSize) - Float2{0.5f, 0.5f});
+    const Int2   quadOffsets[4] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        // Without fused padding, textureGather(...).wzxy of a clamping sampler
+        prevDepthSamples[i] = s.fusedPadding() ? depthTm1.fetch(s.paddedToInputPixel(base + quadOffsets[i])).x : depthTm1.fetchClamped(base + quadOffsets[i]).x;
+    }
+
+    float depth     = 0.0f;
+    float weightSum = 0.0f;
+
+    for (uint32_t sampleIndex = 0; sampleIndex < 4; ++sampleIndex)
+    {
+        const Int2  samplePos = bilinearInfo.basePos + bilinearInfo.offsets[sampleIndex];
+        const float weight    = bilinearInfo.weights[sampleIndex];
+        const bool  onscreen  = isOnScreen(samplePos, renderSize);
+        weightSum += onscreen ? 0.0f : weight;
+        if (onscreen && weight > reconstructedDepthBilinearWeightThreshold)
+        {
+            const float prevDepthSample           = prevDepthSamples[sampleIndex];
+            const float prevNearestDepthViewSpace = s.getViewSpaceDepth(prevDepthSample);
+            const float depthDiff                 = currentDepthViewSpace - prevNearestDepthViewSpace;
+
+            if (depthDiff > 0.0f)
+            {
+                const float planeDepth = s.reverseZ() ? std::min(prevDepthSample, currentDepthSample) : std::max(prevDepthSample, currentDepthSample);
+
+                const Int2   halfSize = toInt2(toFloat2(renderSize) * 0.5f);
+                const Float3 center   = s.getViewSpacePosition(halfSize, renderSize, planeDepth);
+                const Float3 corner   = s.getViewSpacePosition({0, 0}, renderSize, planeDepth);
+
+                const float halfViewportWidth = length(toFloat2(renderSize));
+                const float depthThreshold    = std::max(currentDepthViewSpace, prevNearestDepthViewSpace);
+
+                const float Ksep                    = 1.37e-05f;
+                const float Kfov                    = length(corner) / length(center);
+                const float requiredDepthSeparation = Ksep * Kfov * halfViewportWidth * depthThreshold;
+
+                const float resolutionFactor = saturate(length(toFloat2(renderSize)) / length(Float2{1920.0f, 1080.0f}));
+                const float power            = lerp(1.0f, 3.0f, resolutionFactor);
+                depth += std::pow(saturate(requiredDepthSeparation / depthDiff), power) * weight;
+                weightSum += weight;
+            }
+        }
+    }
+
+    return (weightSum > 0.0f) ? saturate(1.0f - depth / weightSum) : 0.0f;
+}
+
+// CalculateLumaDerivative()
+Float2 calculateLumaDerivative(const TextureView& lumaDerivTm1, Float2 reprojUv, Float3 jitteredColour, float disocclusionMask)
+{
+    const float DIS_THRESH      = 0.01f;
+    const float DERIV_MIN       = 0.05f;
+    const float DERIV_MAX       = 0.3f;
+    const float DERIV_ALPHA     = 0.1f;
+    const float DERIV_MAX_R     = 1.0f / DERIV_MAX;
+    const float DERIV_MAX_POW_R = 1.0f / std::pow(DERIV_MAX, 1.5f);
+
+    const Float4 h             = lumaDerivTm1.sample(reprojUv);
+    const float  lumaTm1       = h.y;
+    const float  derivativeTm1 = h.x;
+
+    const float lumaT       = luminance(jitteredColour);
+    const float derivativeT = std::fabs(lumaT - lumaTm1);
+
+    float clipped = std::min(derivativeT, DERIV_MAX);
+    clipped *= derivativeT >= DERIV_MIN ? 1.0f : 0.0f;
+
+    const float curved = clipped * std::sqrt(clipped) * DERIV_MAX_POW_R;
+
+    const float alphaScale = lerp(DERIV_ALPHA, DERIV_ALPHA * 0.1f, std::min(std::max(derivativeTm1, 0.0f), DERIV_MAX) * DERIV_MAX_R);
+
+    float derivative = lerp(derivativeTm1, curved, alphaScale);
+    derivative *= DIS_THRESH >= disocclusionMask ? 1.0f : 0.0f;
+
+    return {derivative, lumaT};
+}
+
+void runPreprocess(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView color        = s.texture(PREPROCESS_SRV_INPUT_COLOR_JITTERED);
+    const TextureView depthTexture = s.texture(PREPROCESS_SRV_INPUT_DEPTH);
+    const TextureView motion       = s.texture(PREPROCESS_SRV_INPUT_MOTION_VECTORS);
+    const TextureView history      = s.texture(PREPROCESS_SRV_HISTORY_UPSCALED_COLOR);
+    const TextureView depthTm1     = s.texture(PREPROCESS_SRV_INPUT_DEPTH_TM1);
+    const TextureView lumaTm1      = s.texture(PREPROCESS_SRV_LUMA_DERIV_TM1);
+    const TextureView nearestTm1   = s.texture(PREPROCESS_SRV_NEAREST_DEPTH_COORD_TM1);
+    const TensorView  tensorOut    = s.tensor(PREPROCESS_UAV_PREPROCESS_INPUT_TENSOR);
+    const TextureView lumaOut      = s.texture(PREPROCESS_UAV_LUMA_DERIV);
+    const TextureView nearestOut   = s.texture(PREPROCESS_UAV_NEAREST_DEPTH_COORD);
+
+    const TextureView coefficientUvTm1 = s.warpCoefficients() ? s.texture(PREPROCESS_SRV_COEFFICIENT_UV_TM1) : TextureView{};
+    const TextureView coefficientUvOut = s.warpCoefficients() ? s.texture(PREPROCESS_UAV_COEFFICIENT_UV) : TextureView{};
+
+    const Int2        renderSize = s.inputDims;
+    const QuantParams quant      = s.inputQuantParams();
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < renderSize.x; ++x)
+        {
+            const Int2   inputPixel = {x, y};
+            const Float2 uv         = Float2{float(x) + 0.5f, float(y) + 0.5f} * s.invInputDims;
+
+            // 1) Dilate depth, find nearest pixel coordinate
+            float depthDilated       = 0.0f;
+            Int2  nearestPixelOffset = {0, 0};
+            s.findNearestDepth(depthTexture, inputPixel, renderSize, depthDilated, nearestPixelOffset);
+
+            // 2) Load motion vectors, suppressing very small motion
+            Float2       motionVector = s.loadMotion(motion, inputPixel + nearestPixelOffset);
+            const Float2 motionPix    = motionVector * toFloat2(renderSize);
+            const float  motionLength = motionPix.x * motionPix.x + motionPix.y * motionPix.y;
+            motionVector              = motionVector * (motionLength > s.params._MotionDisThreshPad[0] ? 1.0f : 0.0f);
+
+            const Float2 reprojUv      = uv - motionVector;
+            const Float2 unjitterTm1Uv = reprojUv - Float2{s.cb._JitterOffsetTm1[2], s.cb._JitterOffsetTm1[3]};
+
+            // 3) Depth-based disocclusion mask, scaled on static frames
+            float disocclusionMask = computeDepthClip(s, depthTm1, nearestTm1, unjitterTm1Uv, depthDilated);
+            disocclusionMask *= motionLength > s.params._MotionDisThreshPad[1] ? 1.0f : s.params._MotionDisThreshPad[2];
+
+            // 4) Warp history
+            const Float3 warpedHistory = tonemap(safeColour(rgb(history.sample(reprojUv)) * s.exposure()));
+
+            // 5) Current jittered colour
+            const Float3 jitteredColour = tonemap(safeColour(rgb(color.fetch(s.paddedToInputPixel(inputPixel))) * s.exposure()));
+
+            // 6) Luma derivative
+            const Float2 lumaDerivative = calculateLumaDerivative(lumaTm1, reprojUv, jitteredColour, disocclusionMask);
+
+            // 7) Warp temporal feedback
+            const Float4 temporalFeedback = s.sampleOutputTensor(PREPROCESS_SRV_FEEDBACK_TM1_TENSOR, reprojUv, s.feedbackQuantParams()) * s.notHistoryReset();
+
+            // 9) Write outputs, the tensor is only consumed when the network runs
+            const float tensorElement[12] = {warpedHistory.x,
+                                             warpedHistory.y,
+                                             warpedHistory.z,
+                                             jitteredColour.x,
+                                             jitteredColour.y,
+                                             jitteredColour.z,
+                                             disocclusionMask,
+                                             temporalFeedback.x,
+                                             temporalFeedback.y,
+                                             temporalFeedback.z,
+                                             temporalFeedback.w,
+                                             lumaDerivative.x};
+            if (!s.reuseCoefficients())
+            {
+                for (int32_t channel = 0; channel < 12; ++channel)
+                    tensorOut.store(inputPixel, channel, s.quantized() ? quantize(tensorElement[channel], quant.data()) : tensorElement[channel]);
+            }
+
+            nearestOut.store(inputPixel, {float(encodeNearestDepthCoord(nearestPixelOffset)) / 255.0f, 0.0f, 0.0f, 1.0f});
+            lumaOut.store(inputPixel, {lumaDerivative.x, lumaDerivative.y, 0.0f, 1.0f});
+
+            // WarpCoefficientUv()
+            if (s.warpCoefficients())
+            {
+                const Float4 coefficientUv = s.reuseCoefficients() ? coefficientUvTm1.sample(reprojUv) : Float4{uv.x, uv.y, 0.0f, 0.0f};
+                coefficientUvOut.store(inputPixel, {coefficientUv.x, coefficientUv.y, 0.0f, 0.0f});
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Postprocess (ffx_nss_post_process.glsl)
+
+enum PostprocessSlot : uint32_t
+{
+    POSTPROCESS_SRV_INPUT_COLOR_JITTERED   = 0,
+    POSTPROCESS_SRV_INPUT_MOTION_VECTORS   = 1,
+    POSTPROCESS_SRV_HISTORY_UPSCALED_COLOR = 2,
+    POSTPROCESS_SRV_K0_TENSOR              = 3,
+    POSTPROCESS_SRV_K4_TENSOR              = 7,
+    POSTPROCESS_SRV_NEAREST_DEPTH_COORD    = 8,
+    POSTPROCESS_SRV_COEFFICIENT_UV         = 9,
+    POSTPROCESS_UAV_UPSCALED_OUTPUT        = 10,
+    POSTPROCESS_UAV_UNPADDED_OUTPUT        = 11,
+};
+
+// LoadHistoryCatmull()
+Float3 loadHistoryCatmull(const NssPassState& s, const TextureView& history, Float2 uv)
+{
+    const Float2 scaledUv  = uv * toFloat2(s.outputDims);
+    const Float2 baseFloor = Float2{std::floor(scaledUv.x - 0.5f), std::floor(scaledUv.y - 0.5f)} + Float2{0.5f, 0.5f};
+
+    const Float2 f  = scaledUv - baseFloor;
+    const Float2 f2 = f * f;
+    const Float2 f3 = f2 * f;
+
+    const Float2 w0  = f2 - (f3 + f) * 0.5f;
+    const Float2 w1  = f3 * 1.5f - f2 * 2.5f + Float2{1.0f, 1.0f};
+    const Float2 w3  = (f3 - f2) * 0.5f;
+    const Float2 w2  = Float2{1.0f, 1.0f} - w0 - w1 - w3;
+    const Float2 w12 = w1 + w2;
+
+    const float wUp     = w12.x * w0.y;
+    const float wDown   = w12.x * w3.y;
+    const float wLeft   = w0.x * w12.y;
+    const float wRight  = w3.x * w12.y;
+    const float wCenter = w12.x * w12.y;
+
+    const float dx = w2.x / w12.x;
+    const float dy = w2.y / w12.y;
+
+    const Float3 left   = rgb(history.sample((baseFloor + Float2{-1.0f, dy}) * s.invOutputDims));
+    const Float3 up     = rgb(history.sample((baseFloor + Float2{dx, -1.0f}) * s.invOutputDims));
+    const Float3 center = rgb(history.sample((baseFloor + Float2{dx, dy}) * s.invOutputDims));
+    const Float3 right  = rgb(history.sample((baseFloor + Float2{2.0f, dy}) * s.invOutputDims));
+    const Float3 down   = rgb(history.sample((baseFloor + Float2{dx, 2.0f}) * s.invOutputDims));
+
+    const Float3 accum     = up * wUp + left * wLeft + center * wCenter + right * wRight + down * wDown;
+    const float  weightSum = wUp + wLeft + wCenter + wRight + wDown;
+    Float3       colour    = accum * (1.0f / weightSum);
+
+    // dering in the case where we have negative values
+    if (colour.x < 0.0f || colour.y < 0.0f || colour.z < 0.0f)
+    {
+        const Float3 taps[5] = {up, left, center, right, down};
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            float minValue = (&taps[0].x)[channel];
+            float maxValue = minValue;
+            for (const Float3& tap : taps)
+            {
+                minValue = std::min(minValue, (&tap.x)[channel]);
+                maxValue = std::max(maxValue, (&tap.x)[channel]);
+            }
+            (&colour.x)[channel] = std::min(std::max((&colour.x)[channel], minValue), maxValue);
+        }
+    }
+    return colour;
+}
+
+// LoadAndFilterColour() of the 2x scale mode
+Float3 loadAndFilterColourX2(const NssPassState& s, const TextureView& color, Int2 outputPixel, Float2 uv, Float4& colToAccum)
+{
+    const Float2      outTex   = toFloat2(outputPixel) + Float2{0.5f, 0.5f};
+    const int32_t     lutIndex = s.kernelLutIndex(outputPixel);
+    const KernelTile& lut      = kernelLUT[lutIndex];
+
+    const Float4 kpnWeights = clampWeights(s.loadKpnWeight(POSTPROCESS_SRV_K0_TENSOR, uv, lutIndex));
+
+    Float4 interm[4];
+    for (uint32_t tap = 0; tap < 4; ++tap)
+    {
+        const Int2 tapPixel = {std::min(std::max(toInt(std::floor((outTex.x + float(lut.dx[tap])) * s.cb._ScaleFactor[2])), 0), s.inputDims.x - 1),
+                               std::min(std::max(toInt(std::floor((outTex.y + float(lut.dy[tap])) * s.cb._ScaleFactor[3])), 0), s.inputDims.y - 1)};
+        const Float3 tapColour = safeColour(rgb(color.fetch(s.paddedToInputPixel(tapPixel))) * s.exposure());
+        interm[tap]            = {tapColour.x, tapColour.y, tapColour.z, 1.0f};
+    }
+
+    // The center tap is accumulated when it lands on this output pixel
+    const float match = (lut.dx[0] == 0 && lut.dy[0] == 0) ? 1.0f : 0.0f;
+    colToAccum        = interm[0] * match;
+
+    const Float4 outColour = interm[0] * kpnWeights.x + interm[1] * kpnWeights.y + interm[2] * kpnWeights.z + interm[3] * kpnWeights.w;
+    return rgb(outColour) * (1.0f / outColour.w);
+}
+
+// LoadAndFilterColour() for arbitrary scale factors
+Float3 loadAndFilterColour(const NssPassState& s, const TextureView& color, Int2 outputPixel, Float2 uv, Float4& colToAccum)
+{
+    float  weightSum = 0.0f;
+    Float3 outColour = {0.0f, 0.0f, 0.0f};
+    colToAccum       = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    Float4 kpnWeights[4];
+    for (uint32_t kernel = 0; kernel < 4; ++kernel)
+        kpnWeights[kernel] = clampWeights(s.sampleOutputTensor(POSTPROCESS_SRV_K0_TENSOR + kernel, uv, s.kernelQuantParams(kernel)));
+
+    const Float2 invScale = {s.cb._ScaleFactor[2], s.cb._ScaleFactor[3]};
+    const Float2 jitter   = {s.cb._JitterOffset[0] + 0.5f, s.cb._JitterOffset[1] + 0.5f};
+
+    for (int32_t x = 0; x < 4; x++)
+    {
+        for (int32_t y = 0; y < 4; y++)
+        {
+            const float weight      = component(kpnWeights[x], y);
+            const Int2  tapLocation = outputPixel + Int2{x - 1, y - 1};
+
+            // Find the input pixel whose sample point lands on this output pixel, if there is one
+            Int2         inputPixel = {-1, -1};
+            const Float2 lower      = toFloat2(tapLocation) * invScale - jitter;
+            const Float2 upper      = toFloat2(tapLocation + Int2{1, 1}) * invScale - jitter;
+            const Int2   candidate  = floorInt2(upper);
+            if (lower.x < float(candidate.x) && lower.y < float(candidate.y))
+                inputPixel = candidate;
+
+            if (inputPixel.x >= 0 && inputPixel.y >= 0)
+            {
+                inputPixel            = {std::min(inputPixel.x, s.inputDims.x - 1), std::min(inputPixel.y, s.inputDims.y - 1)};
+                const Float3 tapColor = rgb(color.fetch(s.paddedToInputPixel(inputPixel)));
+
+                outColour = outColour + tapColor * weight;
+                weightSum += weight;
+
+                // Centre tap - there is a sample point exactly on this output pixel
+                if (x == 1 && y == 1)
+                    colToAccum = {tapColor.x, tapColor.y, tapColor.z, 1.0f};
+            }
+        }
+    }
+
+    outColour    = safeColour(outColour * (s.exposure() / (weightSum + EPS)));
+    colToAccum.x *= s.exposure();
+    colToAccum.y *= s.exposure();
+    colToAccum.z *= s.exposure();
+    return outColour;
+}
+
+void runPostprocess(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView color    = s.texture(POSTPROCESS_SRV_INPUT_COLOR_JITTERED);
+    const TextureView motion   = s.texture(POSTPROCESS_SRV_INPUT_MOTION_VECTORS);
+    const TextureView history  = s.texture(POSTPROCESS_SRV_HISTORY_UPSCALED_COLOR);
+    const TextureView nearest  = s.texture(POSTPROCESS_SRV_NEAREST_DEPTH_COORD);
+    const TextureView upscaled = s.texture(POSTPROCESS_UAV_UPSCALED_OUTPUT);
+    const TextureView unpadded = s.texture(POSTPROCESS_UAV_UNPADDED_OUTPUT);
+
+    const TextureView coefficientUvs = s.warpCoefficients() ? s.texture(POSTPROCESS_SRV_COEFFICIENT_UV) : TextureView{};
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < s.outputDims.x; ++x)
+        {
+            const Int2   outputPixel = {x, y};
+            const Float2 uv          = Float2{float(x) + 0.5f, float(y) + 0.5f} * s.invOutputDims;
+            const Int2   inputPixel  = toInt2(uv * toFloat2(s.inputDims));
+
+            // 1) Warp history, LoadWarpedHistory()
+            const Int2 nearestOffset = s.loadNearestDepthOffset(nearest, inputPixel);
+            Float2     motionVector  = s.loadMotion(motion, inputPixel + nearestOffset);
+            const Float2 motionPix   = motionVector * toFloat2(s.outputDims);
+            motionVector             = motionVector * ((motionPix.x * motionPix.x + motionPix.y * motionPix.y) > s.params._MotionDisThreshPad[0] ? 1.0f : 0.0f);
+
+            const Float2 reprojUv = uv - motionVector;
+            const float  onscreen = (reprojUv.x >= 0.0f && reprojUv.y >= 0.0f && reprojUv.x < 1.0f && reprojUv.y < 1.0f) ? 1.0f : 0.0f;
+            const Float3 historyColour = safeColour(loadHistoryCatmull(s, history, reprojUv) * s.exposure());
+
+            // 2) KPN filter, LoadCoefficientUv() picks the coefficients warped from the last network run
+            Float2 coefficientUv = uv;
+            if (s.warpCoefficients() && s.reuseCoefficients())
+            {
+                const Float4 warped = coefficientUvs.sample(uv);
+                coefficientUv       = {warped.x, warped.y};
+            }
+
+            Float4       colToAccum;
+            const Float3 colour = s.scaleModeX2() ? loadAndFilterColourX2(s, color, outputPixel, coefficientUv, colToAccum)
+                                                  : loadAndFilterColour(s, color, outputPixel, coefficientUv, colToAccum);
+
+            // 3) Temporal parameters, rectify history and accumulate the new sample
+            float theta, alpha;
+            s.loadTemporalParameters(POSTPROCESS_SRV_K4_TENSOR, coefficientUv, theta, alpha);
+
+            const Float3 rectified   = lerp(colour, historyColour, theta * onscreen);
+            const Float3 accumulated = lerp(tonemap(rectified), tonemap(rgb(colToAccum)), alpha * colToAccum.w);
+
+            // 4) Inverse tonemap + exposure and write output
+            s.writeUpsampledColour(upscaled, unpadded, outputPixel, inverseTonemap(accumulated) * s.invExposure());
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Debug view (ffx_nss_debug_view.glsl)
+
+enum DebugViewSlot : uint32_t
+{
+    DEBUG_VIEW_SRV_INPUT_MOTION_VECTORS    = 1,
+    DEBUG_VIEW_SRV_K0_TENSOR               = 3,
+    DEBUG_VIEW_SRV_K4_TENSOR               = 7,
+    DEBUG_VIEW_SRV_INPUT_DEPTH             = 9,
+    DEBUG_VIEW_UAV_UPSCALED_OUTPUT         = 10,
+    DEBUG_VIEW_UAV_PREPROCESS_INPUT_TENSOR = 11,
+    DEBUG_VIEW_UAV_DEBUG_VIEWS             = 13,
+};
+
+void runDebugView(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView motion       = s.texture(DEBUG_VIEW_SRV_INPUT_MOTION_VECTORS);
+    const TextureView depthTexture = s.texture(DEBUG_VIEW_SRV_INPUT_DEPTH);
+    const TextureView upscaled     = s.texture(DEBUG_VIEW_UAV_UPSCALED_OUTPUT);
+    const TensorView  preprocess   = s.tensor(DEBUG_VIEW_UAV_PREPROCESS_INPUT_TENSOR);
+    const TextureView debugViews   = s.texture(DEBUG_VIEW_UAV_DEBUG_VIEWS);
+
+    const int32_t gridSizeX    = 4;
+    const int32_t gridSizeY    = 3;
+    const Int2    viewportSize = {int32_t(uint32_t(float(debugViews.width) * (1.0f / gridSizeX))),
+                                  int32_t(uint32_t(float(debugViews.height) * (1.0f / gridSizeY)))};
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < s.inputDims.x; ++x)
+        {
+            const Int2   inputPos  = {x, y};
+            const Float2 uv        = {(float(x) + 0.5f) / float(s.inputDims.x), (float(y) + 0.5f) / float(s.inputDims.y)};
+            const Int2   outputPos = toInt2(uv * toFloat2(s.outputDims));
+
+            // Motion
+            float depthDilated       = 0.0f;
+            Int2  nearestPixelOffset = {0, 0};
+            s.findNearestDepth(depthTexture, inputPos, s.inputDims, depthDilated, nearestPixelOffset);
+            const Float2 motionVector = s.loadMotion(motion, inputPos + nearestPixelOffset);
+
+            // Preprocess tensor
+            float element[12];
+            for (int32_t channel = 0; channel < 12; ++channel)
+            {
+                element[channel] = preprocess.load(inputPos, channel);
+                if (s.quantized())
+                    element[channel] = dequantize(element[channel], s.inputDequantParams().data());
+            }
+
+            // Raw kernel weights
+            Float4 k[4];
+            for (uint32_t kernel = 0; kernel < 4; ++kernel)
+                k[kernel] = clampWeights(s.sampleOutputTensor(DEBUG_VIEW_SRV_K0_TENSOR + kernel, uv, s.kernelQuantParams(kernel)));
+
+            Float4 kpnWeights = {0.0f, 0.0f, 0.0f, 0.0f};
+            if (s.scaleModeX2())
+                kpnWeights = clampWeights(s.loadKpnWeight(DEBUG_VIEW_SRV_K0_TENSOR, uv, s.kernelLutIndex(outputPos)));
+
+            float theta, alpha;
+            s.loadTemporalParameters(DEBUG_VIEW_SRV_K4_TENSOR, uv, theta, alpha);
+
+            const Float4 views[gridSizeY][gridSizeX] = {
+                {{element[0], element[1], element[2], 1.0f},
+                 {element[3], element[4], element[5], element[6]},
+                 {element[7], element[8], element[9], element[10]},
+                 {element[6], element[11], 0.0f, 1.0f}},
+                {k[0], k[1], k[2], k[3]},
+                {{motionVector.x, motionVector.y, 0.0f, 1.0f}, kpnWeights, {theta, alpha, 0.0f, 1.0f}, upscaled.fetch(outputPos)},
+            };
+
+            // getPosInViewport()
+            const Float2 viewportUv = Float2{float(x) + 0.5f, float(y) + 0.5f} * s.invInputDims;
+            for (int32_t gridY = 0; gridY < gridSizeY; ++gridY)
+            {
+                for (int32_t gridX = 0; gridX < gridSizeX; ++gridX)
+                {
+                    const Float2 offset = {float(viewportSize.x * gridX), float(viewportSize.y * gridY)};
+                    debugViews.store(toInt2(offset + viewportUv * toFloat2(viewportSize)), views[gridY][gridX]);
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Bilinear upscale (ffx_nss_bilinear_upscale.glsl)
+
+enum BilinearUpscaleSlot : uint32_t
+{
+    BILINEAR_UPSCALE_SRV_INPUT_COLOR_JITTERED = 0,
+    BILINEAR_UPSCALE_UAV_UPSCALED_OUTPUT      = 1,
+    BILINEAR_UPSCALE_UAV_UNPADDED_OUTPUT      = 2,
+};
+
+void runBilinearUpscale(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView color    = s.texture(BILINEAR_UPSCALE_SRV_INPUT_COLOR_JITTERED);
+    const TextureView upscaled = s.texture(BILINEAR_UPSCALE_UAV_UPSCALED_OUTPUT);
+    const TextureView unpadded = s.texture(BILINEAR_UPSCALE_UAV_UNPADDED_OUTPUT);
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < s.outputDims.x; ++x)
+        {
+            // Undo the jitter so the image doesn't shake while the fallback is active.
+            const Float2 uv = Float2{float(x) + 0.5f, float(y) + 0.5f} * s.invOutputDims - Float2{s.cb._JitterOffset[2], s.cb._JitterOffset[3]};
+            s.writeUpsampledColour(upscaled, unpadded, {x, y}, rgb(color.sample(s.paddedToInputUv(uv))));
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Periphery upscale (ffx_nss_periphery_upscale.glsl)
+
+enum PeripheryUpscaleSlot : uint32_t
+{
+    PERIPHERY_UPSCALE_SRV_INPUT_COLOR_JITTERED   = 0,
+    PERIPHERY_UPSCALE_SRV_INPUT_MOTION_VECTORS   = 1,
+    PERIPHERY_UPSCALE_SRV_HISTORY_UPSCALED_COLOR = 2,
+    PERIPHERY_UPSCALE_UAV_UNPADDED_OUTPUT        = 3,
+};
+
+// NSS_PERIPHERY_HISTORY_WEIGHT
+const float PERIPHERY_HISTORY_WEIGHT = 0.9f;
+
+void runPeripheryUpscale(const NssPassState& s, uint32_t firstRow, uint32_t rowCount)
+{
+    const TextureView color    = s.texture(PERIPHERY_UPSCALE_SRV_INPUT_COLOR_JITTERED);
+    const TextureView motion   = s.texture(PERIPHERY_UPSCALE_SRV_INPUT_MOTION_VECTORS);
+    const TextureView history  = s.texture(PERIPHERY_UPSCALE_SRV_HISTORY_UPSCALED_COLOR);
+    const TextureView unpadded = s.texture(PERIPHERY_UPSCALE_UAV_UNPADDED_OUTPUT);
+    const FfxInt32x4& fovea    = s.cb._FoveaRect;
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < s.outputDims.x; ++x)
+        {
+            // The network writes the inside of the fovea
+            if (x >= fovea[0] && y >= fovea[1] && x < fovea[2] && y < fovea[3])
+                continue;
+
+            const Float2 uv         = Float2{float(x) + 0.5f, float(y) + 0.5f} * s.invOutputDims;
+            const Int2   inputPixel = toInt2(uv * toFloat2(s.inputDims));
+
+            // 1) Warp history
+            const Float2 reprojUv = uv - s.loadMotion(motion, inputPixel);
+            const float  onscreen = (reprojUv.x >= 0.0f && reprojUv.y >= 0.0f && reprojUv.x < 1.0f && reprojUv.y < 1.0f) ? 1.0f : 0.0f;
+            const Float3 warped   = tonemap(safeColour(loadHistoryCatmull(s, history, reprojUv) * s.exposure()));
+
+            // 2) Current sample, undoing the jitter, and its neighbourhood
+            const Float2 jitterUv = {s.cb._JitterOffset[2], s.cb._JitterOffset[3]};
+            const Float3 colour   = tonemap(safeColour(rgb(color.sample(s.paddedToInputUv(uv - jitterUv))) * s.exposure()));
+            Float3       nMin     = colour;
+            Float3       nMax     = colour;
+            for (int32_t tapY = -1; tapY <= 1; ++tapY)
+            {
+                for (int32_t tapX = -1; tapX <= 1; ++tapX)
+                {
+                    const Int2   tapPixel = {std::min(std::max(inputPixel.x + tapX, 0), s.inputDims.x - 1),
+                                             std::min(std::max(inputPixel.y + tapY, 0), s.inputDims.y - 1)};
+                    const Float3 tap      = tonemap(safeColour(rgb(color.fetch(s.paddedToInputPixel(tapPixel))) * s.exposure()));
+                    nMin                  = {std::min(nMin.x, tap.x), std::min(nMin.y, tap.y), std::min(nMin.z, tap.z)};
+                    nMax                  = {std::max(nMax.x, tap.x), std::max(nMax.y, tap.y), std::max(nMax.z, tap.z)};
+                }
+            }
+
+            // 3) Rectify history and accumulate, history offscreen is discarded
+            const Float3 rectified   = {std::min(std::max(warped.x, nMin.x), nMax.x),
+                                        std::min(std::max(warped.y, nMin.y), nMax.y),
+                                        std::min(std::max(warped.z, nMin.z), nMax.z)};
+            const Float3 accumulated = lerp(colour, rectified, PERIPHERY_HISTORY_WEIGHT * onscreen * s.notHistoryReset());
+
+            // 4) Inverse tonemap + exposure and write output
+            const Float3 toWrite = safeColour(inverseTonemap(accumulated) * s.invExposure());
+            unpadded.store({x, y}, {toWrite.x, toWrite.y, toWrite.z, 1.0f});
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Network layer (ffx_nss_network.glsl)
+
+enum NetworkSlot : uint32_t
+{
+    NETWORK_SRV_INPUT_0    = 0,
+    NETWORK_SRV_INPUT_1    = 1,
+    NETWORK_SRV_PARAMETERS = 2,
+    NETWORK_UAV_OUTPUT     = 3,
+};
+
+// dotPacked4x8EXT() of signed bytes
+inline int32_t dotPacked4x8(uint32_t a, uint32_t b)
+{
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < 32; i += 8)
+        sum += int32_t(int8_t(a >> i)) * int32_t(int8_t(b >> i));
+    return sum;
+}
+
+// Dot product of signed bytes with 2:4 sparse weights {weight 0, weight 1, index 0 | index 1 << 2, 0}, the other 2 weights being zero
+inline int32_t dotSparse2x4(uint32_t a, uint32_t sparseWeights)
+{
+    const uint32_t indices = sparseWeights >> 16;
+    return int32_t(int8_t(a >> ((indices & 3) * 8))) * int32_t(int8_t(sparseWeights)) +
+           int32_t(int8_t(a >> (((indices >> 2) & 3) * 8))) * int32_t(int8_t(sparseWeights >> 8));
+}
+
+// TOSA apply_scale_32: (value * multiplier + round) >> shift with a 64bit intermediate, shift in [2, 62].
+inline int32_t applyScale32(int32_t value, int32_t multiplier, int32_t shift, bool doubleRound)
+{
+    int64_t round = int64_t(1) << (shift - 1);
+    if (doubleRound && shift > 31)
+        round += value >= 0 ? (int64_t(1) << 30) : -(int64_t(1) << 30);
+    return int32_t((int64_t(value) * int64_t(multiplier) + round) >> shift);
+}
+
+// Packs 4 channels of a tensor into a word, channel in the lowest byte
+inline uint32_t loadPacked(const TensorView& t, Int2 pixel, int32_t channel)
+{
+    if (!isOnScreen(pixel, {t.width, t.height}) || channel + 4 > t.channels)
+        return 0;
+    uint32_t packed;
+    memcpy(&packed, t.element(pixel, channel), sizeof(packed));
+    return packed;
+}
+
+void runNetworkLayer(const CpuPassBindings& bindings, uint32_t firstRow, uint32_t rowCount)
+{
+    const NssNetworkLayerConstants& layer        = *reinterpret_cast<const NssNetworkLayerConstants*>(bindings.constants);
+    const FfxInt32x4&               outputShape  = layer._OutputShape;
+    const FfxInt32x4&               convolution  = layer._Convolution;
+    const FfxInt32x4&               kernel       = layer._Kernel;
+    const FfxInt32x4&               source0      = layer._Source0;
+    const FfxInt32x4&               source1      = layer._Source1;
+    const FfxInt32x4&               offsets      = layer._Parameters;
+    const FfxInt32x4&               quantization = layer._Quantization;
+
+    // The tensors of the layer are buffers, shaped by the layer constants
+    const TensorView  input0     = getBufferTensor(bindings.slots[NETWORK_SRV_INPUT_0], source0[0], source0[1]);
+    const TensorView  input1     = getBufferTensor(bindings.slots[NETWORK_SRV_INPUT_1], source1[0], source1[1]);
+    const TensorView  output     = getBufferTensor(bindings.slots[NETWORK_UAV_OUTPUT], outputShape[0], outputShape[1]);
+    const CpuBinding& parameters = bindings.slots[NETWORK_SRV_PARAMETERS];
+
+    const int32_t* param     = reinterpret_cast<const int32_t*>(parameters.data);
+    const auto     loadParam = [param](int32_t index) { return param[index]; };
+    const Int2     inputDims = {source0[0] * source0[3], source0[1] * source0[3]};
+
+    // Weights are [output channel][kernel y][kernel x][input channel], with 4 input channels per word
+    const int32_t inputWords  = outputShape[3] / 4;
+    const int32_t kernelWords = kernel[0] * kernel[1] * inputWords;
+
+    // LoadLayerInput(): the concatenation of up to two sources, each optionally upsampled
+    const auto loadLayerInput = [&](Int2 pixel, int32_t channel) {
+        if (channel < source0[2])
+            return loadPacked(input0, {pixel.x / source0[3], pixel.y / source0[3]}, channel);
+        return loadPacked(input1, {pixel.x / source1[3], pixel.y / source1[3]}, channel - source0[2]);
+    };
+
+    for (int32_t y = int32_t(firstRow); y < int32_t(firstRow + rowCount); ++y)
+    {
+        for (int32_t x = 0; x < outputShape[0]; ++x)
+        {
+            for (int32_t outputChannel = 0; outputChannel < outputShape[2]; outputChannel += 4)
+            {
+                // The sparse weights have the same layout as the dense ones, one word per 4 input channels
+                const bool sparse      = offsets[3] >= 0;
+                int32_t    weightIndex = (sparse ? offsets[3] : offsets[0]) + outputChannel * kernelWords;
+
+                // Channel parameters are {bias, multiplier, shift, unused} per output channel
+                const int32_t channelIndex = offsets[1] + outputChannel * 4;
+                int32_t       acc[4]       = {loadParam(channelIndex), loadParam(channelIndex + 4), loadParam(channelIndex + 8), loadParam(channelIndex + 12)};
+
+                for (int32_t ky = 0; ky < kernel[1]; ++ky)
+                {
+                    for (int32_t kx = 0; kx < kernel[0]; ++kx)
+                    {
+                        const Int2 inputPixel = {x * convolution[0] - convolution[2] + kx * kernel[2], y * convolution[1] - convolution[3] + ky * kernel[3]};
+                        const bool inside     = isOnScreen(inputPixel, inputDims);
+                        for (int32_t word = 0; word < inputWords; ++word, ++weightIndex)
+                        {
+                            const uint32_t value = inside ? loadLayerInput(inputPixel, word * 4) : uint32_t(quantization[0]);
+                            if (sparse)
+                            {
+                                for (int32_t i = 0; i < 4; ++i)
+                                    acc[i] += dotSparse2x4(value, uint32_t(loadParam(weightIndex + kernelWords * i)));
+                            }
+                            else
+                            {
+                                for (int32_t i = 0; i < 4; ++i)
+                                    acc[i] += dotPacked4x8(value, uint32_t(loadParam(weightIndex + kernelWords * i)));
+                            }
+                        }
+                    }
+                }
+
+                for (int32_t i = 0; i < 4; ++i)
+                {
+                    const int32_t multiplier = loadParam(channelIndex + i * 4 + 1);
+                    const int32_t shift      = loadParam(channelIndex + i * 4 + 2);
+                    int32_t value = std::min(std::max(applyScale32(acc[i], multiplier, shift, quantization[2] != 0) + quantization[1], -128), 127);
+                    if (offsets[2] >= 0)
+                    {
+                        // TOSA table for int8 values, 256 entries packed 4 per word
+                        const int32_t index = value + 128;
+                        value               = int32_t(int8_t(uint32_t(loadParam(offsets[2] + (index >> 2))) >> ((index & 3) * 8)));
+                    }
+                    output.store({x, y}, outputChannel + i, float(value));
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+uint32_t cpuGetSurfaceFormatSize(FfxSurfaceFormat format)
+{
+    switch (format)
+    {
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_UINT:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R32G32B32_FLOAT:
+        return 12;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R32G32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SRGB:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_UNORM:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_SRGB:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R10G10B10A2_TYPELESS:
+    case FFX_SURFACE_FORMAT_R10G10B10A2_UNORM:
+    case FFX_SURFACE_FORMAT_R9G9B9E5_SHAREDEXP:
+    case FFX_SURFACE_FORMAT_R16G16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+    case FFX_SURFACE_FORMAT_R16G16_SINT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_TYPELESS:
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+    case FFX_SURFACE_FORMAT_R8G8_UINT:
+        return 2;
+    case FFX_SURFACE_FORMAT_R8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+    case FFX_SURFACE_FORMAT_R8_SNORM:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+    case FFX_SURFACE_FORMAT_R8_SINT:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+void cpuLoadTexel(FfxSurfaceFormat format, const uint8_t* texel, float color[4])
+{
+    const Float4 value = loadTexel(format, texel);
+    color[0]           = value.x;
+    color[1]           = value.y;
+    color[2]           = value.z;
+    color[3]           = value.w;
+}
+
+void cpuStoreTexel(FfxSurfaceFormat format, uint8_t* texel, const float color[4])
+{
+    storeTexel(format, texel, {color[0], color[1], color[2], color[3]});
+}
+
+uint32_t cpuGetNssPassRowCount(FfxPass pass, const CpuPassBindings& bindings)
+{
+    if (pass == FFX_NSS_PASS_NETWORK)
+        return uint32_t(std::max(reinterpret_cast<const NssNetworkLayerConstants*>(bindings.constants)->_OutputShape[1], 0));
+
+    const NssConstants& cb = *reinterpret_cast<const NssConstants*>(bindings.constants);
+    switch (pass)
+    {
+    case FFX_NSS_PASS_MIRROR_PADDING:
+    case FFX_NSS_PASS_PREPROCESS:
+    case FFX_NSS_PASS_DEBUG_VIEW:
+        return cb._InputDims[1];
+    case FFX_NSS_PASS_POSTPROCESS:
+    case FFX_NSS_PASS_BILINEAR_UPSCALE:
+    case FFX_NSS_PASS_PERIPHERY_UPSCALE:
+        return cb._OutputDims[1];
+    default:
+        return 0;
+    }
+}
+
+void cpuRunNssPassRows(FfxPass pass, const CpuPassBindings& bindings, uint32_t firstRow, uint32_t rowCount)
+{
+    if (pass == FFX_NSS_PASS_NETWORK)
+    {
+        runNetworkLayer(bindings, firstRow, rowCount);
+        return;
+    }
+
+    const NssPassState state(bindings);
+    switch (pass)
+    {
+    case FFX_NSS_PASS_MIRROR_PADDING:
+        runMirrorPadding(state, firstRow, rowCount);
+        break;
+    case FFX_NSS_PASS_PREPROCESS:
+        runPreprocess(state, firstRow, rowCount);
+        break;
+    case FFX_NSS_PASS_POSTPROCESS:
+        runPostprocess(state, firstRow, rowCount);
+        break;
+    case FFX_NSS_PASS_DEBUG_VIEW:
+        runDebugView(state, firstRow, rowCount);
+        break;
+    case FFX_NSS_PASS_BILINEAR_UPSCALE:
+        runBilinearUpscale(state, firstRow, rowCount);
+        break;
+    case FFX_NSS_PASS_PERIPHERY_UPSCALE:
+        runPeripheryUpscale(state, firstRow, rowCount);
+        break;
+    default:
+        FFX_ASSERT_MESSAGE(false, "FFXInterface: CPU: Pass has no CPU implementation.");
+        break;
+    }
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <FidelityFX/host/ffx_interface.h>
+
+/// The number of binding slots a pass run on the CPU can address, the NSS shaders bind up to slot 13.
+#define FFX_CPU_MAX_BINDING_SLOTS 16
+
+/// The number of specialization constants a pipeline run on the CPU keeps, the NSS shaders declare 14.
+#define FFX_CPU_MAX_SPECIALIZATION_CONSTANTS 16
+
+/// A resource bound to one slot of a pass run on the CPU.
+typedef struct CpuBinding
+{
+    uint8_t*               data;         ///< The tightly packed contents of the resource, <c><i>nullptr</i></c> when the slot is unbound.
+    FfxResourceDescription description;  ///< The description the resource was created or registered with.
+} CpuBinding;
+
+/// The resources and constants of a pass run on the CPU, indexed like the bindings of its shader.
+typedef struct CpuPassBindings
+{
+    CpuBinding      slots[FFX_CPU_MAX_BINDING_SLOTS];
+    const uint32_t* constants;                    ///< The 32-bit constant buffer of the pass, or the constants pushed to it.
+    uint32_t        permutationOptions;           ///< The permutation options the pipeline of the pass was created with.
+    const uint32_t* specializationConstants;      ///< The specialization constants the pipeline of the pass was created with.
+    uint32_t        specializationConstantCount;  ///< Number of values in <c><i>specializationConstants</i></c>.
+} CpuPassBindings;
+
+/// Returns the number of rows a pass of NSS writes, each of which can be run on a different thread.
+///
+/// @param [in] pass                The NSS pass to run.
+/// @param [in] bindings            The resources and constants of the dispatch.
+///
+/// @returns
+/// The number of rows, 0 if the pass has no CPU implementation.
+uint32_t cpuGetNssPassRowCount(FfxPass pass, const CpuPassBindings& bindings);
+
+/// Runs a range of the rows of a pass of NSS, mirroring the compute shader of the pass.
+///
+/// @param [in] pass                The NSS pass to run.
+/// @param [in] bindings            The resources and constants of the dispatch.
+/// @param [in] firstRow            The first row to run.
+/// @param [in] rowCount            The number of rows to run.
+void cpuRunNssPassRows(FfxPass pass, const CpuPassBindings& bindings, uint32_t firstRow, uint32_t rowCount);
+
+/// Returns the size in bytes of one element of <c><i>format</i></c>, or 0 if the CPU backend can't access it.
+uint32_t cpuGetSurfaceFormatSize(FfxSurfaceFormat format);
+
+/// Reads the texel at <c><i>texel</i></c>, of <c><i>format</i></c>, converted to a color.
+void cpuLoadTexel(FfxSurfaceFormat format, const uint8_t* texel, float color[4]);
+
+/// Converts a color to <c><i>format</i></c> and writes it to <c><i>texel</i></c>.
+void cpuStoreTexel(FfxSurfaceFormat format, uint8_t* texel, const float color[4]);
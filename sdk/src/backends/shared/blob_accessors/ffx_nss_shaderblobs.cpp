@@ -27,6 +27,14 @@
 
 #include <nss_v0_1_1_int8.h>
 
+// The fp16 model is generated by the model parser like the int8 one, when its VGF is in data_graphs/nss.
+#if defined(__has_include)
+#if __has_include(<nss_v0_1_1_fp16.h>)
+#include <nss_v0_1_1_fp16.h>
+#define NSS_FP16_DATA_GRAPH_AVAILABLE 1
+#endif
+#endif
+
 #include <ffx_nss_mirror_padding_16bit_permutations.h>
 #include <ffx_nss_mirror_padding_permutations.h>
 
@@ -39,22 +47,39 @@
 #include <ffx_nss_debug_view_16bit_permutations.h>
 #include <ffx_nss_debug_view_permutations.h>
 
+#include <ffx_nss_bilinear_upscale_16bit_permutations.h>
+#include <ffx_nss_bilinear_upscale_permutations.h>
+
+#include <ffx_nss_network_16bit_permutations.h>
+#include <ffx_nss_network_permutations.h>
+
+#include <ffx_nss_periphery_upscale_16bit_permutations.h>
+#include <ffx_nss_periphery_upscale_permutations.h>
+
 #include <string.h>  // for memset
 
 #if defined(POPULATE_PERMUTATION_KEY)
 #undef POPULATE_PERMUTATION_KEY
 #endif  // #if defined(POPULATE_PERMUTATION_KEY)
-#define POPULATE_PERMUTATION_KEY(options, key)                                                                \
-    key.index                          = 0;                                                                   \
-    key.REVERSE_Z                      = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_REVERSE_Z);        \
-    key.RESAMPLE_BICUBIC               = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_RESAMPLE_BICUBIC); \
+#define POPULATE_PERMUTATION_KEY(options, key)                                                                              \
+    key.index                          = 0;                                                                                 \
+    key.QUANTIZED                      = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_QUANTIZED);                      \
+    key.REVERSE_Z                      = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_REVERSE_Z);                      \
+    key.RESAMPLE_BICUBIC               = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_RESAMPLE_BICUBIC);               \
     key.ALIAS_OUTPUT_TENSORS_AS_IMAGES = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_ALIAS_OUTPUT_TENSORS_AS_IMAGES);
 
+// The permutations only some passes are compiled for, see CMakeCompileNSSShaders.txt
+#define POPULATE_PUSH_CONSTANTS_KEY(options, key) key.PUSH_CONSTANTS = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_PUSH_CONSTANTS);
+#define POPULATE_FUSED_PADDING_KEY(options, key) key.FUSED_PADDING = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_FUSED_PADDING);
+#define POPULATE_WARP_COEFFICIENTS_KEY(options, key) key.WARP_COEFFICIENTS = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_WARP_COEFFICIENTS);
+#define POPULATE_TENSORS_AS_BUFFERS_KEY(options, key) key.TENSORS_AS_BUFFERS = FFX_CONTAINS_FLAG(options, NSS_SHADER_PERMUTATION_TENSORS_AS_BUFFERS);
+
 static FfxShaderBlob nssGetMirrorPaddingPassPermutationBlobByIndex(uint32_t permutationOptions, bool is16bit)
 {
     ffx_nss_mirror_padding_PermutationKey key;
 
     POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
 
     if (is16bit)
     {
@@ -73,6 +98,10 @@ static FfxShaderBlob nssGetPreprocessPassPermutationBlobByIndex(uint32_t permuta
     ffx_nss_pre_process_PermutationKey key;
 
     POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
+    POPULATE_FUSED_PADDING_KEY(permutationOptions, key);
+    POPULATE_WARP_COEFFICIENTS_KEY(permutationOptions, key);
+    POPULATE_TENSORS_AS_BUFFERS_KEY(permutationOptions, key);
 
     if (is16bit)
     {
@@ -91,6 +120,10 @@ static FfxShaderBlob nssGetPostprocessPassPermutationBlobByIndex(uint32_t permut
     ffx_nss_post_process_PermutationKey key;
 
     POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
+    POPULATE_FUSED_PADDING_KEY(permutationOptions, key);
+    POPULATE_WARP_COEFFICIENTS_KEY(permutationOptions, key);
+    POPULATE_TENSORS_AS_BUFFERS_KEY(permutationOptions, key);
 
     // Match with difinitions in ffx_nss_private.h
     // #define SCALE_1_3X 1
@@ -130,6 +163,9 @@ static FfxShaderBlob nssGetDebugViewPassPermutationBlobByIndex(uint32_t permutat
     ffx_nss_debug_view_PermutationKey key;
 
     POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
+    POPULATE_FUSED_PADDING_KEY(permutationOptions, key);
+    POPULATE_TENSORS_AS_BUFFERS_KEY(permutationOptions, key);
 
     // Match with difinitions in ffx_nss_private.h
     // #define SCALE_1_3X 1
@@ -164,6 +200,64 @@ static FfxShaderBlob nssGetDebugViewPassPermutationBlobByIndex(uint32_t permutat
     }
 }
 
+static FfxShaderBlob nssGetBilinearUpscalePassPermutationBlobByIndex(uint32_t permutationOptions, bool is16bit)
+{
+    ffx_nss_bilinear_upscale_PermutationKey key;
+
+    POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
+    POPULATE_FUSED_PADDING_KEY(permutationOptions, key);
+
+    if (is16bit)
+    {
+        const int32_t tableIndex = g_ffx_nss_bilinear_upscale_16bit_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_bilinear_upscale_16bit_PermutationInfo, tableIndex);
+    }
+    else
+    {
+        const int32_t tableIndex = g_ffx_nss_bilinear_upscale_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_bilinear_upscale_PermutationInfo, tableIndex);
+    }
+}
+
+static FfxShaderBlob nssGetNetworkPassPermutationBlobByIndex(uint32_t permutationOptions, bool is16bit)
+{
+    ffx_nss_network_PermutationKey key;
+
+    POPULATE_PERMUTATION_KEY(permutationOptions, key);
+
+    if (is16bit)
+    {
+        const int32_t tableIndex = g_ffx_nss_network_16bit_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_network_16bit_PermutationInfo, tableIndex);
+    }
+    else
+    {
+        const int32_t tableIndex = g_ffx_nss_network_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_network_PermutationInfo, tableIndex);
+    }
+}
+
+static FfxShaderBlob nssGetPeripheryUpscalePassPermutationBlobByIndex(uint32_t permutationOptions, bool is16bit)
+{
+    ffx_nss_periphery_upscale_PermutationKey key;
+
+    POPULATE_PERMUTATION_KEY(permutationOptions, key);
+    POPULATE_PUSH_CONSTANTS_KEY(permutationOptions, key);
+    POPULATE_FUSED_PADDING_KEY(permutationOptions, key);
+
+    if (is16bit)
+    {
+        const int32_t tableIndex = g_ffx_nss_periphery_upscale_16bit_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_periphery_upscale_16bit_PermutationInfo, tableIndex);
+    }
+    else
+    {
+        const int32_t tableIndex = g_ffx_nss_periphery_upscale_IndirectionTable[key.index];
+        return POPULATE_SHADER_BLOB_FFX_TENSOR(g_ffx_nss_periphery_upscale_PermutationInfo, tableIndex);
+    }
+}
+
 FfxErrorCode nssGetPermutationBlobByIndex(FfxNssPass passId, uint32_t permutationOptions, FfxShaderBlob* outShaderBlob, FfxDataGraphBlob* outDataGraphBlob)
 {
     const bool is16bit = FFX_CONTAINS_FLAG(permutationOptions, NSS_SHADER_PERMUTATION_ALLOW_16BIT);
@@ -186,8 +280,17 @@ FfxErrorCode nssGetPermutationBlobByIndex(FfxNssPass passId, uint32_t permutatio
 
     case FFX_NSS_PASS_DATA_GRAPH:
     {
-        memcpy(outDataGraphBlob, &g_nss_v0_1_1_int8_Info, sizeof(FfxDataGraphBlob));
+        if (FFX_CONTAINS_FLAG(permutationOptions, NSS_SHADER_PERMUTATION_QUANTIZED))
+        {
+            memcpy(outDataGraphBlob, &g_nss_v0_1_1_int8_Info, sizeof(FfxDataGraphBlob));
+            return FFX_OK;
+        }
+#if defined(NSS_FP16_DATA_GRAPH_AVAILABLE)
+        memcpy(outDataGraphBlob, &g_nss_v0_1_1_fp16_Info, sizeof(FfxDataGraphBlob));
         return FFX_OK;
+#else
+        return FFX_ERROR_INVALID_ARGUMENT;
+#endif
     }
 
     case FFX_NSS_PASS_POSTPROCESS:
@@ -204,6 +307,27 @@ FfxErrorCode nssGetPermutationBlobByIndex(FfxNssPass passId, uint32_t permutatio
         return FFX_OK;
     }
 
+    case FFX_NSS_PASS_BILINEAR_UPSCALE:
+    {
+        FfxShaderBlob blob = nssGetBilinearUpscalePassPermutationBlobByIndex(permutationOptions, is16bit);
+        memcpy(outShaderBlob, &blob, sizeof(FfxShaderBlob));
+        return FFX_OK;
+    }
+
+    case FFX_NSS_PASS_NETWORK:
+    {
+        FfxShaderBlob blob = nssGetNetworkPassPermutationBlobByIndex(permutationOptions, is16bit);
+        memcpy(outShaderBlob, &blob, sizeof(FfxShaderBlob));
+        return FFX_OK;
+    }
+
+    case FFX_NSS_PASS_PERIPHERY_UPSCALE:
+    {
+        FfxShaderBlob blob = nssGetPeripheryUpscalePassPermutationBlobByIndex(permutationOptions, is16bit);
+        memcpy(outShaderBlob, &blob, sizeof(FfxShaderBlob));
+        return FFX_OK;
+    }
+
     default:
         FFX_ASSERT_FAIL("Should never reach here.");
         break;
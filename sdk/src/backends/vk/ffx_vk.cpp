@@ -106,22 +106,56 @@ namespace
         return instr.words[instr.operands[operandIdx].offset];
     }
 
-    DescriptorSetBindingToShapeMap GetInputShapes(const FfxDataGraphBlob& dataGraphBlob, const uint32_t width, const uint32_t height)
+    DescriptorSetBindingToShapeMap GetInputShapes(const FfxDataGraphBlob& dataGraphBlob, const uint32_t batchSize, const uint32_t width, const uint32_t height)
     {
         DescriptorSetBindingToShapeMap inputShapes{};
         for (FfxUInt32 i = 0; i < dataGraphBlob.tensorNums; ++i)
         {
             // For now we only support tensor shape with rank 4
-            // The shape[0] is hardcoded to 1, shape[1..2] are decided by render size
+            // The shape[0] is the number of views batched together, shape[1..2] are decided by render size
             // and the shape[3] is queried from the data graph blob
             FFX_ASSERT(4 == dataGraphBlob.tensorDimSize[i]);
-            auto currentTensorDimension = std::vector<int64_t>{1, height, width, static_cast<int64_t>(dataGraphBlob.tensorDims[i][3])};
+            auto currentTensorDimension = std::vector<int64_t>{batchSize, height, width, static_cast<int64_t>(dataGraphBlob.tensorDims[i][3])};
             auto binding                = std::make_pair(0u, dataGraphBlob.tensorBindings[i]);  // [set, binding]
             inputShapes.emplace(binding, std::move(currentTensorDimension));
         }
         return inputShapes;
     }
 
+    // The model parser specializes the graph for the resolutions it's listed with. Those modules are already shaped,
+    // so a graph created at one of them uses its module and tensor shapes without running shape inference.
+    // A module specialized from other graph data than the blob's, such as a stale table, is ignored.
+    bool GetPrecomputedShapes(const FfxDataGraphBlob& dataGraphBlob,
+                              const uint32_t          batchSize,
+                              const uint32_t          width,
+                              const uint32_t          height,
+                              ShapeInferenceResults&  outResults)
+    {
+        if (dataGraphBlob.graphShapeNums == 0)
+            return false;
+
+        const uint64_t graphHash = arm::computeHash(dataGraphBlob.graphData, dataGraphBlob.graphDataSize);
+        for (FfxUInt32 shapeIndex = 0; shapeIndex < dataGraphBlob.graphShapeNums; ++shapeIndex)
+        {
+            const FfxDataGraphShape& graphShape = dataGraphBlob.graphShapes[shapeIndex];
+            if (graphShape.width != width || graphShape.height != height || graphShape.batchSize != batchSize || graphShape.graphHash != graphHash)
+                continue;
+
+            for (FfxUInt32 i = 0; i < dataGraphBlob.tensorNums; ++i)
+            {
+                auto binding = std::make_pair(0u, dataGraphBlob.tensorBindings[i]);  // [set, binding]
+                outResults.OutputShapes.emplace(binding,
+                                                std::vector<int64_t>(graphShape.tensorShapes[i], graphShape.tensorShapes[i] + dataGraphBlob.tensorDimSize[i]));
+            }
+
+            const uint32_t* code = reinterpret_cast<const uint32_t*>(graphShape.code);
+            outResults.NewCode.assign(code, code + graphShape.codeSize / sizeof(uint32_t));
+            outResults.Success = true;
+            return true;
+        }
+        return false;
+    }
+
     ShapeInferenceResults RunShapeInference(const uint32_t* code, const uint32_t codeSize, const DescriptorSetBindingToShapeMap& inputShapes)
     {
         UniqueSpirvPtr<spv_optimizer_t, spvOptimizerDestroy> optimizer(spvOptimizerCreate(SPV_ENV_VULKAN_1_3));
@@ -269,7 +303,14 @@ FfxErrorCode     RegisterResourceVK(FfxInterface*        backendInterface,
                                     FfxResourceInternal* outResourceInternal);
 FfxResource      GetResourceVK(FfxInterface* backendInterface, FfxResourceInternal resource);
 FfxErrorCode     UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+FfxErrorCode     SetResourceFinalStateVK(FfxInterface* backendInterface, FfxResourceInternal resource, FfxResourceStates finalState, FfxUInt32 effectContextId);
+FfxErrorCode     RegisterPersistentResourceVK(FfxInterface*        backendInterface,
+                                              const FfxResource*   inResource,
+                                              FfxUInt32            effectContextId,
+                                              FfxResourceInternal* inOutResourceInternal);
 FfxErrorCode     RegisterStaticResourceVK(FfxInterface* backendInterface, const FfxStaticResourceDescription* desc, FfxUInt32 effectContextId);
+FfxErrorCode     GetPipelineCacheDataVK(FfxInterface* backendInterface, void* outData, size_t* inOutDataSize);
+FfxErrorCode     MergePipelineCacheDataVK(FfxInterface* backendInterface, const void* data, size_t dataSize);
 FfxResourceDescription GetResourceDescriptionVK(FfxInterface* backendInterface, FfxResourceInternal resource);
 FfxErrorCode           StageConstantBufferDataVK(FfxInterface* backendInterface, void* data, FfxUInt32 size, FfxConstantBuffer* constantBuffer);
 FfxErrorCode           CreatePipelineVK(FfxInterface*                 backendInterface,
@@ -296,12 +337,18 @@ FfxErrorCode           CreateDataGraphPipelineVK(FfxInterface*                 b
                                                  FfxUInt32                     render_height,
                                                  FfxPipelineState*             outPass);
 FfxErrorCode           DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId);
-FfxErrorCode           ScheduleGpuJobVK(FfxInterface* backendInterface, const FfxGpuJobDescription* job);
+FfxErrorCode           ScheduleGpuJobVK(FfxInterface* backendInterface, const FfxGpuJobDescription* job, FfxUInt32 effectContextId);
 FfxErrorCode           ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+FfxErrorCode           ExecuteRecordedGpuJobsVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+FfxErrorCode           ExecuteGpuJobsAsyncVK(FfxInterface*                     backendInterface,
+                                             FfxCommandList                    commandList,
+                                             const FfxAsyncComputeDescription* asyncCompute,
+                                             FfxUInt32                         effectContextId);
 
 static VkDeviceContext sVkDeviceContext = {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE};
 
 #define MAX_PIPELINE_USAGE_PER_FRAME (10)  // Required to make sure passes that are called more than once per-frame don't have their descriptors overwritten.
+#define MAX_PIPELINE_USAGE_PER_FRAME_LIMIT (32)  // The most FfxPipelineDescription::dispatchesPerFrame can ask for.
 
 #define MAX_DESCRIPTOR_SET_LAYOUTS  (32)
 #define MAX_DESCRIPTOR_SETS         (2)
@@ -366,6 +413,7 @@ typedef struct BackendContext_VK
         FfxResourceDescription resourceDescription;
         FfxResourceStates      initialState;
         FfxResourceStates      currentState;
+        FfxResourceStates      finalState;  // The state a registered resource is left in once unregistered, see SetResourceFinalStateVK()
         int32_t                srvViewIndex;
         int32_t                uavViewIndex;
         uint32_t               uavViewCount;
@@ -377,6 +425,12 @@ typedef struct BackendContext_VK
 
         bool undefined;
         bool dynamic;
+        bool persistent;  // Registered by RegisterPersistentResourceVK(), the resource belongs to the application and the slot to the static range
+
+        uint64_t registrationKey;  // Identifies what was last registered into a dynamic or persistent slot, see RegisterResourceVK()
+
+        int32_t  persistentViewIndex;  // The views a persistent slot holds in the static range, reused by the resources registered into it later
+        uint32_t persistentViewCount;
 
     } Resource;
 
@@ -384,8 +438,9 @@ typedef struct BackendContext_VK
     {
         VkSampler             samplers[FFX_MAX_SAMPLERS];
         VkDescriptorSetLayout descriptorSetLayout;
-        VkDescriptorSet       descriptorSets[FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME];
+        VkDescriptorSet       descriptorSets[FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME_LIMIT];
         uint32_t              descriptorSetIndex;
+        uint32_t              descriptorSetsPerFrame;  // The part of descriptorSets each queued frame uses
         VkPipelineLayout      pipelineLayout;
         int32_t               staticTextureSrvSet;
         int32_t               staticBufferSrvSet;
@@ -408,8 +463,13 @@ typedef struct BackendContext_VK
         GraphicPipeline_VK graphicsPipeline[MAX_GRAPHICS_PIPELINE_COUNT];
         FfxUInt32          graphicsPipelineIndex;
 
+        // Only used by data graph pipeline
+        VkDataGraphPipelineSessionARM dataGraphSession;
+        VkDeviceMemory                dataGraphSessionMemory;
+
         wchar_t   name[64];
         FfxUInt32 effectContextId;
+        bool      inUse;
     } PipelineLayout;
 
     typedef struct VKFunctionTable
@@ -432,6 +492,10 @@ typedef struct BackendContext_VK
         PFN_vkCreateShaderModule                 vkCreateShaderModule                 = 0;
         PFN_vkCreatePipelineLayout               vkCreatePipelineLayout               = 0;
         PFN_vkCreateComputePipelines             vkCreateComputePipelines             = 0;
+        PFN_vkCreatePipelineCache                vkCreatePipelineCache                = 0;
+        PFN_vkDestroyPipelineCache               vkDestroyPipelineCache               = 0;
+        PFN_vkGetPipelineCacheData               vkGetPipelineCacheData               = 0;
+        PFN_vkMergePipelineCaches                vkMergePipelineCaches                = 0;
         PFN_vkCmdPipelineBarrier2                vkCmdPipelineBarrier2                = 0;
         PFN_vkCmdPushConstants                   vkCmdPushConstants                   = 0;
         // ARM
@@ -480,6 +544,7 @@ typedef struct BackendContext_VK
         PFN_vkCmdCopyBuffer           vkCmdCopyBuffer           = 0;
         PFN_vkCmdCopyImage            vkCmdCopyImage            = 0;
         PFN_vkCmdCopyBufferToImage    vkCmdCopyBufferToImage    = 0;
+        PFN_vkCmdCopyImageToBuffer    vkCmdCopyImageToBuffer    = 0;
         PFN_vkCmdClearColorImage      vkCmdClearColorImage      = 0;
         PFN_vkCmdFillBuffer           vkCmdFillBuffer           = 0;
         // ARM
@@ -487,6 +552,18 @@ typedef struct BackendContext_VK
         PFN_vkCmdEndRenderPass   vkCmdEndRenderPass   = 0;
         PFN_vkCmdDraw            vkCmdDraw            = 0;
         // ~ARM
+        PFN_vkCreateCommandPool          vkCreateCommandPool          = 0;
+        PFN_vkDestroyCommandPool         vkDestroyCommandPool         = 0;
+        PFN_vkAllocateCommandBuffers     vkAllocateCommandBuffers     = 0;
+        PFN_vkBeginCommandBuffer         vkBeginCommandBuffer         = 0;
+        PFN_vkEndCommandBuffer           vkEndCommandBuffer           = 0;
+        PFN_vkCmdExecuteCommands         vkCmdExecuteCommands         = 0;
+        PFN_vkResetCommandBuffer         vkResetCommandBuffer         = 0;
+        PFN_vkQueueSubmit                vkQueueSubmit                = 0;
+        PFN_vkCreateFence                vkCreateFence                = 0;
+        PFN_vkDestroyFence               vkDestroyFence               = 0;
+        PFN_vkWaitForFences              vkWaitForFences              = 0;
+        PFN_vkResetFences                vkResetFences                = 0;
         PFN_vkCmdWriteBufferMarkerAMD    vkCmdWriteBufferMarkerAMD    = 0;
         PFN_vkCmdWriteBufferMarker2AMD   vkCmdWriteBufferMarker2AMD   = 0;
         PFN_vkCmdBeginDebugUtilsLabelEXT vkCmdBeginDebugUtilsLabelEXT = 0;
@@ -519,29 +596,46 @@ typedef struct BackendContext_VK
     VkFunctionTable  vkFunctionTable = {};
 
     FfxGpuJobDescription* pGpuJobs;
-    uint32_t              gpuJobCount = 0;
 
     typedef struct VkResourceView
     {
         VkImageView     imageView;
         VkTensorViewARM tensorView;
+        uint64_t        imageViewKey;  // Hash of the create info of a retained dynamic image view, see acquireDynamicImageView()
     } VkResourceView;
     VkResourceView* pResourceViews;
 
-    uint8_t* pStagingRingBuffer;
-    uint32_t stagingRingBufferBase = 0;
+    uint8_t*   pStagingRingBuffer;
+    uint32_t   stagingRingBufferBase = 0;
+    std::mutex stagingRingBufferMutex;
 
     PipelineLayout* pPipelineLayouts;
 
     VkDescriptorPool descriptorPool;
     uint32_t         bindlessBase;
-
-    VkImageMemoryBarrier2    imageMemoryBarriers[FFX_MAX_BARRIERS]  = {};
-    VkBufferMemoryBarrier2   bufferMemoryBarriers[FFX_MAX_BARRIERS] = {};
-    VkTensorMemoryBarrierARM tensorMemoryBarriers[FFX_MAX_BARRIERS] = {};
-    uint32_t                 scheduledImageBarrierCount             = 0;
-    uint32_t                 scheduledBufferBarrierCount            = 0;
-    uint32_t                 scheduledTensorBarrierCount            = 0;
+    VkPipelineCache  pipelineCache;  // Shared by the pipelines of all effect contexts, see GetPipelineCacheDataVK()
+
+    // The jobs an effect context scheduled and the barriers batched while executing them. Each effect context
+    // records into its own state, so different contexts may schedule and execute their jobs on different threads.
+    typedef struct RecordingState
+    {
+        FfxGpuJobDescription*    pGpuJobs;  // FFX_MAX_GPU_JOBS entries of the backend's job array
+        uint32_t                 gpuJobCount;
+        VkImageMemoryBarrier2    imageMemoryBarriers[FFX_MAX_BARRIERS];
+        VkBufferMemoryBarrier2   bufferMemoryBarriers[FFX_MAX_BARRIERS];
+        VkTensorMemoryBarrierARM tensorMemoryBarriers[FFX_MAX_BARRIERS];
+        uint32_t                 scheduledImageBarrierCount;
+        uint32_t                 scheduledBufferBarrierCount;
+        uint32_t                 scheduledTensorBarrierCount;
+    } RecordingState;
+
+    typedef struct RecordedGpuJobs
+    {
+        VkCommandBuffer   commandBuffer;
+        uint64_t          hash;  // Hash of the jobs and resource generation the command buffer was recorded from, 0 when it must be re-recorded
+        FfxResourceStates endStates[FFX_MAX_RESOURCE_COUNT];     // Resource states once the command buffer has executed
+        bool              endUndefined[FFX_MAX_RESOURCE_COUNT];  // Resource undefined flags once the command buffer has executed
+    } RecordedGpuJobs;
 
     typedef struct alignas(32) EffectContext
     {
@@ -552,9 +646,14 @@ typedef struct BackendContext_VK
         uint32_t nextStaticResource;
         uint32_t nextDynamicResource;
 
+        // Persistent resources registered for the current jobs, walked back by UnregisterResourcesVK() along with the dynamic ones
+        uint32_t persistentResources[FFX_MAX_RESOURCE_COUNT];
+        uint32_t persistentResourceCount;
+
         // UAV offsets
         uint32_t nextStaticResourceView;
         uint32_t nextDynamicResourceView[FFX_MAX_QUEUED_FRAMES];
+        uint32_t retainedDynamicResourceView[FFX_MAX_QUEUED_FRAMES];  // Lowest view index still holding a view retained from an earlier frame
 
         // Bindless descriptors
         uint32_t              bindlessTextureSrvHeapStart;
@@ -576,8 +675,33 @@ typedef struct BackendContext_VK
         // Pipeline layout
         uint32_t nextPipelineLayout;
 
+        // Scheduled jobs and pending barriers
+        RecordingState recordingState;
+
         // the frame index for the context
         uint32_t frameIndex;
+        uint64_t frameCount;  // Frames dispatched, starting from the count of the device when the context was created
+
+        // Recorded command buffers, one per queued frame, and the constant buffer memory they read from
+        VkCommandPool         recordedCommandPool;
+        RecordedGpuJobs       recordedGpuJobs[FFX_MAX_QUEUED_FRAMES];
+        VkBuffer              recordedConstantBuffer;
+        VkDeviceMemory        recordedConstantBufferMemory;
+        VkMemoryPropertyFlags recordedConstantBufferMemoryProperties;
+        uint8_t*              recordedConstantBufferMem;
+        VkDeviceSize          recordedConstantAlignment;
+        VkDeviceSize          recordedConstantFrameSize;
+        VkDeviceSize          recordedConstantOffset;
+        bool                  retainDynamicViews;
+        uint32_t              resourceGeneration;  // Bumped whenever the resources change in a way the recorded command buffers depend on
+
+        // Command buffers for jobs submitted to an asynchronous queue, one per queued frame
+        VkCommandPool   asyncCommandPool;
+        VkCommandBuffer asyncCommandBuffers[FFX_MAX_QUEUED_FRAMES];
+        VkFence         asyncFences[FFX_MAX_QUEUED_FRAMES];
+        uint32_t        asyncQueueFamilyIndex;
+        uint32_t        asyncFrameIndex;
+        uint32_t        internalQueueFamilyIndex;  // The queue family the internal resources were last used on, VK_QUEUE_FAMILY_IGNORED before that
 
         // Usage
         bool active;
@@ -588,7 +712,6 @@ typedef struct BackendContext_VK
     } EffectContext;
 
     Resource*      pResources;
-    Resource       dataGraphPipelineSessionResource;
     EffectContext* pEffectContexts;
 
     // Allocation defaults
@@ -602,11 +725,148 @@ typedef struct BackendContext_VK
     VkDeviceSize          uniformBufferOffset    = 0;
     std::mutex            uniformBufferMutex;
 
+    // Pipelines may be created and destroyed from several threads. This guards the
+    // pipeline layout slots and the descriptor pool the pipelines allocate from.
+    std::mutex pipelineMutex;
+    uint32_t   pipelineGeneration;  // Bumped whenever a pipeline is destroyed, so recordings never refer to a recycled handle
+
+    uint32_t queueFamilyIndex;
+
     uint32_t               numDeviceExtensions = 0;
     VkExtensionProperties* extensionProperties = nullptr;
 
 } BackendContext_VK;
 
+// A Vulkan object whose destruction waits until the GPU can no longer be using it
+typedef struct DeferredDestruction_VK
+{
+    VkObjectType     objectType;
+    uint64_t         handle;
+    VkDescriptorPool descriptorPool;  // The pool a descriptor set is freed to
+    std::mutex*      poolMutex;       // Guards the descriptor pool, null once the pool itself is queued for destruction
+    uint64_t         retireValue;     // The object is destroyed once the completed value reaches this
+} DeferredDestruction_VK;
+
+// The objects of a device waiting to be destroyed. This lives outside the scratch memory of the backend contexts,
+// which may be reset or freed by the application while the GPU still uses objects of the contexts.
+typedef struct DeferredDestructionQueue_VK
+{
+    BackendContext_VK::VkFunctionTable  vkFunctionTable;
+    std::vector<DeferredDestruction_VK> objects;              // In the order they were queued, which keeps descriptor sets ahead of their pool
+    uint64_t                            frameCount;           // The most frames any effect context dispatched, see UnregisterResourcesVK()
+    uint64_t                            pendingValue;         // The timeline value the application signals once the work being recorded has completed
+    uint64_t                            completedValue;       // The timeline value the application knows to have been signalled
+    bool                                applicationTimeline;  // Whether the application supplies timeline values, otherwise frames are counted
+    uint32_t                            backendContextCount;  // The backend contexts created on the device, the queue goes away with the last one
+} DeferredDestructionQueue_VK;
+
+static std::map<VkDevice, DeferredDestructionQueue_VK> sDeferredDestructionQueues;
+static std::mutex                                      sDeferredDestructionMutex;
+
+static void destroyDeferredObject(const DeferredDestructionQueue_VK& queue, VkDevice device, const DeferredDestruction_VK& object)
+{
+    const BackendContext_VK::VkFunctionTable& vkFunctionTable = queue.vkFunctionTable;
+
+    switch (object.objectType)
+    {
+    case VK_OBJECT_TYPE_BUFFER:
+        vkFunctionTable.vkDestroyBuffer(device, (VkBuffer)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE:
+        vkFunctionTable.vkDestroyImage(device, (VkImage)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE_VIEW:
+        vkFunctionTable.vkDestroyImageView(device, (VkImageView)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_DEVICE_MEMORY:
+        vkFunctionTable.vkFreeMemory(device, (VkDeviceMemory)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE:
+        vkFunctionTable.vkDestroyPipeline(device, (VkPipeline)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+        vkFunctionTable.vkDestroyPipelineLayout(device, (VkPipelineLayout)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_SET:
+        if (object.poolMutex)
+        {
+            VkDescriptorSet             descriptorSet = (VkDescriptorSet)object.handle;
+            std::lock_guard<std::mutex> lock{*object.poolMutex};
+            vkFunctionTable.vkFreeDescriptorSets(device, object.descriptorPool, 1, &descriptorSet);
+        }
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+        vkFunctionTable.vkDestroyDescriptorSetLayout(device, (VkDescriptorSetLayout)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+        vkFunctionTable.vkDestroyDescriptorPool(device, (VkDescriptorPool)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_SAMPLER:
+        vkFunctionTable.vkDestroySampler(device, (VkSampler)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_FRAMEBUFFER:
+        vkFunctionTable.vkDestroyFramebuffer(device, (VkFramebuffer)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_RENDER_PASS:
+        vkFunctionTable.vkDestroyRenderPass(device, (VkRenderPass)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_COMMAND_POOL:
+        vkFunctionTable.vkDestroyCommandPool(device, (VkCommandPool)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_FENCE:
+        vkFunctionTable.vkDestroyFence(device, (VkFence)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_TENSOR_ARM:
+        vkFunctionTable.vkDestroyTensorARM(device, (VkTensorARM)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_TENSOR_VIEW_ARM:
+        vkFunctionTable.vkDestroyTensorViewARM(device, (VkTensorViewARM)object.handle, nullptr);
+        break;
+    case VK_OBJECT_TYPE_DATA_GRAPH_PIPELINE_SESSION_ARM:
+        vkFunctionTable.vkDestroyDataGraphPipelineSessionARM(device, (VkDataGraphPipelineSessionARM)object.handle, nullptr);
+        break;
+    default:
+        break;
+    }
+}
+
+// Destroys the queued objects the GPU is done with, or every queued object when flushing. Must hold sDeferredDestructionMutex.
+static void processDeferredDestructions(VkDevice device, DeferredDestructionQueue_VK& queue, bool flush)
+{
+    const uint64_t completedValue = queue.applicationTimeline ? queue.completedValue : queue.frameCount;
+
+    // retire values never decrease along the queue, so only its front can be retired
+    size_t retiredCount = 0;
+    while (retiredCount < queue.objects.size() && (flush || queue.objects[retiredCount].retireValue <= completedValue))
+    {
+        destroyDeferredObject(queue, device, queue.objects[retiredCount]);
+        ++retiredCount;
+    }
+    queue.objects.erase(queue.objects.begin(), queue.objects.begin() + retiredCount);
+}
+
+// Queues a Vulkan object to be destroyed once the work recorded so far has completed on the GPU.
+// Descriptor sets name the pool they are freed to, which must be guarded by the pipeline mutex of the backend context.
+template <typename T>
+static void deferDestruction(BackendContext_VK* backendContext, VkObjectType objectType, T handle, VkDescriptorPool descriptorPool = VK_NULL_HANDLE)
+{
+    if (handle == VK_NULL_HANDLE)
+        return;
+
+    std::lock_guard<std::mutex>  lock{sDeferredDestructionMutex};
+    DeferredDestructionQueue_VK& queue = sDeferredDestructionQueues[backendContext->device];
+
+    DeferredDestruction_VK object = {};
+    object.objectType             = objectType;
+    object.handle                 = (uint64_t)handle;
+    object.descriptorPool         = descriptorPool;
+    object.poolMutex              = descriptorPool != VK_NULL_HANDLE ? &backendContext->pipelineMutex : nullptr;
+
+    // without a timeline, the work of the frame being recorded completes once FFX_MAX_QUEUED_FRAMES more frames were dispatched
+    object.retireValue = queue.applicationTimeline ? queue.pendingValue : queue.frameCount + FFX_MAX_QUEUED_FRAMES;
+    queue.objects.push_back(object);
+}
+
 FFX_API size_t ffxGetScratchMemorySizeVK(VkDeviceContext& deviceContext, size_t maxContexts)
 {
     uint32_t numExtensions = 0;
@@ -672,6 +932,12 @@ FfxErrorCode ffxGetInterfaceVK(FfxInterface* backendInterface, FfxDevice device,
     backendInterface->fpGetPermutationBlobByIndex = ffxGetPermutationBlobByIndex;
     backendInterface->fpScheduleGpuJob            = ScheduleGpuJobVK;
     backendInterface->fpExecuteGpuJobs            = ExecuteGpuJobsVK;
+    backendInterface->fpExecuteRecordedGpuJobs    = ExecuteRecordedGpuJobsVK;
+    backendInterface->fpExecuteGpuJobsAsync       = ExecuteGpuJobsAsyncVK;
+    backendInterface->fpSetResourceFinalState      = SetResourceFinalStateVK;
+    backendInterface->fpRegisterPersistentResource = RegisterPersistentResourceVK;
+    backendInterface->fpGetPipelineCacheData       = GetPipelineCacheDataVK;
+    backendInterface->fpMergePipelineCacheData     = MergePipelineCacheDataVK;
     //backendInterface->fpRegisterConstantBufferAllocator   = RegisterConstantBufferAllocatorVK;
     //backendInterface->fpSwapChainConfigureFrameGeneration = ffxSetFrameGenerationConfigToSwapchainVK;
 
@@ -695,6 +961,43 @@ FfxErrorCode ffxGetInterfaceVK(FfxInterface* backendInterface, FfxDevice device,
     return FFX_OK;
 }
 
+FfxErrorCode ffxSetDeferredDestructionTimelineVK(FfxDevice device, uint64_t pendingValue, uint64_t completedValue)
+{
+    FFX_RETURN_ON_ERROR(device, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(completedValue <= pendingValue, FFX_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex>  lock{sDeferredDestructionMutex};
+    const VkDevice               vkDevice = reinterpret_cast<VkDeviceContext*>(device)->vkDevice;
+    DeferredDestructionQueue_VK& queue    = sDeferredDestructionQueues[vkDevice];
+
+    // objects queued while frames were counted may be used by any work submitted so far
+    if (!queue.applicationTimeline)
+    {
+        for (DeferredDestruction_VK& object : queue.objects)
+            object.retireValue = pendingValue;
+        queue.applicationTimeline = true;
+    }
+
+    queue.pendingValue   = FFX_MAXIMUM(queue.pendingValue, pendingValue);
+    queue.completedValue = FFX_MAXIMUM(queue.completedValue, completedValue);
+    processDeferredDestructions(vkDevice, queue, false);
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFlushDeferredDestructionVK(FfxDevice device)
+{
+    FFX_RETURN_ON_ERROR(device, FFX_ERROR_INVALID_POINTER);
+
+    std::lock_guard<std::mutex> lock{sDeferredDestructionMutex};
+    const VkDevice              vkDevice = reinterpret_cast<VkDeviceContext*>(device)->vkDevice;
+    auto                        it       = sDeferredDestructionQueues.find(vkDevice);
+    if (it != sDeferredDestructionQueues.end())
+        processDeferredDestructions(vkDevice, it->second, true);
+
+    return FFX_OK;
+}
+
 FfxCommandList ffxGetCommandListVK(VkCommandBuffer cmdBuf)
 {
     FFX_ASSERT(NULL != cmdBuf);
@@ -1134,6 +1437,8 @@ VkFormat ffxGetVkFormatForTensorAliasedImage(FfxSurfaceFormat tensorFormat, cons
         {
         case VK_FORMAT_R32_SFLOAT:
             return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case VK_FORMAT_R16_SFLOAT:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
         case VK_FORMAT_R8_SINT:
             return VK_FORMAT_R8G8B8A8_SNORM;
         default:
@@ -1147,6 +1452,8 @@ VkFormat ffxGetVkFormatForTensorAliasedImage(FfxSurfaceFormat tensorFormat, cons
         {
         case VK_FORMAT_R32_SFLOAT:
             return VK_FORMAT_R32_SFLOAT;
+        case VK_FORMAT_R16_SFLOAT:
+            return VK_FORMAT_R16_SFLOAT;
         case VK_FORMAT_R8_SINT:
             return VK_FORMAT_R8_SNORM;
         default:
@@ -1375,19 +1682,74 @@ uint32_t getDynamicResourceViewsStartIndex(uint32_t effectContextId, uint32_t fr
            1;
 }
 
-void destroyDynamicViews(BackendContext_VK* backendContext, uint32_t effectContextId, uint32_t frameIndex)
+uint32_t getDynamicResourceViewsEndIndex(const BackendContext_VK::EffectContext& effectContext)
+{
+    // static resource views share their range with the dynamic resource views of the first frame, including retained ones
+    return FFX_MINIMUM(effectContext.nextDynamicResourceView[0], effectContext.retainedDynamicResourceView[0]);
+}
+
+// Views left by a frame that has cycled out are destroyed immediately, when the effect context is destroyed their destruction is deferred
+void destroyDynamicViews(BackendContext_VK* backendContext, uint32_t effectContextId, uint32_t frameIndex, bool deferred)
 {
     BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
-    // Release image views for dynamic resources
+    // Release image views for dynamic resources, including any retained from earlier frames
     const uint32_t dynamicResourceViewIndexStart = getDynamicResourceViewsStartIndex(effectContextId, frameIndex);
-    for (uint32_t dynamicViewIndex = effectContext.nextDynamicResourceView[frameIndex] + 1; dynamicViewIndex <= dynamicResourceViewIndexStart;
-         ++dynamicViewIndex)
+    const uint32_t dynamicResourceViewIndexEnd =
+        FFX_MINIMUM(effectContext.nextDynamicResourceView[frameIndex], effectContext.retainedDynamicResourceView[frameIndex]);
+    for (uint32_t dynamicViewIndex = dynamicResourceViewIndexEnd + 1; dynamicViewIndex <= dynamicResourceViewIndexStart; ++dynamicViewIndex)
     {
-        backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
-        backendContext->pResourceViews[dynamicViewIndex].imageView = VK_NULL_HANDLE;
+        if (deferred)
+            deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, backendContext->pResourceViews[dynamicViewIndex].imageView);
+        else
+            backendContext->vkFunctionTable.vkDestroyImageView(
+                backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
+        backendContext->pResourceViews[dynamicViewIndex].imageView    = VK_NULL_HANDLE;
+        backendContext->pResourceViews[dynamicViewIndex].imageViewKey = 0;
+    }
+    effectContext.nextDynamicResourceView[frameIndex]     = dynamicResourceViewIndexStart;
+    effectContext.retainedDynamicResourceView[frameIndex] = dynamicResourceViewIndexStart;
+}
+
+// Creates the image view of a dynamic resource. When the effect context retains dynamic views, the view left at this
+// index by an earlier frame is reused if it was created from the same image and description.
+static VkResult acquireDynamicImageView(BackendContext_VK*            backendContext,
+                                        uint32_t                      effectContextId,
+                                        uint32_t                      viewIndex,
+                                        const VkImageViewCreateInfo&  imageViewCreateInfo,
+                                        const FfxResourceDescription& resourceDescription)
+{
+    BackendContext_VK::VkResourceView& resourceView = backendContext->pResourceViews[viewIndex];
+
+    struct
+    {
+        VkImage                 image;
+        VkImageViewType         viewType;
+        VkFormat                format;
+        VkImageSubresourceRange subresourceRange;
+        uint32_t                usage;
+    } viewKey;
+    memset(&viewKey, 0, sizeof(viewKey));
+    viewKey.image            = imageViewCreateInfo.image;
+    viewKey.viewType         = imageViewCreateInfo.viewType;
+    viewKey.format           = imageViewCreateInfo.format;
+    viewKey.subresourceRange = imageViewCreateInfo.subresourceRange;
+    viewKey.usage            = resourceDescription.usage;
+
+    const uint64_t imageViewKey = arm::computeHash(&viewKey, sizeof(viewKey));
+
+    if (resourceView.imageView != VK_NULL_HANDLE)
+    {
+        if (backendContext->pEffectContexts[effectContextId].retainDynamicViews && resourceView.imageViewKey == imageViewKey)
+            return VK_SUCCESS;
+
+        backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, resourceView.imageView, VK_NULL_HANDLE);
+        resourceView.imageView = VK_NULL_HANDLE;
     }
-    effectContext.nextDynamicResourceView[frameIndex] = dynamicResourceViewIndexStart;
+
+    resourceView.imageViewKey = imageViewKey;
+    ++backendContext->pEffectContexts[effectContextId].resourceGeneration;
+    return backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &imageViewCreateInfo, NULL, &resourceView.imageView);
 }
 
 VkAccessFlags2 getVKAccessFlagsFromResourceState(FfxResourceStates state)
@@ -1502,6 +1864,23 @@ void addMutableViewForSRV(VkImageViewCreateInfo&      imageViewCreateInfo,
     }
 }
 
+// The views of a persistent slot are destroyed once the GPU is done with them, the slot keeps their range for its next resource
+static void releasePersistentResource(BackendContext_VK* backendContext, BackendContext_VK::Resource* backendResource)
+{
+    for (uint32_t i = 0; i < backendResource->persistentViewCount; ++i)
+    {
+        VkImageView& imageView = backendContext->pResourceViews[backendResource->persistentViewIndex + i].imageView;
+        deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, imageView);
+        imageView = VK_NULL_HANDLE;
+    }
+
+    backendResource->imageResource   = VK_NULL_HANDLE;
+    backendResource->srvViewIndex    = -1;
+    backendResource->uavViewIndex    = -1;
+    backendResource->uavViewCount    = 0;
+    backendResource->registrationKey = 0;
+}
+
 void copyResourceState(BackendContext_VK::Resource* backendResource, const FfxResource* inFfxResource)
 {
     FfxResourceStates state = inFfxResource->state;
@@ -1509,6 +1888,7 @@ void copyResourceState(BackendContext_VK::Resource* backendResource, const FfxRe
     // copy the new states
     backendResource->initialState = state;
     backendResource->currentState = state;
+    backendResource->finalState   = state;
     backendResource->undefined    = false;
     backendResource->dynamic      = true;
 
@@ -1585,7 +1965,14 @@ void endMarkerVK(BackendContext_VK* backendContext, VkCommandBuffer commandBuffe
     backendContext->vkFunctionTable.vkCmdEndDebugUtilsLabelEXT(commandBuffer);
 }
 
-void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource, FfxResourceStates newState)
+static bool isReadOnlyResourceState(FfxResourceStates state)
+{
+    const uint32_t readOnlyStates = FFX_RESOURCE_STATE_COMPUTE_READ | FFX_RESOURCE_STATE_PIXEL_READ | FFX_RESOURCE_STATE_COPY_SRC |
+                                    FFX_RESOURCE_STATE_INDIRECT_ARGUMENT | FFX_RESOURCE_STATE_DATA_GRAPH_READ;
+    return state != 0 && (state & ~readOnlyStates) == 0;
+}
+
+void addBarrier(BackendContext_VK* backendContext, BackendContext_VK::RecordingState& recordingState, FfxResourceInternal* resource, FfxResourceStates newState)
 {
     FFX_ASSERT(NULL != backendContext);
     FFX_ASSERT(NULL != resource);
@@ -1593,11 +1980,16 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
     BackendContext_VK::Resource& ffxResource = backendContext->pResources[resource->internalIndex];
     FfxResourceStates&           curState    = backendContext->pResources[resource->internalIndex].currentState;
 
+    // A read-only state covering the new one needs no barrier, as the earlier writes are already visible to its readers
+    if (!ffxResource.undefined && isReadOnlyResourceState(curState) && (newState & ~curState) == 0 &&
+        getVKImageLayoutFromResourceState(curState) == getVKImageLayoutFromResourceState(newState))
+        return;
+
     if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
         // Buffer barrier
         VkBuffer                vkResource = ffxResource.bufferResource;
-        VkBufferMemoryBarrier2* barrier    = &backendContext->bufferMemoryBarriers[backendContext->scheduledBufferBarrierCount];
+        VkBufferMemoryBarrier2* barrier    = &recordingState.bufferMemoryBarriers[recordingState.scheduledBufferBarrierCount];
 
         barrier->sType        = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
         barrier->pNext        = nullptr;
@@ -1612,13 +2004,13 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         barrier->offset              = 0;
         barrier->size                = VK_WHOLE_SIZE;
 
-        ++backendContext->scheduledBufferBarrierCount;
+        ++recordingState.scheduledBufferBarrierCount;
     }
     else if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_TENSOR)
     {
         // Tensor barrier
         VkTensorARM               vkResource = ffxResource.tensorResource;
-        VkTensorMemoryBarrierARM* barrier    = &backendContext->tensorMemoryBarriers[backendContext->scheduledTensorBarrierCount];
+        VkTensorMemoryBarrierARM* barrier    = &recordingState.tensorMemoryBarriers[recordingState.scheduledTensorBarrierCount];
 
         barrier->sType        = VK_STRUCTURE_TYPE_TENSOR_MEMORY_BARRIER_ARM;
         barrier->pNext        = nullptr;
@@ -1631,13 +2023,13 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier->tensor              = vkResource;
 
-        ++backendContext->scheduledTensorBarrierCount;
+        ++recordingState.scheduledTensorBarrierCount;
 
         if (ffxResource.aliasedTensorImageResource != VK_NULL_HANDLE)
         {
             VkImage vkImageResource = ffxResource.aliasedTensorImageResource;
 
-            VkImageMemoryBarrier2* barrier  = &backendContext->imageMemoryBarriers[backendContext->scheduledImageBarrierCount];
+            VkImageMemoryBarrier2* barrier  = &recordingState.imageMemoryBarriers[recordingState.scheduledImageBarrierCount];
             FfxResourceStates&     curState = backendContext->pResources[resource->internalIndex].currentState;
 
             VkImageSubresourceRange range;
@@ -1662,7 +2054,7 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
 
             curState = newState;
 
-            ++backendContext->scheduledImageBarrierCount;
+            ++recordingState.scheduledImageBarrierCount;
         }
     }
     else
@@ -1670,7 +2062,7 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         VkImage vkResource =
             ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_TENSOR ? ffxResource.aliasedTensorImageResource : ffxResource.imageResource;
 
-        VkImageMemoryBarrier2* barrier = &backendContext->imageMemoryBarriers[backendContext->scheduledImageBarrierCount];
+        VkImageMemoryBarrier2* barrier = &recordingState.imageMemoryBarriers[recordingState.scheduledImageBarrierCount];
 
         VkImageSubresourceRange range;
         range.aspectMask     = getImageAspect(ffxResource.resourceDescription.usage);
@@ -1693,7 +2085,7 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         barrier->image               = vkResource;
         barrier->subresourceRange    = range;
 
-        ++backendContext->scheduledImageBarrierCount;
+        ++recordingState.scheduledImageBarrierCount;
     }
 
     curState = newState;
@@ -1702,35 +2094,115 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         ffxResource.undefined = false;
 }
 
-void flushBarriers(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer)
+void flushBarriers(BackendContext_VK* backendContext, BackendContext_VK::RecordingState& recordingState, VkCommandBuffer vkCommandBuffer)
 {
     FFX_ASSERT(NULL != backendContext);
     FFX_ASSERT(NULL != vkCommandBuffer);
 
     uint32_t totalCount =
-        backendContext->scheduledImageBarrierCount + backendContext->scheduledBufferBarrierCount + backendContext->scheduledTensorBarrierCount;
+        recordingState.scheduledImageBarrierCount + recordingState.scheduledBufferBarrierCount + recordingState.scheduledTensorBarrierCount;
     if (totalCount)
     {
         const VkTensorDependencyInfoARM tensorDependencyInfo = {VK_STRUCTURE_TYPE_TENSOR_DEPENDENCY_INFO_ARM,
                                                                 nullptr,
-                                                                static_cast<uint32_t>(backendContext->scheduledTensorBarrierCount),
-                                                                backendContext->tensorMemoryBarriers};
+                                                                static_cast<uint32_t>(recordingState.scheduledTensorBarrierCount),
+                                                                recordingState.tensorMemoryBarriers};
 
         const VkDependencyInfo dependencyInfo = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-                                                 backendContext->scheduledTensorBarrierCount != 0 ? &tensorDependencyInfo : NULL,
+                                                 recordingState.scheduledTensorBarrierCount != 0 ? &tensorDependencyInfo : NULL,
                                                  VK_DEPENDENCY_BY_REGION_BIT,  // dependencyFlags
                                                  0,                            // memoryBarrierCount
                                                  nullptr,                      // pMemoryBarriers
-                                                 backendContext->scheduledBufferBarrierCount,
-                                                 backendContext->bufferMemoryBarriers,
-                                                 backendContext->scheduledImageBarrierCount,
-                                                 backendContext->imageMemoryBarriers};
+                                                 recordingState.scheduledBufferBarrierCount,
+                                                 recordingState.bufferMemoryBarriers,
+                                                 recordingState.scheduledImageBarrierCount,
+                                                 recordingState.imageMemoryBarriers};
 
         backendContext->vkFunctionTable.vkCmdPipelineBarrier2(vkCommandBuffer, &dependencyInfo);
 
-        backendContext->scheduledTensorBarrierCount = 0;
-        backendContext->scheduledImageBarrierCount  = 0;
-        backendContext->scheduledBufferBarrierCount = 0;
+        recordingState.scheduledTensorBarrierCount = 0;
+        recordingState.scheduledImageBarrierCount  = 0;
+        recordingState.scheduledBufferBarrierCount = 0;
+    }
+}
+
+// Collects the external resources registered for the current jobs, the dynamic ones followed by the persistent ones
+static uint32_t getRegisteredResources(const BackendContext_VK* backendContext, FfxUInt32 effectContextId, uint32_t resourceIndices[FFX_MAX_RESOURCE_COUNT])
+{
+    const BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
+    uint32_t resourceCount = 0;
+    for (uint32_t resourceIndex = effectContext.nextDynamicResource + 1; resourceIndex <= getDynamicResourcesStartIndex(effectContextId); ++resourceIndex)
+        resourceIndices[resourceCount++] = resourceIndex;
+    for (uint32_t i = 0; i < effectContext.persistentResourceCount; ++i)
+        resourceIndices[resourceCount++] = effectContext.persistentResources[i];
+    return resourceCount;
+}
+
+// Schedules the release (on srcQueueFamilyIndex) or the acquire (on dstQueueFamilyIndex) half of a queue family ownership transfer
+// of the registered resources listed in resourceIndices. The resources keep their current state.
+void addQueueFamilyTransferBarriers(BackendContext_VK*                 backendContext,
+                                    BackendContext_VK::RecordingState& recordingState,
+                                    const uint32_t*                    resourceIndices,
+                                    uint32_t                           resourceCount,
+                                    uint32_t                           srcQueueFamilyIndex,
+                                    uint32_t                           dstQueueFamilyIndex,
+                                    bool                               release)
+{
+    for (uint32_t i = 0; i < resourceCount; ++i)
+    {
+        const BackendContext_VK::Resource& ffxResource = backendContext->pResources[resourceIndices[i]];
+        const FfxResourceStates            state       = ffxResource.currentState;
+
+        // An image registered twice is transferred once
+        bool duplicate = false;
+        for (uint32_t j = 0; j < i && !duplicate; ++j)
+            duplicate = backendContext->pResources[resourceIndices[j]].imageResource == ffxResource.imageResource;
+        if (duplicate || ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_TENSOR)
+            continue;
+
+        const VkPipelineStageFlags2 srcStageMask  = release ? getVKPipelineStageFlagsFromResourceState(state) : VK_PIPELINE_STAGE_2_NONE;
+        const VkAccessFlags2        srcAccessMask = release ? getVKAccessFlagsFromResourceState(state) : VK_ACCESS_2_NONE;
+        const VkPipelineStageFlags2 dstStageMask  = release ? VK_PIPELINE_STAGE_2_NONE : getVKPipelineStageFlagsFromResourceState(state);
+        const VkAccessFlags2        dstAccessMask = release ? VK_ACCESS_2_NONE : getVKAccessFlagsFromResourceState(state);
+
+        if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
+        {
+            VkBufferMemoryBarrier2* barrier = &recordingState.bufferMemoryBarriers[recordingState.scheduledBufferBarrierCount++];
+
+            barrier->sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            barrier->pNext               = nullptr;
+            barrier->srcStageMask        = srcStageMask;
+            barrier->srcAccessMask       = srcAccessMask;
+            barrier->dstStageMask        = dstStageMask;
+            barrier->dstAccessMask       = dstAccessMask;
+            barrier->srcQueueFamilyIndex = srcQueueFamilyIndex;
+            barrier->dstQueueFamilyIndex = dstQueueFamilyIndex;
+            barrier->buffer              = ffxResource.bufferResource;
+            barrier->offset              = 0;
+            barrier->size                = VK_WHOLE_SIZE;
+        }
+        else
+        {
+            VkImageMemoryBarrier2* barrier = &recordingState.imageMemoryBarriers[recordingState.scheduledImageBarrierCount++];
+
+            barrier->sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            barrier->pNext                           = nullptr;
+            barrier->srcStageMask                    = srcStageMask;
+            barrier->srcAccessMask                   = srcAccessMask;
+            barrier->dstStageMask                    = dstStageMask;
+            barrier->dstAccessMask                   = dstAccessMask;
+            barrier->oldLayout                       = getVKImageLayoutFromResourceState(state);
+            barrier->newLayout                       = getVKImageLayoutFromResourceState(state);
+            barrier->srcQueueFamilyIndex             = srcQueueFamilyIndex;
+            barrier->dstQueueFamilyIndex             = dstQueueFamilyIndex;
+            barrier->image                           = ffxResource.imageResource;
+            barrier->subresourceRange.aspectMask     = getImageAspect(ffxResource.resourceDescription.usage);
+            barrier->subresourceRange.baseMipLevel   = 0;
+            barrier->subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+            barrier->subresourceRange.baseArrayLayer = 0;
+            barrier->subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        }
     }
 }
 
@@ -1964,6 +2436,10 @@ static bool LoadVulkanFunctions(VkDeviceContext* vkDeviceContext, BackendContext
         success &= loader.getDeviceProc(tb.vkCreateShaderModule, "vkCreateShaderModule");
         success &= loader.getDeviceProc(tb.vkCreatePipelineLayout, "vkCreatePipelineLayout");
         success &= loader.getDeviceProc(tb.vkCreateComputePipelines, "vkCreateComputePipelines");
+        success &= loader.getDeviceProc(tb.vkCreatePipelineCache, "vkCreatePipelineCache");
+        success &= loader.getDeviceProc(tb.vkDestroyPipelineCache, "vkDestroyPipelineCache");
+        success &= loader.getDeviceProc(tb.vkGetPipelineCacheData, "vkGetPipelineCacheData");
+        success &= loader.getDeviceProc(tb.vkMergePipelineCaches, "vkMergePipelineCaches");
 
         success &= loader.getDeviceProc(tb.vkCreateGraphicsPipelines, "vkCreateGraphicsPipelines");
         success &= loader.getDeviceProc(tb.vkCreateRenderPass, "vkCreateRenderPass");
@@ -2001,11 +2477,13 @@ static bool LoadVulkanFunctions(VkDeviceContext* vkDeviceContext, BackendContext
         success &= loader.getDeviceProc(tb.vkCmdPipelineBarrier2, "vkCmdPipelineBarrier2");
         success &= loader.getDeviceProc(tb.vkCmdBindPipeline, "vkCmdBindPipeline");
         success &= loader.getDeviceProc(tb.vkCmdBindDescriptorSets, "vkCmdBindDescriptorSets");
+        success &= loader.getDeviceProc(tb.vkCmdPushConstants, "vkCmdPushConstants");
         success &= loader.getDeviceProc(tb.vkCmdDispatch, "vkCmdDispatch");
         success &= loader.getDeviceProc(tb.vkCmdDispatchIndirect, "vkCmdDispatchIndirect");
         success &= loader.getDeviceProc(tb.vkCmdCopyBuffer, "vkCmdCopyBuffer");
         success &= loader.getDeviceProc(tb.vkCmdCopyImage, "vkCmdCopyImage");
         success &= loader.getDeviceProc(tb.vkCmdCopyBufferToImage, "vkCmdCopyBufferToImage");
+        success &= loader.getDeviceProc(tb.vkCmdCopyImageToBuffer, "vkCmdCopyImageToBuffer");
         success &= loader.getDeviceProc(tb.vkCmdClearColorImage, "vkCmdClearColorImage");
         success &= loader.getDeviceProc(tb.vkCmdFillBuffer, "vkCmdFillBuffer");
 
@@ -2013,6 +2491,19 @@ static bool LoadVulkanFunctions(VkDeviceContext* vkDeviceContext, BackendContext
         success &= loader.getDeviceProc(tb.vkCmdEndRenderPass, "vkCmdEndRenderPass");
         success &= loader.getDeviceProc(tb.vkCmdDraw, "vkCmdDraw");
 
+        success &= loader.getDeviceProc(tb.vkCreateCommandPool, "vkCreateCommandPool");
+        success &= loader.getDeviceProc(tb.vkDestroyCommandPool, "vkDestroyCommandPool");
+        success &= loader.getDeviceProc(tb.vkAllocateCommandBuffers, "vkAllocateCommandBuffers");
+        success &= loader.getDeviceProc(tb.vkBeginCommandBuffer, "vkBeginCommandBuffer");
+        success &= loader.getDeviceProc(tb.vkEndCommandBuffer, "vkEndCommandBuffer");
+        success &= loader.getDeviceProc(tb.vkCmdExecuteCommands, "vkCmdExecuteCommands");
+        success &= loader.getDeviceProc(tb.vkResetCommandBuffer, "vkResetCommandBuffer");
+        success &= loader.getDeviceProc(tb.vkQueueSubmit, "vkQueueSubmit");
+        success &= loader.getDeviceProc(tb.vkCreateFence, "vkCreateFence");
+        success &= loader.getDeviceProc(tb.vkDestroyFence, "vkDestroyFence");
+        success &= loader.getDeviceProc(tb.vkWaitForFences, "vkWaitForFences");
+        success &= loader.getDeviceProc(tb.vkResetFences, "vkResetFences");
+
         // Optional debug markers
         loader.getDeviceProc(tb.vkSetDebugUtilsObjectNameEXT, "vkSetDebugUtilsObjectNameEXT");
         loader.getDeviceProc(tb.vkCmdWriteBufferMarkerAMD, "vkCmdWriteBufferMarkerAMD");
@@ -2056,6 +2547,8 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         resetBackendContext(backendContext);
 
         new (&backendContext->uniformBufferMutex) std::mutex();
+        new (&backendContext->pipelineMutex) std::mutex();
+        new (&backendContext->stagingRingBufferMutex) std::mutex();
 
         // Map all of our pointers
         uint32_t gpuJobDescArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
@@ -2127,12 +2620,23 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             backendContext->physicalDevice = vkDeviceContext->vkPhysicalDevice;
         }
 
+        backendContext->queueFamilyIndex = vkDeviceContext->queueFamilyIndex;
+
         // load vulkan functions
         if (!LoadVulkanFunctions(vkDeviceContext, backendContext))
         {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 
+        // the deferred destruction queue of the device outlives this backend context, so it keeps its own function table
+        {
+            std::lock_guard<std::mutex>  lock{sDeferredDestructionMutex};
+            DeferredDestructionQueue_VK& queue = sDeferredDestructionQueues[backendContext->device];
+            queue.vkFunctionTable              = backendContext->vkFunctionTable;
+            ++queue.backendContextCount;
+            processDeferredDestructions(backendContext->device, queue, false);
+        }
+
         // enumerate all the device extensions
         backendContext->numDeviceExtensions = 0;
         backendContext->vkFunctionTable.vkEnumerateDeviceExtensionProperties(
@@ -2172,6 +2676,16 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 
+        // create the pipeline cache, which MergePipelineCacheDataVK() fills from an earlier run
+        VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
+        pipelineCacheCreateInfo.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        if (backendContext->vkFunctionTable.vkCreatePipelineCache(backendContext->device, &pipelineCacheCreateInfo, nullptr, &backendContext->pipelineCache) !=
+            VK_SUCCESS)
+        {
+            return FFX_ERROR_BACKEND_API_ERROR;
+        }
+
         // set bindless resource view to base
         backendContext->bindlessBase = (backendContext->maxEffectContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2);
 
@@ -2271,15 +2785,25 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             effectContext.active                            = true;
             effectContext.effectId                          = effect;
 
-            effectContext.nextStaticResource     = (i * FFX_MAX_RESOURCE_COUNT) + 1;
-            effectContext.nextDynamicResource    = getDynamicResourcesStartIndex(i);
-            effectContext.nextStaticResourceView = (i * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2);
+            effectContext.nextStaticResource      = (i * FFX_MAX_RESOURCE_COUNT) + 1;
+            effectContext.nextDynamicResource     = getDynamicResourcesStartIndex(i);
+            effectContext.persistentResourceCount = 0;
+            effectContext.nextStaticResourceView  = (i * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2);
             for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
             {
-                effectContext.nextDynamicResourceView[frameIndex] = getDynamicResourceViewsStartIndex(i, frameIndex);
+                effectContext.nextDynamicResourceView[frameIndex]     = getDynamicResourceViewsStartIndex(i, frameIndex);
+                effectContext.retainedDynamicResourceView[frameIndex] = getDynamicResourceViewsStartIndex(i, frameIndex);
+            }
+            effectContext.nextPipelineLayout       = (i * FFX_MAX_PASS_COUNT);
+            effectContext.frameIndex               = 0;
+            effectContext.internalQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+            effectContext.recordingState          = {};
+            effectContext.recordingState.pGpuJobs = backendContext->pGpuJobs + (i * FFX_MAX_GPU_JOBS);
+            {
+                std::lock_guard<std::mutex> lock{sDeferredDestructionMutex};
+                effectContext.frameCount = sDeferredDestructionQueues[backendContext->device].frameCount;
             }
-            effectContext.nextPipelineLayout = (i * FFX_MAX_PASS_COUNT);
-            effectContext.frameIndex         = 0;
 
             if (bindlessConfig)
             {
@@ -2523,6 +3047,9 @@ FfxErrorCode GetDeviceCapabilitiesVK(FfxInterface* backendInterface, FfxDeviceCa
     deviceCapabilities->shaderStorageBufferArrayNonUniformIndexing = false;
     deviceCapabilities->tensorSupported                            = false;
     deviceCapabilities->dataGraphSupported                         = false;
+    deviceCapabilities->integerDotProductSupported                 = false;
+    deviceCapabilities->pushConstant16BitSupported                 = false;
+    deviceCapabilities->maxPushConstantsSize                       = 0;
 
     BackendContext_VK* context = (BackendContext_VK*)backendInterface->scratchBuffer;
 
@@ -2636,77 +3163,289 @@ FfxErrorCode GetDeviceCapabilitiesVK(FfxInterface* backendInterface, FfxDeviceCa
             // no features structure so extension name is enough
             deviceCapabilities->dataGraphSupported = true;
         }
+        else if (strcmp(extensionName, VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME) == 0)
+        {
+            VkPhysicalDeviceShaderIntegerDotProductFeatures integerDotProductFeatures = {};
+            integerDotProductFeatures.sType                                           = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_INTEGER_DOT_PRODUCT_FEATURES;
+
+            VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 = {};
+            physicalDeviceFeatures2.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            physicalDeviceFeatures2.pNext                     = &integerDotProductFeatures;
+
+            backendContext->vkFunctionTable.vkGetPhysicalDeviceFeatures2(context->physicalDevice, &physicalDeviceFeatures2);
+
+            deviceCapabilities->integerDotProductSupported = (bool)integerDotProductFeatures.shaderIntegerDotProduct;
+        }
+    }
+
+    // push constant limits and 16-bit storage are core in Vulkan 1.1
+    {
+        VkPhysicalDevice16BitStorageFeatures storage16BitFeatures = {};
+        storage16BitFeatures.sType                                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES;
+
+        VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 = {};
+        physicalDeviceFeatures2.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        physicalDeviceFeatures2.pNext                     = &storage16BitFeatures;
+
+        backendContext->vkFunctionTable.vkGetPhysicalDeviceFeatures2(context->physicalDevice, &physicalDeviceFeatures2);
+
+        VkPhysicalDeviceProperties physicalDeviceProperties = {};
+        backendContext->vkFunctionTable.vkGetPhysicalDeviceProperties(context->physicalDevice, &physicalDeviceProperties);
+
+        deviceCapabilities->pushConstant16BitSupported = (bool)storage16BitFeatures.storagePushConstant16;
+        deviceCapabilities->maxPushConstantsSize       = physicalDeviceProperties.limits.maxPushConstantsSize;
     }
 
     return FFX_OK;
 }
 
-FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 effectContextId)
+static void destroyRecordedGpuJobResources(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
 {
-    FFX_ASSERT(NULL != backendInterface);
-    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
-    FFX_ASSERT(backendContext->refCount > 0);
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
-    // Delete any resources allocated by this context
+    // destroying the pool also frees the command buffers allocated from it, which may still be pending
+    deferDestruction(backendContext, VK_OBJECT_TYPE_COMMAND_POOL, effectContext.recordedCommandPool);
+
+    if (effectContext.recordedConstantBufferMem)
+        backendContext->vkFunctionTable.vkUnmapMemory(backendContext->device, effectContext.recordedConstantBufferMemory);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_BUFFER, effectContext.recordedConstantBuffer);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DEVICE_MEMORY, effectContext.recordedConstantBufferMemory);
+
+    effectContext.recordedCommandPool          = VK_NULL_HANDLE;
+    effectContext.recordedConstantBuffer       = VK_NULL_HANDLE;
+    effectContext.recordedConstantBufferMemory = VK_NULL_HANDLE;
+    effectContext.recordedConstantBufferMem    = nullptr;
+    effectContext.retainDynamicViews           = false;
+    memset(effectContext.recordedGpuJobs, 0, sizeof(effectContext.recordedGpuJobs));
+}
+
+static FfxErrorCode createRecordedGpuJobResources(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
+{
     BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
-    for (uint32_t currentStaticResourceIndex = effectContextId * FFX_MAX_RESOURCE_COUNT; currentStaticResourceIndex < effectContext.nextStaticResource;
-         ++currentStaticResourceIndex)
+
+    if (effectContext.recordedCommandPool != VK_NULL_HANDLE)
+        return FFX_OK;
+
+    // one secondary command buffer per queued frame
+    VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+    commandPoolCreateInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags                   = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex        = backendContext->queueFamilyIndex;
+
+    VkResult res =
+        backendContext->vkFunctionTable.vkCreateCommandPool(backendContext->device, &commandPoolCreateInfo, nullptr, &effectContext.recordedCommandPool);
+
+    VkCommandBuffer commandBuffers[FFX_MAX_QUEUED_FRAMES] = {};
+    if (res == VK_SUCCESS)
+    {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool                 = effectContext.recordedCommandPool;
+        allocInfo.level                       = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount          = FFX_MAX_QUEUED_FRAMES;
+
+        res = backendContext->vkFunctionTable.vkAllocateCommandBuffers(backendContext->device, &allocInfo, commandBuffers);
+    }
+
+    // constant buffer with a fixed part for each queued frame
+    if (res == VK_SUCCESS)
+    {
+        VkPhysicalDeviceProperties physicalDeviceProperties = {};
+        backendContext->vkFunctionTable.vkGetPhysicalDeviceProperties(backendContext->physicalDevice, &physicalDeviceProperties);
+        effectContext.recordedConstantAlignment = physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
+        effectContext.recordedConstantFrameSize = FFX_ALIGN_UP(FFX_BUFFER_SIZE, effectContext.recordedConstantAlignment) * FFX_MAX_PASS_COUNT;
+
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size               = effectContext.recordedConstantFrameSize * FFX_MAX_QUEUED_FRAMES;
+        bufferInfo.usage              = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+        res = backendContext->vkFunctionTable.vkCreateBuffer(backendContext->device, &bufferInfo, nullptr, &effectContext.recordedConstantBuffer);
+    }
+
+    VkMemoryAllocateInfo allocInfo = {};
+    if (res == VK_SUCCESS)
     {
-        if (backendContext->pResources[currentStaticResourceIndex].imageResource != VK_NULL_HANDLE)
+        VkMemoryRequirements memRequirements = {};
+        backendContext->vkFunctionTable.vkGetBufferMemoryRequirements(backendContext->device, effectContext.recordedConstantBuffer, &memRequirements);
+
+        VkMemoryPropertyFlags requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize  = memRequirements.size;
+        allocInfo.memoryTypeIndex =
+            findMemoryTypeIndex(backendContext, memRequirements, requiredMemoryProperties, effectContext.recordedConstantBufferMemoryProperties);
+
+        if (allocInfo.memoryTypeIndex == UINT32_MAX)
         {
-            FFX_ASSERT_MESSAGE(false,
-                               "FFXInterface: Vulkan: SDK Resource was not destroyed prior to destroying the backend context. There is a resource leak.");
-            FfxResourceInternal internalResource = {static_cast<int32_t>(currentStaticResourceIndex)};
-            DestroyResourceVK(backendInterface, internalResource, effectContextId);
+            requiredMemoryProperties  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            allocInfo.memoryTypeIndex =
+                findMemoryTypeIndex(backendContext, memRequirements, requiredMemoryProperties, effectContext.recordedConstantBufferMemoryProperties);
+
+            if (allocInfo.memoryTypeIndex == UINT32_MAX)
+                res = VK_ERROR_INITIALIZATION_FAILED;
         }
     }
 
+    if (res == VK_SUCCESS)
+        res = backendContext->vkFunctionTable.vkAllocateMemory(backendContext->device, &allocInfo, nullptr, &effectContext.recordedConstantBufferMemory);
+
+    if (res == VK_SUCCESS)
+        res = backendContext->vkFunctionTable.vkBindBufferMemory(
+            backendContext->device, effectContext.recordedConstantBuffer, effectContext.recordedConstantBufferMemory, 0);
+
+    void* pMappedMemory = nullptr;
+    if (res == VK_SUCCESS)
+        res = backendContext->vkFunctionTable.vkMapMemory(
+            backendContext->device, effectContext.recordedConstantBufferMemory, 0, VK_WHOLE_SIZE, 0, &pMappedMemory);
+
+    if (res != VK_SUCCESS)
+    {
+        destroyRecordedGpuJobResources(backendContext, effectContextId);
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
+
+    effectContext.recordedConstantBufferMem = static_cast<uint8_t*>(pMappedMemory);
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
+    {
+        effectContext.recordedGpuJobs[frameIndex].commandBuffer = commandBuffers[frameIndex];
+        effectContext.recordedGpuJobs[frameIndex].hash          = 0;
+    }
+
+    return FFX_OK;
+}
+
+static void destroyAsyncGpuJobResources(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
     for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
-        destroyDynamicViews(backendContext, effectContextId, frameIndex);
+    {
+        // the command buffers may still be executing, so their fences go with the pool rather than being waited on
+        deferDestruction(backendContext, VK_OBJECT_TYPE_FENCE, effectContext.asyncFences[frameIndex]);
+        effectContext.asyncFences[frameIndex]         = VK_NULL_HANDLE;
+        effectContext.asyncCommandBuffers[frameIndex] = VK_NULL_HANDLE;
+    }
+
+    deferDestruction(backendContext, VK_OBJECT_TYPE_COMMAND_POOL, effectContext.asyncCommandPool);
+
+    effectContext.asyncCommandPool = VK_NULL_HANDLE;
+    effectContext.asyncFrameIndex  = 0;
+}
+
+// The internal resources are exclusive to the queue family they were last used on, and the release of that family was never recorded.
+// When the jobs move to another family, the images are transitioned from VK_IMAGE_LAYOUT_UNDEFINED and the contents of all are discarded.
+static void acquireInternalResources(BackendContext_VK* backendContext, FfxUInt32 effectContextId, uint32_t queueFamilyIndex)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
-    // clean up descriptor set layouts
-    if (effectContext.bindlessTextureSrvDescriptorSetLayout)
+    if (effectContext.internalQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED && effectContext.internalQueueFamilyIndex != queueFamilyIndex)
     {
-        backendContext->vkFunctionTable.vkFreeDescriptorSets(
-            backendContext->device, effectContext.bindlessDescriptorPool, 1, &effectContext.bindlessTextureSrvDescriptorSet);
-        backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(
-            backendContext->device, effectContext.bindlessTextureSrvDescriptorSetLayout, VK_NULL_HANDLE);
-        effectContext.bindlessTextureSrvDescriptorSetLayout = VK_NULL_HANDLE;
+        for (uint32_t index = effectContextId * FFX_MAX_RESOURCE_COUNT + 1; index < effectContext.nextStaticResource; ++index)
+        {
+            if (!backendContext->pResources[index].persistent)
+                backendContext->pResources[index].undefined = true;
+        }
+        ++effectContext.resourceGeneration;
     }
+    effectContext.internalQueueFamilyIndex = queueFamilyIndex;
+}
 
-    if (effectContext.bindlessBufferSrvDescriptorSetLayout)
+static FfxErrorCode createAsyncGpuJobResources(BackendContext_VK* backendContext, FfxUInt32 effectContextId, uint32_t queueFamilyIndex)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
+    if (effectContext.asyncCommandPool != VK_NULL_HANDLE)
     {
-        backendContext->vkFunctionTable.vkFreeDescriptorSets(
-            backendContext->device, effectContext.bindlessDescriptorPool, 1, &effectContext.bindlessBufferSrvDescriptorSet);
-        backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(
-            backendContext->device, effectContext.bindlessBufferSrvDescriptorSetLayout, VK_NULL_HANDLE);
-        effectContext.bindlessBufferSrvDescriptorSetLayout = VK_NULL_HANDLE;
+        if (effectContext.asyncQueueFamilyIndex == queueFamilyIndex)
+            return FFX_OK;
+
+        // the queue moved to another family, the command buffers have to come from a pool of that family
+        destroyAsyncGpuJobResources(backendContext, effectContextId);
     }
 
-    if (effectContext.bindlessTextureUavDescriptorSetLayout)
+    VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+    commandPoolCreateInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags                   = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex        = queueFamilyIndex;
+
+    VkResult res =
+        backendContext->vkFunctionTable.vkCreateCommandPool(backendContext->device, &commandPoolCreateInfo, nullptr, &effectContext.asyncCommandPool);
+
+    if (res == VK_SUCCESS)
     {
-        backendContext->vkFunctionTable.vkFreeDescriptorSets(
-            backendContext->device, effectContext.bindlessDescriptorPool, 1, &effectContext.bindlessTextureUavDescriptorSet);
-        backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(
-            backendContext->device, effectContext.bindlessTextureUavDescriptorSetLayout, VK_NULL_HANDLE);
-        effectContext.bindlessTextureUavDescriptorSetLayout = VK_NULL_HANDLE;
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool                 = effectContext.asyncCommandPool;
+        allocInfo.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount          = FFX_MAX_QUEUED_FRAMES;
+
+        res = backendContext->vkFunctionTable.vkAllocateCommandBuffers(backendContext->device, &allocInfo, effectContext.asyncCommandBuffers);
     }
 
-    if (effectContext.bindlessBufferUavDescriptorSetLayout)
+    // the fences start signalled, as no command buffer is in flight yet
+    VkFenceCreateInfo fenceCreateInfo = {};
+    fenceCreateInfo.sType             = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.flags             = VK_FENCE_CREATE_SIGNALED_BIT;
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES && res == VK_SUCCESS; ++frameIndex)
+        res = backendContext->vkFunctionTable.vkCreateFence(backendContext->device, &fenceCreateInfo, nullptr, &effectContext.asyncFences[frameIndex]);
+
+    if (res != VK_SUCCESS)
     {
-        backendContext->vkFunctionTable.vkFreeDescriptorSets(
-            backendContext->device, effectContext.bindlessDescriptorPool, 1, &effectContext.bindlessBufferUavDescriptorSet);
-        backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(
-            backendContext->device, effectContext.bindlessBufferUavDescriptorSetLayout, VK_NULL_HANDLE);
-        effectContext.bindlessBufferUavDescriptorSetLayout = VK_NULL_HANDLE;
+        destroyAsyncGpuJobResources(backendContext, effectContextId);
+        return FFX_ERROR_BACKEND_API_ERROR;
     }
 
-    if (effectContext.bindlessDescriptorPool)
+    effectContext.asyncQueueFamilyIndex = queueFamilyIndex;
+    effectContext.asyncFrameIndex       = 0;
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    FFX_ASSERT(backendContext->refCount > 0);
+
+    // Delete any resources allocated by this context
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    for (uint32_t currentStaticResourceIndex = effectContextId * FFX_MAX_RESOURCE_COUNT; currentStaticResourceIndex < effectContext.nextStaticResource;
+         ++currentStaticResourceIndex)
     {
-        backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, effectContext.bindlessDescriptorPool, VK_NULL_HANDLE);
-        effectContext.bindlessTextureSrvDescriptorSetLayout = VK_NULL_HANDLE;
+        // Persistent slots only hold the views of application resources
+        if (backendContext->pResources[currentStaticResourceIndex].persistent)
+        {
+            releasePersistentResource(backendContext, &backendContext->pResources[currentStaticResourceIndex]);
+            backendContext->pResources[currentStaticResourceIndex].persistent = false;
+        }
+        else if (backendContext->pResources[currentStaticResourceIndex].imageResource != VK_NULL_HANDLE)
+        {
+            FFX_ASSERT_MESSAGE(false,
+                               "FFXInterface: Vulkan: SDK Resource was not destroyed prior to destroying the backend context. There is a resource leak.");
+            FfxResourceInternal internalResource = {static_cast<int32_t>(currentStaticResourceIndex)};
+            DestroyResourceVK(backendInterface, internalResource, effectContextId);
+        }
     }
 
+    destroyRecordedGpuJobResources(backendContext, effectContextId);
+    destroyAsyncGpuJobResources(backendContext, effectContextId);
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
+        destroyDynamicViews(backendContext, effectContextId, frameIndex, true);
+
+    // clean up descriptor set layouts, the bindless descriptor sets are freed along with their pool
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, effectContext.bindlessTextureSrvDescriptorSetLayout);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, effectContext.bindlessBufferSrvDescriptorSetLayout);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, effectContext.bindlessTextureUavDescriptorSetLayout);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, effectContext.bindlessBufferUavDescriptorSetLayout);
+    deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_POOL, effectContext.bindlessDescriptorPool);
+    effectContext.bindlessTextureSrvDescriptorSetLayout = VK_NULL_HANDLE;
+    effectContext.bindlessBufferSrvDescriptorSetLayout  = VK_NULL_HANDLE;
+    effectContext.bindlessTextureUavDescriptorSetLayout = VK_NULL_HANDLE;
+    effectContext.bindlessBufferUavDescriptorSetLayout  = VK_NULL_HANDLE;
+    effectContext.bindlessDescriptorPool                = VK_NULL_HANDLE;
+
     // Free up for use by another context
     effectContext.nextStaticResource = 0;
     effectContext.active             = false;
@@ -2716,14 +3455,39 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
 
     if (!backendContext->refCount)
     {
-        // clean up descriptor pool
-        backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, backendContext->descriptorPool, VK_NULL_HANDLE);
+        // clean up descriptor pool. Destroying it frees the descriptor sets still queued, and the pipeline mutex
+        // guarding their pool goes away with the scratch memory, so drop them from the queue.
+        {
+            std::lock_guard<std::mutex>  lock{sDeferredDestructionMutex};
+            DeferredDestructionQueue_VK& queue = sDeferredDestructionQueues[backendContext->device];
+            for (DeferredDestruction_VK& object : queue.objects)
+            {
+                if (object.objectType == VK_OBJECT_TYPE_DESCRIPTOR_SET && object.descriptorPool == backendContext->descriptorPool)
+                    object.poolMutex = nullptr;
+            }
+        }
+        deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_POOL, backendContext->descriptorPool);
         backendContext->descriptorPool = VK_NULL_HANDLE;
 
+        // the GPU never uses the pipeline cache, so it can go right away
+        backendContext->vkFunctionTable.vkDestroyPipelineCache(backendContext->device, backendContext->pipelineCache, nullptr);
+        backendContext->pipelineCache = VK_NULL_HANDLE;
+
         // clean up dynamic uniform buffer & memory
         backendContext->vkFunctionTable.vkUnmapMemory(backendContext->device, backendContext->uniformBufferMemory);
-        backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, backendContext->uniformBufferMemory, VK_NULL_HANDLE);
-        backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, backendContext->uniformBuffer, VK_NULL_HANDLE);
+        deferDestruction(backendContext, VK_OBJECT_TYPE_BUFFER, backendContext->uniformBuffer);
+        deferDestruction(backendContext, VK_OBJECT_TYPE_DEVICE_MEMORY, backendContext->uniformBufferMemory);
+
+        // the last backend context of the device takes the queue with it, nothing may be in flight on the GPU by then
+        {
+            std::lock_guard<std::mutex> lock{sDeferredDestructionMutex};
+            auto                        it = sDeferredDestructionQueues.find(backendContext->device);
+            if (it != sDeferredDestructionQueues.end() && --it->second.backendContextCount == 0)
+            {
+                processDeferredDestructions(backendContext->device, it->second, true);
+                sDeferredDestructionQueues.erase(it);
+            }
+        }
 
         backendContext->device         = VK_NULL_HANDLE;
         backendContext->physicalDevice = VK_NULL_HANDLE;
@@ -2734,6 +3498,51 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
     return FFX_OK;
 }
 
+FfxErrorCode GetPipelineCacheDataVK(FfxInterface* backendInterface, void* outData, size_t* inOutDataSize)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != inOutDataSize);
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    FFX_RETURN_ON_ERROR(backendContext->pipelineCache != VK_NULL_HANDLE, FFX_ERROR_BACKEND_API_ERROR);
+
+    const VkResult result =
+        backendContext->vkFunctionTable.vkGetPipelineCacheData(backendContext->device, backendContext->pipelineCache, inOutDataSize, outData);
+    FFX_RETURN_ON_ERROR(result != VK_INCOMPLETE, FFX_ERROR_INSUFFICIENT_MEMORY);
+    FFX_RETURN_ON_ERROR(result == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+
+    return FFX_OK;
+}
+
+FfxErrorCode MergePipelineCacheDataVK(FfxInterface* backendInterface, const void* data, size_t dataSize)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    FFX_RETURN_ON_ERROR(backendContext->pipelineCache != VK_NULL_HANDLE, FFX_ERROR_BACKEND_API_ERROR);
+    FFX_RETURN_ON_ERROR(data != nullptr || dataSize == 0, FFX_ERROR_INVALID_POINTER);
+
+    // The driver ignores data written by another device or driver version, the cache then just starts out empty
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
+    pipelineCacheCreateInfo.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize           = dataSize;
+    pipelineCacheCreateInfo.pInitialData              = data;
+
+    VkPipelineCache loadedCache = VK_NULL_HANDLE;
+    FFX_RETURN_ON_ERROR(
+        backendContext->vkFunctionTable.vkCreatePipelineCache(backendContext->device, &pipelineCacheCreateInfo, nullptr, &loadedCache) == VK_SUCCESS,
+        FFX_ERROR_BACKEND_API_ERROR);
+
+    // Merging writes the cache of the backend context, which the other effect contexts may merge into as well
+    VkResult result = VK_SUCCESS;
+    {
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        result = backendContext->vkFunctionTable.vkMergePipelineCaches(backendContext->device, backendContext->pipelineCache, 1, &loadedCache);
+    }
+    backendContext->vkFunctionTable.vkDestroyPipelineCache(backendContext->device, loadedCache, nullptr);
+    FFX_RETURN_ON_ERROR(result == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+
+    return FFX_OK;
+}
+
 static bool validateTensorSurfaceFormat(FfxInterface* backendInterface, FfxSurfaceFormat format)
 {
     BackendContext_VK*         backendContext           = (BackendContext_VK*)backendInterface->scratchBuffer;
@@ -2751,6 +3560,7 @@ static bool validateTensorSurfaceFormat(FfxInterface* backendInterface, FfxSurfa
         case FFX_SURFACE_FORMAT_R8_UINT:
         case FFX_SURFACE_FORMAT_R8_SINT:
         case FFX_SURFACE_FORMAT_R16_UINT:
+        case FFX_SURFACE_FORMAT_R16_FLOAT:
             res = true;
             break;
         default:
@@ -2772,6 +3582,7 @@ FfxErrorCode CreateTensorResourceVK(FfxInterface*                       backendI
     VkDevice                          device         = backendContext->device;
 
     FFX_ASSERT(VK_NULL_HANDLE != device);
+    ++effectContext.resourceGeneration;
 
     // Setup the resource description
     FfxResourceDescription resourceDesc = createResourceDescription->resourceDescription;
@@ -2782,6 +3593,7 @@ FfxErrorCode CreateTensorResourceVK(FfxInterface*                       backendI
     BackendContext_VK::Resource* backendResource = &backendContext->pResources[outResource->internalIndex];
     backendResource->undefined           = true;   // A flag to make sure the first barrier for this image resource always uses an src layout of undefined
     backendResource->dynamic             = false;  // Not a dynamic resource (need to track them separately for image views)
+    backendResource->persistent          = false;
     backendResource->resourceDescription = resourceDesc;
     backendResource->allocationSize      = 0;
 
@@ -2962,7 +3774,7 @@ FfxErrorCode CreateTensorResourceVK(FfxInterface*                       backendI
                                                             backendResource->tensorResource,
                                                             ffxGetVkFormatFromSurfaceFormat(createResourceDescription->resourceDescription.format)};
 
-    FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < effectContext.nextDynamicResourceView[0],
+    FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < getDynamicResourceViewsEndIndex(effectContext),
                        "ffxInterface: Vulkan: We've run out of resource views. Please increase the size.");
     backendResource->tensorViewIndex = effectContext.nextStaticResourceView++;
 
@@ -2975,7 +3787,7 @@ FfxErrorCode CreateTensorResourceVK(FfxInterface*                       backendI
     if (imageAliased)
     {
         // copied straight from the create resource vk function
-        FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < effectContext.nextDynamicResourceView[0],
+        FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < getDynamicResourceViewsEndIndex(effectContext),
                            "FFXInterface: Vulkan: We've run out of resource views. Please increase the size.");
         backendResource->srvViewIndex = effectContext.nextStaticResourceView++;
 
@@ -3038,7 +3850,7 @@ FfxErrorCode CreateTensorResourceVK(FfxInterface*                       backendI
         if (FFX_CONTAINS_FLAG(backendResource->resourceDescription.usage, FFX_RESOURCE_USAGE_UAV))
         {
             const int32_t uavResourceViewCount = backendResource->resourceDescription.mipCount;
-            FFX_ASSERT(effectContext.nextStaticResourceView + uavResourceViewCount < effectContext.nextDynamicResourceView[0]);
+            FFX_ASSERT(effectContext.nextStaticResourceView + uavResourceViewCount < getDynamicResourceViewsEndIndex(effectContext));
 
             backendResource->uavViewIndex = effectContext.nextStaticResourceView;
             backendResource->uavViewCount = uavResourceViewCount;
@@ -3095,6 +3907,7 @@ FfxErrorCode CreateResourceVK(FfxInterface*                       backendInterfa
     VkDevice                          vkDevice       = backendContext->device;
 
     FFX_ASSERT(VK_NULL_HANDLE != vkDevice);
+    ++effectContext.resourceGeneration;
 
     VkMemoryPropertyFlags requiredMemoryProperties;
 
@@ -3127,6 +3940,7 @@ FfxErrorCode CreateResourceVK(FfxInterface*                       backendInterfa
     BackendContext_VK::Resource* backendResource = &backendContext->pResources[outResource->internalIndex];
     backendResource->undefined           = true;   // A flag to make sure the first barrier for this image resource always uses an src layout of undefined
     backendResource->dynamic             = false;  // Not a dynamic resource (need to track them separately for image views)
+    backendResource->persistent          = false;
     backendResource->resourceDescription = resourceDesc;
     backendResource->allocationSize      = 0;
 
@@ -3303,7 +4117,7 @@ FfxErrorCode CreateResourceVK(FfxInterface*                       backendInterfa
     case FFX_RESOURCE_TYPE_TEXTURE_CUBE:
     case FFX_RESOURCE_TYPE_TEXTURE3D:
     {
-        FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < effectContext.nextDynamicResourceView[0],
+        FFX_ASSERT_MESSAGE(effectContext.nextStaticResourceView + 1 < getDynamicResourceViewsEndIndex(effectContext),
                            "FFXInterface: Vulkan: We've run out of resource views. Please increase the size.");
         backendResource->srvViewIndex = effectContext.nextStaticResourceView++;
 
@@ -3367,7 +4181,7 @@ FfxErrorCode CreateResourceVK(FfxInterface*                       backendInterfa
         if (FFX_CONTAINS_FLAG(backendResource->resourceDescription.usage, FFX_RESOURCE_USAGE_UAV))
         {
             const int32_t uavResourceViewCount = backendResource->resourceDescription.mipCount;
-            FFX_ASSERT(effectContext.nextStaticResourceView + uavResourceViewCount < effectContext.nextDynamicResourceView[0]);
+            FFX_ASSERT(effectContext.nextStaticResourceView + uavResourceViewCount < getDynamicResourceViewsEndIndex(effectContext));
 
             backendResource->uavViewIndex = effectContext.nextStaticResourceView;
             backendResource->uavViewCount = uavResourceViewCount;
@@ -3426,7 +4240,7 @@ FfxErrorCode CreateResourceVK(FfxInterface*                       backendInterfa
         copyJob.copyJobDescriptor.dstOffset = 0;
         copyJob.copyJobDescriptor.size      = 0;
 
-        backendInterface->fpScheduleGpuJob(backendInterface, &copyJob);
+        backendInterface->fpScheduleGpuJob(backendInterface, &copyJob, effectContextId);
     }
 
     backendResource->allocationSize = memRequirements.size;
@@ -3448,13 +4262,14 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
     if ((resource.internalIndex >= int32_t(effectContextId * FFX_MAX_RESOURCE_COUNT)) && (resource.internalIndex < int32_t(effectContext.nextStaticResource)))
     {
         BackendContext_VK::Resource& backgroundResource = backendContext->pResources[resource.internalIndex];
+        ++effectContext.resourceGeneration;
 
         if (backgroundResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
         {
             // Destroy the resource
             if (backgroundResource.bufferResource != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, backgroundResource.bufferResource, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_BUFFER, backgroundResource.bufferResource);
                 backgroundResource.bufferResource = VK_NULL_HANDLE;
             }
         }
@@ -3463,15 +4278,14 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
             // Destroy tensor view
             if (backendContext->pResourceViews[backgroundResource.tensorViewIndex].tensorView != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyTensorViewARM(
-                    backendContext->device, backendContext->pResourceViews[backgroundResource.tensorViewIndex].tensorView, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_TENSOR_VIEW_ARM, backendContext->pResourceViews[backgroundResource.tensorViewIndex].tensorView);
                 backendContext->pResourceViews[backgroundResource.tensorViewIndex].tensorView = VK_NULL_HANDLE;
                 backgroundResource.tensorViewIndex                                            = -1;
             }
             // Destroy the tensor
             if (backgroundResource.tensorResource != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyTensorARM(backendContext->device, backgroundResource.tensorResource, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_TENSOR_ARM, backgroundResource.tensorResource);
                 backgroundResource.tensorResource = VK_NULL_HANDLE;
             }
 
@@ -3481,8 +4295,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
                 // Destroy SRV
                 if (backgroundResource.srvViewIndex >= 0)
                 {
-                    backendContext->vkFunctionTable.vkDestroyImageView(
-                        backendContext->device, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView, nullptr);
+                    deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView);
                     backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView = VK_NULL_HANDLE;
                     backgroundResource.srvViewIndex                                           = 0;
                 }
@@ -3494,8 +4307,8 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
                     {
                         if (backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView != VK_NULL_HANDLE)
                         {
-                            backendContext->vkFunctionTable.vkDestroyImageView(
-                                backendContext->device, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView, nullptr);
+                            deferDestruction(
+                                backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView);
                             backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView = VK_NULL_HANDLE;
                         }
                     }
@@ -3505,7 +4318,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
                 backgroundResource.uavViewIndex = backgroundResource.srvViewIndex = -1;
                 backgroundResource.uavViewCount                                   = 0;
 
-                backendContext->vkFunctionTable.vkDestroyImage(backendContext->device, backgroundResource.aliasedTensorImageResource, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE, backgroundResource.aliasedTensorImageResource);
                 backgroundResource.aliasedTensorImageResource = VK_NULL_HANDLE;
             }
         }
@@ -3514,8 +4327,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
             // Destroy SRV
             if (backgroundResource.srvViewIndex >= 0)
             {
-                backendContext->vkFunctionTable.vkDestroyImageView(
-                    backendContext->device, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView);
                 backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView = VK_NULL_HANDLE;
                 backgroundResource.srvViewIndex                                           = 0;
             }
@@ -3527,8 +4339,8 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
                 {
                     if (backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView != VK_NULL_HANDLE)
                     {
-                        backendContext->vkFunctionTable.vkDestroyImageView(
-                            backendContext->device, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView, nullptr);
+                        deferDestruction(
+                            backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView);
                         backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView = VK_NULL_HANDLE;
                     }
                 }
@@ -3541,14 +4353,14 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
             // Destroy the resource
             if (backgroundResource.imageResource != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyImage(backendContext->device, backgroundResource.imageResource, nullptr);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE, backgroundResource.imageResource);
                 backgroundResource.imageResource = VK_NULL_HANDLE;
             }
         }
 
         if (backgroundResource.deviceMemory)
         {
-            backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, backgroundResource.deviceMemory, nullptr);
+            deferDestruction(backendContext, VK_OBJECT_TYPE_DEVICE_MEMORY, backgroundResource.deviceMemory);
             backgroundResource.deviceMemory = VK_NULL_HANDLE;
 
             effectContext.vramUsage.totalUsageInBytes -= static_cast<uint64_t>(backgroundResource.allocationSize);
@@ -3590,6 +4402,30 @@ FfxErrorCode UnmapResourceVK(FfxInterface* backendInterface, FfxResourceInternal
     return FFX_OK;
 }
 
+// A slot registered with the same resource, description and state as last frame leaves the recordings valid
+static void updateRegistrationKey(BackendContext_VK::EffectContext& effectContext, BackendContext_VK::Resource* backendResource, void* resource)
+{
+    struct
+    {
+        void*                  resource;
+        FfxResourceDescription description;
+        FfxResourceStates      state;
+        bool                   undefined;
+    } registrationKey;
+    memset(&registrationKey, 0, sizeof(registrationKey));
+    registrationKey.resource    = resource;
+    registrationKey.description = backendResource->resourceDescription;
+    registrationKey.state       = backendResource->initialState;
+    registrationKey.undefined   = backendResource->undefined;
+
+    const uint64_t registrationHash = arm::computeHash(&registrationKey, sizeof(registrationKey));
+    if (backendResource->registrationKey != registrationHash)
+    {
+        backendResource->registrationKey = registrationHash;
+        ++effectContext.resourceGeneration;
+    }
+}
+
 FfxErrorCode RegisterResourceVK(FfxInterface*        backendInterface,
                                 const FfxResource*   inFfxResource,
                                 FfxUInt32            effectContextId,
@@ -3663,6 +4499,7 @@ FfxErrorCode RegisterResourceVK(FfxInterface*        backendInterface,
         backendResource->imageResource = reinterpret_cast<VkImage>(inFfxResource->resource);
 
     copyResourceState(backendResource, inFfxResource);
+    updateRegistrationKey(effectContext, backendResource, inFfxResource->resource);
 
 #ifdef _DEBUG
     size_t retval = 0;
@@ -3732,8 +4569,8 @@ FfxErrorCode RegisterResourceVK(FfxInterface*        backendInterface,
         VkImageViewUsageCreateInfo imageViewUsageCreateInfo = {};
         addMutableViewForSRV(imageViewCreateInfo, imageViewUsageCreateInfo, backendResource->resourceDescription);
 
-        if (backendContext->vkFunctionTable.vkCreateImageView(
-                backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->srvViewIndex].imageView) != VK_SUCCESS)
+        if (acquireDynamicImageView(
+                backendContext, effectContextId, backendResource->srvViewIndex, imageViewCreateInfo, backendResource->resourceDescription) != VK_SUCCESS)
         {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
@@ -3764,9 +4601,11 @@ FfxErrorCode RegisterResourceVK(FfxInterface*        backendInterface,
                 imageViewCreateInfo.subresourceRange.levelCount   = 1;
                 imageViewCreateInfo.subresourceRange.baseMipLevel = mip;
 
-                if (backendContext->vkFunctionTable.vkCreateImageView(
-                        backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->uavViewIndex + mip].imageView) !=
-                    VK_SUCCESS)
+                if (acquireDynamicImageView(backendContext,
+                                            effectContextId,
+                                            backendResource->uavViewIndex + mip,
+                                            imageViewCreateInfo,
+                                            backendResource->resourceDescription) != VK_SUCCESS)
                 {
                     return FFX_ERROR_BACKEND_API_ERROR;
                 }
@@ -3790,6 +4629,194 @@ FfxErrorCode RegisterResourceVK(FfxInterface*        backendInterface,
     return FFX_OK;
 }
 
+// Creates the views of an image registered into a persistent slot. They come from the static range, a slot only takes
+// a new range when its image needs more views than the one it held before.
+static FfxErrorCode createPersistentImageViews(BackendContext_VK* backendContext, FfxUInt32 effectContextId, BackendContext_VK::Resource* backendResource)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    const FfxResourceDescription&     description   = backendResource->resourceDescription;
+
+    const uint32_t uavViewCount = FFX_CONTAINS_FLAG(description.usage, FFX_RESOURCE_USAGE_UAV) ? description.mipCount : 0;
+    if (backendResource->persistentViewCount < 1 + uavViewCount)
+    {
+        FFX_RETURN_ON_ERROR(effectContext.nextStaticResourceView + 1 + uavViewCount < getDynamicResourceViewsEndIndex(effectContext), FFX_ERROR_OUT_OF_MEMORY);
+        backendResource->persistentViewIndex = effectContext.nextStaticResourceView;
+        backendResource->persistentViewCount = 1 + uavViewCount;
+        effectContext.nextStaticResourceView += 1 + uavViewCount;
+    }
+
+    VkImageViewCreateInfo imageViewCreateInfo = {};
+    imageViewCreateInfo.sType                 = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    imageViewCreateInfo.pNext                 = nullptr;
+
+    bool requestArrayView = FFX_CONTAINS_FLAG(description.usage, FFX_RESOURCE_USAGE_ARRAYVIEW);
+
+    switch (description.type)
+    {
+    case FFX_RESOURCE_TYPE_TEXTURE1D:
+        imageViewCreateInfo.viewType = (description.depth > 1 || requestArrayView) ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
+        break;
+    default:
+    case FFX_RESOURCE_TYPE_TEXTURE2D:
+        imageViewCreateInfo.viewType = (description.depth > 1 || requestArrayView) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        break;
+    case FFX_RESOURCE_TYPE_TEXTURE_CUBE:
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+        break;
+    case FFX_RESOURCE_TYPE_TEXTURE3D:
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_3D;
+        break;
+    }
+
+    imageViewCreateInfo.image                           = backendResource->imageResource;
+    imageViewCreateInfo.format                          = getVkFormatFromSurfaceFormatAndUsage(description.format, description.usage);
+    imageViewCreateInfo.components.r                    = VK_COMPONENT_SWIZZLE_IDENTITY;
+    imageViewCreateInfo.components.g                    = VK_COMPONENT_SWIZZLE_IDENTITY;
+    imageViewCreateInfo.components.b                    = VK_COMPONENT_SWIZZLE_IDENTITY;
+    imageViewCreateInfo.components.a                    = VK_COMPONENT_SWIZZLE_IDENTITY;
+    imageViewCreateInfo.subresourceRange.aspectMask     = getImageAspect(description.usage);
+    imageViewCreateInfo.subresourceRange.baseMipLevel   = 0;
+    imageViewCreateInfo.subresourceRange.levelCount     = description.mipCount;
+    imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+    imageViewCreateInfo.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+
+    // create an image view containing all mip levels for use as an srv
+    VkImageViewUsageCreateInfo imageViewUsageCreateInfo = {};
+    addMutableViewForSRV(imageViewCreateInfo, imageViewUsageCreateInfo, description);
+
+    backendResource->srvViewIndex = backendResource->persistentViewIndex;
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkCreateImageView(
+                            backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->srvViewIndex].imageView) ==
+                            VK_SUCCESS,
+                        FFX_ERROR_BACKEND_API_ERROR);
+
+    // create image views of individual mip levels for use as a uav
+    if (uavViewCount > 0)
+    {
+        backendResource->uavViewIndex = backendResource->persistentViewIndex + 1;
+        backendResource->uavViewCount = uavViewCount;
+
+        imageViewCreateInfo.format = getVkFormatFromSurfaceFormatAndUsage(description.format, description.usage);
+        imageViewCreateInfo.pNext  = nullptr;
+
+        for (uint32_t mip = 0; mip < uavViewCount; ++mip)
+        {
+            imageViewCreateInfo.subresourceRange.levelCount   = 1;
+            imageViewCreateInfo.subresourceRange.baseMipLevel = mip;
+
+            FFX_RETURN_ON_ERROR(
+                backendContext->vkFunctionTable.vkCreateImageView(
+                    backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->uavViewIndex + mip].imageView) ==
+                    VK_SUCCESS,
+                FFX_ERROR_BACKEND_API_ERROR);
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode RegisterPersistentResourceVK(FfxInterface*        backendInterface,
+                                          const FfxResource*   inFfxResource,
+                                          FfxUInt32            effectContextId,
+                                          FfxResourceInternal* inOutFfxResourceInternal)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_VK*                backendContext = (BackendContext_VK*)(backendInterface->scratchBuffer);
+    BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+
+    const int32_t firstStaticResource = int32_t(effectContextId * FFX_MAX_RESOURCE_COUNT) + 1;
+    int32_t       resourceIndex       = inOutFfxResourceInternal->internalIndex;
+    FFX_RETURN_ON_ERROR(resourceIndex == 0 || (resourceIndex >= firstStaticResource && resourceIndex < int32_t(effectContext.nextStaticResource) &&
+                                               backendContext->pResources[resourceIndex].persistent),
+                        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(inFfxResource->resource == nullptr || inFfxResource->description.type != FFX_RESOURCE_TYPE_TENSOR, FFX_ERROR_INVALID_ARGUMENT);
+
+    // The undefined flag only applies to the jobs being scheduled, it doesn't make a different resource
+    FfxResourceDescription description = inFfxResource->description;
+    description.flags                  = (FfxResourceFlags)((int)description.flags & ~FFX_RESOURCE_FLAGS_UNDEFINED);
+
+    if (resourceIndex != 0)
+    {
+        BackendContext_VK::Resource* backendResource = &backendContext->pResources[resourceIndex];
+        if (backendResource->imageResource != reinterpret_cast<VkImage>(inFfxResource->resource) ||
+            memcmp(&backendResource->resourceDescription, &description, sizeof(description)) != 0)
+        {
+            releasePersistentResource(backendContext, backendResource);
+            ++effectContext.resourceGeneration;
+        }
+    }
+
+    // A released slot is taken again by the next registration
+    if (inFfxResource->resource == nullptr)
+    {
+        inOutFfxResourceInternal->internalIndex = 0;
+        return FFX_OK;
+    }
+
+    if (resourceIndex == 0)
+    {
+        for (int32_t index = firstStaticResource; index < int32_t(effectContext.nextStaticResource) && resourceIndex == 0; ++index)
+        {
+            if (backendContext->pResources[index].persistent && backendContext->pResources[index].imageResource == VK_NULL_HANDLE)
+                resourceIndex = index;
+        }
+
+        if (resourceIndex == 0)
+        {
+            FFX_RETURN_ON_ERROR(effectContext.nextStaticResource + 1 < effectContext.nextDynamicResource, FFX_ERROR_OUT_OF_MEMORY);
+            resourceIndex = effectContext.nextStaticResource++;
+
+            BackendContext_VK::Resource* backendResource = &backendContext->pResources[resourceIndex];
+            backendResource->persistent                  = true;
+            backendResource->persistentViewIndex         = -1;
+            backendResource->persistentViewCount         = 0;
+            backendResource->imageResource               = VK_NULL_HANDLE;
+            backendResource->registrationKey             = 0;
+        }
+    }
+
+    BackendContext_VK::Resource* backendResource = &backendContext->pResources[resourceIndex];
+    if (backendResource->imageResource == VK_NULL_HANDLE)
+    {
+        backendResource->resourceDescription = description;
+        if (description.type == FFX_RESOURCE_TYPE_BUFFER)
+            backendResource->bufferResource = reinterpret_cast<VkBuffer>(inFfxResource->resource);
+        else
+            backendResource->imageResource = reinterpret_cast<VkImage>(inFfxResource->resource);
+
+#ifdef _DEBUG
+        size_t retval = 0;
+        wcstombs_s(&retval, backendResource->resourceName, sizeof(backendResource->resourceName), inFfxResource->name, sizeof(backendResource->resourceName));
+        if (retval >= 64)
+            backendResource->resourceName[63] = '\0';
+#endif
+
+        if (description.type != FFX_RESOURCE_TYPE_BUFFER)
+        {
+            const FfxErrorCode errorCode = createPersistentImageViews(backendContext, effectContextId, backendResource);
+            if (errorCode != FFX_OK)
+            {
+                releasePersistentResource(backendContext, backendResource);
+                return errorCode;
+            }
+        }
+    }
+
+    // The state, and whether the contents are undefined, are those of the jobs being scheduled
+    backendResource->resourceDescription.flags = inFfxResource->description.flags;
+    copyResourceState(backendResource, inFfxResource);
+    updateRegistrationKey(effectContext, backendResource, inFfxResource->resource);
+
+    bool listed = false;
+    for (uint32_t i = 0; i < effectContext.persistentResourceCount && !listed; ++i)
+        listed = effectContext.persistentResources[i] == uint32_t(resourceIndex);
+    if (!listed)
+        effectContext.persistentResources[effectContext.persistentResourceCount++] = resourceIndex;
+
+    inOutFfxResourceInternal->internalIndex = resourceIndex;
+    return FFX_OK;
+}
+
 FfxResource GetResourceVK(FfxInterface* backendInterface, FfxResourceInternal inResource)
 {
     FFX_ASSERT(nullptr != backendInterface);
@@ -3826,8 +4853,9 @@ FfxResource GetResourceVK(FfxInterface* backendInterface, FfxResourceInternal in
 FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
 {
     FFX_ASSERT(NULL != backendInterface);
-    BackendContext_VK*                backendContext = (BackendContext_VK*)(backendInterface->scratchBuffer);
-    BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK*                 backendContext = (BackendContext_VK*)(backendInterface->scratchBuffer);
+    BackendContext_VK::EffectContext&  effectContext  = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK::RecordingState& recordingState = effectContext.recordingState;
 
     // Walk back all the resources that don't belong to us and reset them to their initial state
     const uint32_t dynamicResourceIndexStart = getDynamicResourcesStartIndex(effectContextId);
@@ -3844,22 +4872,67 @@ FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandLis
         backendResource->tensorViewIndex = -1;
 
         // Add the barrier
-        addBarrier(backendContext, &internalResource, backendResource->initialState);
+        addBarrier(backendContext, recordingState, &internalResource, backendResource->finalState);
+    }
+
+    // The persistent resources registered for the jobs are walked back the same way, but keep their views
+    for (uint32_t i = 0; i < effectContext.persistentResourceCount; ++i)
+    {
+        FfxResourceInternal internalResource;
+        internalResource.internalIndex = effectContext.persistentResources[i];
+
+        addBarrier(backendContext, recordingState, &internalResource, backendContext->pResources[internalResource.internalIndex].finalState);
     }
+    effectContext.persistentResourceCount = 0;
 
     FFX_ASSERT(nullptr != commandList);
     VkCommandBuffer pCmdList = reinterpret_cast<VkCommandBuffer>(commandList);
 
-    flushBarriers(backendContext, pCmdList);
+    flushBarriers(backendContext, recordingState, pCmdList);
 
     // Just reset the dynamic resource index, but leave the images views.
     // They will be deleted in the first pipeline destroy call as they need to live until then
     effectContext.nextDynamicResource = dynamicResourceIndexStart;
 
-    // destroy the views of the next frame
+    // destroy the views of the next frame, or keep them around to be matched against the next frame's resources
     effectContext.frameIndex = (effectContext.frameIndex + 1) % FFX_MAX_QUEUED_FRAMES;
-    destroyDynamicViews(backendContext, effectContextId, effectContext.frameIndex);
+    if (effectContext.retainDynamicViews)
+    {
+        const uint32_t frameIndex = effectContext.frameIndex;
+        effectContext.retainedDynamicResourceView[frameIndex] =
+            FFX_MINIMUM(effectContext.retainedDynamicResourceView[frameIndex], effectContext.nextDynamicResourceView[frameIndex]);
+        effectContext.nextDynamicResourceView[frameIndex] = getDynamicResourceViewsStartIndex(effectContextId, frameIndex);
+    }
+    else
+    {
+        destroyDynamicViews(backendContext, effectContextId, effectContext.frameIndex, false);
+    }
+
+    // several effect contexts may dispatch each frame, so the device counts the frames of the context furthest ahead
+    {
+        std::lock_guard<std::mutex>  lock{sDeferredDestructionMutex};
+        DeferredDestructionQueue_VK& queue = sDeferredDestructionQueues[backendContext->device];
+        queue.frameCount                   = FFX_MAXIMUM(queue.frameCount, ++effectContext.frameCount);
+        processDeferredDestructions(backendContext->device, queue, false);
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode SetResourceFinalStateVK(FfxInterface* backendInterface, FfxResourceInternal resource, FfxResourceStates finalState, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    BackendContext_VK*                backendContext = (BackendContext_VK*)(backendInterface->scratchBuffer);
+    BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
 
+    // Only resources registered for the current dispatch are walked back by UnregisterResourcesVK()
+    bool registered = resource.internalIndex > int32_t(effectContext.nextDynamicResource) &&
+                      resource.internalIndex <= int32_t(getDynamicResourcesStartIndex(effectContextId));
+    for (uint32_t i = 0; i < effectContext.persistentResourceCount && !registered; ++i)
+        registered = effectContext.persistentResources[i] == uint32_t(resource.internalIndex);
+    FFX_RETURN_ON_ERROR(registered, FFX_ERROR_INVALID_ARGUMENT);
+
+    backendContext->pResources[resource.internalIndex].finalState = finalState;
     return FFX_OK;
 }
 
@@ -4219,7 +5292,10 @@ FfxErrorCode StageConstantBufferDataVK(FfxInterface* backendInterface, void* dat
 
     if (data && constantBuffer)
     {
-        if ((backendContext->stagingRingBufferBase + FFX_ALIGN_UP(size, 256)) >= FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE)
+        // Effect contexts may stage their constants concurrently, so they share the ring buffers of all contexts under a lock
+        std::lock_guard<std::mutex> lock{backendContext->stagingRingBufferMutex};
+
+        if ((backendContext->stagingRingBufferBase + FFX_ALIGN_UP(size, 256)) >= backendContext->maxEffectContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE)
             backendContext->stagingRingBufferBase = 0;
 
         uint32_t* dstPtr = (uint32_t*)(backendContext->pStagingRingBuffer + backendContext->stagingRingBufferBase);
@@ -4258,6 +5334,32 @@ VkSamplerAddressMode FfxGetAddressModeVK(const FfxAddressMode& addressMode)
     }
 }
 
+// Returns a pipeline layout slot for the effect context, recycling slots released by DestroyPipelineVK
+// so that effects which rebuild pipelines at runtime don't run out of layouts. Returns nullptr when all
+// FFX_MAX_PASS_COUNT slots of the effect context are in use, which pipeline creation reports as an error.
+BackendContext_VK::PipelineLayout* acquirePipelineLayout(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    std::lock_guard<std::mutex>       lock{backendContext->pipelineMutex};
+
+    for (uint32_t layoutIndex = effectContextId * FFX_MAX_PASS_COUNT; layoutIndex < effectContext.nextPipelineLayout; ++layoutIndex)
+    {
+        BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[layoutIndex];
+        if (!pPipelineLayout->inUse)
+        {
+            *pPipelineLayout       = {};
+            pPipelineLayout->inUse = true;
+            return pPipelineLayout;
+        }
+    }
+
+    if (effectContext.nextPipelineLayout >= (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT)
+        return nullptr;
+    BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    pPipelineLayout->inUse                             = true;
+    return pPipelineLayout;
+}
+
 FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
                               FfxEffect                     effect,
                               FfxPass                       pass,
@@ -4272,17 +5374,22 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
     BackendContext_VK*                backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
     BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
 
-    // start by fetching the shader blob
-    FfxShaderBlob shaderBlob = {};
-    // WON'T WORK WITH FSR3!!
-    backendInterface->fpGetPermutationBlobByIndex(effect, pass, permutationOptions, &shaderBlob, nullptr, nullptr);
+    // start by fetching the shader blob, unless the effect provides its own
+    FfxShaderBlob shaderBlob = (pipelineDescription->shaderBlob != nullptr) ? *pipelineDescription->shaderBlob : FfxShaderBlob{};
+    if (pipelineDescription->shaderBlob == nullptr)
+    {
+        // WON'T WORK WITH FSR3!!
+        backendInterface->fpGetPermutationBlobByIndex(effect, pass, permutationOptions, &shaderBlob, nullptr, nullptr);
+    }
     FFX_ASSERT(shaderBlob.data && shaderBlob.size);
 
-    //////////////////////////////////////////////////////////////////////////
-    // One root signature (or pipeline layout) per pipeline
-    FFX_ASSERT_MESSAGE(effectContext.nextPipelineLayout < (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT,
-                       "FFXInterface: Vulkan: Ran out of pipeline layouts. Please increase FFX_MAX_PASS_COUNT");
-    BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    //////////////////////////////////////////////////////////////////////////
+    // One root signature (or pipeline layout) per pipeline. Pipelines dispatched more often a frame get a larger part
+    // of its descriptor set ring for each queued frame.
+    FFX_RETURN_ON_ERROR(pipelineDescription->dispatchesPerFrame <= MAX_PIPELINE_USAGE_PER_FRAME_LIMIT, FFX_ERROR_INVALID_ARGUMENT);
+    BackendContext_VK::PipelineLayout* pPipelineLayout = acquirePipelineLayout(backendContext, effectContextId);
+    FFX_RETURN_ON_ERROR(pPipelineLayout != nullptr, FFX_ERROR_OUT_OF_RANGE);
+    pPipelineLayout->descriptorSetsPerFrame = FFX_MAXIMUM(pipelineDescription->dispatchesPerFrame, MAX_PIPELINE_USAGE_PER_FRAME);
 
     // Start by creating samplers
     FFX_ASSERT(pipelineDescription->samplerCount <= FFX_MAX_SAMPLERS);
@@ -4429,8 +5536,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
             shaderBlob.boundUAVBuffers[uavIndex], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, shaderBlob.boundUAVBufferCounts[uavIndex], shaderStageFlags, nullptr};
     }
 
-    // Constant buffers (uniforms)
-    for (uint32_t cbIndex = 0; cbIndex < shaderBlob.cbvCount; ++cbIndex)
+    // Constant buffers (uniforms). A pipeline with push constants reads its constants from the push constant range instead.
+    const uint32_t constantBufferCount = (pipelineDescription->pushConstantSize > 0) ? 0 : shaderBlob.cbvCount;
+    for (uint32_t cbIndex = 0; cbIndex < constantBufferCount; ++cbIndex)
     {
         layoutBindings[numLayoutBindings++] = {shaderBlob.boundConstantBuffers[cbIndex],
                                                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
@@ -4467,17 +5575,21 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
 
     // allocate descriptor sets
     pPipelineLayout->descriptorSetIndex = 0;
-    for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME); i++)
     {
-        VkDescriptorSetAllocateInfo allocateInfo = {};
-        allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.descriptorPool              = backendContext->descriptorPool;
-        allocateInfo.descriptorSetCount          = 1;
-        allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
-
-        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) != VK_SUCCESS)
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * pPipelineLayout->descriptorSetsPerFrame); i++)
         {
-            return FFX_ERROR_BACKEND_API_ERROR;
+            VkDescriptorSetAllocateInfo allocateInfo = {};
+            allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool              = backendContext->descriptorPool;
+            allocateInfo.descriptorSetCount          = 1;
+            allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
+
+            if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) !=
+                VK_SUCCESS)
+            {
+                return FFX_ERROR_BACKEND_API_ERROR;
+            }
         }
     }
 
@@ -4511,13 +5623,18 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
         setCount++;
     }
 
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset              = 0;
+    pushConstantRange.size                = pipelineDescription->pushConstantSize;
+
     // create the pipeline layout
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount         = setCount;
     pipelineLayoutInfo.pSetLayouts            = layouts;
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
-    pipelineLayoutInfo.pPushConstantRanges    = nullptr;
+    pipelineLayoutInfo.pushConstantRangeCount = (pushConstantRange.size > 0) ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges    = (pushConstantRange.size > 0) ? &pushConstantRange : nullptr;
 
     if (backendContext->vkFunctionTable.vkCreatePipelineLayout(backendContext->device, &pipelineLayoutInfo, nullptr, &pPipelineLayout->pipelineLayout) !=
         VK_SUCCESS)
@@ -4668,15 +5785,16 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
         FFX_ASSERT(outPipeline->uavTensorCount < FFX_MAX_NUM_TENSORS);
     }
 
-    for (uint32_t cbIndex = 0; cbIndex < shaderBlob.cbvCount; ++cbIndex)
+    for (uint32_t cbIndex = 0; cbIndex < constantBufferCount; ++cbIndex)
     {
         outPipeline->constantBufferBindings[cbIndex].slotIndex  = shaderBlob.boundConstantBuffers[cbIndex];
         outPipeline->constantBufferBindings[cbIndex].arrayIndex = 1;
         ConvertUTF8ToUTF16(shaderBlob.boundConstantBufferNames[cbIndex], outPipeline->constantBufferBindings[cbIndex].name, FFX_RESOURCE_NAME_SIZE);
     }
 
-    outPipeline->constCount = shaderBlob.cbvCount;
+    outPipeline->constCount = constantBufferCount;
     FFX_ASSERT(outPipeline->constCount < FFX_MAX_NUM_CONST_BUFFERS);
+    outPipeline->pushConstantSize = pipelineDescription->pushConstantSize;
 
     outPipeline->staticTextureSrvCount = staticTextureSrvCount;
     FFX_ASSERT(outPipeline->staticTextureSrvCount <= effectContext.bindlessTextureSrvHeapSize);
@@ -4715,12 +5833,31 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
     VkPipelineShaderStageCreateInfo shaderStageCreateInfo = {};
     shaderStageCreateInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     shaderStageCreateInfo.stage                           = VK_SHADER_STAGE_COMPUTE_BIT;
-    shaderStageCreateInfo.pName                           = "main";
+    shaderStageCreateInfo.pName                           = pipelineDescription->entryPoint ? pipelineDescription->entryPoint : "main";
     shaderStageCreateInfo.module                          = shaderModule;
 
+    // specialization constants, each a 32bit value at constant_id = its index
+    std::vector<VkSpecializationMapEntry> specializationEntries(pipelineDescription->specializationConstantCount);
+    for (uint32_t i = 0; i < pipelineDescription->specializationConstantCount; ++i)
+    {
+        specializationEntries[i].constantID = i;
+        specializationEntries[i].offset     = i * sizeof(uint32_t);
+        specializationEntries[i].size       = sizeof(uint32_t);
+    }
+    VkSpecializationInfo specializationInfo = {};
+    specializationInfo.mapEntryCount        = pipelineDescription->specializationConstantCount;
+    specializationInfo.pMapEntries          = specializationEntries.data();
+    specializationInfo.dataSize             = pipelineDescription->specializationConstantCount * sizeof(uint32_t);
+    specializationInfo.pData                = pipelineDescription->specializationConstants;
+    if (pipelineDescription->specializationConstantCount > 0)
+    {
+        shaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
+    }
+
     // check if wave64 is requested
     bool isWave64 = false;
-    ffxIsWave64(effect, permutationOptions, isWave64);
+    if (pipelineDescription->shaderBlob == nullptr)
+        ffxIsWave64(effect, permutationOptions, isWave64);
     VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT subgroupSizeCreateInfo = {};
     if (isWave64 && (capabilities.waveLaneCountMin <= 64 && capabilities.waveLaneCountMax >= 64))
     {
@@ -4736,8 +5873,8 @@ FfxErrorCode CreatePipelineVK(FfxInterface*                 backendInterface,
     pipelineCreateInfo.layout                      = pPipelineLayout->pipelineLayout;
 
     VkPipeline computePipeline = VK_NULL_HANDLE;
-    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, nullptr, 1, &pipelineCreateInfo, nullptr, &computePipeline) !=
-        VK_SUCCESS)
+    if (backendContext->vkFunctionTable.vkCreateComputePipelines(
+            backendContext->device, backendContext->pipelineCache, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS)
     {
         return FFX_ERROR_BACKEND_API_ERROR;
     }
@@ -4778,9 +5915,9 @@ FfxErrorCode CreateGraphicsPipelineVK(FfxInterface*                 backendInter
 
     //////////////////////////////////////////////////////////////////////////
     // One root signature (or pipeline layout) per pipeline
-    FFX_ASSERT_MESSAGE(effectContext.nextPipelineLayout < (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT,
-                       "FFXInterface: Vulkan: Ran out of pipeline layouts. Please increase FFX_MAX_PASS_COUNT");
-    BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    BackendContext_VK::PipelineLayout* pPipelineLayout = acquirePipelineLayout(backendContext, effectContextId);
+    FFX_RETURN_ON_ERROR(pPipelineLayout != nullptr, FFX_ERROR_OUT_OF_RANGE);
+    pPipelineLayout->descriptorSetsPerFrame = MAX_PIPELINE_USAGE_PER_FRAME;
 
     // Start by creating samplers
     FFX_ASSERT(pipelineDescription->samplerCount <= FFX_MAX_SAMPLERS);
@@ -4965,17 +6102,21 @@ FfxErrorCode CreateGraphicsPipelineVK(FfxInterface*                 backendInter
 
     // allocate descriptor sets
     pPipelineLayout->descriptorSetIndex = 0;
-    for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME); i++)
     {
-        VkDescriptorSetAllocateInfo allocateInfo = {};
-        allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.descriptorPool              = backendContext->descriptorPool;
-        allocateInfo.descriptorSetCount          = 1;
-        allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
-
-        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) != VK_SUCCESS)
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * pPipelineLayout->descriptorSetsPerFrame); i++)
         {
-            return FFX_ERROR_BACKEND_API_ERROR;
+            VkDescriptorSetAllocateInfo allocateInfo = {};
+            allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool              = backendContext->descriptorPool;
+            allocateInfo.descriptorSetCount          = 1;
+            allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
+
+            if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) !=
+                VK_SUCCESS)
+            {
+                return FFX_ERROR_BACKEND_API_ERROR;
+            }
         }
     }
 
@@ -5585,7 +6726,7 @@ FfxErrorCode getOrCreateGraphicsPipeline(BackendContext_VK* backendContext, FfxG
     }
 
     if (backendContext->vkFunctionTable.vkCreateGraphicsPipelines(backendContext->device,
-                                                                  VK_NULL_HANDLE,
+                                                                  backendContext->pipelineCache,
                                                                   1,
                                                                   &pipelineCreateInfo,
                                                                   nullptr,
@@ -5618,15 +6759,19 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
     BackendContext_VK*                backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
     BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
 
-    // start by fetching the shader blob
-    FfxDataGraphBlob dataGraphBlob = {};
-    backendInterface->fpGetPermutationBlobByIndex(effect, passId, permutationOptions, nullptr, nullptr, &dataGraphBlob);
+    // start by fetching the shader blob, unless the effect supplied its own (e.g. a model loaded at runtime)
+    FfxDataGraphBlob permutationBlob = {};
+    if (desc->dataGraphBlob == nullptr)
+    {
+        backendInterface->fpGetPermutationBlobByIndex(effect, passId, permutationOptions, nullptr, nullptr, &permutationBlob);
+    }
+    const FfxDataGraphBlob& dataGraphBlob = (desc->dataGraphBlob != nullptr) ? *desc->dataGraphBlob : permutationBlob;
 
     //////////////////////////////////////////////////////////////////////////
     // One root signature (or pipeline layout) per pipeline
-    FFX_ASSERT_MESSAGE(effectContext.nextPipelineLayout < (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT,
-                       "FFXInterface: Vulkan: Ran out of pipeline layouts. Please increase FFX_MAX_PASS_COUNT");
-    BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    BackendContext_VK::PipelineLayout* pPipelineLayout = acquirePipelineLayout(backendContext, effectContextId);
+    FFX_RETURN_ON_ERROR(pPipelineLayout != nullptr, FFX_ERROR_OUT_OF_RANGE);
+    pPipelineLayout->descriptorSetsPerFrame = MAX_PIPELINE_USAGE_PER_FRAME;
 
     // Setup descriptor sets
     std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
@@ -5657,17 +6802,21 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
 
     // allocate descriptor sets
     pPipelineLayout->descriptorSetIndex = 0;
-    for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME); i++)
     {
-        VkDescriptorSetAllocateInfo allocateInfo = {};
-        allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.descriptorPool              = backendContext->descriptorPool;
-        allocateInfo.descriptorSetCount          = 1;
-        allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
-
-        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) != VK_SUCCESS)
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * pPipelineLayout->descriptorSetsPerFrame); i++)
         {
-            return FFX_ERROR_BACKEND_API_ERROR;
+            VkDescriptorSetAllocateInfo allocateInfo = {};
+            allocateInfo.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool              = backendContext->descriptorPool;
+            allocateInfo.descriptorSetCount          = 1;
+            allocateInfo.pSetLayouts                 = &pPipelineLayout->descriptorSetLayout;
+
+            if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) !=
+                VK_SUCCESS)
+            {
+                return FFX_ERROR_BACKEND_API_ERROR;
+            }
         }
     }
 
@@ -5704,10 +6853,18 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
         ConvertUTF8ToUTF16(dataGraphBlob.tensorNames[tensorIndex], outPipeline->uavTensorBindings[tensorIndex].name, FFX_RESOURCE_NAME_SIZE);
     }
 
-    DescriptorSetBindingToShapeMap inputShapes = GetInputShapes(dataGraphBlob, render_width, render_height);
+    // Views batched together share one dispatch of the graph
+    const uint32_t batchSize = desc->batchSize ? desc->batchSize : 1;
 
-    ShapeInferenceResults ShapeInferenceResults =
-        RunShapeInference(reinterpret_cast<const uint32_t*>(dataGraphBlob.graphData), dataGraphBlob.graphDataSize / 4, inputShapes);
+    // Graphs the parser didn't specialize for this resolution are shape inferred now
+    ShapeInferenceResults ShapeInferenceResults = {};
+    if (!GetPrecomputedShapes(dataGraphBlob, batchSize, render_width, render_height, ShapeInferenceResults))
+    {
+        DescriptorSetBindingToShapeMap inputShapes = GetInputShapes(dataGraphBlob, batchSize, render_width, render_height);
+
+        ShapeInferenceResults =
+            RunShapeInference(reinterpret_cast<const uint32_t*>(dataGraphBlob.graphData), dataGraphBlob.graphDataSize / 4, inputShapes);
+    }
 
     if (!ShapeInferenceResults.Success)
     {
@@ -5726,10 +6883,14 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
-    std::vector<VkTensorDescriptionARM>         pipelineTensorConstantDescs;
-    std::vector<VkDataGraphPipelineConstantARM> pipelineConstants;
+    std::vector<VkTensorDescriptionARM>                                         pipelineTensorConstantDescs;
+    std::vector<VkDataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM> pipelineConstantSparsityInfos;
+    std::vector<std::vector<uint8_t>>                                           expandedConstantDatas;
+    std::vector<VkDataGraphPipelineConstantARM>                                 pipelineConstants;
 
     pipelineTensorConstantDescs.resize(dataGraphBlob.constantNums);
+    pipelineConstantSparsityInfos.resize(dataGraphBlob.constantNums);
+    expandedConstantDatas.resize(dataGraphBlob.constantNums);
 
     for (FfxUInt32 constantIndex = 0; constantIndex < dataGraphBlob.constantNums; ++constantIndex)
     {
@@ -5750,6 +6911,29 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
                                                            dataGraphBlob.constantIds[constantIndex],
                                                            dataGraphBlob.constantDatas[constantIndex]};
 
+        // Pruned weights are stored without their zeros. They are passed dense, with their sparsity so the implementation can skip the zeros.
+        if (ffxDataGraphConstantIsCompressed(dataGraphBlob, constantIndex))
+        {
+            std::vector<uint8_t>& expandedData = expandedConstantDatas[constantIndex];
+            expandedData.resize(dataGraphBlob.constantDataSize[constantIndex]);
+            if (!ffxDataGraphExpandConstant(dataGraphBlob, constantIndex, expandedData.data()))
+            {
+                backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, shaderModule, nullptr);
+                return FFX_ERROR_INVALID_ARGUMENT;
+            }
+
+            VkDataGraphPipelineConstantTensorSemiStructuredSparsityInfoARM sparsityInfo = {
+                VK_STRUCTURE_TYPE_DATA_GRAPH_PIPELINE_CONSTANT_TENSOR_SEMI_STRUCTURED_SPARSITY_INFO_ARM,
+                &pipelineTensorConstantDescs[constantIndex],
+                static_cast<uint32_t>(dataGraphBlob.constantSparsityDimensions[constantIndex]),
+                dataGraphBlob.constantSparsityZeroCounts[constantIndex],
+                dataGraphBlob.constantSparsityGroupSizes[constantIndex]};
+
+            pipelineConstantSparsityInfos[constantIndex] = sparsityInfo;
+            pipelineConstant.pNext                       = &pipelineConstantSparsityInfos[constantIndex];
+            pipelineConstant.pConstantData               = expandedData.data();
+        }
+
         pipelineConstants.push_back(pipelineConstant);
     }
 
@@ -5802,7 +6986,7 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
 
     VkPipeline dataGraphPipeline = VK_NULL_HANDLE;
     if (backendContext->vkFunctionTable.vkCreateDataGraphPipelinesARM(
-            backendContext->device, VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &dataGraphPipeline) != VK_SUCCESS)
+            backendContext->device, VK_NULL_HANDLE, backendContext->pipelineCache, 1, &pipelineCreateInfo, nullptr, &dataGraphPipeline) != VK_SUCCESS)
     {
         return FFX_ERROR_BACKEND_API_ERROR;
     }
@@ -5823,7 +7007,8 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
     }
 
     // Use cpp standard way (eg.reinterpret_cast) to store opaque vulkan handles in generic pointers
-    outPipeline->session = reinterpret_cast<FfxDataGraphPipelineSession>(session);
+    outPipeline->session              = reinterpret_cast<FfxDataGraphPipelineSession>(session);
+    pPipelineLayout->dataGraphSession = session;
 
     const VkDataGraphPipelineSessionMemoryRequirementsInfoARM memoryRequirementsInfo = {
         VK_STRUCTURE_TYPE_DATA_GRAPH_PIPELINE_SESSION_MEMORY_REQUIREMENTS_INFO_ARM, nullptr, session, VK_DATA_GRAPH_PIPELINE_SESSION_BIND_POINT_TRANSIENT_ARM};
@@ -5832,15 +7017,15 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
 
     backendContext->vkFunctionTable.vkGetDataGraphPipelineSessionMemoryRequirementsARM(backendContext->device, &memoryRequirementsInfo, &memreqs);
 
-    backendContext->dataGraphPipelineSessionResource.memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    // The session memory is owned by the pipeline layout so it is released together with the pipeline.
+    BackendContext_VK::Resource sessionResource = {};
+    sessionResource.memoryProperties            = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-    if (allocateDeviceMemory(backendContext,
-                             memreqs.memoryRequirements,
-                             backendContext->dataGraphPipelineSessionResource.memoryProperties,
-                             &backendContext->dataGraphPipelineSessionResource))
+    if (allocateDeviceMemory(backendContext, memreqs.memoryRequirements, sessionResource.memoryProperties, &sessionResource))
     {
         return FFX_ERROR_BACKEND_API_ERROR;
     }
+    pPipelineLayout->dataGraphSessionMemory = sessionResource.deviceMemory;
 
     const VkBindDataGraphPipelineSessionMemoryInfoARM bindInfo = {
         VK_STRUCTURE_TYPE_BIND_DATA_GRAPH_PIPELINE_SESSION_MEMORY_INFO_ARM,
@@ -5848,7 +7033,7 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
         session,
         VK_DATA_GRAPH_PIPELINE_SESSION_BIND_POINT_TRANSIENT_ARM,  // binding point
         0,                                                        // resource index
-        backendContext->dataGraphPipelineSessionResource.deviceMemory,
+        pPipelineLayout->dataGraphSessionMemory,
         0  // memoryOffset
     };
 
@@ -5863,8 +7048,7 @@ FfxErrorCode CreateDataGraphPipelineVK(FfxInterface*                 backendInte
 FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId)
 {
     FFX_ASSERT(backendInterface != nullptr);
-    BackendContext_VK*                backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
-    BackendContext_VK::EffectContext& effectContext  = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
 
     if (!pipeline)
         return FFX_OK;
@@ -5873,7 +7057,7 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
     VkPipeline vkPipeline = reinterpret_cast<VkPipeline>(pipeline->pipeline);
     if (vkPipeline != VK_NULL_HANDLE)
     {
-        backendContext->vkFunctionTable.vkDestroyPipeline(backendContext->device, vkPipeline, VK_NULL_HANDLE);
+        deferDestruction(backendContext, VK_OBJECT_TYPE_PIPELINE, vkPipeline);
         pipeline->pipeline = VK_NULL_HANDLE;
     }
 
@@ -5888,22 +7072,21 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         // Descriptor set layout
         if (pPipelineLayout->pipelineLayout != VK_NULL_HANDLE)
         {
-            backendContext->vkFunctionTable.vkDestroyPipelineLayout(backendContext->device, pPipelineLayout->pipelineLayout, VK_NULL_HANDLE);
+            deferDestruction(backendContext, VK_OBJECT_TYPE_PIPELINE_LAYOUT, pPipelineLayout->pipelineLayout);
             pPipelineLayout->pipelineLayout = VK_NULL_HANDLE;
         }
 
-        // Descriptor sets
-        for (uint32_t i = 0; i < FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME; i++)
+        // Descriptor sets, which are freed under the pipeline mutex once the GPU is done with them
+        for (uint32_t i = 0; i < FFX_MAX_QUEUED_FRAMES * pPipelineLayout->descriptorSetsPerFrame; i++)
         {
-            backendContext->vkFunctionTable.vkFreeDescriptorSets(
-                backendContext->device, backendContext->descriptorPool, 1, &pPipelineLayout->descriptorSets[i]);
+            deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET, pPipelineLayout->descriptorSets[i], backendContext->descriptorPool);
             pPipelineLayout->descriptorSets[i] = VK_NULL_HANDLE;
         }
 
         // Descriptor set layout
         if (pPipelineLayout->descriptorSetLayout != VK_NULL_HANDLE)
         {
-            backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(backendContext->device, pPipelineLayout->descriptorSetLayout, VK_NULL_HANDLE);
+            deferDestruction(backendContext, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, pPipelineLayout->descriptorSetLayout);
             pPipelineLayout->descriptorSetLayout = VK_NULL_HANDLE;
         }
 
@@ -5912,7 +7095,7 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             if (pPipelineLayout->samplers[currentSamplerIndex] != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroySampler(backendContext->device, pPipelineLayout->samplers[currentSamplerIndex], VK_NULL_HANDLE);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_SAMPLER, pPipelineLayout->samplers[currentSamplerIndex]);
                 pPipelineLayout->samplers[currentSamplerIndex] = VK_NULL_HANDLE;
             }
         }
@@ -5921,7 +7104,7 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             if (pPipelineLayout->imageView[i].handle != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, pPipelineLayout->imageView[i].handle, VK_NULL_HANDLE);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_IMAGE_VIEW, pPipelineLayout->imageView[i].handle);
             }
         }
 
@@ -5929,7 +7112,7 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             if (pPipelineLayout->frameBuffer[i].handle != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyFramebuffer(backendContext->device, pPipelineLayout->frameBuffer[i].handle, VK_NULL_HANDLE);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_FRAMEBUFFER, pPipelineLayout->frameBuffer[i].handle);
             }
         }
 
@@ -5937,7 +7120,7 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             if (pPipelineLayout->renderPass[i].handle != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyRenderPass(backendContext->device, pPipelineLayout->renderPass[i].handle, VK_NULL_HANDLE);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_RENDER_PASS, pPipelineLayout->renderPass[i].handle);
             }
         }
 
@@ -5945,10 +7128,11 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             if (pPipelineLayout->graphicsPipeline[i].handle != VK_NULL_HANDLE)
             {
-                backendContext->vkFunctionTable.vkDestroyPipeline(backendContext->device, pPipelineLayout->graphicsPipeline[i].handle, VK_NULL_HANDLE);
+                deferDestruction(backendContext, VK_OBJECT_TYPE_PIPELINE, pPipelineLayout->graphicsPipeline[i].handle);
             }
         }
 
+        // Shader modules are only read when pipelines are created, so they don't need to outlive the GPU work
         if (pPipelineLayout->fragShaderModule != VK_NULL_HANDLE)
         {
             backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, pPipelineLayout->fragShaderModule, nullptr);
@@ -5958,30 +7142,90 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         {
             backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, pPipelineLayout->vertShaderModule, nullptr);
         }
+
+        if (pPipelineLayout->dataGraphSession != VK_NULL_HANDLE)
+        {
+            deferDestruction(backendContext, VK_OBJECT_TYPE_DATA_GRAPH_PIPELINE_SESSION_ARM, pPipelineLayout->dataGraphSession);
+            pPipelineLayout->dataGraphSession = VK_NULL_HANDLE;
+            pipeline->session                 = nullptr;
+        }
+
+        if (pPipelineLayout->dataGraphSessionMemory != VK_NULL_HANDLE)
+        {
+            deferDestruction(backendContext, VK_OBJECT_TYPE_DEVICE_MEMORY, pPipelineLayout->dataGraphSessionMemory);
+            pPipelineLayout->dataGraphSessionMemory = VK_NULL_HANDLE;
+        }
+
+        // The layout slot can now be recycled, so don't leave a dangling reference to it
+        {
+            std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+            pPipelineLayout->inUse = false;
+            ++backendContext->pipelineGeneration;
+        }
+        pipeline->rootSignature = nullptr;
     }
 
     return FFX_OK;
 }
 
-FfxErrorCode ScheduleGpuJobVK(FfxInterface* backendInterface, const FfxGpuJobDescription* job)
+FfxErrorCode ScheduleGpuJobVK(FfxInterface* backendInterface, const FfxGpuJobDescription* job, FfxUInt32 effectContextId)
 {
     FFX_ASSERT(NULL != backendInterface);
     FFX_ASSERT(NULL != job);
 
-    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK*                 backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::RecordingState& recordingState = backendContext->pEffectContexts[effectContextId].recordingState;
 
-    FFX_ASSERT(backendContext->gpuJobCount < FFX_MAX_GPU_JOBS);
+    FFX_ASSERT(recordingState.gpuJobCount < FFX_MAX_GPU_JOBS);
 
-    backendContext->pGpuJobs[backendContext->gpuJobCount] = *job;
-    backendContext->gpuJobCount++;
+    recordingState.pGpuJobs[recordingState.gpuJobCount] = *job;
+    recordingState.gpuJobCount++;
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
-                                         FfxGpuJobDescription* job,
-                                         VkCommandBuffer       vkCommandBuffer,
-                                         FfxUInt32             effectContextId)
+static FfxConstantAllocation allocateRecordedConstants(BackendContext_VK* backendContext, FfxUInt32 effectContextId, void* data, FfxUInt64 dataSize)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
+    FfxConstantAllocation allocation;
+    memset(&allocation, 0, sizeof(FfxConstantAllocation));
+
+    // Each queued frame owns a fixed part of the buffer, so replaying the same jobs writes the constants to the offsets they were recorded with
+    if (effectContext.recordedConstantOffset + dataSize > effectContext.recordedConstantFrameSize)
+        return allocation;
+
+    const VkDeviceSize offset = effectContext.frameIndex * effectContext.recordedConstantFrameSize + effectContext.recordedConstantOffset;
+    memcpy(effectContext.recordedConstantBufferMem + offset, data, dataSize);
+
+    // flush mapped range if memory type is not coherent
+    if ((effectContext.recordedConstantBufferMemoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+    {
+        VkMappedMemoryRange memoryRange;
+        memset(&memoryRange, 0, sizeof(memoryRange));
+
+        memoryRange.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        memoryRange.memory = effectContext.recordedConstantBufferMemory;
+        memoryRange.offset = offset;
+        memoryRange.size   = dataSize;
+
+        backendContext->vkFunctionTable.vkFlushMappedMemoryRanges(backendContext->device, 1, &memoryRange);
+    }
+
+    effectContext.recordedConstantOffset += FFX_ALIGN_UP(dataSize, effectContext.recordedConstantAlignment);
+
+    allocation.resource.resource = effectContext.recordedConstantBuffer;
+    allocation.handle            = static_cast<FfxUInt64>(offset);
+
+    return allocation;
+}
+
+static FfxErrorCode executeGpuJobCompute(BackendContext_VK*                 backendContext,
+                                         BackendContext_VK::RecordingState& recordingState,
+                                         FfxGpuJobDescription*              job,
+                                         VkCommandBuffer                    vkCommandBuffer,
+                                         FfxUInt32                          effectContextId,
+                                         bool                               recording)
 {
     BackendContext_VK::PipelineLayout* pipelineLayout = reinterpret_cast<BackendContext_VK::PipelineLayout*>(job->computeJobDescriptor.pipeline.rootSignature);
 
@@ -6010,7 +7254,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.uavTextures[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recordingState, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavTextureBindings[currentPipelineUavIndex];
 
@@ -6050,7 +7294,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recordingState, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavBufferBindings[currentPipelineUavIndex];
 
@@ -6087,7 +7331,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.srvTextures[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        addBarrier(backendContext, recordingState, &textureSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvTextureBindings[currentPipelineSrvIndex];
 
@@ -6123,7 +7367,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        addBarrier(backendContext, recordingState, &bufferSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvBufferBindings[currentPipelineSrvIndex];
 
@@ -6165,7 +7409,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (tensor.resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &tensor.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recordingState, &tensor.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavTensorBindings[currentPipelineUavIndex];
 
@@ -6197,7 +7441,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (tensor.resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &tensor.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        addBarrier(backendContext, recordingState, &tensor.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvTensorBindings[currentPipelineSrvIndex];
 
@@ -6225,9 +7469,15 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     {
         uint32_t dataSize = job->computeJobDescriptor.cbs[currentRootConstantIndex].num32BitEntries * sizeof(uint32_t);
 
-        // If we have a constant buffer allocator, use that, otherwise use the default backend allocator
+        // Recorded jobs keep their constants at fixed offsets. Otherwise, if we have a constant buffer allocator, use that,
+        // otherwise use the default backend allocator
         FfxConstantAllocation allocation;
-        if (s_fpConstantAllocator)
+        if (recording)
+        {
+            allocation = allocateRecordedConstants(backendContext, effectContextId, job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize);
+            FFX_RETURN_ON_ERROR(allocation.resource.resource != nullptr, FFX_ERROR_OUT_OF_MEMORY);
+        }
+        else if (s_fpConstantAllocator)
             allocation = s_fpConstantAllocator(job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize);
         else
             allocation = backendContext->FallbackConstantAllocator(job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize);
@@ -6252,11 +7502,11 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     // If we are dispatching indirectly, transition the argument resource to indirect argument
     if (job->computeJobDescriptor.pipeline.cmdSignature)
     {
-        addBarrier(backendContext, &job->computeJobDescriptor.cmdArgument, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
+        addBarrier(backendContext, recordingState, &job->computeJobDescriptor.cmdArgument, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
     }
 
     // insert all the barriers
-    flushBarriers(backendContext, vkCommandBuffer);
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
     // update all uavs and srvs
     backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
@@ -6265,6 +7515,18 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     backendContext->vkFunctionTable.vkCmdBindPipeline(
         vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reinterpret_cast<VkPipeline>(job->computeJobDescriptor.pipeline.pipeline));
 
+    // push constants replace the constant buffer writes above for pipelines created with a push constant range
+    if (job->computeJobDescriptor.pipeline.pushConstantSize > 0)
+    {
+        FFX_ASSERT(job->computeJobDescriptor.pushConstants.num32BitEntries * sizeof(uint32_t) >= job->computeJobDescriptor.pipeline.pushConstantSize);
+        backendContext->vkFunctionTable.vkCmdPushConstants(vkCommandBuffer,
+                                                           pipelineLayout->pipelineLayout,
+                                                           VK_SHADER_STAGE_COMPUTE_BIT,
+                                                           0,
+                                                           job->computeJobDescriptor.pipeline.pushConstantSize,
+                                                           job->computeJobDescriptor.pushConstants.data);
+    }
+
     // bind descriptor sets
     {
         backendContext->vkFunctionTable.vkCmdBindDescriptorSets(vkCommandBuffer,
@@ -6334,13 +7596,16 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
 
     // move to another descriptor set for the next compute render job so that we don't overwrite descriptors in-use
     ++pipelineLayout->descriptorSetIndex;
-    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME))
+    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * pipelineLayout->descriptorSetsPerFrame))
         pipelineLayout->descriptorSetIndex = 0;
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobFragment(BackendContext_VK*                 backendContext,
+                                          BackendContext_VK::RecordingState& recordingState,
+                                          FfxGpuJobDescription*              job,
+                                          VkCommandBuffer                    vkCommandBuffer)
 {
     BackendContext_VK::PipelineLayout* pipelineLayout = reinterpret_cast<BackendContext_VK::PipelineLayout*>(job->fragmentJobDescriptor.pipeline.rootSignature);
 
@@ -6369,7 +7634,7 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
         if (job->fragmentJobDescriptor.uavTextures[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recordingState, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->fragmentJobDescriptor.pipeline.uavTextureBindings[currentPipelineUavIndex];
 
@@ -6409,7 +7674,7 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
         if (job->fragmentJobDescriptor.uavBuffers[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recordingState, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->fragmentJobDescriptor.pipeline.uavBufferBindings[currentPipelineUavIndex];
 
@@ -6446,7 +7711,7 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
         if (job->fragmentJobDescriptor.srvTextures[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureSRV.resource, FFX_RESOURCE_STATE_PIXEL_READ);
+        addBarrier(backendContext, recordingState, &textureSRV.resource, FFX_RESOURCE_STATE_PIXEL_READ);
 
         const FfxResourceBinding binding = job->fragmentJobDescriptor.pipeline.srvTextureBindings[currentPipelineSrvIndex];
 
@@ -6482,7 +7747,7 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
         if (job->fragmentJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferSRV.resource, FFX_RESOURCE_STATE_PIXEL_READ);
+        addBarrier(backendContext, recordingState, &bufferSRV.resource, FFX_RESOURCE_STATE_PIXEL_READ);
 
         const FfxResourceBinding binding = job->fragmentJobDescriptor.pipeline.srvBufferBindings[currentPipelineSrvIndex];
 
@@ -6542,11 +7807,11 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
     // Transition RTs
     for (FfxUInt32 rt = 0; rt < job->fragmentJobDescriptor.pipeline.rtCount; ++rt)
     {
-        addBarrier(backendContext, &job->fragmentJobDescriptor.rtTextures[rt].resource, FFX_RESOURCE_STATE_RENDER_TARGET);
+        addBarrier(backendContext, recordingState, &job->fragmentJobDescriptor.rtTextures[rt].resource, FFX_RESOURCE_STATE_RENDER_TARGET);
     }
 
     // insert all the barriers
-    flushBarriers(backendContext, vkCommandBuffer);
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
     // update all uavs and srvs
     backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
@@ -6594,13 +7859,16 @@ static FfxErrorCode executeGpuJobFragment(BackendContext_VK* backendContext, Ffx
 
     // move to another descriptor set for the next compute render job so that we don't overwrite descriptors in-use
     ++pipelineLayout->descriptorSetIndex;
-    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME))
+    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * pipelineLayout->descriptorSetsPerFrame))
         pipelineLayout->descriptorSetIndex = 0;
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK*                 backendContext,
+                                           BackendContext_VK::RecordingState& recordingState,
+                                           FfxGpuJobDescription*              job,
+                                           VkCommandBuffer                    vkCommandBuffer)
 {
     BackendContext_VK::PipelineLayout* pipelineLayout =
         reinterpret_cast<BackendContext_VK::PipelineLayout*>(job->dataGraphJobDescription.pipeline.rootSignature);
@@ -6622,7 +7890,7 @@ static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK* backendContext, Ff
         if (tensor.resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &tensor.resource, FFX_RESOURCE_STATE_DATA_GRAPH_WRITE);
+        addBarrier(backendContext, recordingState, &tensor.resource, FFX_RESOURCE_STATE_DATA_GRAPH_WRITE);
 
         const FfxResourceBinding binding = job->dataGraphJobDescription.pipeline.uavTensorBindings[currentPipelineUavIndex];
 
@@ -6654,7 +7922,7 @@ static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK* backendContext, Ff
         if (tensor.resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &tensor.resource, FFX_RESOURCE_STATE_DATA_GRAPH_READ);
+        addBarrier(backendContext, recordingState, &tensor.resource, FFX_RESOURCE_STATE_DATA_GRAPH_READ);
 
         const FfxResourceBinding binding = job->dataGraphJobDescription.pipeline.srvTensorBindings[currentPipelineSrvIndex];
 
@@ -6678,7 +7946,7 @@ static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK* backendContext, Ff
     }
 
     // insert all the barriers
-    flushBarriers(backendContext, vkCommandBuffer);
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
     // update all uavs and srvs
     backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
@@ -6706,20 +7974,23 @@ static FfxErrorCode executeGpuJobDataGraph(BackendContext_VK* backendContext, Ff
 
     // move to another descriptor set for the next compute render job so that we don't overwrite descriptors in-use
     ++pipelineLayout->descriptorSetIndex;
-    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME))
+    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * pipelineLayout->descriptorSetsPerFrame))
         pipelineLayout->descriptorSetIndex = 0;
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobCopy(BackendContext_VK*                 backendContext,
+                                      BackendContext_VK::RecordingState& recordingState,
+                                      FfxGpuJobDescription*              job,
+                                      VkCommandBuffer                    vkCommandBuffer)
 {
     BackendContext_VK::Resource ffxResourceSrc = backendContext->pResources[job->copyJobDescriptor.src.internalIndex];
     BackendContext_VK::Resource ffxResourceDst = backendContext->pResources[job->copyJobDescriptor.dst.internalIndex];
 
-    addBarrier(backendContext, &job->copyJobDescriptor.src, FFX_RESOURCE_STATE_COPY_SRC);
-    addBarrier(backendContext, &job->copyJobDescriptor.dst, FFX_RESOURCE_STATE_COPY_DEST);
-    flushBarriers(backendContext, vkCommandBuffer);
+    addBarrier(backendContext, recordingState, &job->copyJobDescriptor.src, FFX_RESOURCE_STATE_COPY_SRC);
+    addBarrier(backendContext, recordingState, &job->copyJobDescriptor.dst, FFX_RESOURCE_STATE_COPY_DEST);
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
     if (ffxResourceSrc.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER && ffxResourceDst.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
@@ -6771,6 +8042,37 @@ static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, FfxGpuJ
         backendContext->vkFunctionTable.vkCmdCopyBufferToImage(
             vkCommandBuffer, vkResourceSrc, vkResourceDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferImageCopy);
     }
+    else if (ffxResourceSrc.resourceDescription.type != FFX_RESOURCE_TYPE_BUFFER && ffxResourceDst.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
+    {
+        VkImage  vkResourceSrc = ffxResourceSrc.imageResource;
+        VkBuffer vkResourceDst = ffxResourceDst.bufferResource;
+
+        VkImageSubresourceLayers subresourceLayers = {};
+
+        subresourceLayers.aspectMask     = getImageAspect(ffxResourceSrc.resourceDescription.usage);
+        subresourceLayers.baseArrayLayer = 0;
+        subresourceLayers.layerCount     = 1;
+        subresourceLayers.mipLevel       = 0;
+
+        VkExtent3D extent = {};
+
+        extent.width  = ffxResourceSrc.resourceDescription.width;
+        extent.height = ffxResourceSrc.resourceDescription.height;
+        extent.depth  = ffxResourceSrc.resourceDescription.depth;
+
+        // mip 0 is written as tightly packed rows at the destination offset
+        VkBufferImageCopy bufferImageCopy = {};
+
+        bufferImageCopy.bufferOffset      = job->copyJobDescriptor.dstOffset;
+        bufferImageCopy.bufferRowLength   = 0;
+        bufferImageCopy.bufferImageHeight = 0;
+        bufferImageCopy.imageSubresource  = subresourceLayers;
+        bufferImageCopy.imageOffset       = {0, 0, 0};
+        bufferImageCopy.imageExtent       = extent;
+
+        backendContext->vkFunctionTable.vkCmdCopyImageToBuffer(
+            vkCommandBuffer, vkResourceSrc, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, vkResourceDst, 1, &bufferImageCopy);
+    }
     else
     {
         bool isSrcDepth = FFX_CONTAINS_FLAG(ffxResourceSrc.resourceDescription.usage, FFX_RESOURCE_USAGE_DEPTHTARGET);
@@ -6851,10 +8153,13 @@ static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, FfxGpuJ
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobBarrier(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobBarrier(BackendContext_VK*                 backendContext,
+                                         BackendContext_VK::RecordingState& recordingState,
+                                         FfxGpuJobDescription*              job,
+                                         VkCommandBuffer                    vkCommandBuffer)
 {
-    addBarrier(backendContext, &job->barrierDescriptor.resource, job->barrierDescriptor.newState);
-    flushBarriers(backendContext, vkCommandBuffer);
+    addBarrier(backendContext, recordingState, &job->barrierDescriptor.resource, job->barrierDescriptor.newState);
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
     return FFX_OK;
 }
@@ -6864,15 +8169,18 @@ static FfxErrorCode executeGpuJobTimestamp(BackendContext_VK* backendContext, Ff
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK*                 backendContext,
+                                            BackendContext_VK::RecordingState& recordingState,
+                                            FfxGpuJobDescription*              job,
+                                            VkCommandBuffer                    vkCommandBuffer)
 {
     uint32_t                    idx         = job->clearJobDescriptor.target.internalIndex;
     BackendContext_VK::Resource ffxResource = backendContext->pResources[idx];
 
     if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
-        addBarrier(backendContext, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
-        flushBarriers(backendContext, vkCommandBuffer);
+        addBarrier(backendContext, recordingState, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
+        flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
         VkBuffer vkResource = ffxResource.bufferResource;
 
@@ -6885,8 +8193,8 @@ static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, F
     }
     else
     {
-        addBarrier(backendContext, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
-        flushBarriers(backendContext, vkCommandBuffer);
+        addBarrier(backendContext, recordingState, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
+        flushBarriers(backendContext, recordingState, vkCommandBuffer);
 
         VkImage vkResource = ffxResource.imageResource;
 
@@ -6921,20 +8229,15 @@ static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, F
     return FFX_OK;
 }
 
-FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+static FfxErrorCode executeGpuJobs(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer, FfxUInt32 effectContextId, bool recording)
 {
-    FFX_ASSERT(nullptr != backendInterface);
-    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
-
-    FFX_ASSERT(nullptr != commandList);
-    VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
-
-    FfxErrorCode errorCode = FFX_OK;
+    BackendContext_VK::RecordingState& recordingState = backendContext->pEffectContexts[effectContextId].recordingState;
+    FfxErrorCode                       errorCode      = FFX_OK;
 
     // execute all renderjobs
-    for (uint32_t i = 0; i < backendContext->gpuJobCount; ++i)
+    for (uint32_t i = 0; i < recordingState.gpuJobCount; ++i)
     {
-        FfxGpuJobDescription* gpuJob = &backendContext->pGpuJobs[i];
+        FfxGpuJobDescription* gpuJob = &recordingState.pGpuJobs[i];
 
         // If we have a label for the job, drop a marker for it
         if (gpuJob->jobLabel[0])
@@ -6946,32 +8249,32 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
         {
         case FFX_GPU_JOB_CLEAR_FLOAT:
         {
-            errorCode = executeGpuJobClearFloat(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobClearFloat(backendContext, recordingState, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COPY:
         {
-            errorCode = executeGpuJobCopy(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobCopy(backendContext, recordingState, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COMPUTE:
         {
-            errorCode = executeGpuJobCompute(backendContext, gpuJob, vkCommandBuffer, effectContextId);
+            errorCode = executeGpuJobCompute(backendContext, recordingState, gpuJob, vkCommandBuffer, effectContextId, recording);
             break;
         }
         case FFX_GPU_JOB_BARRIER:
         {
-            errorCode = executeGpuJobBarrier(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobBarrier(backendContext, recordingState, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_FRAGMENT:
         {
-            errorCode = executeGpuJobFragment(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobFragment(backendContext, recordingState, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_DATA_GRAPH:
         {
-            errorCode = executeGpuJobDataGraph(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobDataGraph(backendContext, recordingState, gpuJob, vkCommandBuffer);
             break;
         }
         default:;
@@ -6983,10 +8286,390 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
         }
     }
 
+    return errorCode;
+}
+
+FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(nullptr != backendInterface);
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+
+    FFX_ASSERT(nullptr != commandList);
+    VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
+
+    // Executing jobs directly walks the descriptor set rings, which the recorded command buffers rely on
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
+        effectContext.recordedGpuJobs[frameIndex].hash = 0;
+
+    acquireInternalResources(backendContext, effectContextId, backendContext->queueFamilyIndex);
+    FfxErrorCode errorCode = executeGpuJobs(backendContext, vkCommandBuffer, effectContextId, false);
+
     // check the execute function returned cleanly.
     FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
 
-    backendContext->gpuJobCount = 0;
+    effectContext.recordingState.gpuJobCount = 0;
+
+    return FFX_OK;
+}
+
+template<typename T>
+static uint64_t appendHashValue(const T& value, uint64_t hash)
+{
+    return arm::appendHash(&value, sizeof(T), hash);
+}
+
+static uint64_t appendPipelineHash(const FfxPipelineState& pipeline, uint64_t hash)
+{
+    // the bindings only depend on the pipeline, which is identified by its handles and the pipeline generation
+    hash = appendHashValue(pipeline.rootSignature, hash);
+    hash = appendHashValue(pipeline.pipeline, hash);
+    hash = appendHashValue(pipeline.session, hash);
+    hash = appendHashValue(pipeline.cmdSignature, hash);
+    return hash;
+}
+
+// Hashes everything a recording of the scheduled jobs depends on: the jobs themselves, minus the constant
+// buffer contents, and the generation of the effect context's resources when execution starts.
+// Push constants are recorded into the command buffer, so their contents are part of the hash.
+static uint64_t hashRecordedGpuJobs(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
+{
+    const BackendContext_VK::RecordingState& recordingState = backendContext->pEffectContexts[effectContextId].recordingState;
+
+    uint32_t pipelineGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock{backendContext->pipelineMutex};
+        pipelineGeneration = backendContext->pipelineGeneration;
+    }
+
+    uint64_t hash = arm::computeHash(&pipelineGeneration, sizeof(pipelineGeneration));
+    hash          = appendHashValue(recordingState.gpuJobCount, hash);
+
+    for (uint32_t i = 0; i < recordingState.gpuJobCount; ++i)
+    {
+        const FfxGpuJobDescription* gpuJob = &recordingState.pGpuJobs[i];
+        hash                               = appendHashValue(gpuJob->jobType, hash);
+
+        switch (gpuJob->jobType)
+        {
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+        {
+            hash = appendHashValue(gpuJob->clearJobDescriptor.color, hash);
+            hash = appendHashValue(gpuJob->clearJobDescriptor.target, hash);
+            break;
+        }
+        case FFX_GPU_JOB_COPY:
+        {
+            hash = appendHashValue(gpuJob->copyJobDescriptor, hash);
+            break;
+        }
+        case FFX_GPU_JOB_BARRIER:
+        {
+            hash = appendHashValue(gpuJob->barrierDescriptor, hash);
+            break;
+        }
+        case FFX_GPU_JOB_COMPUTE:
+        {
+            const FfxComputeJobDescription& job = gpuJob->computeJobDescriptor;
+
+            hash = appendPipelineHash(job.pipeline, hash);
+            hash = appendHashValue(job.dimensions, hash);
+            hash = appendHashValue(job.cmdArgument, hash);
+            hash = appendHashValue(job.cmdArgumentOffset, hash);
+            for (uint32_t index = 0; index < job.pipeline.srvTextureCount; ++index)
+                hash = appendHashValue(job.srvTextures[index].resource, hash);
+            for (uint32_t index = 0; index < job.pipeline.uavTextureCount; ++index)
+            {
+                hash = appendHashValue(job.uavTextures[index].resource, hash);
+                hash = appendHashValue(job.uavTextures[index].mip, hash);
+            }
+            for (uint32_t index = 0; index < job.pipeline.srvBufferCount; ++index)
+            {
+                hash = appendHashValue(job.srvBuffers[index].resource, hash);
+                hash = appendHashValue(job.srvBuffers[index].offset, hash);
+                hash = appendHashValue(job.srvBuffers[index].size, hash);
+            }
+            for (uint32_t index = 0; index < job.pipeline.uavBufferCount; ++index)
+            {
+                hash = appendHashValue(job.uavBuffers[index].resource, hash);
+                hash = appendHashValue(job.uavBuffers[index].offset, hash);
+                hash = appendHashValue(job.uavBuffers[index].size, hash);
+            }
+            for (uint32_t index = 0; index < job.pipeline.srvTensorCount; ++index)
+                hash = appendHashValue(job.srvTensors[index].resource, hash);
+            for (uint32_t index = 0; index < job.pipeline.uavTensorCount; ++index)
+                hash = appendHashValue(job.uavTensors[index].resource, hash);
+            for (uint32_t index = 0; index < job.pipeline.constCount; ++index)
+                hash = appendHashValue(job.cbs[index].num32BitEntries, hash);
+            for (uint32_t index = 0; index < job.pipeline.pushConstantSize / sizeof(uint32_t); ++index)
+                hash = appendHashValue(job.pushConstants.data[index], hash);
+            break;
+        }
+        case FFX_GPU_JOB_DATA_GRAPH:
+        {
+            const FfxDataGraphJobDescription& job = gpuJob->dataGraphJobDescription;
+
+            hash = appendPipelineHash(job.pipeline, hash);
+            for (uint32_t index = 0; index < job.pipeline.srvTensorCount; ++index)
+                hash = appendHashValue(job.srvTensors[index].resource, hash);
+            for (uint32_t index = 0; index < job.pipeline.uavTensorCount; ++index)
+                hash = appendHashValue(job.uavTensors[index].resource, hash);
+            break;
+        }
+        default:;
+        }
+    }
+
+    // The resources are covered by their generation rather than walked, see acquireDynamicImageView() and RegisterResourceVK()
+    hash = appendHashValue(backendContext->pEffectContexts[effectContextId].resourceGeneration, hash);
+
+    // 0 marks an invalid recording
+    return hash ? hash : 1;
+}
+
+static void setRecordedDescriptorSetIndex(const BackendContext_VK::RecordingState& recordingState, uint32_t frameIndex)
+{
+    // Every queued frame uses its own part of each descriptor set ring, so the sets bound by a recording stay untouched until it is replayed
+    for (uint32_t i = 0; i < recordingState.gpuJobCount; ++i)
+    {
+        const FfxGpuJobDescription*        gpuJob         = &recordingState.pGpuJobs[i];
+        BackendContext_VK::PipelineLayout* pipelineLayout = nullptr;
+        if (gpuJob->jobType == FFX_GPU_JOB_COMPUTE)
+            pipelineLayout = reinterpret_cast<BackendContext_VK::PipelineLayout*>(gpuJob->computeJobDescriptor.pipeline.rootSignature);
+        else if (gpuJob->jobType == FFX_GPU_JOB_DATA_GRAPH)
+            pipelineLayout = reinterpret_cast<BackendContext_VK::PipelineLayout*>(gpuJob->dataGraphJobDescription.pipeline.rootSignature);
+
+        if (pipelineLayout)
+            pipelineLayout->descriptorSetIndex = frameIndex * pipelineLayout->descriptorSetsPerFrame;
+    }
+}
+
+FfxErrorCode ExecuteRecordedGpuJobsVK(FfxInterface* backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+{
+    FFX_ASSERT(nullptr != backendInterface);
+    BackendContext_VK*                 backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::EffectContext&  effectContext  = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK::RecordingState& recordingState = effectContext.recordingState;
+
+    FFX_ASSERT(nullptr != commandList);
+    VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
+
+    // Fragment jobs need a render pass the secondary command buffers do not inherit, so anything but these is executed directly
+    bool recordable = true;
+    for (uint32_t i = 0; i < recordingState.gpuJobCount; ++i)
+    {
+        const FfxGpuJobType jobType = recordingState.pGpuJobs[i].jobType;
+        recordable &= jobType == FFX_GPU_JOB_CLEAR_FLOAT || jobType == FFX_GPU_JOB_COPY || jobType == FFX_GPU_JOB_COMPUTE ||
+                      jobType == FFX_GPU_JOB_BARRIER || jobType == FFX_GPU_JOB_DATA_GRAPH;
+    }
+
+    if (!recordable || createRecordedGpuJobResources(backendContext, effectContextId) != FFX_OK)
+        return ExecuteGpuJobsVK(backendInterface, commandList, effectContextId);
+
+    // Before the hash, which covers whether the resources are undefined
+    acquireInternalResources(backendContext, effectContextId, backendContext->queueFamilyIndex);
+
+    // From now on the views of external resources are kept across frames, as recreating them would invalidate every recording
+    effectContext.retainDynamicViews = true;
+
+    // Barriers still pending belong to the primary command buffer
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
+
+    const uint32_t                     frameIndex = effectContext.frameIndex;
+    BackendContext_VK::RecordedGpuJobs& recorded   = effectContext.recordedGpuJobs[frameIndex];
+    BackendContext_VK::Resource*       pResources = &backendContext->pResources[effectContextId * FFX_MAX_RESOURCE_COUNT];
+    const uint64_t                     hash       = hashRecordedGpuJobs(backendContext, effectContextId);
+
+    setRecordedDescriptorSetIndex(recordingState, frameIndex);
+    effectContext.recordedConstantOffset = 0;
+
+    FfxErrorCode errorCode = FFX_OK;
+    if (recorded.hash != hash)
+    {
+        recorded.hash = 0;
+
+        VkCommandBufferInheritanceInfo inheritanceInfo = {};
+        inheritanceInfo.sType                          = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pInheritanceInfo         = &inheritanceInfo;
+
+        for (uint32_t index = 0; index < FFX_MAX_RESOURCE_COUNT; ++index)
+        {
+            recorded.endStates[index]    = pResources[index].currentState;
+            recorded.endUndefined[index] = pResources[index].undefined;
+        }
+
+        FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkBeginCommandBuffer(recorded.commandBuffer, &beginInfo) == VK_SUCCESS,
+                            FFX_ERROR_BACKEND_API_ERROR);
+        errorCode = executeGpuJobs(backendContext, recorded.commandBuffer, effectContextId, true);
+        FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkEndCommandBuffer(recorded.commandBuffer) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+        // The internal resources start a replay in the states the recording left them in, so one that changed them, such as
+        // the first use of an undefined resource, has to be made again. Registered resources start from their registration.
+        const uint32_t staticResourceCount = effectContext.nextStaticResource - effectContextId * FFX_MAX_RESOURCE_COUNT;
+        bool           changedStates       = false;
+        for (uint32_t index = 0; index < FFX_MAX_RESOURCE_COUNT; ++index)
+        {
+            if (index < staticResourceCount && !pResources[index].persistent)
+                changedStates |= recorded.endStates[index] != pResources[index].currentState || recorded.endUndefined[index] != pResources[index].undefined;
+            recorded.endStates[index]    = pResources[index].currentState;
+            recorded.endUndefined[index] = pResources[index].undefined;
+        }
+        if (changedStates)
+            ++effectContext.resourceGeneration;
+        recorded.hash = hash;
+    }
+    else
+    {
+        // Nothing but the constants changed since the recording, write them to the offsets the recording reads from
+        for (uint32_t i = 0; i < recordingState.gpuJobCount && errorCode == FFX_OK; ++i)
+        {
+            FfxGpuJobDescription* gpuJob = &recordingState.pGpuJobs[i];
+            if (gpuJob->jobType != FFX_GPU_JOB_COMPUTE)
+                continue;
+
+            for (uint32_t index = 0; index < gpuJob->computeJobDescriptor.pipeline.constCount; ++index)
+            {
+                FfxConstantBuffer&    constantBuffer = gpuJob->computeJobDescriptor.cbs[index];
+                FfxConstantAllocation allocation =
+                    allocateRecordedConstants(backendContext, effectContextId, constantBuffer.data, constantBuffer.num32BitEntries * sizeof(uint32_t));
+                if (allocation.resource.resource == nullptr)
+                    errorCode = FFX_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+        for (uint32_t index = 0; index < FFX_MAX_RESOURCE_COUNT; ++index)
+        {
+            pResources[index].currentState = recorded.endStates[index];
+            pResources[index].undefined    = recorded.endUndefined[index];
+        }
+    }
+
+    backendContext->vkFunctionTable.vkCmdExecuteCommands(vkCommandBuffer, 1, &recorded.commandBuffer);
+
+    // Leave the rings at the next frame's part, should the jobs of the next frame be executed directly
+    setRecordedDescriptorSetIndex(recordingState, (frameIndex + 1) % FFX_MAX_QUEUED_FRAMES);
+
+    recordingState.gpuJobCount = 0;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ExecuteGpuJobsAsyncVK(FfxInterface*                     backendInterface,
+                                   FfxCommandList                    commandList,
+                                   const FfxAsyncComputeDescription* asyncCompute,
+                                   FfxUInt32                         effectContextId)
+{
+    FFX_ASSERT(nullptr != backendInterface);
+    BackendContext_VK*                 backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::EffectContext&  effectContext  = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK::RecordingState& recordingState = effectContext.recordingState;
+
+    FFX_ASSERT(nullptr != commandList);
+    FFX_ASSERT(nullptr != asyncCompute);
+    VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
+
+    // Resources only change queue family when the queues belong to different families, and then they have to be handed back
+    const bool transferOwnership = asyncCompute->queueFamilyIndex != asyncCompute->commandListQueueFamilyIndex;
+    FFX_RETURN_ON_ERROR(asyncCompute->queue != nullptr, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(!transferOwnership || asyncCompute->acquireCommandList != nullptr, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(!transferOwnership || asyncCompute->waitSemaphore != nullptr, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(createAsyncGpuJobResources(backendContext, effectContextId, asyncCompute->queueFamilyIndex) == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+    // The command buffer of this slot was submitted FFX_MAX_QUEUED_FRAMES dispatches ago, it has normally completed by now
+    const uint32_t  slot               = effectContext.asyncFrameIndex;
+    VkCommandBuffer asyncCommandBuffer = effectContext.asyncCommandBuffers[slot];
+    VkFence         fence              = effectContext.asyncFences[slot];
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkWaitForFences(backendContext->device, 1, &fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS,
+                        FFX_ERROR_BACKEND_API_ERROR);
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkResetCommandBuffer(asyncCommandBuffer, 0) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+
+    // Executing jobs directly walks the descriptor set rings, which the recorded command buffers rely on
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
+        effectContext.recordedGpuJobs[frameIndex].hash = 0;
+
+    // The resources registered for these jobs, UnregisterResourcesVK() below resets the lists
+    uint32_t       registeredResources[FFX_MAX_RESOURCE_COUNT];
+    const uint32_t registeredResourceCount = getRegisteredResources(backendContext, effectContextId, registeredResources);
+    const uint32_t srcQueueFamilyIndex     = asyncCompute->commandListQueueFamilyIndex;
+    const uint32_t dstQueueFamilyIndex     = asyncCompute->queueFamilyIndex;
+
+    // Barriers still pending, and the release of the external resources, belong to the command list
+    flushBarriers(backendContext, recordingState, vkCommandBuffer);
+    if (transferOwnership)
+    {
+        addQueueFamilyTransferBarriers(
+            backendContext, recordingState, registeredResources, registeredResourceCount, srcQueueFamilyIndex, dstQueueFamilyIndex, true);
+        flushBarriers(backendContext, recordingState, vkCommandBuffer);
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkBeginCommandBuffer(asyncCommandBuffer, &beginInfo) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+
+    if (transferOwnership)
+    {
+        addQueueFamilyTransferBarriers(
+            backendContext, recordingState, registeredResources, registeredResourceCount, srcQueueFamilyIndex, dstQueueFamilyIndex, false);
+        flushBarriers(backendContext, recordingState, asyncCommandBuffer);
+    }
+
+    acquireInternalResources(backendContext, effectContextId, dstQueueFamilyIndex);
+    FfxErrorCode errorCode     = executeGpuJobs(backendContext, asyncCommandBuffer, effectContextId, false);
+    recordingState.gpuJobCount = 0;
+
+    // Walk the external resources back to their initial states before they are handed back
+    UnregisterResourcesVK(backendInterface, ffxGetCommandListVK(asyncCommandBuffer), effectContextId);
+    if (transferOwnership)
+    {
+        addQueueFamilyTransferBarriers(
+            backendContext, recordingState, registeredResources, registeredResourceCount, dstQueueFamilyIndex, srcQueueFamilyIndex, true);
+        flushBarriers(backendContext, recordingState, asyncCommandBuffer);
+    }
+
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkEndCommandBuffer(asyncCommandBuffer) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+    if (transferOwnership)
+    {
+        addQueueFamilyTransferBarriers(
+            backendContext, recordingState, registeredResources, registeredResourceCount, dstQueueFamilyIndex, srcQueueFamilyIndex, false);
+        flushBarriers(backendContext, recordingState, reinterpret_cast<VkCommandBuffer>(asyncCompute->acquireCommandList));
+    }
+
+    const VkSemaphore          waitSemaphore   = reinterpret_cast<VkSemaphore>(asyncCompute->waitSemaphore);
+    const VkSemaphore          signalSemaphore = reinterpret_cast<VkSemaphore>(asyncCompute->signalSemaphore);
+    const VkPipelineStageFlags waitStageMask   = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType                         = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount       = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    timelineInfo.pWaitSemaphoreValues          = &asyncCompute->waitValue;
+    timelineInfo.signalSemaphoreValueCount     = signalSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    timelineInfo.pSignalSemaphoreValues        = &asyncCompute->signalValue;
+
+    VkSubmitInfo submitInfo         = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext                = &timelineInfo;
+    submitInfo.waitSemaphoreCount   = timelineInfo.waitSemaphoreValueCount;
+    submitInfo.pWaitSemaphores      = &waitSemaphore;
+    submitInfo.pWaitDstStageMask    = &waitStageMask;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &asyncCommandBuffer;
+    submitInfo.signalSemaphoreCount = timelineInfo.signalSemaphoreValueCount;
+    submitInfo.pSignalSemaphores    = &signalSemaphore;
+
+    FFX_RETURN_ON_ERROR(backendContext->vkFunctionTable.vkResetFences(backendContext->device, 1, &fence) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+    FFX_RETURN_ON_ERROR(
+        backendContext->vkFunctionTable.vkQueueSubmit(reinterpret_cast<VkQueue>(asyncCompute->queue), 1, &submitInfo, fence) == VK_SUCCESS,
+        FFX_ERROR_BACKEND_API_ERROR);
+
+    effectContext.asyncFrameIndex = (slot + 1) % FFX_MAX_QUEUED_FRAMES;
 
     return FFX_OK;
 }
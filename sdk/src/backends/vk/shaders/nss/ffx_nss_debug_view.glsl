@@ -4,7 +4,13 @@
 #version 460
 #extension GL_EXT_samplerless_texture_functions : require
 #extension GL_GOOGLE_include_directive : require
+// Without tensor support the tensors are storage buffers of packed int8 values.
+#if TENSORS_AS_BUFFERS
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
+#else
 #extension GL_ARM_tensors : require
+#endif
 
 #if FFX_HALF
 #extension GL_EXT_shader_8bit_storage : require
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#version 460
+#extension GL_EXT_samplerless_texture_functions : require
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
+#extension GL_EXT_integer_dot_product : require
+
+#if FFX_HALF
+#extension GL_EXT_shader_16bit_storage : require
+#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require
+#extension GL_EXT_shader_explicit_arithmetic_types_float32 : require
+#endif
+
+#define NSS_BIND_SRV_NETWORK_INPUT_0    0  // FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_0
+#define NSS_BIND_SRV_NETWORK_INPUT_1    1  // FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_1
+#define NSS_BIND_SRV_NETWORK_PARAMETERS 2  // FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_PARAMETERS
+#define NSS_BIND_UAV_NETWORK_OUTPUT     3  // FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_OUTPUT
+
+#include "nss/ffx_nss_callbacks_glsl.h"
+#include "nss/ffx_nss_network.h"
+
+#ifndef FFX_NSS_THREAD_GROUP_WIDTH
+#define FFX_NSS_THREAD_GROUP_WIDTH 8
+#endif // FFX_NSS_THREAD_GROUP_WIDTH
+#ifndef FFX_NSS_THREAD_GROUP_HEIGHT
+#define FFX_NSS_THREAD_GROUP_HEIGHT 8
+#endif // FFX_NSS_THREAD_GROUP_HEIGHT
+#ifndef FFX_NSS_THREAD_GROUP_DEPTH
+#define FFX_NSS_THREAD_GROUP_DEPTH 1
+#endif // FFX_NSS_THREAD_GROUP_DEPTH
+#ifndef FFX_NSS_NUM_THREADS
+#define FFX_NSS_NUM_THREADS layout (local_size_x = FFX_NSS_THREAD_GROUP_WIDTH, local_size_y = FFX_NSS_THREAD_GROUP_HEIGHT, local_size_z = FFX_NSS_THREAD_GROUP_DEPTH) in;
+#endif // FFX_NSS_NUM_THREADS
+
+FFX_NSS_NUM_THREADS
+void main()
+{
+    NetworkLayer(int32_t3(gl_GlobalInvocationID));
+}
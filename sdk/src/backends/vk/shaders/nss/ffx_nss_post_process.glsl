@@ -4,7 +4,13 @@
 #version 460
 #extension GL_EXT_samplerless_texture_functions : require
 #extension GL_GOOGLE_include_directive : require
+// Without tensor support the tensors are storage buffers of packed int8 values.
+#if TENSORS_AS_BUFFERS
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
+#else
 #extension GL_ARM_tensors : require
+#endif
 
 #if FFX_HALF
 #extension GL_EXT_shader_8bit_storage : require
@@ -26,9 +32,11 @@
 #define NSS_BIND_SRV_K3_TENSOR                          6    // FFX_NSS_RESOURCE_IDENTIFIER_K3_TENSOR
 #define NSS_BIND_SRV_K4_TENSOR                          7    // FFX_NSS_RESOURCE_IDENTIFIER_K4_TENSOR
 #define NSS_BIND_SRV_NEAREST_DEPTH_COORD                8    // FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD
-#define NSS_BIND_UAV_UPSCALED_OUTPUT                    9    // FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT
+#define NSS_BIND_SRV_COEFFICIENT_UV                     9    // FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV
+#define NSS_BIND_UAV_UPSCALED_OUTPUT                    10   // FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT
+#define NSS_BIND_UAV_UNPADDED_OUTPUT                    11   // FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT
 
-#define NSS_BIND_CB_NSS                                 10
+#define NSS_BIND_CB_NSS                                 12
 
 // settings
 #ifndef HISTORY_CATMULL
@@ -4,7 +4,13 @@
 #version 460
 #extension GL_EXT_samplerless_texture_functions : require
 #extension GL_GOOGLE_include_directive : require
+// Without tensor support the tensors are storage buffers of packed int8 values.
+#if TENSORS_AS_BUFFERS
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int8 : require
+#else
 #extension GL_ARM_tensors : require
+#endif
 
 #if FFX_HALF
 #extension GL_EXT_shader_8bit_storage : require
@@ -23,11 +29,13 @@
 #define NSS_BIND_SRV_INPUT_DEPTH_TM1                    5   // FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1
 #define NSS_BIND_SRV_LUMA_DERIV_TM1                     6   // FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV
 #define NSS_BIND_SRV_NEAREST_DEPTH_COORD_TM1            7   // FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_TM1
+#define NSS_BIND_SRV_COEFFICIENT_UV_TM1                 8   // FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_TM1
 #define NSS_BIND_UAV_PREPROCESS_INPUT_TENSOR            9   // FFX_NSS_RESOURCE_IDENTIFIER_PREPROCESS_INPUT_TENSOR
 #define NSS_BIND_UAV_LUMA_DERIV                         10  // FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV
 #define NSS_BIND_UAV_NEAREST_DEPTH_COORD                11  // FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD
+#define NSS_BIND_UAV_COEFFICIENT_UV                     12  // FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV
 
-#define NSS_BIND_CB_NSS                                 12
+#define NSS_BIND_CB_NSS                                 13
 
 #include "nss/ffx_nss_callbacks_glsl.h"
 #include "nss/ffx_nss_preprocess.h"
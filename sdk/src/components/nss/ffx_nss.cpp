@@ -25,7 +25,9 @@
 #include <cfloat>     // for FLT_EPSILON
 #include <cmath>      // for fabs, abs, sinf, sqrt, etc.
 #include <string.h>   // for memset
+#include <cstddef>    // for offsetof
 #include <cstdint>
+#include <cstdlib>    // for mbstowcs
 
 #include "FidelityFX/host/ffx_nss.h"
 #define FFX_CPU
@@ -42,6 +44,11 @@
 #include "ffx_nss_private.h"
 #include <tuple>
 #include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
 
 // max queued frames for descriptor management
 static const uint32_t NSS_MAX_QUEUED_FRAMES = 16;
@@ -49,6 +56,9 @@ static const uint32_t NSS_MAX_QUEUED_FRAMES = 16;
 // threashold for whether we should use scale preset mode
 static constexpr float SCALE_PRESET_MODE_THRESHOLD = 0.01;
 
+// size of the constants pushed by the push constant permutation: the common constants followed by the 16bit parameters
+static constexpr uint32_t NSS_PUSH_CONSTANTS_SIZE = offsetof(NssConstants, dynamicPrecision) + sizeof(NssConstants16bitParameters);
+
 // lists to map shader resource bindpoint name to resource identifier
 typedef struct ResourceBinding
 {
@@ -71,6 +81,8 @@ static const ResourceBinding srvTextureBindingTable[] = {
     {FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR, L"r_prev_upscaled_color"},
     {FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD, L"r_input_nearest_depth_coord"},
     {FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_TM1, L"r_input_nearest_depth_coord_tm1"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV, L"r_coefficient_uv"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_TM1, L"r_coefficient_uv_tm1"},
 
     // Aliased tensors
     {FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR, L"r_prev_feedback_tensor"},
@@ -85,8 +97,10 @@ static const ResourceBinding srvTextureBindingTable[] = {
 static const ResourceBinding nssUavTextureBindingTable[] = {
     {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV, L"rw_luma_deriv"},
     {FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT, L"rw_upscaled_output"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT, L"rw_unpadded_output"},
     {FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD, L"rw_nearest_depth_coord_out"},
     {FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS, L"rw_debug_views"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV, L"rw_coefficient_uv"},
 
     // For mirror padding
     {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR, L"rw_input_color_jittered"},
@@ -119,6 +133,31 @@ static const ResourceBinding uavTensorBindingTable[] = {
     {FFX_NSS_RESOURCE_IDENTIFIER_K0_TENSOR, L"Resource_6_output"},
 };
 
+// Number of uavTensorBindingTable entries bound by shaders, the data graph interface follows them.
+static constexpr uint32_t NSS_SHADER_UAV_TENSOR_BINDING_COUNT = 1;
+
+// Without tensor support the tensors are storage buffers, which the shaders bind by the same names.
+static const ResourceBinding srvBufferBindingTable[] = {
+    {FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR, L"r_prev_feedback_tensor"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_K0_TENSOR, L"r_coefficients_k0_tensor"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_K1_TENSOR, L"r_coefficients_k1_tensor"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_K2_TENSOR, L"r_coefficients_k2_tensor"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_K3_TENSOR, L"r_coefficients_k3_tensor"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_K4_TENSOR, L"r_coefficients_k4_tensor"},
+
+    // Compute shader network
+    {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_0, L"r_network_input_0"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_1, L"r_network_input_1"},
+    {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_PARAMETERS, L"r_network_parameters"},
+};
+
+static const ResourceBinding uavBufferBindingTable[] = {
+    {FFX_NSS_RESOURCE_IDENTIFIER_PREPROCESS_INPUT_TENSOR, L"rw_preprocessed_tensor"},
+
+    // Compute shader network
+    {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_OUTPUT, L"rw_network_output"},
+};
+
 #define FFX_LENGTH(x, y) (sqrt((x) * (x) + (y) * (y)))
 
 static void nssDebugCheckDispatch(FfxNssContext_Private* context, const FfxNssDispatchDescription* params)
@@ -206,7 +245,7 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
+        uint32_t mapIndex = 0;
         for (mapIndex = 0; mapIndex < FFX_COUNTOF(srvTextureBindingTable); ++mapIndex)
         {
             if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
@@ -220,7 +259,7 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
+        uint32_t mapIndex = 0;
         for (mapIndex = 0; mapIndex < FFX_COUNTOF(nssUavTextureBindingTable); ++mapIndex)
         {
             if (0 == wcscmp(nssUavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
@@ -232,9 +271,37 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = nssUavTextureBindingTable[mapIndex].index;
     }
 
+    for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvBufferCount; ++srvIndex)
+    {
+        uint32_t mapIndex = 0;
+        for (mapIndex = 0; mapIndex < FFX_COUNTOF(srvBufferBindingTable); ++mapIndex)
+        {
+            if (0 == wcscmp(srvBufferBindingTable[mapIndex].name, inoutPipeline->srvBufferBindings[srvIndex].name))
+                break;
+        }
+        if (mapIndex == FFX_COUNTOF(srvBufferBindingTable))
+            return FFX_ERROR_INVALID_ARGUMENT;
+
+        inoutPipeline->srvBufferBindings[srvIndex].resourceIdentifier = srvBufferBindingTable[mapIndex].index;
+    }
+
+    for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
+    {
+        uint32_t mapIndex = 0;
+        for (mapIndex = 0; mapIndex < FFX_COUNTOF(uavBufferBindingTable); ++mapIndex)
+        {
+            if (0 == wcscmp(uavBufferBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
+                break;
+        }
+        if (mapIndex == FFX_COUNTOF(uavBufferBindingTable))
+            return FFX_ERROR_INVALID_ARGUMENT;
+
+        inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavBufferBindingTable[mapIndex].index;
+    }
+
     for (uint32_t tensorIndex = 0; tensorIndex < inoutPipeline->srvTensorCount; ++tensorIndex)
     {
-        int32_t mapIndex = 0;
+        uint32_t mapIndex = 0;
         for (mapIndex = 0; mapIndex < FFX_COUNTOF(srvTensorBindingTable); ++mapIndex)
         {
             if (0 == wcscmp(srvTensorBindingTable[mapIndex].name, inoutPipeline->srvTensorBindings[tensorIndex].name))
@@ -248,7 +315,7 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t tensorIndex = 0; tensorIndex < inoutPipeline->uavTensorCount; ++tensorIndex)
     {
-        int32_t mapIndex = 0;
+        uint32_t mapIndex = 0;
         for (mapIndex = 0; mapIndex < FFX_COUNTOF(uavTensorBindingTable); ++mapIndex)
         {
             if (0 == wcscmp(uavTensorBindingTable[mapIndex].name, inoutPipeline->uavTensorBindings[tensorIndex].name))
@@ -263,6 +330,12 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     return FFX_OK;
 }
 
+// The 16bit constants can be pushed instead of bound as a constant buffer, if the device allows it.
+static bool pushConstantsSupported(const FfxNssContext_Private* context)
+{
+    return context->deviceCapabilities.pushConstant16BitSupported && NSS_PUSH_CONSTANTS_SIZE <= context->deviceCapabilities.maxPushConstantsSize;
+}
+
 static uint32_t getPipelinePermutationFlags(FfxNssContext_Private* context, const float upscaleRatio)
 {
     FFX_ASSERT(context);
@@ -275,6 +348,12 @@ static uint32_t getPipelinePermutationFlags(FfxNssContext_Private* context, cons
     flags |= (contextFlags & FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED) ? NSS_SHADER_PERMUTATION_REVERSE_Z : 0;
     flags |= (contextFlags & FFX_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC) ? NSS_SHADER_PERMUTATION_RESAMPLE_BICUBIC : 0;
     flags |= (contextFlags & FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES) ? NSS_SHADER_PERMUTATION_ALIAS_OUTPUT_TENSORS_AS_IMAGES : 0;
+    flags |= context->fusedPadding ? NSS_SHADER_PERMUTATION_FUSED_PADDING : 0;
+    flags |= (context->networkInterval > 1) ? NSS_SHADER_PERMUTATION_WARP_COEFFICIENTS : 0;
+
+    // Without tensor support the tensors are storage buffers, which can't be read as images.
+    if (context->computeNetwork)
+        flags = (flags | NSS_SHADER_PERMUTATION_TENSORS_AS_BUFFERS) & ~NSS_SHADER_PERMUTATION_ALIAS_OUTPUT_TENSORS_AS_IMAGES;
 
     const bool require16bit = (contextFlags & FFX_NSS_CONTEXT_FLAG_ALLOW_16BIT) != 0;
     if (require16bit)
@@ -282,6 +361,10 @@ static uint32_t getPipelinePermutationFlags(FfxNssContext_Private* context, cons
         if (fp16Supported)
         {
             flags |= NSS_SHADER_PERMUTATION_ALLOW_16BIT;
+
+            // Recorded command buffers update the constants in place, which only works for constant buffers
+            const bool reuseCommandBuffers = (contextFlags & FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS) != 0;
+            flags |= (pushConstantsSupported(context) && !reuseCommandBuffers) ? NSS_SHADER_PERMUTATION_PUSH_CONSTANTS : 0;
         }
         else
         {
@@ -300,13 +383,71 @@ static uint32_t getPipelinePermutationFlags(FfxNssContext_Private* context, cons
     return flags;
 }
 
-static FfxErrorCode createPipelineStates(FfxNssContext_Private* context)
+// Hands over the pipeline ffxNssContextWarmupPipelines() kept for a permutation, false when there is none.
+static bool takeWarmedPipeline(FfxNssContext_Private* context, FfxPass pass, uint32_t pipelineFlags, FfxPipelineState* outPipeline)
+{
+    std::lock_guard<std::mutex> lock{context->warmedPipelineMutex};
+    for (uint32_t warmedIndex = 0; warmedIndex < context->warmedPipelineCount; ++warmedIndex)
+    {
+        NssWarmedPipeline& warmed = context->warmedPipelines[warmedIndex];
+        if (warmed.pass == pass && warmed.pipelineFlags == pipelineFlags)
+        {
+            *outPipeline = warmed.pipeline;
+            warmed       = context->warmedPipelines[--context->warmedPipelineCount];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Builds a data graph pipeline without binding its tensors, see createDataGraphPipeline() and createSegmentPipeline().
+static FfxErrorCode buildDataGraphPipeline(FfxNssContext_Private*  context,
+                                           uint32_t                pipelineFlags,
+                                           const FfxDataGraphBlob* dataGraphBlob,
+                                           FfxPipelineState*       outPipeline)
 {
     FFX_ASSERT(context);
 
-    const uint32_t width        = context->paddedInputWidth;
-    const uint32_t height       = context->paddedInputHeight;
-    const float    upscaleRatio = static_cast<float>(context->paddedOutputWidth) / static_cast<float>(context->paddedInputWidth);
+    const uint32_t width  = context->paddedInputWidth;
+    const uint32_t height = context->paddedInputHeight;
+
+    FfxPipelineDescription pipelineDescription = {};
+    pipelineDescription.contextFlags           = context->contextDescription.flags;
+    pipelineDescription.dataGraphBlob          = dataGraphBlob;
+    pipelineDescription.batchSize              = context->viewCount;
+    wcscpy(pipelineDescription.name, L"NSS-Graph");
+
+    FFX_ASSERT_MESSAGE(width % FFX_NSS_RESOURCE_ALIGNMENT == 0 && height % FFX_NSS_RESOURCE_ALIGNMENT == 0,
+                       "The NSS algorithm requires the input resolution must be 8 aligned!");
+    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreateDataGraphPipeline(&context->contextDescription.backendInterface,
+                                                                                        FFX_EFFECT_NSS,
+                                                                                        FFX_NSS_PASS_DATA_GRAPH,
+                                                                                        pipelineFlags,
+                                                                                        &pipelineDescription,
+                                                                                        context->effectContextId,
+                                                                                        width,
+                                                                                        height,
+                                                                                        outPipeline));
+    return FFX_OK;
+}
+
+static FfxErrorCode createDataGraphPipeline(FfxNssContext_Private*  context,
+                                           uint32_t                pipelineFlags,
+                                           const FfxDataGraphBlob* dataGraphBlob,
+                                           FfxPipelineState*       outPipeline)
+{
+    // Only the built-in model is warmed up
+    if (dataGraphBlob == nullptr && takeWarmedPipeline(context, FFX_NSS_PASS_DATA_GRAPH, pipelineFlags, outPipeline))
+        return FFX_OK;
+
+    FFX_VALIDATE(buildDataGraphPipeline(context, pipelineFlags, dataGraphBlob, outPipeline));
+    return patchResourceBindings(outPipeline);
+}
+
+static FfxErrorCode buildComputePipeline(
+    FfxNssContext_Private* context, FfxPass pass, uint32_t pipelineFlags, const wchar_t* name, FfxPipelineState* pipeline)
+{
+    FFX_ASSERT(context);
 
     FfxPipelineDescription pipelineDescription = {};
     pipelineDescription.contextFlags           = context->contextDescription.flags;
@@ -318,196 +459,1073 @@ static FfxErrorCode createPipelineStates(FfxNssContext_Private* context)
         {FFX_FILTER_TYPE_MINMAGMIP_LINEAR, FFX_ADDRESS_MODE_CLAMP, FFX_ADDRESS_MODE_CLAMP, FFX_ADDRESS_MODE_CLAMP, FFX_BIND_COMPUTE_SHADER_STAGE}};
     pipelineDescription.samplers = samplerDescs;
 
-    // Set up pipeline descriptor (basically RootSignature and binding)
-    uint32_t pipelineFlags = getPipelinePermutationFlags(context, upscaleRatio);
-
     // Root constants
     pipelineDescription.rootConstantBufferCount     = 1;
     FfxRootConstantDescription rootConstantDescs[1] = {{sizeof(NssConstants) / sizeof(uint32_t), FFX_BIND_COMPUTE_SHADER_STAGE}};
     pipelineDescription.rootConstants               = rootConstantDescs;
+    pipelineDescription.pushConstantSize            = (pipelineFlags & NSS_SHADER_PERMUTATION_PUSH_CONSTANTS) ? NSS_PUSH_CONSTANTS_SIZE : 0;
+
+    // The quantization of the model is folded into the shaders
+    pipelineDescription.specializationConstants     = reinterpret_cast<const uint32_t*>(&context->quantization);
+    pipelineDescription.specializationConstantCount = NSS_SPECIALIZATION_CONSTANT_COUNT;
+
+    // The network layers only read push constants, every layer is a dispatch of the same pipeline.
+    if (pass == FFX_NSS_PASS_NETWORK)
+    {
+        pipelineDescription.rootConstantBufferCount = 0;
+        pipelineDescription.pushConstantSize        = sizeof(NssNetworkLayerConstants);
+        pipelineDescription.dispatchesPerFrame      = FFX_NSS_NETWORK_MAX_LAYERS;
+    }
 
-    const auto CreatePipeline = [&](FfxPass pass, const wchar_t* name, FfxPipelineState* pipeline) -> FfxErrorCode {
-        ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pipeline, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pipeline, context->effectContextId);
 
-        wcscpy_s(pipelineDescription.name, name);
+    wcscpy_s(pipelineDescription.name, name);
 
-        FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(
-            &context->contextDescription.backendInterface, FFX_EFFECT_NSS, pass, pipelineFlags, &pipelineDescription, context->effectContextId, pipeline));
-        patchResourceBindings(pipeline);
+    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(&context->contextDescription.backendInterface,
+                                                                               FFX_EFFECT_NSS,
+                                                                               pass,
+                                                                               pipelineFlags,
+                                                                               &pipelineDescription,
+                                                                               context->effectContextId,
+                                                                               pipeline));
+    patchResourceBindings(pipeline);
+
+    return FFX_OK;
+}
 
+static FfxErrorCode createComputePipeline(
+    FfxNssContext_Private* context, FfxPass pass, uint32_t pipelineFlags, const wchar_t* name, FfxPipelineState* pipeline)
+{
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pipeline, context->effectContextId);
+    if (takeWarmedPipeline(context, pass, pipelineFlags, pipeline))
         return FFX_OK;
-    };
 
-    if (context->hasPaddingPass)
+    return buildComputePipeline(context, pass, pipelineFlags, name, pipeline);
+}
+
+// Finds the entry of uavTensorBindingTable a tensor of a model binds to, FFX_COUNTOF(uavTensorBindingTable) when there is none.
+static uint32_t findTensorBinding(const char* tensorName)
+{
+    wchar_t name[64] = {};
+    mbstowcs(name, tensorName, FFX_COUNTOF(name) - 1);
+
+    uint32_t mapIndex = 0;
+    for (mapIndex = 0; mapIndex < FFX_COUNTOF(uavTensorBindingTable); ++mapIndex)
     {
-        FFX_VALIDATE(CreatePipeline(FFX_NSS_PASS_MIRROR_PADDING, L"NSS-MirrorPadding", &context->pipelineNssMirrorPadding));
+        if (0 == wcscmp(uavTensorBindingTable[mapIndex].name, name))
+            break;
     }
-    FFX_VALIDATE(CreatePipeline(FFX_NSS_PASS_PREPROCESS, L"NSS-Preprocess", &context->pipelineNssPreprocess));
-    FFX_VALIDATE(CreatePipeline(FFX_NSS_PASS_POSTPROCESS, L"NSS-Postprocess", &context->pipelineNssPostprocess));
-    FFX_VALIDATE(CreatePipeline(FFX_NSS_PASS_DEBUG_VIEW, L"NSS-DebugView", &context->pipelineNssDebugView));
+    return mapIndex;
+}
 
-    // DATA GRAPH
-    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraph, context->effectContextId);
-    wcscpy(pipelineDescription.name, L"NSS-Graph");
-    FFX_ASSERT_MESSAGE(width % FFX_NSS_RESOURCE_ALIGNMENT == 0 && height % FFX_NSS_RESOURCE_ALIGNMENT == 0,
-                       "The NSS algorithm requires the input resolution must be 8 aligned!");
-    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreateDataGraphPipeline(&context->contextDescription.backendInterface,
-                                                                                        FFX_EFFECT_NSS,
-                                                                                        FFX_NSS_PASS_DATA_GRAPH,
-                                                                                        pipelineFlags,
-                                                                                        &pipelineDescription,
-                                                                                        context->effectContextId,
-                                                                                        width,
-                                                                                        height,
-                                                                                        &context->pipelineNssDataGraph));
-    patchResourceBindings(&context->pipelineNssDataGraph);
-    // END DATA GRAPH
+// The tensor a segment binds, one of the graph interface or the intermediate tensor createSegmentResources() stored it in.
+static uint32_t getSegmentTensorResourceId(const FfxNssContext_Private* context, const FfxDataGraphSegment& segment, uint32_t tensorIndex)
+{
+    const uint32_t mapIndex = findTensorBinding(segment.tensorNames[tensorIndex]);
+    if (mapIndex < FFX_COUNTOF(uavTensorBindingTable))
+        return uavTensorBindingTable[mapIndex].index;
+
+    for (uint32_t intermediateIndex = 0; intermediateIndex < context->segmentIntermediateCount; ++intermediateIndex)
+    {
+        if (context->segmentIntermediateIndices[intermediateIndex] == segment.tensorResources[tensorIndex])
+            return context->segmentIntermediateResourceIds[intermediateIndex];
+    }
+    return FFX_NSS_RESOURCE_IDENTIFIER_COUNT;
+}
+
+// Creates the pipeline of a segment of a model exported from several modules, bound to the tensors of the segment.
+static FfxErrorCode createSegmentPipeline(FfxNssContext_Private* context, uint32_t segmentIndex, FfxPipelineState* outPipeline)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(segmentIndex < context->segmentCount);
+
+    const FfxDataGraphSegment& segment = context->segments[segmentIndex];
+    if (segment.type == FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH)
+    {
+        FFX_VALIDATE(buildDataGraphPipeline(context, context->pipelinePermutationFlags, segment.graph, outPipeline));
+    }
+    else
+    {
+        // The compute shaders of a model only bind tensors, one per binding.
+        const std::vector<uint32_t> tensorCounts(segment.tensorNums, 1);
+        const FfxShaderBlob         shaderBlob = {segment.code, segment.codeSize, 0, 0, 0, 0, 0, 0, 0, 0, 0, segment.tensorNums,
+                                                 nullptr, nullptr, nullptr, nullptr,  // constant buffers
+                                                 nullptr, nullptr, nullptr, nullptr,  // srv textures
+                                                 nullptr, nullptr, nullptr, nullptr,  // uav textures
+                                                 nullptr, nullptr, nullptr, nullptr,  // srv buffers
+                                                 nullptr, nullptr, nullptr, nullptr,  // uav buffers
+                                                 nullptr, nullptr, nullptr, nullptr,  // samplers
+                                                 nullptr, nullptr, nullptr, nullptr,  // rt acceleration structures
+                                                 nullptr, nullptr, nullptr, nullptr,  // rt textures
+                                                 nullptr, nullptr, nullptr, nullptr,  // srv tensors
+                                                 segment.tensorNames, segment.tensorBindings, tensorCounts.data(), segment.tensorSets};
+
+        FfxPipelineDescription pipelineDescription = {};
+        pipelineDescription.contextFlags           = context->contextDescription.flags;
+        pipelineDescription.shaderBlob             = &shaderBlob;
+        pipelineDescription.entryPoint             = segment.entryPoint;
+        wcscpy_s(pipelineDescription.name, L"NSS-Segment");
+
+        FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(&context->contextDescription.backendInterface,
+                                                                                   FFX_EFFECT_NSS,
+                                                                                   FFX_NSS_PASS_DATA_GRAPH,
+                                                                                   context->pipelinePermutationFlags,
+                                                                                   &pipelineDescription,
+                                                                                   context->effectContextId,
+                                                                                   outPipeline));
+    }
+
+    // Both kinds of pipeline bind every tensor as a UAV, at the binding of the segment's tensor.
+    for (uint32_t bindingIndex = 0; bindingIndex < outPipeline->uavTensorCount; ++bindingIndex)
+    {
+        FfxResourceBinding& binding    = outPipeline->uavTensorBindings[bindingIndex];
+        uint32_t            resourceId = FFX_NSS_RESOURCE_IDENTIFIER_COUNT;
+        for (uint32_t tensorIndex = 0; tensorIndex < segment.tensorNums; ++tensorIndex)
+        {
+            if (segment.tensorBindings[tensorIndex] == binding.slotIndex)
+                resourceId = getSegmentTensorResourceId(context, segment, tensorIndex);
+        }
+        FFX_RETURN_ON_ERROR(resourceId != FFX_NSS_RESOURCE_IDENTIFIER_COUNT, FFX_ERROR_INVALID_ARGUMENT);
+
+        binding.resourceIdentifier = resourceId;
+    }
 
     return FFX_OK;
 }
 
-static FfxErrorCode createResourceFromDescription(FfxNssContext_Private* context, const FfxInternalResourceDescription* resDesc)
+// Creates the pipelines of the network passes. These are the expensive ones, which
+// are created on a background thread with FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION.
+static FfxErrorCode createPipelineStates(FfxNssContext_Private* context)
 {
-    const FfxResourceType        resourceType        = resDesc->type;
-    const FfxResourceDescription resourceDescription = {resourceType,
-                                                        resDesc->format,
-                                                        resDesc->width,
-                                                        resDesc->height,
-                                                        (resourceType == FFX_RESOURCE_TYPE_TENSOR) ? resDesc->channel : 1,
-                                                        resDesc->mipCount,
-                                                        resDesc->flags,
-                                                        resDesc->usage,
-                                                        resDesc->batchSize,
-                                                        resDesc->shapeSize};
-    const FfxResourceStates      initialState =
-        (resDesc->usage == FFX_RESOURCE_USAGE_READ_ONLY) ? FFX_RESOURCE_STATE_COMPUTE_READ : FFX_RESOURCE_STATE_UNORDERED_ACCESS;
-    const FfxCreateResourceDescription createResourceDescription = {
-        FFX_HEAP_TYPE_DEFAULT, resourceDescription, initialState, resDesc->name, resDesc->id, resDesc->initData};
-    return context->contextDescription.backendInterface.fpCreateResource(
-        &context->contextDescription.backendInterface, &createResourceDescription, context->effectContextId, &context->srvResources[resDesc->id]);
+    FFX_ASSERT(context);
+
+    const uint32_t pipelineFlags = context->pipelinePermutationFlags;
+
+    FFX_VALIDATE(createComputePipeline(context, FFX_NSS_PASS_PREPROCESS, pipelineFlags, L"NSS-Preprocess", &context->pipelineNssPreprocess));
+    FFX_VALIDATE(createComputePipeline(context, FFX_NSS_PASS_POSTPROCESS, pipelineFlags, L"NSS-Postprocess", &context->pipelineNssPostprocess));
+    FFX_VALIDATE(createComputePipeline(context, FFX_NSS_PASS_DEBUG_VIEW, pipelineFlags, L"NSS-DebugView", &context->pipelineNssDebugView));
+
+    if (context->computeNetwork)
+    {
+        FFX_VALIDATE(createComputePipeline(context, FFX_NSS_PASS_NETWORK, pipelineFlags, L"NSS-Network", &context->pipelineNssNetwork));
+    }
+    else if (context->segmentCount > 0)
+    {
+        for (uint32_t segmentIndex = 0; segmentIndex < context->segmentCount; ++segmentIndex)
+        {
+            FFX_VALIDATE(createSegmentPipeline(context, segmentIndex, &context->pipelineNssSegments[segmentIndex]));
+        }
+    }
+    else
+    {
+        // DATA GRAPH
+        ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraph, context->effectContextId);
+        FFX_VALIDATE(createDataGraphPipeline(context, pipelineFlags, nullptr, &context->pipelineNssDataGraph));
+        // END DATA GRAPH
+    }
+
+    return FFX_OK;
 }
 
-/// Computes the padded input and output resolutions based on unpadded resolutions.
-///
-/// @param unpaddedInputWidth      Unpadded input width.
-/// @param unpaddedInputHeight     Unpadded input height.
-/// @param unpaddedOutputWidth     Unpadded output width.
-/// @param unpaddedOutputHeight    Unpadded output height.
-/// @param paddedInputWidth        [out] Padded input width.
-/// @param paddedInputHeight       [out] Padded input height.
-/// @param paddedOutputWidth       [out] Padded output width.
-/// @param paddedOutputHeight      [out] Padded output height.
-///
-/// @return True if any of the padded dimensions differ from the unpadded dimensions, false otherwise.
-static bool ComputePaddedResolution(const uint32_t unpaddedInputWidth,
-                                    const uint32_t unpaddedInputHeight,
-                                    const uint32_t unpaddedOutputWidth,
-                                    const uint32_t unpaddedOutputHeight,
-                                    uint32_t&      paddedInputWidth,
-                                    uint32_t&      paddedInputHeight,
-                                    uint32_t&      paddedOutputWidth,
-                                    uint32_t&      paddedOutputHeight)
+static void createPipelineStatesInBackground(FfxNssContext_Private* context)
 {
-    paddedInputWidth           = FFX_ALIGN_UP(unpaddedInputWidth, FFX_NSS_RESOURCE_ALIGNMENT);
-    paddedInputHeight          = FFX_ALIGN_UP(unpaddedInputHeight, FFX_NSS_RESOURCE_ALIGNMENT);
-    const float upscaleFactorX = static_cast<float>(unpaddedOutputWidth) / static_cast<float>(unpaddedInputWidth);
-    const float upscaleFactorY = static_cast<float>(unpaddedOutputHeight) / static_cast<float>(unpaddedInputHeight);
+    context->pipelineCreationResult = createPipelineStates(context);
+    context->pipelineCreationDone.store(true, std::memory_order_release);
+}
 
-    // TODO: does the output require the alignment?
-    paddedOutputWidth  = FFX_ALIGN_UP(static_cast<uint32_t>(paddedInputWidth * upscaleFactorX), FFX_NSS_RESOURCE_ALIGNMENT);
-    paddedOutputHeight = FFX_ALIGN_UP(static_cast<uint32_t>(paddedInputHeight * upscaleFactorY), FFX_NSS_RESOURCE_ALIGNMENT);
+static bool pipelinesReady(FfxNssContext_Private* context)
+{
+    return context->pipelineCreationDone.load(std::memory_order_acquire) && context->pipelineCreationResult == FFX_OK;
+}
 
-    return paddedInputWidth != unpaddedInputWidth || paddedInputHeight != unpaddedInputHeight || paddedOutputWidth != unpaddedOutputWidth ||
-           paddedOutputHeight != unpaddedOutputHeight;
+// The background creation writes the context's pipelines, so it has to finish
+// before anything else may replace or release them.
+static void waitForPipelineCreation(FfxNssContext_Private* context)
+{
+    if (context->pipelineCreationThread.joinable())
+    {
+        context->pipelineCreationThread.join();
+    }
 }
 
-static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContextDescription* contextDescription)
+// A model set through ffxNssContextSetModel(), copied so its pipeline can be built after the call has returned.
+struct NssDataGraphCopy
 {
-    FFX_ASSERT(context);
-    FFX_ASSERT(contextDescription);
+    std::vector<std::unique_ptr<uint8_t[]>> allocations;
+    std::unique_ptr<FfxDataGraphBlob>       dataGraph;
 
-    // Setup the data for implementation.
-    memset(context, 0, sizeof(FfxNssContext_Private));
-    context->device = contextDescription->backendInterface.device;
+    template <typename T>
+    T* copy(const T* data, size_t count)
+    {
+        if (data == nullptr || count == 0)
+            return nullptr;
 
-    memcpy(&context->contextDescription, contextDescription, sizeof(FfxNssContextDescription));
+        allocations.emplace_back(new uint8_t[count * sizeof(T)]);
+        memcpy(allocations.back().get(), data, count * sizeof(T));
+        return reinterpret_cast<T*>(allocations.back().get());
+    }
+};
 
-    // Create the context.
-    FfxErrorCode errorCode = context->contextDescription.backendInterface.fpCreateBackendContext(
-        &context->contextDescription.backendInterface, FFX_EFFECT_NSS, nullptr, &context->effectContextId);
-    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+// The size of the data of a constant, which constantDataSize gives once expanded for a compressed one. 0 when the sparsity doesn't fit the shape.
+static size_t getDataGraphConstantStoredSize(const FfxDataGraphBlob& dataGraph, uint32_t constantIndex)
+{
+    const uint32_t dataSize = dataGraph.constantDataSize[constantIndex];
+    if (!ffxDataGraphConstantIsCompressed(dataGraph, constantIndex))
+        return dataSize;
+
+    const uint32_t rank      = dataGraph.constantShapeSize[constantIndex];
+    const int64_t* shape     = dataGraph.constantShapes[constantIndex];
+    const int64_t  dimension = dataGraph.constantSparsityDimensions[constantIndex];
+    const uint32_t zeroCount = dataGraph.constantSparsityZeroCounts[constantIndex];
+    const uint32_t groupSize = dataGraph.constantSparsityGroupSizes[constantIndex];
+    if (dimension < 0 || dimension >= int64_t(rank) || zeroCount >= groupSize || (shape[dimension] % groupSize) != 0)
+        return 0;
+
+    int64_t elementCount = 1;
+    for (uint32_t i = 0; i < rank; ++i)
+        elementCount *= shape[i];
+    if (elementCount == 0 || (dataSize % elementCount) != 0)
+        return 0;
+
+    const int64_t elementSize = dataSize / elementCount;
+    const int64_t groupCount  = elementCount / groupSize;
+    return size_t((groupCount * groupSize + 7) / 8 + groupCount * (groupSize - zeroCount) * elementSize);
+}
 
-    // call out for device caps.
-    errorCode =
-        context->contextDescription.backendInterface.fpGetDeviceCapabilities(&context->contextDescription.backendInterface, &context->deviceCapabilities);
-    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+// Copies a single graph model, nullptr when the sparsity of a constant doesn't fit its shape.
+static NssDataGraphCopy* copyDataGraph(const FfxDataGraphBlob& dataGraph)
+{
+    std::unique_ptr<NssDataGraphCopy> copy(new NssDataGraphCopy());
 
-    const bool neuralGraphicsSupported = context->deviceCapabilities.tensorSupported && context->deviceCapabilities.dataGraphSupported;
-    if (!neuralGraphicsSupported)
+    const uint32_t        constantNums   = dataGraph.constantNums;
+    const int64_t**       constantShapes = copy->copy(dataGraph.constantShapes, constantNums);
+    const unsigned char** constantDatas  = copy->copy(dataGraph.constantDatas, constantNums);
+    for (uint32_t constantIndex = 0; constantIndex < constantNums; ++constantIndex)
     {
-        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR,
-                                              L"NSS requires device with support for tensors and data graphs. "
-                                              L"Please check device capabilities.");
-        return FFX_ERROR_NULL_DEVICE;
+        const size_t storedSize = getDataGraphConstantStoredSize(dataGraph, constantIndex);
+        if (storedSize == 0 && dataGraph.constantDataSize[constantIndex] != 0)
+            return nullptr;
+
+        constantShapes[constantIndex] = copy->copy(dataGraph.constantShapes[constantIndex], dataGraph.constantShapeSize[constantIndex]);
+        constantDatas[constantIndex]  = copy->copy(dataGraph.constantDatas[constantIndex], storedSize);
     }
 
-    // set defaults
-    context->firstExecution     = true;
-    context->resourceFrameIndex = 0;
-    const bool needPaddingPass  = ComputePaddedResolution(contextDescription->maxRenderSize.width,
-                                                         contextDescription->maxRenderSize.height,
-                                                         contextDescription->maxUpscaleSize.width,
-                                                         contextDescription->maxUpscaleSize.height,
-                                                         context->paddedInputWidth,
-                                                         context->paddedInputHeight,
-                                                         context->paddedOutputWidth,
-                                                         context->paddedOutputHeight);
-    const bool hasPaddingFlag   = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING) == 0;
-    context->hasPaddingPass     = hasPaddingFlag && needPaddingPass;
+    const uint32_t   tensorNums  = dataGraph.tensorNums;
+    const char**     tensorNames = copy->copy(dataGraph.tensorNames, tensorNums);
+    const uint64_t** tensorDims  = copy->copy(dataGraph.tensorDims, tensorNums);
+    for (uint32_t tensorIndex = 0; tensorIndex < tensorNums; ++tensorIndex)
+    {
+        tensorNames[tensorIndex] = copy->copy(dataGraph.tensorNames[tensorIndex], strlen(dataGraph.tensorNames[tensorIndex]) + 1);
+        tensorDims[tensorIndex]  = copy->copy(dataGraph.tensorDims[tensorIndex], dataGraph.tensorDimSize[tensorIndex]);
+    }
 
-    // NOTE: This will not work for RHI-NNE Backend!
-    FfxSurfaceFormat tensorFormatSingleChannel = ((contextDescription->flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) == FFX_NSS_CONTEXT_FLAG_QUANTIZED)
-                                                     ? FFX_SURFACE_FORMAT_R8_SINT
-                                                     : FFX_SURFACE_FORMAT_R32_FLOAT;
+    FfxDataGraphShape* graphShapes = copy->copy(dataGraph.graphShapes, dataGraph.graphShapeNums);
+    for (uint32_t shapeIndex = 0; shapeIndex < dataGraph.graphShapeNums; ++shapeIndex)
+    {
+        const FfxDataGraphShape& graphShape   = dataGraph.graphShapes[shapeIndex];
+        const int64_t**          tensorShapes = copy->copy(graphShape.tensorShapes, tensorNums);
+        for (uint32_t tensorIndex = 0; tensorIndex < tensorNums; ++tensorIndex)
+            tensorShapes[tensorIndex] = copy->copy(graphShape.tensorShapes[tensorIndex], dataGraph.tensorDimSize[tensorIndex]);
+
+        new (&graphShapes[shapeIndex]) FfxDataGraphShape{graphShape.width,
+                                                         graphShape.height,
+                                                         graphShape.batchSize,
+                                                         graphShape.codeSize,
+                                                         copy->copy(graphShape.code, graphShape.codeSize),
+                                                         tensorShapes,
+                                                         graphShape.graphHash};
+    }
 
-    // NOTE: This will not work for RHI-NNE Backend!
-    FfxSurfaceFormat tensorFormatQuadChannel = ((contextDescription->flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) == FFX_NSS_CONTEXT_FLAG_QUANTIZED)
-                                                   ? FFX_SURFACE_FORMAT_R8_SINT
-                                                   : FFX_SURFACE_FORMAT_R32_FLOAT;
+    copy->dataGraph.reset(new FfxDataGraphBlob{constantNums,
+                                               copy->copy(dataGraph.constantIds, constantNums),
+                                               copy->copy(dataGraph.constantFormats, constantNums),
+                                               copy->copy(dataGraph.constantShapeSize, constantNums),
+                                               constantShapes,
+                                               copy->copy(dataGraph.constantSparsityDimensions, constantNums),
+                                               copy->copy(dataGraph.constantDataSize, constantNums),
+                                               constantDatas,
+                                               copy->copy(dataGraph.graphEntryPoint, strlen(dataGraph.graphEntryPoint) + 1),
+                                               dataGraph.graphDataSize,
+                                               copy->copy(dataGraph.graphData, dataGraph.graphDataSize),
+                                               tensorNums,
+                                               tensorNames,
+                                               copy->copy(dataGraph.tensorSets, tensorNums),
+                                               copy->copy(dataGraph.tensorBindings, tensorNums),
+                                               copy->copy(dataGraph.tensorFormats, tensorNums),
+                                               copy->copy(dataGraph.tensorDimSize, tensorNums),
+                                               tensorDims,
+                                               copy->copy(dataGraph.tensorQuantScales, tensorNums),
+                                               copy->copy(dataGraph.tensorQuantZeroPoints, tensorNums),
+                                               copy->copy(dataGraph.constantSparsityZeroCounts, constantNums),
+                                               copy->copy(dataGraph.constantSparsityGroupSizes, constantNums),
+                                               0,
+                                               nullptr,
+                                               dataGraph.graphShapeNums,
+                                               graphShapes});
+    return copy.release();
+}
 
-    const bool aliasTensorAsImage = (contextDescription->flags & FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES) == FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES;
+// The model creation thread writes pipelineNssDataGraphBuilt, so it has to finish before the pipeline is taken or released.
+static void waitForModelCreation(FfxNssContext_Private* context)
+{
+    if (context->modelCreationThread.joinable())
+    {
+        context->modelCreationThread.join();
+    }
+    delete context->modelDataGraph;
+    context->modelDataGraph = nullptr;
+}
 
-    uint32_t           inputTensorChannel        = 12;
-    constexpr uint32_t feedbackTensorChannel     = 4;
-    constexpr uint32_t coefficientsTensorChannel = 4;
-    // declare internal resources needed
-    const FfxInternalResourceDescription internalSurfaceDesc[] = {
-        {FFX_NSS_RESOURCE_IDENTIFIER_PREPROCESS_INPUT_TENSOR,
-         L"NSS_PreprocessInputTensor",
-         FFX_RESOURCE_TYPE_TENSOR,
-         FFX_RESOURCE_USAGE_UAV,
-         tensorFormatSingleChannel,
-         context->paddedInputWidth,
-         context->paddedInputHeight,
-         1,
-         FFX_RESOURCE_FLAGS_NONE,
-         {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
-         inputTensorChannel,
-         4},
+// The model parser records the Vulkan format of each tensor of a model.
+static uint32_t getDataGraphTensorFormat(FfxSurfaceFormat format)
+{
+    switch (format)
+    {
+    case FFX_SURFACE_FORMAT_R8_SINT:
+        return FFX_DATA_GRAPH_TENSOR_FORMAT_R8_SINT;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+        return FFX_DATA_GRAPH_TENSOR_FORMAT_R16_FLOAT;
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        return FFX_DATA_GRAPH_TENSOR_FORMAT_R32_FLOAT;
+    default:
+        return FFX_DATA_GRAPH_TENSOR_FORMAT_UNDEFINED;
+    }
+}
 
-        {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1,
-         L"NSS_LumaDeriv_1",
-         FFX_RESOURCE_TYPE_TEXTURE2D,
-         (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
-         FFX_SURFACE_FORMAT_R8G8_UNORM,
-         context->paddedInputWidth,
-         context->paddedInputHeight,
-         1,
-         FFX_RESOURCE_FLAGS_NONE,
-         {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+// The surface format of a tensor of a model, the inverse of getDataGraphTensorFormat().
+static FfxSurfaceFormat getDataGraphTensorSurfaceFormat(uint32_t format)
+{
+    switch (format)
+    {
+    case FFX_DATA_GRAPH_TENSOR_FORMAT_R8_SINT:
+        return FFX_SURFACE_FORMAT_R8_SINT;
+    case FFX_DATA_GRAPH_TENSOR_FORMAT_R16_FLOAT:
+        return FFX_SURFACE_FORMAT_R16_FLOAT;
+    case FFX_DATA_GRAPH_TENSOR_FORMAT_R32_FLOAT:
+        return FFX_SURFACE_FORMAT_R32_FLOAT;
+    default:
+        return FFX_SURFACE_FORMAT_UNKNOWN;
+    }
+}
 
-        {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2,
+// The quantization the shaders are specialized with when the tensors aren't int8, which leaves the values as they are.
+static constexpr NssQuantizationConstants NSS_NEUTRAL_QUANTIZATION = {
+    {1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}};
+
+// The specialization constants of a graph interface tensor.
+static FfxFloat32* getTensorQuantization(NssQuantizationConstants& quantization, uint32_t resourceId)
+{
+    switch (resourceId)
+    {
+    case FFX_NSS_RESOURCE_IDENTIFIER_PREPROCESS_INPUT_TENSOR:
+        return quantization.input;
+    case FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR:
+        return quantization.feedback;
+    case FFX_NSS_RESOURCE_IDENTIFIER_K4_TENSOR:
+        return quantization.temporal;
+    case FFX_NSS_RESOURCE_IDENTIFIER_K0_TENSOR:
+        return quantization.k0;
+    case FFX_NSS_RESOURCE_IDENTIFIER_K1_TENSOR:
+        return quantization.k1;
+    case FFX_NSS_RESOURCE_IDENTIFIER_K2_TENSOR:
+        return quantization.k2;
+    case FFX_NSS_RESOURCE_IDENTIFIER_K3_TENSOR:
+        return quantization.k3;
+    default:
+        return nullptr;
+    }
+}
+
+// Checks a graph module, and the constants it's built with.
+static FfxErrorCode validateDataGraphModule(FfxNssMessage fpMessage, const FfxDataGraphBlob* dataGraph)
+{
+    if (dataGraph == nullptr || dataGraph->graphData == nullptr || dataGraph->graphDataSize == 0 || (dataGraph->graphDataSize % sizeof(uint32_t)) != 0 ||
+        dataGraph->graphEntryPoint == nullptr)
+    {
+        if (fpMessage)
+            fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model has no valid SPIR-V graph module");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Compressed constants are expanded by the backend, their groups must tile the sparsity dimension.
+    for (uint32_t constantIndex = 0; constantIndex < dataGraph->constantNums; ++constantIndex)
+    {
+        if (!ffxDataGraphConstantIsCompressed(*dataGraph, constantIndex))
+            continue;
+
+        const int64_t  dimension = dataGraph->constantSparsityDimensions[constantIndex];
+        const uint32_t groupSize = dataGraph->constantSparsityGroupSizes ? dataGraph->constantSparsityGroupSizes[constantIndex] : 0;
+        if (dimension < 0 || dimension >= int64_t(dataGraph->constantShapeSize[constantIndex]) || groupSize <= dataGraph->constantSparsityZeroCounts[constantIndex] ||
+            (dataGraph->constantShapes[constantIndex][dimension] % groupSize) != 0)
+        {
+            if (fpMessage)
+                fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model contains a sparse constant whose groups don't match its shape");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    return FFX_OK;
+}
+
+// The description of an interface tensor created in nssCreate(). The compute shader network keeps the tensors in buffers, whose
+// description is rebuilt from their size at the resolution of the network.
+static FfxResourceDescription getTensorDescription(FfxNssContext_Private* context, uint32_t resourceId)
+{
+    FfxResourceDescription description =
+        context->contextDescription.backendInterface.fpGetResourceDescription(&context->contextDescription.backendInterface, context->srvResources[resourceId]);
+    if (description.type != FFX_RESOURCE_TYPE_BUFFER)
+        return description;
+
+    const uint32_t pixelCount = context->paddedInputWidth * context->paddedInputHeight;
+    const uint32_t channels   = description.size / pixelCount;
+    description               = {FFX_RESOURCE_TYPE_TENSOR, FFX_SURFACE_FORMAT_R8_SINT, context->paddedInputWidth, context->paddedInputHeight, channels, 1};
+    description.batchSize     = 1;
+    description.shapeSize     = 4;
+    return description;
+}
+
+// Checks the tensors of a segment bind to the tensors created in nssCreate(), and adds them to boundTensorMask. Tensors of a segmented
+// model which aren't part of the graph interface are intermediates, created in createSegmentResources().
+static FfxErrorCode validateSegmentTensors(FfxNssContext_Private*     context,
+                                           const FfxDataGraphSegment& segment,
+                                           bool                       allowIntermediates,
+                                           NssQuantizationConstants&  outQuantization,
+                                           uint32_t&                  boundTensorMask)
+{
+    const FfxNssMessage     fpMessage         = context->contextDescription.fpMessage;
+    const FfxDataGraphBlob* dataGraph         = segment.graph;
+    uint32_t                segmentTensorMask = 0;
+
+    for (uint32_t tensorIndex = 0; tensorIndex < segment.tensorNums; ++tensorIndex)
+    {
+        const bool     layoutMatches = segment.tensorSets[tensorIndex] == 0 && segment.tensorDimSize[tensorIndex] == 4;
+        const uint32_t mapIndex      = findTensorBinding(segment.tensorNames[tensorIndex]);
+        if (mapIndex == FFX_COUNTOF(uavTensorBindingTable))
+        {
+            if (allowIntermediates && layoutMatches && getDataGraphTensorSurfaceFormat(segment.tensorFormats[tensorIndex]) != FFX_SURFACE_FORMAT_UNKNOWN)
+                continue;
+
+            if (fpMessage)
+                fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model contains a tensor which is not known to NSS");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+
+        // The feedback tensor is ping-ponged every frame, both copies share the same description.
+        const uint32_t resourceId = uavTensorBindingTable[mapIndex].index;
+        const uint32_t storageId  = (resourceId == FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR) ? FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1 : resourceId;
+        const FfxResourceDescription tensorDescription = getTensorDescription(context, storageId);
+
+        if (!layoutMatches || segment.tensorDims[tensorIndex][3] != tensorDescription.channel || (segmentTensorMask & (1u << mapIndex)) != 0)
+        {
+            if (fpMessage)
+                fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model tensor layout does not match the tensors used by NSS");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+
+        // An int8 model can't run on the fp16 tensors of a context created without quantization, nor the other way round.
+        if (segment.tensorFormats[tensorIndex] != getDataGraphTensorFormat(tensorDescription.format))
+        {
+            if (fpMessage)
+                fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model tensor format does not match the quantization of the context");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+
+        // Only graphs carry quantization, a graph segment's tensors are those of its graph.
+        FfxFloat32* quantization = getTensorQuantization(outQuantization, resourceId);
+        if (quantization && dataGraph && dataGraph->tensorQuantScales && dataGraph->tensorQuantZeroPoints && dataGraph->tensorQuantScales[tensorIndex] > 0.0f)
+        {
+            quantization[0] = dataGraph->tensorQuantScales[tensorIndex];
+            quantization[1] = FfxFloat32(dataGraph->tensorQuantZeroPoints[tensorIndex]);
+        }
+
+        segmentTensorMask |= 1u << mapIndex;
+    }
+
+    boundTensorMask |= segmentTensorMask;
+    return FFX_OK;
+}
+
+// Checks the model binds to the tensors of the context, and reads the quantization of its
+// tensors into outQuantization. Tensors without metadata keep the values passed in.
+static FfxErrorCode validateDataGraphModel(FfxNssContext_Private* context, const FfxDataGraphBlob* dataGraph, NssQuantizationConstants& outQuantization)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(dataGraph);
+
+    const FfxNssMessage fpMessage = context->contextDescription.fpMessage;
+
+    // Every tensor of the model must bind to one of the tensors created in nssCreate(), with the same channel count.
+    uint32_t boundTensorMask = 0;
+    if (dataGraph->segmentNums == 0)
+    {
+        FFX_VALIDATE(validateDataGraphModule(fpMessage, dataGraph));
+
+        const FfxDataGraphSegment graphSegment = {FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH,
+                                                  dataGraph,
+                                                  dataGraph->graphEntryPoint,
+                                                  dataGraph->graphDataSize,
+                                                  dataGraph->graphData,
+                                                  nullptr,
+                                                  dataGraph->tensorNums,
+                                                  dataGraph->tensorNames,
+                                                  dataGraph->tensorSets,
+                                                  dataGraph->tensorBindings,
+                                                  dataGraph->tensorFormats,
+                                                  dataGraph->tensorDimSize,
+                                                  dataGraph->tensorDims,
+                                                  nullptr};
+        FFX_VALIDATE(validateSegmentTensors(context, graphSegment, false, outQuantization, boundTensorMask));
+    }
+
+    for (uint32_t segmentIndex = 0; segmentIndex < dataGraph->segmentNums; ++segmentIndex)
+    {
+        const FfxDataGraphSegment& segment = dataGraph->segments[segmentIndex];
+        if (segment.type == FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH)
+        {
+            FFX_VALIDATE(validateDataGraphModule(fpMessage, segment.graph));
+        }
+
+        const bool validCode =
+            segment.code != nullptr && segment.codeSize != 0 && (segment.codeSize % sizeof(uint32_t)) == 0 && segment.entryPoint != nullptr;
+        const bool validCompute =
+            segment.type == FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH || (segment.type == FFX_DATA_GRAPH_SEGMENT_TYPE_COMPUTE && segment.dispatchShape != nullptr);
+        if (!validCode || !validCompute || segment.tensorResources == nullptr)
+        {
+            if (fpMessage)
+                fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model contains an invalid segment");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+
+        FFX_VALIDATE(validateSegmentTensors(context, segment, true, outQuantization, boundTensorMask));
+    }
+
+    // The first entries of the table are shader outputs, the rest are the data graph interface.
+    const uint32_t dataGraphTensorMask = ((1u << FFX_COUNTOF(uavTensorBindingTable)) - 1) & ~((1u << NSS_SHADER_UAV_TENSOR_BINDING_COUNT) - 1);
+    if (boundTensorMask != dataGraphTensorMask)
+    {
+        if (fpMessage)
+            fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model does not provide all the tensors used by NSS");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    return FFX_OK;
+}
+
+// Checks the built-in model, and reads the quantization the shaders are specialized with. An int8 model must carry the
+// quantization of every int8 tensor, from its .quant file.
+static FfxErrorCode validateBuiltInDataGraphModel(FfxNssContext_Private* context, const FfxDataGraphBlob* dataGraph)
+{
+    FFX_ASSERT(context);
+
+    NssQuantizationConstants quantization = {};
+    FFX_VALIDATE(validateDataGraphModel(context, dataGraph, quantization));
+    if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) != FFX_NSS_CONTEXT_FLAG_QUANTIZED)
+        return FFX_OK;
+
+    const FfxFloat32x2* tensorQuantization = &quantization.input;
+    for (uint32_t tensorIndex = 0; tensorIndex < sizeof(NssQuantizationConstants) / sizeof(FfxFloat32x2); ++tensorIndex)
+    {
+        if (tensorQuantization[tensorIndex][0] <= 0.0f)
+        {
+            context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR,
+                                                  L"NSS model has no quantization for its int8 tensors, it must be parsed with its .quant file.");
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    context->quantization = quantization;
+    return FFX_OK;
+}
+
+static FfxErrorCode createResourceFromDescription(FfxNssContext_Private* context, const FfxInternalResourceDescription* resDesc)
+{
+    const FfxResourceType  resourceType        = resDesc->type;
+    FfxResourceDescription resourceDescription = {resourceType,
+                                                  resDesc->format,
+                                                  resDesc->width,
+                                                  resDesc->height,
+                                                  (resourceType == FFX_RESOURCE_TYPE_TENSOR) ? resDesc->channel : 1,
+                                                  resDesc->mipCount,
+                                                  resDesc->flags,
+                                                  resDesc->usage,
+                                                  resDesc->batchSize,
+                                                  resDesc->shapeSize};
+
+    // The compute shader network keeps its int8 tensors in storage buffers of the same NHWC layout, with a single view.
+    if (context->computeNetwork && resourceType == FFX_RESOURCE_TYPE_TENSOR)
+    {
+        FFX_ASSERT(resDesc->format == FFX_SURFACE_FORMAT_R8_SINT && resDesc->batchSize == 1);
+        resourceDescription           = {FFX_RESOURCE_TYPE_BUFFER, FFX_SURFACE_FORMAT_R32_UINT};
+        resourceDescription.size      = resDesc->width * resDesc->height * resDesc->channel;
+        resourceDescription.stride    = sizeof(uint32_t);
+        resourceDescription.alignment = 1;
+        resourceDescription.mipCount  = 1;
+        resourceDescription.flags     = FFX_RESOURCE_FLAGS_NONE;
+        resourceDescription.usage     = resDesc->usage;
+    }
+
+    const FfxResourceStates      initialState =
+        (resDesc->usage == FFX_RESOURCE_USAGE_READ_ONLY) ? FFX_RESOURCE_STATE_COMPUTE_READ : FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    const FfxCreateResourceDescription createResourceDescription = {
+        FFX_HEAP_TYPE_DEFAULT, resourceDescription, initialState, resDesc->name, resDesc->id, resDesc->initData};
+    return context->contextDescription.backendInterface.fpCreateResource(
+        &context->contextDescription.backendInterface, &createResourceDescription, context->effectContextId, &context->srvResources[resDesc->id]);
+}
+
+/// Computes the padded input and output resolutions based on unpadded resolutions.
+///
+/// @param unpaddedInputWidth      Unpadded input width.
+/// @param unpaddedInputHeight     Unpadded input height.
+/// @param unpaddedOutputWidth     Unpadded output width.
+/// @param unpaddedOutputHeight    Unpadded output height.
+/// @param paddedInputWidth        [out] Padded input width.
+/// @param paddedInputHeight       [out] Padded input height.
+/// @param paddedOutputWidth       [out] Padded output width.
+/// @param paddedOutputHeight      [out] Padded output height.
+///
+/// @return True if any of the padded dimensions differ from the unpadded dimensions, false otherwise.
+static bool ComputePaddedResolution(const uint32_t unpaddedInputWidth,
+                                    const uint32_t unpaddedInputHeight,
+                                    const uint32_t unpaddedOutputWidth,
+                                    const uint32_t unpaddedOutputHeight,
+                                    uint32_t&      paddedInputWidth,
+                                    uint32_t&      paddedInputHeight,
+                                    uint32_t&      paddedOutputWidth,
+                                    uint32_t&      paddedOutputHeight)
+{
+    paddedInputWidth           = FFX_ALIGN_UP(unpaddedInputWidth, FFX_NSS_RESOURCE_ALIGNMENT);
+    paddedInputHeight          = FFX_ALIGN_UP(unpaddedInputHeight, FFX_NSS_RESOURCE_ALIGNMENT);
+    const float upscaleFactorX = static_cast<float>(unpaddedOutputWidth) / static_cast<float>(unpaddedInputWidth);
+    const float upscaleFactorY = static_cast<float>(unpaddedOutputHeight) / static_cast<float>(unpaddedInputHeight);
+
+    // The padded output is only kept as history, the unpadded output is written directly by the upscale passes.
+    paddedOutputWidth  = FFX_ALIGN_UP(static_cast<uint32_t>(paddedInputWidth * upscaleFactorX), FFX_NSS_RESOURCE_ALIGNMENT);
+    paddedOutputHeight = FFX_ALIGN_UP(static_cast<uint32_t>(paddedInputHeight * upscaleFactorY), FFX_NSS_RESOURCE_ALIGNMENT);
+
+    return paddedInputWidth != unpaddedInputWidth || paddedInputHeight != unpaddedInputHeight || paddedOutputWidth != unpaddedOutputWidth ||
+           paddedOutputHeight != unpaddedOutputHeight;
+}
+
+// Translates the built-in data graph into compute shader layers and creates the parameter buffer and the
+// intermediate tensors they use. The graph interface tensors must already exist.
+static FfxErrorCode createNetworkResources(FfxNssContext_Private* context)
+{
+    FFX_ASSERT(context);
+
+    FfxDataGraphBlob dataGraphBlob = {};
+    FFX_VALIDATE(context->contextDescription.backendInterface.fpGetPermutationBlobByIndex(
+        FFX_EFFECT_NSS, FFX_NSS_PASS_DATA_GRAPH, NSS_SHADER_PERMUTATION_QUANTIZED, nullptr, nullptr, &dataGraphBlob));
+    FFX_VALIDATE(validateBuiltInDataGraphModel(context, &dataGraphBlob));
+
+    // The segments of a model exported from several modules are only run as data graphs and their own compute shaders.
+    if (dataGraphBlob.segmentNums > 0)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model can't be run as compute shaders.");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // The names were checked against the binding table above.
+    uint32_t tensorResourceIds[FFX_COUNTOF(uavTensorBindingTable)] = {};
+    FFX_RETURN_ON_ERROR(dataGraphBlob.tensorNums <= FFX_COUNTOF(tensorResourceIds), FFX_ERROR_INVALID_ARGUMENT);
+    for (uint32_t tensorIndex = 0; tensorIndex < dataGraphBlob.tensorNums; ++tensorIndex)
+    {
+        wchar_t tensorName[64] = {};
+        mbstowcs(tensorName, dataGraphBlob.tensorNames[tensorIndex], FFX_COUNTOF(tensorName) - 1);
+
+        for (uint32_t mapIndex = 0; mapIndex < FFX_COUNTOF(uavTensorBindingTable); ++mapIndex)
+        {
+            if (0 == wcscmp(uavTensorBindingTable[mapIndex].name, tensorName))
+                tensorResourceIds[tensorIndex] = uavTensorBindingTable[mapIndex].index;
+        }
+    }
+
+    std::vector<uint32_t> parameters;
+    const FfxErrorCode    errorCode =
+        nssParseNetwork(&dataGraphBlob, tensorResourceIds, context->paddedInputWidth, context->paddedInputHeight, &context->network, parameters);
+    if (errorCode != FFX_OK)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model can't be run as compute shaders.");
+        return errorCode;
+    }
+
+    const FfxInternalResourceDescription parametersDesc = {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_PARAMETERS,
+                                                           L"NSS_NetworkParameters",
+                                                           FFX_RESOURCE_TYPE_BUFFER,
+                                                           FFX_RESOURCE_USAGE_UAV,
+                                                           FFX_SURFACE_FORMAT_R32_UINT,
+                                                           uint32_t(parameters.size() * sizeof(uint32_t)),
+                                                           sizeof(uint32_t),
+                                                           1,
+                                                           FFX_RESOURCE_FLAGS_NONE,
+                                                           FfxResourceInitData::FfxResourceInitBuffer(parameters.size() * sizeof(uint32_t),
+                                                                                                      parameters.data())};
+    FFX_VALIDATE(createResourceFromDescription(context, &parametersDesc));
+
+    for (uint32_t activationIndex = 0; activationIndex < context->network.activationCount; ++activationIndex)
+    {
+        const NssNetworkActivation&          activation     = context->network.activations[activationIndex];
+        const FfxInternalResourceDescription activationDesc = {FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0 + activationIndex,
+                                                               L"NSS_NetworkActivation",
+                                                               FFX_RESOURCE_TYPE_TENSOR,
+                                                               FFX_RESOURCE_USAGE_UAV,
+                                                               FFX_SURFACE_FORMAT_R8_SINT,
+                                                               activation.width,
+                                                               activation.height,
+                                                               1,
+                                                               FFX_RESOURCE_FLAGS_NONE,
+                                                               {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
+                                                               1,
+                                                               activation.channels,
+                                                               4};
+        FFX_VALIDATE(createResourceFromDescription(context, &activationDesc));
+    }
+
+    return FFX_OK;
+}
+
+// Creates the tensors a model exported from several modules passes between its segments. The segments run in order, so an
+// intermediate is live from the first segment binding it to the last, and intermediates which are never live at once share a tensor.
+static FfxErrorCode createSegmentResources(FfxNssContext_Private* context, const FfxDataGraphBlob* dataGraph)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(dataGraph);
+
+    struct SegmentIntermediate
+    {
+        uint32_t resourceIndex;  ///< Index in the model's resource table
+        uint32_t format;
+        uint64_t width;  ///< At the resolution the model was exported for
+        uint64_t height;
+        uint64_t channels;
+        uint32_t firstSegment;
+        uint32_t lastSegment;
+    };
+
+    // Found in the order their lifetimes start
+    std::vector<SegmentIntermediate> intermediates;
+    for (uint32_t segmentIndex = 0; segmentIndex < dataGraph->segmentNums; ++segmentIndex)
+    {
+        const FfxDataGraphSegment& segment = dataGraph->segments[segmentIndex];
+        for (uint32_t tensorIndex = 0; tensorIndex < segment.tensorNums; ++tensorIndex)
+        {
+            const uint32_t  resourceIndex = segment.tensorResources[tensorIndex];
+            const uint32_t  format        = segment.tensorFormats[tensorIndex];
+            const uint64_t* dims          = segment.tensorDims[tensorIndex];
+            const uint64_t  width         = dims[2];
+            const uint64_t  height        = dims[1];
+            const uint64_t  channels      = dims[3];
+
+            // The interface tensors are NHWC at the resolution the model was exported for
+            if (findTensorBinding(segment.tensorNames[tensorIndex]) < FFX_COUNTOF(uavTensorBindingTable))
+            {
+                context->segmentModelWidth  = uint32_t(dims[2]);
+                context->segmentModelHeight = uint32_t(dims[1]);
+                continue;
+            }
+
+            auto intermediate = std::find_if(intermediates.begin(), intermediates.end(), [resourceIndex](const SegmentIntermediate& candidate) {
+                return candidate.resourceIndex == resourceIndex;
+            });
+            if (intermediate == intermediates.end())
+            {
+                intermediates.push_back({resourceIndex, format, width, height, channels, segmentIndex, segmentIndex});
+                continue;
+            }
+
+            // Every segment binding an intermediate must agree on its description
+            FFX_RETURN_ON_ERROR(intermediate->format == format && intermediate->width == width && intermediate->height == height &&
+                                    intermediate->channels == channels,
+                                FFX_ERROR_INVALID_ARGUMENT);
+            intermediate->lastSegment = segmentIndex;
+        }
+    }
+
+    if (intermediates.size() > NSS_MAX_SEGMENT_INTERMEDIATES || context->segmentModelWidth == 0 || context->segmentModelHeight == 0)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model segments can't be run, they pass too many intermediates.");
+        return FFX_ERROR_OUT_OF_RANGE;
+    }
+
+    // The last segment which reads each intermediate tensor, a later intermediate with the same description may reuse it.
+    std::vector<SegmentIntermediate> tensors;
+    for (uint32_t intermediateIndex = 0; intermediateIndex < intermediates.size(); ++intermediateIndex)
+    {
+        const SegmentIntermediate& intermediate = intermediates[intermediateIndex];
+
+        uint32_t tensorIndex = 0;
+        for (tensorIndex = 0; tensorIndex < tensors.size(); ++tensorIndex)
+        {
+            const SegmentIntermediate& tensor = tensors[tensorIndex];
+            if (tensor.lastSegment < intermediate.firstSegment && tensor.format == intermediate.format && tensor.width == intermediate.width &&
+                tensor.height == intermediate.height && tensor.channels == intermediate.channels)
+                break;
+        }
+
+        const uint32_t resourceId = FFX_NSS_RESOURCE_IDENTIFIER_SEGMENT_INTERMEDIATE_0 + tensorIndex;
+        if (tensorIndex == tensors.size())
+        {
+            if (tensors.size() == FFX_NSS_SEGMENT_MAX_INTERMEDIATES)
+            {
+                context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model segments can't be run, they pass too many intermediates.");
+                return FFX_ERROR_OUT_OF_RANGE;
+            }
+
+            // Intermediates are scaled from their shape in the model to the resolution of the network like the interface tensors, rounding
+            // up as strided layers do, with the views batched together.
+            const uint64_t modelWidth         = context->segmentModelWidth;
+            const uint64_t modelHeight        = context->segmentModelHeight;
+            const uint32_t intermediateWidth  = uint32_t((intermediate.width * context->paddedInputWidth + modelWidth - 1) / modelWidth);
+            const uint32_t intermediateHeight = uint32_t((intermediate.height * context->paddedInputHeight + modelHeight - 1) / modelHeight);
+            const FfxInternalResourceDescription intermediateDesc = {resourceId,
+                                                                     L"NSS_SegmentIntermediate",
+                                                                     FFX_RESOURCE_TYPE_TENSOR,
+                                                                     FFX_RESOURCE_USAGE_UAV,
+                                                                     getDataGraphTensorSurfaceFormat(intermediate.format),
+                                                                     intermediateWidth,
+                                                                     intermediateHeight,
+                                                                     1,
+                                                                     FFX_RESOURCE_FLAGS_NONE,
+                                                                     {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
+                                                                     context->viewCount,
+                                                                     uint32_t(intermediate.channels),
+                                                                     4};
+            FFX_VALIDATE(createResourceFromDescription(context, &intermediateDesc));
+            context->uavResources[resourceId] = context->srvResources[resourceId];
+            tensors.push_back(intermediate);
+        }
+        tensors[tensorIndex].lastSegment = intermediate.lastSegment;
+
+        context->segmentIntermediateIndices[intermediateIndex]     = intermediate.resourceIndex;
+        context->segmentIntermediateResourceIds[intermediateIndex] = resourceId;
+    }
+
+    context->segmentIntermediateCount = uint32_t(intermediates.size());
+    context->segments                 = dataGraph->segments;
+    context->segmentCount             = dataGraph->segmentNums;
+
+    // The pipeline states are too large to keep one per segment in the context itself.
+    context->pipelineNssSegments = new FfxPipelineState[context->segmentCount]();
+
+    return FFX_OK;
+}
+
+// The internal resources each view keeps its own copy of, indexed like FfxNssContext_Private::viewResources.
+// The padded inputs are read again by the post-process pass, after the pre-process passes of all views.
+static constexpr uint32_t viewResourceIds[NSS_VIEW_RESOURCE_COUNT] = {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_1,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_2,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_1,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_2,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_1,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1,
+                                                                      FFX_NSS_RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS};
+
+// Keeps the resources of the first view, and creates those of the other views from the same descriptions.
+static FfxErrorCode createViewResources(FfxNssContext_Private* context, const FfxInternalResourceDescription* descriptions, uint32_t count)
+{
+    for (uint32_t viewResourceIndex = 0; viewResourceIndex < NSS_VIEW_RESOURCE_COUNT; ++viewResourceIndex)
+    {
+        const uint32_t resourceId = viewResourceIds[viewResourceIndex];
+        for (uint32_t descriptionIndex = 0; descriptionIndex < count; ++descriptionIndex)
+        {
+            if (descriptions[descriptionIndex].id != resourceId)
+                continue;
+
+            const FfxResourceInternal firstViewResource  = context->srvResources[resourceId];
+            context->viewResources[0][viewResourceIndex] = firstViewResource;
+            for (uint32_t viewIndex = 1; viewIndex < context->viewCount; ++viewIndex)
+            {
+                FFX_VALIDATE(createResourceFromDescription(context, &descriptions[descriptionIndex]));
+                context->viewResources[viewIndex][viewResourceIndex] = context->srvResources[resourceId];
+            }
+            context->srvResources[resourceId] = firstViewResource;
+            context->viewResourceMask |= 1u << viewResourceIndex;
+        }
+    }
+
+    return FFX_OK;
+}
+
+// Points the entries of the resource tables created for each view at the resources of a view.
+static void bindViewResources(FfxNssContext_Private* context, uint32_t viewIndex)
+{
+    for (uint32_t viewResourceIndex = 0; viewResourceIndex < NSS_VIEW_RESOURCE_COUNT; ++viewResourceIndex)
+    {
+        if ((context->viewResourceMask & (1u << viewResourceIndex)) == 0)
+            continue;
+
+        const uint32_t resourceId         = viewResourceIds[viewResourceIndex];
+        context->srvResources[resourceId] = context->viewResources[viewIndex][viewResourceIndex];
+        context->uavResources[resourceId] = context->viewResources[viewIndex][viewResourceIndex];
+    }
+}
+
+static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContextDescription* contextDescription)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(contextDescription);
+
+    // Setup the data for implementation, value-initialized so the worker thread and its flag are constructed.
+    new (context) FfxNssContext_Private();
+    context->device = contextDescription->backendInterface.device;
+
+    memcpy(&context->contextDescription, contextDescription, sizeof(FfxNssContextDescription));
+
+    // Create the context.
+    FfxErrorCode errorCode = context->contextDescription.backendInterface.fpCreateBackendContext(
+        &context->contextDescription.backendInterface, FFX_EFFECT_NSS, nullptr, &context->effectContextId);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    // Pipelines stored by an earlier run come out of the pipeline cache instead of being compiled again. The data is
+    // only read here, so the context doesn't hold on to it.
+    FfxInterface& backendInterface = context->contextDescription.backendInterface;
+    if (contextDescription->pipelineCacheDataSize > 0 && backendInterface.fpMergePipelineCacheData)
+    {
+        errorCode =
+            backendInterface.fpMergePipelineCacheData(&backendInterface, contextDescription->pipelineCacheData, contextDescription->pipelineCacheDataSize);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    }
+    context->contextDescription.pipelineCacheData     = nullptr;
+    context->contextDescription.pipelineCacheDataSize = 0;
+
+    // call out for device caps.
+    errorCode =
+        context->contextDescription.backendInterface.fpGetDeviceCapabilities(&context->contextDescription.backendInterface, &context->deviceCapabilities);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    // Until an fp16 model is built in, contexts created without quantization keep running the quantized model.
+    if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) != FFX_NSS_CONTEXT_FLAG_QUANTIZED)
+    {
+        FfxDataGraphBlob dataGraphBlob = {};
+        if (context->contextDescription.backendInterface.fpGetPermutationBlobByIndex(
+                FFX_EFFECT_NSS, FFX_NSS_PASS_DATA_GRAPH, 0, nullptr, nullptr, &dataGraphBlob) != FFX_OK)
+        {
+            context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_WARNING, L"NSS was built without an fp16 model, the quantized model is used.");
+            context->contextDescription.flags |= FFX_NSS_CONTEXT_FLAG_QUANTIZED;
+        }
+    }
+
+    // Without tensors and data graphs the network runs as compute shaders on storage buffers, which only needs packed integer dot products.
+    const bool dataGraphNetworkSupported = context->deviceCapabilities.tensorSupported && context->deviceCapabilities.dataGraphSupported;
+    if (!dataGraphNetworkSupported && !context->deviceCapabilities.integerDotProductSupported)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR,
+                                              L"NSS requires device with support for tensors and data graphs, or integer dot products. "
+                                              L"Please check device capabilities.");
+        return FFX_ERROR_NULL_DEVICE;
+    }
+
+    context->computeNetwork = !dataGraphNetworkSupported;
+    if (context->computeNetwork && (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) != FFX_NSS_CONTEXT_FLAG_QUANTIZED)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS compute shader network requires FFX_NSS_CONTEXT_FLAG_QUANTIZED.");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Views are stacked in the batch dimension of the tensors, which the compute shader layers and the images
+    // aliasing the tensors don't address.
+    context->viewCount = contextDescription->viewCount ? contextDescription->viewCount : 1;
+    FFX_RETURN_ON_ERROR(context->viewCount <= FFX_NSS_MAX_VIEW_COUNT, FFX_ERROR_INVALID_ARGUMENT);
+    if (context->viewCount > 1 && (context->computeNetwork || (contextDescription->flags & FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES)))
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR,
+                                              L"NSS with more than one view requires data graph support and no FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES.");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    context->networkInterval = contextDescription->networkInterval ? contextDescription->networkInterval : 1;
+
+    // A region of interest is read in place from the inputs, with a halo around it which the padded frame covers too.
+    // Its output is written through the unpadded output, so it always takes the fused padding path.
+    context->regionOfInterest = (contextDescription->flags & (FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST | FFX_NSS_CONTEXT_FLAG_FOVEATED)) != 0;
+    if (context->regionOfInterest && (contextDescription->flags & FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING))
+    {
+        context->contextDescription.fpMessage(
+            FFX_MESSAGE_TYPE_ERROR,
+            L"NSS FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST and FFX_NSS_CONTEXT_FLAG_FOVEATED are incompatible with FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING.");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // A fovea is a region of interest of foveaSize which nssDispatch() places around the gaze. The periphery pass
+    // upscales the whole frame except the fovea, whose halo blends the two.
+    context->foveated = (contextDescription->flags & FFX_NSS_CONTEXT_FLAG_FOVEATED) != 0;
+    if (context->foveated)
+    {
+        FFX_RETURN_ON_ERROR(contextDescription->foveaSize.width > 0 && contextDescription->foveaSize.height > 0, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(contextDescription->foveaSize.width <= contextDescription->maxRenderSize.width &&
+                                contextDescription->foveaSize.height <= contextDescription->maxRenderSize.height,
+                            FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    const FfxDimensions2D regionSize   = context->foveated ? contextDescription->foveaSize : contextDescription->maxRenderSize;
+    const uint32_t        haloSize     = context->regionOfInterest ? 2 * FFX_NSS_REGION_HALO : 0;
+    const uint32_t        regionWidth  = regionSize.width + haloSize;
+    const uint32_t        regionHeight = regionSize.height + haloSize;
+
+    // set defaults
+    context->firstExecution     = true;
+    context->resourceFrameIndex = 0;
+    const bool needPaddingPass  = ComputePaddedResolution(regionWidth,
+                                                         regionHeight,
+                                                         contextDescription->maxUpscaleSize.width * regionWidth / contextDescription->maxRenderSize.width,
+                                                         contextDescription->maxUpscaleSize.height * regionHeight / contextDescription->maxRenderSize.height,
+                                                         context->paddedInputWidth,
+                                                         context->paddedInputHeight,
+                                                         context->paddedOutputWidth,
+                                                         context->paddedOutputHeight);
+    const bool hasPaddingFlag   = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_DISABLE_PADDING) == 0;
+    const bool fusedPaddingFlag = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_FUSED_PADDING) != 0;
+    context->hasPaddingPass     = context->regionOfInterest || (hasPaddingFlag && needPaddingPass);
+    context->fusedPadding       = context->hasPaddingPass && (fusedPaddingFlag || context->regionOfInterest);
+
+    // Without quantization the tensors hold fp16 values, which the fp16 model reads and writes as they are.
+    // NOTE: This will not work for RHI-NNE Backend!
+    FfxSurfaceFormat tensorFormatSingleChannel = ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) == FFX_NSS_CONTEXT_FLAG_QUANTIZED)
+                                                     ? FFX_SURFACE_FORMAT_R8_SINT
+                                                     : FFX_SURFACE_FORMAT_R16_FLOAT;
+
+    // NOTE: This will not work for RHI-NNE Backend!
+    FfxSurfaceFormat tensorFormatQuadChannel = ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_QUANTIZED) == FFX_NSS_CONTEXT_FLAG_QUANTIZED)
+                                                   ? FFX_SURFACE_FORMAT_R8_SINT
+                                                   : FFX_SURFACE_FORMAT_R16_FLOAT;
+
+    const bool aliasTensorAsImage = (contextDescription->flags & FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES) == FFX_NSS_CONTEXT_FLAG_READ_TENSORS_AS_IMAGES;
+
+    uint32_t           inputTensorChannel        = 12;
+    constexpr uint32_t feedbackTensorChannel     = 4;
+    constexpr uint32_t coefficientsTensorChannel = 4;
+    // declare internal resources needed
+    const FfxInternalResourceDescription internalSurfaceDesc[] = {
+        {FFX_NSS_RESOURCE_IDENTIFIER_PREPROCESS_INPUT_TENSOR,
+         L"NSS_PreprocessInputTensor",
+         FFX_RESOURCE_TYPE_TENSOR,
+         FFX_RESOURCE_USAGE_UAV,
+         tensorFormatSingleChannel,
+         context->paddedInputWidth,
+         context->paddedInputHeight,
+         1,
+         FFX_RESOURCE_FLAGS_NONE,
+         {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
+         context->viewCount,
+         inputTensorChannel,
+         4},
+
+        {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1,
+         L"NSS_LumaDeriv_1",
+         FFX_RESOURCE_TYPE_TEXTURE2D,
+         (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+         FFX_SURFACE_FORMAT_R8G8_UNORM,
+         context->paddedInputWidth,
+         context->paddedInputHeight,
+         1,
+         FFX_RESOURCE_FLAGS_NONE,
+         {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+
+        {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2,
          L"NSS_LumaDeriv_2",
          FFX_RESOURCE_TYPE_TEXTURE2D,
          (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
@@ -550,7 +1568,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          feedbackTensorChannel,
          4},
 
@@ -564,7 +1582,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          feedbackTensorChannel,
          4},
 
@@ -578,7 +1596,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          coefficientsTensorChannel,
          4},
 
@@ -592,7 +1610,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          coefficientsTensorChannel,
          4},
 
@@ -606,7 +1624,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          coefficientsTensorChannel,
          4},
 
@@ -620,7 +1638,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          coefficientsTensorChannel,
          4},
 
@@ -634,7 +1652,7 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
          1,
          aliasTensorAsImage ? FFX_RESOURCE_FLAGS_IMAGE_ALIASED : FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED},
-         1,
+         context->viewCount,
          coefficientsTensorChannel,
          4},
     };
@@ -647,45 +1665,114 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
     {
         FFX_VALIDATE(createResourceFromDescription(context, &internalSurfaceDesc[currentSurfaceIndex]));
     }
+    FFX_VALIDATE(createViewResources(context, internalSurfaceDesc, FFX_ARRAY_ELEMENTS(internalSurfaceDesc)));
 
     if (context->hasPaddingPass)
     {
-        const FfxInternalResourceDescription mirrorPaddingInternalSurfaceDesc[] = {
-            {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR,
-             L"NSS_padded_input_color_jittered",
+        // With fused padding the passes mirror their fetches into the unpadded inputs, so no padded copies are needed
+        if (!context->fusedPadding)
+        {
+            const FfxInternalResourceDescription mirrorPaddingInternalSurfaceDesc[] = {
+                {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR,
+                 L"NSS_padded_input_color_jittered",
+                 FFX_RESOURCE_TYPE_TEXTURE2D,
+                 (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+                 FFX_SURFACE_FORMAT_R11G11B10_FLOAT,
+                 context->paddedInputWidth,
+                 context->paddedInputHeight,
+                 1,
+                 FFX_RESOURCE_FLAGS_NONE,
+                 {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+
+                {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH,
+                 L"NSS_padded_input_depth",
+                 FFX_RESOURCE_TYPE_TEXTURE2D,
+                 (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+                 FFX_SURFACE_FORMAT_R32_FLOAT,
+                 context->paddedInputWidth,
+                 context->paddedInputHeight,
+                 1,
+                 FFX_RESOURCE_FLAGS_NONE,
+                 {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+
+                {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1,
+                 L"NSS_padded_input_depth_tm1",
+                 FFX_RESOURCE_TYPE_TEXTURE2D,
+                 (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+                 FFX_SURFACE_FORMAT_R32_FLOAT,
+                 context->paddedInputWidth,
+                 context->paddedInputHeight,
+                 1,
+                 FFX_RESOURCE_FLAGS_NONE,
+                 {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+
+                {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS,
+                 L"NSS_padded_input_motion_vectors",
+                 FFX_RESOURCE_TYPE_TEXTURE2D,
+                 (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+                 FFX_SURFACE_FORMAT_R16G16_FLOAT,
+                 context->paddedInputWidth,
+                 context->paddedInputHeight,
+                 1,
+                 FFX_RESOURCE_FLAGS_NONE,
+                 {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+            };
+
+            for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(mirrorPaddingInternalSurfaceDesc); ++currentSurfaceIndex)
+            {
+                FFX_VALIDATE(createResourceFromDescription(context, &mirrorPaddingInternalSurfaceDesc[currentSurfaceIndex]));
+            }
+            FFX_VALIDATE(createViewResources(context, mirrorPaddingInternalSurfaceDesc, FFX_ARRAY_ELEMENTS(mirrorPaddingInternalSurfaceDesc)));
+        }
+
+        const FfxInternalResourceDescription paddedOutputInternalSurfaceDesc[] = {
+            {FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_1,
+             L"NSS_padded_upscaled_color_1",
              FFX_RESOURCE_TYPE_TEXTURE2D,
              (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
              FFX_SURFACE_FORMAT_R11G11B10_FLOAT,
-             context->paddedInputWidth,
-             context->paddedInputHeight,
+             context->paddedOutputWidth,
+             context->paddedOutputHeight,
              1,
              FFX_RESOURCE_FLAGS_NONE,
              {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
 
-            {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH,
-             L"NSS_padded_input_depth",
+            {FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_2,
+             L"NSS_padded_upscaled_color_2",
              FFX_RESOURCE_TYPE_TEXTURE2D,
              (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
-             FFX_SURFACE_FORMAT_R32_FLOAT,
-             context->paddedInputWidth,
-             context->paddedInputHeight,
+             FFX_SURFACE_FORMAT_R11G11B10_FLOAT,
+             context->paddedOutputWidth,
+             context->paddedOutputHeight,
              1,
              FFX_RESOURCE_FLAGS_NONE,
              {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+        };
+
+        for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(paddedOutputInternalSurfaceDesc); ++currentSurfaceIndex)
+        {
+            FFX_VALIDATE(createResourceFromDescription(context, &paddedOutputInternalSurfaceDesc[currentSurfaceIndex]));
+        }
+        FFX_VALIDATE(createViewResources(context, paddedOutputInternalSurfaceDesc, FFX_ARRAY_ELEMENTS(paddedOutputInternalSurfaceDesc)));
+    }
 
-            {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1,
-             L"NSS_padded_input_depth_tm1",
+    // Where each pixel finds its coefficients in the tensors of the last network run, ping-ponged like the other history
+    if (context->networkInterval > 1)
+    {
+        const FfxInternalResourceDescription coefficientUvInternalSurfaceDesc[] = {
+            {FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_1,
+             L"NSS_CoefficientUv_1",
              FFX_RESOURCE_TYPE_TEXTURE2D,
              (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
-             FFX_SURFACE_FORMAT_R32_FLOAT,
+             FFX_SURFACE_FORMAT_R16G16_FLOAT,
              context->paddedInputWidth,
              context->paddedInputHeight,
              1,
              FFX_RESOURCE_FLAGS_NONE,
              {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
 
-            {FFX_NSS_RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS,
-             L"NSS_padded_input_motion_vectors",
+            {FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2,
+             L"NSS_CoefficientUv_2",
              FFX_RESOURCE_TYPE_TEXTURE2D,
              (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
              FFX_SURFACE_FORMAT_R16G16_FLOAT,
@@ -694,34 +1781,21 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
              1,
              FFX_RESOURCE_FLAGS_NONE,
              {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
-
-            {FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_1,
-             L"NSS_padded_upscaled_color_1",
-             FFX_RESOURCE_TYPE_TEXTURE2D,
-             (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
-             FFX_SURFACE_FORMAT_R11G11B10_FLOAT,
-             context->paddedOutputWidth,
-             context->paddedOutputHeight,
-             1,
-             FFX_RESOURCE_FLAGS_NONE,
-             {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
-
-            {FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_2,
-             L"NSS_padded_upscaled_color_2",
-             FFX_RESOURCE_TYPE_TEXTURE2D,
-             (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
-             FFX_SURFACE_FORMAT_R11G11B10_FLOAT,
-             context->paddedOutputWidth,
-             context->paddedOutputHeight,
-             1,
-             FFX_RESOURCE_FLAGS_NONE,
-             {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
         };
 
-        for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(mirrorPaddingInternalSurfaceDesc); ++currentSurfaceIndex)
+        for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(coefficientUvInternalSurfaceDesc); ++currentSurfaceIndex)
         {
-            FFX_VALIDATE(createResourceFromDescription(context, &mirrorPaddingInternalSurfaceDesc[currentSurfaceIndex]));
+            FFX_VALIDATE(createResourceFromDescription(context, &coefficientUvInternalSurfaceDesc[currentSurfaceIndex]));
         }
+        FFX_VALIDATE(createViewResources(context, coefficientUvInternalSurfaceDesc, FFX_ARRAY_ELEMENTS(coefficientUvInternalSurfaceDesc)));
+    }
+
+    // Replaced by the quantization of the built-in model when the tensors are int8
+    context->quantization = NSS_NEUTRAL_QUANTIZATION;
+
+    if (context->computeNetwork)
+    {
+        FFX_VALIDATE(createNetworkResources(context));
     }
 
     // copy resources to uavResrouces list
@@ -730,17 +1804,126 @@ static FfxErrorCode nssCreate(FfxNssContext_Private* context, const FfxNssContex
 
     // avoid compiling pipelines on first render
     {
-        errorCode = createPipelineStates(context);
-        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+        const float upscaleRatio          = static_cast<float>(context->paddedOutputWidth) / static_cast<float>(context->paddedInputWidth);
+        context->pipelinePermutationFlags = getPipelinePermutationFlags(context, upscaleRatio);
+        const uint32_t pipelineFlags      = context->pipelinePermutationFlags;
+
+        if (!context->computeNetwork)
+        {
+            FfxDataGraphBlob dataGraphBlob = {};
+            FFX_VALIDATE(context->contextDescription.backendInterface.fpGetPermutationBlobByIndex(
+                FFX_EFFECT_NSS, FFX_NSS_PASS_DATA_GRAPH, pipelineFlags, nullptr, nullptr, &dataGraphBlob));
+            FFX_VALIDATE(validateBuiltInDataGraphModel(context, &dataGraphBlob));
+
+            if (dataGraphBlob.segmentNums > 0)
+            {
+                FFX_VALIDATE(createSegmentResources(context, &dataGraphBlob));
+            }
+        }
+
+        if (context->hasPaddingPass && !context->fusedPadding)
+        {
+            FFX_VALIDATE(
+                createComputePipeline(context, FFX_NSS_PASS_MIRROR_PADDING, pipelineFlags, L"NSS-MirrorPadding", &context->pipelineNssMirrorPadding));
+        }
+
+        // The periphery is upscaled by the bilinear fallback's dispatches too, so it's created up front
+        if (context->foveated)
+        {
+            FFX_VALIDATE(
+                createComputePipeline(context, FFX_NSS_PASS_PERIPHERY_UPSCALE, pipelineFlags, L"NSS-PeripheryUpscale", &context->pipelineNssPeripheryUpscale));
+        }
+
+        if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION) == FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION)
+        {
+            // Only the cheap fallback is created up front, dispatches use it until the background thread is done.
+            FFX_VALIDATE(
+                createComputePipeline(context, FFX_NSS_PASS_BILINEAR_UPSCALE, pipelineFlags, L"NSS-BilinearUpscale", &context->pipelineNssBilinearUpscale));
+            context->bilinearFallbackActive = true;
+
+            context->pipelineCreationThread = std::thread(createPipelineStatesInBackground, context);
+        }
+        else
+        {
+            errorCode = createPipelineStates(context);
+            FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+            context->pipelineCreationResult = FFX_OK;
+            context->pipelineCreationDone.store(true, std::memory_order_release);
+        }
     }
     return FFX_OK;
 }
 
+static void deliverCapturedFrame(FfxNssContext_Private* context, NssCaptureSlot* slot)
+{
+    FfxInterface& backendInterface = context->contextDescription.backendInterface;
+
+    // Null inputs were not copied
+    void* data[NSS_CAPTURE_INPUT_COUNT] = {};
+    bool  mapped                        = true;
+    for (uint32_t i = 0; i < NSS_CAPTURE_INPUT_COUNT; ++i)
+    {
+        if (slot->readbackSizes[i] != 0)
+            mapped = mapped && backendInterface.fpMapResource(&backendInterface, slot->readbackResources[i], &data[i]) == FFX_OK;
+    }
+
+    if (mapped && context->captureDescription.fpCaptureFrame)
+    {
+        FfxNssCaptureFrame frame    = {};
+        frame.frameIndex            = slot->frameIndex;
+        frame.dispatchDescription   = slot->dispatchDescription;
+        frame.colorData             = data[NSS_CAPTURE_INPUT_COLOR];
+        frame.colorDataSize         = slot->readbackSizes[NSS_CAPTURE_INPUT_COLOR];
+        frame.depthData             = data[NSS_CAPTURE_INPUT_DEPTH];
+        frame.depthDataSize         = slot->readbackSizes[NSS_CAPTURE_INPUT_DEPTH];
+        frame.motionVectorsData     = data[NSS_CAPTURE_INPUT_MOTION_VECTORS];
+        frame.motionVectorsDataSize = slot->readbackSizes[NSS_CAPTURE_INPUT_MOTION_VECTORS];
+        frame.depthTm1Data          = data[NSS_CAPTURE_INPUT_DEPTH_TM1];
+        frame.depthTm1DataSize      = slot->readbackSizes[NSS_CAPTURE_INPUT_DEPTH_TM1];
+        frame.outputTm1Data         = data[NSS_CAPTURE_INPUT_OUTPUT_TM1];
+        frame.outputTm1DataSize     = slot->readbackSizes[NSS_CAPTURE_INPUT_OUTPUT_TM1];
+
+        context->captureDescription.fpCaptureFrame(&frame, context->captureDescription.pUserData);
+    }
+
+    for (uint32_t i = 0; i < NSS_CAPTURE_INPUT_COUNT; ++i)
+    {
+        if (data[i] != nullptr)
+        {
+            backendInterface.fpUnmapResource(&backendInterface, slot->readbackResources[i]);
+        }
+    }
+
+    slot->pending = false;
+}
+
 static FfxErrorCode nssRelease(FfxNssContext_Private* context)
 {
     FFX_ASSERT(context);
 
-    if (context->hasPaddingPass)
+    waitForPipelineCreation(context);
+    waitForModelCreation(context);
+
+    for (uint32_t warmedIndex = 0; warmedIndex < context->warmedPipelineCount; ++warmedIndex)
+    {
+        ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->warmedPipelines[warmedIndex].pipeline, context->effectContextId);
+    }
+    delete[] context->warmedPipelines;
+    context->warmedPipelines     = nullptr;
+    context->warmedPipelineCount = 0;
+
+    // The GPU is idle when the context is destroyed, so the frames still in flight can be delivered, oldest first.
+    for (uint32_t slotIndex = 0; slotIndex < FFX_MAX_QUEUED_FRAMES; ++slotIndex)
+    {
+        NssCaptureSlot& slot = context->captureSlots[(context->captureDispatchIndex + slotIndex) % FFX_MAX_QUEUED_FRAMES];
+        if (slot.pending)
+        {
+            deliverCapturedFrame(context, &slot);
+        }
+    }
+
+    if (context->hasPaddingPass && !context->fusedPadding)
     {
         ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssMirrorPadding, context->effectContextId);
     }
@@ -748,11 +1931,49 @@ static FfxErrorCode nssRelease(FfxNssContext_Private* context)
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraph, context->effectContextId);
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssPostprocess, context->effectContextId);
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDebugView, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssBilinearUpscale, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssPeripheryUpscale, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphBuilt, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphPending, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphRetired, context->effectContextId);
+    if (context->pipelineNssSegments != nullptr)
+    {
+        for (uint32_t segmentIndex = 0; segmentIndex < context->segmentCount; ++segmentIndex)
+        {
+            ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssSegments[segmentIndex], context->effectContextId);
+        }
+        delete[] context->pipelineNssSegments;
+        context->pipelineNssSegments = nullptr;
+    }
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssNetwork, context->effectContextId);
+
+    // release internal resources, the tables hold those of the first view
+    bindViewResources(context, 0);
+    for (int32_t currentResourceIndex = 0; currentResourceIndex < FFX_NSS_RESOURCE_IDENTIFIER_COUNT; ++currentResourceIndex)
+    {
+        ffxSafeReleaseResource(&context->contextDescription.backendInterface, context->srvResources[currentResourceIndex], context->effectContextId);
+    }
+    for (uint32_t viewIndex = 1; viewIndex < context->viewCount; ++viewIndex)
+    {
+        for (uint32_t viewResourceIndex = 0; viewResourceIndex < NSS_VIEW_RESOURCE_COUNT; ++viewResourceIndex)
+        {
+            if (context->viewResourceMask & (1u << viewResourceIndex))
+                ffxSafeReleaseResource(
+                    &context->contextDescription.backendInterface, context->viewResources[viewIndex][viewResourceIndex], context->effectContextId);
+        }
+    }
 
-    // release internal resources
-    for (int32_t currentResourceIndex = 0; currentResourceIndex < FFX_NSS_RESOURCE_IDENTIFIER_COUNT; ++currentResourceIndex)
+    // release capture readback buffers, frames still pending are dropped
+    for (uint32_t slotIndex = 0; slotIndex < FFX_MAX_QUEUED_FRAMES; ++slotIndex)
     {
-        ffxSafeReleaseResource(&context->contextDescription.backendInterface, context->srvResources[currentResourceIndex], context->effectContextId);
+        NssCaptureSlot& slot = context->captureSlots[slotIndex];
+        for (uint32_t inputIndex = 0; inputIndex < NSS_CAPTURE_INPUT_COUNT; ++inputIndex)
+        {
+            if (slot.readbackCapacities[inputIndex] != 0)
+            {
+                ffxSafeReleaseResource(&context->contextDescription.backendInterface, slot.readbackResources[inputIndex], context->effectContextId);
+            }
+        }
     }
 
     // unregister resources not created internally
@@ -782,6 +2003,292 @@ static FfxErrorCode nssRelease(FfxNssContext_Private* context)
     return FFX_OK;
 }
 
+static void createModelPipelineInBackground(FfxNssContext_Private* context)
+{
+    // Permutation options only select the built-in blob, so they don't apply to a runtime model.
+    context->modelCreationResult = createDataGraphPipeline(context, 0, context->modelDataGraph->dataGraph.get(), &context->pipelineNssDataGraphBuilt);
+    context->modelCreationDone.store(true, std::memory_order_release);
+}
+
+static FfxErrorCode nssSetModel(FfxNssContext_Private* context, const FfxNssModelDescription* modelDescription)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(modelDescription);
+
+    // The compute shader layers are translated from the built-in model once, in nssCreate().
+    if (context->computeNetwork)
+    {
+        if (context->contextDescription.fpMessage)
+            context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS models can't be replaced on devices without data graph support");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Only built-in models are split into segments, their intermediates are created with the context.
+    if (modelDescription->dataGraph && modelDescription->dataGraph->segmentNums > 0)
+    {
+        if (context->contextDescription.fpMessage)
+            context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS models set at runtime must be a single data graph");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // The shaders were specialized for the quantization of the built-in model when the context was created.
+    NssQuantizationConstants quantization = context->quantization;
+    FFX_VALIDATE(validateDataGraphModel(context, modelDescription->dataGraph, quantization));
+    if (memcmp(&quantization, &context->quantization, sizeof(NssQuantizationConstants)) != 0)
+    {
+        if (context->contextDescription.fpMessage)
+            context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR,
+                                                  L"NSS model quantization differs from the built-in model, create a new context to use it");
+        return FFX_ERROR_INVALID_ARGUMENT;
+    }
+
+    // A model which was set but never dispatched can be dropped straight away, the GPU hasn't seen it. One which is still
+    // being built is waited for, its compile can't be cancelled.
+    waitForModelCreation(context);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphBuilt, context->effectContextId);
+    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphPending, context->effectContextId);
+    memset(&context->pipelineNssDataGraphBuilt, 0, sizeof(FfxPipelineState));
+    memset(&context->pipelineNssDataGraphPending, 0, sizeof(FfxPipelineState));
+
+    context->modelDataGraph = copyDataGraph(*modelDescription->dataGraph);
+    FFX_RETURN_ON_ERROR(context->modelDataGraph, FFX_ERROR_INVALID_ARGUMENT);
+
+    // The dispatches keep running the current model while the pipeline compiles, swapDataGraphPipeline() takes it once it's done.
+    context->modelCreationDone.store(false, std::memory_order_relaxed);
+    context->modelCreationThread = std::thread(createModelPipelineInBackground, context);
+    return FFX_OK;
+}
+
+// Shared by all tasks of one nssWarmupPipelines call, which waits for them before returning.
+typedef struct NssWarmupState
+{
+    FfxNssContext_Private*         context;
+    std::vector<NssWarmedPipeline> items;  ///< The permutations to build, each task writes the pipelines of the ones it takes.
+    std::atomic<uint32_t>          nextItem{0};
+    std::atomic<FfxErrorCode>      result{FFX_OK};
+    std::mutex                     mutex;
+    std::condition_variable        tasksDone;
+    uint32_t                       pendingTaskCount = 0;
+} NssWarmupState;
+
+typedef struct NssWarmupTask
+{
+    NssWarmupState* state;
+} NssWarmupTask;
+
+static void nssWarmupTask(void* taskData)
+{
+    NssWarmupTask*         task    = static_cast<NssWarmupTask*>(taskData);
+    NssWarmupState*        state   = task->state;
+    FfxNssContext_Private* context = state->context;
+
+    // Tasks pull items until none are left. Only the pipelines of the context's permutation are kept, the others are released
+    // once built, so apart from the kept ones each task holds at most one pipeline layout slot at a time.
+    for (uint32_t itemIndex = state->nextItem++; itemIndex < state->items.size(); itemIndex = state->nextItem++)
+    {
+        NssWarmedPipeline& item = state->items[itemIndex];
+
+        FfxErrorCode errorCode = FFX_OK;
+        if (item.pass == FFX_NSS_PASS_DATA_GRAPH)
+        {
+            errorCode = buildDataGraphPipeline(context, item.pipelineFlags, nullptr, &item.pipeline);
+            if (errorCode == FFX_OK)
+                errorCode = patchResourceBindings(&item.pipeline);
+        }
+        else
+        {
+            errorCode = buildComputePipeline(context, item.pass, item.pipelineFlags, L"NSS-Warmup", &item.pipeline);
+        }
+
+        // A pipeline which failed is not kept, nor one the context can never take: it has already populated the pipeline cache
+        if (errorCode != FFX_OK || item.pipelineFlags != context->pipelinePermutationFlags)
+        {
+            ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &item.pipeline, context->effectContextId);
+            memset(&item.pipeline, 0, sizeof(FfxPipelineState));
+        }
+
+        FfxErrorCode expected = FFX_OK;
+        state->result.compare_exchange_strong(expected, errorCode);
+    }
+
+    // Notify while holding the lock, the state is gone as soon as the waiter sees the count reach zero.
+    std::lock_guard<std::mutex> lock{state->mutex};
+    if (--state->pendingTaskCount == 0)
+    {
+        state->tasksDone.notify_all();
+    }
+}
+
+static FfxErrorCode nssWarmupPipelines(FfxNssContext_Private* context, const FfxNssWarmupDescription* warmupDescription)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(warmupDescription);
+
+    constexpr uint32_t tensorLayoutFlags = NSS_SHADER_PERMUTATION_ALIAS_OUTPUT_TENSORS_AS_IMAGES | NSS_SHADER_PERMUTATION_TENSORS_AS_BUFFERS;
+
+    FfxInterface&  backendInterface = context->contextDescription.backendInterface;
+    const uint32_t aliasFlags       = context->pipelinePermutationFlags & tensorLayoutFlags;
+    const uint32_t paddingFlags     = context->pipelinePermutationFlags & (NSS_SHADER_PERMUTATION_FUSED_PADDING | NSS_SHADER_PERMUTATION_WARP_COEFFICIENTS);
+    const uint32_t fp16Flags        = context->deviceCapabilities.fp16Supported ? NSS_SHADER_PERMUTATION_ALLOW_16BIT : 0;
+    const bool     reuseCommands    = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS) != 0;
+    const uint32_t pushFlags        = (pushConstantsSupported(context) && !reuseCommands) ? NSS_SHADER_PERMUTATION_PUSH_CONSTANTS : 0;
+
+    // Every option getPipelinePermutationFlags can select on this device. Tensor aliasing, tensors kept in buffers, fused padding
+    // and coefficient warping depend on how the context's resources were created, so they are kept as is.
+    const uint32_t variableFlags = NSS_SHADER_PERMUTATION_QUANTIZED | NSS_SHADER_PERMUTATION_REVERSE_Z | NSS_SHADER_PERMUTATION_RESAMPLE_BICUBIC |
+                                   fp16Flags | pushFlags | NSS_SHADER_PERMUTATION_SCALE_PRESET_MODE_X2;
+
+    const FfxPass computePasses[] = {FFX_NSS_PASS_MIRROR_PADDING,
+                                     FFX_NSS_PASS_PREPROCESS,
+                                     FFX_NSS_PASS_POSTPROCESS,
+                                     FFX_NSS_PASS_DEBUG_VIEW,
+                                     FFX_NSS_PASS_BILINEAR_UPSCALE,
+                                     FFX_NSS_PASS_NETWORK,
+                                     FFX_NSS_PASS_PERIPHERY_UPSCALE};
+
+    NssWarmupState state;
+    state.context = context;
+
+    // Most options only affect some passes, so skip permutations resolving to a blob which is already queued,
+    // or which an earlier warmup kept.
+    std::vector<const void*> queuedBlobs;
+    const auto               queueBlob = [context, &queuedBlobs](FfxPass pass, uint32_t pipelineFlags, const void* blobData) {
+        if (blobData == nullptr || std::find(queuedBlobs.begin(), queuedBlobs.end(), blobData) != queuedBlobs.end())
+            return false;
+        queuedBlobs.push_back(blobData);
+
+        std::lock_guard<std::mutex> lock{context->warmedPipelineMutex};
+        for (uint32_t warmedIndex = 0; warmedIndex < context->warmedPipelineCount; ++warmedIndex)
+        {
+            if (context->warmedPipelines[warmedIndex].pass == pass && context->warmedPipelines[warmedIndex].pipelineFlags == pipelineFlags)
+                return false;
+        }
+        return true;
+    };
+
+    const auto queuePermutation = [&](uint32_t optionFlags) -> FfxErrorCode {
+        // Constants are only pushed by the 16bit permutations, the duplicates this leaves are skipped below
+        const bool     use16bit      = (optionFlags & NSS_SHADER_PERMUTATION_ALLOW_16BIT) != 0;
+        const uint32_t pipelineFlags = (use16bit ? optionFlags : (optionFlags & ~NSS_SHADER_PERMUTATION_PUSH_CONSTANTS)) | aliasFlags | paddingFlags;
+
+        for (const FfxPass pass : computePasses)
+        {
+            if (pass == FFX_NSS_PASS_MIRROR_PADDING && context->fusedPadding)
+                continue;
+            if (pass == FFX_NSS_PASS_NETWORK && !context->computeNetwork)
+                continue;
+            if (pass == FFX_NSS_PASS_PERIPHERY_UPSCALE && !context->foveated)
+                continue;
+
+            FfxShaderBlob shaderBlob = {};
+            FFX_VALIDATE(backendInterface.fpGetPermutationBlobByIndex(FFX_EFFECT_NSS, pass, pipelineFlags, &shaderBlob, nullptr, nullptr));
+            if (queueBlob(pass, pipelineFlags, shaderBlob.data))
+                state.items.push_back({pass, pipelineFlags, {}});
+        }
+
+        if (!context->computeNetwork)
+        {
+            // Without a built-in fp16 model only the quantized graph is built
+            FfxDataGraphBlob   dataGraphBlob = {};
+            const FfxErrorCode blobError =
+                backendInterface.fpGetPermutationBlobByIndex(FFX_EFFECT_NSS, FFX_NSS_PASS_DATA_GRAPH, pipelineFlags, nullptr, nullptr, &dataGraphBlob);
+            if (blobError == FFX_OK && dataGraphBlob.segmentNums == 0 && queueBlob(FFX_NSS_PASS_DATA_GRAPH, pipelineFlags, dataGraphBlob.graphData))
+                state.items.push_back({FFX_NSS_PASS_DATA_GRAPH, pipelineFlags, {}});
+        }
+        return FFX_OK;
+    };
+
+    // The permutation of the context goes first, so pipeline creation still running in the background can take its pipelines
+    FFX_VALIDATE(queuePermutation(context->pipelinePermutationFlags & variableFlags));
+
+    // Iterate over the subsets of variableFlags
+    uint32_t optionFlags = 0;
+    do
+    {
+        FFX_VALIDATE(queuePermutation(optionFlags));
+        optionFlags = (optionFlags - variableFlags) & variableFlags;
+    } while (optionFlags != 0);
+
+    const uint32_t maxTaskCount = warmupDescription->maxTaskCount ? warmupDescription->maxTaskCount : FFX_NSS_WARMUP_DEFAULT_TASK_COUNT;
+    const uint32_t taskCount    = warmupDescription->fpSubmitTask ? std::min<uint32_t>(maxTaskCount, uint32_t(state.items.size())) : 1;
+
+    std::vector<NssWarmupTask> tasks(taskCount);
+    state.pendingTaskCount = taskCount;
+    for (NssWarmupTask& task : tasks)
+    {
+        task.state = &state;
+        if (warmupDescription->fpSubmitTask)
+            warmupDescription->fpSubmitTask(nssWarmupTask, &task, warmupDescription->pUserData);
+        else
+            nssWarmupTask(&task);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{state.mutex};
+        state.tasksDone.wait(lock, [&state] { return state.pendingTaskCount == 0; });
+    }
+
+    // Keep the pipelines of the context's permutation which were built, the context takes them when it creates its pipelines
+    uint32_t builtCount = 0;
+    for (const NssWarmedPipeline& item : state.items)
+        builtCount += item.pipeline.pipeline != nullptr ? 1 : 0;
+
+    if (builtCount > 0)
+    {
+        std::lock_guard<std::mutex> lock{context->warmedPipelineMutex};
+        NssWarmedPipeline*          warmedPipelines = new NssWarmedPipeline[context->warmedPipelineCount + builtCount];
+        std::copy(context->warmedPipelines, context->warmedPipelines + context->warmedPipelineCount, warmedPipelines);
+        for (const NssWarmedPipeline& item : state.items)
+        {
+            if (item.pipeline.pipeline != nullptr)
+                warmedPipelines[context->warmedPipelineCount++] = item;
+        }
+        delete[] context->warmedPipelines;
+        context->warmedPipelines = warmedPipelines;
+    }
+
+    return state.result.load();
+}
+
+static void swapDataGraphPipeline(FfxNssContext_Private* context)
+{
+    // Release the previous data graph once every frame which may reference it has retired.
+    if (context->pipelineNssDataGraphRetired.pipeline != nullptr && ++context->retiredDataGraphFrameCount > NSS_MAX_QUEUED_FRAMES)
+    {
+        ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphRetired, context->effectContextId);
+        memset(&context->pipelineNssDataGraphRetired, 0, sizeof(FfxPipelineState));
+    }
+
+    // A model whose pipeline is ready to go waits in pipelineNssDataGraphPending.
+    if (context->modelCreationThread.joinable() && context->modelCreationDone.load(std::memory_order_acquire))
+    {
+        waitForModelCreation(context);
+        if (context->modelCreationResult == FFX_OK)
+        {
+            context->pipelineNssDataGraphPending = context->pipelineNssDataGraphBuilt;
+        }
+        else
+        {
+            ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineNssDataGraphBuilt, context->effectContextId);
+            if (context->contextDescription.fpMessage)
+                context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, L"NSS model pipeline creation failed, the previous model is kept");
+        }
+        memset(&context->pipelineNssDataGraphBuilt, 0, sizeof(FfxPipelineState));
+    }
+
+    // Only one pipeline is retired at a time, a newer model waits until the slot is free.
+    if (context->pipelineNssDataGraphPending.pipeline != nullptr && context->pipelineNssDataGraphRetired.pipeline == nullptr)
+    {
+        context->pipelineNssDataGraphRetired = context->pipelineNssDataGraph;
+        context->pipelineNssDataGraph        = context->pipelineNssDataGraphPending;
+        context->retiredDataGraphFrameCount  = 0;
+        memset(&context->pipelineNssDataGraphPending, 0, sizeof(FfxPipelineState));
+
+        // The feedback tensor written by the previous model is meaningless to the new one.
+        context->firstExecution = true;
+    }
+}
+
 // Convert float32 to float16 (IEEE 754 half-precision)
 static uint16_t packfloat32ToUint16(float value)
 {
@@ -823,7 +2330,7 @@ static FfxUInt32 packTwoUintsTo32bit(FfxUInt32 a, FfxUInt32 b)
     return (static_cast<FfxUInt32>(b16) << 16) | a16;
 }
 
-static void setupDeviceDepthToViewSpaceDepthParams(FfxNssContext_Private* context, const FfxNssDispatchDescription* params)
+static void setupDeviceDepthToViewSpaceDepthParams(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, NssConstants& constants)
 {
     const bool bInverted = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED) == FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED;
     const bool bInfinite = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_DEPTH_INFINITE) == FFX_NSS_CONTEXT_FLAG_DEPTH_INFINITE;
@@ -862,8 +2369,8 @@ static void setupDeviceDepthToViewSpaceDepthParams(FfxNssContext_Private* contex
         fMax,                 // reversed, infinite
     };
 
-    context->constants._DeviceToViewDepth[0] = d * matrix_elem_c[bInverted][bInfinite];
-    context->constants._DeviceToViewDepth[1] = matrix_elem_e[bInverted][bInfinite];
+    constants._DeviceToViewDepth[0] = d * matrix_elem_c[bInverted][bInfinite];
+    constants._DeviceToViewDepth[1] = matrix_elem_e[bInverted][bInfinite];
 
     // revert x and y coords
     const float aspect      = context->paddedInputWidth / float(context->paddedInputHeight);
@@ -871,8 +2378,8 @@ static void setupDeviceDepthToViewSpaceDepthParams(FfxNssContext_Private* contex
     const float a           = cotHalfFovY / aspect;
     const float b           = cotHalfFovY;
 
-    context->constants._DeviceToViewDepth[2] = (1.0f / a);
-    context->constants._DeviceToViewDepth[3] = (1.0f / b);
+    constants._DeviceToViewDepth[2] = (1.0f / a);
+    constants._DeviceToViewDepth[3] = (1.0f / b);
 }
 
 static void computeJitterTileOffset(float jx, float jy, float sx, float sy, int mx, int my, FfxInt32x2& jitterTileOffset)
@@ -903,9 +2410,9 @@ static bool NeedResetHistory(FfxNssContext_Private* context, const FfxNssDispatc
     return context->firstExecution || params->reset;
 }
 
-static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, bool use16bit)
+static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, uint32_t viewIndex, bool use16bit)
 {
-    NssConstants& constants        = context->constants;
+    NssConstants& constants        = context->constants[viewIndex];
     const bool    needResetHistory = NeedResetHistory(context, params);
     if (needResetHistory)
     {
@@ -913,7 +2420,7 @@ static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDisp
     }
 
     // compute params to enable device depth to view space depth computation in shader
-    setupDeviceDepthToViewSpaceDepthParams(context, params);
+    setupDeviceDepthToViewSpaceDepthParams(context, params, constants);
 
     constants._InputDims[0]    = context->paddedInputWidth;
     constants._InputDims[1]    = context->paddedInputHeight;
@@ -928,9 +2435,40 @@ static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDisp
     constants._UnpaddedInputDims[0] = params->renderSize.width;
     constants._UnpaddedInputDims[1] = params->renderSize.height;
 
+    // Without padding the output is written once, through the upscaled output binding
+    constants._UnpaddedOutputDims[0] = context->hasPaddingPass ? params->upscaleSize.width : 0;
+    constants._UnpaddedOutputDims[1] = context->hasPaddingPass ? params->upscaleSize.height : 0;
+
+    // The uv space of the passes spans the region of interest and its halo, which is in render pixels,
+    // and the reads mirror about the edges of the whole input rather than those of the region
+    FfxFloat32x2 renderPixelsPerUv = {static_cast<float>(params->renderSize.width), static_cast<float>(params->renderSize.height)};
+    if (context->regionOfInterest)
+    {
+        const int32_t outputHaloX = FFX_NSS_REGION_HALO * context->paddedOutputWidth / context->paddedInputWidth;
+        const int32_t outputHaloY = FFX_NSS_REGION_HALO * context->paddedOutputHeight / context->paddedInputHeight;
+
+        constants._UnpaddedInputDims[0] = FFX_MAXIMUM(params->color.description.width, uint32_t(params->renderOffset.x) + params->renderSize.width);
+        constants._UnpaddedInputDims[1] = FFX_MAXIMUM(params->color.description.height, uint32_t(params->renderOffset.y) + params->renderSize.height);
+        constants._InputOffset[0]       = params->renderOffset.x - FFX_NSS_REGION_HALO;
+        constants._InputOffset[1]       = params->renderOffset.y - FFX_NSS_REGION_HALO;
+        constants._OutputRegion[0]      = outputHaloX;
+        constants._OutputRegion[1]      = outputHaloY;
+        constants._OutputRegion[2]      = params->upscaleOffset.x;
+        constants._OutputRegion[3]      = params->upscaleOffset.y;
+
+        renderPixelsPerUv[0] = static_cast<float>(context->paddedInputWidth);
+        renderPixelsPerUv[1] = static_cast<float>(context->paddedInputHeight);
+    }
+
+    // The output pixels of a fovea, its halo around them is blended with the periphery
+    constants._FoveaRect[0] = context->foveated ? params->upscaleOffset.x : 0;
+    constants._FoveaRect[1] = context->foveated ? params->upscaleOffset.y : 0;
+    constants._FoveaRect[2] = context->foveated ? params->upscaleOffset.x + int32_t(params->upscaleSize.width) : 0;
+    constants._FoveaRect[3] = context->foveated ? params->upscaleOffset.y + int32_t(params->upscaleSize.height) : 0;
+
     // The passed in jitter offset is in pixel space of unpadded render size
-    const float jitterUvX = params->jitterOffset.x / static_cast<float>(params->renderSize.width);
-    const float jitterUvY = params->jitterOffset.y / static_cast<float>(params->renderSize.height);
+    const float jitterUvX = params->jitterOffset.x / renderPixelsPerUv[0];
+    const float jitterUvY = params->jitterOffset.y / renderPixelsPerUv[1];
     // JitterOffset in pixels
     constants._JitterOffsetTm1[0] = constants._JitterOffset[0];
     constants._JitterOffsetTm1[1] = constants._JitterOffset[1];
@@ -949,17 +2487,12 @@ static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDisp
     constants._ScaleFactor[3] = constants._InputDims[1] / FfxFloat32(constants._OutputDims[1]);
 
     // Setup motion vector scale. The passed in motion vectors are in pixel space of unpadded render size.
-    constants._MotionVectorScale[0] = params->motionVectorScale.x / params->renderSize.width;
-    constants._MotionVectorScale[1] = params->motionVectorScale.y / params->renderSize.height;
-
-    // These quantize parameters are copied from the metadata of the using model.
-    // Note that quantParamsSNORM.xy is not used because the input tensor’s shape cannot be aliased
-    // through a single image. Therefore, we consistently use the int format for the input.
-    constexpr FfxFloat32x4 quantParamsSNORM = {1.0f / 0.49803924513980746, -1.0078740157480315, 0.49999999813735485, -1.0f};
-    constexpr FfxFloat32x4 quantParamsSINT  = {1.0f / 0.003921568859368563, -128.0f, 0.003937007859349251, -127.0f};
-    const float            noHistoryReset   = needResetHistory ? 0.0f : 1.0f;
-    const float            exposure         = (params->exposure <= 0.0f) ? 1.0 : params->exposure;
-    const float            invExposure      = 1.f / exposure;
+    constants._MotionVectorScale[0] = params->motionVectorScale.x / renderPixelsPerUv[0];
+    constants._MotionVectorScale[1] = params->motionVectorScale.y / renderPixelsPerUv[1];
+
+    const float noHistoryReset = needResetHistory ? 0.0f : 1.0f;
+    const float exposure       = (params->exposure <= 0.0f) ? 1.0 : params->exposure;
+    const float invExposure    = 1.f / exposure;
 
     // These value comes from arm-model-zoo/models/super_sampling/ClampNet_v5_1/scenarios/1920x1088/end_to_end/push_consts_generator.py
     // They are const or learned during training. Cannot be changed.
@@ -979,27 +2512,17 @@ static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDisp
 
     if (use16bit)
     {
-        constants.dynamicPrecision._16bit._QuantParamsSNORM[0]   = packTwoFloatsTo32bit(quantParamsSNORM[0], quantParamsSNORM[1]);
-        constants.dynamicPrecision._16bit._QuantParamsSNORM[1]   = packTwoFloatsTo32bit(quantParamsSNORM[2], quantParamsSNORM[3]);
-        constants.dynamicPrecision._16bit._QuantParamsSINT[0]    = packTwoFloatsTo32bit(quantParamsSINT[0], quantParamsSINT[1]);
-        constants.dynamicPrecision._16bit._QuantParamsSINT[1]    = packTwoFloatsTo32bit(quantParamsSINT[2], quantParamsSINT[3]);
         constants.dynamicPrecision._16bit._Exposure              = packTwoFloatsTo32bit(exposure, invExposure);
         constants.dynamicPrecision._16bit._MotionDisThreshPad[0] = packTwoFloatsTo32bit(motionVectorThreshold, motionDisocclusionThreshold);
         constants.dynamicPrecision._16bit._MotionDisThreshPad[1] = packTwoFloatsTo32bit(disocclusionScale, 0.0f);
         constants.dynamicPrecision._16bit._IndexModulo           = packTwoUintsTo32bit(indexModulo[0], indexModulo[1]);
         constants.dynamicPrecision._16bit._LutOffset             = packTwoUintsTo32bit(jitterTileOffset[0], jitterTileOffset[1]);
         constants.dynamicPrecision._16bit._NotHistoryReset       = packTwoFloatsTo32bit(noHistoryReset, 0.0f);
+        constants.dynamicPrecision._16bit._ViewIndex             = viewIndex;
+        constants.dynamicPrecision._16bit._ReuseCoefficients     = context->reuseCoefficients ? 1 : 0;
     }
     else
     {
-        constants.dynamicPrecision._32bit._QuantParamsSNORM[0]   = quantParamsSNORM[0];
-        constants.dynamicPrecision._32bit._QuantParamsSNORM[1]   = quantParamsSNORM[1];
-        constants.dynamicPrecision._32bit._QuantParamsSNORM[2]   = quantParamsSNORM[2];
-        constants.dynamicPrecision._32bit._QuantParamsSNORM[3]   = quantParamsSNORM[3];
-        constants.dynamicPrecision._32bit._QuantParamsSINT[0]    = quantParamsSINT[0];
-        constants.dynamicPrecision._32bit._QuantParamsSINT[1]    = quantParamsSINT[1];
-        constants.dynamicPrecision._32bit._QuantParamsSINT[2]    = quantParamsSINT[2];
-        constants.dynamicPrecision._32bit._QuantParamsSINT[3]    = quantParamsSINT[3];
         constants.dynamicPrecision._32bit._Exposure[0]           = exposure;
         constants.dynamicPrecision._32bit._Exposure[1]           = invExposure;
         constants.dynamicPrecision._32bit._MotionDisThreshPad[0] = motionVectorThreshold;
@@ -1011,12 +2534,62 @@ static void setupConstantBuffer(FfxNssContext_Private* context, const FfxNssDisp
         constants.dynamicPrecision._32bit._LutOffset[0]          = jitterTileOffset[0];
         constants.dynamicPrecision._32bit._LutOffset[1]          = jitterTileOffset[1];
         constants.dynamicPrecision._32bit._NotHistoryReset       = noHistoryReset;
+        constants.dynamicPrecision._32bit._ViewIndex             = viewIndex;
+        constants.dynamicPrecision._32bit._ReuseCoefficients     = context->reuseCoefficients ? 1 : 0;
     }
 
     // initialize constantBuffers data
     context->contextDescription.backendInterface.fpStageConstantBufferDataFunc(&context->contextDescription.backendInterface,
-                                                                               &context->constants,
-                                                                               sizeof(context->constants),
+                                                                               &constants,
+                                                                               sizeof(constants),
+                                                                               &context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS]);
+}
+
+// The periphery pass of a foveated view covers the whole of its inputs and output, and skips the fovea set up by
+// setupConstantBuffer(). Its history is the application's, which only resets when the application resets it.
+static void setupPeripheryConstantBuffer(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, uint32_t viewIndex, bool use16bit)
+{
+    NssConstants constants = context->constants[viewIndex];
+
+    constants._InputDims[0]    = params->renderSize.width;
+    constants._InputDims[1]    = params->renderSize.height;
+    constants._InvInputDims[0] = 1.f / static_cast<float>(params->renderSize.width);
+    constants._InvInputDims[1] = 1.f / static_cast<float>(params->renderSize.height);
+
+    constants._OutputDims[0]    = params->upscaleSize.width;
+    constants._OutputDims[1]    = params->upscaleSize.height;
+    constants._InvOutputDims[0] = 1.f / static_cast<float>(params->upscaleSize.width);
+    constants._InvOutputDims[1] = 1.f / static_cast<float>(params->upscaleSize.height);
+
+    constants._UnpaddedInputDims[0]  = params->renderSize.width;
+    constants._UnpaddedInputDims[1]  = params->renderSize.height;
+    constants._UnpaddedOutputDims[0] = params->upscaleSize.width;
+    constants._UnpaddedOutputDims[1] = params->upscaleSize.height;
+    memset(constants._InputOffset, 0, sizeof(constants._InputOffset));
+    memset(constants._OutputRegion, 0, sizeof(constants._OutputRegion));
+
+    constants._JitterOffset[0] = params->jitterOffset.x;
+    constants._JitterOffset[1] = params->jitterOffset.y;
+    constants._JitterOffset[2] = params->jitterOffset.x / static_cast<float>(params->renderSize.width);
+    constants._JitterOffset[3] = params->jitterOffset.y / static_cast<float>(params->renderSize.height);
+
+    constants._ScaleFactor[0] = constants._OutputDims[0] / FfxFloat32(constants._InputDims[0]);
+    constants._ScaleFactor[1] = constants._OutputDims[1] / FfxFloat32(constants._InputDims[1]);
+    constants._ScaleFactor[2] = constants._InputDims[0] / FfxFloat32(constants._OutputDims[0]);
+    constants._ScaleFactor[3] = constants._InputDims[1] / FfxFloat32(constants._OutputDims[1]);
+
+    constants._MotionVectorScale[0] = params->motionVectorScale.x / static_cast<float>(params->renderSize.width);
+    constants._MotionVectorScale[1] = params->motionVectorScale.y / static_cast<float>(params->renderSize.height);
+
+    const float noHistoryReset = NeedResetHistory(context, params) ? 0.0f : 1.0f;
+    if (use16bit)
+        constants.dynamicPrecision._16bit._NotHistoryReset = packTwoFloatsTo32bit(noHistoryReset, 0.0f);
+    else
+        constants.dynamicPrecision._32bit._NotHistoryReset = noHistoryReset;
+
+    context->contextDescription.backendInterface.fpStageConstantBufferDataFunc(&context->contextDescription.backendInterface,
+                                                                               &constants,
+                                                                               sizeof(constants),
                                                                                &context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS]);
 }
 
@@ -1059,125 +2632,424 @@ static void scheduleDispatch(FfxNssContext_Private*           context,
         }
     }
 
-    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->srvTensorCount; ++currentTensorIndex)
+    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->srvTensorCount; ++currentTensorIndex)
+    {
+        const uint32_t            currentResourceId                              = pipeline->srvTensorBindings[currentTensorIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                = context->srvResources[currentResourceId];
+        dispatchJob.computeJobDescriptor.srvTensors[currentTensorIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dispatchJob.computeJobDescriptor.srvTensors[currentTensorIndex].name, pipeline->srvTensorBindings[currentTensorIndex].name);
+#endif
+    }
+
+    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->uavTensorCount; ++currentTensorIndex)
+    {
+        const uint32_t            currentResourceId                              = pipeline->uavTensorBindings[currentTensorIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                = context->uavResources[currentResourceId];
+        dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].name, pipeline->uavTensorBindings[currentTensorIndex].name);
+#endif
+    }
+
+    // The tensors are buffers when the device has no tensor support
+    for (uint32_t currentBufferIndex = 0; currentBufferIndex < pipeline->srvBufferCount; ++currentBufferIndex)
+    {
+        const uint32_t            currentResourceId                              = pipeline->srvBufferBindings[currentBufferIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                = context->srvResources[currentResourceId];
+        dispatchJob.computeJobDescriptor.srvBuffers[currentBufferIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dispatchJob.computeJobDescriptor.srvBuffers[currentBufferIndex].name, pipeline->srvBufferBindings[currentBufferIndex].name);
+#endif
+    }
+
+    for (uint32_t currentBufferIndex = 0; currentBufferIndex < pipeline->uavBufferCount; ++currentBufferIndex)
+    {
+        const uint32_t            currentResourceId                              = pipeline->uavBufferBindings[currentBufferIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                = context->uavResources[currentResourceId];
+        dispatchJob.computeJobDescriptor.uavBuffers[currentBufferIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dispatchJob.computeJobDescriptor.uavBuffers[currentBufferIndex].name, pipeline->uavBufferBindings[currentBufferIndex].name);
+#endif
+    }
+
+    dispatchJob.computeJobDescriptor.dimensions[0] = dispatchX;
+    dispatchJob.computeJobDescriptor.dimensions[1] = dispatchY;
+    dispatchJob.computeJobDescriptor.dimensions[2] = 1;
+    dispatchJob.computeJobDescriptor.pipeline      = *pipeline;
+
+    for (uint32_t currentRootConstantIndex = 0; currentRootConstantIndex < pipeline->constCount; ++currentRootConstantIndex)
+    {
+        wcscpy(dispatchJob.computeJobDescriptor.cbNames[currentRootConstantIndex], pipeline->constantBufferBindings[currentRootConstantIndex].name);
+        dispatchJob.computeJobDescriptor.cbs[currentRootConstantIndex] =
+            context->constantBuffers[pipeline->constantBufferBindings[currentRootConstantIndex].resourceIdentifier];
+    }
+
+    if (pipeline->pushConstantSize > 0)
+    {
+        dispatchJob.computeJobDescriptor.pushConstants = context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS];
+    }
+
+    context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dispatchJob, context->effectContextId);
+}
+
+static void scheduleDataGraph(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, FfxPipelineState* pipeline, wchar_t* debugName)
+{
+    FfxGpuJobDescription dataGraphJob = {FFX_GPU_JOB_DATA_GRAPH};
+    if (debugName != nullptr)
+    {
+        wcscpy(dataGraphJob.jobLabel, debugName);
+    }
+
+    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->srvTensorCount; ++currentTensorIndex)
+    {
+        const uint32_t            currentResourceId                                  = pipeline->srvTensorBindings[currentTensorIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                    = context->srvResources[currentResourceId];
+        dataGraphJob.dataGraphJobDescription.srvTensors[currentTensorIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dataGraphJob.dataGraphJobDescription.srvTensors[currentTensorIndex].name, pipeline->srvTensorBindings[currentTensorIndex].name);
+#endif
+    }
+
+    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->uavTensorCount; ++currentTensorIndex)
+    {
+        const uint32_t            currentResourceId                                  = pipeline->uavTensorBindings[currentTensorIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource                                    = context->uavResources[currentResourceId];
+        dataGraphJob.dataGraphJobDescription.uavTensors[currentTensorIndex].resource = currentResource;
+#ifdef FFX_DEBUG
+        wcscpy(dataGraphJob.dataGraphJobDescription.uavTensors[currentTensorIndex].name, pipeline->uavTensorBindings[currentTensorIndex].name);
+#endif
+    }
+
+    dataGraphJob.dataGraphJobDescription.pipeline = *pipeline;
+
+    context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dataGraphJob, context->effectContextId);
+}
+
+// Runs the segments of a model exported from several modules in order, each reading the intermediates of the segments before it.
+static void scheduleSegments(FfxNssContext_Private* context, const FfxNssDispatchDescription* params)
+{
+    for (uint32_t segmentIndex = 0; segmentIndex < context->segmentCount; ++segmentIndex)
+    {
+        const FfxDataGraphSegment& segment  = context->segments[segmentIndex];
+        FfxPipelineState*          pipeline = &context->pipelineNssSegments[segmentIndex];
+        if (segment.type == FFX_DATA_GRAPH_SEGMENT_TYPE_GRAPH)
+        {
+            scheduleDataGraph(context, params, pipeline, L"DataGraphSegment");
+            continue;
+        }
+
+        FfxGpuJobDescription dispatchJob = {FFX_GPU_JOB_COMPUTE};
+        wcscpy(dispatchJob.jobLabel, L"ComputeSegment");
+
+        for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->uavTensorCount; ++currentTensorIndex)
+        {
+            const uint32_t currentResourceId                                         = pipeline->uavTensorBindings[currentTensorIndex].resourceIdentifier;
+            dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].resource = context->uavResources[currentResourceId];
+#ifdef FFX_DEBUG
+            wcscpy(dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].name, pipeline->uavTensorBindings[currentTensorIndex].name);
+#endif
+        }
+
+        // The workgroup counts were exported for the model's resolution, x and y cover the width and height of the tensors.
+        dispatchJob.computeJobDescriptor.dimensions[0] =
+            FFX_DIVIDE_ROUNDING_UP(segment.dispatchShape[0] * context->paddedInputWidth, context->segmentModelWidth);
+        dispatchJob.computeJobDescriptor.dimensions[1] =
+            FFX_DIVIDE_ROUNDING_UP(segment.dispatchShape[1] * context->paddedInputHeight, context->segmentModelHeight);
+        dispatchJob.computeJobDescriptor.dimensions[2] = segment.dispatchShape[2];
+        dispatchJob.computeJobDescriptor.pipeline      = *pipeline;
+
+        context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dispatchJob, context->effectContextId);
+    }
+}
+
+// Dispatches the layers of the network in order, used instead of the data graph when the device has no tensor or data graph
+// support. Every layer is a dispatch of the same pipeline with its own push constants.
+static void scheduleNetwork(FfxNssContext_Private* context)
+{
+    const FfxPipelineState* pipeline = &context->pipelineNssNetwork;
+    for (uint32_t layerIndex = 0; layerIndex < context->network.layerCount; ++layerIndex)
+    {
+        const NssNetworkLayer& layer = context->network.layers[layerIndex];
+
+        // The network bindings are placeholders for the tensors of the layer.
+        const auto getLayerResource = [&](uint32_t resourceId) {
+            switch (resourceId)
+            {
+            case FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_0:
+                return context->uavResources[layer.sourceResourceIds[0]];
+            case FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_INPUT_1:
+                return context->uavResources[layer.sourceResourceIds[1]];
+            case FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_OUTPUT:
+                return context->uavResources[layer.outputResourceId];
+            default:
+                return context->srvResources[resourceId];
+            }
+        };
+
+        FfxGpuJobDescription dispatchJob = {FFX_GPU_JOB_COMPUTE};
+        wcscpy(dispatchJob.jobLabel, L"Network");
+
+        for (uint32_t currentBufferIndex = 0; currentBufferIndex < pipeline->srvBufferCount; ++currentBufferIndex)
+        {
+            const uint32_t currentResourceId                                         = pipeline->srvBufferBindings[currentBufferIndex].resourceIdentifier;
+            dispatchJob.computeJobDescriptor.srvBuffers[currentBufferIndex].resource = getLayerResource(currentResourceId);
+#ifdef FFX_DEBUG
+            wcscpy(dispatchJob.computeJobDescriptor.srvBuffers[currentBufferIndex].name, pipeline->srvBufferBindings[currentBufferIndex].name);
+#endif
+        }
+
+        for (uint32_t currentBufferIndex = 0; currentBufferIndex < pipeline->uavBufferCount; ++currentBufferIndex)
+        {
+            const uint32_t currentResourceId                                         = pipeline->uavBufferBindings[currentBufferIndex].resourceIdentifier;
+            dispatchJob.computeJobDescriptor.uavBuffers[currentBufferIndex].resource = getLayerResource(currentResourceId);
+#ifdef FFX_DEBUG
+            wcscpy(dispatchJob.computeJobDescriptor.uavBuffers[currentBufferIndex].name, pipeline->uavBufferBindings[currentBufferIndex].name);
+#endif
+        }
+
+        // Each invocation writes 4 output channels of one pixel.
+        const FfxInt32x4& outputShape                  = layer.constants._OutputShape;
+        dispatchJob.computeJobDescriptor.dimensions[0] = FFX_DIVIDE_ROUNDING_UP(outputShape[0], 8);
+        dispatchJob.computeJobDescriptor.dimensions[1] = FFX_DIVIDE_ROUNDING_UP(outputShape[1], 8);
+        dispatchJob.computeJobDescriptor.dimensions[2] = FFX_DIVIDE_ROUNDING_UP(outputShape[2], 4);
+        dispatchJob.computeJobDescriptor.pipeline      = *pipeline;
+        dispatchJob.computeJobDescriptor.pushConstants = {sizeof(layer.constants) / sizeof(uint32_t), (uint32_t*)&layer.constants};
+
+        context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dispatchJob, context->effectContextId);
+    }
+}
+
+/// Returns the size in bytes of a texel of <c><i>format</i></c>, or 0 if a capture can't store it. Only formats a replay
+/// can create its images in are stored; typeless and block formats have no texel layout to recreate.
+static uint32_t getSurfaceFormatStride(FfxSurfaceFormat format)
+{
+    switch (format)
+    {
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_SRGB:
+    case FFX_SURFACE_FORMAT_B8G8R8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R10G10B10A2_UNORM:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+static void stopCapture(FfxNssContext_Private* context, const wchar_t* reason)
+{
+    if (context->contextDescription.fpMessage)
+    {
+        context->contextDescription.fpMessage(FFX_MESSAGE_TYPE_ERROR, reason);
+    }
+
+    // frames already in flight are still delivered
+    if (context->capturedFrameCount == 0)
+    {
+        context->captureDescription = {};
+    }
+    else
+    {
+        context->captureDescription.frameCount = context->capturedFrameCount;
+    }
+}
+
+/// Delivers the frame captured <c><i>FFX_MAX_QUEUED_FRAMES</i></c> dispatches ago, then schedules copies of the
+/// current inputs into the readback buffers it used.
+static void updateCapture(FfxNssContext_Private*           context,
+                          const FfxNssDispatchDescription* params,
+                          const FfxResourceInternal        inputs[NSS_CAPTURE_INPUT_COUNT])
+{
+    NssCaptureSlot& slot = context->captureSlots[context->captureDispatchIndex++ % FFX_MAX_QUEUED_FRAMES];
+    if (slot.pending)
+    {
+        deliverCapturedFrame(context, &slot);
+    }
+
+    const FfxNssCaptureDescription& capture = context->captureDescription;
+    if (!capture.fpCaptureFrame || (capture.frameCount != 0 && context->capturedFrameCount >= capture.frameCount))
     {
-        const uint32_t            currentResourceId                              = pipeline->srvTensorBindings[currentTensorIndex].resourceIdentifier;
-        const FfxResourceInternal currentResource                                = context->srvResources[currentResourceId];
-        dispatchJob.computeJobDescriptor.srvTensors[currentTensorIndex].resource = currentResource;
-#ifdef FFX_DEBUG
-        wcscpy(dispatchJob.computeJobDescriptor.srvTensors[currentTensorIndex].name, pipeline->srvTensorBindings[currentTensorIndex].name);
-#endif
+        return;
     }
 
-    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->uavTensorCount; ++currentTensorIndex)
+    FfxInterface&      backendInterface                = context->contextDescription.backendInterface;
+    const FfxResource* sources[NSS_CAPTURE_INPUT_COUNT] = {&params->color, &params->depth, &params->motionVectors, &params->depthTm1, &params->outputTm1};
+    for (uint32_t i = 0; i < NSS_CAPTURE_INPUT_COUNT; ++i)
     {
-        const uint32_t            currentResourceId                              = pipeline->uavTensorBindings[currentTensorIndex].resourceIdentifier;
-        const FfxResourceInternal currentResource                                = context->uavResources[currentResourceId];
-        dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].resource = currentResource;
-#ifdef FFX_DEBUG
-        wcscpy(dispatchJob.computeJobDescriptor.uavTensors[currentTensorIndex].name, pipeline->uavTensorBindings[currentTensorIndex].name);
-#endif
-    }
+        const FfxResourceDescription& description = sources[i]->description;
 
-    dispatchJob.computeJobDescriptor.dimensions[0] = dispatchX;
-    dispatchJob.computeJobDescriptor.dimensions[1] = dispatchY;
-    dispatchJob.computeJobDescriptor.dimensions[2] = 1;
-    dispatchJob.computeJobDescriptor.pipeline      = *pipeline;
+        // The previous depth and output may be null on the first frame
+        if (sources[i]->resource == nullptr)
+        {
+            slot.readbackSizes[i] = 0;
+            continue;
+        }
 
-    for (uint32_t currentRootConstantIndex = 0; currentRootConstantIndex < pipeline->constCount; ++currentRootConstantIndex)
-    {
-        wcscpy(dispatchJob.computeJobDescriptor.cbNames[currentRootConstantIndex], pipeline->constantBufferBindings[currentRootConstantIndex].name);
-        dispatchJob.computeJobDescriptor.cbs[currentRootConstantIndex] =
-            context->constantBuffers[pipeline->constantBufferBindings[currentRootConstantIndex].resourceIdentifier];
-    }
+        const uint32_t size = description.width * description.height * getSurfaceFormatStride(description.format);
+        if (size == 0)
+        {
+            stopCapture(context, L"NSS capture stopped, an input uses a format which can't be captured");
+            return;
+        }
 
-    context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dispatchJob);
-}
+        if (slot.readbackCapacities[i] == 0)
+        {
+            const FfxResourceDescription readbackDescription = {
+                FFX_RESOURCE_TYPE_BUFFER, FFX_SURFACE_FORMAT_UNKNOWN, size, 0, 1, 1, FFX_RESOURCE_FLAGS_NONE, FFX_RESOURCE_USAGE_READ_ONLY};
+            const FfxCreateResourceDescription createResourceDescription = {FFX_HEAP_TYPE_READBACK,
+                                                                            readbackDescription,
+                                                                            FFX_RESOURCE_STATE_COPY_DEST,
+                                                                            L"NSS_CaptureReadback",
+                                                                            FFX_NSS_RESOURCE_IDENTIFIER_NULL,
+                                                                            {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}};
+            if (backendInterface.fpCreateResource(&backendInterface, &createResourceDescription, context->effectContextId, &slot.readbackResources[i]) !=
+                FFX_OK)
+            {
+                stopCapture(context, L"NSS capture stopped, the readback buffers could not be created");
+                return;
+            }
+            slot.readbackCapacities[i] = size;
+        }
+        else if (size > slot.readbackCapacities[i])
+        {
+            stopCapture(context, L"NSS capture stopped, the inputs grew larger than the first captured frame");
+            return;
+        }
 
-static void scheduleDataGraph(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, FfxPipelineState* pipeline, wchar_t* debugName)
-{
-    FfxGpuJobDescription dataGraphJob = {FFX_GPU_JOB_DATA_GRAPH};
-    if (debugName != nullptr)
+        slot.readbackSizes[i] = size;
+    }
+
+    for (uint32_t i = 0; i < NSS_CAPTURE_INPUT_COUNT; ++i)
     {
-        wcscpy(dataGraphJob.jobLabel, debugName);
+        if (slot.readbackSizes[i] == 0)
+            continue;
+
+        FfxGpuJobDescription copyJob = {FFX_GPU_JOB_COPY};
+
+        copyJob.copyJobDescriptor.src = inputs[i];
+        copyJob.copyJobDescriptor.dst = slot.readbackResources[i];
+
+        backendInterface.fpScheduleGpuJob(&backendInterface, &copyJob, context->effectContextId);
     }
 
-    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->srvTensorCount; ++currentTensorIndex)
+    // only the descriptions of the resources are meaningful once the frame is delivered
+    slot.dispatchDescription              = *params;
+    slot.dispatchDescription.commandList  = nullptr;
+    slot.dispatchDescription.asyncCompute = nullptr;
+    for (FfxResource* resource : {&slot.dispatchDescription.color,
+                                  &slot.dispatchDescription.depth,
+                                  &slot.dispatchDescription.depthTm1,
+                                  &slot.dispatchDescription.motionVectors,
+                                  &slot.dispatchDescription.outputTm1,
+                                  &slot.dispatchDescription.output,
+                                  &slot.dispatchDescription.debugViews})
     {
-        const uint32_t            currentResourceId                                  = pipeline->srvTensorBindings[currentTensorIndex].resourceIdentifier;
-        const FfxResourceInternal currentResource                                    = context->srvResources[currentResourceId];
-        dataGraphJob.dataGraphJobDescription.srvTensors[currentTensorIndex].resource = currentResource;
-#ifdef FFX_DEBUG
-        wcscpy(dataGraphJob.dataGraphJobDescription.srvTensors[currentTensorIndex].name, pipeline->srvTensorBindings[currentTensorIndex].name);
-#endif
+        resource->resource = nullptr;
     }
 
-    for (uint32_t currentTensorIndex = 0; currentTensorIndex < pipeline->uavTensorCount; ++currentTensorIndex)
+    slot.frameIndex = context->capturedFrameCount++;
+    slot.pending    = true;
+}
+
+static FfxErrorCode nssSetCapture(FfxNssContext_Private* context, const FfxNssCaptureDescription* captureDescription)
+{
+    // frames captured for the previous description are dropped, its user data may no longer be valid
+    for (uint32_t i = 0; i < FFX_MAX_QUEUED_FRAMES; ++i)
     {
-        const uint32_t            currentResourceId                                  = pipeline->uavTensorBindings[currentTensorIndex].resourceIdentifier;
-        const FfxResourceInternal currentResource                                    = context->uavResources[currentResourceId];
-        dataGraphJob.dataGraphJobDescription.uavTensors[currentTensorIndex].resource = currentResource;
-#ifdef FFX_DEBUG
-        wcscpy(dataGraphJob.dataGraphJobDescription.uavTensors[currentTensorIndex].name, pipeline->uavTensorBindings[currentTensorIndex].name);
-#endif
+        context->captureSlots[i].pending = false;
     }
 
-    dataGraphJob.dataGraphJobDescription.pipeline = *pipeline;
+    context->captureDescription = *captureDescription;
+    context->capturedFrameCount = 0;
 
-    context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &dataGraphJob);
+    return FFX_OK;
 }
 
-static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDispatchDescription* params)
+// Leaves an external resource in the state the application uses it in next, when it named one
+static void setFinalState(FfxNssContext_Private* context, const FfxResource& resource, FfxResourceInternal internalResource, FfxResourceStates finalState)
 {
-    FFX_ASSERT(context);
-    FFX_ASSERT(params);
+    FfxInterface& backendInterface = context->contextDescription.backendInterface;
+    if (finalState != 0 && resource.resource != nullptr && backendInterface.fpSetResourceFinalState)
+        backendInterface.fpSetResourceFinalState(&backendInterface, internalResource, finalState, context->effectContextId);
+}
 
-    if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING) == FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING)
+// Registers an external resource of a dispatch. One the application registered with the context keeps its backend slot
+// across dispatches, and only takes the state of this one.
+static void registerExternalResource(FfxNssContext_Private* context, const FfxResource& resource, FfxUInt32 handle, FfxResourceInternal* internalResource)
+{
+    FfxInterface& backendInterface = context->contextDescription.backendInterface;
+    if (handle != 0 && backendInterface.fpRegisterPersistentResource)
     {
-        nssDebugCheckDispatch(context, params);
+        NssRegisteredResource& registered = context->registeredResources[handle - 1];
+        if (backendInterface.fpRegisterPersistentResource(&backendInterface, &resource, context->effectContextId, &registered.internalResource) == FFX_OK)
+        {
+            *internalResource = registered.internalResource;
+            return;
+        }
     }
 
-    // take a short cut to the command list
-    FfxCommandList commandList = params->commandList;
+    backendInterface.fpRegisterResource(&backendInterface, &resource, context->effectContextId, internalResource);
+}
+
+// Points the resource tables at the internal and external resources of a view, as its passes expect them.
+static void setupViewResources(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, uint32_t viewIndex)
+{
+    bindViewResources(context, viewIndex);
 
     FfxGpuJobDescription clearJob = {FFX_GPU_JOB_CLEAR_FLOAT};
 
     const float clearValuesToZeroFloat[]{0.f, 0.f, 0.f, 0.f};
     memcpy(clearJob.clearJobDescriptor.color, clearValuesToZeroFloat, 4 * sizeof(float));
 
+    // The feedback tensors hold all views, they are cleared by nssDispatch()
     const bool resetAccumulation = NeedResetHistory(context, params);
     if (resetAccumulation)
     {
         constexpr uint32_t resources_to_clear[] = {FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1,
                                                    FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2,
                                                    FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_1,
-                                                   FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_2,
-                                                   FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1,
-                                                   FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2};
+                                                   FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_2};
 
         for (uint32_t i = 0; i < FFX_COUNTOF(resources_to_clear); ++i)
         {
             clearJob.clearJobDescriptor.target = context->srvResources[resources_to_clear[i]];
-            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob);
+            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob, context->effectContextId);
         }
 
         if (context->hasPaddingPass)
         {
             clearJob.clearJobDescriptor.target = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_1];
-            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob);
+            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob, context->effectContextId);
 
             clearJob.clearJobDescriptor.target = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PADDED_OUTPUT_2];
-            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob);
+            context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob, context->effectContextId);
         }
     }
 
     // Prepare per frame descriptor tables
     const bool isOddFrame = !!(context->resourceFrameIndex & 1);
 
+    // The feedback tensors only swap when the network writes them
+    const bool isOddNetworkFrame = !!(context->networkFrameIndex & 1);
+
     const uint32_t lumaDerivSrvResourceIndex = isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2 : FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1;
     const uint32_t lumaDerivUavResourceIndex = isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_1 : FFX_NSS_RESOURCE_IDENTIFIER_LUMA_DERIV_2;
-    const uint32_t feedbackTm1ResourceIndex  = isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2 : FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1;
-    const uint32_t feedbackResourceIndex     = isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1 : FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2;
+    const uint32_t feedbackTm1ResourceIndex =
+        isOddNetworkFrame ? FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2 : FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1;
+    const uint32_t feedbackResourceIndex =
+        isOddNetworkFrame ? FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1 : FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2;
     const uint32_t depthOffsetTm1ResourceIndex =
         isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_2 : FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD_1;
     const uint32_t depthOffsetResourceIndex =
@@ -1191,35 +3063,34 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
         // Input: Color/Depth/Depth tm1/Motion/History
         // If padding pass is needed, these inputs are register to unpadded resource ids used by mirror padding stage, and the
         // mirror padding stage will output to padded resource ids used by pre-process stage, which is already setup in nssCreate().
-        // If padding pass is not needed, we register these inputs directly to padded resource ids used by pre-process stage.
+        // If padding pass is not needed, or the padding is fused into the passes' addressing, we register these inputs directly
+        // to padded resource ids used by pre-process stage.
+        const bool     paddedInputs = context->hasPaddingPass && !context->fusedPadding;
         const uint32_t external_input_color_resource_id =
-            context->hasPaddingPass ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_COLOR : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR;
+            paddedInputs ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_COLOR : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_COLOR;
         const uint32_t external_input_depth_resource_id =
-            context->hasPaddingPass ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_DEPTH : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH;
+            paddedInputs ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_DEPTH : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH;
         const uint32_t external_input_depth_tm1_resource_id =
-            context->hasPaddingPass ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_DEPTH_TM1 : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1;
+            paddedInputs ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_DEPTH_TM1 : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_DEPTH_TM1;
         const uint32_t external_input_motion_resource_id =
-            context->hasPaddingPass ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_MOTION : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS;
+            paddedInputs ? FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_MOTION : FFX_NSS_RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS;
 
         // Input: Depth tm1
-        context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                        &params->depthTm1,
-                                                                        context->effectContextId,
-                                                                        &context->srvResources[external_input_depth_tm1_resource_id]);
+        registerExternalResource(context, params->depthTm1, params->handles.depthTm1, &context->srvResources[external_input_depth_tm1_resource_id]);
 
         // Input: Depth
-        context->contextDescription.backendInterface.fpRegisterResource(
-            &context->contextDescription.backendInterface, &params->depth, context->effectContextId, &context->srvResources[external_input_depth_resource_id]);
+        registerExternalResource(context, params->depth, params->handles.depth, &context->srvResources[external_input_depth_resource_id]);
 
         // Input: Color
-        context->contextDescription.backendInterface.fpRegisterResource(
-            &context->contextDescription.backendInterface, &params->color, context->effectContextId, &context->srvResources[external_input_color_resource_id]);
+        registerExternalResource(context, params->color, params->handles.color, &context->srvResources[external_input_color_resource_id]);
 
         // Input: Motion vector
-        context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                        &params->motionVectors,
-                                                                        context->effectContextId,
-                                                                        &context->srvResources[external_input_motion_resource_id]);
+        registerExternalResource(context, params->motionVectors, params->handles.motionVectors, &context->srvResources[external_input_motion_resource_id]);
+
+        setFinalState(context, params->depthTm1, context->srvResources[external_input_depth_tm1_resource_id], params->finalStates.depthTm1);
+        setFinalState(context, params->depth, context->srvResources[external_input_depth_resource_id], params->finalStates.depth);
+        setFinalState(context, params->color, context->srvResources[external_input_color_resource_id], params->finalStates.color);
+        setFinalState(context, params->motionVectors, context->srvResources[external_input_motion_resource_id], params->finalStates.motionVectors);
 
         // Input: History
         // When there is padding pass, history will use the padded history generated by last frame.
@@ -1228,13 +3099,44 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
         {
             FFX_ASSERT(context->uavResources[paddedHistoryResourceIndex].internalIndex == context->srvResources[paddedHistoryResourceIndex].internalIndex);
             context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR] = context->srvResources[paddedHistoryResourceIndex];
+
+            // The periphery of a foveated frame accumulates into the whole of the last output
+            if (context->foveated)
+            {
+                registerExternalResource(
+                    context, params->outputTm1, params->handles.outputTm1, &context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY]);
+                setFinalState(
+                    context, params->outputTm1, context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY], params->finalStates.outputTm1);
+            }
         }
         else
         {
-            context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                            &params->outputTm1,
-                                                                            context->effectContextId,
-                                                                            &context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR]);
+            registerExternalResource(
+                context, params->outputTm1, params->handles.outputTm1, &context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR]);
+            setFinalState(
+                context, params->outputTm1, context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR], params->finalStates.outputTm1);
+        }
+
+        // Capture: read back the registered inputs of the first view. The padded history replaces the last output unless
+        // the frame is foveated, then it's only registered for the capture.
+        if (viewIndex == 0)
+        {
+            FfxResourceInternal outputTm1 = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR];
+            if (context->foveated)
+            {
+                outputTm1 = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY];
+            }
+            else if (context->hasPaddingPass && context->captureDescription.fpCaptureFrame)
+            {
+                registerExternalResource(context, params->outputTm1, params->handles.outputTm1, &outputTm1);
+            }
+
+            const FfxResourceInternal captureInputs[NSS_CAPTURE_INPUT_COUNT] = {context->srvResources[external_input_color_resource_id],
+                                                                                 context->srvResources[external_input_depth_resource_id],
+                                                                                 context->srvResources[external_input_motion_resource_id],
+                                                                                 context->srvResources[external_input_depth_tm1_resource_id],
+                                                                                 outputTm1};
+            updateCapture(context, params, captureInputs);
         }
 
         // Input: DepthOffset tm1
@@ -1254,6 +3156,18 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
 
         // Output: Depth offset, consumed by next frame and post-process stage
         context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_NEAREST_DEPTH_COORD] = context->uavResources[depthOffsetResourceIndex];
+
+        // Input: Coefficient uv tm1, Output: Coefficient uv, consumed by next frame and post-process stage
+        if (context->networkInterval > 1)
+        {
+            const uint32_t coefficientUvTm1ResourceIndex =
+                isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2 : FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_1;
+            const uint32_t coefficientUvResourceIndex =
+                isOddFrame ? FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_1 : FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_2;
+            context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV_TM1] = context->srvResources[coefficientUvTm1ResourceIndex];
+            context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV]     = context->srvResources[coefficientUvResourceIndex];
+            context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_COEFFICIENT_UV]     = context->uavResources[coefficientUvResourceIndex];
+        }
     }
 
     // Setup the resources for data graph stage
@@ -1285,36 +3199,151 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
 
         // Output: Upscaled padded output
         // If padding pass is needed, upscaled output resource id is already setup in nssCreate(), we register the external output resource to unppaded output resource id.
-        // If padding pass is not needed, we register the external output resource to upscaled output resource id.
+        // The upscale passes keep the padded output as history and write the pixels inside the unpadded output's bounds to it directly.
+        // If padding pass is not needed, we register the external output resource to upscaled output resource id, and alias the unpadded
+        // output to it so the binding is valid. Its bounds are zero in that case, so it is never written.
         if (context->hasPaddingPass)
         {
             FFX_ASSERT(context->uavResources[paddedOutputResourceIndex].internalIndex == context->srvResources[paddedOutputResourceIndex].internalIndex);
             context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT] = context->uavResources[paddedOutputResourceIndex];
             context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT] = context->srvResources[paddedOutputResourceIndex];
 
-            context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                            &params->output,
-                                                                            context->effectContextId,
-                                                                            &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT]);
+            registerExternalResource(context, params->output, params->handles.output, &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT]);
+            setFinalState(context, params->output, context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT], params->finalStates.output);
         }
         else
         {
-            context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                            &params->output,
-                                                                            context->effectContextId,
-                                                                            &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT]);
+            registerExternalResource(context, params->output, params->handles.output, &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT]);
+            context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT] = context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT];
+            setFinalState(context, params->output, context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT], params->finalStates.output);
         }
     }
 
     if ((params->flags & FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW) == FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW)
     {
-        context->contextDescription.backendInterface.fpRegisterResource(&context->contextDescription.backendInterface,
-                                                                        &params->debugViews,
-                                                                        context->effectContextId,
-                                                                        &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS]);
+        registerExternalResource(context, params->debugViews, params->handles.debugViews, &context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS]);
+        setFinalState(context, params->debugViews, context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS], params->finalStates.debugViews);
 
         clearJob.clearJobDescriptor.target = context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_DEBUG_VIEWS];
-        context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob);
+        context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &clearJob, context->effectContextId);
+    }
+}
+
+// Places the fovea of a view around its gaze, as the region of interest the network upscales. Moving it resets the
+// history of the region, so it only follows the gaze once the gaze has left its inner half. Gaze shifts that large are
+// mostly saccades, which mask the reset. Offsets are snapped so the fovea lands on whole output pixels.
+static void setupFoveaView(FfxNssContext_Private* context, const FfxNssDispatchDescription* params, uint32_t viewIndex, FfxNssDispatchDescription& fovea)
+{
+    const FfxDimensions2D foveaSize = context->contextDescription.foveaSize;
+    const float           gazeX     = (0.5f + params->gazeOffset.x) * static_cast<float>(params->renderSize.width);
+    const float           gazeY     = (0.5f + params->gazeOffset.y) * static_cast<float>(params->renderSize.height);
+    const int32_t         alignMask = ~int32_t(FFX_NSS_RESOURCE_ALIGNMENT - 1);
+    const int32_t         centredX  = FFX_MAXIMUM(int32_t(gazeX) - int32_t(foveaSize.width / 2), 0) & alignMask;
+    const int32_t         centredY  = FFX_MAXIMUM(int32_t(gazeY) - int32_t(foveaSize.height / 2), 0) & alignMask;
+    const int32_t         clampedX  = FFX_MINIMUM(centredX, int32_t(params->renderSize.width - foveaSize.width));
+    const int32_t         clampedY  = FFX_MINIMUM(centredY, int32_t(params->renderSize.height - foveaSize.height));
+
+    FfxIntCoords2D& offset     = context->foveaOffsets[viewIndex];
+    const float     gazeFromX  = fabs(gazeX - static_cast<float>(offset.x) - 0.5f * foveaSize.width);
+    const float     gazeFromY  = fabs(gazeY - static_cast<float>(offset.y) - 0.5f * foveaSize.height);
+    const bool      gazeInside = gazeFromX <= 0.25f * foveaSize.width && gazeFromY <= 0.25f * foveaSize.height;
+    const bool      recentre   = NeedResetHistory(context, params) || !gazeInside;
+    const bool      moved      = recentre && (offset.x != clampedX || offset.y != clampedY);
+    if (recentre)
+    {
+        offset.x = clampedX;
+        offset.y = clampedY;
+    }
+
+    fovea                    = *params;
+    fovea.renderOffset       = offset;
+    fovea.renderSize         = foveaSize;
+    fovea.upscaleSize.width  = foveaSize.width * params->upscaleSize.width / params->renderSize.width;
+    fovea.upscaleSize.height = foveaSize.height * params->upscaleSize.height / params->renderSize.height;
+    fovea.upscaleOffset.x    = int32_t(int64_t(offset.x) * params->upscaleSize.width / params->renderSize.width);
+    fovea.upscaleOffset.y    = int32_t(int64_t(offset.y) * params->upscaleSize.height / params->renderSize.height);
+    fovea.reset              = params->reset || moved;
+}
+
+static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDispatchDescription* views, uint32_t viewCount)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(views);
+    FFX_ASSERT(viewCount == context->viewCount);
+
+    // The jobs of all views are recorded into the command list of the first one
+    const FfxNssDispatchDescription* firstView = &views[0];
+
+    if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING) == FFX_NSS_CONTEXT_FLAG_ENABLE_DEBUG_CHECKING)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+        {
+            nssDebugCheckDispatch(context, &views[viewIndex]);
+        }
+    }
+
+    // take a short cut to the command list
+    FfxCommandList commandList = firstView->commandList;
+
+    // Until the background pipeline creation is done, the network can't run.
+    const bool useBilinearFallback = !pipelinesReady(context);
+    if (!useBilinearFallback && context->bilinearFallbackActive)
+    {
+        waitForPipelineCreation(context);
+
+        // The history written by the fallback can't be used by the network.
+        context->bilinearFallbackActive = false;
+        context->firstExecution         = true;
+    }
+
+    // Internal resources are owned by the queue family they were last used on, moving the passes to another queue discards them.
+    FfxInterface& backendInterface = context->contextDescription.backendInterface;
+    const bool    useAsyncCompute  = firstView->asyncCompute != nullptr && backendInterface.fpExecuteGpuJobsAsync != nullptr;
+    if (useAsyncCompute != context->asyncComputeActive)
+    {
+        context->asyncComputeActive = useAsyncCompute;
+        context->firstExecution     = true;
+    }
+
+    // pick up a model set through ffxNssContextSetModel() between frames
+    if (!useBilinearFallback)
+    {
+        swapDataGraphPipeline(context);
+    }
+
+    // A foveated dispatch upscales the fovea of each view as its region of interest, after the periphery pass has upscaled the rest
+    const FfxNssDispatchDescription* frameViews = views;
+    FfxNssDispatchDescription        foveaViews[FFX_NSS_MAX_VIEW_COUNT];
+    if (context->foveated)
+    {
+        for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+        {
+            setupFoveaView(context, &frameViews[viewIndex], viewIndex, foveaViews[viewIndex]);
+        }
+        views = foveaViews;
+    }
+
+    // The feedback tensors hold the batches of all views, so they are only cleared when every view resets.
+    // A view reset on its own ignores its feedback through _NotHistoryReset instead.
+    bool resetAllViews = true;
+    bool resetAnyView  = false;
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+    {
+        resetAllViews = resetAllViews && NeedResetHistory(context, &views[viewIndex]);
+        resetAnyView  = resetAnyView || NeedResetHistory(context, &views[viewIndex]);
+    }
+
+    // Between the runs of the network, the passes warp the coefficients it produced last. A reset has no coefficients to warp.
+    context->reuseCoefficients  = !useBilinearFallback && !resetAnyView && context->framesSinceNetwork + 1 < context->networkInterval;
+    context->framesSinceNetwork = context->reuseCoefficients ? context->framesSinceNetwork + 1 : 0;
+    if (resetAllViews)
+    {
+        FfxGpuJobDescription clearJob = {FFX_GPU_JOB_CLEAR_FLOAT};
+        for (const uint32_t resourceId : {FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_1, FFX_NSS_RESOURCE_IDENTIFIER_FEEDBACK_TENSOR_2})
+        {
+            clearJob.clearJobDescriptor.target = context->srvResources[resourceId];
+            backendInterface.fpScheduleGpuJob(&backendInterface, &clearJob, context->effectContextId);
+        }
     }
 
     const int32_t dispatchSrcX = FFX_DIVIDE_ROUNDING_UP(context->paddedInputWidth, 16);
@@ -1324,42 +3353,113 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
 
     const bool require16bit = (context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_ALLOW_16BIT) == FFX_NSS_CONTEXT_FLAG_ALLOW_16BIT;
     const bool use16bit     = require16bit && context->deviceCapabilities.fp16Supported;
-    setupConstantBuffer(context, params, use16bit);
 
-    if (context->hasPaddingPass)
-    {
-        scheduleDispatch(context, params, &context->pipelineNssMirrorPadding, dispatchSrcX, dispatchSrcY, L"MirrorPadding");
-    }
+    // The passes after the network run once it has processed every view, with the tables and constants kept here
+    FfxResourceInternal viewSrvResources[FFX_NSS_MAX_VIEW_COUNT][FFX_NSS_RESOURCE_IDENTIFIER_COUNT];
+    FfxResourceInternal viewUavResources[FFX_NSS_MAX_VIEW_COUNT][FFX_NSS_RESOURCE_IDENTIFIER_COUNT];
+    FfxConstantBuffer   viewConstantBuffers[FFX_NSS_MAX_VIEW_COUNT];
 
-    scheduleDispatch(context, params, &context->pipelineNssPreprocess, dispatchSrcX, dispatchSrcY, L"Preprocess");
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+    {
+        const FfxNssDispatchDescription* params = &views[viewIndex];
+        setupViewResources(context, params, viewIndex);
+        setupConstantBuffer(context, params, viewIndex, use16bit);
 
-    scheduleDataGraph(context, params, &context->pipelineNssDataGraph, L"DataGraph");
+        // The passes of the fovea blend its halo with the periphery, so the periphery goes first
+        if (context->foveated)
+        {
+            const FfxNssDispatchDescription* frameParams    = &frameViews[viewIndex];
+            const FfxConstantBuffer          foveaConstants = context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS];
+            const FfxResourceInternal        foveaHistory   = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR];
+            setupPeripheryConstantBuffer(context, frameParams, viewIndex, use16bit);
+            context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR] = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_PERIPHERY_HISTORY];
+
+            const int32_t dispatchPeripheryX = FFX_DIVIDE_ROUNDING_UP(frameParams->upscaleSize.width, 16);
+            const int32_t dispatchPeripheryY = FFX_DIVIDE_ROUNDING_UP(frameParams->upscaleSize.height, 16);
+            scheduleDispatch(context, frameParams, &context->pipelineNssPeripheryUpscale, dispatchPeripheryX, dispatchPeripheryY, L"PeripheryUpscale");
+
+            context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_HISTORY_UPSCALED_COLOR] = foveaHistory;
+            context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS]           = foveaConstants;
+        }
 
-    scheduleDispatch(context, params, &context->pipelineNssPostprocess, dispatchDstX, dispatchDstY, L"Postprocess");
+        if (context->hasPaddingPass && !context->fusedPadding)
+        {
+            scheduleDispatch(context, params, &context->pipelineNssMirrorPadding, dispatchSrcX, dispatchSrcY, L"MirrorPadding");
+        }
 
-    if (context->hasPaddingPass)
-    {
-        FfxGpuJobDescription copyJob = {FFX_GPU_JOB_COPY};
+        if (useBilinearFallback)
+        {
+            scheduleDispatch(context, params, &context->pipelineNssBilinearUpscale, dispatchDstX, dispatchDstY, L"BilinearUpscale");
+        }
+        else
+        {
+            scheduleDispatch(context, params, &context->pipelineNssPreprocess, dispatchSrcX, dispatchSrcY, L"Preprocess");
+        }
 
-        copyJob.copyJobDescriptor.src      = context->srvResources[FFX_NSS_RESOURCE_IDENTIFIER_UPSCALED_OUTPUT];
-        copyJob.copyJobDescriptor.dst      = context->uavResources[FFX_NSS_RESOURCE_IDENTIFIER_UNPADDED_OUTPUT];
-        copyJob.copyJobDescriptor.copyMode = FFX_GPU_COPY_DST_EXTENT;  // We want to crop the padded output to the unpadded output.
+        memcpy(viewSrvResources[viewIndex], context->srvResources, sizeof(context->srvResources));
+        memcpy(viewUavResources[viewIndex], context->uavResources, sizeof(context->uavResources));
+        viewConstantBuffers[viewIndex] = context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS];
+    }
 
-        context->contextDescription.backendInterface.fpScheduleGpuJob(&context->contextDescription.backendInterface, &copyJob);
+    // One run of the network covers the batches of all views
+    if (!useBilinearFallback && !context->reuseCoefficients)
+    {
+        if (context->computeNetwork)
+        {
+            scheduleNetwork(context);
+        }
+        else if (context->pipelineNssDataGraph.pipeline == nullptr && context->segmentCount > 0)
+        {
+            // Until a model set at runtime replaces the built-in one
+            scheduleSegments(context, firstView);
+        }
+        else
+        {
+            scheduleDataGraph(context, firstView, &context->pipelineNssDataGraph, L"DataGraph");
+        }
     }
 
-    if ((params->flags & FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW) == FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW)
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
     {
-        const int32_t dispatchSrcX = FFX_DIVIDE_ROUNDING_UP(params->renderSize.width, 16);
-        const int32_t dispatchSrcY = FFX_DIVIDE_ROUNDING_UP(params->renderSize.height, 16);
-        scheduleDispatch(context, params, &context->pipelineNssDebugView, dispatchSrcX, dispatchSrcY, L"DebugView");
+        const FfxNssDispatchDescription* params = &views[viewIndex];
+        memcpy(context->srvResources, viewSrvResources[viewIndex], sizeof(context->srvResources));
+        memcpy(context->uavResources, viewUavResources[viewIndex], sizeof(context->uavResources));
+        context->constantBuffers[FFX_NSS_CONSTANTBUFFER_IDENTIFIER_NSS] = viewConstantBuffers[viewIndex];
+
+        if (!useBilinearFallback)
+        {
+            scheduleDispatch(context, params, &context->pipelineNssPostprocess, dispatchDstX, dispatchDstY, L"Postprocess");
+        }
+
+        if ((params->flags & FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW) == FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW && !useBilinearFallback)
+        {
+            const int32_t dispatchDebugX = FFX_DIVIDE_ROUNDING_UP(params->renderSize.width, 16);
+            const int32_t dispatchDebugY = FFX_DIVIDE_ROUNDING_UP(params->renderSize.height, 16);
+            scheduleDispatch(context, params, &context->pipelineNssDebugView, dispatchDebugX, dispatchDebugY, L"DebugView");
+        }
     }
 
     context->resourceFrameIndex = (context->resourceFrameIndex + 1) % NSS_MAX_QUEUED_FRAMES;
+    context->networkFrameIndex += context->reuseCoefficients ? 0 : 1;
     // NSS_MAX_QUEUED_FRAMES must be an even number.
     FFX_STATIC_ASSERT((NSS_MAX_QUEUED_FRAMES & 1) == 0);
 
-    context->contextDescription.backendInterface.fpExecuteGpuJobs(&context->contextDescription.backendInterface, commandList, context->effectContextId);
+    // Submitting the jobs to the asynchronous queue also releases the dynamic resources
+    if (useAsyncCompute)
+    {
+        const FfxErrorCode errorCode =
+            backendInterface.fpExecuteGpuJobsAsync(&backendInterface, commandList, firstView->asyncCompute, context->effectContextId);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+        context->firstExecution = false;
+        return FFX_OK;
+    }
+
+    // Replay the jobs recorded for this queued frame when the backend supports it, only the constants change between frames
+    if ((context->contextDescription.flags & FFX_NSS_CONTEXT_FLAG_REUSE_COMMAND_BUFFERS) && backendInterface.fpExecuteRecordedGpuJobs)
+        backendInterface.fpExecuteRecordedGpuJobs(&backendInterface, commandList, context->effectContextId);
+    else
+        backendInterface.fpExecuteGpuJobs(&backendInterface, commandList, context->effectContextId);
 
     // release dynamic resources
     context->contextDescription.backendInterface.fpUnregisterResources(&context->contextDescription.backendInterface, commandList, context->effectContextId);
@@ -1368,6 +3468,78 @@ static FfxErrorCode nssDispatch(FfxNssContext_Private* context, const FfxNssDisp
     return FFX_OK;
 }
 
+// Looks up a registered resource, taking the state of the dispatch when it names one
+static FfxErrorCode resolveRegisteredResource(const FfxNssContext_Private* context, FfxUInt32 handle, FfxResource* resource)
+{
+    if (handle == 0)
+        return FFX_OK;
+
+    FFX_RETURN_ON_ERROR(handle <= FFX_NSS_MAX_REGISTERED_RESOURCES, FFX_ERROR_INVALID_ARGUMENT);
+    const FfxResource& registered = context->registeredResources[handle - 1].resource;
+    FFX_RETURN_ON_ERROR(registered.resource != nullptr, FFX_ERROR_INVALID_ARGUMENT);
+
+    const FfxResourceStates state = resource->state;
+    *resource                     = registered;
+    if (state != 0)
+        resource->state = state;
+
+    return FFX_OK;
+}
+
+// Replaces the resources of a view with the registered ones its handles name
+static FfxErrorCode resolveRegisteredResources(const FfxNssContext_Private* context, FfxNssDispatchDescription* view)
+{
+    const FfxNssResourceHandles& handles = view->handles;
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.color, &view->color));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.depth, &view->depth));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.depthTm1, &view->depthTm1));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.motionVectors, &view->motionVectors));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.outputTm1, &view->outputTm1));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.output, &view->output));
+    FFX_VALIDATE(resolveRegisteredResource(context, handles.debugViews, &view->debugViews));
+    return FFX_OK;
+}
+
+static FfxErrorCode nssRegisterResource(FfxNssContext_Private* context, const FfxResource* resource, FfxUInt32* handle)
+{
+    FfxUInt32 registeredHandle = *handle;
+    if (registeredHandle == 0)
+    {
+        // A null resource releases nothing, registering one is a no-op
+        if (resource->resource == nullptr)
+            return FFX_OK;
+
+        for (FfxUInt32 i = 0; i < FFX_NSS_MAX_REGISTERED_RESOURCES && registeredHandle == 0; ++i)
+        {
+            if (context->registeredResources[i].resource.resource == nullptr)
+                registeredHandle = i + 1;
+        }
+        FFX_RETURN_ON_ERROR(registeredHandle != 0, FFX_ERROR_OUT_OF_MEMORY);
+    }
+    else
+    {
+        FFX_RETURN_ON_ERROR(registeredHandle <= FFX_NSS_MAX_REGISTERED_RESOURCES, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(context->registeredResources[registeredHandle - 1].resource.resource != nullptr, FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    NssRegisteredResource& registered = context->registeredResources[registeredHandle - 1];
+    registered.resource               = *resource;
+
+    // The backend replaces the resource in its slot at the next dispatch, a released one gives the slot back now
+    if (resource->resource == nullptr)
+    {
+        FfxInterface& backendInterface = context->contextDescription.backendInterface;
+        if (registered.internalResource.internalIndex != 0 && backendInterface.fpRegisterPersistentResource)
+            backendInterface.fpRegisterPersistentResource(&backendInterface, resource, context->effectContextId, &registered.internalResource);
+
+        registered.internalResource.internalIndex = 0;
+        registeredHandle                          = 0;
+    }
+
+    *handle = registeredHandle;
+    return FFX_OK;
+}
+
 FfxErrorCode ffxNssContextCreate(FfxNssContext* context, const FfxNssContextDescription* contextDescription)
 {
     // zero context memory
@@ -1415,6 +3587,11 @@ FfxErrorCode ffxNssContextDestroy(FfxNssContext* context)
 }
 
 FfxErrorCode ffxNssContextDispatch(FfxNssContext* context, const FfxNssDispatchDescription* dispatchParams)
+{
+    return ffxNssContextDispatchViews(context, dispatchParams, 1);
+}
+
+FfxErrorCode ffxNssContextDispatchViews(FfxNssContext* context, const FfxNssDispatchDescription* dispatchParams, uint32_t viewCount)
 {
     FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
     FFX_RETURN_ON_ERROR(dispatchParams, FFX_ERROR_INVALID_POINTER);
@@ -1422,26 +3599,125 @@ FfxErrorCode ffxNssContextDispatch(FfxNssContext* context, const FfxNssDispatchD
     FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
     FFX_ASSERT(contextPrivate);
 
-    // validate zero sizes.
-    FFX_RETURN_ON_ERROR(dispatchParams->renderSize.width, FFX_ERROR_INVALID_ARGUMENT);
-    FFX_RETURN_ON_ERROR(dispatchParams->renderSize.height, FFX_ERROR_INVALID_ARGUMENT);
-    FFX_RETURN_ON_ERROR(dispatchParams->upscaleSize.width, FFX_ERROR_INVALID_ARGUMENT);
-    FFX_RETURN_ON_ERROR(dispatchParams->upscaleSize.height, FFX_ERROR_INVALID_ARGUMENT);
-
-    // validate that renderSize/upscaleSize match the size declared at context creation.
-    FFX_RETURN_ON_ERROR(dispatchParams->renderSize.width == contextPrivate->contextDescription.maxRenderSize.width, FFX_ERROR_OUT_OF_RANGE);
-    FFX_RETURN_ON_ERROR(dispatchParams->renderSize.height == contextPrivate->contextDescription.maxRenderSize.height, FFX_ERROR_OUT_OF_RANGE);
-    FFX_RETURN_ON_ERROR(dispatchParams->upscaleSize.width == contextPrivate->contextDescription.maxUpscaleSize.width, FFX_ERROR_OUT_OF_RANGE);
-    FFX_RETURN_ON_ERROR(dispatchParams->upscaleSize.height == contextPrivate->contextDescription.maxUpscaleSize.height, FFX_ERROR_OUT_OF_RANGE);
-    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+    // every view of the context is upscaled by each dispatch
+    FFX_RETURN_ON_ERROR(viewCount == contextPrivate->viewCount, FFX_ERROR_INVALID_ARGUMENT);
+
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+    {
+        const FfxNssDispatchDescription& view = dispatchParams[viewIndex];
+
+        // validate zero sizes.
+        FFX_RETURN_ON_ERROR(view.renderSize.width, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(view.renderSize.height, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(view.upscaleSize.width, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(view.upscaleSize.height, FFX_ERROR_INVALID_ARGUMENT);
+
+        // validate that renderSize/upscaleSize match the size declared at context creation.
+        FFX_RETURN_ON_ERROR(view.renderSize.width == contextPrivate->contextDescription.maxRenderSize.width, FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(view.renderSize.height == contextPrivate->contextDescription.maxRenderSize.height, FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(view.upscaleSize.width == contextPrivate->contextDescription.maxUpscaleSize.width, FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(view.upscaleSize.height == contextPrivate->contextDescription.maxUpscaleSize.height, FFX_ERROR_OUT_OF_RANGE);
+
+        // validate the region of interest, which only a context created for it can offset.
+        const bool regionOffset = view.renderOffset.x || view.renderOffset.y || view.upscaleOffset.x || view.upscaleOffset.y;
+        FFX_RETURN_ON_ERROR((contextPrivate->regionOfInterest && !contextPrivate->foveated) || !regionOffset, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(view.renderOffset.x >= 0 && view.renderOffset.y >= 0, FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(view.upscaleOffset.x >= 0 && view.upscaleOffset.y >= 0, FFX_ERROR_OUT_OF_RANGE);
+    }
 
     FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
 
+    // use the registered resources the views name in place of their own
+    FfxNssDispatchDescription views[FFX_NSS_MAX_VIEW_COUNT];
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex)
+    {
+        views[viewIndex] = dispatchParams[viewIndex];
+        FFX_VALIDATE(resolveRegisteredResources(contextPrivate, &views[viewIndex]));
+    }
+
     // dispatch the NSS passes.
-    const FfxErrorCode errorCode = nssDispatch(contextPrivate, dispatchParams);
+    const FfxErrorCode errorCode = nssDispatch(contextPrivate, views, viewCount);
     return errorCode;
 }
 
+FfxErrorCode ffxNssContextSetModel(FfxNssContext* context, const FfxNssModelDescription* modelDescription)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(modelDescription, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(modelDescription->dataGraph, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+
+    return nssSetModel(contextPrivate, modelDescription);
+}
+
+FfxErrorCode ffxNssContextGetPipelinesReady(FfxNssContext* context, bool* outReady)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(outReady, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_INVALID_ARGUMENT);
+
+    const bool creationDone = contextPrivate->pipelineCreationDone.load(std::memory_order_acquire);
+    *outReady               = creationDone && contextPrivate->pipelineCreationResult == FFX_OK;
+
+    return creationDone ? contextPrivate->pipelineCreationResult : FFX_OK;
+}
+
+FfxErrorCode ffxNssContextWarmupPipelines(FfxNssContext* context, const FfxNssWarmupDescription* warmupDescription)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(warmupDescription, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+
+    return nssWarmupPipelines(contextPrivate, warmupDescription);
+}
+
+FfxErrorCode ffxNssContextGetPipelineCacheData(FfxNssContext* context, void* data, size_t* dataSize)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(dataSize, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+
+    FfxInterface& backendInterface = contextPrivate->contextDescription.backendInterface;
+    if (backendInterface.fpGetPipelineCacheData == nullptr)
+    {
+        *dataSize = 0;
+        return FFX_OK;
+    }
+
+    return backendInterface.fpGetPipelineCacheData(&backendInterface, data, dataSize);
+}
+
+FfxErrorCode ffxNssContextSetCapture(FfxNssContext* context, const FfxNssCaptureDescription* captureDescription)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(captureDescription, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+
+    return nssSetCapture(contextPrivate, captureDescription);
+}
+
+FfxErrorCode ffxNssContextRegisterResource(FfxNssContext* context, const FfxResource* resource, FfxUInt32* inOutHandle)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(resource, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(inOutHandle, FFX_ERROR_INVALID_POINTER);
+
+    FfxNssContext_Private* contextPrivate = (FfxNssContext_Private*)(context);
+    FFX_RETURN_ON_ERROR(contextPrivate->device, FFX_ERROR_NULL_DEVICE);
+
+    return nssRegisterResource(contextPrivate, resource, inOutHandle);
+}
+
 int32_t ffxNssGetJitterPhaseCount(int32_t renderWidth, int32_t displayWidth)
 {
     const float   basePhaseCount   = 8.0f;
@@ -0,0 +1,749 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#include "FidelityFX/host/ffx_nss.h"
+#define FFX_CPU
+
+#include "FidelityFX/host/ffx_util.h"
+
+#include "ffx_nss_network.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+// SPIR-V opcodes read by the parser
+static constexpr uint32_t SPV_OP_EXT_INST_IMPORT                  = 11;
+static constexpr uint32_t SPV_OP_EXT_INST                         = 12;
+static constexpr uint32_t SPV_OP_TYPE_INT                         = 21;
+static constexpr uint32_t SPV_OP_TYPE_ARRAY                       = 28;
+static constexpr uint32_t SPV_OP_CONSTANT_TRUE                    = 41;
+static constexpr uint32_t SPV_OP_CONSTANT_FALSE                   = 42;
+static constexpr uint32_t SPV_OP_CONSTANT                         = 43;
+static constexpr uint32_t SPV_OP_CONSTANT_COMPOSITE               = 44;
+static constexpr uint32_t SPV_OP_CONSTANT_NULL                    = 46;
+static constexpr uint32_t SPV_OP_DECORATE                         = 71;
+static constexpr uint32_t SPV_OP_TYPE_TENSOR_ARM                  = 4163;
+static constexpr uint32_t SPV_OP_GRAPH_CONSTANT_ARM               = 4181;
+static constexpr uint32_t SPV_OP_GRAPH_ENTRY_POINT_ARM            = 4182;
+static constexpr uint32_t SPV_OP_GRAPH_ARM                        = 4183;
+static constexpr uint32_t SPV_OP_GRAPH_INPUT_ARM                  = 4184;
+static constexpr uint32_t SPV_OP_GRAPH_SET_OUTPUT_ARM             = 4185;
+static constexpr uint32_t SPV_OP_TYPE_GRAPH_ARM                   = 4190;
+static constexpr uint32_t SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT = 4461;
+
+static constexpr uint32_t SPV_DECORATION_BINDING        = 33;
+static constexpr uint32_t SPV_DECORATION_DESCRIPTOR_SET = 34;
+
+// TOSA.001000.1 extended instructions
+static constexpr uint32_t TOSA_CONV2D  = 2;
+static constexpr uint32_t TOSA_TABLE   = 30;
+static constexpr uint32_t TOSA_CONCAT  = 54;
+static constexpr uint32_t TOSA_RESIZE  = 63;
+static constexpr uint32_t TOSA_RESCALE = 65;
+
+static constexpr int64_t TOSA_ACC_TYPE_INT32          = 1;
+static constexpr int64_t TOSA_RESIZE_NEAREST_NEIGHBOR = 1;
+static constexpr int64_t TOSA_ROUNDING_MODE_SINGLE    = 1;
+static constexpr int64_t TOSA_ROUNDING_MODE_DOUBLE    = 3;
+
+static constexpr uint32_t TOSA_TABLE_SIZE = 256;
+
+typedef struct SpirvInstruction
+{
+    uint32_t        opcode;
+    const uint32_t* operands;
+    uint32_t        operandCount;
+} SpirvInstruction;
+
+// The declarations of a graph module the network is built from
+typedef struct SpirvGraphModule
+{
+    std::unordered_map<uint32_t, uint32_t>         intWidths;       ///< OpTypeInt result -> width
+    std::unordered_map<uint32_t, uint32_t>         arrayLengths;    ///< OpTypeArray result -> length constant
+    std::unordered_map<uint32_t, uint32_t>         tensorShapes;    ///< OpTypeTensorARM result -> shape constant, 0 if unranked
+    std::unordered_map<uint32_t, uint32_t>         tensorElements;  ///< OpTypeTensorARM result -> element type
+    std::unordered_map<uint32_t, SpirvInstruction> constants;       ///< Constant result -> instruction
+    std::unordered_map<uint32_t, uint32_t>         graphConstants;  ///< OpGraphConstantARM result -> index into the blob constants
+    std::unordered_map<uint32_t, uint32_t>         graphInputs;     ///< OpGraphInputARM result -> input index
+    std::unordered_map<uint32_t, uint32_t>         graphOutputs;    ///< Value written by OpGraphSetOutputARM -> output index
+    std::unordered_map<uint32_t, uint32_t>         graphInputCounts;
+    std::unordered_map<uint32_t, uint32_t>         graphTypes;
+    std::unordered_map<uint32_t, uint32_t>         bindings;
+    std::unordered_map<uint32_t, uint32_t>         descriptorSets;
+    std::vector<SpirvInstruction>                  operations;  ///< OpExtInst of the TOSA instruction set, in order
+    std::vector<uint32_t>                          interfaceIds;
+    uint32_t                                       entryPointGraph;
+} SpirvGraphModule;
+
+// A tensor a layer can read: a layer output, optionally upsampled
+typedef struct NetworkSource
+{
+    uint32_t resourceId;
+    int32_t  width;
+    int32_t  height;
+    int32_t  channels;
+    int32_t  factor;
+} NetworkSource;
+
+// What a SPIR-V value of the graph resolves to
+typedef struct NetworkValue
+{
+    uint32_t        sourceCount;  ///< Number of sources the value concatenates, 0 for a layer which isn't written yet
+    NetworkSource   sources[2];
+    int32_t         width;
+    int32_t         height;
+    int32_t         channels;
+    NssNetworkLayer layer;     ///< The layer producing the value, while it isn't written yet
+    bool            rescaled;  ///< The layer has its rescale, only a table may still be fused
+} NetworkValue;
+
+static uint32_t stringWordCount(const uint32_t* words, uint32_t wordCount)
+{
+    for (uint32_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        if ((words[wordIndex] >> 24) == 0)
+            return wordIndex + 1;
+    }
+    return wordCount;
+}
+
+static bool parseGraphModule(const FfxDataGraphBlob* dataGraph, SpirvGraphModule& module)
+{
+    const uint32_t* words     = reinterpret_cast<const uint32_t*>(dataGraph->graphData);
+    const uint32_t  wordCount = dataGraph->graphDataSize / sizeof(uint32_t);
+
+    // Skip the header, whose first word is the magic number
+    if (wordCount < 5 || words[0] != 0x07230203)
+        return false;
+
+    uint32_t tosaInstructionSet = 0;
+    module.entryPointGraph      = 0;
+    for (uint32_t position = 5; position < wordCount;)
+    {
+        const uint32_t instructionWordCount = words[position] >> 16;
+        if (instructionWordCount == 0 || position + instructionWordCount > wordCount)
+            return false;
+
+        const SpirvInstruction instruction = {words[position] & 0xffff, words + position + 1, instructionWordCount - 1};
+        const uint32_t*        operands    = instruction.operands;
+        position += instructionWordCount;
+
+        switch (instruction.opcode)
+        {
+        case SPV_OP_EXT_INST_IMPORT:
+            if (strncmp(reinterpret_cast<const char*>(operands + 1), "TOSA.", 5) == 0)
+                tosaInstructionSet = operands[0];
+            break;
+        case SPV_OP_TYPE_INT:
+            module.intWidths[operands[0]] = operands[1];
+            break;
+        case SPV_OP_TYPE_ARRAY:
+            module.arrayLengths[operands[0]] = operands[2];
+            break;
+        case SPV_OP_TYPE_TENSOR_ARM:
+            module.tensorElements[operands[0]] = operands[1];
+            module.tensorShapes[operands[0]]   = (instruction.operandCount > 3) ? operands[3] : 0;
+            break;
+        case SPV_OP_CONSTANT_TRUE:
+        case SPV_OP_CONSTANT_FALSE:
+        case SPV_OP_CONSTANT:
+        case SPV_OP_CONSTANT_COMPOSITE:
+        case SPV_OP_CONSTANT_NULL:
+        case SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT:
+            module.constants[operands[1]] = instruction;
+            break;
+        case SPV_OP_GRAPH_CONSTANT_ARM:
+        {
+            uint32_t constantIndex = 0;
+            while (constantIndex < dataGraph->constantNums && dataGraph->constantIds[constantIndex] != operands[2])
+                ++constantIndex;
+            if (constantIndex == dataGraph->constantNums)
+                return false;
+            module.graphConstants[operands[1]] = constantIndex;
+            module.constants[operands[1]]      = instruction;
+            break;
+        }
+        case SPV_OP_GRAPH_ENTRY_POINT_ARM:
+        {
+            if (module.entryPointGraph != 0)
+                return false;
+            module.entryPointGraph      = operands[0];
+            const uint32_t nameWords    = stringWordCount(operands + 1, instruction.operandCount - 1);
+            const uint32_t firstOperand = 1 + nameWords;
+            module.interfaceIds.assign(operands + firstOperand, operands + instruction.operandCount);
+            break;
+        }
+        case SPV_OP_TYPE_GRAPH_ARM:
+            module.graphInputCounts[operands[0]] = operands[1];
+            break;
+        case SPV_OP_GRAPH_ARM:
+            module.graphTypes[operands[1]] = operands[0];
+            break;
+        case SPV_OP_GRAPH_INPUT_ARM:
+            module.graphInputs[operands[1]] = operands[2];
+            break;
+        case SPV_OP_GRAPH_SET_OUTPUT_ARM:
+            module.graphOutputs[operands[0]] = operands[1];
+            break;
+        case SPV_OP_DECORATE:
+            if (operands[1] == SPV_DECORATION_BINDING)
+                module.bindings[operands[0]] = operands[2];
+            else if (operands[1] == SPV_DECORATION_DESCRIPTOR_SET)
+                module.descriptorSets[operands[0]] = operands[2];
+            break;
+        case SPV_OP_EXT_INST:
+            // Any other instruction set can't be run by the compute shaders
+            if (operands[2] != tosaInstructionSet || tosaInstructionSet == 0)
+                return false;
+            module.operations.push_back(instruction);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return module.entryPointGraph != 0;
+}
+
+// Flattens a constant into its integer elements. Constants are signless, so values are sign extended by their type's width.
+static bool evaluateConstant(const SpirvGraphModule& module, uint32_t id, std::vector<int64_t>& values);
+
+static bool evaluateScalar(const SpirvGraphModule& module, uint32_t id, int64_t& value)
+{
+    std::vector<int64_t> values;
+    if (!evaluateConstant(module, id, values) || values.size() != 1)
+        return false;
+    value = values[0];
+    return true;
+}
+
+static bool getElementCount(const SpirvGraphModule& module, uint32_t type, int64_t& count)
+{
+    if (module.arrayLengths.count(type) != 0)
+        return evaluateScalar(module, module.arrayLengths.at(type), count);
+
+    if (module.tensorShapes.count(type) != 0)
+    {
+        std::vector<int64_t> shape;
+        if (module.tensorShapes.at(type) == 0 || !evaluateConstant(module, module.tensorShapes.at(type), shape))
+            return false;
+        count = 1;
+        for (const int64_t dimension : shape)
+            count *= dimension;
+        return true;
+    }
+
+    count = 1;
+    return true;
+}
+
+static bool evaluateConstant(const SpirvGraphModule& module, uint32_t id, std::vector<int64_t>& values)
+{
+    const auto constant = module.constants.find(id);
+    if (constant == module.constants.end())
+        return false;
+
+    const SpirvInstruction& instruction = constant->second;
+    const uint32_t          type        = instruction.operands[0];
+    switch (instruction.opcode)
+    {
+    case SPV_OP_CONSTANT_TRUE:
+    case SPV_OP_CONSTANT_FALSE:
+        values.push_back(instruction.opcode == SPV_OP_CONSTANT_TRUE);
+        return true;
+    case SPV_OP_CONSTANT:
+    {
+        const auto width = module.intWidths.find(type);
+        if (width == module.intWidths.end() || width->second > 32)
+            return false;
+        const uint32_t shift = 32 - width->second;
+        values.push_back(int64_t(int32_t(instruction.operands[2] << shift) >> shift));
+        return true;
+    }
+    case SPV_OP_CONSTANT_COMPOSITE:
+        for (uint32_t operandIndex = 2; operandIndex < instruction.operandCount; ++operandIndex)
+        {
+            if (!evaluateConstant(module, instruction.operands[operandIndex], values))
+                return false;
+        }
+        return true;
+    case SPV_OP_CONSTANT_NULL:
+    case SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT:
+    {
+        int64_t count = 0;
+        int64_t value = 0;
+        if (!getElementCount(module, type, count))
+            return false;
+        if (instruction.opcode == SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT && !evaluateScalar(module, instruction.operands[2], value))
+            return false;
+        values.insert(values.end(), size_t(count), value);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// Evaluates a constant operand which must have count elements, a single element is broadcast.
+static bool evaluateOperand(const SpirvGraphModule& module, uint32_t id, size_t count, std::vector<int64_t>& values)
+{
+    values.clear();
+    if (!evaluateConstant(module, id, values))
+        return false;
+    if (values.size() == 1)
+        values.resize(count, values[0]);
+    return values.size() == count;
+}
+
+// Returns the dense data of a graph constant of the given element width, expanded into storage if the constant is compressed.
+static const unsigned char* getGraphConstant(const FfxDataGraphBlob*     dataGraph,
+                                             const SpirvGraphModule&     module,
+                                             uint32_t                    id,
+                                             uint32_t                    elementWidth,
+                                             std::vector<int64_t>&       shape,
+                                             std::vector<unsigned char>& storage)
+{
+    const auto graphConstant = module.graphConstants.find(id);
+    if (graphConstant == module.graphConstants.end())
+        return nullptr;
+
+    // A sparsity dimension without zero counts doesn't say how the data is laid out
+    const uint32_t constantIndex = graphConstant->second;
+    const uint32_t type          = module.constants.at(id).operands[0];
+    const auto     element       = module.tensorElements.find(type);
+    const bool     compressed    = ffxDataGraphConstantIsCompressed(*dataGraph, constantIndex);
+    if (element == module.tensorElements.end() || module.intWidths.count(element->second) == 0 ||
+        module.intWidths.at(element->second) != elementWidth || (dataGraph->constantSparsityDimensions[constantIndex] != -1 && !compressed))
+        return nullptr;
+
+    shape.assign(dataGraph->constantShapes[constantIndex], dataGraph->constantShapes[constantIndex] + dataGraph->constantShapeSize[constantIndex]);
+
+    int64_t elementCount = 1;
+    for (const int64_t dimension : shape)
+        elementCount *= dimension;
+    if (int64_t(dataGraph->constantDataSize[constantIndex]) != elementCount * elementWidth / 8)
+        return nullptr;
+
+    if (!compressed)
+        return dataGraph->constantDatas[constantIndex];
+
+    storage.resize(dataGraph->constantDataSize[constantIndex]);
+    return ffxDataGraphExpandConstant(*dataGraph, constantIndex, storage.data()) ? storage.data() : nullptr;
+}
+
+// Checks whether every 4 input channels of a [output channel, kernel height, kernel width, input channel] weight constant hold at most 2 non-zero weights.
+static bool isSparse2x4(const FfxDataGraphBlob* dataGraph, const SpirvGraphModule& module, uint32_t id)
+{
+    const uint32_t constantIndex = module.graphConstants.at(id);
+    return ffxDataGraphConstantIsCompressed(*dataGraph, constantIndex) && dataGraph->constantSparsityDimensions[constantIndex] == 3 &&
+           dataGraph->constantSparsityGroupSizes[constantIndex] == 4 && dataGraph->constantSparsityZeroCounts[constantIndex] >= 2;
+}
+
+// Returns the index of the blob tensor bound to an entry point interface variable.
+static bool getInterfaceTensor(const FfxDataGraphBlob* dataGraph, const SpirvGraphModule& module, uint32_t interfaceIndex, uint32_t& tensorIndex)
+{
+    if (interfaceIndex >= module.interfaceIds.size())
+        return false;
+
+    const uint32_t variable = module.interfaceIds[interfaceIndex];
+    if (module.bindings.count(variable) == 0 || module.descriptorSets.count(variable) == 0)
+        return false;
+
+    for (tensorIndex = 0; tensorIndex < dataGraph->tensorNums; ++tensorIndex)
+    {
+        if (dataGraph->tensorBindings[tensorIndex] == module.bindings.at(variable) && dataGraph->tensorSets[tensorIndex] == module.descriptorSets.at(variable))
+            return dataGraph->tensorDimSize[tensorIndex] == 4;
+    }
+    return false;
+}
+
+static bool addConvolution(const FfxDataGraphBlob*  dataGraph,
+                           const SpirvGraphModule&  module,
+                           const SpirvInstruction&  operation,
+                           const NetworkValue&      input,
+                           NetworkValue&            value,
+                           std::vector<uint32_t>&   parameters)
+{
+    // pad, stride, dilation, acc_type, local_bound, input, weight, bias, input_zp, weight_zp
+    const uint32_t* operands = operation.operands + 4;
+    if (operation.operandCount != 14 || input.sourceCount == 0)
+        return false;
+
+    std::vector<int64_t> pad, stride, dilation, weightShape, inputZeroPoint, weightZeroPoint;
+    int64_t              accumulatorType = 0;
+    if (!evaluateOperand(module, operands[0], 4, pad) || !evaluateOperand(module, operands[1], 2, stride) ||
+        !evaluateOperand(module, operands[2], 2, dilation) || !evaluateScalar(module, operands[3], accumulatorType) ||
+        accumulatorType != TOSA_ACC_TYPE_INT32)
+        return false;
+
+    std::vector<unsigned char> weightStorage, biasStorage;
+    const unsigned char*       weights = getGraphConstant(dataGraph, module, operands[6], 8, weightShape, weightStorage);
+    if (weights == nullptr || weightShape.size() != 4)
+        return false;
+
+    // Weights are [output channels, kernel height, kernel width, input channels], each layer invocation produces 4 channels from 4 channel words
+    const int32_t outputChannels = int32_t(weightShape[0]);
+    const int32_t kernelHeight   = int32_t(weightShape[1]);
+    const int32_t kernelWidth    = int32_t(weightShape[2]);
+    const int32_t inputChannels  = int32_t(weightShape[3]);
+    if (inputChannels != input.channels || (inputChannels % 4) != 0 || (outputChannels % 4) != 0)
+        return false;
+
+    std::vector<int64_t> bias, biasShape;
+    const unsigned char* biasData = getGraphConstant(dataGraph, module, operands[7], 32, biasShape, biasStorage);
+    if (biasData != nullptr)
+    {
+        if (biasShape.size() != 1 || biasShape[0] != outputChannels)
+            return false;
+        const int32_t* biasValues = reinterpret_cast<const int32_t*>(biasData);
+        bias.assign(biasValues, biasValues + outputChannels);
+    }
+    else if (!evaluateOperand(module, operands[7], size_t(outputChannels), bias))
+    {
+        return false;
+    }
+
+    if (!evaluateOperand(module, operands[8], 1, inputZeroPoint) || !evaluateOperand(module, operands[9], 1, weightZeroPoint) || weightZeroPoint[0] != 0)
+        return false;
+
+    // Output sizes have to be exact, as required by TOSA
+    const int64_t paddedHeight = input.height - 1 + pad[0] + pad[1] - (kernelHeight - 1) * dilation[0];
+    const int64_t paddedWidth  = input.width - 1 + pad[2] + pad[3] - (kernelWidth - 1) * dilation[1];
+    if (stride[0] <= 0 || stride[1] <= 0 || paddedHeight < 0 || paddedWidth < 0 || (paddedHeight % stride[0]) != 0 || (paddedWidth % stride[1]) != 0)
+        return false;
+
+    memset(&value.layer, 0, sizeof(NssNetworkLayer));
+    NssNetworkLayerConstants& constants = value.layer.constants;
+
+    value.sourceCount = 0;
+    value.rescaled    = false;
+    value.width       = int32_t(paddedWidth / stride[1] + 1);
+    value.height      = int32_t(paddedHeight / stride[0] + 1);
+    value.channels    = outputChannels;
+
+    const NetworkSource& source0 = input.sources[0];
+    const NetworkSource& source1 = input.sources[input.sourceCount - 1];
+    value.layer.sourceResourceIds[0] = source0.resourceId;
+    value.layer.sourceResourceIds[1] = source1.resourceId;
+
+    const FfxInt32x4 outputShape  = {value.width, value.height, outputChannels, inputChannels};
+    const FfxInt32x4 convolution  = {int32_t(stride[1]), int32_t(stride[0]), int32_t(pad[2]), int32_t(pad[0])};
+    const FfxInt32x4 kernel       = {kernelWidth, kernelHeight, int32_t(dilation[1]), int32_t(dilation[0])};
+    const FfxInt32x4 sourceShape0 = {source0.width, source0.height, source0.channels, source0.factor};
+    const FfxInt32x4 sourceShape1 = {source1.width, source1.height, source1.channels, source1.factor};
+    memcpy(constants._OutputShape, outputShape, sizeof(FfxInt32x4));
+    memcpy(constants._Convolution, convolution, sizeof(FfxInt32x4));
+    memcpy(constants._Kernel, kernel, sizeof(FfxInt32x4));
+    memcpy(constants._Source0, sourceShape0, sizeof(FfxInt32x4));
+    memcpy(constants._Source1, sourceShape1, sizeof(FfxInt32x4));
+
+    // The zero point is read for padding taps and folded into the bias, so (input - zero point) * weight is never computed
+    const uint32_t zeroPointByte = uint32_t(inputZeroPoint[0]) & 0xff;
+    constants._Quantization[0]   = int32_t(zeroPointByte * 0x01010101u);
+
+    const size_t kernelSize    = size_t(kernelHeight) * kernelWidth * inputChannels;
+    constants._Parameters[0]   = int32_t(parameters.size());
+    constants._Parameters[2]   = -1;
+    constants._Parameters[3]   = -1;
+    parameters.resize(parameters.size() + outputChannels * kernelSize / 4);
+    memcpy(&parameters[constants._Parameters[0]], weights, outputChannels * kernelSize);
+
+    // 2:4 sparse weights are also kept as the 2 weights of each word and their byte indices {weight 0, weight 1, index 0 | index 1 << 2, 0},
+    // so the CPU backend does half the multiplications. The shaders read the dense weights.
+    if (isSparse2x4(dataGraph, module, operands[6]))
+    {
+        constants._Parameters[3] = int32_t(parameters.size());
+        for (size_t wordIndex = 0; wordIndex < outputChannels * kernelSize / 4; ++wordIndex)
+        {
+            const unsigned char* word = &weights[wordIndex * 4];
+
+            // The zeros fill in for words with fewer than 2 non-zero weights
+            uint32_t indices[2] = {0, 1};
+            uint32_t keptCount  = 0;
+            for (uint32_t i = 0; i < 4 && keptCount < 2; ++i)
+                if (word[i] != 0)
+                    indices[keptCount++] = i;
+            for (uint32_t i = 0; i < 4 && keptCount < 2; ++i)
+                if (word[i] == 0)
+                    indices[keptCount++] = i;
+            if (indices[0] > indices[1])
+                std::swap(indices[0], indices[1]);
+
+            parameters.push_back(uint32_t(word[indices[0]]) | (uint32_t(word[indices[1]]) << 8) | ((indices[0] | (indices[1] << 2)) << 16));
+        }
+    }
+
+    // Channel parameters are {bias, multiplier, shift, unused}, the rescale fills in the rest
+    constants._Parameters[1] = int32_t(parameters.size());
+    for (int32_t outputChannel = 0; outputChannel < outputChannels; ++outputChannel)
+    {
+        int64_t weightSum = 0;
+        for (size_t weightIndex = 0; weightIndex < kernelSize; ++weightIndex)
+            weightSum += int8_t(weights[outputChannel * kernelSize + weightIndex]);
+
+        parameters.push_back(uint32_t(int32_t(bias[outputChannel] - inputZeroPoint[0] * weightSum)));
+        parameters.insert(parameters.end(), 3, 0);
+    }
+
+    return true;
+}
+
+static bool addRescale(const SpirvGraphModule& module, const SpirvInstruction& operation, NetworkValue& value, std::vector<uint32_t>& parameters)
+{
+    // scale32, rounding_mode, per_channel, input_unsigned, output_unsigned, input, multiplier, shift, input_zp, output_zp
+    const uint32_t* operands = operation.operands + 4;
+    if (operation.operandCount != 14 || value.sourceCount != 0 || value.rescaled)
+        return false;
+
+    int64_t              scale32 = 0, roundingMode = 0, perChannel = 0, inputUnsigned = 0, outputUnsigned = 0;
+    std::vector<int64_t> multipliers, shifts, inputZeroPoint, outputZeroPoint;
+    if (!evaluateScalar(module, operands[0], scale32) || !evaluateScalar(module, operands[1], roundingMode) ||
+        !evaluateScalar(module, operands[2], perChannel) || !evaluateScalar(module, operands[3], inputUnsigned) ||
+        !evaluateScalar(module, operands[4], outputUnsigned))
+        return false;
+
+    const bool doubleRound = roundingMode == TOSA_ROUNDING_MODE_DOUBLE;
+    if (!scale32 || inputUnsigned || outputUnsigned || (roundingMode != TOSA_ROUNDING_MODE_SINGLE && !doubleRound))
+        return false;
+
+    const size_t channelCount = perChannel ? size_t(value.channels) : 1;
+    if (!evaluateOperand(module, operands[6], channelCount, multipliers) || !evaluateOperand(module, operands[7], channelCount, shifts) ||
+        !evaluateOperand(module, operands[8], 1, inputZeroPoint) || !evaluateOperand(module, operands[9], 1, outputZeroPoint) ||
+        inputZeroPoint[0] != 0)
+        return false;
+
+    for (int32_t outputChannel = 0; outputChannel < value.channels; ++outputChannel)
+    {
+        const size_t  scaleIndex = perChannel ? size_t(outputChannel) : 0;
+        const int64_t shift      = shifts[scaleIndex];
+        if (shift < 2 || shift > 62)
+            return false;
+
+        const size_t channelIndex         = size_t(value.layer.constants._Parameters[1]) + outputChannel * 4;
+        parameters[channelIndex + 1] = uint32_t(int32_t(multipliers[scaleIndex]));
+        parameters[channelIndex + 2] = uint32_t(shift);
+    }
+
+    value.layer.constants._Quantization[1] = int32_t(outputZeroPoint[0]);
+    value.layer.constants._Quantization[2] = doubleRound ? 1 : 0;
+    value.rescaled                         = true;
+    return true;
+}
+
+static bool addTable(const SpirvGraphModule& module, const SpirvInstruction& operation, NetworkValue& value, std::vector<uint32_t>& parameters)
+{
+    // input, table
+    std::vector<int64_t> table;
+    if (operation.operandCount != 6 || value.sourceCount != 0 || !value.rescaled || !evaluateOperand(module, operation.operands[5], TOSA_TABLE_SIZE, table))
+        return false;
+
+    // Entries are indexed by value + 128, 4 to a word
+    value.layer.constants._Parameters[2] = int32_t(parameters.size());
+    parameters.resize(parameters.size() + TOSA_TABLE_SIZE / 4, 0);
+    for (uint32_t entryIndex = 0; entryIndex < TOSA_TABLE_SIZE; ++entryIndex)
+        parameters[value.layer.constants._Parameters[2] + entryIndex / 4] |= (uint32_t(table[entryIndex]) & 0xff) << ((entryIndex % 4) * 8);
+
+    return true;
+}
+
+// A nearest neighbour resize the layers can read as an integer upsampling factor: output o samples input o / factor.
+static bool getResizeFactor(int64_t numerator, int64_t denominator, int64_t offset, int64_t border, int32_t inputSize, int32_t& factor)
+{
+    if (denominator <= 0 || numerator <= 0 || (numerator % denominator) != 0)
+        return false;
+
+    factor                   = int32_t(numerator / denominator);
+    const int64_t outputSize = ((inputSize - 1) * numerator - offset + border) / denominator + 1;
+    if (outputSize != int64_t(inputSize) * factor)
+        return false;
+
+    for (int64_t output = 0; output < outputSize; ++output)
+    {
+        const int64_t position = output * denominator + offset;
+        int64_t       index    = (position >= 0) ? position / numerator : -((numerator - 1 - position) / numerator);
+        if (2 * (position - index * numerator) >= numerator)
+            ++index;
+        index = std::min<int64_t>(std::max<int64_t>(index, 0), inputSize - 1);
+
+        if (index != output / factor)
+            return false;
+    }
+    return true;
+}
+
+static bool addResize(const SpirvGraphModule& module, const SpirvInstruction& operation, const NetworkValue& input, NetworkValue& value)
+{
+    // mode, input, scale, offset, border
+    const uint32_t*      operands = operation.operands + 4;
+    int64_t              mode     = 0;
+    std::vector<int64_t> scale, offset, border;
+    if (operation.operandCount != 9 || input.sourceCount != 1 || input.sources[0].factor != 1 || !evaluateScalar(module, operands[0], mode) ||
+        mode != TOSA_RESIZE_NEAREST_NEIGHBOR || !evaluateOperand(module, operands[2], 4, scale) || !evaluateOperand(module, operands[3], 2, offset) ||
+        !evaluateOperand(module, operands[4], 2, border))
+        return false;
+
+    int32_t factorY = 0, factorX = 0;
+    if (!getResizeFactor(scale[0], scale[1], offset[0], border[0], input.height, factorY) ||
+        !getResizeFactor(scale[2], scale[3], offset[1], border[1], input.width, factorX) || factorX != factorY)
+        return false;
+
+    value                   = input;
+    value.sources[0].factor = factorX;
+    value.width             = input.width * factorX;
+    value.height            = input.height * factorY;
+    return true;
+}
+
+static bool addConcat(
+    const SpirvGraphModule& module, const SpirvInstruction& operation, const NetworkValue& first, const NetworkValue& second, NetworkValue& value)
+{
+    // axis, input1, input2
+    int64_t axis = 0;
+    if (operation.operandCount != 7 || !evaluateScalar(module, operation.operands[4], axis) || axis != 3 || first.sourceCount != 1 ||
+        second.sourceCount != 1 || first.width != second.width || first.height != second.height || (first.channels % 4) != 0)
+        return false;
+
+    value             = first;
+    value.sourceCount = 2;
+    value.sources[1]  = second.sources[0];
+    value.channels    = first.channels + second.channels;
+    return true;
+}
+
+FfxErrorCode nssParseNetwork(const FfxDataGraphBlob* dataGraph,
+                             const uint32_t*         tensorResourceIds,
+                             uint32_t                inputWidth,
+                             uint32_t                inputHeight,
+                             NssNetwork*             network,
+                             std::vector<uint32_t>&  parameters)
+{
+    FFX_ASSERT(dataGraph);
+    FFX_ASSERT(tensorResourceIds);
+    FFX_ASSERT(network);
+
+    memset(network, 0, sizeof(NssNetwork));
+    parameters.clear();
+
+    SpirvGraphModule module;
+    FFX_RETURN_ON_ERROR(parseGraphModule(dataGraph, module), FFX_ERROR_INVALID_ARGUMENT);
+
+    const auto graphType = module.graphTypes.find(module.entryPointGraph);
+    FFX_RETURN_ON_ERROR(graphType != module.graphTypes.end() && module.graphInputCounts.count(graphType->second) != 0, FFX_ERROR_INVALID_ARGUMENT);
+    const uint32_t inputCount = module.graphInputCounts.at(graphType->second);
+
+    // Count the uses of every value, a layer is only fused with the operation after it when that is its single user
+    std::unordered_map<uint32_t, uint32_t> useCounts;
+    std::unordered_map<uint32_t, uint32_t> userInstructions;
+    for (const SpirvInstruction& operation : module.operations)
+    {
+        for (uint32_t operandIndex = 4; operandIndex < operation.operandCount; ++operandIndex)
+        {
+            ++useCounts[operation.operands[operandIndex]];
+            userInstructions[operation.operands[operandIndex]] = operation.operands[3];
+        }
+    }
+    const auto useCount = [&useCounts](uint32_t id) { return useCounts.count(id) != 0 ? useCounts.at(id) : 0u; };
+
+    std::unordered_map<uint32_t, NetworkValue> values;
+    for (const auto& graphInput : module.graphInputs)
+    {
+        int64_t  inputIndex  = 0;
+        uint32_t tensorIndex = 0;
+        FFX_RETURN_ON_ERROR(evaluateScalar(module, graphInput.second, inputIndex) && inputIndex < inputCount, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(getInterfaceTensor(dataGraph, module, uint32_t(inputIndex), tensorIndex), FFX_ERROR_INVALID_ARGUMENT);
+
+        NetworkValue& value = values[graphInput.first];
+        memset(&value, 0, sizeof(NetworkValue));
+        value.sourceCount = 1;
+        value.width       = int32_t(inputWidth);
+        value.height      = int32_t(inputHeight);
+        value.channels    = int32_t(dataGraph->tensorDims[tensorIndex][3]);
+        value.sources[0]  = {tensorResourceIds[tensorIndex], value.width, value.height, value.channels, 1};
+    }
+
+    // Writes the layer producing a value, into the graph output or a new activation
+    uint32_t   writtenOutputCount = 0;
+    const auto writeLayer         = [&](uint32_t id, NetworkValue& value) {
+        uint32_t   resourceId = 0;
+        const auto output     = module.graphOutputs.find(id);
+        if (output != module.graphOutputs.end())
+        {
+            int64_t  outputIndex = 0;
+            uint32_t tensorIndex = 0;
+            if (useCount(id) != 0 || !evaluateScalar(module, output->second, outputIndex) ||
+                !getInterfaceTensor(dataGraph, module, inputCount + uint32_t(outputIndex), tensorIndex) ||
+                int32_t(dataGraph->tensorDims[tensorIndex][3]) != value.channels || uint32_t(value.width) != inputWidth ||
+                uint32_t(value.height) != inputHeight)
+                return false;
+
+            resourceId = tensorResourceIds[tensorIndex];
+            ++writtenOutputCount;
+        }
+        else
+        {
+            if (network->activationCount == FFX_NSS_NETWORK_MAX_ACTIVATIONS)
+                return false;
+
+            network->activations[network->activationCount] = {uint32_t(value.width), uint32_t(value.height), uint32_t(value.channels)};
+            resourceId = FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0 + network->activationCount++;
+        }
+
+        if (network->layerCount == FFX_NSS_NETWORK_MAX_LAYERS)
+            return false;
+
+        value.layer.outputResourceId            = resourceId;
+        network->layers[network->layerCount++] = value.layer;
+
+        value.sourceCount = 1;
+        value.sources[0]  = {resourceId, value.width, value.height, value.channels, 1};
+        return true;
+    };
+
+    for (const SpirvInstruction& operation : module.operations)
+    {
+        const uint32_t id          = operation.operands[1];
+        const uint32_t instruction = operation.operands[3];
+
+        // Every operation takes its input tensor first, after its attributes for some of them
+        const uint32_t inputOperand = (instruction == TOSA_CONV2D || instruction == TOSA_RESCALE) ? 9 : (instruction == TOSA_RESIZE) ? 5 : 4;
+        FFX_RETURN_ON_ERROR(instruction != TOSA_CONCAT || operation.operandCount == 7, FFX_ERROR_INVALID_ARGUMENT);
+        const uint32_t inputId = operation.operands[(instruction == TOSA_CONCAT) ? 5 : inputOperand];
+        FFX_RETURN_ON_ERROR(inputOperand < operation.operandCount && values.count(inputId) != 0, FFX_ERROR_INVALID_ARGUMENT);
+
+        NetworkValue value = values.at(inputId);
+        bool         valid = false;
+        bool         write = false;
+        switch (instruction)
+        {
+        case TOSA_CONV2D:
+            // The rescale is fused into the convolution, so nothing else may read the 32bit accumulators
+            valid = useCount(id) == 1 && addConvolution(dataGraph, module, operation, values.at(inputId), value, parameters);
+            break;
+        case TOSA_RESCALE:
+            valid = useCount(inputId) == 1 && addRescale(module, operation, value, parameters);
+            write = useCount(id) != 1 || module.graphOutputs.count(id) != 0 || userInstructions.at(id) != TOSA_TABLE;
+            break;
+        case TOSA_TABLE:
+            valid = useCount(inputId) == 1 && addTable(module, operation, value, parameters);
+            write = true;
+            break;
+        case TOSA_RESIZE:
+            valid = addResize(module, operation, values.at(inputId), value);
+            break;
+        case TOSA_CONCAT:
+            valid = values.count(operation.operands[6]) != 0 && addConcat(module, operation, values.at(inputId), values.at(operation.operands[6]), value);
+            break;
+        default:
+            break;
+        }
+
+        FFX_RETURN_ON_ERROR(valid, FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(!write || writeLayer(id, value), FFX_ERROR_INVALID_ARGUMENT);
+        values[id] = value;
+    }
+
+    // Every output has to be written by a layer
+    FFX_RETURN_ON_ERROR(writtenOutputCount == module.graphOutputs.size() && module.interfaceIds.size() == inputCount + writtenOutputCount,
+                        FFX_ERROR_INVALID_ARGUMENT);
+    return FFX_OK;
+}
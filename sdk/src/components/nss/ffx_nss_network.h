@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "FidelityFX/host/ffx_nss.h"
+#include "FidelityFX/gpu/nss/ffx_nss_resources.h"
+
+#include <vector>
+
+/// The maximum number of layers of a network run with compute shaders.
+///
+/// Every layer is a dispatch of the same pipeline, which is created with a descriptor set for each of them a frame.
+///
+/// @ingroup ffxNss
+#define FFX_NSS_NETWORK_MAX_LAYERS 24
+
+/// Constants pushed for one layer of the compute shader network.
+///
+/// Matches <c><i>cbNetworkLayer_t</i></c> in ffx_nss_callbacks_glsl.h.
+///
+/// @ingroup ffxNss
+typedef struct NssNetworkLayerConstants
+{
+    FfxInt32x4 _OutputShape;   ///< .xy = output width/height, .z = output channels, .w = input channels
+    FfxInt32x4 _Convolution;   ///< .xy = stride, .zw = left/top padding
+    FfxInt32x4 _Kernel;        ///< .xy = kernel width/height, .zw = dilation
+    FfxInt32x4 _Source0;       ///< .xy = width/height, .z = channels, .w = nearest upsampling factor
+    FfxInt32x4 _Source1;       ///< Same as <c><i>_Source0</i></c>, for the channels concatenated after it
+    FfxInt32x4 _Parameters;    ///< Word offsets into the parameter buffer: .x = weights, .y = channel parameters, .z = table or -1, .w = 2:4 sparse weights or -1
+    FfxInt32x4 _Quantization;  ///< .x = input zero point in every byte, .y = output zero point, .z = double rounding
+} NssNetworkLayerConstants;
+
+/// One layer of the compute shader network: a convolution, its rescale and an optional table lookup.
+///
+/// @ingroup ffxNss
+typedef struct NssNetworkLayer
+{
+    NssNetworkLayerConstants constants;
+    uint32_t                 sourceResourceIds[2];  ///< The tensors read by the layer, both are the same for a single source.
+    uint32_t                 outputResourceId;      ///< The tensor written by the layer.
+} NssNetworkLayer;
+
+/// An intermediate tensor of the compute shader network, created as <c><i>FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0</i></c> + index.
+///
+/// @ingroup ffxNss
+typedef struct NssNetworkActivation
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+} NssNetworkActivation;
+
+/// The layers of a quantized data graph, in the order they have to be dispatched.
+///
+/// @ingroup ffxNss
+typedef struct NssNetwork
+{
+    NssNetworkLayer      layers[FFX_NSS_NETWORK_MAX_LAYERS];
+    uint32_t             layerCount;
+    NssNetworkActivation activations[FFX_NSS_NETWORK_MAX_ACTIVATIONS];
+    uint32_t             activationCount;
+} NssNetwork;
+
+/// Translates the TOSA graph of a quantized data graph blob into compute shader layers.
+///
+/// Only the operations used by the NSS models are supported: int8 2D convolutions, each followed
+/// by a per channel rescale and optionally a table lookup, nearest neighbour upscales by an integer
+/// factor and concatenations of two tensors along the channels.
+///
+/// @param [in] dataGraph           The data graph blob to translate.
+/// @param [in] tensorResourceIds   The resource identifier of each tensor of <c><i>dataGraph</i></c>.
+/// @param [in] inputWidth          The width of the graph input.
+/// @param [in] inputHeight         The height of the graph input.
+/// @param [out] network            The layers and intermediate tensors of the network.
+/// @param [out] parameters         The weights, channel parameters and tables the layers read, addressed in words.
+///
+/// @retval
+/// FFX_OK                          The graph was translated successfully.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT      The graph uses an operation or layout the compute shaders don't support.
+///
+/// @ingroup ffxNss
+FfxErrorCode nssParseNetwork(const FfxDataGraphBlob* dataGraph,
+                             const uint32_t*         tensorResourceIds,
+                             uint32_t                inputWidth,
+                             uint32_t                inputHeight,
+                             NssNetwork*             network,
+                             std::vector<uint32_t>&  parameters);
@@ -23,6 +23,11 @@
 
 #pragma once
 #include "FidelityFX/gpu/nss/ffx_nss_resources.h"
+#include "ffx_nss_network.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 /// An enumeration of all the permutations that can be passed to the NSS algorithm.
 ///
@@ -43,6 +48,10 @@ typedef enum NssShaderPermutationOptions : uint32_t
     NSS_SHADER_PERMUTATION_SCALE_PRESET_MODE_X1_3         = (1 << 6),
     NSS_SHADER_PERMUTATION_SCALE_PRESET_MODE_X1_5         = (1 << 7),
     NSS_SHADER_PERMUTATION_SCALE_PRESET_MODE_X2           = (1 << 8),
+    NSS_SHADER_PERMUTATION_PUSH_CONSTANTS                 = (1 << 9),
+    NSS_SHADER_PERMUTATION_FUSED_PADDING                  = (1 << 10),
+    NSS_SHADER_PERMUTATION_WARP_COEFFICIENTS              = (1 << 11),
+    NSS_SHADER_PERMUTATION_TENSORS_AS_BUFFERS             = (1 << 12),
 } NssShaderPermutationOptions;
 
 /// 32bits constants for NSS dispatches.
@@ -53,19 +62,21 @@ typedef enum NssShaderPermutationOptions : uint32_t
 /// @ingroup ffxNss
 typedef struct NssConstants32bitParameters
 {
-    FfxFloat32x4 _QuantParamsSNORM;    ///< Quant parameters between float and snorm. .xy for quantize, .zw for dequantize
-    FfxFloat32x4 _QuantParamsSINT;     ///< Quant parameters between float and sint. .xy for quantize, .zw for dequantize
     FfxFloat32x4 _MotionDisThreshPad;  ///< .x = motion vector thresholds, .y = disocclusion threshold, .z = disocclusion scale
     FfxFloat32x2 _Exposure;            ///< .x = exposure, .y = inverse exposure
     FfxUInt32x2  _IndexModulo;         ///< Euqal to {2, 2}. Hardcode to use 2x2 tile size.
     FfxUInt32x2  _LutOffset;           ///< Jittered offset in 2x2 tile. .x = offset.x, .y = offset.y
     FfxFloat32   _NotHistoryReset;     ///< 1.0 if history is valid, 0.0 if history needs reset
+    FfxUInt32    _ViewIndex;           ///< The batch of the view in the tensors shared by all views
+    FfxUInt32    _ReuseCoefficients;   ///< 1 if the network was skipped and the coefficients are warped, 0 otherwise
 } NssConstants32bitParameters;
 
 /// 16bits constants for NSS dispatches.
 ///
 /// These constants are used when the shader permutation option
-/// "NSS_SHADER_PERMUTATION_ALLOW_16BIT" is enabled.
+/// "NSS_SHADER_PERMUTATION_ALLOW_16BIT" is enabled. With
+/// "NSS_SHADER_PERMUTATION_PUSH_CONSTANTS" they are pushed, together with
+/// the 32bit part of "NssConstants", instead of bound as a constant buffer.
 ///
 /// The definition of member variables is the same as
 /// "NssConstants32bitParameters".
@@ -73,13 +84,13 @@ typedef struct NssConstants32bitParameters
 /// @ingroup ffxNss
 typedef struct NssConstants16bitParameters
 {
-    FfxUInt32x2 _QuantParamsSNORM;
-    FfxUInt32x2 _QuantParamsSINT;
     FfxUInt32x2 _MotionDisThreshPad;
     FfxUInt32   _Exposure;
     FfxUInt32   _IndexModulo;
     FfxUInt32   _LutOffset;
     FfxUInt32   _NotHistoryReset;
+    FfxUInt32   _ViewIndex;
+    FfxUInt32   _ReuseCoefficients;
 } NssConstants16bitParameters;
 
 /// Constants for NSS dispatches.
@@ -99,12 +110,16 @@ typedef struct NssConstants
     FfxFloat32x4 _JitterOffsetTm1;  ///<  Last frame's jitter offset. .xy = pixels, .zw = uvs
     FfxFloat32x4 _ScaleFactor;      ///<  Upscale factor. .xy = scale, .zw = inverse scale
 
-    FfxUInt32x2  _OutputDims;         ///< Upscaled image dimensions (width, height)
-    FfxUInt32x2  _InputDims;          ///< Rendered image dimensions (width, height)
-    FfxFloat32x2 _InvOutputDims;      ///< Inverse upscaled image dimensions (width, height)
-    FfxFloat32x2 _InvInputDims;       ///< Inverse rendered image dimensions (width, height)
-    FfxFloat32x2 _MotionVectorScale;  ///< .x = motion vector scale.x, .y = motion vector scale.y
-    FfxUInt32x2  _UnpaddedInputDims;  ///< Unpadded rendered image dimensions (width, height)
+    FfxUInt32x2  _OutputDims;          ///< Upscaled image dimensions (width, height)
+    FfxUInt32x2  _InputDims;           ///< Rendered image dimensions (width, height)
+    FfxFloat32x2 _InvOutputDims;       ///< Inverse upscaled image dimensions (width, height)
+    FfxFloat32x2 _InvInputDims;        ///< Inverse rendered image dimensions (width, height)
+    FfxFloat32x2 _MotionVectorScale;   ///< .x = motion vector scale.x, .y = motion vector scale.y
+    FfxUInt32x2  _UnpaddedInputDims;   ///< Unpadded rendered image dimensions (width, height)
+    FfxUInt32x2  _UnpaddedOutputDims;  ///< Unpadded upscaled image dimensions (width, height), zero when the output isn't padded
+    FfxInt32x2   _InputOffset;         ///< The input pixel read for the first padded input pixel, non zero for a region of interest
+    FfxInt32x4   _OutputRegion;        ///< .xy = first padded output pixel written to the output, .zw = the output pixel it is written to
+    FfxInt32x4   _FoveaRect;           ///< Output pixels the network writes without blending, .xy = first pixel, .zw = one past the last. Empty unless foveated
 
     union
     {
@@ -113,6 +128,88 @@ typedef struct NssConstants
     } dynamicPrecision;  ///< Union of 16bit and 32bit precision constant parameters
 } NssConstants;
 
+/// Quantization of the int8 graph tensors read and written by the NSS shaders,
+/// real = (q - zero point) * scale.
+///
+/// They come from the model and are passed to the shaders as specialization
+/// constants, in the order of the <c><i>constant_id</i></c> declarations of
+/// ffx_nss_callbacks_glsl.h. Each member is .x = scale, .y = zero point.
+///
+/// @ingroup ffxNss
+typedef struct NssQuantizationConstants
+{
+    FfxFloat32x2 input;     ///< The preprocess output, the input of the network
+    FfxFloat32x2 feedback;  ///< The feedback output of the network
+    FfxFloat32x2 temporal;  ///< The temporal coefficients, K4
+    FfxFloat32x2 k0;
+    FfxFloat32x2 k1;
+    FfxFloat32x2 k2;
+    FfxFloat32x2 k3;
+} NssQuantizationConstants;
+
+/// The number of 32bit specialization constants of the NSS shaders.
+///
+/// @ingroup ffxNss
+static constexpr uint32_t NSS_SPECIALIZATION_CONSTANT_COUNT = sizeof(NssQuantizationConstants) / sizeof(uint32_t);
+
+/// The inputs of NSS read back for a capture.
+///
+/// @ingroup ffxNss
+typedef enum NssCaptureInput : uint32_t
+{
+    NSS_CAPTURE_INPUT_COLOR,
+    NSS_CAPTURE_INPUT_DEPTH,
+    NSS_CAPTURE_INPUT_MOTION_VECTORS,
+    NSS_CAPTURE_INPUT_DEPTH_TM1,
+    NSS_CAPTURE_INPUT_OUTPUT_TM1,
+    NSS_CAPTURE_INPUT_COUNT
+} NssCaptureInput;
+
+/// A captured frame waiting for the GPU to finish writing its readback buffers.
+///
+/// @ingroup ffxNss
+typedef struct NssCaptureSlot
+{
+    FfxNssDispatchDescription dispatchDescription;                          ///< The dispatch parameters, without resource handles.
+    FfxResourceInternal       readbackResources[NSS_CAPTURE_INPUT_COUNT];   ///< Host visible buffers the inputs are copied into.
+    uint32_t                  readbackCapacities[NSS_CAPTURE_INPUT_COUNT];  ///< The sizes <c><i>readbackResources</i></c> were created with.
+    uint32_t                  readbackSizes[NSS_CAPTURE_INPUT_COUNT];       ///< The sizes of the inputs copied for the pending frame, 0 for a null input.
+    uint32_t                  frameIndex;                                   ///< The index of the frame in the capture.
+    bool                      pending;                                      ///< True while a frame is waiting to be delivered.
+} NssCaptureSlot;
+
+/// A resource registered with <c><i>ffxNssContextRegisterResource</i></c>.
+///
+/// @ingroup ffxNss
+typedef struct NssRegisteredResource
+{
+    FfxResource         resource;          ///< The registered resource, a null resource marks a free handle.
+    FfxResourceInternal internalResource;  ///< The slot the backend keeps the resource in, 0 until a dispatch first uses it.
+} NssRegisteredResource;
+
+/// A pipeline built by <c><i>ffxNssContextWarmupPipelines</i></c>, kept until
+/// the context creates the same permutation or is destroyed.
+///
+/// @ingroup ffxNss
+typedef struct NssWarmedPipeline
+{
+    FfxPass          pass;           ///< The pass the pipeline was built for.
+    uint32_t         pipelineFlags;  ///< The permutation options the pipeline was built with.
+    FfxPipelineState pipeline;       ///< The pipeline, null when building it failed.
+} NssWarmedPipeline;
+
+/// The number of internal resources each view keeps its own copy of: its
+/// history, its coefficient warp, and the padded inputs read by its passes.
+///
+/// @ingroup ffxNss
+static constexpr uint32_t NSS_VIEW_RESOURCE_COUNT = 12;
+
+/// The number of intermediates the segments of a model may pass to each
+/// other, before they are aliased onto the intermediate tensors.
+///
+/// @ingroup ffxNss
+static constexpr uint32_t NSS_MAX_SEGMENT_INTERMEDIATES = 32;
+
 struct FfxDeviceCapabilities;
 struct FfxPipelineState;
 
@@ -124,7 +221,7 @@ typedef struct FfxNssContext_Private
 {
     FfxNssContextDescription contextDescription;  ///< The description used to create this context
     FfxUInt32                effectContextId;
-    NssConstants             constants;  ///< The constants used for the current dispatch. Setup and stored in host side.
+    NssConstants             constants[FFX_NSS_MAX_VIEW_COUNT];  ///< The constants used for the current dispatch of each view. Setup and stored in host side.
     FfxDevice                device;
     FfxDeviceCapabilities    deviceCapabilities;
     FfxPipelineState         pipelineNssMirrorPadding;                         ///< The pipeline state for the NSS mirror padding pass.
@@ -132,6 +229,11 @@ typedef struct FfxNssContext_Private
     FfxPipelineState         pipelineNssDataGraph;                             ///< The pipeline state for the NSS data graph pass.
     FfxPipelineState         pipelineNssPostprocess;                           ///< The pipeline state for the NSS postprocess pass.
     FfxPipelineState         pipelineNssDebugView;                             ///< The pipeline state for the NSS debug view pass.
+    FfxPipelineState         pipelineNssBilinearUpscale;                       ///< The pipeline state for the bilinear upscale used until the other pipelines are ready.
+    FfxPipelineState         pipelineNssPeripheryUpscale;                      ///< The pipeline state for the temporal upscale of the periphery of a foveated frame.
+    FfxPipelineState         pipelineNssDataGraphBuilt;                        ///< Data graph pipeline the model creation thread builds from a runtime model.
+    FfxPipelineState         pipelineNssDataGraphPending;                      ///< Data graph pipeline built from a runtime model, swapped in at the next dispatch.
+    FfxPipelineState         pipelineNssDataGraphRetired;                      ///< Previous data graph pipeline, destroyed once in-flight frames no longer use it.
     FfxConstantBuffer        constantBuffers[FFX_NSS_CONSTANTBUFFER_COUNT];    ///< Pointer to constant data in staging ring buffer and data size.
     FfxResourceInternal      srvResources[FFX_NSS_RESOURCE_IDENTIFIER_COUNT];  ///< SRV resource table.
     FfxResourceInternal      uavResources[FFX_NSS_RESOURCE_IDENTIFIER_COUNT];  ///< UAV resource table.
@@ -139,9 +241,59 @@ typedef struct FfxNssContext_Private
 
     bool     firstExecution;
     uint32_t resourceFrameIndex;
+    uint32_t retiredDataGraphFrameCount;  ///< Number of dispatches since <c><i>pipelineNssDataGraphRetired</i></c> was swapped out.
     bool     hasPaddingPass;
+    bool     fusedPadding;  ///< Input padding is applied by mirroring fetches in the passes, see <c><i>FFX_NSS_CONTEXT_FLAG_FUSED_PADDING</i></c>.
+    bool     regionOfInterest;  ///< The padded frame covers a region of the inputs and its halo, see <c><i>FFX_NSS_CONTEXT_FLAG_REGION_OF_INTEREST</i></c>.
+    bool     foveated;          ///< The region of interest follows the gaze, see <c><i>FFX_NSS_CONTEXT_FLAG_FOVEATED</i></c>.
     uint32_t paddedInputWidth;
     uint32_t paddedInputHeight;
     uint32_t paddedOutputWidth;
     uint32_t paddedOutputHeight;
+
+    uint32_t            viewCount;         ///< The number of views dispatched together, stacked in the batch dimension of the tensors.
+    FfxResourceInternal viewResources[FFX_NSS_MAX_VIEW_COUNT][NSS_VIEW_RESOURCE_COUNT];  ///< The internal resources each view has a copy of.
+    uint32_t            viewResourceMask;  ///< The entries of <c><i>viewResources</i></c> which were created.
+    FfxIntCoords2D      foveaOffsets[FFX_NSS_MAX_VIEW_COUNT];  ///< The render pixel of the top left of the fovea of each view, kept until the gaze leaves it.
+
+    uint32_t networkInterval;     ///< The network runs on every <c><i>networkInterval</i></c>th dispatch, see <c><i>FfxNssContextDescription</i></c>.
+    uint32_t framesSinceNetwork;  ///< Number of dispatches since the network last ran.
+    uint32_t networkFrameIndex;   ///< Number of dispatches which ran the network, selects the feedback tensors.
+    bool     reuseCoefficients;   ///< True while the current dispatch warps the coefficients of an earlier network run.
+
+    uint32_t                 pipelinePermutationFlags;  ///< The permutation options used to create the pipelines.
+    NssQuantizationConstants quantization;              ///< The quantization of the model the pipelines are specialized for.
+    std::thread              pipelineCreationThread;    ///< Creates the pipelines when <c><i>FFX_NSS_CONTEXT_FLAG_ASYNC_PIPELINE_CREATION</i></c> is set.
+    std::atomic<bool>        pipelineCreationDone;      ///< Set once <c><i>pipelineCreationResult</i></c> is valid.
+    FfxErrorCode             pipelineCreationResult;    ///< The result of the pipeline creation.
+    bool                     bilinearFallbackActive;    ///< True while dispatches run the bilinear upscale instead of the network.
+    std::thread              modelCreationThread;       ///< Builds <c><i>pipelineNssDataGraphBuilt</i></c> for <c><i>ffxNssContextSetModel</i></c>.
+    std::atomic<bool>        modelCreationDone;         ///< Set once <c><i>modelCreationResult</i></c> is valid.
+    FfxErrorCode             modelCreationResult;       ///< The result of the model's pipeline creation.
+    struct NssDataGraphCopy* modelDataGraph;            ///< The model being built, copied since the application may free it once it was set.
+    bool                     asyncComputeActive;        ///< True while dispatches are submitted to <c><i>FfxNssDispatchDescription::asyncCompute</i></c>.
+
+    NssWarmedPipeline* warmedPipelines;      ///< The pipelines kept by <c><i>ffxNssContextWarmupPipelines</i></c>, allocated by it.
+    uint32_t           warmedPipelineCount;  ///< Number of <c><i>warmedPipelines</i></c>.
+    std::mutex         warmedPipelineMutex;  ///< Guards <c><i>warmedPipelines</i></c>, which the background pipeline creation takes from.
+
+    bool             computeNetwork;      ///< The device can't run tensors and data graphs, the network runs as compute shaders on buffers.
+    NssNetwork       network;             ///< The layers dispatched instead of the data graph.
+    FfxPipelineState pipelineNssNetwork;  ///< The pipeline state every layer of <c><i>network</i></c> is dispatched with, with its own constants.
+
+    const FfxDataGraphSegment* segments;                  ///< The segments of the built-in model when it was exported from several modules.
+    uint32_t                   segmentCount;              ///< Number of <c><i>segments</i></c>, 0 when the built-in model is a single graph.
+    uint32_t                   segmentModelWidth;         ///< The resolution the model was exported for, compute segment workgroup counts scale from it.
+    uint32_t                   segmentModelHeight;        ///< See <c><i>segmentModelWidth</i></c>.
+    FfxPipelineState*          pipelineNssSegments;       ///< The pipeline state of each of <c><i>segments</i></c>, allocated in nssCreate().
+    uint32_t                   segmentIntermediateCount;  ///< Number of intermediates passed between <c><i>segments</i></c>.
+    uint32_t segmentIntermediateIndices[NSS_MAX_SEGMENT_INTERMEDIATES];      ///< The index of each intermediate in the model's resource table.
+    uint32_t segmentIntermediateResourceIds[NSS_MAX_SEGMENT_INTERMEDIATES];  ///< The tensor each intermediate is stored in.
+
+    FfxNssCaptureDescription captureDescription;                   ///< The active capture, <c><i>fpCaptureFrame</i></c> is NULL when not capturing.
+    NssCaptureSlot           captureSlots[FFX_MAX_QUEUED_FRAMES];  ///< Frames in flight, indexed by <c><i>captureDispatchIndex</i></c>.
+    uint32_t                 captureDispatchIndex;                 ///< Number of dispatches since the context was created.
+    uint32_t                 capturedFrameCount;                   ///< Number of frames captured since capturing started.
+
+    NssRegisteredResource registeredResources[FFX_NSS_MAX_REGISTERED_RESOURCES];  ///< Indexed by handle - 1, see <c><i>ffxNssContextRegisterResource</i></c>.
 } FfxNssContext_Private;
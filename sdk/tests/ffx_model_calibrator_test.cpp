@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+// Covers the statistics the model calibrator derives the int8 quantization of a channel from.
+
+#include "ffx_test.h"
+
+#include "ffx_model_calibrator_statistics.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// Gathers the statistics of a single channel holding values
+arm::ChannelStatistics gatherChannel(const std::vector<float>& values, arm::Statistic statistic)
+{
+    const std::vector<arm::ChannelStatistics> channels = arm::gatherStatistics(1, statistic, [&](auto addValue) {
+        for (const float value : values)
+            addValue(0, value);
+    });
+    return channels[0];
+}
+
+// count values spread evenly over [low, high]
+std::vector<float> uniformValues(float low, float high, uint32_t count)
+{
+    std::vector<float> values;
+    for (uint32_t i = 0; i < count; ++i)
+        values.push_back(low + (high - low) * float(i) / float(count - 1));
+    return values;
+}
+
+void testMinMax()
+{
+    const arm::ChannelStatistics channel = gatherChannel({0.5f, -1.0f, 3.0f, 2.0f}, arm::Statistic::MinMax);
+    FFX_TEST_CHECK(channel.histogram.empty());
+
+    const arm::Range range = arm::calibrateChannel(channel, arm::Statistic::MinMax, 0.0, false);
+    FFX_TEST_CHECK(range.low == -1.0f && range.high == 3.0f);
+
+    // Asymmetric quantization covers the range with the 256 values, with zero exactly representable
+    const arm::Quantization asymmetric = arm::asymmetricQuantization(range);
+    FFX_TEST_CHECK(std::fabs(asymmetric.scale - 4.0f / 255.0f) < 1e-7f);
+    FFX_TEST_CHECK(asymmetric.zeroPoint == -64);
+
+    // A positive range is extended to zero, its lowest value is then the zero point
+    const arm::Quantization positive = arm::asymmetricQuantization({0.5f, 2.0f});
+    FFX_TEST_CHECK(positive.zeroPoint == -128 && std::fabs(positive.scale - 2.0f / 255.0f) < 1e-7f);
+
+    // Symmetric quantization, as for the weights, covers the largest magnitude with a zero point of zero
+    const arm::Quantization symmetric = arm::symmetricQuantization({-2.0f, 1.0f});
+    FFX_TEST_CHECK(symmetric.zeroPoint == 0 && std::fabs(symmetric.scale - 2.0f / 127.0f) < 1e-7f);
+
+    // A channel without values keeps its range whatever the statistic
+    const arm::ChannelStatistics empty = gatherChannel({}, arm::Statistic::Mse);
+    const arm::Range             none  = arm::calibrateChannel(empty, arm::Statistic::Mse, 0.0, false);
+    FFX_TEST_CHECK(empty.count == 0 && none.low == INFINITY && none.high == -INFINITY);
+}
+
+void testPercentile()
+{
+    // Uniform over [-1, 1]: the 99% range leaves out half a percent at each end
+    const std::vector<float>     values  = uniformValues(-1.0f, 1.0f, 100001);
+    const arm::ChannelStatistics channel = gatherChannel(values, arm::Statistic::Percentile);
+    FFX_TEST_CHECK(channel.count == values.size());
+
+    const arm::Range range = arm::calibrateChannel(channel, arm::Statistic::Percentile, 99.0, false);
+    FFX_TEST_CHECK(std::fabs(range.low + 0.99f) <= 2.0f * channel.binWidth());
+    FFX_TEST_CHECK(std::fabs(range.high - 0.99f) <= 2.0f * channel.binWidth());
+
+    // Outliers holding less than the percentile leaves out are clipped
+    std::vector<float> outliers = uniformValues(0.0f, 1.0f, 10000);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        outliers.push_back(-1000.0f);
+        outliers.push_back(1000.0f);
+    }
+    const arm::ChannelStatistics clipped      = gatherChannel(outliers, arm::Statistic::Percentile);
+    const arm::Range             clippedRange = arm::calibrateChannel(clipped, arm::Statistic::Percentile, 99.5, false);
+    FFX_TEST_CHECK(clippedRange.low >= -2.0f * clipped.binWidth() && clippedRange.high <= 1.0f + 2.0f * clipped.binWidth());
+}
+
+void testMse()
+{
+    // Values in [-1, 1] with rare outliers at +-50: the range with the smallest error clips the outliers, at about +-14 here
+    std::vector<float> values = uniformValues(-1.0f, 1.0f, 1000001);
+    values.push_back(-50.0f);
+    values.push_back(50.0f);
+    const arm::ChannelStatistics channel = gatherChannel(values, arm::Statistic::Mse);
+
+    const arm::Range range = arm::calibrateChannel(channel, arm::Statistic::Mse, 0.0, true);
+    FFX_TEST_CHECK(range.high < 25.0f && range.low > -25.0f);
+    FFX_TEST_CHECK(range.high >= 1.0f - 1e-3f && range.low <= -1.0f + 1e-3f);
+    const double clippedError = arm::quantizationError(channel, arm::symmetricQuantization(range));
+    const double fullError    = arm::quantizationError(channel, arm::symmetricQuantization({channel.minValue, channel.maxValue}));
+    FFX_TEST_CHECK(clippedError < fullError);
+
+    // Without outliers, clipping only adds error: the range stays close to the full range
+    const arm::ChannelStatistics uniform      = gatherChannel(uniformValues(-1.0f, 3.0f, 20001), arm::Statistic::Mse);
+    const arm::Range             uniformRange = arm::calibrateChannel(uniform, arm::Statistic::Mse, 0.0, false);
+    FFX_TEST_CHECK(uniformRange.low <= -0.95f && uniformRange.high >= 2.85f);
+}
+
+}  // namespace
+
+int main()
+{
+    testMinMax();
+    testPercentile();
+    testMse();
+    return ffxTestResult();
+}
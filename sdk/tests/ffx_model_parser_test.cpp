@@ -0,0 +1,286 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+// Covers the parts of the model parser which don't need the VGF decoder: the .quant and .shapes files read next to the
+// model, the compression of sparse constants, checked against the runtime's expansion, and the shapes read from a shaped graph.
+
+#include "ffx_test.h"
+
+#include "utils.hpp"
+
+#include <FidelityFX/host/ffx_util.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Writes a file to the temporary directory and returns its path
+std::filesystem::path writeFile(const char* name, const char* text)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream               file(path, std::ios::binary);
+    file << text;
+    return path;
+}
+
+template <typename Function>
+bool throws(Function function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+arm::ConstantsInfo makeConstant(const std::vector<uint64_t>& shape, const std::vector<uint8_t>& data, int64_t sparsityDimension = -1)
+{
+    arm::ConstantsInfo constant           = {};
+    constant.tensorInfo.shape             = shape;
+    constant.tensorInfo.format            = VK_FORMAT_R8_SINT;
+    constant.tensorInfo.sparsityDimension = sparsityDimension;
+    constant.constantData.data            = data.data();
+    constant.constantData.size            = data.size();
+    return constant;
+}
+
+// Compresses a constant the way the parser writes it and expands it the way the runtime reads it
+std::vector<uint8_t> roundTrip(const arm::ConstantsInfo& constant)
+{
+    const std::vector<unsigned char> compressed = arm::compressConstant(constant);
+
+    std::vector<int64_t> shape(constant.tensorInfo.shape.begin(), constant.tensorInfo.shape.end());
+    const int64_t*       shapes[]  = {shape.data()};
+    const uint32_t       shapeSize = uint32_t(shape.size());
+    const int64_t        dimension = constant.tensorInfo.sparsityDimension;
+    const uint32_t       dataSize  = uint32_t(constant.constantData.size);
+    const unsigned char* datas[]   = {compressed.data()};
+    const uint32_t       zeroCount = constant.tensorInfo.sparsityZeroCount;
+    const uint32_t       groupSize = constant.tensorInfo.sparsityGroupSize;
+    const uint32_t       id        = 0;
+    const uint32_t       format    = 0;
+
+    const FfxDataGraphBlob blob = {1,
+                                   &id,
+                                   &format,
+                                   &shapeSize,
+                                   shapes,
+                                   &dimension,
+                                   &dataSize,
+                                   datas,
+                                   "main",
+                                   0,
+                                   nullptr,
+                                   0,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   &zeroCount,
+                                   &groupSize,
+                                   0,
+                                   nullptr,
+                                   0,
+                                   nullptr};
+
+    std::vector<uint8_t> expanded(dataSize, 0xcd);
+    if (!ffxDataGraphExpandConstant(blob, 0, expanded.data()))
+        expanded.clear();
+    return expanded;
+}
+
+void testReadQuantization()
+{
+    const std::filesystem::path path = writeFile("ffx_model_parser_test.quant",
+                                                 "# tensor scale zero_point\n"
+                                                 "input 0.0078125 -3\n"
+                                                 "\n"
+                                                 "output 0.25 7\n");
+    const std::map<std::string, arm::QuantizationInfo> quantization = arm::readQuantization(path);
+    FFX_TEST_CHECK(quantization.size() == 2);
+    FFX_TEST_CHECK(quantization.count("input") && quantization.at("input").scale == 0.0078125f && quantization.at("input").zeroPoint == -3);
+    FFX_TEST_CHECK(quantization.count("output") && quantization.at("output").scale == 0.25f && quantization.at("output").zeroPoint == 7);
+
+    // No metadata file means no quantization, malformed lines and scales which aren't positive are errors
+    FFX_TEST_CHECK(arm::readQuantization(std::filesystem::temp_directory_path() / "ffx_model_parser_test_missing.quant").empty());
+    const std::filesystem::path missingZeroPoint = writeFile("ffx_model_parser_test_zero_point.quant", "input 0.5\n");
+    FFX_TEST_CHECK(throws([&] { arm::readQuantization(missingZeroPoint); }));
+    const std::filesystem::path zeroScale = writeFile("ffx_model_parser_test_scale.quant", "input 0 1\n");
+    FFX_TEST_CHECK(throws([&] { arm::readQuantization(zeroScale); }));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(missingZeroPoint);
+    std::filesystem::remove(zeroScale);
+}
+
+void testReadGraphShapes()
+{
+    const std::filesystem::path path = writeFile("ffx_model_parser_test.shapes",
+                                                 "# width height [batch]\n"
+                                                 "960 540\n"
+                                                 "1920 1080 2\n");
+    const std::vector<arm::GraphShape> shapes = arm::readGraphShapes(path);
+    FFX_TEST_REQUIRE(shapes.size() == 2);
+    FFX_TEST_CHECK(shapes[0].width == 960 && shapes[0].height == 540 && shapes[0].batchSize == 1);
+    FFX_TEST_CHECK(shapes[1].width == 1920 && shapes[1].height == 1080 && shapes[1].batchSize == 2);
+
+    FFX_TEST_CHECK(arm::readGraphShapes(std::filesystem::temp_directory_path() / "ffx_model_parser_test_missing.shapes").empty());
+    const std::filesystem::path zeroWidth = writeFile("ffx_model_parser_test_width.shapes", "0 540\n");
+    FFX_TEST_CHECK(throws([&] { arm::readGraphShapes(zeroWidth); }));
+    const std::filesystem::path missingHeight = writeFile("ffx_model_parser_test_height.shapes", "960\n");
+    FFX_TEST_CHECK(throws([&] { arm::readGraphShapes(missingHeight); }));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(zeroWidth);
+    std::filesystem::remove(missingHeight);
+}
+
+void testSparseConstantRoundTrip()
+{
+    // Convolution weights [4, 3, 3, 8] with 2 zeros in every 4 input channels, 3 in some groups
+    std::vector<uint8_t> weights(4 * 3 * 3 * 8);
+    for (size_t i = 0; i < weights.size(); ++i)
+        weights[i] = uint8_t(i % 4 < 2 ? 0 : 1 + i % 251);
+    for (size_t group = 0; group < weights.size() / 4; group += 7)
+        weights[group * 4 + 2] = 0;
+
+    arm::ConstantsInfo constant = makeConstant({4, 3, 3, 8}, weights);
+    arm::detectSparsity(constant);
+    FFX_TEST_CHECK(constant.tensorInfo.sparsityDimension == 3);
+    FFX_TEST_CHECK(constant.tensorInfo.sparsityZeroCount == 2 && constant.tensorInfo.sparsityGroupSize == 4);
+    FFX_TEST_CHECK(arm::compressConstant(constant).size() == weights.size() / 8 + weights.size() / 2);
+    FFX_TEST_CHECK(roundTrip(constant) == weights);
+}
+
+void testSparsityAlongOuterDimension()
+{
+    // int16 elements [2, 8, 3], sparse along the middle dimension only: groups of 4 have 2 zeros, groups of 8 a higher ratio of 6
+    const uint64_t       shape[] = {2, 8, 3};
+    std::vector<uint8_t> data(2 * 8 * 3 * 2, 0);
+    for (uint64_t outer = 0; outer < shape[0]; ++outer)
+    {
+        for (uint64_t inner = 0; inner < shape[2]; ++inner)
+        {
+            for (const uint64_t position : {inner, uint64_t(3)})
+            {
+                const uint64_t element = (outer * shape[1] + position) * shape[2] + inner;
+                data[element * 2]      = uint8_t(element + 1);
+                data[element * 2 + 1]  = 0x80;
+            }
+        }
+    }
+
+    arm::ConstantsInfo constant = makeConstant({2, 8, 3}, data, 1);
+    arm::detectSparsity(constant);
+    FFX_TEST_CHECK(constant.tensorInfo.sparsityDimension == 1);
+    FFX_TEST_CHECK(constant.tensorInfo.sparsityZeroCount == 6 && constant.tensorInfo.sparsityGroupSize == 8);
+    FFX_TEST_CHECK(roundTrip(constant) == data);
+}
+
+void testDenseConstantsStayDense()
+{
+    // A group with a single zero, and a constant with nothing to keep
+    std::vector<uint8_t> weights(2 * 8, 0);
+    for (size_t i = 0; i < weights.size(); ++i)
+        weights[i] = uint8_t(i % 4 < 2 ? 0 : 9);
+    weights[1] = 5;
+
+    arm::ConstantsInfo constant = makeConstant({2, 8}, weights);
+    arm::detectSparsity(constant);
+    FFX_TEST_CHECK(constant.tensorInfo.sparsityZeroCount == 0);
+
+    const std::vector<uint8_t> zeros(2 * 8, 0);
+    arm::ConstantsInfo         zeroConstant = makeConstant({2, 8}, zeros);
+    arm::detectSparsity(zeroConstant);
+    FFX_TEST_CHECK(zeroConstant.tensorInfo.sparsityZeroCount == 0);
+
+    // Biases have a single dimension and are never sparse
+    arm::ConstantsInfo bias = makeConstant({16}, zeros);
+    arm::detectSparsity(bias);
+    FFX_TEST_CHECK(bias.tensorInfo.sparsityZeroCount == 0);
+}
+
+// A shaped module with a tensor at set 0, binding 1 of shape [1, 540, 960, 12], and one at binding 2 whose shape is unknown
+std::vector<uint32_t> shapedModule(bool secondShaped)
+{
+    std::vector<uint32_t> words = {0x07230203, 0x00010600, 0, 100, 0};
+    const auto            op    = [&](uint32_t opcode, std::vector<uint32_t> operands) {
+        words.push_back(uint32_t(operands.size() + 1) << 16 | opcode);
+        words.insert(words.end(), operands.begin(), operands.end());
+    };
+    op(71, {10, 34, 0});  // OpDecorate %10 DescriptorSet 0
+    op(71, {10, 33, 1});  // OpDecorate %10 Binding 1
+    op(71, {11, 34, 0});
+    op(71, {11, 33, 2});
+    op(21, {1, 8, 1});   // %1 = OpTypeInt 8 1
+    op(21, {2, 32, 1});  // %2 = OpTypeInt 32 1
+    op(21, {3, 64, 1});  // %3 = OpTypeInt 64 1
+    op(43, {2, 20, 1});
+    op(43, {2, 21, 540});
+    op(43, {3, 22, 960, 0});  // A 64 bit dimension
+    op(43, {2, 23, 12});
+    op(43, {2, 24, 4});
+    op(28, {4, 3, 24});               // %4 = OpTypeArray %3 4
+    op(44, {4, 30, 20, 21, 22, 23});  // The shape
+    op(4163, {5, 1, 24, 30});         // %5 = OpTypeTensorARM %1 4 %30
+    if (secondShaped)
+        op(4163, {6, 1, 24, 30});
+    else
+        op(4163, {6, 1});
+    op(32, {7, 0, 5});  // %7 = OpTypePointer UniformConstant %5
+    op(32, {8, 0, 6});
+    op(59, {7, 10, 0});  // %10 = OpVariable %7 UniformConstant
+    op(59, {8, 11, 0});
+    return words;
+}
+
+void testGetTensorShapes()
+{
+    std::vector<arm::ResourceInfo> resourceInfos(2);
+    resourceInfos[0].set = 0;
+    resourceInfos[0].id  = 2;
+    resourceInfos[1].set = 0;
+    resourceInfos[1].id  = 1;
+
+    const std::vector<std::vector<int64_t>> shapes = arm::getTensorShapes(shapedModule(true), resourceInfos);
+    FFX_TEST_REQUIRE(shapes.size() == 2);
+    FFX_TEST_CHECK((shapes[0] == std::vector<int64_t>{1, 540, 960, 12}));
+    FFX_TEST_CHECK((shapes[1] == std::vector<int64_t>{1, 540, 960, 12}));
+
+    // A tensor left unshaped, or not bound at all, gives no shapes
+    FFX_TEST_CHECK(arm::getTensorShapes(shapedModule(false), resourceInfos).empty());
+    resourceInfos[0].id = 3;
+    FFX_TEST_CHECK(arm::getTensorShapes(shapedModule(true), resourceInfos).empty());
+
+    // As does a truncated module
+    std::vector<uint32_t> truncated = shapedModule(true);
+    truncated.pop_back();
+    resourceInfos[0].id = 2;
+    FFX_TEST_CHECK(arm::getTensorShapes(truncated, resourceInfos).empty());
+}
+
+}  // namespace
+
+int main()
+{
+    testReadQuantization();
+    testReadGraphShapes();
+    testSparseConstantRoundTrip();
+    testSparsityAlongOuterDimension();
+    testDenseConstantsStayDense();
+    testGetTensorShapes();
+    return ffxTestResult();
+}
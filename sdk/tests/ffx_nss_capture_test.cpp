@@ -0,0 +1,234 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+// Writes captures in the layout ffx_api/ffx_nss.h documents, and files of output images, and reads them back with the reader
+// of the replay tool.
+
+#include "ffx_test.h"
+
+#include "ffx_nss_capture.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// The layout is read and written as raw structs, a change of their size needs a new FFX_API_NSS_CAPTURE_VERSION
+static_assert(sizeof(ffxApiNssCaptureFileHeader) == 36, "The capture file header changed size");
+static_assert(sizeof(ffxApiNssCaptureImage) == 20, "The capture image description changed size");
+static_assert(sizeof(ffxApiNssCaptureFrameHeader) == 164, "The capture frame header changed size");
+
+namespace
+{
+
+ffxApiNssCaptureImage makeImage(uint32_t format, uint32_t width, uint32_t height, uint32_t bytesPerTexel)
+{
+    ffxApiNssCaptureImage image = {};
+    image.format                = format;
+    image.usage                 = FFX_API_RESOURCE_USAGE_READ_ONLY;
+    image.width                 = width;
+    image.height                = height;
+    image.dataSize              = width * height * bytesPerTexel;
+    return image;
+}
+
+std::vector<uint8_t> makeData(const ffxApiNssCaptureImage& image, uint8_t seed)
+{
+    std::vector<uint8_t> data(image.dataSize);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uint8_t(seed + i * 7);
+    return data;
+}
+
+struct TestCapture
+{
+    ffxApiNssCaptureFileHeader                     header;
+    std::vector<ffxApiNssCaptureFrameHeader>       frames;
+    std::vector<std::vector<std::vector<uint8_t>>> data;  // [frame][color, depth, motion vectors, previous depth, previous output]
+};
+
+// Two frames of a 16x8 to 32x16 context, the first without the previous depth and output
+TestCapture makeCapture()
+{
+    TestCapture capture           = {};
+    capture.header.magic          = FFX_API_NSS_CAPTURE_MAGIC;
+    capture.header.version        = FFX_API_NSS_CAPTURE_VERSION;
+    capture.header.frameCount     = 2;
+    capture.header.qualityMode    = 1;
+    capture.header.maxRenderSize  = {16, 8};
+    capture.header.maxUpscaleSize = {32, 16};
+
+    for (uint32_t frameIndex = 0; frameIndex < capture.header.frameCount; ++frameIndex)
+    {
+        const bool                  first = frameIndex == 0;
+        ffxApiNssCaptureFrameHeader frame = {};
+        frame.frameIndex                  = frameIndex;
+        frame.jitterOffset                = {0.25f, -0.25f * float(frameIndex)};
+        frame.motionVectorScale           = {16.0f, 8.0f};
+        frame.renderSize                  = {16, 8};
+        frame.upscaleSize                 = {32, 16};
+        frame.cameraNear                  = 0.1f;
+        frame.cameraFar                   = 1000.0f;
+        frame.exposure                    = 1.0f;
+        frame.frameTimeDelta              = 16.6f;
+        frame.reset                       = first ? 1 : 0;
+        frame.color                       = makeImage(FFX_API_SURFACE_FORMAT_R16G16B16A16_FLOAT, 16, 8, 8);
+        frame.depth                       = makeImage(FFX_API_SURFACE_FORMAT_R32_FLOAT, 16, 8, 4);
+        frame.motionVectors               = makeImage(FFX_API_SURFACE_FORMAT_R16G16_FLOAT, 16, 8, 4);
+        frame.depthTm1                    = first ? ffxApiNssCaptureImage{} : makeImage(FFX_API_SURFACE_FORMAT_R32_FLOAT, 16, 8, 4);
+        frame.outputTm1                   = first ? ffxApiNssCaptureImage{} : makeImage(FFX_API_SURFACE_FORMAT_R16G16B16A16_FLOAT, 32, 16, 8);
+        capture.frames.push_back(frame);
+
+        const uint8_t seed = uint8_t(frameIndex * 50);
+        capture.data.push_back({makeData(frame.color, seed),
+                                makeData(frame.depth, seed + 1),
+                                makeData(frame.motionVectors, seed + 2),
+                                makeData(frame.depthTm1, seed + 3),
+                                makeData(frame.outputTm1, seed + 4)});
+    }
+    return capture;
+}
+
+// Writes the capture as the NSS provider does, leaving out the last truncatedBytes bytes
+std::string writeCapture(const TestCapture& capture, const char* name, size_t truncatedBytes = 0)
+{
+    std::vector<uint8_t> bytes;
+    const auto           append = [&](const void* data, size_t size) {
+        bytes.insert(bytes.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    };
+    append(&capture.header, sizeof(capture.header));
+    for (size_t frame = 0; frame < capture.frames.size(); ++frame)
+    {
+        append(&capture.frames[frame], sizeof(capture.frames[frame]));
+        for (const std::vector<uint8_t>& image : capture.data[frame])
+            append(image.data(), image.size());
+    }
+    bytes.resize(bytes.size() - truncatedBytes);
+
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    FILE*             file = fopen(path.c_str(), "wb");
+    if (file != nullptr)
+    {
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+    }
+    return path;
+}
+
+bool readFails(const std::string& path)
+{
+    try
+    {
+        arm::readCapture(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+void testCaptureRoundTrip()
+{
+    const TestCapture expected = makeCapture();
+    const std::string path     = writeCapture(expected, "ffx_nss_capture_test.nssc");
+
+    const arm::Capture capture = arm::readCapture(path);
+    FFX_TEST_CHECK(capture.header.qualityMode == 1 && capture.header.maxUpscaleSize.width == 32 && capture.header.maxUpscaleSize.height == 16);
+    FFX_TEST_REQUIRE(capture.frames.size() == 2);
+    for (size_t frameIndex = 0; frameIndex < capture.frames.size(); ++frameIndex)
+    {
+        const arm::CapturedFrame&          frame  = capture.frames[frameIndex];
+        const ffxApiNssCaptureFrameHeader& header = expected.frames[frameIndex];
+        FFX_TEST_CHECK(frame.header.frameIndex == frameIndex && frame.header.reset == header.reset);
+        FFX_TEST_CHECK(frame.header.jitterOffset.y == header.jitterOffset.y && frame.header.frameTimeDelta == header.frameTimeDelta);
+
+        const arm::CapturedImage* images[] = {&frame.color, &frame.depth, &frame.motionVectors, &frame.depthTm1, &frame.outputTm1};
+        for (size_t image = 0; image < 5; ++image)
+        {
+            FFX_TEST_CHECK(images[image]->data == expected.data[frameIndex][image]);
+            FFX_TEST_CHECK(images[image]->description.dataSize == uint32_t(expected.data[frameIndex][image].size()));
+        }
+        FFX_TEST_CHECK(frame.color.description.format == FFX_API_SURFACE_FORMAT_R16G16B16A16_FLOAT && frame.color.description.width == 16);
+    }
+    FFX_TEST_CHECK(capture.frames[0].depthTm1.data.empty() && capture.frames[0].outputTm1.data.empty());
+
+    std::remove(path.c_str());
+}
+
+void testInvalidCapturesAreRejected()
+{
+    TestCapture capture = makeCapture();
+
+    // A frame cut short, in its texels or in its header
+    const std::string truncatedData = writeCapture(capture, "ffx_nss_capture_test_data.nssc", 1);
+    FFX_TEST_CHECK(readFails(truncatedData));
+    size_t lastFrameSize = sizeof(ffxApiNssCaptureFrameHeader);
+    for (const std::vector<uint8_t>& image : capture.data[1])
+        lastFrameSize += image.size();
+    const std::string truncatedHeader = writeCapture(capture, "ffx_nss_capture_test_header.nssc", lastFrameSize - 4);
+    FFX_TEST_CHECK(readFails(truncatedHeader));
+
+    capture.header.version    = FFX_API_NSS_CAPTURE_VERSION + 1;
+    const std::string version = writeCapture(capture, "ffx_nss_capture_test_version.nssc");
+    FFX_TEST_CHECK(readFails(version));
+
+    capture.header.version  = FFX_API_NSS_CAPTURE_VERSION;
+    capture.header.magic    = 0x46464952;
+    const std::string magic = writeCapture(capture, "ffx_nss_capture_test_magic.nssc");
+    FFX_TEST_CHECK(readFails(magic));
+
+    FFX_TEST_CHECK(readFails((std::filesystem::temp_directory_path() / "ffx_nss_capture_test_missing.nssc").string()));
+
+    for (const std::string& path : {truncatedData, truncatedHeader, version, magic})
+        std::remove(path.c_str());
+}
+
+// The outputs the replay tool writes with -output=<File>, read back as the CPU reference test does
+void testImageFileRoundTrip()
+{
+    const ffxApiNssCaptureImage images[] = {makeImage(FFX_API_SURFACE_FORMAT_R16G16B16A16_FLOAT, 32, 16, 8),
+                                            makeImage(FFX_API_SURFACE_FORMAT_R8G8B8A8_UNORM, 32, 16, 4)};
+    const std::string           path     = (std::filesystem::temp_directory_path() / "ffx_nss_capture_test_images.bin").string();
+    FILE*                       file     = fopen(path.c_str(), "wb");
+    FFX_TEST_REQUIRE(file != nullptr);
+    for (uint8_t i = 0; i < 2; ++i)
+        FFX_TEST_CHECK(arm::writeImage(file, images[i], makeData(images[i], i).data()));
+    fclose(file);
+
+    const std::vector<arm::CapturedImage> read = arm::readImages(path);
+    FFX_TEST_REQUIRE(read.size() == 2);
+    for (uint8_t i = 0; i < 2; ++i)
+    {
+        FFX_TEST_CHECK(read[i].description.format == images[i].format && read[i].description.dataSize == images[i].dataSize);
+        FFX_TEST_CHECK(read[i].data == makeData(images[i], i));
+    }
+
+    // An image cut short, in its texels or in its description
+    for (const size_t size : {std::filesystem::file_size(path) - 1, sizeof(ffxApiNssCaptureImage) + images[0].dataSize + 4})
+    {
+        std::filesystem::resize_file(path, size);
+        bool failed = false;
+        try
+        {
+            arm::readImages(path);
+        }
+        catch (const std::runtime_error&)
+        {
+            failed = true;
+        }
+        FFX_TEST_CHECK(failed);
+    }
+
+    std::remove(path.c_str());
+}
+
+}  // namespace
+
+int main()
+{
+    testCaptureRoundTrip();
+    testInvalidCapturesAreRejected();
+    testImageFileRoundTrip();
+    return ffxTestResult();
+}
@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+// Runs a capture through NSS on the CPU backend and compares each upscaled frame with the one the Vulkan backend produced,
+// as written by ffx_nss_replay -output=<File>. Takes the capture, the Vulkan outputs and the largest mean absolute error
+// allowed per frame as arguments.
+
+#include "ffx_test.h"
+
+#include "ffx_cpu_nss_kernels.h"
+#include "ffx_nss_capture.h"
+
+#include <FidelityFX/host/backends/cpu/ffx_cpu.h>
+#include <FidelityFX/host/ffx_nss.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+struct Image
+{
+    FfxResourceDescription description;
+    std::vector<uint8_t>   data;
+};
+
+Image createImage(uint32_t format, uint32_t width, uint32_t height, uint32_t usage)
+{
+    Image image                = {};
+    image.description.type     = FFX_RESOURCE_TYPE_TEXTURE2D;
+    image.description.format   = static_cast<FfxSurfaceFormat>(format);
+    image.description.width    = width;
+    image.description.height   = height;
+    image.description.depth    = 1;
+    image.description.mipCount = 1;
+    image.description.usage    = static_cast<FfxResourceUsage>(usage);
+    image.data.resize(size_t(width) * height * cpuGetSurfaceFormatSize(image.description.format));
+    return image;
+}
+
+Image createImage(const ffxApiNssCaptureImage& description)
+{
+    return createImage(description.format, description.width, description.height, description.usage);
+}
+
+// Copies captured texels into an image, when the capture holds them
+void upload(const arm::CapturedImage& captured, Image& image)
+{
+    if (!captured.data.empty())
+    {
+        FFX_TEST_REQUIRE(captured.data.size() == image.data.size());
+        memcpy(image.data.data(), captured.data.data(), image.data.size());
+    }
+}
+
+FfxResource getResource(Image& image, const wchar_t* name, FfxResourceStates state)
+{
+    return ffxGetResourceCPU(image.data.data(), image.description, name, state);
+}
+
+// The context flags of the capture which change the output, mapped from the FfxApiCreateContextNssFlags they were captured as
+uint32_t getContextFlags(uint32_t apiFlags)
+{
+    uint32_t flags = FFX_NSS_CONTEXT_FLAG_QUANTIZED;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE)
+        flags |= FFX_NSS_CONTEXT_FLAG_HIGH_DYNAMIC_RANGE;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_DEPTH_INVERTED)
+        flags |= FFX_NSS_CONTEXT_FLAG_DEPTH_INVERTED;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_DEPTH_INFINITE)
+        flags |= FFX_NSS_CONTEXT_FLAG_DEPTH_INFINITE;
+    if (apiFlags & FFX_API_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC)
+        flags |= FFX_NSS_CONTEXT_FLAG_RESAMPLE_BICUBIC;
+    return flags;
+}
+
+void messageCallback(FfxMsgType type, const wchar_t* message)
+{
+    fprintf(stderr, "%s: %ls\n", type == FFX_MESSAGE_TYPE_ERROR ? "error" : "warning", message);
+}
+
+// Compares the color channels of two frames, their mean absolute error must be at most tolerance
+void compareFrames(uint32_t frameIndex, const Image& output, const arm::CapturedImage& reference, double tolerance)
+{
+    FFX_TEST_REQUIRE(uint32_t(output.description.format) == reference.description.format);
+    FFX_TEST_REQUIRE(output.description.width == reference.description.width && output.description.height == reference.description.height);
+    FFX_TEST_REQUIRE(output.data.size() == reference.data.size());
+
+    const uint32_t texelSize  = cpuGetSurfaceFormatSize(output.description.format);
+    const size_t   texelCount = output.data.size() / texelSize;
+    double         errorSum = 0.0, squaredErrorSum = 0.0, maxError = 0.0;
+    for (size_t i = 0; i < texelCount; ++i)
+    {
+        float cpu[4], vulkan[4];
+        cpuLoadTexel(output.description.format, output.data.data() + i * texelSize, cpu);
+        cpuLoadTexel(output.description.format, reference.data.data() + i * texelSize, vulkan);
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            const double error = std::fabs(double(cpu[channel]) - double(vulkan[channel]));
+            errorSum += error;
+            squaredErrorSum += error * error;
+            maxError = std::max(maxError, error);
+        }
+    }
+
+    const double meanError = errorSum / double(texelCount * 3);
+    const double mse       = squaredErrorSum / double(texelCount * 3);
+    const double psnr      = mse > 0.0 ? 10.0 * std::log10(1.0 / mse) : INFINITY;
+    printf("frame %4u: mean abs error %.6f, max abs error %.6f, psnr %.2f dB\n", frameIndex, meanError, maxError, psnr);
+    FFX_TEST_CHECK(meanError <= tolerance);
+}
+
+void testCaptureMatchesVulkanOutput(const char* capturePath, const char* referencePath, double tolerance)
+{
+    const arm::Capture                    capture    = arm::readCapture(capturePath);
+    const std::vector<arm::CapturedImage> references = arm::readImages(referencePath);
+    FFX_TEST_REQUIRE(!capture.frames.empty() && references.size() == capture.frames.size());
+
+    std::vector<uint8_t> scratch(ffxGetScratchMemorySizeCPU(FFX_NSS_CONTEXT_COUNT));
+    FfxCpuDeviceContext  deviceContext = {};
+
+    FfxNssContextDescription contextDescription = {};
+    contextDescription.qualityMode              = static_cast<FfxNssShaderQualityMode>(capture.header.qualityMode);
+    contextDescription.flags                    = getContextFlags(capture.header.contextFlags);
+    contextDescription.maxRenderSize            = {capture.header.maxRenderSize.width, capture.header.maxRenderSize.height};
+    contextDescription.maxUpscaleSize           = {capture.header.maxUpscaleSize.width, capture.header.maxUpscaleSize.height};
+    contextDescription.displaySize              = contextDescription.maxUpscaleSize;
+    contextDescription.fpMessage                = &messageCallback;
+    FFX_TEST_REQUIRE(ffxGetInterfaceCPU(&contextDescription.backendInterface,
+                                        ffxGetDeviceCPU(&deviceContext),
+                                        scratch.data(),
+                                        scratch.size(),
+                                        FFX_NSS_CONTEXT_COUNT) == FFX_OK);
+
+    std::unique_ptr<FfxNssContext> context(new FfxNssContext());
+    FFX_TEST_REQUIRE(ffxNssContextCreate(context.get(), &contextDescription) == FFX_OK);
+
+    // The images are set up as the replay tool does, the outputs taking the format and size of the Vulkan outputs
+    const arm::CapturedFrame&    first         = capture.frames[0];
+    const ffxApiNssCaptureImage& reference     = references[0].description;
+    Image                        color         = createImage(first.color.description);
+    Image                        motionVectors = createImage(first.motionVectors.description);
+    Image                        depth[2]      = {createImage(first.depth.description), createImage(first.depth.description)};
+    Image                        output[2]     = {createImage(reference), createImage(reference)};
+
+    for (uint32_t frameIndex = 0; frameIndex < capture.frames.size(); ++frameIndex)
+    {
+        const arm::CapturedFrame& frame     = capture.frames[frameIndex];
+        const uint32_t            current   = frameIndex & 1;
+        const uint32_t            previous  = current ^ 1;
+        const bool                debugView = (frame.header.flags & FFX_API_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW) != 0;
+
+        // When the previous depth or output weren't captured, the ones this run produced stand in for them
+        upload(frame.color, color);
+        upload(frame.depth, depth[current]);
+        upload(frame.motionVectors, motionVectors);
+        upload(frame.depthTm1, depth[previous]);
+        upload(frame.outputTm1, output[previous]);
+
+        FfxNssDispatchDescription dispatchDescription = {};
+        dispatchDescription.commandList               = context.get();  // Never dereferenced by the CPU backend
+        dispatchDescription.color                     = getResource(color, L"Color", FFX_RESOURCE_STATE_COMPUTE_READ);
+        dispatchDescription.depth                     = getResource(depth[current], L"Depth", FFX_RESOURCE_STATE_COMPUTE_READ);
+        dispatchDescription.depthTm1                  = getResource(depth[previous], L"DepthTm1", FFX_RESOURCE_STATE_COMPUTE_READ);
+        dispatchDescription.motionVectors             = getResource(motionVectors, L"MotionVectors", FFX_RESOURCE_STATE_COMPUTE_READ);
+        dispatchDescription.outputTm1                 = getResource(output[previous], L"OutputTm1", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        dispatchDescription.output                    = getResource(output[current], L"Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        dispatchDescription.jitterOffset              = {frame.header.jitterOffset.x, frame.header.jitterOffset.y};
+        dispatchDescription.upscaleSize               = {frame.header.upscaleSize.width, frame.header.upscaleSize.height};
+        dispatchDescription.renderSize                = {frame.header.renderSize.width, frame.header.renderSize.height};
+        dispatchDescription.cameraNear                = frame.header.cameraNear;
+        dispatchDescription.cameraFar                 = frame.header.cameraFar;
+        dispatchDescription.cameraFovAngleVertical    = frame.header.cameraFovAngleVertical;
+        dispatchDescription.exposure                  = frame.header.exposure;
+        dispatchDescription.motionVectorScale         = {frame.header.motionVectorScale.x, frame.header.motionVectorScale.y};
+        dispatchDescription.frameTimeDelta            = frame.header.frameTimeDelta;
+        dispatchDescription.reset                     = frame.header.reset != 0 || frameIndex == 0;
+        dispatchDescription.flags                     = debugView ? FFX_NSS_DISPATCH_FLAG_DRAW_DEBUG_VIEW : 0;
+        FFX_TEST_CHECK(ffxNssContextDispatch(context.get(), &dispatchDescription) == FFX_OK);
+
+        compareFrames(frame.header.frameIndex, output[current], references[frameIndex], tolerance);
+    }
+
+    FFX_TEST_CHECK(ffxNssContextDestroy(context.get()) == FFX_OK);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        fprintf(stderr, "Usage: %s <CaptureFile> <VulkanOutputFile> <MaxMeanAbsError>\n", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        testCaptureMatchesVulkanOutput(argv[1], argv[2], strtod(argv[3], nullptr));
+    }
+    catch (const std::exception& e)
+    {
+        ffxTestFail(__FILE__, __LINE__, e.what());
+    }
+    return ffxTestResult();
+}
@@ -0,0 +1,735 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+// Translates a quantized TOSA graph with nssParseNetwork(), runs its layers with the CPU kernels of the compute shader
+// network and compares the result bit for bit with a direct evaluation of the TOSA operations.
+
+#include "ffx_test.h"
+
+#include <FidelityFX/host/ffx_nss.h>
+#include "nss/ffx_nss_network.h"
+#include "ffx_cpu_nss_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// SPIR-V opcodes and TOSA.001000.1 instructions the graph is built from
+const uint32_t SPV_OP_EXT_INST_IMPORT                  = 11;
+const uint32_t SPV_OP_EXT_INST                         = 12;
+const uint32_t SPV_OP_TYPE_BOOL                        = 20;
+const uint32_t SPV_OP_TYPE_INT                         = 21;
+const uint32_t SPV_OP_TYPE_ARRAY                       = 28;
+const uint32_t SPV_OP_TYPE_POINTER                     = 32;
+const uint32_t SPV_OP_CONSTANT_TRUE                    = 41;
+const uint32_t SPV_OP_CONSTANT_FALSE                   = 42;
+const uint32_t SPV_OP_CONSTANT                         = 43;
+const uint32_t SPV_OP_CONSTANT_COMPOSITE               = 44;
+const uint32_t SPV_OP_CONSTANT_NULL                    = 46;
+const uint32_t SPV_OP_VARIABLE                         = 59;
+const uint32_t SPV_OP_DECORATE                         = 71;
+const uint32_t SPV_OP_TYPE_TENSOR_ARM                  = 4163;
+const uint32_t SPV_OP_GRAPH_CONSTANT_ARM               = 4181;
+const uint32_t SPV_OP_GRAPH_ENTRY_POINT_ARM            = 4182;
+const uint32_t SPV_OP_GRAPH_ARM                        = 4183;
+const uint32_t SPV_OP_GRAPH_INPUT_ARM                  = 4184;
+const uint32_t SPV_OP_GRAPH_SET_OUTPUT_ARM             = 4185;
+const uint32_t SPV_OP_GRAPH_END_ARM                    = 4186;
+const uint32_t SPV_OP_TYPE_GRAPH_ARM                   = 4190;
+const uint32_t SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT = 4461;
+
+const uint32_t SPV_DECORATION_BINDING        = 33;
+const uint32_t SPV_DECORATION_DESCRIPTOR_SET = 34;
+const uint32_t SPV_STORAGE_CLASS_UNIFORM     = 0;
+
+const uint32_t TOSA_AVG_POOL2D = 1;
+const uint32_t TOSA_CONV2D     = 2;
+const uint32_t TOSA_TABLE      = 30;
+const uint32_t TOSA_CONCAT     = 54;
+const uint32_t TOSA_RESIZE     = 63;
+const uint32_t TOSA_RESCALE    = 65;
+
+const int32_t TOSA_ROUNDING_MODE_SINGLE = 1;
+const int32_t TOSA_ROUNDING_MODE_DOUBLE = 3;
+
+const uint32_t INPUT_WIDTH     = 8;
+const uint32_t INPUT_HEIGHT    = 8;
+const uint32_t INPUT_RESOURCE  = 100;
+const uint32_t OUTPUT_RESOURCE = 101;
+const uint32_t FIRST_CONSTANT  = 10;
+
+// Writes the words of a SPIR-V module, with ids allocated in order
+class SpirvWriter
+{
+public:
+    uint32_t newId()
+    {
+        return m_nextId++;
+    }
+
+    void op(uint32_t opcode, const std::vector<uint32_t>& operands)
+    {
+        m_words.push_back(uint32_t(operands.size() + 1) << 16 | opcode);
+        m_words.insert(m_words.end(), operands.begin(), operands.end());
+    }
+
+    // The literal string operand of an instruction, nul terminated and padded to a word
+    static std::vector<uint32_t> string(const char* text)
+    {
+        std::vector<uint32_t> words(strlen(text) / 4 + 1, 0);
+        memcpy(words.data(), text, strlen(text));
+        return words;
+    }
+
+    uint32_t typeInt(uint32_t width)
+    {
+        const uint32_t id = newId();
+        op(SPV_OP_TYPE_INT, {id, width, 1});
+        return id;
+    }
+
+    uint32_t constant(uint32_t type, int32_t value)
+    {
+        const auto key = std::make_pair(type, value);
+        if (m_constants.count(key) == 0)
+        {
+            m_constants[key] = newId();
+            op(SPV_OP_CONSTANT, {type, m_constants[key], uint32_t(value)});
+        }
+        return m_constants[key];
+    }
+
+    uint32_t composite(uint32_t type, const std::vector<uint32_t>& elements)
+    {
+        const uint32_t        id       = newId();
+        std::vector<uint32_t> operands = {type, id};
+        operands.insert(operands.end(), elements.begin(), elements.end());
+        op(SPV_OP_CONSTANT_COMPOSITE, operands);
+        return id;
+    }
+
+    // A tensor type, of any shape when shape is 0
+    uint32_t typeTensor(uint32_t elementType, uint32_t rank, uint32_t shape)
+    {
+        const uint32_t id = newId();
+        if (shape != 0)
+            op(SPV_OP_TYPE_TENSOR_ARM, {id, elementType, rank, shape});
+        else
+            op(SPV_OP_TYPE_TENSOR_ARM, {id, elementType});
+        return id;
+    }
+
+    uint32_t tosa(uint32_t type, uint32_t instructionSet, uint32_t instruction, const std::vector<uint32_t>& arguments)
+    {
+        const uint32_t        id       = newId();
+        std::vector<uint32_t> operands = {type, id, instructionSet, instruction};
+        operands.insert(operands.end(), arguments.begin(), arguments.end());
+        op(SPV_OP_EXT_INST, operands);
+        return id;
+    }
+
+    std::vector<uint32_t> words() const
+    {
+        std::vector<uint32_t> module = {0x07230203, 0x00010600, 0, m_nextId, 0};
+        module.insert(module.end(), m_words.begin(), m_words.end());
+        return module;
+    }
+
+private:
+    uint32_t                                         m_nextId = 1;
+    std::vector<uint32_t>                            m_words;
+    std::map<std::pair<uint32_t, int32_t>, uint32_t> m_constants;
+};
+
+// An int8 or int32 NHWC tensor of a single batch
+struct Tensor
+{
+    int32_t              width    = 0;
+    int32_t              height   = 0;
+    int32_t              channels = 0;
+    std::vector<int32_t> values;
+
+    Tensor(int32_t w, int32_t h, int32_t c)
+        : width(w)
+        , height(h)
+        , channels(c)
+        , values(size_t(w) * h * c, 0)
+    {
+    }
+
+    int32_t& at(int32_t x, int32_t y, int32_t c)
+    {
+        return values[(size_t(y) * width + x) * channels + c];
+    }
+
+    int32_t at(int32_t x, int32_t y, int32_t c) const
+    {
+        return values[(size_t(y) * width + x) * channels + c];
+    }
+};
+
+struct Convolution
+{
+    std::vector<int8_t>  weights;  // [output channel, kernel height, kernel width, input channel]
+    std::vector<int32_t> bias;
+    int32_t              outputChannels;
+    int32_t              kernelHeight;
+    int32_t              kernelWidth;
+    int32_t              inputChannels;
+    int32_t              pad[4];       // top, bottom, left, right
+    int32_t              stride[2];    // y, x
+    int32_t              dilation[2];  // y, x
+    int32_t              inputZeroPoint;
+};
+
+struct Rescale
+{
+    std::vector<int32_t> multipliers;  // One per channel, or a single one for the tensor
+    std::vector<int32_t> shifts;
+    bool                 doubleRound;
+    int32_t              outputZeroPoint;
+};
+
+uint32_t g_random = 12345;
+
+int32_t randomInt(int32_t low, int32_t high)
+{
+    g_random = g_random * 1664525u + 1013904223u;
+    return low + int32_t((g_random >> 8) % uint32_t(high - low + 1));
+}
+
+Convolution makeConvolution(int32_t outputChannels, int32_t kernelSize, int32_t inputChannels, int32_t inputZeroPoint)
+{
+    Convolution convolution = {};
+    convolution.outputChannels = outputChannels;
+    convolution.kernelHeight   = kernelSize;
+    convolution.kernelWidth    = kernelSize;
+    convolution.inputChannels  = inputChannels;
+    convolution.stride[0] = convolution.stride[1] = 1;
+    convolution.dilation[0] = convolution.dilation[1] = 1;
+    convolution.inputZeroPoint = inputZeroPoint;
+    convolution.weights.resize(size_t(outputChannels) * kernelSize * kernelSize * inputChannels);
+    for (int8_t& weight : convolution.weights)
+        weight = int8_t(randomInt(-24, 24));
+    for (int32_t outputChannel = 0; outputChannel < outputChannels; ++outputChannel)
+        convolution.bias.push_back(randomInt(-2000, 2000));
+    return convolution;
+}
+
+Rescale makeRescale(size_t channelCount, int32_t shift, bool doubleRound, int32_t outputZeroPoint)
+{
+    Rescale rescale = {};
+    for (size_t channel = 0; channel < channelCount; ++channel)
+    {
+        rescale.multipliers.push_back((1 << 30) + randomInt(0, 1 << 29));
+        rescale.shifts.push_back(shift + randomInt(0, 1));
+    }
+    rescale.doubleRound     = doubleRound;
+    rescale.outputZeroPoint = outputZeroPoint;
+    return rescale;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TOSA reference, evaluated as the specification describes the operations
+
+Tensor referenceConv2d(const Tensor& input, const Convolution& c)
+{
+    Tensor output((input.width - 1 + c.pad[2] + c.pad[3] - (c.kernelWidth - 1) * c.dilation[1]) / c.stride[1] + 1,
+                  (input.height - 1 + c.pad[0] + c.pad[1] - (c.kernelHeight - 1) * c.dilation[0]) / c.stride[0] + 1,
+                  c.outputChannels);
+    for (int32_t y = 0; y < output.height; ++y)
+        for (int32_t x = 0; x < output.width; ++x)
+            for (int32_t oc = 0; oc < c.outputChannels; ++oc)
+            {
+                int32_t acc = c.bias[oc];
+                for (int32_t ky = 0; ky < c.kernelHeight; ++ky)
+                    for (int32_t kx = 0; kx < c.kernelWidth; ++kx)
+                    {
+                        const int32_t iy = y * c.stride[0] - c.pad[0] + ky * c.dilation[0];
+                        const int32_t ix = x * c.stride[1] - c.pad[2] + kx * c.dilation[1];
+                        if (iy < 0 || iy >= input.height || ix < 0 || ix >= input.width)
+                            continue;
+                        for (int32_t ic = 0; ic < c.inputChannels; ++ic)
+                        {
+                            const int32_t weight = c.weights[((size_t(oc) * c.kernelHeight + ky) * c.kernelWidth + kx) * c.inputChannels + ic];
+                            acc += (input.at(ix, iy, ic) - c.inputZeroPoint) * weight;
+                        }
+                    }
+                output.at(x, y, oc) = acc;
+            }
+    return output;
+}
+
+Tensor referenceRescale(const Tensor& input, const Rescale& r)
+{
+    Tensor output = input;
+    for (size_t i = 0; i < input.values.size(); ++i)
+    {
+        const size_t  scaleIndex = r.multipliers.size() == 1 ? 0 : i % size_t(input.channels);
+        const int32_t shift      = r.shifts[scaleIndex];
+        int64_t       round      = int64_t(1) << (shift - 1);
+        if (r.doubleRound && shift > 31)
+            round += input.values[i] >= 0 ? (int64_t(1) << 30) : -(int64_t(1) << 30);
+        const int64_t scaled = (int64_t(input.values[i]) * r.multipliers[scaleIndex] + round) >> shift;
+        output.values[i]     = int32_t(std::min<int64_t>(std::max<int64_t>(scaled + r.outputZeroPoint, -128), 127));
+    }
+    return output;
+}
+
+Tensor referenceTable(const Tensor& input, const std::vector<int32_t>& table)
+{
+    Tensor output = input;
+    for (int32_t& value : output.values)
+        value = table[value + 128];
+    return output;
+}
+
+// RESIZE in NEAREST_NEIGHBOR mode, scale = {y numerator, y denominator, x numerator, x denominator}
+Tensor referenceResize(const Tensor& input, const int32_t scale[4], const int32_t offset[2], const int32_t border[2])
+{
+    const auto nearest = [](int32_t output, int32_t numerator, int32_t denominator, int32_t offset, int32_t size) {
+        const int32_t position = output * denominator + offset;
+        const int32_t index    = (position >= 0) ? position / numerator : -((numerator - 1 - position) / numerator);
+        const int32_t delta    = position - index * numerator;
+        return std::min(std::max((2 * delta >= numerator) ? index + 1 : index, 0), size - 1);
+    };
+
+    Tensor output(((input.width - 1) * scale[2] - offset[1] + border[1]) / scale[3] + 1,
+                  ((input.height - 1) * scale[0] - offset[0] + border[0]) / scale[1] + 1,
+                  input.channels);
+    for (int32_t y = 0; y < output.height; ++y)
+        for (int32_t x = 0; x < output.width; ++x)
+            for (int32_t c = 0; c < output.channels; ++c)
+                output.at(x, y, c) =
+                    input.at(nearest(x, scale[2], scale[3], offset[1], input.width), nearest(y, scale[0], scale[1], offset[0], input.height), c);
+    return output;
+}
+
+Tensor referenceConcat(const Tensor& first, const Tensor& second)
+{
+    Tensor output(first.width, first.height, first.channels + second.channels);
+    for (int32_t y = 0; y < output.height; ++y)
+        for (int32_t x = 0; x < output.width; ++x)
+            for (int32_t c = 0; c < output.channels; ++c)
+                output.at(x, y, c) = c < first.channels ? first.at(x, y, c) : second.at(x, y, c - first.channels);
+    return output;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// The graph: conv2d (2:4 sparse weights) + rescale + table, a strided conv2d + rescale upscaled by a resize,
+// concatenated with the first layer and reduced to the output by a dilated conv2d + rescale
+
+struct TestGraph
+{
+    Convolution          convolutions[3];
+    Rescale              rescales[3];
+    std::vector<int32_t> table;
+    int32_t              resizeScale[4]  = {4, 2, 4, 2};  // An upscale by 2, sampling output o from input o / 2
+    int32_t              resizeOffset[2] = {-1, -1};
+    int32_t              resizeBorder[2] = {1, 1};
+
+    // Blob data
+    std::vector<uint32_t>             spirv;
+    std::vector<uint32_t>             constantIds;
+    std::vector<uint32_t>             constantFormats;
+    std::vector<uint32_t>             constantShapeSizes;
+    std::vector<std::vector<int64_t>> constantShapeData;
+    std::vector<const int64_t*>       constantShapes;
+    std::vector<int64_t>              sparsityDimensions;
+    std::vector<uint32_t>             sparsityZeroCounts;
+    std::vector<uint32_t>             sparsityGroupSizes;
+    std::vector<uint32_t>             constantDataSizes;
+    std::vector<std::vector<uint8_t>> constantData;
+    std::vector<const unsigned char*> constantDatas;
+};
+
+// Stores weights as ffxDataGraphExpandConstant() reads them: a mask of the 2 weights kept of each 4 input channels, then the kept weights.
+// Groups with 3 zeros keep their first zero, as the model parser fills them in.
+std::vector<uint8_t> compress2x4(const std::vector<int8_t>& weights)
+{
+    std::vector<uint8_t> mask((weights.size() + 7) / 8, 0);
+    std::vector<uint8_t> kept;
+    for (size_t group = 0; group < weights.size() / 4; ++group)
+    {
+        const int8_t* groupWeights = &weights[group * 4];
+        bool          keep[4]      = {};
+        uint32_t      keptCount    = 0;
+        for (uint32_t position = 0; position < 4 && keptCount < 2; ++position)
+        {
+            if (groupWeights[position] != 0)
+                keep[position] = ++keptCount != 0;
+        }
+        for (uint32_t position = 0; position < 4 && keptCount < 2; ++position)
+        {
+            if (!keep[position])
+                keep[position] = ++keptCount != 0;
+        }
+
+        for (uint32_t position = 0; position < 4; ++position)
+        {
+            if (!keep[position])
+                continue;
+            mask[(group * 4 + position) / 8] |= uint8_t(1u << ((group * 4 + position) % 8));
+            kept.push_back(uint8_t(groupWeights[position]));
+        }
+    }
+    mask.insert(mask.end(), kept.begin(), kept.end());
+    return mask;
+}
+
+void addConstant(TestGraph& graph, const std::vector<int64_t>& shape, const void* data, uint32_t dataSize)
+{
+    graph.constantIds.push_back(FIRST_CONSTANT + uint32_t(graph.constantIds.size()));
+    graph.constantFormats.push_back(0);
+    graph.constantShapeSizes.push_back(uint32_t(shape.size()));
+    graph.constantShapeData.push_back(shape);
+    graph.sparsityDimensions.push_back(-1);
+    graph.sparsityZeroCounts.push_back(0);
+    graph.sparsityGroupSizes.push_back(0);
+    graph.constantDataSizes.push_back(dataSize);
+    graph.constantData.emplace_back(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + dataSize);
+}
+
+// Builds the graph, with unsupported replacing the final rescale by another instruction when it's not 0
+TestGraph buildGraph(uint32_t unsupported = 0)
+{
+    g_random = 12345;
+
+    TestGraph graph;
+    graph.convolutions[0] = makeConvolution(8, 3, 4, -3);
+    graph.convolutions[0].pad[0] = graph.convolutions[0].pad[1] = graph.convolutions[0].pad[2] = graph.convolutions[0].pad[3] = 1;
+    std::vector<int8_t>& sparseWeights = graph.convolutions[0].weights;
+    for (size_t group = 0; group < sparseWeights.size() / 4; ++group)
+    {
+        // 2 zeros in every 4 input channels, 3 in some groups
+        const int32_t first = randomInt(0, 3);
+        const int32_t zeros = (group % 5 == 0) ? 3 : 2;
+        for (int32_t zero = 0; zero < zeros; ++zero)
+            sparseWeights[group * 4 + (first + zero) % 4] = 0;
+    }
+    graph.rescales[0] = makeRescale(8, 36, true, 5);
+
+    graph.convolutions[1] = makeConvolution(4, 3, 8, 0);
+    graph.convolutions[1].stride[0] = graph.convolutions[1].stride[1] = 2;
+    graph.convolutions[1].pad[0] = graph.convolutions[1].pad[2] = 1;
+    graph.convolutions[1].bias.assign(4, 0);
+    graph.rescales[1] = makeRescale(1, 37, false, -2);
+
+    graph.convolutions[2] = makeConvolution(4, 3, 12, 7);
+    graph.convolutions[2].dilation[0] = graph.convolutions[2].dilation[1] = 2;
+    graph.convolutions[2].pad[0] = graph.convolutions[2].pad[1] = graph.convolutions[2].pad[2] = graph.convolutions[2].pad[3] = 2;
+    graph.convolutions[2].bias.assign(4, 300);
+    graph.rescales[2] = makeRescale(4, 38, true, 0);
+
+    for (int32_t entry = 0; entry < 256; ++entry)
+        graph.table.push_back(randomInt(-128, 127));
+
+    // Graph constants: the sparse weights and the bias of the first convolution, the dense weights of the others
+    const Convolution& c0 = graph.convolutions[0];
+    const Convolution& c1 = graph.convolutions[1];
+    const Convolution& c2 = graph.convolutions[2];
+    addConstant(graph, {c0.outputChannels, c0.kernelHeight, c0.kernelWidth, c0.inputChannels}, c0.weights.data(), uint32_t(c0.weights.size()));
+    addConstant(graph, {c0.outputChannels}, c0.bias.data(), uint32_t(c0.bias.size() * sizeof(int32_t)));
+    addConstant(graph, {c1.outputChannels, c1.kernelHeight, c1.kernelWidth, c1.inputChannels}, c1.weights.data(), uint32_t(c1.weights.size()));
+    addConstant(graph, {c2.outputChannels, c2.kernelHeight, c2.kernelWidth, c2.inputChannels}, c2.weights.data(), uint32_t(c2.weights.size()));
+    graph.constantData[0]       = compress2x4(c0.weights);
+    graph.sparsityDimensions[0] = 3;
+    graph.sparsityZeroCounts[0] = 2;
+    graph.sparsityGroupSizes[0] = 4;
+    for (size_t i = 0; i < graph.constantIds.size(); ++i)
+    {
+        graph.constantShapes.push_back(graph.constantShapeData[i].data());
+        graph.constantDatas.push_back(graph.constantData[i].data());
+    }
+
+    SpirvWriter                 spirv;
+    const uint32_t              tosaSet        = spirv.newId();
+    std::vector<uint32_t>       importOperands = {tosaSet};
+    const std::vector<uint32_t> tosaName       = SpirvWriter::string("TOSA.001000.1");
+    importOperands.insert(importOperands.end(), tosaName.begin(), tosaName.end());
+    spirv.op(SPV_OP_EXT_INST_IMPORT, importOperands);
+
+    const uint32_t              graphId    = spirv.newId();
+    const uint32_t              inputVar   = spirv.newId();
+    const uint32_t              outputVar  = spirv.newId();
+    std::vector<uint32_t>       entryPoint = {graphId};
+    const std::vector<uint32_t> entryName  = SpirvWriter::string("main");
+    entryPoint.insert(entryPoint.end(), entryName.begin(), entryName.end());
+    entryPoint.insert(entryPoint.end(), {inputVar, outputVar});
+    spirv.op(SPV_OP_GRAPH_ENTRY_POINT_ARM, entryPoint);
+    spirv.op(SPV_OP_DECORATE, {inputVar, SPV_DECORATION_DESCRIPTOR_SET, 0});
+    spirv.op(SPV_OP_DECORATE, {inputVar, SPV_DECORATION_BINDING, 0});
+    spirv.op(SPV_OP_DECORATE, {outputVar, SPV_DECORATION_DESCRIPTOR_SET, 0});
+    spirv.op(SPV_OP_DECORATE, {outputVar, SPV_DECORATION_BINDING, 1});
+
+    const uint32_t i8      = spirv.typeInt(8);
+    const uint32_t i32     = spirv.typeInt(32);
+    const uint32_t boolean = spirv.newId();
+    spirv.op(SPV_OP_TYPE_BOOL, {boolean});
+    const uint32_t trueId  = spirv.newId();
+    const uint32_t falseId = spirv.newId();
+    spirv.op(SPV_OP_CONSTANT_TRUE, {boolean, trueId});
+    spirv.op(SPV_OP_CONSTANT_FALSE, {boolean, falseId});
+
+    const auto c32   = [&](int32_t value) { return spirv.constant(i32, value); };
+    const auto array = [&](const std::vector<int32_t>& values) {
+        const uint32_t type = spirv.newId();
+        spirv.op(SPV_OP_TYPE_ARRAY, {type, i32, c32(int32_t(values.size()))});
+        std::vector<uint32_t> elements;
+        for (const int32_t value : values)
+            elements.push_back(c32(value));
+        return spirv.composite(type, elements);
+    };
+
+    const uint32_t shape4    = array({1, int32_t(INPUT_HEIGHT), int32_t(INPUT_WIDTH), 4});
+    const uint32_t ioTensor  = spirv.typeTensor(i8, c32(4), shape4);
+    const uint32_t i8Tensor  = spirv.typeTensor(i8, 0, 0);
+    const uint32_t i32Tensor = spirv.typeTensor(i32, 0, 0);
+    const uint32_t pointer   = spirv.newId();
+    spirv.op(SPV_OP_TYPE_POINTER, {pointer, SPV_STORAGE_CLASS_UNIFORM, ioTensor});
+    spirv.op(SPV_OP_VARIABLE, {pointer, inputVar, SPV_STORAGE_CLASS_UNIFORM});
+    spirv.op(SPV_OP_VARIABLE, {pointer, outputVar, SPV_STORAGE_CLASS_UNIFORM});
+
+    // Weights and the first bias are graph constants, the other biases a null and a replicated constant of 4 channels
+    const uint32_t vector4Shape = array({4});
+    const uint32_t bias4Tensor  = spirv.typeTensor(i32, c32(1), vector4Shape);
+    uint32_t       constants[4];
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        constants[i] = spirv.newId();
+        spirv.op(SPV_OP_GRAPH_CONSTANT_ARM, {i == 1 ? i32Tensor : i8Tensor, constants[i], graph.constantIds[i]});
+    }
+    const uint32_t nullBias = spirv.newId();
+    spirv.op(SPV_OP_CONSTANT_NULL, {bias4Tensor, nullBias});
+    const uint32_t replicatedBias = spirv.newId();
+    spirv.op(SPV_OP_CONSTANT_COMPOSITE_REPLICATE_EXT, {bias4Tensor, replicatedBias, c32(300)});
+
+    std::vector<uint32_t> tableValues;
+    for (const int32_t entry : graph.table)
+        tableValues.push_back(spirv.constant(i8, entry));
+    const uint32_t tableType = spirv.typeTensor(i8, c32(1), array({256}));
+    const uint32_t table     = spirv.composite(tableType, tableValues);
+
+    const uint32_t graphType = spirv.newId();
+    spirv.op(SPV_OP_TYPE_GRAPH_ARM, {graphType, 1, ioTensor, ioTensor});
+    spirv.op(SPV_OP_GRAPH_ARM, {graphType, graphId});
+    const uint32_t input = spirv.newId();
+    spirv.op(SPV_OP_GRAPH_INPUT_ARM, {ioTensor, input, c32(0)});
+
+    const auto conv2d = [&](uint32_t source, const Convolution& c, uint32_t weights, uint32_t bias) {
+        return spirv.tosa(i32Tensor,
+                          tosaSet,
+                          TOSA_CONV2D,
+                          {array({c.pad[0], c.pad[1], c.pad[2], c.pad[3]}),
+                           array({c.stride[0], c.stride[1]}),
+                           array({c.dilation[0], c.dilation[1]}),
+                           c32(1),
+                           falseId,
+                           source,
+                           weights,
+                           bias,
+                           spirv.constant(i8, c.inputZeroPoint),
+                           spirv.constant(i8, 0)});
+    };
+    const auto rescale = [&](uint32_t source, const Rescale& r, uint32_t instruction) {
+        const uint32_t multipliers = r.multipliers.size() == 1 ? c32(r.multipliers[0]) : array(r.multipliers);
+        const uint32_t shifts      = r.shifts.size() == 1 ? spirv.constant(i8, r.shifts[0]) : array(r.shifts);
+        return spirv.tosa(i8Tensor,
+                          tosaSet,
+                          instruction,
+                          {trueId,
+                           c32(r.doubleRound ? TOSA_ROUNDING_MODE_DOUBLE : TOSA_ROUNDING_MODE_SINGLE),
+                           r.multipliers.size() == 1 ? falseId : trueId,
+                           falseId,
+                           falseId,
+                           source,
+                           multipliers,
+                           shifts,
+                           spirv.constant(i32, 0),
+                           spirv.constant(i8, r.outputZeroPoint)});
+    };
+
+    const uint32_t layer0  = rescale(conv2d(input, graph.convolutions[0], constants[0], constants[1]), graph.rescales[0], TOSA_RESCALE);
+    const uint32_t tabled  = spirv.tosa(i8Tensor, tosaSet, TOSA_TABLE, {layer0, table});
+    const uint32_t layer1  = rescale(conv2d(tabled, graph.convolutions[1], constants[2], nullBias), graph.rescales[1], TOSA_RESCALE);
+    const int32_t* scale   = graph.resizeScale;
+    const uint32_t resized = spirv.tosa(i8Tensor,
+                                        tosaSet,
+                                        TOSA_RESIZE,
+                                        {c32(1),
+                                         layer1,
+                                         array({scale[0], scale[1], scale[2], scale[3]}),
+                                         array({graph.resizeOffset[0], graph.resizeOffset[1]}),
+                                         array({graph.resizeBorder[0], graph.resizeBorder[1]})});
+    const uint32_t concat  = spirv.tosa(i8Tensor, tosaSet, TOSA_CONCAT, {c32(3), resized, tabled});
+    const uint32_t last    = unsupported ? unsupported : TOSA_RESCALE;
+    const uint32_t output  = rescale(conv2d(concat, graph.convolutions[2], constants[3], replicatedBias), graph.rescales[2], last);
+    spirv.op(SPV_OP_GRAPH_SET_OUTPUT_ARM, {output, c32(0)});
+    spirv.op(SPV_OP_GRAPH_END_ARM, {});
+
+    graph.spirv = spirv.words();
+    return graph;
+}
+
+FfxErrorCode parseGraph(const TestGraph& graph, NssNetwork& network, std::vector<uint32_t>& parameters)
+{
+    static const uint32_t  tensorSets[]     = {0, 0};
+    static const uint32_t  tensorBindings[] = {0, 1};
+    static const uint32_t  tensorFormats[]  = {0, 0};
+    static const uint32_t  tensorDimSizes[] = {4, 4};
+    static const uint64_t  tensorShape[]    = {1, INPUT_HEIGHT, INPUT_WIDTH, 4};
+    static const uint64_t* tensorDims[]     = {tensorShape, tensorShape};
+    static const uint32_t  resourceIds[]    = {INPUT_RESOURCE, OUTPUT_RESOURCE};
+
+    const FfxDataGraphBlob blob = {uint32_t(graph.constantIds.size()),
+                                   graph.constantIds.data(),
+                                   graph.constantFormats.data(),
+                                   graph.constantShapeSizes.data(),
+                                   const_cast<const int64_t**>(graph.constantShapes.data()),
+                                   graph.sparsityDimensions.data(),
+                                   graph.constantDataSizes.data(),
+                                   const_cast<const unsigned char**>(graph.constantDatas.data()),
+                                   "main",
+                                   uint32_t(graph.spirv.size() * sizeof(uint32_t)),
+                                   reinterpret_cast<const unsigned char*>(graph.spirv.data()),
+                                   2,
+                                   nullptr,
+                                   tensorSets,
+                                   tensorBindings,
+                                   tensorFormats,
+                                   tensorDimSizes,
+                                   tensorDims,
+                                   nullptr,
+                                   nullptr,
+                                   graph.sparsityZeroCounts.data(),
+                                   graph.sparsityGroupSizes.data(),
+                                   0,
+                                   nullptr,
+                                   0,
+                                   nullptr};
+    return nssParseNetwork(&blob, resourceIds, INPUT_WIDTH, INPUT_HEIGHT, &network, parameters);
+}
+
+// Runs the layers of the network like the compute shader fallback dispatches them, every tensor being an int8 storage buffer
+std::vector<int8_t> runNetwork(const NssNetwork& network, std::vector<uint32_t>& parameters, const std::vector<int8_t>& input)
+{
+    std::map<uint32_t, std::vector<uint8_t>> buffers;
+    buffers[INPUT_RESOURCE].assign(input.begin(), input.end());
+    buffers[OUTPUT_RESOURCE].resize(INPUT_WIDTH * INPUT_HEIGHT * 4);
+    for (uint32_t i = 0; i < network.activationCount; ++i)
+    {
+        const NssNetworkActivation& activation = network.activations[i];
+        buffers[FFX_NSS_RESOURCE_IDENTIFIER_NETWORK_ACTIVATION_0 + i].resize(size_t(activation.width) * activation.height * activation.channels);
+    }
+
+    const auto bind = [](uint8_t* data, size_t size) {
+        CpuBinding binding         = {};
+        binding.data               = data;
+        binding.description.type   = FFX_RESOURCE_TYPE_BUFFER;
+        binding.description.format = FFX_SURFACE_FORMAT_R32_UINT;
+        binding.description.size   = uint32_t(size);
+        return binding;
+    };
+
+    for (uint32_t i = 0; i < network.layerCount; ++i)
+    {
+        const NssNetworkLayer& layer    = network.layers[i];
+        CpuPassBindings        bindings = {};
+        for (uint32_t source = 0; source < 2; ++source)
+        {
+            std::vector<uint8_t>& buffer = buffers.at(layer.sourceResourceIds[source]);
+            bindings.slots[source]       = bind(buffer.data(), buffer.size());
+        }
+        bindings.slots[2]  = bind(reinterpret_cast<uint8_t*>(parameters.data()), parameters.size() * sizeof(uint32_t));
+        bindings.slots[3]  = bind(buffers.at(layer.outputResourceId).data(), buffers.at(layer.outputResourceId).size());
+        bindings.constants = reinterpret_cast<const uint32_t*>(&layer.constants);
+        cpuRunNssPassRows(FFX_NSS_PASS_NETWORK, bindings, 0, cpuGetNssPassRowCount(FFX_NSS_PASS_NETWORK, bindings));
+    }
+
+    const std::vector<uint8_t>& output = buffers[OUTPUT_RESOURCE];
+    return std::vector<int8_t>(output.begin(), output.end());
+}
+
+void testTranslatedNetworkMatchesTosa()
+{
+    const TestGraph graph = buildGraph();
+
+    NssNetwork            network = {};
+    std::vector<uint32_t> parameters;
+    FFX_TEST_REQUIRE(parseGraph(graph, network, parameters) == FFX_OK);
+
+    // The first layer fuses its table, the resize and concatenation are read by the last layer
+    FFX_TEST_CHECK(network.layerCount == 3);
+    FFX_TEST_CHECK(network.activationCount == 2);
+    FFX_TEST_CHECK(network.layers[0].constants._Parameters[2] >= 0 && network.layers[0].constants._Parameters[3] >= 0);
+    FFX_TEST_CHECK(network.layers[1].constants._OutputShape[0] == 4 && network.layers[1].constants._OutputShape[1] == 4);
+    FFX_TEST_CHECK(network.layers[2].constants._Source0[3] == 2 && network.layers[2].constants._Source1[3] == 1);
+    FFX_TEST_CHECK(network.layers[2].outputResourceId == OUTPUT_RESOURCE);
+
+    Tensor              input(INPUT_WIDTH, INPUT_HEIGHT, 4);
+    std::vector<int8_t> inputData;
+    for (int32_t& value : input.values)
+    {
+        value = randomInt(-128, 127);
+        inputData.push_back(int8_t(value));
+    }
+
+    const Tensor layer0   = referenceTable(referenceRescale(referenceConv2d(input, graph.convolutions[0]), graph.rescales[0]), graph.table);
+    const Tensor layer1   = referenceRescale(referenceConv2d(layer0, graph.convolutions[1]), graph.rescales[1]);
+    const Tensor concat   = referenceConcat(referenceResize(layer1, graph.resizeScale, graph.resizeOffset, graph.resizeBorder), layer0);
+    const Tensor expected = referenceRescale(referenceConv2d(concat, graph.convolutions[2]), graph.rescales[2]);
+    FFX_TEST_REQUIRE(expected.width == int32_t(INPUT_WIDTH) && expected.height == int32_t(INPUT_HEIGHT) && expected.channels == 4);
+
+    const std::vector<int8_t> output     = runNetwork(network, parameters, inputData);
+    size_t                    mismatches = 0;
+    for (size_t i = 0; i < output.size(); ++i)
+        mismatches += output[i] != expected.values[i] ? 1 : 0;
+    FFX_TEST_CHECK(mismatches == 0);
+
+    // The output isn't trivially constant, every value of the reference would otherwise match by chance
+    FFX_TEST_CHECK(std::count(expected.values.begin(), expected.values.end(), expected.values[0]) < int64_t(expected.values.size()) / 2);
+}
+
+void testUnsupportedOperationIsRejected()
+{
+    const TestGraph       graph   = buildGraph(TOSA_AVG_POOL2D);
+    NssNetwork            network = {};
+    std::vector<uint32_t> parameters;
+    FFX_TEST_CHECK(parseGraph(graph, network, parameters) == FfxErrorCode(FFX_ERROR_INVALID_ARGUMENT));
+}
+
+void testWeightZeroPointIsRejected()
+{
+    TestGraph graph = buildGraph();
+
+    // The weight zero point is the last operand of the first convolution, zero is the only value the layers support
+    std::vector<uint32_t>& words = graph.spirv;
+    for (size_t position = 5; position < words.size(); position += words[position] >> 16)
+    {
+        if ((words[position] & 0xffff) == SPV_OP_EXT_INST && words[position + 4] == TOSA_CONV2D)
+        {
+            const uint32_t wordCount = words[position] >> 16;
+            words[position + wordCount - 1] = words[position + wordCount - 2];
+            break;
+        }
+    }
+
+    NssNetwork            network = {};
+    std::vector<uint32_t> parameters;
+    FFX_TEST_CHECK(parseGraph(graph, network, parameters) == FfxErrorCode(FFX_ERROR_INVALID_ARGUMENT));
+}
+
+}  // namespace
+
+int main()
+{
+    testTranslatedNetworkMatchesTosa();
+    testUnsupportedOperationIsRejected();
+    testWeightZeroPointIsRejected();
+    return ffxTestResult();
+}
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Checks shared by the SDK tests. Each test is an executable whose main() runs its cases and returns ffxTestResult(),
+// so ctest reports it as failed when any check failed.
+
+#include <cstdio>
+
+inline int& ffxTestFailureCount()
+{
+    static int failureCount = 0;
+    return failureCount;
+}
+
+inline void ffxTestFail(const char* file, int line, const char* expression)
+{
+    fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+    ++ffxTestFailureCount();
+}
+
+/// Prints the outcome of the test and returns its exit code.
+inline int ffxTestResult()
+{
+    if (ffxTestFailureCount() != 0)
+    {
+        fprintf(stderr, "%d checks failed\n", ffxTestFailureCount());
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+/// Records a failure when <c><i>condition</i></c> is false, and carries on with the test.
+#define FFX_TEST_CHECK(condition)                         \
+    do                                                    \
+    {                                                     \
+        if (!(condition))                                 \
+            ffxTestFail(__FILE__, __LINE__, #condition);  \
+    } while (0)
+
+/// Records a failure and returns from the current case when <c><i>condition</i></c> is false.
+#define FFX_TEST_REQUIRE(condition)                       \
+    do                                                    \
+    {                                                     \
+        if (!(condition))                                 \
+        {                                                 \
+            ffxTestFail(__FILE__, __LINE__, #condition);  \
+            return;                                       \
+        }                                                 \
+    } while (0)
@@ -0,0 +1,386 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+// Calibrates the int8 quantization of an NSS model from tensors captured while running its float version.
+// Writes the quantization metadata ffx_model_parser reads next to the int8 model, see readQuantization().
+
+#include "decoder.h"
+#include "ffx_model_calibrator_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace arm
+{
+    static const char* const APP_NAME    = "Arm_Model_Calibrator";
+    static const char* const APP_VERSION = "1.0.0";
+
+    // The Vulkan formats of the float constants, as recorded in the VGF
+    static const mlsdk_vk_format VK_FORMAT_R16_SFLOAT = 76;
+    static const mlsdk_vk_format VK_FORMAT_R32_SFLOAT = 100;
+
+    struct LaunchParameters
+    {
+        std::string modelFile;
+        std::string captureDirectory;
+        std::string outputFile;
+        std::string channelsFile;
+        Statistic   statistic  = Statistic::MinMax;
+        double      percentile = 99.99;
+    };
+
+    /// \brief An input or output tensor of the graph, named like ffx_model_parser names it
+    struct ModelTensor
+    {
+        std::string name;
+        uint32_t    channels;
+    };
+
+    /// \brief A float constant of the graph, the weights or biases of a layer
+    struct ModelConstant
+    {
+        std::string          name;
+        std::vector<int64_t> shape;
+        std::vector<float>   values;
+    };
+
+    static std::vector<uint8_t> readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file " + path.generic_string());
+        }
+        std::vector<uint8_t> data(size_t(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()));
+        return data;
+    }
+
+    static float halfToFloat(uint16_t value)
+    {
+        const uint32_t sign     = uint32_t(value & 0x8000) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1f;
+        const uint32_t mantissa = value & 0x3ff;
+
+        float magnitude;
+        if (exponent == 0)
+            magnitude = std::ldexp(float(mantissa), -24);
+        else if (exponent == 31)
+            magnitude = mantissa ? NAN : INFINITY;
+        else
+            magnitude = std::ldexp(float(mantissa | 0x400), int32_t(exponent) - 25);
+        return sign ? -magnitude : magnitude;
+    }
+
+    // The input and output tensors and the float constants of the graph module of the model.
+    static void readModel(const std::vector<uint8_t>& model, std::vector<ModelTensor>& tensors, std::vector<ModelConstant>& constants)
+    {
+        std::vector<uint8_t>          headerDecoderMemory(mlsdk_decoder_header_decoder_mem_reqs());
+        mlsdk_decoder_header_decoder* headerDecoder = mlsdk_decoder_create_header_decoder(model.data(), headerDecoderMemory.data());
+        if (!mlsdk_decoder_is_header_valid(headerDecoder) || !mlsdk_decoder_is_header_compatible(headerDecoder))
+        {
+            throw std::runtime_error("Invalid or incompatible vgf header");
+        }
+
+        mlsdk_decoder_vgf_section_info sequenceSection, resourceSection, constantSection;
+        mlsdk_decoder_get_header_section_info(headerDecoder, mlsdk_decoder_section_model_sequence, &sequenceSection);
+        mlsdk_decoder_get_header_section_info(headerDecoder, mlsdk_decoder_section_resources, &resourceSection);
+        mlsdk_decoder_get_header_section_info(headerDecoder, mlsdk_decoder_section_constants, &constantSection);
+
+        std::vector<uint8_t>                  sequenceDecoderMemory(mlsdk_decoder_model_sequence_decoder_mem_reqs());
+        mlsdk_decoder_model_sequence_decoder* sequenceDecoder =
+            mlsdk_decoder_create_model_sequence_decoder(model.data() + sequenceSection.offset, sequenceDecoderMemory.data());
+
+        std::vector<uint8_t>                        resourceDecoderMemory(mlsdk_decoder_model_resource_table_decoder_mem_reqs());
+        mlsdk_decoder_model_resource_table_decoder* resourceDecoder =
+            mlsdk_decoder_create_model_resource_table_decoder(model.data() + resourceSection.offset, resourceDecoderMemory.data());
+
+        std::vector<uint8_t>                  constantDecoderMemory(mlsdk_decoder_constant_table_decoder_mem_reqs());
+        mlsdk_decoder_constant_table_decoder* constantDecoder =
+            mlsdk_decoder_create_constant_table_decoder(model.data() + constantSection.offset, constantDecoderMemory.data());
+
+        // The interface tensors of the graph segment
+        for (size_t segment = 0; segment < mlsdk_decoder_get_model_sequence_table_size(sequenceDecoder); ++segment)
+        {
+            if (mlsdk_decoder_model_sequence_get_segment_type(sequenceDecoder, uint32_t(segment)) != mlsdk_decoder_module_type_graph)
+                continue;
+
+            const size_t setCount = mlsdk_decoder_model_sequence_get_segment_descriptorset_info_size(sequenceDecoder, uint32_t(segment));
+            for (uint32_t set = 0; set < setCount; ++set)
+            {
+                auto handle = mlsdk_decoder_model_sequence_get_segment_descriptor_binding_slot(sequenceDecoder, uint32_t(segment), set);
+                for (uint32_t slot = 0; slot < mlsdk_decoder_binding_slot_size(sequenceDecoder, handle); ++slot)
+                {
+                    const uint32_t bindingId = mlsdk_decoder_binding_slot_binding_id(sequenceDecoder, handle, slot);
+                    const uint32_t mrtIndex  = mlsdk_decoder_binding_slot_mrt_index(sequenceDecoder, handle, slot);
+
+                    const mlsdk_decoder_mrt_category category = mlsdk_decoder_model_resource_table_get_category(resourceDecoder, mrtIndex);
+                    if (category != mlsdk_decoder_mrt_category_input && category != mlsdk_decoder_mrt_category_output)
+                        continue;
+
+                    mlsdk_decoder_tensor_dimensions dims;
+                    mlsdk_decoder_model_resource_table_get_tensor_shape(resourceDecoder, mrtIndex, &dims);
+                    if (dims.size != 4)
+                    {
+                        throw std::runtime_error("Graph tensors are expected to be NHWC");
+                    }
+
+                    const std::string suffix = (category == mlsdk_decoder_mrt_category_input) ? "_input" : "_output";
+                    tensors.push_back({"Resource_" + std::to_string(bindingId) + suffix, uint32_t(dims.data[3])});
+                }
+            }
+        }
+
+        // The float constants, the first dimension of the weights is the output channel
+        for (uint32_t constantIndex = 0; constantIndex < mlsdk_decoder_get_constant_table_num_entries(constantDecoder); ++constantIndex)
+        {
+            const uint32_t        mrtIndex = mlsdk_decoder_constant_table_get_mrt_index(constantDecoder, constantIndex);
+            const mlsdk_vk_format format   = mlsdk_decoder_get_vk_format(resourceDecoder, mrtIndex);
+            if (format != VK_FORMAT_R16_SFLOAT && format != VK_FORMAT_R32_SFLOAT)
+                continue;
+
+            mlsdk_decoder_constant_data data;
+            mlsdk_decoder_constant_table_get_data(constantDecoder, constantIndex, &data);
+            mlsdk_decoder_tensor_dimensions dims;
+            mlsdk_decoder_model_resource_table_get_tensor_shape(resourceDecoder, mrtIndex, &dims);
+
+            ModelConstant constant;
+            constant.name  = "Constant_" + std::to_string(constantIndex);
+            constant.shape = std::vector<int64_t>(dims.data, dims.data + dims.size);
+            if (format == VK_FORMAT_R32_SFLOAT)
+            {
+                constant.values.resize(data.size / sizeof(float));
+                memcpy(constant.values.data(), data.data, constant.values.size() * sizeof(float));
+            }
+            else
+            {
+                constant.values.resize(data.size / sizeof(uint16_t));
+                for (size_t i = 0; i < constant.values.size(); ++i)
+                {
+                    uint16_t value;
+                    memcpy(&value, data.data + i * sizeof(uint16_t), sizeof(uint16_t));
+                    constant.values[i] = halfToFloat(value);
+                }
+            }
+            constants.push_back(std::move(constant));
+        }
+    }
+
+    // The captures of a tensor are the files <tensor name>*.bin, raw float32 NHWC values.
+    static std::vector<std::filesystem::path> findCaptures(const std::string& directory, const std::string& tensorName)
+    {
+        std::vector<std::filesystem::path> captures;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            const std::string fileName = entry.path().filename().generic_string();
+            if (entry.is_regular_file() && entry.path().extension() == ".bin" && fileName.compare(0, tensorName.size(), tensorName) == 0)
+            {
+                // Resource_1_output must not pick up Resource_10_output
+                const char next = fileName[tensorName.size()];
+                if (next == '.' || next == '_' || next == '-')
+                    captures.push_back(entry.path());
+            }
+        }
+        std::sort(captures.begin(), captures.end());
+        return captures;
+    }
+
+    // Visits every value of every capture of a tensor with its channel.
+    template <typename Visitor>
+    static void visitCaptures(const std::vector<std::filesystem::path>& captures, uint32_t channels, Visitor visit)
+    {
+        for (const auto& capture : captures)
+        {
+            const std::vector<uint8_t> data = readFile(capture);
+            if (data.size() % (channels * sizeof(float)) != 0)
+            {
+                throw std::runtime_error("Capture " + capture.generic_string() + " is not a whole number of " + std::to_string(channels) + " channel pixels");
+            }
+
+            const size_t valueCount = data.size() / sizeof(float);
+            for (size_t i = 0; i < valueCount; ++i)
+            {
+                float value;
+                memcpy(&value, data.data() + i * sizeof(float), sizeof(float));
+                if (std::isfinite(value))
+                    visit(uint32_t(i % channels), value);
+            }
+        }
+    }
+
+    static void calibrate(const LaunchParameters& params)
+    {
+        std::vector<ModelTensor>   tensors;
+        std::vector<ModelConstant> constants;
+        const std::vector<uint8_t> model = readFile(params.modelFile);
+        readModel(model, tensors, constants);
+
+        FILE* output = fopen(params.outputFile.c_str(), "wb");
+        if (output == nullptr)
+        {
+            throw std::runtime_error("Could not open file " + params.outputFile);
+        }
+        FILE* channelsOutput = nullptr;
+        if (!params.channelsFile.empty())
+        {
+            channelsOutput = fopen(params.channelsFile.c_str(), "wb");
+            if (channelsOutput == nullptr)
+            {
+                fclose(output);
+                throw std::runtime_error("Could not open file " + params.channelsFile);
+            }
+            fprintf(channelsOutput, "# Per channel int8 quantization of %s: <name>[<channel>] <scale> <zero point>\n", params.modelFile.c_str());
+        }
+
+        fprintf(output, "# Quantization of the int8 tensors of %s, calibrated by %s %s.\n", params.modelFile.c_str(), APP_NAME, APP_VERSION);
+        fprintf(output, "# <tensor name> <scale> <zero point>, real = (q - zero point) * scale\n");
+
+        // Activations: asymmetric, one quantization per tensor as NSS quantizes them, over the calibrated range of all channels
+        for (const ModelTensor& tensor : tensors)
+        {
+            const std::vector<std::filesystem::path> captures = findCaptures(params.captureDirectory, tensor.name);
+            if (captures.empty())
+            {
+                printf("%s: no captures, the tensor keeps the quantization of the built-in model\n", tensor.name.c_str());
+                continue;
+            }
+
+            const std::vector<ChannelStatistics> channels =
+                gatherStatistics(tensor.channels, params.statistic, [&](auto addValue) { visitCaptures(captures, tensor.channels, addValue); });
+
+            Range tensorRange = {INFINITY, -INFINITY};
+            for (uint32_t channel = 0; channel < tensor.channels; ++channel)
+            {
+                const Range range = calibrateChannel(channels[channel], params.statistic, params.percentile, false);
+                tensorRange.low   = std::min(tensorRange.low, range.low);
+                tensorRange.high  = std::max(tensorRange.high, range.high);
+
+                if (channelsOutput)
+                {
+                    const Quantization quantization = asymmetricQuantization(range);
+                    fprintf(channelsOutput, "%s[%u] %.9g %d\n", tensor.name.c_str(), channel, quantization.scale, quantization.zeroPoint);
+                }
+            }
+
+            const Quantization quantization = asymmetricQuantization(tensorRange);
+            fprintf(output, "%s %.9g %d\n", tensor.name.c_str(), quantization.scale, quantization.zeroPoint);
+            printf("%s: %zu captures, range [%g, %g], scale %g, zero point %d\n",
+                   tensor.name.c_str(),
+                   captures.size(),
+                   tensorRange.low,
+                   tensorRange.high,
+                   quantization.scale,
+                   quantization.zeroPoint);
+        }
+
+        // Weights: symmetric, one quantization per output channel
+        if (channelsOutput)
+        {
+            for (const ModelConstant& constant : constants)
+            {
+                const uint32_t outputChannels = constant.shape.empty() ? 1 : uint32_t(std::max<int64_t>(constant.shape[0], 1));
+                const size_t   channelSize    = constant.values.size() / outputChannels;
+
+                const std::vector<ChannelStatistics> channels = gatherStatistics(outputChannels, params.statistic, [&](auto addValue) {
+                    for (size_t i = 0; i < constant.values.size(); ++i)
+                        addValue(uint32_t(std::min<size_t>(i / channelSize, outputChannels - 1)), constant.values[i]);
+                });
+
+                for (uint32_t channel = 0; channel < outputChannels; ++channel)
+                {
+                    const Quantization quantization = symmetricQuantization(calibrateChannel(channels[channel], params.statistic, params.percentile, true));
+                    fprintf(channelsOutput, "%s[%u] %.9g %d\n", constant.name.c_str(), channel, quantization.scale, quantization.zeroPoint);
+                }
+            }
+            fclose(channelsOutput);
+        }
+
+        fclose(output);
+    }
+
+    static void printCommandLineSyntax()
+    {
+        printf("%s %s\n", APP_NAME, APP_VERSION);
+        printf("Command line syntax:\n");
+        printf("  %s [Options] -captures=<Directory> <FloatModel>\n", APP_NAME);
+        printf(
+            "Options:\n"
+            "-captures=<Directory>\n"
+            "  Directory of the tensors captured with the float model, <tensor name>*.bin files of float32 NHWC values.\n"
+            "-method=<minmax|percentile|mse>\n"
+            "  Statistic the range of each channel is calibrated with. Defaults to minmax.\n"
+            "-percentile=<Value>\n"
+            "  Percentage of the values the percentile method keeps in range. Defaults to 99.99.\n"
+            "-output=<Path>\n"
+            "  Quantization metadata read by ffx_model_parser. Defaults to <FloatModel>.quant.\n"
+            "-channels=<Path>\n"
+            "  Also writes the per channel quantization of the tensors and weights, for the exporter.\n"
+            "Notes:\n"
+            "  The model is not requantized. The int8 VGF must be exported again from the float model with these\n"
+            "  parameters, and the .quant file passed to ffx_model_parser with that VGF; using it with a VGF\n"
+            "  quantized differently gives wrong results.\n");
+    }
+
+    static bool parseCommandLine(int argCount, const char* const* args, LaunchParameters& params)
+    {
+        for (int i = 0; i < argCount; ++i)
+        {
+            if (strncmp(args[i], "-captures=", 10) == 0)
+                params.captureDirectory = args[i] + 10;
+            else if (strcmp(args[i], "-method=minmax") == 0)
+                params.statistic = Statistic::MinMax;
+            else if (strcmp(args[i], "-method=percentile") == 0)
+                params.statistic = Statistic::Percentile;
+            else if (strcmp(args[i], "-method=mse") == 0)
+                params.statistic = Statistic::Mse;
+            else if (strncmp(args[i], "-percentile=", 12) == 0)
+                params.percentile = strtod(args[i] + 12, nullptr);
+            else if (strncmp(args[i], "-output=", 8) == 0)
+                params.outputFile = args[i] + 8;
+            else if (strncmp(args[i], "-channels=", 10) == 0)
+                params.channelsFile = args[i] + 10;
+            else if (args[i][0] == '-')
+                return false;
+            else
+                params.modelFile = args[i];
+        }
+
+        if (params.outputFile.empty())
+            params.outputFile = std::filesystem::path(params.modelFile).replace_extension(".quant").generic_string();
+
+        return !params.modelFile.empty() && !params.captureDirectory.empty() && params.percentile > 0.0 && params.percentile <= 100.0;
+    }
+
+}  // namespace arm
+
+int main(int argc, char** argv)
+{
+    arm::LaunchParameters params;
+    if (!arm::parseCommandLine(argc - 1, argv + 1, params))
+    {
+        arm::printCommandLineSyntax();
+        return 1;
+    }
+
+    try
+    {
+        arm::calibrate(params);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
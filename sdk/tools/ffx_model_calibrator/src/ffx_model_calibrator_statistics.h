@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+// The statistics the calibrator derives the int8 quantization of a channel from, over a histogram of its values.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace arm
+{
+    // Bins of the histogram each channel is calibrated on
+    static const uint32_t HISTOGRAM_BINS = 2048;
+
+    // Clipping ranges tried by the MSE search, as fractions of the full range
+    static const uint32_t MSE_CANDIDATES = 128;
+
+    enum class Statistic
+    {
+        MinMax,      ///< The full range of the values
+        Percentile,  ///< The range holding all but the outer (100 - percentile)% of the values
+        Mse,         ///< The clipping range with the smallest quantization and clipping error
+    };
+
+    /// \brief The values of one channel, gathered over all captured frames
+    struct ChannelStatistics
+    {
+        float                 minValue = INFINITY;
+        float                 maxValue = -INFINITY;
+        std::vector<uint64_t> histogram;
+        uint64_t              count = 0;
+
+        void addRange(float value)
+        {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+
+        float binWidth() const
+        {
+            return std::max(maxValue - minValue, 1e-12f) / float(HISTOGRAM_BINS);
+        }
+
+        void addToHistogram(float value)
+        {
+            if (histogram.empty())
+                histogram.resize(HISTOGRAM_BINS, 0);
+            const uint32_t bin = std::min(uint32_t((value - minValue) / binWidth()), HISTOGRAM_BINS - 1);
+            histogram[bin]++;
+            count++;
+        }
+
+        float binCenter(uint32_t bin) const
+        {
+            return minValue + (float(bin) + 0.5f) * binWidth();
+        }
+    };
+
+    /// \brief An int8 quantization, real = (q - zeroPoint) * scale
+    struct Quantization
+    {
+        float   scale;
+        int32_t zeroPoint;
+    };
+
+    struct Range
+    {
+        float low;
+        float high;
+    };
+
+    inline Quantization asymmetricQuantization(Range range)
+    {
+        // Zero must be exact, the padding of the convolutions is zero
+        range.low  = std::min(range.low, 0.0f);
+        range.high = std::max(range.high, 0.0f);
+
+        const float   scale     = std::max(range.high - range.low, 1e-8f) / 255.0f;
+        const int32_t zeroPoint = std::min(std::max(int32_t(std::lrint(-128.0f - range.low / scale)), -128), 127);
+        return {scale, zeroPoint};
+    }
+
+    inline Quantization symmetricQuantization(Range range)
+    {
+        const float magnitude = std::max(std::fabs(range.low), std::fabs(range.high));
+        return {std::max(magnitude, 1e-8f) / 127.0f, 0};
+    }
+
+    // The squared error of quantizing the values of the histogram, clipping included.
+    inline double quantizationError(const ChannelStatistics& channel, const Quantization& quantization)
+    {
+        double error = 0.0;
+        for (uint32_t bin = 0; bin < HISTOGRAM_BINS; ++bin)
+        {
+            if (channel.histogram[bin] == 0)
+                continue;
+
+            const float   value     = channel.binCenter(bin);
+            const int32_t quantized = std::min(std::max(int32_t(std::lrint(value / quantization.scale)) + quantization.zeroPoint, -128), 127);
+            const double  delta     = double(value) - double(quantized - quantization.zeroPoint) * quantization.scale;
+            error += delta * delta * double(channel.histogram[bin]);
+        }
+        return error;
+    }
+
+    // The value below which the given fraction of the values of the histogram lies.
+    inline float histogramQuantile(const ChannelStatistics& channel, double fraction)
+    {
+        const double target     = fraction * double(channel.count);
+        double       cumulative = 0.0;
+        for (uint32_t bin = 0; bin < HISTOGRAM_BINS; ++bin)
+        {
+            cumulative += double(channel.histogram[bin]);
+            if (cumulative >= target)
+                return channel.minValue + float(bin + 1) * channel.binWidth();
+        }
+        return channel.maxValue;
+    }
+
+    // The range to quantize a channel over, by the given statistic. Weights are quantized symmetrically, activations asymmetrically.
+    inline Range calibrateChannel(const ChannelStatistics& channel, Statistic statistic, double percentile, bool symmetric)
+    {
+        const Range fullRange = {channel.minValue, channel.maxValue};
+        if (statistic == Statistic::MinMax || channel.count == 0)
+            return fullRange;
+
+        if (statistic == Statistic::Percentile)
+        {
+            const double outside = (100.0 - percentile) / 100.0;
+            return {histogramQuantile(channel, outside * 0.5), histogramQuantile(channel, 1.0 - outside * 0.5)};
+        }
+
+        // Shrink the range towards zero and keep the one with the smallest error
+        Range  bestRange = fullRange;
+        double bestError = INFINITY;
+        for (uint32_t candidate = 1; candidate <= MSE_CANDIDATES; ++candidate)
+        {
+            const float        fraction     = float(candidate) / float(MSE_CANDIDATES);
+            const Range        range        = {fullRange.low * fraction, fullRange.high * fraction};
+            const Quantization quantization = symmetric ? symmetricQuantization(range) : asymmetricQuantization(range);
+            const double       error        = quantizationError(channel, quantization);
+            if (error < bestError)
+            {
+                bestError = error;
+                bestRange = range;
+            }
+        }
+        return bestRange;
+    }
+
+    // Gathers the statistics of each channel of a set of values, in two passes when a histogram is needed.
+    template <typename Gather>
+    std::vector<ChannelStatistics> gatherStatistics(uint32_t channelCount, Statistic statistic, Gather gather)
+    {
+        std::vector<ChannelStatistics> channels(channelCount);
+        gather([&](uint32_t channel, float value) { channels[channel].addRange(value); });
+        if (statistic != Statistic::MinMax)
+        {
+            gather([&](uint32_t channel, float value) { channels[channel].addToHistogram(value); });
+        }
+        return channels;
+    }
+
+}  // namespace arm
@@ -5,6 +5,10 @@
 
 #include "decoder.h"
 #include "types.hpp"
+#include "utils.hpp"
+#include <FidelityFX/host/backends/vk/ffx_hash.h>
+
+#include <spirv-tools/libspirv.h>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -17,6 +21,8 @@
 #include <algorithm>
 #endif
 
+#include <cstring>
+#include <memory>
 #include <vector>
 #include <map>
 #include <numeric>
@@ -26,6 +32,8 @@
 #include <locale>
 #include <codecvt>
 #include <string>
+#include <fstream>
+#include <sstream>
 
 static std::wstring UTF8ToWChar(const std::string& str)
 {
@@ -116,18 +124,11 @@ namespace arm
         void* _addr;
     };
 
-    std::vector<uint32_t> getDispatchShape(mlsdk_decoder_model_sequence_decoder* sequenceDecoder)
+    std::vector<uint32_t> getDispatchShape(mlsdk_decoder_model_sequence_decoder* sequenceDecoder, int segmentIdx)
     {
         mlsdk_decoder_dispatch_shape dispatchShapePtr;
-        for (int seqIdx = 0; seqIdx < mlsdk_decoder_get_model_sequence_table_size(sequenceDecoder); seqIdx++)
-        {
-            if (0 == mlsdk_decoder_model_sequence_get_segment_module_index(sequenceDecoder, seqIdx))
-            {
-                mlsdk_decoder_model_sequence_get_segment_dispatch_shape(sequenceDecoder, 0, &dispatchShapePtr);
-                return {dispatchShapePtr.data[0], dispatchShapePtr.data[1], dispatchShapePtr.data[2]};
-            }
-        }
-        throw std::runtime_error("[Scenario-Runner] Could not find dispatchShape");
+        mlsdk_decoder_model_sequence_get_segment_dispatch_shape(sequenceDecoder, segmentIdx, &dispatchShapePtr);
+        return {dispatchShapePtr.data[0], dispatchShapePtr.data[1], dispatchShapePtr.data[2]};
     }
 
     std::vector<BindingDesc> getBindings(mlsdk_decoder_model_sequence_decoder*       sequenceDecoder,
@@ -177,15 +178,15 @@ namespace arm
 
     std::vector<ResourceInfo> getResourceInfos(mlsdk_decoder_model_sequence_decoder*       sequenceDecoder,
                                                mlsdk_decoder_model_resource_table_decoder* resourceTableDecoder,
-                                               int                                         moduleIdx)
+                                               int                                         segmentIdx)
     {
         // Get segment binding infos
         std::vector<ResourceInfo> infos{};
-        auto                      descSetSize = mlsdk_decoder_model_sequence_get_segment_descriptorset_info_size(sequenceDecoder, moduleIdx);
+        auto                      descSetSize = mlsdk_decoder_model_sequence_get_segment_descriptorset_info_size(sequenceDecoder, segmentIdx);
         // For each segment descriptor set:
         for (int set = 0; set < descSetSize; ++set)
         {
-            auto handle = mlsdk_decoder_model_sequence_get_segment_descriptor_binding_slot(sequenceDecoder, moduleIdx, set);
+            auto handle = mlsdk_decoder_model_sequence_get_segment_descriptor_binding_slot(sequenceDecoder, segmentIdx, set);
             // For each descriptor set binding:
             for (int slot = 0; slot < mlsdk_decoder_binding_slot_size(sequenceDecoder, handle); ++slot)
             {
@@ -218,7 +219,7 @@ namespace arm
                 mlsdk_decoder_model_resource_table_get_tensor_shape(resourceTableDecoder, mrtIdx, &dims);
                 mlsdk_vk_format format = mlsdk_decoder_get_vk_format(resourceTableDecoder, mrtIdx);
 
-                infos.emplace_back(ResourceInfo(guidStr, set, bindingId, format, dims));
+                infos.emplace_back(ResourceInfo(guidStr, set, bindingId, format, dims, mrtIdx));
             }
         }
         return infos;
@@ -252,6 +253,11 @@ namespace arm
 
         std::string varName = fileName;
 
+        for (ConstantsInfo& constantInfo : constantInfos)
+        {
+            detectSparsity(constantInfo);
+        }
+
         fprintf(fp, "static const uint32_t g_%s_id[] = { ", varName.c_str());
         for (uint32_t i = 0; i < constantInfos.size(); i++)
         {
@@ -299,6 +305,20 @@ namespace arm
         }
         fprintf(fp, " };\n\n");
 
+        fprintf(fp, "static const uint32_t g_%s_sparsity_zero_count[] = {", varName.c_str());
+        for (uint32_t i = 0; i < constantInfos.size(); i++)
+        {
+            fprintf(fp, " %u,", constantInfos[i].tensorInfo.sparsityZeroCount);
+        }
+        fprintf(fp, " };\n\n");
+
+        fprintf(fp, "static const uint32_t g_%s_sparsity_group_size[] = {", varName.c_str());
+        for (uint32_t i = 0; i < constantInfos.size(); i++)
+        {
+            fprintf(fp, " %u,", constantInfos[i].tensorInfo.sparsityGroupSize);
+        }
+        fprintf(fp, " };\n\n");
+
         fprintf(fp, "static const uint32_t g_%s_data_size[] = {", varName.c_str());
         for (uint32_t i = 0; i < constantInfos.size(); i++)
         {
@@ -306,15 +326,19 @@ namespace arm
         }
         fprintf(fp, " };\n\n");
 
+        // Sparse constants are stored compressed, the data size stays the size of the dense constant
         for (uint32_t i = 0; i < constantInfos.size(); i++)
         {
+            const ConstantsInfo&             constantInfo = constantInfos[i];
+            const std::vector<unsigned char> data =
+                constantInfo.tensorInfo.sparsityZeroCount != 0
+                    ? compressConstant(constantInfo)
+                    : std::vector<unsigned char>(constantInfo.constantData.data, constantInfo.constantData.data + constantInfo.constantData.size);
+
             fprintf(fp, "static const unsigned char g_%s_data_%d[] = {\n", varName.c_str(), i);
 
-            for (int32_t j = 0; j < constantInfos[i].constantData.size; ++j)
-                fprintf(fp,
-                        "0x%02x%s",
-                        constantInfos[i].constantData.data[j],
-                        j == constantInfos[i].constantData.size - 1 ? "" : ((j + 1) % 16 == 0 ? ",\n" : ","));
+            for (size_t j = 0; j < data.size(); ++j)
+                fprintf(fp, "0x%02x%s", data[j], j == data.size() - 1 ? "" : ((j + 1) % 16 == 0 ? ",\n" : ","));
 
             fprintf(fp, "\n};\n\n");
         }
@@ -329,28 +353,93 @@ namespace arm
         fclose(fp);
     }
 
-    void writeGraph(int                               moduleIdx,
-                    const std::string&                entryPoint,
-                    const std::vector<unsigned char>& spirv,
-                    const std::vector<ResourceInfo>&  resourceInfos,
-                    std::vector<std::string>&         graphHeaderFiles,
-                    const std::wstring&               outputPath,
-                    const std::string&                vgfFileName)
+    /// Runs the shape inference the Vulkan backend runs when it creates the data graph pipeline, with the tensors it creates them with:
+    /// every tensor NHWC with the batch and resolution of graphShape and the channels of the model. Returns the shaped module.
+    std::vector<uint32_t> specializeGraph(const std::vector<unsigned char>&  spirv,
+                                          const std::vector<ResourceInfo>&   resourceInfos,
+                                          const GraphShape&                  graphShape,
+                                          std::vector<std::vector<int64_t>>& outTensorShapes)
+    {
+        const auto destroyOptimizer = [](spv_optimizer_t* optimizer) { spvOptimizerDestroy(optimizer); };
+        const auto destroyOptions   = [](spv_optimizer_options_t* options) { spvOptimizerOptionsDestroy(options); };
+        const auto destroyBinary    = [](spv_binary_t* binary) { spvBinaryDestroy(binary); };
+
+        std::unique_ptr<spv_optimizer_t, decltype(destroyOptimizer)>       optimizer(spvOptimizerCreate(SPV_ENV_VULKAN_1_3), destroyOptimizer);
+        std::unique_ptr<spv_optimizer_options_t, decltype(destroyOptions)> options(spvOptimizerOptionsCreate(), destroyOptions);
+        if (!optimizer || !options)
+        {
+            throw std::runtime_error("Could not create the SPIR-V optimizer");
+        }
+
+        std::vector<std::vector<int64_t>>  inputShapes;
+        std::vector<spv_graph_shape_input> shapeInputs;
+        for (const ResourceInfo& resourceInfo : resourceInfos)
+        {
+            if (resourceInfo.dims.size != 4)
+            {
+                throw std::runtime_error("Graph tensor " + resourceInfo.name + " is not NHWC, its shape can't be specialized");
+            }
+            inputShapes.push_back({int64_t(graphShape.batchSize), int64_t(graphShape.height), int64_t(graphShape.width), resourceInfo.dims.data[3]});
+        }
+        for (size_t i = 0; i < resourceInfos.size(); ++i)
+        {
+            shapeInputs.push_back({uint32_t(resourceInfos[i].set), uint32_t(resourceInfos[i].id), uint32_t(inputShapes[i].size()), inputShapes[i].data()});
+        }
+
+        spvOptimizerSetMessageConsumer(optimizer.get(), [](spv_message_level_t, const char*, const spv_position_t*, const char*) {});
+        spvOptimizerRegisterGraphShapePass(optimizer.get(), shapeInputs.size(), shapeInputs.data());
+
+        spv_binary_t*  rawBinary = nullptr;
+        const uint32_t wordCount = uint32_t(spirv.size() / sizeof(uint32_t));
+        const spv_result_t result =
+            spvOptimizerRun(optimizer.get(), reinterpret_cast<const uint32_t*>(spirv.data()), wordCount, &rawBinary, options.get());
+        std::unique_ptr<spv_binary_t, decltype(destroyBinary)> binary(rawBinary, destroyBinary);
+        if (result != SPV_SUCCESS || !binary)
+        {
+            throw std::runtime_error("Shape inference failed for " + std::to_string(graphShape.width) + "x" + std::to_string(graphShape.height));
+        }
+
+        std::vector<uint32_t> code(binary->code, binary->code + binary->wordCount);
+        outTensorShapes = getTensorShapes(code, resourceInfos);
+        if (outTensorShapes.empty() && !resourceInfos.empty())
+        {
+            throw std::runtime_error("Shape inference left tensors unshaped for " + std::to_string(graphShape.width) + "x" + std::to_string(graphShape.height));
+        }
+        return code;
+    }
+
+    /// The name of the header and arrays of a segment, <model>_graph_<segment> or <model>_compute_<segment>
+    std::string getSegmentName(const std::string& vgfFileName, ModuleType type, int segmentIdx)
+    {
+        return vgfFileName + (type == ModuleType::GRAPH ? "_graph_" : "_compute_") + std::to_string(segmentIdx);
+    }
+
+    void writeSegment(int                                            segmentIdx,
+                      ModuleType                                     type,
+                      const std::string&                             entryPoint,
+                      const std::vector<unsigned char>&              spirv,
+                      const std::vector<uint32_t>&                   dispatchShape,
+                      const std::vector<ResourceInfo>&               resourceInfos,
+                      const std::map<std::string, QuantizationInfo>& quantization,
+                      const std::vector<GraphShape>&                 graphShapes,
+                      std::vector<std::string>&                      segmentHeaderFiles,
+                      const std::wstring&                            outputPath,
+                      const std::string&                             vgfFileName)
     {
         FILE* fp = NULL;
 
-        std::string fileName = vgfFileName + "_graph_";
+        std::string fileName = getSegmentName(vgfFileName, type, segmentIdx);
 
-        graphHeaderFiles.push_back(fileName + std::to_string(moduleIdx) + ".h");
+        segmentHeaderFiles.push_back(fileName + ".h");
 
 #if defined(_WIN32)
         const std::wstring wFileName(fileName.begin(), fileName.end());
         std::wstring       outputFile = outputPath;
-        outputFile += wFileName + std::to_wstring(moduleIdx) + L".h";
+        outputFile += wFileName + L".h";
         _wfopen_s(&fp, outputFile.c_str(), L"wb");
 #else
         std::string outputFile(outputPath.begin(), outputPath.end());
-        outputFile += fileName + std::to_string(moduleIdx) + ".h";
+        outputFile += fileName + ".h";
         fp = fopen(outputFile.c_str(), "wb");
         if (fp == nullptr)
         {
@@ -358,10 +447,21 @@ namespace arm
         }
 #endif
 
-        std::string varName = fileName + std::to_string(moduleIdx);
+        std::string varName = fileName;
 
         fprintf(fp, "static const char g_%s_entry_point[] = \"%s\";\n\n", varName.c_str(), entryPoint.c_str());
 
+        // Compute segments are dispatched with the workgroup counts of the model sequence
+        if (type == ModuleType::SHADER)
+        {
+            fprintf(fp,
+                    "static const uint32_t g_%s_dispatch_shape[] = { %u, %u, %u };\n\n",
+                    varName.c_str(),
+                    dispatchShape[0],
+                    dispatchShape[1],
+                    dispatchShape[2]);
+        }
+
         fprintf(fp, "static const uint32_t g_%s_tensor_nums = %d;\n\n", varName.c_str(), resourceInfos.size());
 
         fprintf(fp, "static const char* g_%s_tensor_names[] = { ", varName.c_str());
@@ -400,6 +500,37 @@ namespace arm
 
         fprintf(fp, " };\n\n");
 
+        // Tensors without quantization metadata get a scale of 0
+        fprintf(fp, "static const float g_%s_tensor_quant_scales[] = { ", varName.c_str());
+
+        for (int i = 0; i < resourceInfos.size(); i++)
+        {
+            auto quant = quantization.find(resourceInfos[i].name);
+            fprintf(fp, " %.9g,", quant != quantization.end() ? quant->second.scale : 0.0f);
+        }
+
+        fprintf(fp, " };\n\n");
+
+        fprintf(fp, "static const int32_t g_%s_tensor_quant_zero_points[] = { ", varName.c_str());
+
+        for (int i = 0; i < resourceInfos.size(); i++)
+        {
+            auto quant = quantization.find(resourceInfos[i].name);
+            fprintf(fp, " %d,", quant != quantization.end() ? quant->second.zeroPoint : 0);
+        }
+
+        fprintf(fp, " };\n\n");
+
+        // Intermediates are identified by their index in the model resource table, their bindings may differ between segments
+        fprintf(fp, "static const uint32_t g_%s_tensor_resources[] = { ", varName.c_str());
+
+        for (int i = 0; i < resourceInfos.size(); i++)
+        {
+            fprintf(fp, " %d,", resourceInfos[i].mrtIndex);
+        }
+
+        fprintf(fp, " };\n\n");
+
         for (int i = 0; i < resourceInfos.size(); i++)
         {
             fprintf(fp, "static const uint32_t g_%s_tensor_dim_size_%d = %d;\n\n", varName.c_str(), i, resourceInfos[i].dims.size);
@@ -433,6 +564,48 @@ namespace arm
 
         fprintf(fp, " };\n\n");
 
+        // Graphs are shaped for each resolution they're listed with, so pipelines created at it skip shape inference
+        for (int shapeIdx = 0; type == ModuleType::GRAPH && shapeIdx < graphShapes.size(); shapeIdx++)
+        {
+            std::vector<std::vector<int64_t>> tensorShapes;
+            const std::vector<uint32_t>       code      = specializeGraph(spirv, resourceInfos, graphShapes[shapeIdx], tensorShapes);
+            const unsigned char*              codeBytes = reinterpret_cast<const unsigned char*>(code.data());
+            const size_t                      codeSize  = code.size() * sizeof(uint32_t);
+            const std::string                 shapeName = varName + "_shape_" + std::to_string(shapeIdx);
+
+            for (int i = 0; i < tensorShapes.size(); i++)
+            {
+                fprintf(fp, "static const int64_t g_%s_tensor_shapes_%d[] = { ", shapeName.c_str(), i);
+                for (const int64_t dim : tensorShapes[i])
+                {
+                    fprintf(fp, " %lld,", (long long)dim);
+                }
+                fprintf(fp, " };\n\n");
+            }
+
+            fprintf(fp, "static const int64_t* g_%s_tensor_shapes[] = { ", shapeName.c_str());
+
+            for (int i = 0; i < tensorShapes.size(); i++)
+            {
+                fprintf(fp, " g_%s_tensor_shapes_%d,", shapeName.c_str(), i);
+            }
+
+            fprintf(fp, " };\n\n");
+
+            fprintf(fp, "static const uint32_t g_%s_data_size = %d;\n\n", shapeName.c_str(), (int)codeSize);
+
+            // The runtime only uses the module with the graph data it was specialized from
+            const unsigned long long graphHash = arm::computeHash(spirv.data(), spirv.size());
+            fprintf(fp, "static const uint64_t g_%s_graph_hash = 0x%016llxull;\n\n", shapeName.c_str(), graphHash);
+
+            fprintf(fp, "static const unsigned char g_%s_data[] = {\n", shapeName.c_str());
+
+            for (size_t i = 0; i < codeSize; ++i)
+                fprintf(fp, "0x%02x%s", codeBytes[i], i == codeSize - 1 ? "" : ((i + 1) % 16 == 0 ? ",\n" : ","));
+
+            fprintf(fp, "\n};\n\n");
+        }
+
         fprintf(fp, "static const uint32_t g_%s_data_size = %d;\n\n", varName.c_str(), spirv.size());
 
         fprintf(fp, "static const unsigned char g_%s_data[] = {\n", varName.c_str());
@@ -445,11 +618,143 @@ namespace arm
         fclose(fp);
     }
 
-    void writeHeaderFile(const std::vector<std::string>& moduleHeaderFiles,
-                         const std::vector<std::string>& constantHeaderFiles,
-                         uint32_t                        constantNums,
-                         const std::wstring&             outputPath,
-                         const std::string&              vgfFileName)
+    /// Writes the constants a graph segment of a multi-segment model is built with, as the arrays of the model's constants they were taken from.
+    void writeConstantSubset(FILE*                             fp,
+                             const std::string&                varName,
+                             const std::string&                modelVarName,
+                             const std::vector<ConstantsInfo>& constantInfos,
+                             const std::vector<uint32_t>&      constants)
+    {
+        const auto writeArray = [&](const char* type, const char* suffix, auto writeValue) {
+            fprintf(fp, "static const %s g_%s_%s[] = {", type, varName.c_str(), suffix);
+            for (const uint32_t i : constants)
+            {
+                writeValue(i);
+            }
+            fprintf(fp, " };\n\n");
+        };
+
+        writeArray("uint32_t", "id", [&](uint32_t i) { fprintf(fp, " %d,", constantInfos[i].constantIdx); });
+        writeArray("uint32_t", "format", [&](uint32_t i) { fprintf(fp, " %d,", (int)constantInfos[i].tensorInfo.format); });
+        writeArray("uint32_t", "shape_size", [&](uint32_t i) { fprintf(fp, " %d,", (int)constantInfos[i].tensorInfo.shape.size()); });
+        writeArray("uint64_t*", "shape", [&](uint32_t i) { fprintf(fp, " g_%s_shape_%u,", modelVarName.c_str(), i); });
+        writeArray("int64_t", "sparsity_dimension", [&](uint32_t i) { fprintf(fp, " %d,", (int)constantInfos[i].tensorInfo.sparsityDimension); });
+        writeArray("uint32_t", "sparsity_zero_count", [&](uint32_t i) { fprintf(fp, " %u,", constantInfos[i].tensorInfo.sparsityZeroCount); });
+        writeArray("uint32_t", "sparsity_group_size", [&](uint32_t i) { fprintf(fp, " %u,", constantInfos[i].tensorInfo.sparsityGroupSize); });
+        writeArray("uint32_t", "data_size", [&](uint32_t i) { fprintf(fp, " %d,", (int)constantInfos[i].constantData.size); });
+        writeArray("unsigned char*", "data", [&](uint32_t i) { fprintf(fp, " g_%s_data_%u,", modelVarName.c_str(), i); });
+    }
+
+    /// Writes the initializer of an _Info, for a graph built with the constants in the arrays named constantsVarName, or with none when it is empty
+    void writeInfo(FILE*              fp,
+                   const std::string& infoVarName,
+                   const std::string& constantsVarName,
+                   const std::string& graphVarName,
+                   size_t             constantNums,
+                   bool               hasQuantization,
+                   size_t             segmentNums,
+                   const std::string& segmentsVarName,
+                   size_t             graphShapeNums)
+    {
+        const auto writeConstantArray = [&](const char* suffix) {
+            if (constantsVarName.empty())
+                fprintf(fp, "    nullptr, \n");
+            else
+                fprintf(fp, "    g_%s_%s, \n", constantsVarName.c_str(), suffix);
+        };
+
+        fprintf(fp, "static const %s_Info g_%s_Info = {\n", infoVarName.c_str(), infoVarName.c_str());
+
+        fprintf(fp, "    %d, \n", (int)constantNums);
+        writeConstantArray("id");
+        writeConstantArray("format");
+        writeConstantArray("shape_size");
+        writeConstantArray("shape");
+        writeConstantArray("sparsity_dimension");
+        writeConstantArray("data_size");
+        writeConstantArray("data");
+
+        fprintf(fp, "    g_%s_entry_point, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_data_size, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_data, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_nums, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_names, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_sets, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_bindings, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_formats, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_dim_size, \n", graphVarName.c_str());
+        fprintf(fp, "    g_%s_tensor_dims, \n", graphVarName.c_str());
+
+        if (hasQuantization)
+        {
+            fprintf(fp, "    g_%s_tensor_quant_scales, \n", graphVarName.c_str());
+            fprintf(fp, "    g_%s_tensor_quant_zero_points, \n", graphVarName.c_str());
+        }
+        else
+        {
+            fprintf(fp, "    nullptr, \n");
+            fprintf(fp, "    nullptr, \n");
+        }
+
+        writeConstantArray("sparsity_zero_count");
+        writeConstantArray("sparsity_group_size");
+
+        if (segmentNums > 0)
+        {
+            fprintf(fp, "    %d, \n", (int)segmentNums);
+            fprintf(fp, "    g_%s, \n", segmentsVarName.c_str());
+        }
+        else
+        {
+            fprintf(fp, "    0, \n");
+            fprintf(fp, "    nullptr, \n");
+        }
+
+        if (graphShapeNums > 0)
+        {
+            fprintf(fp, "    %d, \n", (int)graphShapeNums);
+            fprintf(fp, "    g_%s_shapes \n", graphVarName.c_str());
+        }
+        else
+        {
+            fprintf(fp, "    0, \n");
+            fprintf(fp, "    nullptr \n");
+        }
+
+        fprintf(fp, "};\n\n");
+    }
+
+    /// Writes the table of the graph modules a graph segment was specialized for, see writeSegment()
+    void writeGraphShapes(FILE* fp, const std::string& modelVarName, const std::string& graphVarName, const std::vector<GraphShape>& graphShapes)
+    {
+        if (graphShapes.empty())
+            return;
+
+        fprintf(fp, "static const %s_GraphShape g_%s_shapes[] = {\n", modelVarName.c_str(), graphVarName.c_str());
+        for (int i = 0; i < graphShapes.size(); i++)
+        {
+            const std::string shapeName = graphVarName + "_shape_" + std::to_string(i);
+            fprintf(fp,
+                    "    { %u, %u, %u, g_%s_data_size, g_%s_data, g_%s_tensor_shapes, g_%s_graph_hash },\n",
+                    graphShapes[i].width,
+                    graphShapes[i].height,
+                    graphShapes[i].batchSize,
+                    shapeName.c_str(),
+                    shapeName.c_str(),
+                    shapeName.c_str(),
+                    shapeName.c_str());
+        }
+        fprintf(fp, "};\n\n");
+    }
+
+    void writeHeaderFile(const std::vector<std::string>&   segmentHeaderFiles,
+                         const std::vector<std::string>&   constantHeaderFiles,
+                         const std::vector<ConstantsInfo>& constantInfos,
+                         const std::vector<SegmentInfo>&   segments,
+                         const std::vector<GraphShape>&    graphShapes,
+                         bool                              hasQuantization,
+                         const std::wstring&               outputPath,
+                         const std::string&                vgfFileName)
     {
         FILE* fp = NULL;
 
@@ -470,9 +775,9 @@ namespace arm
         }
 #endif
 
-        for (int i = 0; i < moduleHeaderFiles.size(); i++)
+        for (int i = 0; i < segmentHeaderFiles.size(); i++)
         {
-            fprintf(fp, "#include \"%s\"\n", moduleHeaderFiles[i].c_str());
+            fprintf(fp, "#include \"%s\"\n", segmentHeaderFiles[i].c_str());
         }
 
         for (int i = 0; i < constantHeaderFiles.size(); i++)
@@ -502,42 +807,140 @@ namespace arm
         fprintf(fp, "    const uint32_t*      tensorBindings;\n");
         fprintf(fp, "    const uint32_t*      tensorFormats;\n");
         fprintf(fp, "    const uint32_t*      tensorDimSize;\n");
-        fprintf(fp, "    const uint64_t**     tensorDims;\n");
+        fprintf(fp, "    const uint64_t**     tensorDims;\n\n");
+        fprintf(fp, "    const float*         tensorQuantScales;\n");
+        fprintf(fp, "    const int32_t*       tensorQuantZeroPoints;\n\n");
+        fprintf(fp, "    const uint32_t*      constantSparsityZeroCounts;\n");
+        fprintf(fp, "    const uint32_t*      constantSparsityGroupSizes;\n\n");
+        fprintf(fp, "    const uint32_t       segmentNums;\n");
+        fprintf(fp, "    const struct %s_Segment* segments;\n", varName.c_str());
+        fprintf(fp, "    const uint32_t       graphShapeNums;\n");
+        fprintf(fp, "    const struct %s_GraphShape* graphShapes;\n", varName.c_str());
 
         fprintf(fp, "} %s_Info;\n\n", varName.c_str());
 
-        fprintf(fp, "static const %s_Info g_%s_Info = {\n", varName.c_str(), varName.c_str());
-
-        fprintf(fp, "    %d, \n", constantNums);
-        fprintf(fp, "    g_%s_constants_id, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_format, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_shape_size, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_shape, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_sparsity_dimension, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_data_size, \n", varName.c_str());
-        fprintf(fp, "    g_%s_constants_data, \n", varName.c_str());
-
-        fprintf(fp, "    g_%s_graph_%d_entry_point, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_data_size, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_data, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_nums, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_names, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_sets, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_bindings, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_formats, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_dim_size, \n", varName.c_str(), 0);
-        fprintf(fp, "    g_%s_graph_%d_tensor_dims \n", varName.c_str(), 0);
+        fprintf(fp, "typedef struct %s_Segment {\n", varName.c_str());
+        fprintf(fp, "    const uint32_t       type;\n");
+        fprintf(fp, "    const %s_Info* graph;\n", varName.c_str());
+        fprintf(fp, "    const char*          entryPoint;\n");
+        fprintf(fp, "    const uint32_t       codeSize;\n");
+        fprintf(fp, "    const unsigned char* code;\n");
+        fprintf(fp, "    const uint32_t*      dispatchShape;\n\n");
+        fprintf(fp, "    const uint32_t       tensorNums;\n");
+        fprintf(fp, "    const char**         tensorNames;\n");
+        fprintf(fp, "    const uint32_t*      tensorSets;\n");
+        fprintf(fp, "    const uint32_t*      tensorBindings;\n");
+        fprintf(fp, "    const uint32_t*      tensorFormats;\n");
+        fprintf(fp, "    const uint32_t*      tensorDimSize;\n");
+        fprintf(fp, "    const uint64_t**     tensorDims;\n");
+        fprintf(fp, "    const uint32_t*      tensorResources;\n");
+        fprintf(fp, "} %s_Segment;\n\n", varName.c_str());
+
+        fprintf(fp, "typedef struct %s_GraphShape {\n", varName.c_str());
+        fprintf(fp, "    const uint32_t       width;\n");
+        fprintf(fp, "    const uint32_t       height;\n");
+        fprintf(fp, "    const uint32_t       batchSize;\n");
+        fprintf(fp, "    const uint32_t       codeSize;\n");
+        fprintf(fp, "    const unsigned char* code;\n");
+        fprintf(fp, "    const int64_t**      tensorShapes;\n");
+        fprintf(fp, "    const uint64_t       graphHash;\n");
+        fprintf(fp, "} %s_GraphShape;\n\n", varName.c_str());
+
+        // The model's own graph fields are those of its first graph segment
+        const auto firstGraph = std::find_if(segments.begin(), segments.end(), [](const SegmentInfo& segment) { return segment.type == ModuleType::GRAPH; });
+        if (firstGraph == segments.end())
+        {
+            throw std::runtime_error("Model has no graph module");
+        }
+        const std::string firstGraphVarName = getSegmentName(varName, ModuleType::GRAPH, int(firstGraph - segments.begin()));
+
+        // A single graph is built with all the constants, other models list their segments with the constants of each graph
+        if (segments.size() == 1)
+        {
+            writeGraphShapes(fp, varName, firstGraphVarName, graphShapes);
+            writeInfo(fp, varName, varName + "_constants", firstGraphVarName, constantInfos.size(), hasQuantization, 0, "", graphShapes.size());
+            fprintf(fp, "\n");
+            fclose(fp);
+            return;
+        }
+
+        for (int i = 0; i < segments.size(); i++)
+        {
+            if (segments[i].type != ModuleType::GRAPH)
+                continue;
+
+            const std::string segmentVarName    = getSegmentName(varName, ModuleType::GRAPH, i);
+            const std::string constantsVarName = segments[i].constants.empty() ? "" : segmentVarName + "_constants";
+            if (!constantsVarName.empty())
+            {
+                writeConstantSubset(fp, constantsVarName, varName + "_constants", constantInfos, segments[i].constants);
+            }
+
+            fprintf(fp, "typedef %s_Info %s_Info;\n\n", varName.c_str(), segmentVarName.c_str());
+            writeGraphShapes(fp, varName, segmentVarName, graphShapes);
+            writeInfo(fp, segmentVarName, constantsVarName, segmentVarName, segments[i].constants.size(), hasQuantization, 0, "", graphShapes.size());
+        }
+
+        fprintf(fp, "static const %s_Segment g_%s_segments[] = {\n", varName.c_str(), varName.c_str());
+        for (int i = 0; i < segments.size(); i++)
+        {
+            const bool        isGraph        = segments[i].type == ModuleType::GRAPH;
+            const std::string segmentVarName = getSegmentName(varName, segments[i].type, i);
 
+            fprintf(fp, "    {\n");
+            fprintf(fp, "        %d, \n", isGraph ? 0 : 1);
+            if (isGraph)
+                fprintf(fp, "        &g_%s_Info, \n", segmentVarName.c_str());
+            else
+                fprintf(fp, "        nullptr, \n");
+            fprintf(fp, "        g_%s_entry_point, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_data_size, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_data, \n", segmentVarName.c_str());
+            if (isGraph)
+                fprintf(fp, "        nullptr, \n");
+            else
+                fprintf(fp, "        g_%s_dispatch_shape, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_nums, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_names, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_sets, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_bindings, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_formats, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_dim_size, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_dims, \n", segmentVarName.c_str());
+            fprintf(fp, "        g_%s_tensor_resources \n", segmentVarName.c_str());
+            fprintf(fp, "    },\n");
+        }
         fprintf(fp, "};\n\n");
+
+        writeInfo(fp,
+                  varName,
+                  varName + "_constants",
+                  firstGraphVarName,
+                  constantInfos.size(),
+                  hasQuantization,
+                  segments.size(),
+                  varName + "_segments",
+                  graphShapes.size());
+        fclose(fp);
     }
 
-    void parseVgf(std::wstring& wvgfFile, std::wstring& outputPath)
+    void parseVgf(std::wstring& wvgfFile, std::wstring& wquantFile, std::wstring& wshapesFile, std::wstring& outputPath)
     {
         std::string vgfFile(wvgfFile.begin(), wvgfFile.end());
 
         std::string vgfFileName = std::filesystem::path(vgfFile).stem().generic_string();
         std::replace(vgfFileName.begin(), vgfFileName.end(), '-', '_');
 
+        // Quantization metadata defaults to <model>.quant next to the model
+        const std::filesystem::path quantFile =
+            wquantFile.empty() ? std::filesystem::path(vgfFile).replace_extension(".quant") : std::filesystem::path(wquantFile);
+        const std::map<std::string, QuantizationInfo> quantization = readQuantization(quantFile);
+
+        // The resolutions to shape the graphs for default to <model>.shapes next to the model
+        const std::filesystem::path shapesFile =
+            wshapesFile.empty() ? std::filesystem::path(vgfFile).replace_extension(".shapes") : std::filesystem::path(wshapesFile);
+        const std::vector<GraphShape> graphShapes = readGraphShapes(shapesFile);
+
         MemoryMap mapped(vgfFile);
 
         // Create header decoder
@@ -578,68 +981,91 @@ namespace arm
         mlsdk_decoder_model_resource_table_decoder* resourceTableDecoder =
             mlsdk_decoder_create_model_resource_table_decoder((char*)mapped.ptr() + modelResourceSection.offset, resourceTableDecoderMemory.data());
 
-        // Needed to transfer info from module handling to constant handling sections
-        // Module Id -> {constant Id}
-        std::map<int, std::set<int>> segmentConstantRefs;
-
-        // Get module info / spirv code
-        std::vector<VgfModule> vgfModules;
-        size_t                 num_module_table_entries = mlsdk_decoder_get_module_table_num_entries(moduleDecoder);
+        const mlsdk_vk_descriptor_type DESCRIPTOR_TYPE_STORAGE_BUFFER_EXT = 6;
+        const mlsdk_vk_descriptor_type DESCRIPTOR_TYPE_STORAGE_TENSOR_EXT = 1000460000;
 
-        // Model sequence section
-        mlsdk_decoder_vgf_section_info sequenceSection;
-        mlsdk_decoder_get_header_section_info(headerDecoder, mlsdk_decoder_section_model_sequence, &sequenceSection);
+        // Needed to transfer info from segment handling to constant handling sections
+        // Segment Id -> {constant Id}
+        std::map<int, std::set<int>> segmentConstantRefs;
 
-        std::vector<std::string> graphHeaderFiles;
+        std::vector<SegmentInfo> segments;
+        std::vector<std::string> segmentHeaderFiles;
         std::vector<std::string> constantHeaderFiles;
 
-        for (int moduleIdx = 0; moduleIdx < num_module_table_entries; ++moduleIdx)
+        // Each segment of the model sequence runs one module, in sequence order
+        size_t num_segments = mlsdk_decoder_get_model_sequence_table_size(sequenceDecoder);
+        for (int segmentIdx = 0; segmentIdx < num_segments; ++segmentIdx)
         {
+            const uint32_t moduleIdx = mlsdk_decoder_model_sequence_get_segment_module_index(sequenceDecoder, segmentIdx);
+
+            mlsdk_decoder_spirv_code spirv;
+            mlsdk_decoder_get_module_code(moduleDecoder, moduleIdx, &spirv);
+            if (spirv.code == nullptr)
+            {
+                throw std::runtime_error("No spirv code found in module " + std::to_string(moduleIdx));
+            }
+
+            auto                            castSpv       = reinterpret_cast<const uint8_t*>(spirv.code);
+            const std::vector<uint8_t>      spvData       = std::vector(castSpv, castSpv + 4 * spirv.words);
+            const char*                     entryPoint    = mlsdk_decoder_get_module_entry_point(moduleDecoder, moduleIdx);
+            const std::vector<ResourceInfo> resourceInfos = getResourceInfos(sequenceDecoder, resourceTableDecoder, segmentIdx);
+
             switch (mlsdk_decoder_get_module_type(moduleDecoder, moduleIdx))
             {
             case mlsdk_decoder_module_type_graph:
             {
-                mlsdk_decoder_spirv_code spirv;
-                mlsdk_decoder_get_module_code(moduleDecoder, moduleIdx, &spirv);
-                if (spirv.code == nullptr)
-                {
-                    throw std::runtime_error("No spirv code found in graph module");
-                }
-
-                // Get constant ids for each module
+                // Get constant ids for each segment
                 mlsdk_decoder_constant_indexes constantIdxs{};
-                mlsdk_decoder_model_sequence_get_segment_constant_indexes(sequenceDecoder, moduleIdx, &constantIdxs);
+                mlsdk_decoder_model_sequence_get_segment_constant_indexes(sequenceDecoder, segmentIdx, &constantIdxs);
                 for (int constantIdx = 0; constantIdx < constantIdxs.size; ++constantIdx)
                 {
-                    segmentConstantRefs[moduleIdx].insert(constantIdxs.data[constantIdx]);
+                    segmentConstantRefs[segmentIdx].insert(constantIdxs.data[constantIdx]);
                 }
 
-                auto castSpv = reinterpret_cast<const uint8_t*>(spirv.code);
-                writeGraph(moduleIdx,
-                           mlsdk_decoder_get_module_entry_point(moduleDecoder, moduleIdx),
-                           std::vector(castSpv, castSpv + 4 * spirv.words),
-                           getResourceInfos(sequenceDecoder, resourceTableDecoder, moduleIdx),
-                           graphHeaderFiles,
-                           outputPath,
-                           vgfFileName);
+                segments.push_back({ModuleType::GRAPH, {}});
+                writeSegment(segmentIdx,
+                             ModuleType::GRAPH,
+                             entryPoint,
+                             spvData,
+                             {},
+                             resourceInfos,
+                             quantization,
+                             graphShapes,
+                             segmentHeaderFiles,
+                             outputPath,
+                             vgfFileName);
                 break;
             }
             case mlsdk_decoder_module_type_compute:
             {
-                std::vector<uint32_t>    dispatchShape = getDispatchShape(sequenceDecoder);
-                mlsdk_decoder_spirv_code spirv;
-                mlsdk_decoder_get_module_code(moduleDecoder, moduleIdx, &spirv);
-
-                const char* moduleName = mlsdk_decoder_get_module_name(moduleDecoder, moduleIdx);
-                const char* entryPoint = mlsdk_decoder_get_module_entry_point(moduleDecoder, moduleIdx);
+                // Compute segments are dispatched with tensors only, the runtime has no push constants or buffers to give them
+                mlsdk_decoder_push_constant_ranges_handle pushConstants =
+                    mlsdk_decoder_model_sequence_get_segment_push_constant_range(sequenceDecoder, segmentIdx);
+                if (mlsdk_decoder_get_push_constant_ranges_size(sequenceDecoder, pushConstants) > 0)
+                {
+                    throw std::runtime_error("Compute segment " + std::to_string(segmentIdx) + " uses push constants");
+                }
 
-                std::vector<uint8_t> spvData = {};
-                if (spirv.code)
+                for (const ResourceInfo& resourceInfo : resourceInfos)
                 {
-                    auto castSpv = reinterpret_cast<const uint8_t*>(spirv.code);
-                    spvData      = std::vector(castSpv, castSpv + 4 * spirv.words);
+                    if (mlsdk_decoder_get_vk_descriptor_type(resourceTableDecoder, resourceInfo.mrtIndex).value != DESCRIPTOR_TYPE_STORAGE_TENSOR_EXT)
+                    {
+                        throw std::runtime_error("Compute segment " + std::to_string(segmentIdx) + " binds a resource that is not a tensor");
+                    }
                 }
 
+                segments.push_back({ModuleType::SHADER, {}});
+                writeSegment(segmentIdx,
+                             ModuleType::SHADER,
+                             entryPoint,
+                             spvData,
+                             getDispatchShape(sequenceDecoder, segmentIdx),
+                             resourceInfos,
+                             quantization,
+                             {},
+                             segmentHeaderFiles,
+                             outputPath,
+                             vgfFileName);
                 break;
             }
             default:
@@ -648,9 +1074,6 @@ namespace arm
         }
 
         // Iterate over all vgf Resources, create intermediates
-        const mlsdk_vk_descriptor_type DESCRIPTOR_TYPE_STORAGE_BUFFER_EXT = 6;
-        const mlsdk_vk_descriptor_type DESCRIPTOR_TYPE_STORAGE_TENSOR_EXT = 1000460000;
-
         size_t num_resources = mlsdk_decoder_get_model_resource_table_num_entries(resourceTableDecoder);
         for (int resourceIdx = 0; resourceIdx < num_resources; ++resourceIdx)
         {
@@ -729,18 +1152,25 @@ namespace arm
             tensorInfo.format            = static_cast<VkFormat>(mlsdk_decoder_get_vk_format(resourceTableDecoder, mrt_idx));
             tensorInfo.sparsityDimension = mlsdk_decoder_constant_table_get_sparsity_dimension(constantDecoder, constantIdx);
 
-            // Check each module to see if requires the current constant
-            for (auto ref : segmentConstantRefs)
+            // Check each segment to see if requires the current constant, the constant is written once for all of them
+            bool isReferenced = false;
+            for (auto& ref : segmentConstantRefs)
             {
                 if (ref.second.count(constantIdx))
                 {
-                    constantInfos.push_back({constantIdx, tensorInfo, constantData});
+                    segments[ref.first].constants.push_back(uint32_t(constantInfos.size()));
+                    isReferenced = true;
                 }
             }
+
+            if (isReferenced)
+            {
+                constantInfos.push_back({constantIdx, tensorInfo, constantData});
+            }
         }
 
         writeConstants(constantInfos, constantHeaderFiles, outputPath, vgfFileName);
-        writeHeaderFile(graphHeaderFiles, constantHeaderFiles, constantInfos.size(), outputPath, vgfFileName);
+        writeHeaderFile(segmentHeaderFiles, constantHeaderFiles, constantInfos, segments, graphShapes, !quantization.empty(), outputPath, vgfFileName);
     }
 
     static const wchar_t* const APP_NAME    = L"Arm_Model_Parser";
@@ -749,6 +1179,8 @@ namespace arm
     struct LaunchParameters
     {
         std::wstring outputPath;
+        std::wstring quantFile;
+        std::wstring shapesFile;
         std::wstring inputFile;
     };
 
@@ -760,7 +1192,12 @@ namespace arm
         wprintf(
             L"Options:\n"
             L"-output=<Path>\n"
-            L"  Path to where the shader permutations should be output to.\n");
+            L"  Path to where the shader permutations should be output to.\n"
+            L"-quant=<Path>\n"
+            L"  Quantization metadata of the model's tensors. Defaults to <InputFile>.quant when present.\n"
+            L"-shapes=<Path>\n"
+            L"  Resolutions to shape the graphs for, one <Width> <Height> [<BatchSize>] line each, so the runtime skips shape inference at them.\n"
+            L"  Defaults to <InputFile>.shapes when present.\n");
     }
 
     bool startsWith(const wchar_t* s, const wchar_t* subS)
@@ -790,6 +1227,10 @@ namespace arm
         {
             if (startsWith(args[i], L"-output"))
                 parseString(params.outputPath, args[i]);
+            else if (startsWith(args[i], L"-quant"))
+                parseString(params.quantFile, args[i]);
+            else if (startsWith(args[i], L"-shapes"))
+                parseString(params.shapesFile, args[i]);
             else
                 params.inputFile = args[i];
         }
@@ -826,6 +1267,6 @@ int main(int argc, char** argv)
     }
     arm::parseCommandLine(static_cast<int>(wargv.size()), wargv.data(), params);
 #endif
-    arm::parseVgf(params.inputFile, params.outputPath);
+    arm::parseVgf(params.inputFile, params.quantFile, params.shapesFile, params.outputPath);
     return 0;
 }
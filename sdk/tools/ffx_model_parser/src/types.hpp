@@ -47,6 +47,8 @@ namespace arm
         VkFormat              format;
         bool                  isAliased{false};
         int64_t               sparsityDimension;
+        uint32_t              sparsityZeroCount{0};  // Zeros in each group along the sparsity dimension, 0 when dense
+        uint32_t              sparsityGroupSize{0};
     };
 
     struct ConstantsInfo
@@ -74,12 +76,13 @@ namespace arm
     struct ResourceInfo
     {
         ResourceInfo() = default;
-        ResourceInfo(std::string name, int set, int id, int format, mlsdk_decoder_tensor_dimensions dims)
+        ResourceInfo(std::string name, int set, int id, int format, mlsdk_decoder_tensor_dimensions dims, int mrtIndex)
             : name(name)
             , set(set)
             , id(id)
             , format(format)
             , dims(dims)
+            , mrtIndex(mrtIndex)
         {
         }
 
@@ -88,6 +91,32 @@ namespace arm
         int                             id;
         int                             format;
         mlsdk_decoder_tensor_dimensions dims;
+        int                             mrtIndex;  // Index in the model resource table, shared by the segments binding the resource
+    };
+
+    /// \brief A segment of the model sequence, the SDK runs them in order
+    struct SegmentInfo
+    {
+        ModuleType            type;
+        std::vector<uint32_t> constants;  // The constants a graph segment is built with, indexes into the constants of the model
+    };
+
+    /// \brief Quantization of an int8 tensor, real = (q - zeroPoint) * scale
+    ///
+    /// \note The VGF only carries the tensor formats, the exporter writes the
+    /// scale and zero point of each tensor in a separate metadata file
+    struct QuantizationInfo
+    {
+        float   scale;
+        int32_t zeroPoint;
+    };
+
+    /// \brief A resolution graphs are specialized for offline, with the batch of views run together
+    struct GraphShape
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t batchSize;
     };
 
     struct VgfModule
@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace arm
+{
+    std::map<std::string, QuantizationInfo> readQuantization(const std::filesystem::path& quantFile)
+    {
+        std::map<std::string, QuantizationInfo> quantization;
+
+        std::ifstream file(quantFile);
+        if (!file.is_open())
+        {
+            return quantization;
+        }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            std::string        name;
+            QuantizationInfo   info{};
+            if (!(stream >> name >> info.scale >> info.zeroPoint) || info.scale <= 0.0f)
+            {
+                throw std::runtime_error("Invalid quantization metadata in " + quantFile.generic_string() + ": " + line);
+            }
+            quantization[name] = info;
+        }
+        return quantization;
+    }
+
+    std::vector<GraphShape> readGraphShapes(const std::filesystem::path& shapesFile)
+    {
+        std::vector<GraphShape> graphShapes;
+
+        std::ifstream file(shapesFile);
+        if (!file.is_open())
+        {
+            return graphShapes;
+        }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            GraphShape         graphShape{0, 0, 1};
+            if (!(stream >> graphShape.width >> graphShape.height) || graphShape.width == 0 || graphShape.height == 0)
+            {
+                throw std::runtime_error("Invalid graph shape in " + shapesFile.generic_string() + ": " + line);
+            }
+            if (!(stream >> graphShape.batchSize))
+            {
+                graphShape.batchSize = 1;
+            }
+            graphShapes.push_back(graphShape);
+        }
+        return graphShapes;
+    }
+
+    /// Calls visit(group, elements) for each group of groupSize consecutive elements along a dimension of a tensor,
+    /// ordered by their first element as ffxDataGraphExpandConstant expects. Returns false when the groups don't tile the dimension.
+    template <typename Visitor>
+    bool visitSparsityGroups(const std::vector<uint64_t>& shape, int64_t dimension, uint32_t groupSize, Visitor visit)
+    {
+        if (dimension < 0 || dimension >= int64_t(shape.size()) || shape[dimension] % groupSize != 0)
+        {
+            return false;
+        }
+
+        uint64_t outerCount = 1;
+        uint64_t innerCount = 1;
+        for (int64_t i = 0; i < int64_t(shape.size()); ++i)
+        {
+            if (i < dimension)
+                outerCount *= shape[i];
+            else if (i > dimension)
+                innerCount *= shape[i];
+        }
+
+        std::vector<uint64_t> elements(groupSize);
+        uint64_t              group = 0;
+        for (uint64_t outer = 0; outer < outerCount; ++outer)
+        {
+            for (uint64_t first = 0; first < shape[dimension]; first += groupSize)
+            {
+                for (uint64_t inner = 0; inner < innerCount; ++inner, ++group)
+                {
+                    for (uint32_t position = 0; position < groupSize; ++position)
+                        elements[position] = (outer * shape[dimension] + first + position) * innerCount + inner;
+                    visit(group, elements);
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Returns the size in bytes of an element of a constant, or 0 when its data doesn't match its shape.
+    size_t getElementSize(const ConstantsInfo& constant)
+    {
+        const std::vector<uint64_t>& shape        = constant.tensorInfo.shape;
+        const uint64_t               elementCount = std::accumulate(shape.begin(), shape.end(), uint64_t(1), std::multiplies<uint64_t>());
+        return (elementCount != 0 && constant.constantData.size % elementCount == 0) ? size_t(constant.constantData.size / elementCount) : 0;
+    }
+
+    /// Checks whether every byte of an element is zero, which covers integers and positive zero floats.
+    bool isZeroElement(const ConstantsInfo& constant, size_t elementSize, uint64_t element)
+    {
+        const unsigned char* data = constant.constantData.data + element * elementSize;
+        return std::all_of(data, data + elementSize, [](unsigned char byte) { return byte == 0; });
+    }
+
+    void detectSparsity(ConstantsInfo& constant)
+    {
+        TensorInfo&    tensorInfo  = constant.tensorInfo;
+        const size_t   elementSize = getElementSize(constant);
+        const int64_t  dimension   = tensorInfo.sparsityDimension >= 0 ? tensorInfo.sparsityDimension : int64_t(tensorInfo.shape.size()) - 1;
+        if (tensorInfo.shape.size() < 2 || elementSize == 0)
+        {
+            return;
+        }
+
+        for (const uint32_t groupSize : {4u, 8u})
+        {
+            uint32_t zeroCount = groupSize;
+            if (!visitSparsityGroups(tensorInfo.shape, dimension, groupSize, [&](uint64_t, const std::vector<uint64_t>& elements) {
+                    const auto groupZeros =
+                        std::count_if(elements.begin(), elements.end(), [&](uint64_t element) { return isZeroElement(constant, elementSize, element); });
+                    zeroCount = std::min(zeroCount, uint32_t(groupZeros));
+                }))
+            {
+                continue;
+            }
+
+            // Fully zero constants are left dense, there is nothing to keep. Larger groups are only used for a higher ratio of zeros.
+            const bool halfZero  = zeroCount * 2 >= groupSize && zeroCount < groupSize;
+            const bool moreZeros = tensorInfo.sparsityZeroCount == 0 || zeroCount * tensorInfo.sparsityGroupSize > tensorInfo.sparsityZeroCount * groupSize;
+            if (halfZero && moreZeros)
+            {
+                tensorInfo.sparsityDimension = dimension;
+                tensorInfo.sparsityZeroCount = zeroCount;
+                tensorInfo.sparsityGroupSize = groupSize;
+            }
+        }
+    }
+
+    std::vector<unsigned char> compressConstant(const ConstantsInfo& constant)
+    {
+        const TensorInfo& tensorInfo  = constant.tensorInfo;
+        const size_t      elementSize = getElementSize(constant);
+        const uint32_t    groupSize   = tensorInfo.sparsityGroupSize;
+        const uint32_t    keptCount   = groupSize - tensorInfo.sparsityZeroCount;
+        const uint64_t    groupCount  = constant.constantData.size / elementSize / groupSize;
+
+        std::vector<unsigned char> mask((groupCount * groupSize + 7) / 8, 0);
+        std::vector<unsigned char> values;
+        visitSparsityGroups(tensorInfo.shape, tensorInfo.sparsityDimension, groupSize, [&](uint64_t group, const std::vector<uint64_t>& elements) {
+            // Groups with more zeros than the constant's minimum keep some of them
+            std::vector<bool> kept(groupSize, false);
+            uint32_t          count = 0;
+            for (uint32_t position = 0; position < groupSize && count < keptCount; ++position)
+            {
+                if (!isZeroElement(constant, elementSize, elements[position]))
+                {
+                    kept[position] = true;
+                    ++count;
+                }
+            }
+            for (uint32_t position = 0; position < groupSize && count < keptCount; ++position)
+            {
+                if (!kept[position])
+                {
+                    kept[position] = true;
+                    ++count;
+                }
+            }
+
+            for (uint32_t position = 0; position < groupSize; ++position)
+            {
+                if (!kept[position])
+                    continue;
+                const uint64_t bit = group * groupSize + position;
+                mask[bit / 8] |= uint8_t(1u << (bit % 8));
+                const unsigned char* element = constant.constantData.data + elements[position] * elementSize;
+                values.insert(values.end(), element, element + elementSize);
+            }
+        });
+
+        mask.insert(mask.end(), values.begin(), values.end());
+        return mask;
+    }
+
+    std::vector<std::vector<int64_t>> getTensorShapes(const std::vector<uint32_t>& words, const std::vector<ResourceInfo>& resourceInfos)
+    {
+        const uint32_t OP_TYPE_POINTER       = 32;
+        const uint32_t OP_CONSTANT           = 43;
+        const uint32_t OP_CONSTANT_COMPOSITE = 44;
+        const uint32_t OP_VARIABLE           = 59;
+        const uint32_t OP_DECORATE           = 71;
+        const uint32_t OP_TYPE_TENSOR_ARM    = 4163;
+        const uint32_t DECORATION_BINDING    = 33;
+        const uint32_t DECORATION_SET        = 34;
+        const size_t   HEADER_WORDS          = 5;
+
+        std::map<uint32_t, BindingDesc>           variableBindings;  // Variable id -> set, binding
+        std::map<uint32_t, uint32_t>              variableTypes;     // Variable id -> pointer type id
+        std::map<uint32_t, uint32_t>              pointeeTypes;      // Pointer type id -> pointee type id
+        std::map<uint32_t, uint32_t>              tensorShapeIds;    // Tensor type id -> shape constant id
+        std::map<uint32_t, int64_t>               constants;
+        std::map<uint32_t, std::vector<uint32_t>> composites;
+
+        for (size_t wordIdx = HEADER_WORDS; wordIdx < words.size();)
+        {
+            const uint32_t  wordCount = words[wordIdx] >> 16;
+            const uint32_t  opcode    = words[wordIdx] & 0xffff;
+            const uint32_t* operands  = &words[wordIdx + 1];
+            if (wordCount == 0 || wordIdx + wordCount > words.size())
+            {
+                return {};
+            }
+
+            if (opcode == OP_DECORATE && wordCount >= 4 && operands[1] == DECORATION_BINDING)
+                variableBindings[operands[0]].id = operands[2];
+            else if (opcode == OP_DECORATE && wordCount >= 4 && operands[1] == DECORATION_SET)
+                variableBindings[operands[0]].set = operands[2];
+            else if (opcode == OP_VARIABLE && wordCount >= 4)
+                variableTypes[operands[1]] = operands[0];
+            else if (opcode == OP_TYPE_POINTER && wordCount >= 4)
+                pointeeTypes[operands[0]] = operands[2];
+            else if (opcode == OP_TYPE_TENSOR_ARM && wordCount >= 5)
+                tensorShapeIds[operands[0]] = operands[3];
+            else if (opcode == OP_CONSTANT && wordCount >= 4)
+                constants[operands[1]] = wordCount >= 5 ? int64_t(uint64_t(operands[2]) | (uint64_t(operands[3]) << 32)) : int64_t(operands[2]);
+            else if (opcode == OP_CONSTANT_COMPOSITE && wordCount >= 3)
+                composites[operands[1]] = std::vector<uint32_t>(operands + 2, operands + wordCount - 1);
+
+            wordIdx += wordCount;
+        }
+
+        std::vector<std::vector<int64_t>> shapes;
+        for (const ResourceInfo& resourceInfo : resourceInfos)
+        {
+            const auto variable = std::find_if(variableBindings.begin(), variableBindings.end(), [&](const auto& binding) {
+                return binding.second.set == resourceInfo.set && binding.second.id == resourceInfo.id && variableTypes.count(binding.first);
+            });
+            if (variable == variableBindings.end())
+            {
+                return {};
+            }
+
+            const auto pointee = pointeeTypes.find(variableTypes[variable->first]);
+            if (pointee == pointeeTypes.end() || !tensorShapeIds.count(pointee->second) || !composites.count(tensorShapeIds[pointee->second]))
+            {
+                return {};
+            }
+
+            std::vector<int64_t> shape;
+            for (const uint32_t dimId : composites[tensorShapeIds[pointee->second]])
+            {
+                if (!constants.count(dimId) || constants[dimId] <= 0)
+                {
+                    return {};
+                }
+                shape.push_back(constants[dimId]);
+            }
+            shapes.push_back(shape);
+        }
+
+        return shapes;
+    }
+
+}  // namespace arm
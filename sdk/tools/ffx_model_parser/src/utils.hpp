@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include "decoder.h"
+#include "types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+// The parts of the parser which read the files next to the model and transform its data without the VGF decoder
+
+namespace arm
+{
+    /// Reads the quantization metadata the exporter writes next to the model, one "<tensor name> <scale> <zero point>" line per tensor.
+    /// Lines starting with '#' are comments. Returns an empty map when the model has no metadata file.
+    std::map<std::string, QuantizationInfo> readQuantization(const std::filesystem::path& quantFile);
+
+    /// Reads the resolutions to specialize the graphs for, one <width> <height> [<batch size>] line each. No file means none.
+    std::vector<GraphShape> readGraphShapes(const std::filesystem::path& shapesFile);
+
+    /// Finds the structured sparsity of a pruned weight constant: the fewest zeros in the groups of 4 or 8 elements along the sparsity
+    /// dimension of the model, or along the innermost dimension (the input channels of convolution weights) when the model declares none.
+    /// A constant is only sparse when at least half of every group is zero, as with 2:4 sparsity.
+    void detectSparsity(ConstantsInfo& constant);
+
+    /// Stores a sparse constant as ffxDataGraphExpandConstant reads it: a mask of the elements kept in each group, followed by the kept elements.
+    std::vector<unsigned char> compressConstant(const ConstantsInfo& constant);
+
+    /// Reads the shape a shaped graph module declares for each of its tensors, the way the runtime reads them after shape inference.
+    /// Returns no shapes when a tensor's shape isn't constant in the module.
+    std::vector<std::vector<int64_t>> getTensorShapes(const std::vector<uint32_t>& words, const std::vector<ResourceInfo>& resourceInfos);
+
+}  // namespace arm
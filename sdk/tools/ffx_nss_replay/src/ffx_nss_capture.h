@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+// Reads a capture written through FFX_API_CONFIGURE_DESC_TYPE_NSS_CAPTURE, in the layout ffx_api/ffx_nss.h describes, and the
+// files of images the replay tool writes its outputs to.
+
+#include <ffx_api/ffx_nss.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace arm
+{
+    struct CapturedImage
+    {
+        ffxApiNssCaptureImage description;
+        std::vector<uint8_t>  data;
+    };
+
+    struct CapturedFrame
+    {
+        ffxApiNssCaptureFrameHeader header;
+        CapturedImage               color;
+        CapturedImage               depth;
+        CapturedImage               motionVectors;
+        CapturedImage               depthTm1;
+        CapturedImage               outputTm1;
+    };
+
+    struct Capture
+    {
+        ffxApiNssCaptureFileHeader header;
+        std::vector<CapturedFrame> frames;
+    };
+
+    inline void readImage(FILE* file, CapturedImage& image)
+    {
+        image.data.resize(image.description.dataSize);
+        if (!image.data.empty() && fread(image.data.data(), 1, image.data.size(), file) != image.data.size())
+        {
+            throw std::runtime_error("Truncated capture file");
+        }
+    }
+
+    /// Reads every frame of a capture file. Throws when the file isn't a capture of the supported version or is truncated.
+    inline Capture readCapture(const std::string& path)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            throw std::runtime_error("Could not open file " + path);
+        }
+
+        Capture capture = {};
+        try
+        {
+            if (fread(&capture.header, sizeof(capture.header), 1, file) != 1 || capture.header.magic != FFX_API_NSS_CAPTURE_MAGIC)
+            {
+                throw std::runtime_error(path + " is not an NSS capture");
+            }
+            if (capture.header.version != FFX_API_NSS_CAPTURE_VERSION)
+            {
+                throw std::runtime_error(path + " has unsupported capture version " + std::to_string(capture.header.version));
+            }
+
+            capture.frames.resize(capture.header.frameCount);
+            for (CapturedFrame& frame : capture.frames)
+            {
+                if (fread(&frame.header, sizeof(frame.header), 1, file) != 1)
+                {
+                    throw std::runtime_error("Truncated capture file");
+                }
+                frame.color.description         = frame.header.color;
+                frame.depth.description         = frame.header.depth;
+                frame.motionVectors.description = frame.header.motionVectors;
+                frame.depthTm1.description      = frame.header.depthTm1;
+                frame.outputTm1.description     = frame.header.outputTm1;
+                readImage(file, frame.color);
+                readImage(file, frame.depth);
+                readImage(file, frame.motionVectors);
+                readImage(file, frame.depthTm1);
+                readImage(file, frame.outputTm1);
+            }
+        }
+        catch (...)
+        {
+            fclose(file);
+            throw;
+        }
+
+        fclose(file);
+        return capture;
+    }
+
+    /// Appends an image to a file of images, as the replay tool writes the outputs it produced with -output=<File>:
+    /// the description of the image followed by its texels, which are description.dataSize bytes.
+    inline bool writeImage(FILE* file, const ffxApiNssCaptureImage& description, const void* data)
+    {
+        return fwrite(&description, sizeof(description), 1, file) == 1 &&
+               (description.dataSize == 0 || fwrite(data, 1, description.dataSize, file) == description.dataSize);
+    }
+
+    /// Reads every image of a file written with writeImage. Throws when the file is truncated.
+    inline std::vector<CapturedImage> readImages(const std::string& path)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            throw std::runtime_error("Could not open file " + path);
+        }
+
+        std::vector<CapturedImage> images;
+        try
+        {
+            // A description cut short leaves the file position past the last complete image
+            CapturedImage image    = {};
+            long          complete = 0;
+            while (fread(&image.description, sizeof(image.description), 1, file) == 1)
+            {
+                readImage(file, image);
+                images.push_back(image);
+                complete += long(sizeof(image.description) + image.data.size());
+            }
+            if (ferror(file) || ftell(file) != complete)
+            {
+                throw std::runtime_error("Truncated image file");
+            }
+        }
+        catch (...)
+        {
+            fclose(file);
+            throw;
+        }
+
+        fclose(file);
+        return images;
+    }
+
+}  // namespace arm
@@ -0,0 +1,649 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2025 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+// Replays a capture written through FFX_API_CONFIGURE_DESC_TYPE_NSS_CAPTURE and reports the time each dispatch takes.
+
+#include "ffx_nss_capture.h"
+
+#include <ffx_api/ffx_nss.hpp>
+#include <ffx_api/vk/ffx_api_vk.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace arm
+{
+    struct LaunchParameters
+    {
+        std::string inputFile;
+        std::string outputFile;
+        uint32_t    loopCount   = 1;
+        uint32_t    deviceIndex = 0;
+    };
+
+    struct Image
+    {
+        VkImage           image  = VK_NULL_HANDLE;
+        VkDeviceMemory    memory = VK_NULL_HANDLE;
+        VkImageCreateInfo createInfo;
+        uint32_t          usage = FFX_API_RESOURCE_USAGE_READ_ONLY;
+    };
+
+    struct HostBuffer
+    {
+        VkBuffer       buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint8_t*       data   = nullptr;
+    };
+
+    struct Device
+    {
+        VkInstance                       instance        = VK_NULL_HANDLE;
+        VkPhysicalDevice                 physicalDevice  = VK_NULL_HANDLE;
+        VkDevice                         device          = VK_NULL_HANDLE;
+        VkQueue                          queue           = VK_NULL_HANDLE;
+        uint32_t                         queueFamily     = 0;
+        float                            timestampPeriod = 0.0f;
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+    };
+
+    static const char* const APP_NAME    = "Arm_NSS_Replay";
+    static const char* const APP_VERSION = "1.0.0";
+
+    static void check(VkResult result, const char* what)
+    {
+        if (result != VK_SUCCESS)
+        {
+            throw std::runtime_error(std::string(what) + " failed with VkResult " + std::to_string(result));
+        }
+    }
+
+    static VkFormat getVkFormat(uint32_t format, bool depth)
+    {
+        switch (format)
+        {
+        case FFX_API_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+            return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case FFX_API_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case FFX_API_SURFACE_FORMAT_R32G32_FLOAT:
+            return VK_FORMAT_R32G32_SFLOAT;
+        case FFX_API_SURFACE_FORMAT_R8G8B8A8_UNORM:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case FFX_API_SURFACE_FORMAT_R8G8B8A8_SRGB:
+            return VK_FORMAT_R8G8B8A8_SRGB;
+        case FFX_API_SURFACE_FORMAT_B8G8R8A8_UNORM:
+            return VK_FORMAT_B8G8R8A8_UNORM;
+        case FFX_API_SURFACE_FORMAT_R11G11B10_FLOAT:
+            return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        case FFX_API_SURFACE_FORMAT_R10G10B10A2_UNORM:
+            return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+        case FFX_API_SURFACE_FORMAT_R16G16_FLOAT:
+            return VK_FORMAT_R16G16_SFLOAT;
+        case FFX_API_SURFACE_FORMAT_R16_FLOAT:
+            return VK_FORMAT_R16_SFLOAT;
+        case FFX_API_SURFACE_FORMAT_R32_UINT:
+            return depth ? VK_FORMAT_X8_D24_UNORM_PACK32 : VK_FORMAT_R32_UINT;
+        case FFX_API_SURFACE_FORMAT_R16_UNORM:
+            return depth ? VK_FORMAT_D16_UNORM : VK_FORMAT_R16_UNORM;
+        case FFX_API_SURFACE_FORMAT_R32_FLOAT:
+            return depth ? VK_FORMAT_D32_SFLOAT : VK_FORMAT_R32_SFLOAT;
+        default:
+            throw std::runtime_error("Unsupported captured surface format " + std::to_string(format));
+        }
+    }
+
+    static uint32_t findMemoryType(const Device& device, uint32_t typeBits, VkMemoryPropertyFlags properties)
+    {
+        for (uint32_t i = 0; i < device.memoryProperties.memoryTypeCount; ++i)
+        {
+            if ((typeBits & (1u << i)) && (device.memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                return i;
+            }
+        }
+        throw std::runtime_error("No suitable memory type");
+    }
+
+    static Device createDevice(uint32_t deviceIndex)
+    {
+        Device device = {};
+
+        VkApplicationInfo appInfo = {VK_STRUCTURE_TYPE_APPLICATION_INFO};
+        appInfo.pApplicationName  = APP_NAME;
+        appInfo.apiVersion        = VK_API_VERSION_1_3;
+
+        VkInstanceCreateInfo instanceInfo = {VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+        instanceInfo.pApplicationInfo     = &appInfo;
+        check(vkCreateInstance(&instanceInfo, nullptr, &device.instance), "vkCreateInstance");
+
+        uint32_t physicalDeviceCount = 0;
+        vkEnumeratePhysicalDevices(device.instance, &physicalDeviceCount, nullptr);
+        if (deviceIndex >= physicalDeviceCount)
+        {
+            throw std::runtime_error("Device index " + std::to_string(deviceIndex) + " out of range");
+        }
+        std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+        vkEnumeratePhysicalDevices(device.instance, &physicalDeviceCount, physicalDevices.data());
+        device.physicalDevice = physicalDevices[deviceIndex];
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device.physicalDevice, &properties);
+        vkGetPhysicalDeviceMemoryProperties(device.physicalDevice, &device.memoryProperties);
+        device.timestampPeriod = properties.limits.timestampPeriod;
+        printf("Device: %s\n", properties.deviceName);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device.physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device.physicalDevice, &queueFamilyCount, queueFamilies.data());
+        device.queueFamily = queueFamilyCount;
+        for (uint32_t i = 0; i < queueFamilyCount; ++i)
+        {
+            if ((queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT) && queueFamilies[i].timestampValidBits != 0)
+            {
+                device.queueFamily = i;
+                break;
+            }
+        }
+        if (device.queueFamily == queueFamilyCount)
+        {
+            throw std::runtime_error("No compute queue with timestamp support");
+        }
+
+        // Enable every feature the device reports, NSS picks what it needs from the tensor and data graph extensions
+        VkPhysicalDeviceDataGraphFeaturesARM dataGraphFeatures = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DATA_GRAPH_FEATURES_ARM};
+        VkPhysicalDeviceTensorFeaturesARM    tensorFeatures    = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TENSOR_FEATURES_ARM, &dataGraphFeatures};
+        VkPhysicalDeviceVulkan13Features     vulkan13Features  = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES, &tensorFeatures};
+        VkPhysicalDeviceVulkan12Features     vulkan12Features  = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, &vulkan13Features};
+        VkPhysicalDeviceVulkan11Features     vulkan11Features  = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES, &vulkan12Features};
+        VkPhysicalDeviceFeatures2            features          = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &vulkan11Features};
+        vkGetPhysicalDeviceFeatures2(device.physicalDevice, &features);
+        if (!tensorFeatures.tensors || !dataGraphFeatures.dataGraph)
+        {
+            throw std::runtime_error("The device does not support tensors and data graphs");
+        }
+
+        const char* const extensions[] = {VK_ARM_TENSORS_EXTENSION_NAME, VK_ARM_DATA_GRAPH_EXTENSION_NAME};
+
+        const float             queuePriority = 1.0f;
+        VkDeviceQueueCreateInfo queueInfo     = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+        queueInfo.queueFamilyIndex            = device.queueFamily;
+        queueInfo.queueCount                  = 1;
+        queueInfo.pQueuePriorities            = &queuePriority;
+
+        VkDeviceCreateInfo deviceInfo      = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO, &features};
+        deviceInfo.queueCreateInfoCount    = 1;
+        deviceInfo.pQueueCreateInfos       = &queueInfo;
+        deviceInfo.enabledExtensionCount   = sizeof(extensions) / sizeof(extensions[0]);
+        deviceInfo.ppEnabledExtensionNames = extensions;
+        check(vkCreateDevice(device.physicalDevice, &deviceInfo, nullptr, &device.device), "vkCreateDevice");
+        vkGetDeviceQueue(device.device, device.queueFamily, 0, &device.queue);
+
+        return device;
+    }
+
+    static Image createImage(const Device& device, VkFormat format, uint32_t width, uint32_t height, VkImageUsageFlags vkUsage, uint32_t usage)
+    {
+        Image image;
+        image.usage      = usage;
+        image.createInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+
+        image.createInfo.imageType     = VK_IMAGE_TYPE_2D;
+        image.createInfo.format        = format;
+        image.createInfo.extent        = {width, height, 1};
+        image.createInfo.mipLevels     = 1;
+        image.createInfo.arrayLayers   = 1;
+        image.createInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        image.createInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        image.createInfo.usage         = vkUsage;
+        image.createInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        image.createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        check(vkCreateImage(device.device, &image.createInfo, nullptr, &image.image), "vkCreateImage");
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device.device, image.image, &requirements);
+
+        VkMemoryAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        allocateInfo.allocationSize       = requirements.size;
+        allocateInfo.memoryTypeIndex      = findMemoryType(device, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        check(vkAllocateMemory(device.device, &allocateInfo, nullptr, &image.memory), "vkAllocateMemory");
+        check(vkBindImageMemory(device.device, image.image, image.memory, 0), "vkBindImageMemory");
+
+        return image;
+    }
+
+    static Image createInputImage(const Device& device, const ffxApiNssCaptureImage& description)
+    {
+        const bool        depth   = (description.usage & FFX_API_RESOURCE_USAGE_DEPTHTARGET) != 0;
+        VkImageUsageFlags vkUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        return createImage(device, getVkFormat(description.format, depth), description.width, description.height, vkUsage, description.usage);
+    }
+
+    static void destroyImage(const Device& device, Image& image)
+    {
+        vkDestroyImage(device.device, image.image, nullptr);
+        vkFreeMemory(device.device, image.memory, nullptr);
+        image = Image();
+    }
+
+    static HostBuffer createHostBuffer(const Device& device, VkDeviceSize size, VkBufferUsageFlags usage)
+    {
+        HostBuffer buffer;
+
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size               = std::max<VkDeviceSize>(size, 1);
+        bufferInfo.usage              = usage;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+        check(vkCreateBuffer(device.device, &bufferInfo, nullptr, &buffer.buffer), "vkCreateBuffer");
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(device.device, buffer.buffer, &requirements);
+        VkMemoryAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        allocateInfo.allocationSize       = requirements.size;
+        allocateInfo.memoryTypeIndex =
+            findMemoryType(device, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        check(vkAllocateMemory(device.device, &allocateInfo, nullptr, &buffer.memory), "vkAllocateMemory");
+        check(vkBindBufferMemory(device.device, buffer.buffer, buffer.memory, 0), "vkBindBufferMemory");
+        check(vkMapMemory(device.device, buffer.memory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&buffer.data)), "vkMapMemory");
+
+        return buffer;
+    }
+
+    static void destroyHostBuffer(const Device& device, HostBuffer& buffer)
+    {
+        vkDestroyBuffer(device.device, buffer.buffer, nullptr);
+        vkFreeMemory(device.device, buffer.memory, nullptr);
+        buffer = HostBuffer();
+    }
+
+    static VkImageAspectFlags getAspect(const Image& image)
+    {
+        return (image.usage & FFX_API_RESOURCE_USAGE_DEPTHTARGET) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+
+    static void transition(VkCommandBuffer commandBuffer, const Image& image, VkImageLayout oldLayout, VkImageLayout newLayout)
+    {
+        VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        barrier.srcAccessMask        = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask        = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.oldLayout            = oldLayout;
+        barrier.newLayout            = newLayout;
+        barrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                = image.image;
+        barrier.subresourceRange     = {getAspect(image), 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    static void upload(VkCommandBuffer commandBuffer, VkBuffer staging, VkDeviceSize offset, const Image& image)
+    {
+        VkBufferImageCopy region = {};
+        region.bufferOffset      = offset;
+        region.imageSubresource  = {getAspect(image), 0, 0, 1};
+        region.imageExtent       = image.createInfo.extent;
+        vkCmdCopyBufferToImage(commandBuffer, staging, image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+
+    static void readback(VkCommandBuffer commandBuffer, const Image& image, VkImageLayout layout, VkBuffer readbackBuffer)
+    {
+        VkBufferImageCopy region = {};
+        region.imageSubresource  = {getAspect(image), 0, 0, 1};
+        region.imageExtent       = image.createInfo.extent;
+        vkCmdCopyImageToBuffer(commandBuffer, image.image, layout, readbackBuffer, 1, &region);
+
+        VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    static FfxApiResource getResource(const Image& image, uint32_t state)
+    {
+        return ffxApiGetResourceVK(image.image, ffxApiGetImageResourceDescriptionVK(image.image, image.createInfo, image.usage), state);
+    }
+
+    static void messageCallback(uint32_t type, const wchar_t* message)
+    {
+        fprintf(stderr, "%s: %ls\n", type == FFX_API_MESSAGE_TYPE_ERROR ? "error" : "warning", message);
+    }
+
+    static void replay(const LaunchParameters& params)
+    {
+        const Capture capture = readCapture(params.inputFile);
+        if (capture.frames.empty())
+        {
+            throw std::runtime_error(params.inputFile + " contains no frames");
+        }
+        printf("%s: %u frames, render %ux%u, upscale %ux%u\n",
+               params.inputFile.c_str(),
+               capture.header.frameCount,
+               capture.header.maxRenderSize.width,
+               capture.header.maxRenderSize.height,
+               capture.header.maxUpscaleSize.width,
+               capture.header.maxUpscaleSize.height);
+
+        Device device = createDevice(params.deviceIndex);
+
+        ffx::CreateBackendVKDesc backendDesc{};
+        backendDesc.vkDevice              = device.device;
+        backendDesc.vkPhysicalDevice      = device.physicalDevice;
+        backendDesc.vkInstance            = device.instance;
+        backendDesc.vkDeviceProcAddr      = vkGetDeviceProcAddr;
+        backendDesc.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
+
+        ffx::CreateContextDescNss createContextNss{};
+        createContextNss.flags          = capture.header.contextFlags;
+        createContextNss.maxRenderSize  = capture.header.maxRenderSize;
+        createContextNss.maxUpscaleSize = capture.header.maxUpscaleSize;
+        createContextNss.fpMessage      = &messageCallback;
+        createContextNss.qualityMode    = static_cast<FfxApiNssShaderQualityMode>(capture.header.qualityMode);
+
+        ffx::Context context = nullptr;
+        if (ffx::CreateContext(context, nullptr, createContextNss, backendDesc) != ffx::ReturnCode::Ok)
+        {
+            throw std::runtime_error("Failed to create the NSS context");
+        }
+
+        // The inputs are sized by the first frame, like the capture readback buffers were
+        const CapturedFrame& first = capture.frames[0];
+        Image                color = createInputImage(device, first.color.description);
+        Image                motionVectors = createInputImage(device, first.motionVectors.description);
+        Image                depth[2]      = {createInputImage(device, first.depth.description), createInputImage(device, first.depth.description)};
+
+        // The outputs take the format and size of the captured previous output, which is uploaded into them
+        ffxApiNssCaptureImage outputTm1 = {};
+        for (const CapturedFrame& frame : capture.frames)
+        {
+            if (outputTm1.dataSize == 0)
+                outputTm1 = frame.header.outputTm1;
+        }
+        const bool              hasOutputTm1  = outputTm1.dataSize != 0;
+        const VkFormat          outputFormat  = hasOutputTm1 ? getVkFormat(outputTm1.format, false) : color.createInfo.format;
+        const VkImageUsageFlags outputVkUsage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        const uint32_t          outputWidth   = hasOutputTm1 ? outputTm1.width : capture.header.maxUpscaleSize.width;
+        const uint32_t          outputHeight  = hasOutputTm1 ? outputTm1.height : capture.header.maxUpscaleSize.height;
+        Image                   output[2]     = {createImage(device, outputFormat, outputWidth, outputHeight, outputVkUsage, FFX_API_RESOURCE_USAGE_UAV),
+                                                 createImage(device, outputFormat, outputWidth, outputHeight, outputVkUsage, FFX_API_RESOURCE_USAGE_UAV)};
+
+        VkDeviceSize stagingSize = 0;
+        for (const CapturedFrame& frame : capture.frames)
+        {
+            // The previous depth and output may only be missing, when the application passed none
+            const bool tm1Matches = (frame.header.depthTm1.dataSize == 0 || frame.header.depthTm1.dataSize == first.header.depth.dataSize) &&
+                                    (frame.header.outputTm1.dataSize == 0 || frame.header.outputTm1.dataSize == outputTm1.dataSize);
+            if (frame.header.color.width != first.header.color.width || frame.header.color.height != first.header.color.height ||
+                frame.header.depth.dataSize != first.header.depth.dataSize || frame.header.motionVectors.dataSize != first.header.motionVectors.dataSize ||
+                !tm1Matches)
+            {
+                throw std::runtime_error("Frame " + std::to_string(frame.header.frameIndex) + " changes the input sizes");
+            }
+            stagingSize = std::max<VkDeviceSize>(stagingSize,
+                                                 frame.color.data.size() + frame.depth.data.size() + frame.motionVectors.data.size() +
+                                                     frame.depthTm1.data.size() + frame.outputTm1.data.size());
+        }
+
+        HostBuffer staging = createHostBuffer(device, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+        // With -output=<File>, the output of each frame of the first loop is read back and written to the file
+        const uint32_t        colorTexelSize = first.header.color.dataSize / (first.header.color.width * first.header.color.height);
+        ffxApiNssCaptureImage outputImage    = {};
+        outputImage.format                   = hasOutputTm1 ? outputTm1.format : first.header.color.format;
+        outputImage.usage                    = FFX_API_RESOURCE_USAGE_UAV;
+        outputImage.width                    = outputWidth;
+        outputImage.height                   = outputHeight;
+        outputImage.dataSize                 = hasOutputTm1 ? outputTm1.dataSize : outputWidth * outputHeight * colorTexelSize;
+        HostBuffer outputReadback;
+        FILE*      outputFile = nullptr;
+        if (!params.outputFile.empty())
+        {
+            outputReadback = createHostBuffer(device, outputImage.dataSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+            outputFile     = fopen(params.outputFile.c_str(), "wb");
+            if (outputFile == nullptr)
+            {
+                throw std::runtime_error("Could not open file " + params.outputFile);
+            }
+        }
+
+        VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        poolInfo.flags                   = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex        = device.queueFamily;
+        VkCommandPool commandPool        = VK_NULL_HANDLE;
+        check(vkCreateCommandPool(device.device, &poolInfo, nullptr, &commandPool), "vkCreateCommandPool");
+
+        VkCommandBufferAllocateInfo commandBufferInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        commandBufferInfo.commandPool                 = commandPool;
+        commandBufferInfo.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferInfo.commandBufferCount          = 1;
+        VkCommandBuffer commandBuffer                 = VK_NULL_HANDLE;
+        check(vkAllocateCommandBuffers(device.device, &commandBufferInfo, &commandBuffer), "vkAllocateCommandBuffers");
+
+        VkQueryPoolCreateInfo queryPoolInfo = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        queryPoolInfo.queryType             = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount            = 2;
+        VkQueryPool queryPool               = VK_NULL_HANDLE;
+        check(vkCreateQueryPool(device.device, &queryPoolInfo, nullptr, &queryPool), "vkCreateQueryPool");
+
+        VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        VkFence           fence     = VK_NULL_HANDLE;
+        check(vkCreateFence(device.device, &fenceInfo, nullptr, &fence), "vkCreateFence");
+
+        // The outputs stay in GENERAL for the whole replay
+        VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        check(vkBeginCommandBuffer(commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+        for (const Image& image : output)
+        {
+            transition(commandBuffer, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+        }
+        transition(commandBuffer, depth[1], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        check(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+
+        VkSubmitInfo submitInfo       = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &commandBuffer;
+        check(vkQueueSubmit(device.queue, 1, &submitInfo, fence), "vkQueueSubmit");
+        check(vkWaitForFences(device.device, 1, &fence, VK_TRUE, UINT64_MAX), "vkWaitForFences");
+
+        double   cpuTotal = 0.0, gpuTotal = 0.0;
+        double   gpuMin = 1e30, gpuMax = 0.0;
+        uint32_t dispatchCount = 0;
+
+        printf("%8s %8s %10s %10s\n", "loop", "frame", "cpu ms", "gpu ms");
+        for (uint32_t loop = 0; loop < params.loopCount; ++loop)
+        {
+            for (const CapturedFrame& frame : capture.frames)
+            {
+                const uint32_t current  = dispatchCount & 1;
+                const uint32_t previous = current ^ 1;
+
+                // The captured previous depth and output are uploaded into the images standing in for them
+                const CapturedImage* capturedInputs[] = {&frame.color, &frame.depth, &frame.motionVectors, &frame.depthTm1, &frame.outputTm1};
+                const Image*         inputs[]         = {&color, &depth[current], &motionVectors, &depth[previous], &output[previous]};
+                const VkImageLayout  inputLayouts[]   = {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_GENERAL};
+
+                VkDeviceSize offset = 0;
+                for (const CapturedImage* capturedInput : capturedInputs)
+                {
+                    memcpy(staging.data + offset, capturedInput->data.data(), capturedInput->data.size());
+                    offset += capturedInput->data.size();
+                }
+
+                check(vkResetFences(device.device, 1, &fence), "vkResetFences");
+                check(vkResetCommandBuffer(commandBuffer, 0), "vkResetCommandBuffer");
+                check(vkBeginCommandBuffer(commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+                vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+
+                offset = 0;
+                for (uint32_t i = 0; i < 5; ++i)
+                {
+                    if (capturedInputs[i]->data.empty())
+                        continue;
+
+                    transition(commandBuffer, *inputs[i], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+                    upload(commandBuffer, staging.buffer, offset, *inputs[i]);
+                    transition(commandBuffer, *inputs[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, inputLayouts[i]);
+                    offset += capturedInputs[i]->data.size();
+                }
+
+                // When the previous depth or output weren't captured, the ones this replay produced stand in for them
+                ffx::DispatchDescNss dispatchNss{};
+                dispatchNss.commandList            = commandBuffer;
+                dispatchNss.color                  = getResource(color, FFX_API_RESOURCE_STATE_COMPUTE_READ);
+                dispatchNss.depth                  = getResource(depth[current], FFX_API_RESOURCE_STATE_COMPUTE_READ);
+                dispatchNss.depthTm1               = getResource(depth[previous], FFX_API_RESOURCE_STATE_COMPUTE_READ);
+                dispatchNss.motionVectors          = getResource(motionVectors, FFX_API_RESOURCE_STATE_COMPUTE_READ);
+                dispatchNss.outputTm1              = getResource(output[previous], FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
+                dispatchNss.output                 = getResource(output[current], FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
+                dispatchNss.jitterOffset           = frame.header.jitterOffset;
+                dispatchNss.upscaleSize            = frame.header.upscaleSize;
+                dispatchNss.renderSize             = frame.header.renderSize;
+                dispatchNss.cameraNear             = frame.header.cameraNear;
+                dispatchNss.cameraFar              = frame.header.cameraFar;
+                dispatchNss.cameraFovAngleVertical = frame.header.cameraFovAngleVertical;
+                dispatchNss.exposure               = frame.header.exposure;
+                dispatchNss.motionVectorScale      = frame.header.motionVectorScale;
+                dispatchNss.frameTimeDelta         = frame.header.frameTimeDelta;
+                dispatchNss.reset                  = frame.header.reset != 0 || dispatchCount == 0 || (loop != 0 && &frame == &first);
+                dispatchNss.flags                  = frame.header.flags;
+
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+                const auto cpuStart = std::chrono::high_resolution_clock::now();
+                if (ffx::Dispatch(context, dispatchNss) != ffx::ReturnCode::Ok)
+                {
+                    throw std::runtime_error("Dispatch of frame " + std::to_string(frame.header.frameIndex) + " failed");
+                }
+                const auto cpuEnd = std::chrono::high_resolution_clock::now();
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+
+                const bool writeOutput = outputFile != nullptr && loop == 0;
+                if (writeOutput)
+                {
+                    transition(commandBuffer, output[current], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL);
+                    readback(commandBuffer, output[current], VK_IMAGE_LAYOUT_GENERAL, outputReadback.buffer);
+                }
+
+                check(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+                check(vkQueueSubmit(device.queue, 1, &submitInfo, fence), "vkQueueSubmit");
+                check(vkWaitForFences(device.device, 1, &fence, VK_TRUE, UINT64_MAX), "vkWaitForFences");
+
+                uint64_t timestamps[2] = {};
+                check(vkGetQueryPoolResults(
+                          device.device, queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT),
+                      "vkGetQueryPoolResults");
+
+                if (writeOutput && !writeImage(outputFile, outputImage, outputReadback.data))
+                {
+                    throw std::runtime_error("Could not write to " + params.outputFile);
+                }
+
+                const double cpuMs = std::chrono::duration<double, std::milli>(cpuEnd - cpuStart).count();
+                const double gpuMs = double(timestamps[1] - timestamps[0]) * device.timestampPeriod * 1e-6;
+                printf("%8u %8u %10.3f %10.3f\n", loop, frame.header.frameIndex, cpuMs, gpuMs);
+
+                cpuTotal += cpuMs;
+                gpuTotal += gpuMs;
+                gpuMin = std::min(gpuMin, gpuMs);
+                gpuMax = std::max(gpuMax, gpuMs);
+                ++dispatchCount;
+            }
+        }
+
+        printf("%u dispatches: cpu avg %.3f ms, gpu avg %.3f ms, gpu min %.3f ms, gpu max %.3f ms\n",
+               dispatchCount,
+               cpuTotal / dispatchCount,
+               gpuTotal / dispatchCount,
+               gpuMin,
+               gpuMax);
+
+        vkDeviceWaitIdle(device.device);
+        ffx::DestroyContext(context);
+
+        vkDestroyFence(device.device, fence, nullptr);
+        vkDestroyQueryPool(device.device, queryPool, nullptr);
+        vkDestroyCommandPool(device.device, commandPool, nullptr);
+        destroyHostBuffer(device, staging);
+        if (outputFile != nullptr)
+        {
+            fclose(outputFile);
+            destroyHostBuffer(device, outputReadback);
+        }
+        destroyImage(device, color);
+        destroyImage(device, motionVectors);
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            destroyImage(device, depth[i]);
+            destroyImage(device, output[i]);
+        }
+        vkDestroyDevice(device.device, nullptr);
+        vkDestroyInstance(device.instance, nullptr);
+    }
+
+    static void printCommandLineSyntax()
+    {
+        printf("%s %s\n", APP_NAME, APP_VERSION);
+        printf("Command line syntax:\n");
+        printf("  %s [Options] <CaptureFile>\n", APP_NAME);
+        printf(
+            "Options:\n"
+            "-loops=<Count>\n"
+            "  Number of times the capture is replayed. Defaults to 1.\n"
+            "-device=<Index>\n"
+            "  Index of the Vulkan physical device to replay on. Defaults to 0.\n"
+            "-output=<File>\n"
+            "  Writes the output of each frame of the first loop to File, for comparison with another backend.\n");
+    }
+
+    static bool parseCommandLine(int argCount, const char* const* args, LaunchParameters& params)
+    {
+        for (int i = 0; i < argCount; ++i)
+        {
+            if (strncmp(args[i], "-loops=", 7) == 0)
+                params.loopCount = static_cast<uint32_t>(strtoul(args[i] + 7, nullptr, 10));
+            else if (strncmp(args[i], "-device=", 8) == 0)
+                params.deviceIndex = static_cast<uint32_t>(strtoul(args[i] + 8, nullptr, 10));
+            else if (strncmp(args[i], "-output=", 8) == 0)
+                params.outputFile = args[i] + 8;
+            else
+                params.inputFile = args[i];
+        }
+        return !params.inputFile.empty() && params.loopCount != 0;
+    }
+
+}  // namespace arm
+
+int main(int argc, char** argv)
+{
+    arm::LaunchParameters params;
+    if (!arm::parseCommandLine(argc - 1, argv + 1, params))
+    {
+        arm::printCommandLineSyntax();
+        return 1;
+    }
+
+    try
+    {
+        arm::replay(params);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}